@@ -0,0 +1,71 @@
+# Common setup of the CPU only tools and tests. These do not depend on gfx so can also be configured on their
+# own on machines that cannot build the rest of Capsaicin, in which case this provides the output directories
+# normally set by the main project
+
+if(CMAKE_SOURCE_DIR STREQUAL CMAKE_CURRENT_SOURCE_DIR)
+    set(CAPSAICIN_RUNTIME_OUTPUT_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/bin")
+    set(CAPSAICIN_LIBRARY_OUTPUT_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/bin")
+    set(CAPSAICIN_ARCHIVE_OUTPUT_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/lib")
+endif()
+
+# Make CLI11 available when it has not already been fetched by the main project
+function(capsaicin_cpu_require_cli11)
+    if(NOT TARGET CLI11::CLI11)
+        include(FetchContent)
+        FetchContent_Declare(
+            CLI11
+            GIT_REPOSITORY https://github.com/CLIUtils/CLI11.git
+            GIT_TAG        v2.5.0
+            GIT_SHALLOW    TRUE
+            GIT_PROGRESS   TRUE
+            SOURCE_DIR     "${CMAKE_CURRENT_FUNCTION_LIST_DIR}/../../third_party/cli11"
+            FIND_PACKAGE_ARGS NAMES CLI11
+        )
+        FetchContent_MakeAvailable(CLI11)
+    endif()
+endfunction()
+
+# Apply the compile options, include directories and output directories shared by all CPU only targets
+function(capsaicin_cpu_target TARGET)
+    if(CMAKE_SYSTEM_PROCESSOR MATCHES "(x86)|(X86)|(amd64)|(AMD64)")
+        if("${CMAKE_CXX_COMPILER_ID}" STREQUAL "GNU")
+            target_compile_options(${TARGET} PRIVATE -march=x86-64-v3)
+        elseif("${CMAKE_CXX_COMPILER_ID}" STREQUAL "MSVC")
+            target_compile_options(${TARGET} PRIVATE /arch:AVX2)
+        elseif("${CMAKE_CXX_COMPILER_ID}" STREQUAL "Clang")
+            if("${CMAKE_CXX_COMPILER_FRONTEND_VARIANT}" STREQUAL "MSVC")
+                target_compile_options(${TARGET} PRIVATE /arch:AVX2)
+            else()
+                target_compile_options(${TARGET} PRIVATE -march=x86-64-v3)
+            endif()
+        endif()
+    endif()
+
+    target_compile_features(${TARGET} PUBLIC cxx_std_20)
+    if("${CMAKE_CXX_COMPILER_ID}" STREQUAL "GNU")
+        target_compile_options(${TARGET} PRIVATE $<$<COMPILE_LANGUAGE:CXX>:-Wall -Wextra -pedantic>)
+        target_compile_options(${TARGET} PRIVATE $<$<COMPILE_LANGUAGE:CXX>:-fno-math-errno -fno-trapping-math>) # allows loops using sqrt and float selects to be vectorised
+    elseif("${CMAKE_CXX_COMPILER_ID}" STREQUAL "MSVC")
+        target_compile_options(${TARGET} PRIVATE $<$<COMPILE_LANGUAGE:CXX>:/MP /W4 /WX /experimental:external /external:anglebrackets /external:W0 /analyze:external->)
+        target_compile_definitions(${TARGET} PRIVATE _CRT_SECURE_NO_WARNINGS NOMINMAX)
+    elseif("${CMAKE_CXX_COMPILER_ID}" STREQUAL "Clang")
+        if("${CMAKE_CXX_COMPILER_FRONTEND_VARIANT}" STREQUAL "MSVC")
+            target_compile_options(${TARGET} PRIVATE $<$<COMPILE_LANGUAGE:CXX>:/W4 /WX>)
+        else()
+            target_compile_options(${TARGET} PRIVATE $<$<COMPILE_LANGUAGE:CXX>:-Wall -Wextra -pedantic>)
+            target_compile_options(${TARGET} PRIVATE $<$<COMPILE_LANGUAGE:CXX>:-fno-math-errno -fno-trapping-math>) # allows loops using sqrt and float selects to be vectorised
+        endif()
+    endif()
+
+    # Shared CPU helpers (parallel.h) are header only so the targets do not need to link against capsaicin/gfx
+    target_include_directories(${TARGET} PRIVATE "${CMAKE_CURRENT_FUNCTION_LIST_DIR}/../core/src/capsaicin")
+
+    find_package(Threads REQUIRED)
+    target_link_libraries(${TARGET} PRIVATE Threads::Threads)
+
+    set_target_properties(${TARGET} PROPERTIES
+        RUNTIME_OUTPUT_DIRECTORY ${CAPSAICIN_RUNTIME_OUTPUT_DIRECTORY}
+        LIBRARY_OUTPUT_DIRECTORY ${CAPSAICIN_LIBRARY_OUTPUT_DIRECTORY}
+        ARCHIVE_OUTPUT_DIRECTORY ${CAPSAICIN_ARCHIVE_OUTPUT_DIRECTORY}
+    )
+endfunction()
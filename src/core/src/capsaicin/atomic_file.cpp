@@ -0,0 +1,54 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "atomic_file.h"
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+#ifdef _WIN32
+#    include <process.h>
+#else
+#    include <unistd.h>
+#endif
+
+namespace Capsaicin
+{
+std::filesystem::path GetUniqueTempPath(std::filesystem::path const &filePath) noexcept
+{
+    static std::atomic_uint32_t counter = 0;
+    thread_local std::mt19937   random(std::random_device {}());
+#ifdef _WIN32
+    auto const processID = static_cast<uint32_t>(_getpid());
+#else
+    auto const processID = static_cast<uint32_t>(getpid());
+#endif
+    auto const threadID = static_cast<uint32_t>(std::hash<std::thread::id> {}(std::this_thread::get_id()));
+    char       suffix[48];
+    snprintf(suffix, sizeof(suffix), ".%x-%x-%x-%x.tmp", processID, threadID, static_cast<uint32_t>(random()),
+        counter.fetch_add(1, std::memory_order_relaxed));
+    auto tempPath = filePath;
+    tempPath += suffix;
+    return tempPath;
+}
+} // namespace Capsaicin
@@ -0,0 +1,75 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+namespace Capsaicin
+{
+/**
+ * Get a unique temporary file path to use when writing a file.
+ * The path is in the same directory as the destination so that it can be renamed into place. It includes the
+ * process id, thread id and a random value so that concurrent writers (including other processes) never use
+ * the same temporary file.
+ * @param filePath The final path of the file being written.
+ * @return The temporary file path.
+ */
+[[nodiscard]] std::filesystem::path GetUniqueTempPath(std::filesystem::path const &filePath) noexcept;
+
+/**
+ * Atomically replace a file with new contents.
+ * The contents are written to a unique temporary file which is then renamed over the destination so that
+ * readers never see a partially written file. The temporary file is removed if writing fails.
+ * @tparam Func Type of the write function.
+ * @param filePath The file to write.
+ * @param write    Function used to write the file contents, called with the open binary output stream. Can
+ *                 return false to abort writing the file.
+ * @return True if the file was written successfully, False otherwise.
+ */
+template<typename Func>
+bool WriteFileAtomic(std::filesystem::path const &filePath, Func const &write) noexcept
+{
+    auto const      tempPath = GetUniqueTempPath(filePath);
+    std::error_code ec;
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        if (!write(file) || !file.flush().good())
+        {
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, filePath, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+} // namespace Capsaicin
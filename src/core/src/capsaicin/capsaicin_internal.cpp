@@ -24,13 +24,14 @@ THE SOFTWARE.
 #include "common_functions.inl"
 #include "components/light_builder/light_builder.h"
 #include "render_technique.h"
+#include "shared_texture_aliasing.h"
 
 #include <chrono>
 #include <filesystem>
 #include <gfx_imgui.h>
 #include <imgui_stdlib.h>
-#include <ppl.h>
 #include <ranges>
+#include <unordered_set>
 
 using namespace std;
 
@@ -53,7 +54,13 @@ GfxScene CapsaicinInternal::getScene() const
 
 vector<string> CapsaicinInternal::getShaderPaths() const
 {
-    return {shader_path_, third_party_shader_path_, third_party_shader_path_ + "FidelityFX/gpu/"};
+    vector<string> paths = {shader_path_, third_party_shader_path_, third_party_shader_path_ + "FidelityFX/gpu/"};
+    if (compact_vertices_)
+    {
+        // gpu_shared.h picks up the compact Vertex declaration if it is found on the include paths
+        paths.emplace_back(shader_path_ + "geometry/compact_vertex/");
+    }
+    return paths;
 }
 
 uint2 CapsaicinInternal::getWindowDimensions() const noexcept
@@ -201,6 +208,11 @@ bool CapsaicinInternal::getTransformsUpdated() const noexcept
     return transform_updated_;
 }
 
+vector<uint32_t> const &CapsaicinInternal::getTransformsChanged() const noexcept
+{
+    return transform_tracker_.getChanged();
+}
+
 bool CapsaicinInternal::getInstancesUpdated() const noexcept
 {
     return instances_updated_;
@@ -234,23 +246,34 @@ bool CapsaicinInternal::getEnvironmentMapUpdated() const noexcept
 vector<string_view> CapsaicinInternal::getSharedTextures() const noexcept
 {
     vector<string_view> textures;
+    textures.reserve(shared_textures_.size() + aliased_shared_textures_.size());
     for (auto const &i : shared_textures_)
     {
         textures.emplace_back(i.first);
     }
+    // Aliased textures are still accessible through their own name
+    for (auto const &i : aliased_shared_textures_)
+    {
+        textures.emplace_back(i.first);
+    }
     return textures;
 }
 
 bool CapsaicinInternal::hasSharedTexture(string_view const &texture) const noexcept
 {
-    return ranges::any_of(shared_textures_, [&texture](auto const &item) { return item.first == texture; });
+    return ranges::any_of(shared_textures_, [&texture](auto const &item) { return item.first == texture; })
+        || ranges::any_of(
+            aliased_shared_textures_, [&texture](auto const &item) { return item.first == texture; });
 }
 
 bool CapsaicinInternal::checkSharedTexture(
     string_view const &texture, uint2 const dimensions, uint32_t const mips)
 {
-    if (auto const i =
-            ranges::find_if(shared_textures_, [&texture](auto const &item) { return item.first == texture; });
+    // Resizing an aliased texture resizes the allocation it shares
+    if (auto const i = ranges::find_if(shared_textures_,
+            [allocation = getSharedTextureAllocation(texture)](auto const &item) {
+                return item.first == allocation;
+            });
         i != shared_textures_.end())
     {
         uint2      checkDim = dimensions;
@@ -299,11 +322,41 @@ GfxTexture const &CapsaicinInternal::getSharedTexture(string_view const &texture
     {
         return i->second;
     }
+    if (auto const i = ranges::find_if(
+            aliased_shared_textures_, [&texture](auto const &item) { return item.first == texture; });
+        i != aliased_shared_textures_.cend())
+    {
+        return shared_textures_[i->second].second;
+    }
     GFX_PRINTLN("Error: Unknown VAO requested: %s", texture.data());
     static GfxTexture const invalidReturn;
     return invalidReturn;
 }
 
+SharedTextureHandle CapsaicinInternal::getSharedTextureHandle(string_view const &texture) const noexcept
+{
+    // Aliased textures resolve directly to the allocation they share
+    auto const allocation = getSharedTextureAllocation(texture);
+    if (auto const i = ranges::find_if(
+            shared_textures_, [&allocation](auto const &item) { return item.first == allocation; });
+        i != shared_textures_.cend())
+    {
+        return {static_cast<uint32_t>(distance(shared_textures_.cbegin(), i))};
+    }
+    return {};
+}
+
+GfxTexture const &CapsaicinInternal::getSharedTexture(SharedTextureHandle const handle) const noexcept
+{
+    if (handle.index < shared_textures_.size())
+    {
+        return shared_textures_[handle.index].second;
+    }
+    GFX_PRINTLN("Error: Invalid shared texture handle requested: %u", handle.index);
+    static GfxTexture const invalidReturn;
+    return invalidReturn;
+}
+
 vector<string_view> CapsaicinInternal::getDebugViews() const noexcept
 {
     vector<string_view> views;
@@ -371,6 +424,28 @@ GfxBuffer const &CapsaicinInternal::getSharedBuffer(string_view const &buffer) c
     return invalidReturn;
 }
 
+SharedBufferHandle CapsaicinInternal::getSharedBufferHandle(string_view const &buffer) const noexcept
+{
+    if (auto const i =
+            ranges::find_if(shared_buffers_, [&buffer](auto const &item) { return item.first == buffer; });
+        i != shared_buffers_.cend())
+    {
+        return {static_cast<uint32_t>(distance(shared_buffers_.cbegin(), i))};
+    }
+    return {};
+}
+
+GfxBuffer const &CapsaicinInternal::getSharedBuffer(SharedBufferHandle const handle) const noexcept
+{
+    if (handle.index < shared_buffers_.size())
+    {
+        return shared_buffers_[handle.index].second;
+    }
+    GFX_PRINTLN("Error: Invalid buffer handle requested: %u", handle.index);
+    static GfxBuffer const invalidReturn;
+    return invalidReturn;
+}
+
 bool CapsaicinInternal::hasComponent(string_view const &component) const noexcept
 {
     return ranges::any_of(components_, [&component](auto const &item) { return item.first == component; });
@@ -445,6 +520,11 @@ RenderOptionList &CapsaicinInternal::getOptions() noexcept
     return options_;
 }
 
+RenderOptionRegistry const &CapsaicinInternal::getOptionRegistry() const noexcept
+{
+    return option_registry_;
+}
+
 CameraMatrices const &CapsaicinInternal::getCameraMatrices(bool const jittered) const
 {
     return camera_matrices_[jittered];
@@ -591,22 +671,27 @@ GfxSamplerState CapsaicinInternal::getAnisotropicSampler() const
 
 GfxBuffer CapsaicinInternal::getIndexBuffer() const
 {
-    return index_buffer_;
+    return index_heap_.getBuffer();
 }
 
 GfxBuffer CapsaicinInternal::getVertexBuffer() const
 {
-    return vertex_buffer_;
+    return vertex_heap_.getBuffer();
 }
 
 GfxBuffer CapsaicinInternal::getVertexSourceBuffer() const
 {
-    return vertex_source_buffer_;
+    return vertex_source_heap_.getBuffer();
+}
+
+uint32_t CapsaicinInternal::getVertexStride() const
+{
+    return vertex_heap_.getStride();
 }
 
 GfxBuffer CapsaicinInternal::getJointBuffer() const
 {
-    return joint_buffer_;
+    return joint_heap_.getBuffer();
 }
 
 GfxBuffer CapsaicinInternal::getJointMatricesBuffer() const
@@ -691,6 +776,53 @@ GfxBuffer CapsaicinInternal::allocateConstantBuffer(uint64_t const size)
     return constant_buffer;
 }
 
+void CapsaicinInternal::uploadBufferRanges(
+    GfxBuffer const &buffer, uint32_t const stride, std::vector<BufferUpload> &uploads)
+{
+    erase_if(uploads, [](BufferUpload const &upload) { return upload.count == 0; });
+    if (uploads.empty())
+    {
+        return;
+    }
+    uint64_t upload_size = 0;
+    for (auto const &upload : uploads)
+    {
+        upload_size += static_cast<uint64_t>(upload.count) * stride;
+    }
+    ranges::sort(uploads, [](BufferUpload const &a, BufferUpload const &b) { return a.offset < b.offset; });
+
+    // Small updates use the constant buffer pool as a staging ring, large uploads (such as loading a new scene)
+    // use a temporary staging buffer so that the pool does not permanently grow to the size of the scene
+    constexpr uint64_t max_pool_upload_size = 4U << 20U;
+    GfxBuffer const    staging_buffer       = upload_size <= max_pool_upload_size
+                                                ? allocateConstantBuffer(upload_size)
+                                                : gfxCreateBuffer(gfx_, upload_size, nullptr, kGfxCpuAccess_Write);
+    auto *const        staging_data         = static_cast<uint8_t *>(gfxBufferGetData(gfx_, staging_buffer));
+
+    // Copy each contiguous range of destination elements using a single copy
+    uint64_t staging_offset = 0;
+    uint64_t range_start    = 0;
+    uint32_t range_offset   = uploads.front().offset;
+    uint32_t range_end      = range_offset;
+    for (auto const &upload : uploads)
+    {
+        if (upload.offset != range_end)
+        {
+            gfxCommandCopyBuffer(gfx_, buffer, static_cast<uint64_t>(range_offset) * stride, staging_buffer,
+                range_start, staging_offset - range_start);
+            range_start  = staging_offset;
+            range_offset = upload.offset;
+        }
+        uint64_t const size = static_cast<uint64_t>(upload.count) * stride;
+        memcpy(staging_data + staging_offset, upload.data, size);
+        staging_offset += size;
+        range_end       = upload.offset + upload.count;
+    }
+    gfxCommandCopyBuffer(gfx_, buffer, static_cast<uint64_t>(range_offset) * stride, staging_buffer,
+        range_start, staging_offset - range_start);
+    gfxDestroyBuffer(gfx_, staging_buffer);
+}
+
 GfxTexture CapsaicinInternal::createRenderTexture(
     const DXGI_FORMAT format, string_view const &name, uint32_t mips, float const scale) const noexcept
 {
@@ -767,10 +899,16 @@ GfxTexture CapsaicinInternal::resizeWindowTexture(
 
 GfxProgram CapsaicinInternal::createProgram(char const *file_name) const noexcept
 {
-    auto const  shaderPaths      = getShaderPaths();
-    // New include paths can be added here.
-    char const *include_paths[3] = {shaderPaths[0].c_str(), shaderPaths[1].c_str(), shaderPaths[2].c_str()};
-    return gfxCreateProgram(gfx_, file_name, shader_path_.c_str(), nullptr, include_paths, 3U);
+    auto const          shaderPaths = getShaderPaths();
+    // New include paths can be added to getShaderPaths.
+    vector<char const *> include_paths;
+    include_paths.reserve(shaderPaths.size());
+    for (auto const &path : shaderPaths)
+    {
+        include_paths.push_back(path.c_str());
+    }
+    return gfxCreateProgram(gfx_, file_name, shader_path_.c_str(), nullptr, include_paths.data(),
+        static_cast<uint32_t>(include_paths.size()));
 }
 
 void CapsaicinInternal::dispatchKernel(GfxKernel const &kernel, uint2 const dimensions) const noexcept
@@ -831,6 +969,10 @@ void CapsaicinInternal::initialize(GfxContext const &gfx, ImGuiContext *imgui_co
 
     gfx_ = gfx;
 
+    index_heap_.initialise(gfx_, "IndexBuffer", sizeof(uint32_t));
+    initialiseVertexHeaps();
+    joint_heap_.initialise(gfx_, "JointBuffer", sizeof(Joint));
+
     blit_program_ = createProgram("capsaicin/blit");
     blit_kernel_  = gfxCreateGraphicsKernel(gfx, blit_program_);
 
@@ -840,6 +982,12 @@ void CapsaicinInternal::initialize(GfxContext const &gfx, ImGuiContext *imgui_co
     window_dimensions_ = uint2(gfxGetBackBufferWidth(gfx), gfxGetBackBufferHeight(gfx));
     setRenderDimensionsScale(render_scale_);
 
+    // Each writer encodes a whole image so a few threads are enough to keep up with per frame captures, the
+    // memory cap allows around 16 in flight 4K RGBA16F images before the render thread is throttled
+    uint32_t const   dumpThreadCount    = std::clamp(std::thread::hardware_concurrency() / 2U, 1U, 4U);
+    constexpr size_t dumpMaxPendingSize = 1024ULL * 1024ULL * 1024ULL;
+    dump_queue_.start(&CapsaicinInternal::saveImage, dumpThreadCount, dumpMaxPendingSize);
+
     ImGui::SetCurrentContext(imgui_context);
 }
 
@@ -852,6 +1000,12 @@ void CapsaicinInternal::render()
     current_time_ = static_cast<double>(wallTime.count()) / 1000000.0;
     frame_time_   = current_time_ - previousTime;
 
+    // Pick up any option changes made since the last frame (including those made directly through getOptions)
+    option_registry_.update(options_);
+
+    // Changing the vertex layout restarts playback so must be done before the frame index is updated
+    updateVertexLayout();
+
     // Check if manual frame increment/decrement has been applied
     if (bool const manual_play = play_time_ != play_time_old_;
         !render_paused_ || manual_play || frame_index_ == numeric_limits<uint32_t>::max())
@@ -907,7 +1061,7 @@ void CapsaicinInternal::render()
 
                 if (!debug_view_.empty() && debug_view_ != "None")
                 {
-                    gfxCommandClearTexture(gfx_, getSharedTexture("Debug"));
+                    gfxCommandClearTexture(gfx_, getSharedTexture(debug_texture_));
                 }
             }
             else
@@ -967,10 +1121,9 @@ void CapsaicinInternal::render()
     }
 
     // Show debug visualizations if requested or blit Color AOV
-    currentView =
-        hasSharedTexture("ColorScaled") && hasOption<bool>("taa_enable") && getOption<bool>("taa_enable")
-            ? getSharedTexture("ColorScaled")
-            : getSharedTexture("Color");
+    currentView = color_scaled_texture_ && hasOption<bool>("taa_enable") && getOption<bool>("taa_enable")
+                    ? getSharedTexture(color_scaled_texture_)
+                    : getSharedTexture(color_texture_);
     if (!debug_view_.empty() && debug_view_ != "None")
     {
         if (auto const debugView = ranges::find_if(
@@ -990,7 +1143,7 @@ void CapsaicinInternal::render()
                     && (strstr(texture.getName(), "Depth") != nullptr
                         || strstr(texture.getName(), "depth") != nullptr)))
             {
-                auto const &debug_texture = getSharedTexture("Debug");
+                auto const &debug_texture = getSharedTexture(debug_texture_);
                 if (!debug_depth_kernel_)
                 {
                     debug_depth_program_    = createProgram("capsaicin/debug_depth");
@@ -1019,7 +1172,7 @@ void CapsaicinInternal::render()
                     && (format == DXGI_FORMAT_R32G32B32A32_FLOAT || format == DXGI_FORMAT_R32G32B32_FLOAT
                         || format == DXGI_FORMAT_R16G16B16A16_FLOAT || format == DXGI_FORMAT_R11G11B10_FLOAT))
                 {
-                    currentView = getSharedTexture("Debug");
+                    currentView = getSharedTexture(debug_texture_);
                 }
                 else
                 {
@@ -1030,7 +1183,7 @@ void CapsaicinInternal::render()
         else
         {
             // Output debug AOV
-            currentView = getSharedTexture("Debug");
+            currentView = getSharedTexture(debug_texture_);
         }
     }
     {
@@ -1060,18 +1213,19 @@ void CapsaicinInternal::render()
         }
     }
 
-    // Write out each available buffer in parallel
-    concurrency::parallel_for(0U, dump_available_buffer_count, 1U, [&](uint32_t const buffer_index) {
-        auto const &buffer = dump_in_flight_buffers_[buffer_index];
-        saveImage(get<0>(buffer), get<1>(buffer), get<2>(buffer), get<3>(buffer), get<4>(buffer));
-    });
-
+    // Hand each available buffer to the background writers, this only blocks if too many are outstanding
     for (uint32_t available_buffer_index = 0; available_buffer_index < dump_available_buffer_count;
         available_buffer_index++)
     {
-        gfxDestroyBuffer(gfx_, get<0>(dump_in_flight_buffers_.front()));
+        queueDumpBuffer(dump_in_flight_buffers_.front());
         dump_in_flight_buffers_.pop_front();
     }
+
+    // Release the buffers of any dumps that have finished writing
+    for (auto const &image : dump_queue_.takeCompleted())
+    {
+        gfxDestroyBuffer(gfx_, image.buffer);
+    }
 }
 
 void CapsaicinInternal::renderGUI(bool const readOnly)
@@ -1327,18 +1481,16 @@ void CapsaicinInternal::terminate() noexcept
     {
         gfxFinish(gfx_);
         // Dump remaining buffers, they are all available after gfxFinish
-        concurrency::parallel_for(
-            0U, static_cast<uint32_t>(dump_in_flight_buffers_.size()), 1U, [&](uint32_t const buffer_index) {
-                auto const &buffer = dump_in_flight_buffers_[buffer_index];
-                saveImage(
-                    get<0>(buffer), get<1>(buffer), get<2>(buffer), get<3>(buffer), get<4>(buffer).c_str());
-            });
-
         while (!dump_in_flight_buffers_.empty())
         {
-            gfxDestroyBuffer(gfx_, get<0>(dump_in_flight_buffers_.front()));
+            queueDumpBuffer(dump_in_flight_buffers_.front());
             dump_in_flight_buffers_.pop_front();
         }
+        dump_queue_.stop();
+        for (auto const &image : dump_queue_.takeCompleted())
+        {
+            gfxDestroyBuffer(gfx_, image.buffer);
+        }
     }
 
     render_techniques_.clear();
@@ -1354,16 +1506,16 @@ void CapsaicinInternal::terminate() noexcept
 
     gfxDestroyBuffer(gfx_, camera_matrices_buffer_[0]);
     gfxDestroyBuffer(gfx_, camera_matrices_buffer_[1]);
-    gfxDestroyBuffer(gfx_, index_buffer_);
-    gfxDestroyBuffer(gfx_, vertex_buffer_);
-    gfxDestroyBuffer(gfx_, vertex_source_buffer_);
+    index_heap_.destroy();
+    vertex_heap_.destroy();
+    vertex_source_heap_.destroy();
     gfxDestroyBuffer(gfx_, instance_buffer_);
     gfxDestroyBuffer(gfx_, material_buffer_);
     gfxDestroyBuffer(gfx_, transform_buffer_);
     gfxDestroyBuffer(gfx_, instance_id_buffer_);
     gfxDestroyBuffer(gfx_, prev_transform_buffer_);
     gfxDestroyBuffer(gfx_, morph_weight_buffer_);
-    gfxDestroyBuffer(gfx_, joint_buffer_);
+    joint_heap_.destroy();
     gfxDestroyBuffer(gfx_, joint_matrices_buffer_);
 
     gfxDestroyTexture(gfx_, environment_buffer_);
@@ -1382,6 +1534,7 @@ void CapsaicinInternal::terminate() noexcept
     shared_textures_.clear();
     backup_shared_textures_.clear();
     clear_shared_textures_.clear();
+    aliased_shared_textures_.clear();
 
     debug_views_.clear();
 
@@ -1453,6 +1606,9 @@ RenderOptionList CapsaicinInternal::getStockRenderOptions() noexcept
     newOptions.emplace(RENDER_OPTION_MAKE(capsaicin_lod_offset, render_options));
     newOptions.emplace(RENDER_OPTION_MAKE(capsaicin_lod_aggressive, render_options));
     newOptions.emplace(RENDER_OPTION_MAKE(capsaicin_mirror_roughness_threshold, render_options));
+    newOptions.emplace(RENDER_OPTION_MAKE(capsaicin_mesh_cache_path, render_options));
+    newOptions.emplace(RENDER_OPTION_MAKE(capsaicin_compact_vertices, render_options));
+    newOptions.emplace(RENDER_OPTION_MAKE(capsaicin_shared_texture_aliasing, render_options));
     return newOptions;
 }
 
@@ -1463,6 +1619,9 @@ CapsaicinInternal::RenderOptions CapsaicinInternal::convertOptions(RenderOptionL
     RENDER_OPTION_GET(capsaicin_lod_offset, newOptions, options)
     RENDER_OPTION_GET(capsaicin_lod_aggressive, newOptions, options)
     RENDER_OPTION_GET(capsaicin_mirror_roughness_threshold, newOptions, options)
+    RENDER_OPTION_GET(capsaicin_mesh_cache_path, newOptions, options)
+    RENDER_OPTION_GET(capsaicin_compact_vertices, newOptions, options)
+    RENDER_OPTION_GET(capsaicin_shared_texture_aliasing, newOptions, options)
     return newOptions;
 }
 
@@ -1534,6 +1693,7 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
     shared_textures_.clear();
     backup_shared_textures_.clear();
     clear_shared_textures_.clear();
+    aliased_shared_textures_.clear();
     // Debug views must also be cleared as shared texture views may change after re-negotiation
     debug_views_.clear();
     debug_views_.emplace_back("None", nullptr);
@@ -2358,6 +2518,77 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
             }
         }
 
+        // Find the shared textures that can reuse the allocation of another one
+        unordered_map<string_view, string_view> aliasedTextures;
+        unordered_set<string_view>              sharedAllocations;
+        if (convertOptions(getOptions()).capsaicin_shared_texture_aliasing)
+        {
+            SharedTextureAliasing                aliasing;
+            vector<string_view>                  textureNames;
+            unordered_map<string_view, uint32_t> textureIndices;
+            unordered_set<string_view>           componentTextures;
+            for (auto const &i : components_)
+            {
+                for (auto &j : i.second->getSharedTextures())
+                {
+                    componentTextures.insert(j.name);
+                }
+            }
+            for (auto const &[textureName, textureParams] : requestedTextures)
+            {
+                if (textureParams.format == DXGI_FORMAT_UNKNOWN)
+                {
+                    continue;
+                }
+                // Textures kept across frames, accessed by components or used after the render techniques
+                // (display, debug and depth views) must keep their own allocation
+                bool const transient =
+                    !(textureParams.flags & SharedTexture::Flags::Accumulate) && textureParams.backup.empty()
+                    && !componentTextures.contains(textureName) && textureName != "Color"
+                    && textureName != "ColorScaled" && textureName != "Debug" && textureName != "Depth";
+                bool const  autoSize   = any(equal(textureParams.dimensions, uint2(0)));
+                uint2 const dimensions = autoSize ? render_dimensions_ : textureParams.dimensions;
+                // Auto sized textures are resized with the window so must not share with fixed sized ones
+                uint64_t const key = (static_cast<uint64_t>(textureParams.format) << 49)
+                                   | (static_cast<uint64_t>(textureParams.mips) << 48)
+                                   | (autoSize ? 0 : (uint64_t {dimensions.x} << 24 | dimensions.y));
+                uint64_t size =
+                    uint64_t {dimensions.x} * dimensions.y * GetBitsPerPixel(textureParams.format) / 8;
+                if (textureParams.mips)
+                {
+                    size = size * 4 / 3;
+                }
+                bool const cleared = !!(textureParams.flags & SharedTexture::Flags::Clear);
+                textureIndices.try_emplace(textureName, aliasing.addTexture(key, size, transient, cleared));
+                textureNames.push_back(textureName);
+            }
+            // Render techniques are executed in order, each one being a separate pass
+            for (uint32_t pass = 0; pass < static_cast<uint32_t>(render_techniques_.size()); ++pass)
+            {
+                for (auto const &j : render_techniques_[pass]->getSharedTextures())
+                {
+                    if (auto const k = textureIndices.find(j.name); k != textureIndices.end())
+                    {
+                        aliasing.addAccess(k->second, pass, j.access != SharedTexture::Access::Write);
+                    }
+                }
+            }
+            aliasing.pack();
+            for (uint32_t i = 0; i < static_cast<uint32_t>(textureNames.size()); ++i)
+            {
+                if (uint32_t const allocation = aliasing.getAllocation(i); allocation != i)
+                {
+                    aliasedTextures.try_emplace(textureNames[i], textureNames[allocation]);
+                    sharedAllocations.insert(textureNames[i]);
+                    sharedAllocations.insert(textureNames[allocation]);
+                }
+            }
+            GFX_PRINTLN("Shared texture aliasing: %u textures in %u allocations, %llu of %llu MiB saved",
+                static_cast<uint32_t>(textureNames.size()), aliasing.getAllocationCount(),
+                static_cast<unsigned long long>((aliasing.getTotalSize() - aliasing.getAliasedSize()) >> 20),
+                static_cast<unsigned long long>(aliasing.getTotalSize() >> 20));
+        }
+
         // Create all requested shared textures
         for (auto &[textureName, textureParams] : requestedTextures)
         {
@@ -2367,6 +2598,10 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
                     "Error: Requested shared texture does not have valid format: %s", textureName.data());
                 continue;
             }
+            if (aliasedTextures.contains(textureName))
+            {
+                continue; // added once the texture owning its allocation has been created
+            }
 
             // Create new texture
             constexpr array clear = {0.0F, 0.0F, 0.0F, 0.0F};
@@ -2459,18 +2694,34 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
             // Add to texture list
             shared_textures_.emplace_back(textureName, texture);
 
-            // Add the shared texture as a debug view (Using false to differentiate as shared texture)
-            if (textureName != "Color" && textureName != "Debug" && textureName != "ColorScaled")
+            // Add the shared texture as a debug view (Using false to differentiate as shared texture), shared
+            // allocations are skipped as they only hold the contents of their last user
+            if (textureName != "Color" && textureName != "Debug" && textureName != "ColorScaled"
+                && !sharedAllocations.contains(textureName))
             {
                 debug_views_.emplace_back(textureName, false);
             }
         }
 
+        // Add the aliased textures
+        for (auto const &[textureName, allocationName] : aliasedTextures)
+        {
+            auto const allocation = ranges::find_if(shared_textures_,
+                [&allocationName](auto const &item) { return item.first == allocationName; });
+            aliased_shared_textures_.emplace_back(
+                textureName, static_cast<uint32_t>(distance(shared_textures_.begin(), allocation)));
+        }
+
         // Initialise the shared textures
         for (auto const &i : shared_textures_)
         {
             gfxCommandClearTexture(gfx_, i.second);
         }
+
+        // Resolve the stock textures used when displaying each frame
+        color_texture_        = getSharedTextureHandle("Color");
+        color_scaled_texture_ = getSharedTextureHandle("ColorScaled");
+        debug_texture_        = getSharedTextureHandle("Debug");
     }
 
     {
@@ -2516,6 +2767,28 @@ void CapsaicinInternal::negotiateRenderTechniques() noexcept
     }
 }
 
+string_view CapsaicinInternal::getSharedTextureAllocation(string_view const &texture) const noexcept
+{
+    if (auto const i = ranges::find_if(
+            aliased_shared_textures_, [&texture](auto const &item) { return item.first == texture; });
+        i != aliased_shared_textures_.cend())
+    {
+        return shared_textures_[i->second].first;
+    }
+    return texture;
+}
+
+uint32_t CapsaicinInternal::getComponentIndex(string_view const &component) const noexcept
+{
+    if (auto const i =
+            ranges::find_if(components_, [&component](auto const &item) { return item.first == component; });
+        i != components_.cend())
+    {
+        return static_cast<uint32_t>(distance(components_.cbegin(), i));
+    }
+    return ComponentHandle<Component>::InvalidIndex;
+}
+
 bool CapsaicinInternal::setupRenderTechniques(string_view const &name) noexcept
 {
     // Clear any existing shared textures
@@ -2542,6 +2815,9 @@ bool CapsaicinInternal::setupRenderTechniques(string_view const &name) noexcept
 
     // Get default internal options
     options_ = getStockRenderOptions();
+    option_registry_.compile(options_);
+    stock_option_group_      = option_registry_.addGroup("Capsaicin", options_);
+    stock_option_generation_ = 0;
 
     // Create the new renderer
     renderer_ = RendererFactory::make(name);
@@ -2688,6 +2964,18 @@ bool CapsaicinInternal::setupRenderTechniques(string_view const &name) noexcept
         }
     }
 
+    // Compile the final options and group them by owner so each can cheaply check for changes
+    option_registry_.compile(options_);
+    stock_option_group_ = option_registry_.addGroup("Capsaicin", getStockRenderOptions());
+    for (auto const &i : render_techniques_)
+    {
+        option_registry_.addGroup(i->getName(), i->getRenderOptions());
+    }
+    for (auto const &i : components_)
+    {
+        option_registry_.addGroup(i.second->getName(), i.second->getRenderOptions());
+    }
+
     negotiateRenderTechniques();
 
     // If no scene currently loaded then delay initialisation till scene load
@@ -2721,6 +3009,43 @@ bool CapsaicinInternal::setupRenderTechniques(string_view const &name) noexcept
     return true;
 }
 
+void CapsaicinInternal::initialiseVertexHeaps() noexcept
+{
+    uint32_t const vertexSize = compact_vertices_ ? sizeof(CompactVertex) : sizeof(Vertex);
+    // NVIDIA-specific fix
+    uint32_t const vertexBufferStride = gfx_.getVendorId() == 0x10DEU ? 4 : 0;
+    vertex_heap_.initialise(gfx_, "VertexBuffer", vertexSize, vertexBufferStride);
+    vertex_source_heap_.initialise(gfx_, "VertexSourceBuffer", vertexSize);
+}
+
+void CapsaicinInternal::updateVertexLayout() noexcept
+{
+    if (option_registry_.getGroupGeneration(stock_option_group_) <= stock_option_generation_)
+    {
+        return;
+    }
+    bool const compactVertices = convertOptions(getOptions()).capsaicin_compact_vertices;
+    if (compactVertices == compact_vertices_)
+    {
+        return;
+    }
+    gfxFinish(gfx_); // flush & sync
+    compact_vertices_ = compactVertices;
+
+    // The existing vertex data cannot be converted in place so force all meshes to be re-built
+    vertex_heap_.destroy();
+    vertex_source_heap_.destroy();
+    initialiseVertexHeaps();
+    mesh_tracker_.reset();
+
+    // Every shader that accesses vertices must be recompiled against the new layout
+    gfxDestroyKernel(gfx_, generate_animated_vertices_kernel_);
+    gfxDestroyProgram(gfx_, generate_animated_vertices_program_);
+    generate_animated_vertices_program_ = createProgram("capsaicin/generate_animated_vertices");
+    generate_animated_vertices_kernel_  = gfxCreateComputeKernel(gfx_, generate_animated_vertices_program_);
+    reloadShaders();
+}
+
 void CapsaicinInternal::resetPlaybackState() noexcept
 {
     // Reset frame index
@@ -22,8 +22,13 @@ THE SOFTWARE.
 #pragma once
 
 #include "capsaicin.h"
+#include "geometry_heap.h"
 #include "gpu_shared.h"
 #include "graph.h"
+#include "hash_reduce.h"
+#include "image_dump_queue.h"
+#include "mesh_builder.h"
+#include "render_option_registry.h"
 #include "renderer.h"
 
 #include <deque>
@@ -221,6 +226,13 @@ class CapsaicinInternal
      */
     [[nodiscard]] bool getTransformsUpdated() const noexcept;
 
+    /**
+     * Gets the scene instances whose transform changed this frame.
+     * @note Only valid when getTransformsUpdated() returns true.
+     * @return The list of changed instance indices (indices into the scene instance list).
+     */
+    [[nodiscard]] std::vector<uint32_t> const &getTransformsChanged() const noexcept;
+
     /**
      * Check if the scenes instance data was changed this frame (not including transforms).
      * @return True if instance data has changed.
@@ -260,7 +272,7 @@ class CapsaicinInternal
     [[nodiscard]] bool getEnvironmentMapUpdated() const noexcept;
 
     /**
-     * Gets the list of currently available shared textures.
+     * Gets the list of currently available shared textures, including those aliasing another's allocation.
      * @return The shared texture list.
      */
     [[nodiscard]] std::vector<std::string_view> getSharedTextures() const noexcept;
@@ -288,6 +300,22 @@ class CapsaicinInternal
      */
     [[nodiscard]] GfxTexture const &getSharedTexture(std::string_view const &texture) const noexcept;
 
+    /**
+     * Resolves the name of a shared texture to a handle that can be used for repeated access.
+     * @note Handles are invalidated whenever render techniques are re-negotiated, they should therefore be
+     * resolved in a render technique's `init` function.
+     * @param texture The name of the shared texture to search for.
+     * @return The texture handle, or an invalid handle if not found.
+     */
+    [[nodiscard]] SharedTextureHandle getSharedTextureHandle(std::string_view const &texture) const noexcept;
+
+    /**
+     * Gets a shared texture using a previously resolved handle.
+     * @param handle The handle of the shared texture to get (see @getSharedTextureHandle()).
+     * @return The requested texture or null texture if handle is invalid.
+     */
+    [[nodiscard]] GfxTexture const &getSharedTexture(SharedTextureHandle handle) const noexcept;
+
     /**
      * Checks whether a debug view is of a shared texture.
      * @param view The name of the debug view to check.
@@ -322,6 +350,21 @@ class CapsaicinInternal
      */
     [[nodiscard]] GfxBuffer const &getSharedBuffer(std::string_view const &buffer) const noexcept;
 
+    /**
+     * Resolves the name of a shared buffer to a handle that can be used for repeated access.
+     * @note Handles are invalidated whenever render techniques are re-negotiated.
+     * @param buffer The name of the buffer to search for.
+     * @return The buffer handle, or an invalid handle if not found.
+     */
+    [[nodiscard]] SharedBufferHandle getSharedBufferHandle(std::string_view const &buffer) const noexcept;
+
+    /**
+     * Gets a shared buffer using a previously resolved handle.
+     * @param handle The handle of the buffer to get (see @getSharedBufferHandle()).
+     * @return The requested buffer or null buffer if handle is invalid.
+     */
+    [[nodiscard]] GfxBuffer const &getSharedBuffer(SharedBufferHandle handle) const noexcept;
+
     /**
      * Query if a shared component currently exists.
      * @param component The Component to search for.
@@ -348,6 +391,37 @@ class CapsaicinInternal
         return std::dynamic_pointer_cast<T>(getComponent(static_cast<std::string_view>(toStaticString<T>())));
     }
 
+    /**
+     * Resolves a shared component to a handle that can be used for repeated access.
+     * @note Handles are invalidated whenever render techniques are re-negotiated.
+     * @tparam T The type of component to search for.
+     * @return The component handle, or an invalid handle if not found or not of the requested type.
+     */
+    template<typename T>
+    [[nodiscard]] ComponentHandle<T> getComponentHandle() const noexcept
+    {
+        auto const index = getComponentIndex(static_cast<std::string_view>(toStaticString<T>()));
+        if (index >= components_.size() || dynamic_cast<T *>(components_[index].second.get()) == nullptr)
+        {
+            return {};
+        }
+        return {index};
+    }
+
+    /**
+     * Gets a shared component using a previously resolved handle.
+     * @tparam T The type of component.
+     * @param handle The handle of the component to get (see @getComponentHandle()).
+     * @return The requested component or nullptr if handle is invalid.
+     */
+    template<typename T>
+    [[nodiscard]] T *getComponent(ComponentHandle<T> const handle) const noexcept
+    {
+        // The type was already checked when the handle was resolved
+        return handle.index < components_.size() ? static_cast<T *>(components_[handle.index].second.get())
+                                                 : nullptr;
+    }
+
     /**
      * Gets the list of supported renderers.
      * @return The renderers list.
@@ -484,6 +558,14 @@ class CapsaicinInternal
     [[nodiscard]] RenderOptionList const &getOptions() const noexcept;
     [[nodiscard]] RenderOptionList       &getOptions() noexcept;
 
+    /**
+     * Gets the compiled render options.
+     * The registry is synchronised with the render options at the start of each frame and contains a group
+     * for the options of each render technique and component (named using their getName()).
+     * @return The render option registry.
+     */
+    [[nodiscard]] RenderOptionRegistry const &getOptionRegistry() const noexcept;
+
     /**
      * Checks if an options exists with the specified type.
      * @tparam T Generic type parameter of the requested option.
@@ -672,6 +754,7 @@ class CapsaicinInternal
     [[nodiscard]] GfxBuffer getIndexBuffer() const;
     [[nodiscard]] GfxBuffer getVertexBuffer() const;
     [[nodiscard]] GfxBuffer getVertexSourceBuffer() const;
+    [[nodiscard]] uint32_t  getVertexStride() const;
     [[nodiscard]] GfxBuffer getJointBuffer() const;
     [[nodiscard]] GfxBuffer getJointMatricesBuffer() const;
     [[nodiscard]] GfxBuffer getMorphWeightBuffer() const;
@@ -701,6 +784,24 @@ class CapsaicinInternal
 
     [[nodiscard]] GfxBuffer allocateConstantBuffer(uint64_t size);
 
+    /** A range of elements to be uploaded into a GPU buffer. */
+    struct BufferUpload
+    {
+        uint32_t    offset; /**< Destination offset in elements */
+        uint32_t    count;  /**< Number of elements */
+        void const *data;   /**< Source data */
+    };
+
+    /**
+     * Upload multiple ranges of data into an existing GPU buffer.
+     * All ranges are packed into a single staging buffer (taken from the constant buffer pool for small
+     * uploads) and are copied using a single copy command for each contiguous range of destination elements.
+     * @param buffer  The destination buffer.
+     * @param stride  The size of each element in bytes.
+     * @param uploads The ranges to upload, these are sorted by offset.
+     */
+    void uploadBufferRanges(GfxBuffer const &buffer, uint32_t stride, std::vector<BufferUpload> &uploads);
+
     /**
      * Create a new texture sized according to the render resolution.
      * @param format The internal format for the new texture.
@@ -819,20 +920,6 @@ class CapsaicinInternal
      */
     std::vector<NodeTimestamps> getProfiling() noexcept;
 
-    struct MeshInfo
-    {
-        uint vertex_offset_idx[2];
-        uint index_offset_idx;
-        uint index_count;
-        uint vertex_source_offset_idx;
-        uint joints_offset;
-        uint targets_count;
-        uint vertex_count;
-        uint meshlet_count;      /**< Number of meshlets in mesh */
-        uint meshlet_offset_idx; /**< Absolute offset into Meshlet buffer for first meshlet */
-        bool is_animated;
-    };
-
     // I need more information about the scene for now. It's the easy way how to get the per instance vertex count. 
     const MeshInfo& getMeshInfo(uint32_t index) { return mesh_infos_[index]; }
 
@@ -851,6 +938,13 @@ class CapsaicinInternal
                                                   mesh size but with potential to destroy mesh topology) */
         float capsaicin_mirror_roughness_threshold =
             0.1f; /**< The threshold below which to force mirror reflections */
+        std::string capsaicin_mesh_cache_path =
+            ""; /**< Directory used to cache processed mesh data between runs (empty to disable) */
+        bool capsaicin_compact_vertices = false; /**< Store GPU vertices using the compressed CompactVertex
+                                                    layout (changing requires all shaders to be rebuilt) */
+        bool capsaicin_shared_texture_aliasing =
+            false; /**< Share allocations between shared textures whose lifetimes within a frame do not
+                      overlap (only applied when the renderer is set up) */
     };
 
     /**
@@ -895,6 +989,20 @@ class CapsaicinInternal
      */
     void negotiateRenderTechniques() noexcept;
 
+    /**
+     * Gets the shared texture owning the allocation used by a shared texture.
+     * @param texture The name of the shared texture.
+     * @return The name of the shared texture owning the allocation (texture itself if not aliased).
+     */
+    [[nodiscard]] std::string_view getSharedTextureAllocation(std::string_view const &texture) const noexcept;
+
+    /**
+     * Gets the index of a shared component.
+     * @param component The name of the component to search for.
+     * @return The index of the component within the component list, or an invalid index if not found.
+     */
+    [[nodiscard]] uint32_t getComponentIndex(std::string_view const &component) const noexcept;
+
     /**
      * Sets up the render techniques for the currently set renderer.
      * This will set up any required shared textures, views or buffers required for all specified render
@@ -903,6 +1011,17 @@ class CapsaicinInternal
      */
     [[nodiscard]] bool setupRenderTechniques(std::string_view const &name) noexcept;
 
+    /**
+     * Initialise the vertex geometry heaps using the element size of the current vertex layout.
+     */
+    void initialiseVertexHeaps() noexcept;
+
+    /**
+     * Switch between the default and compact vertex layouts if the corresponding render option has changed.
+     * This re-creates the vertex buffers and reloads all shaders.
+     */
+    void updateVertexLayout() noexcept;
+
     /**
      * Reset current frame index and duration state.
      * This should be called whenever any renderer or scene changes are made.
@@ -1001,12 +1120,35 @@ class CapsaicinInternal
     void updateSceneBVH(bool animationGPUUpdated) noexcept;
 
     void dumpTexture(std::filesystem::path const &filePath, GfxTexture const &texture);
-    void saveImage(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
-        uint32_t dumpBufferHeight, std::filesystem::path const &filePath);
-    void saveEXR(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
-        uint32_t dumpBufferHeight, std::filesystem::path const &filePath);
-    void saveJPG(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
-        uint32_t dumpBufferHeight, std::filesystem::path const &filePath) const;
+
+    /**
+     * Pass a completed dump readback to the background writers.
+     * @param dumpBuffer The in flight dump request, its readback must have completed.
+     */
+    void queueDumpBuffer(std::tuple<GfxBuffer, DXGI_FORMAT, uint32_t, uint32_t, std::filesystem::path,
+        uint32_t> const &dumpBuffer) noexcept;
+
+    /** A completed dump readback waiting to be written by the background writers. */
+    struct DumpImage
+    {
+        GfxBuffer             buffer;                        /**< The readback buffer owning the image data */
+        void const           *data   = nullptr;             /**< Mapped contents of the readback buffer */
+        DXGI_FORMAT           format = DXGI_FORMAT_UNKNOWN; /**< Format of the image data */
+        uint32_t              width  = 0;                   /**< Width of the image in pixels */
+        uint32_t              height = 0;                   /**< Height of the image in pixels */
+        std::filesystem::path filePath;                      /**< Path of the file to write */
+    };
+
+    /**
+     * Encode and write an image.
+     * This is called from the dump worker threads so must not touch the gfx context.
+     * @param image The image to write.
+     */
+    static void saveImage(DumpImage const &image) noexcept;
+    static void saveEXR(void const *bufferData, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
+        uint32_t dumpBufferHeight, std::filesystem::path const &filePath) noexcept;
+    static void saveJPG(void const *bufferData, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
+        uint32_t dumpBufferHeight, std::filesystem::path const &filePath) noexcept;
     void dumpCamera(CameraMatrices const &cameraMatrices, float cameraJitterX, float cameraJitterY,
         std::filesystem::path const &filePath) const;
 
@@ -1018,9 +1160,12 @@ class CapsaicinInternal
         uint32_t targets_count;
     };
 
-    size_t mesh_hash_                 = 0;
-    size_t transform_hash_            = 0;
-    size_t material_hash_             = 0;
+    HashTracker mesh_tracker_;      /**< Per mesh change tracking */
+    HashTracker transform_tracker_; /**< Per instance transform change tracking */
+    HashTracker instance_tracker_;  /**< Per instance mesh/material reference change tracking */
+    HashTracker material_tracker_;  /**< Per material change tracking */
+
+    bool   meshes_rebuilt_            = true; /**< True if mesh buffers were rebuilt this frame */
     bool   render_dimensions_updated_ = false;
     bool   window_dimensions_updated_ = false;
     bool   mesh_updated_              = true;
@@ -1071,6 +1216,10 @@ class CapsaicinInternal
     GfxCamera camera_prev_backup_;      /**< Backup of the camera used in the previous frame */
 
     RenderOptionList options_; /**< Options for controlling the operation of each render technique */
+    RenderOptionRegistry option_registry_; /**< Compiled view of options_ used to track option changes */
+    RenderOptionRegistry::GroupHandle stock_option_group_ =
+        RenderOptionRegistry::InvalidGroupHandle; /**< Option group containing the stock render options */
+    uint64_t stock_option_generation_ = 0; /**< Option generation last used to convert the stock options */
 
     std::vector<std::unique_ptr<RenderTechnique>>
         render_techniques_; /**< The list of render techniques to be applied. */
@@ -1092,10 +1241,16 @@ class CapsaicinInternal
     using SharedTexturesList = std::vector<std::pair<std::string_view /*name*/, GfxTexture>>;
     using TextureBackupList  = std::vector<std::pair<uint32_t /*Source*/, uint32_t /*Destination*/>>;
     using TextureClearList   = std::vector<uint32_t>;
+    using TextureAliasList   = std::vector<std::pair<std::string_view /*name*/, uint32_t /*Allocation*/>>;
     SharedTexturesList
         shared_textures_; /**< The list of shared textures populated by the render techniques. */
-    TextureBackupList backup_shared_textures_; /**< The list of shared textures to back up each frame */
-    TextureClearList  clear_shared_textures_;  /**< List of shared textures to clear each frame */
+    TextureBackupList backup_shared_textures_;  /**< The list of shared textures to back up each frame */
+    TextureClearList  clear_shared_textures_;   /**< List of shared textures to clear each frame */
+    TextureAliasList  aliased_shared_textures_; /**< List of shared textures reusing another's allocation */
+
+    SharedTextureHandle color_texture_;        /**< Handle of the stock "Color" shared texture */
+    SharedTextureHandle color_scaled_texture_; /**< Handle of the stock "ColorScaled" shared texture */
+    SharedTextureHandle debug_texture_;        /**< Handle of the stock "Debug" shared texture */
     using SharedBuffersList = std::vector<std::pair<std::string_view, GfxBuffer>>;
     SharedBuffersList shared_buffers_;       /**< The list of buffers populated by the render techniques. */
     TextureClearList  clear_shared_buffers_; /**< List of shared buffers to clear each frame */
@@ -1117,18 +1272,34 @@ class CapsaicinInternal
     GfxSamplerState                              linear_wrap_sampler_;
     GfxSamplerState                              nearest_sampler_;
     GfxSamplerState                              anisotropic_sampler_;
-    GfxBuffer index_buffer_;  /**< The buffer storing all indices so it can be accessed via RT. */
-    GfxBuffer vertex_buffer_; /**< The buffer storing all vertices so it can be accessed via RT. */
-    uint32_t  vertex_data_index_      = 0; /**< Animated vertices data frame index for the current frame. */
-    uint32_t  prev_vertex_data_index_ = 0; /**< Animated vertices data frame index for the previous frame. */
-    GfxBuffer vertex_source_buffer_;       /**< The buffer storing vertices source data for animation. */
-    GfxBuffer morph_weight_buffer_;        /**< The buffer storing weights for morph targets animation. */
-    GfxBuffer joint_buffer_;               /**< The buffer storing per vertex joint indices and weights. */
+    GeometryHeap index_heap_;  /**< The buffer storing all indices so it can be accessed via RT. */
+    GeometryHeap vertex_heap_; /**< The buffer storing all vertices so it can be accessed via RT. */
+    uint32_t     vertex_data_index_      = 0; /**< Animated vertices data frame index for the current frame. */
+    uint32_t     prev_vertex_data_index_ = 0; /**< Animated vertices data frame index for the previous frame. */
+    GeometryHeap vertex_source_heap_;         /**< The buffer storing vertices source data for animation. */
+    GfxBuffer    morph_weight_buffer_;        /**< The buffer storing weights for morph targets animation. */
+    GeometryHeap joint_heap_;                 /**< The buffer storing per vertex joint indices and weights. */
+    bool         compact_vertices_ = false;   /**< True if the vertex heaps use the CompactVertex layout. */
     std::vector<uint32_t>           joint_matrices_offsets_;
     GfxBuffer                       joint_matrices_buffer_; /**< The buffer storing joint matrices. */
     std::vector<InstanceSourceInfo> instance_source_info_data_;
 
+    /** Location of each meshes data within the geometry heaps. */
+    struct MeshAllocation
+    {
+        uint32_t index_count         = 0;
+        uint32_t vertex_count        = 0;
+        uint32_t vertex_source_count = 0;
+        uint32_t joint_count         = 0;
+        uint32_t meshlet_count       = 0;
+        uint32_t meshlet_pack_offset = 0;
+        uint32_t meshlet_pack_count  = 0;
+    };
+
     std::vector<MeshInfo>               mesh_infos_;
+    std::vector<MeshAllocation>         mesh_allocations_; /**< Per mesh heap allocations, indexed by handle */
+    FreeListAllocator                   meshlet_allocator_;      /**< Allocator for Meshlets/MeshletCull */
+    FreeListAllocator                   meshlet_pack_allocator_; /**< Allocator for MeshletPack */
     GfxAccelerationStructure            acceleration_structure_;
     std::vector<GfxRaytracingPrimitive> raytracing_primitives_;
     uint32_t                            sbt_stride_in_entries_[kGfxShaderGroupType_Count] = {};
@@ -1140,8 +1311,9 @@ class CapsaicinInternal
 
     std::deque<std::tuple<GfxBuffer, DXGI_FORMAT, uint32_t /*width*/, uint32_t /*height*/,
         std::filesystem::path, uint32_t /*remainingDelay*/>>
-               dump_in_flight_buffers_; /**< In flight dumpDebugView requests */
-    GfxKernel  generate_animated_vertices_kernel_;
-    GfxProgram generate_animated_vertices_program_;
+                              dump_in_flight_buffers_; /**< In flight dumpDebugView requests */
+    ImageDumpQueue<DumpImage> dump_queue_;             /**< Background writers for completed dump requests */
+    GfxKernel                 generate_animated_vertices_kernel_;
+    GfxProgram                generate_animated_vertices_program_;
 };
 } // namespace Capsaicin
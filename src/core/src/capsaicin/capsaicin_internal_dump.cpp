@@ -21,6 +21,7 @@ THE SOFTWARE.
 ********************************************************************/
 #include "capsaicin_internal.h"
 
+#include <array>
 #include <format>
 #include <fstream>
 #include <sstream>
@@ -30,7 +31,7 @@ THE SOFTWARE.
 namespace Capsaicin
 {
 
-static uint32_t GetBitsPerPixel(const DXGI_FORMAT format) noexcept
+uint32_t GetBitsPerPixel(const DXGI_FORMAT format) noexcept
 {
     switch (format)
     {
@@ -171,6 +172,48 @@ static T ConvertType(TFrom source) noexcept
     }
 }
 
+/**
+ * Split interleaved pixel data into separate planes, converting the type of each value.
+ * The channel counts are made compile time constants so the inner loop has a fixed stride and no branches,
+ * allowing the compiler to vectorise it.
+ * @tparam T                 Type of the output values.
+ * @tparam TFrom             Type of the input values.
+ * @tparam InputChannelCount Number of interleaved input channels.
+ * @tparam ChannelCount      Number of leading input channels to output.
+ * @param source     The interleaved input values.
+ * @param pixelCount Number of pixels to convert.
+ * @param outputs    Output plane for each input channel.
+ */
+template<typename T, typename TFrom, uint32_t InputChannelCount, uint32_t ChannelCount>
+static void DeinterleaveChannels(
+    TFrom const *source, size_t const pixelCount, std::array<T *, 4> const &outputs) noexcept
+{
+    static_assert(ChannelCount <= InputChannelCount);
+    // Single pass over the input so each interleaved pixel is only read once
+    for (size_t pixel = 0; pixel < pixelCount; ++pixel)
+    {
+        for (uint32_t channel = 0; channel < ChannelCount; ++channel)
+        {
+            outputs[channel][pixel] = ConvertType<T, TFrom>(source[InputChannelCount * pixel + channel]);
+        }
+    }
+}
+
+template<typename T, typename TFrom>
+static void DeinterleaveChannels(TFrom const *source, uint32_t const inputChannelCount,
+    uint32_t const channelCount, size_t const pixelCount, std::array<T *, 4> const &outputs) noexcept
+{
+    switch (inputChannelCount * 4 + channelCount)
+    {
+    case 1 * 4 + 1: DeinterleaveChannels<T, TFrom, 1, 1>(source, pixelCount, outputs); break;
+    case 2 * 4 + 2: DeinterleaveChannels<T, TFrom, 2, 2>(source, pixelCount, outputs); break;
+    case 3 * 4 + 3: DeinterleaveChannels<T, TFrom, 3, 3>(source, pixelCount, outputs); break;
+    case 4 * 4 + 3: DeinterleaveChannels<T, TFrom, 4, 3>(source, pixelCount, outputs); break;
+    case 4 * 4 + 4: DeinterleaveChannels<T, TFrom, 4, 4>(source, pixelCount, outputs); break;
+    default:        GFX_ASSERT(false); break;
+    }
+}
+
 void CapsaicinInternal::dumpDebugView(std::filesystem::path const &filePath, std::string_view const &texture)
 {
     if (filePath.has_extension())
@@ -294,31 +337,46 @@ void CapsaicinInternal::dumpTexture(std::filesystem::path const &filePath, GfxTe
         filePath, gfxGetBackBufferCount(gfx_));
 }
 
-void CapsaicinInternal::saveImage(GfxBuffer const &dumpBuffer, const DXGI_FORMAT bufferFormat,
-    uint32_t const dumpBufferWidth, uint32_t const dumpBufferHeight, std::filesystem::path const &filePath)
+void CapsaicinInternal::queueDumpBuffer(std::tuple<GfxBuffer, DXGI_FORMAT, uint32_t, uint32_t,
+    std::filesystem::path, uint32_t> const &dumpBuffer) noexcept
 {
-    if (filePath.has_extension())
+    // The mapped readback memory is handed over directly, the buffer is destroyed once the job completes
+    DumpImage image;
+    image.buffer   = get<0>(dumpBuffer);
+    image.data     = gfxBufferGetData(gfx_, image.buffer);
+    image.format   = get<1>(dumpBuffer);
+    image.width    = get<2>(dumpBuffer);
+    image.height   = get<3>(dumpBuffer);
+    image.filePath = get<4>(dumpBuffer);
+
+    size_t const bytes = image.buffer.getSize();
+    dump_queue_.push(std::move(image), bytes);
+}
+
+void CapsaicinInternal::saveImage(DumpImage const &image) noexcept
+{
+    if (image.filePath.has_extension())
     {
-        auto extension = filePath.extension().string();
+        auto extension = image.filePath.extension().string();
         std::ranges::transform(extension, extension.begin(), tolower);
         if (extension == ".jpg" || extension == ".jpeg")
         {
-            saveJPG(dumpBuffer, bufferFormat, dumpBufferWidth, dumpBufferHeight, filePath);
+            saveJPG(image.data, image.format, image.width, image.height, image.filePath);
         }
         else if (extension == ".exr")
         {
-            saveEXR(dumpBuffer, bufferFormat, dumpBufferWidth, dumpBufferHeight, filePath);
+            saveEXR(image.data, image.format, image.width, image.height, image.filePath);
         }
         else
         {
             GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Can't save '%s': Unknown file extension",
-                filePath.string().c_str());
+                image.filePath.string().c_str());
         }
     }
 }
 
-void CapsaicinInternal::saveEXR(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferFormat,
-    uint32_t dumpBufferWidth, uint32_t dumpBufferHeight, std::filesystem::path const &filePath)
+void CapsaicinInternal::saveEXR(void const *bufferData, DXGI_FORMAT bufferFormat, uint32_t dumpBufferWidth,
+    uint32_t dumpBufferHeight, std::filesystem::path const &filePath) noexcept
 {
     uint32_t const inputChannelCount = GetNumChannels(bufferFormat);
     GFX_ASSERT(inputChannelCount > 0 && inputChannelCount <= 4);
@@ -342,7 +400,6 @@ void CapsaicinInternal::saveEXR(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferF
     }
 
     // Image
-    void const    *bufferData         = gfxBufferGetData(gfx_, dumpBuffer);
     uint32_t const imageWidth         = dumpBufferWidth;
     uint32_t const imageHeight        = dumpBufferHeight;
     uint32_t const imagePixelCount    = dumpBufferWidth * dumpBufferHeight;
@@ -388,29 +445,16 @@ void CapsaicinInternal::saveEXR(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferF
     std::vector<unsigned char *>      images(channelNames.size());
     std::vector<std::vector<uint8_t>> image_channels(channelNames.size());
     auto fillImages = [&]<typename T, typename TFrom>(TFrom const *dumpBufferData) {
-        uint32_t channel = 0;
-        for (char const &channel_name : channelNames)
+        // Channel names are stored in reverse order of the interleaved input channels
+        std::array<T *, 4> outputs {};
+        for (uint32_t channel = 0; channel < channelCount; ++channel)
         {
-            int channelOffset = 0;
-            switch (channel_name)
-            {
-            case 'R': channelOffset = 0; break;
-            case 'G': channelOffset = 1; break;
-            case 'B': channelOffset = 2; break;
-            case 'A': channelOffset = 3; break;
-            default:  assert(false);
-            }
             auto &imageChannel = image_channels[channel];
             imageChannel.resize(imagePixelCount * sizeof(T));
-            images[channel] = imageChannel.data();
-            for (size_t pixel_index = 0; pixel_index < imagePixelCount; ++pixel_index)
-            {
-                auto val =
-                    dumpBufferData[inputChannelCount * pixel_index + static_cast<size_t>(channelOffset)];
-                reinterpret_cast<T *>(imageChannel.data())[pixel_index] = ConvertType<T, TFrom>(val);
-            }
-            ++channel;
+            images[channel]                     = imageChannel.data();
+            outputs[channelCount - channel - 1] = reinterpret_cast<T *>(imageChannel.data());
         }
+        DeinterleaveChannels<T>(dumpBufferData, inputChannelCount, channelCount, imagePixelCount, outputs);
     };
     if (requiresConversion)
     {
@@ -455,12 +499,11 @@ void CapsaicinInternal::saveEXR(GfxBuffer const &dumpBuffer, DXGI_FORMAT bufferF
     }
 }
 
-void CapsaicinInternal::saveJPG(GfxBuffer const &dumpBuffer, const DXGI_FORMAT bufferFormat,
+void CapsaicinInternal::saveJPG(void const *bufferData, const DXGI_FORMAT bufferFormat,
     uint32_t const dumpBufferWidth, uint32_t const dumpBufferHeight,
-    std::filesystem::path const &filePath) const
+    std::filesystem::path const &filePath) noexcept
 {
     // Image
-    void const    *bufferData      = gfxBufferGetData(gfx_, dumpBuffer);
     uint32_t const imageWidth      = dumpBufferWidth;
     uint32_t const imageHeight     = dumpBufferHeight;
     uint32_t const imagePixelCount = dumpBufferWidth * dumpBufferHeight;
@@ -23,13 +23,16 @@ THE SOFTWARE.
 #include "capsaicin_internal.h"
 #include "common_functions.inl"
 #include "hash_reduce.h"
+#include "mesh_cache.h"
+#include "parallel.h"
 
+#include <algorithm>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <glm/gtc/matrix_transform.hpp>
-#include <meshoptimizer.h>
 #include <numbers>
+#include <numeric>
 #include <yaml-cpp/yaml.h>
 
 namespace Capsaicin
@@ -465,6 +468,12 @@ bool CapsaicinInternal::createBlankScene() noexcept
         scene_files_ = {};
     }
 
+    // Any existing change tracking refers to the old scene objects
+    mesh_tracker_.reset();
+    transform_tracker_.reset();
+    instance_tracker_.reset();
+    material_tracker_.reset();
+
     // Create new blank scene
     scene_ = gfxCreateScene();
     if (!scene_)
@@ -923,15 +932,26 @@ void CapsaicinInternal::updateSceneCameraMatrices() noexcept
 
 void CapsaicinInternal::updateSceneMeshes() noexcept
 {
-    // Check whether we need to re-build our mesh data
-    auto const mesh_hash = mesh_hash_;
-    if (frame_index_ == 0 || animation_updated_)
+    GfxMesh const *meshes     = gfxSceneGetObjects<GfxMesh>(scene_);
+    uint32_t const mesh_count = gfxSceneGetObjectCount<GfxMesh>(scene_);
+
+    // Check whether we need to re-build our mesh data. Meshes are tracked using their handles so only meshes
+    // that have been added or changed need to be re-processed, everything is re-processed for a new scene.
+    // Animations only modify instance transforms and morph weights so they never require the (full content)
+    // mesh hashes to be recomputed
+    bool rebuild_all = !mesh_tracker_.isValid();
+    if (frame_index_ == 0 || scene_updated_ || rebuild_all)
+    {
+        mesh_updated_ = mesh_tracker_.update(meshes, mesh_count, std::hash<GfxMesh> {},
+                            [this](uint32_t const i) { return gfxSceneGetObjectHandle<GfxMesh>(scene_, i); })
+                     || rebuild_all;
+    }
+    else
     {
-        mesh_hash_ = HashReduce(gfxSceneGetObjects<GfxMesh>(scene_), gfxSceneGetObjectCount<GfxMesh>(scene_));
+        mesh_updated_ = false;
     }
-    mesh_updated_ = mesh_hash != mesh_hash_;
 
-    // Currently the transform data check is the same as checking for instance change
+    // Instance changes are checked for separately in updateSceneInstances
     instances_updated_ = false;
 
     // Check for a change in optional meshlet buffers
@@ -940,11 +960,15 @@ void CapsaicinInternal::updateSceneMeshes() noexcept
     {
         // We must rebuild meshlet data
         mesh_updated_ = gfxSceneGetObjectCount<GfxInstance>(scene_) > 0;
+        rebuild_all   = true;
     }
 
-    // Check for change in render options
+    // Check for change in render options, these only need converting when one of them has changed
     auto const old_options = render_options;
-    render_options         = convertOptions(getOptions());
+    if (option_registry_.checkChanged(stock_option_group_, stock_option_generation_))
+    {
+        render_options = convertOptions(getOptions());
+    }
     if ((old_options.capsaicin_lod_mode != render_options.capsaicin_lod_mode
             && (old_options.capsaicin_lod_mode != 0 || render_options.capsaicin_lod_offset != 0
                 || render_options.capsaicin_lod_mode != 1)
@@ -956,373 +980,177 @@ void CapsaicinInternal::updateSceneMeshes() noexcept
     {
         mesh_updated_      = true;
         instances_updated_ = true;
+        rebuild_all        = true;
     }
+    meshes_rebuilt_ = mesh_updated_;
 
     if (mesh_updated_)
     {
         // Reload and build the required buffers (vertex/index etc.) specific for each mesh
         GfxCommandEvent const command_event(gfx_, "BuildMeshes");
 
-        GfxMesh const *meshes     = gfxSceneGetObjects<GfxMesh>(scene_);
-        uint32_t const mesh_count = gfxSceneGetObjectCount<GfxMesh>(scene_);
-
         bool hasMeshlets    = hasSharedBuffer("Meshlets");
         bool hasMeshletCull = hasSharedBuffer("MeshletCull");
         GFX_ASSERTMSG(hasMeshlets == hasSharedBuffer("MeshletPack") && (!hasMeshletCull || hasMeshlets),
             "Cannot have Meshlets without also having MeshletPack shared buffer");
 
-        mesh_infos_.clear();
-        mesh_infos_.reserve(mesh_count);
-
-        std::vector<Meshlet> meshlet_data; /**< The buffer storing meshlets. */
-        std::vector<uint32_t>
-            meshlet_pack_data; /**< The buffer storing packed meshlet vertex/index offsets. */
-        std::vector<MeshletCull> meshlet_cull_data; /**< The buffer storing per meshlet culling data. */
-        std::vector<uint32_t>    index_data;
-        std::vector<Vertex>      vertex_data;
-        std::vector<Vertex>      vertex_source_data;
-        std::vector<Joint>       joint_data;
-
-        // Prepare mesh data for loading to GPU. Perform copy for indices and skinning data when
-        // needed; copy vertex data to vertex buffer for static meshes or to vertex source buffer for
-        // animated ones.
-        for (uint32_t i = 0; i < mesh_count; ++i)
+        // Release the heap allocations of any meshes that are about to be re-processed or that have been
+        // removed. Unchanged meshes retain their existing location within the geometry heaps.
+        auto const releaseMesh = [&](uint32_t const mesh_index) {
+            if (mesh_index >= mesh_allocations_.size())
+            {
+                return;
+            }
+            MeshInfo const       &mesh       = mesh_infos_[mesh_index];
+            MeshAllocation const &allocation = mesh_allocations_[mesh_index];
+            index_heap_.free(mesh.index_offset_idx, allocation.index_count);
+            vertex_heap_.free(mesh.vertex_offset_idx[0], allocation.vertex_count);
+            vertex_source_heap_.free(mesh.vertex_source_offset_idx, allocation.vertex_source_count);
+            joint_heap_.free(mesh.joints_offset, allocation.joint_count);
+            meshlet_allocator_.free(mesh.meshlet_offset_idx, allocation.meshlet_count);
+            meshlet_pack_allocator_.free(allocation.meshlet_pack_offset, allocation.meshlet_pack_count);
+            mesh_allocations_[mesh_index] = {};
+            mesh_infos_[mesh_index]       = {};
+        };
+        std::vector<uint32_t> build_meshes;
+        if (rebuild_all)
         {
-            auto const generateLOD = [&](uint32_t const offsetLOD, std::vector<GfxVertex> const &vertexBuffer,
-                                         std::vector<uint32_t> const &indexBuffer,
-                                         std::vector<uint32_t>       &indexBufferOut,
-                                         size_t                       indexBufferOffset = 0) {
-                size_t const vertexCount = vertexBuffer.size();
-                size_t       indexCount  = indexBuffer.size();
-
-                // Generate LOD. Note: mesh optimizer creates LODs by removing indices from the
-                // index buffer and doesn't attempt to move vertices
-                float const threshold = std::powf(0.5F, static_cast<float>(offsetLOD));
-                auto const  targetIndexCount =
-                    static_cast<size_t>(fmax(static_cast<float>(indexCount) * threshold, 6.0F));
-                constexpr float    baseTargetError = 0.1F;
-                float              targetError     = baseTargetError * static_cast<float>(offsetLOD);
-                constexpr uint32_t options         = meshopt_SimplifyLockBorder;
-
-                float lodError = 0.0F;
-                indexBufferOut.resize(indexBufferOffset + indexBuffer.size());
-                indexCount = meshopt_simplify(indexBufferOut.data() + indexBufferOffset, indexBuffer.data(),
-                    indexCount, &vertexBuffer[0].position.x, vertexCount, sizeof(GfxVertex), targetIndexCount,
-                    targetError, options, &lodError);
-
-                uint32_t retries = 1;
-                while (indexCount == 0 && retries <= offsetLOD)
-                {
-                    // Simplify has gone way overboard, try and back off until it works
-                    targetError = baseTargetError * static_cast<float>(offsetLOD - retries);
-                    indexCount  = meshopt_simplify(indexBufferOut.data() + indexBufferOffset,
-                         indexBuffer.data(), indexBuffer.size(), &vertexBuffer[0].position.x, vertexCount,
-                         sizeof(GfxVertex), targetIndexCount, targetError, options, &lodError);
-                    ++retries;
-                }
-                indexBufferOut.resize(indexBufferOffset + indexCount);
-
-                if (render_options.capsaicin_lod_aggressive && indexCount > 100
-                    && static_cast<float>(indexCount) / static_cast<float>(targetIndexCount) > 2.0F)
-                {
-                    // If simplify doest reduce by as many indices as we want then fall back to a
-                    // less accurate but cruder simplification technique
-                    auto indexCount2 = meshopt_simplifySloppy(indexBufferOut.data() + indexBufferOffset,
-                        indexBuffer.data(), indexCount, &vertexBuffer[0].position.x, vertexCount,
-                        sizeof(GfxVertex), targetIndexCount, targetError, &lodError);
-
-                    retries = 1;
-                    while (indexCount2 == 0 && retries <= offsetLOD)
-                    {
-                        // Sloppy simplification can at time completely remove all indices in this
-                        // case we back off until we get a value that works much like the back off
-                        // for regular simplify
-                        targetError = baseTargetError * static_cast<float>(offsetLOD - retries);
-                        indexCount2 = meshopt_simplifySloppy(indexBufferOut.data() + indexBufferOffset,
-                            indexBuffer.data(), indexCount, &vertexBuffer[0].position.x, vertexCount,
-                            sizeof(GfxVertex), targetIndexCount, targetError, &lodError);
-                        ++retries;
-                    }
-                    if (indexCount2 != 0)
-                    {
-                        // We only use the output of sloppy simplification if it is actually valid.
-                        // If the fall-back still couldn't find anything then we ignore the output
-                        // of sloppy entirely
-                        indexBufferOut.resize(indexBufferOffset + indexCount2);
-                        indexCount = indexCount2;
-                    }
-                }
-                // mesh optimizer outputs the LOD error as a relative metric, to convert it to an absolute
-                // value as it needs to be scaled
-                lodError *=
-                    meshopt_simplifyScale(&vertexBuffer[0].position.x, vertexCount, sizeof(GfxVertex));
-                return std::make_tuple(indexBufferOffset, indexCount, lodError);
-            };
-            auto const loadMesh = [&](std::vector<GfxVertex> const &meshVertices,
-                                      std::vector<uint32_t> const  &meshIndices,
-                                      std::vector<GfxVertex> const &morphVertices,
-                                      std::vector<GfxJoint> const  &joints) {
-                // Get mesh values
-                uint32_t const mesh_index     = gfxSceneGetObjectHandle<GfxMesh>(scene_, i);
-                auto const     indexCount     = meshIndices.size();
-                MeshInfo       mesh           = {};
-                mesh.index_offset_idx         = static_cast<uint32_t>(index_data.size());
-                mesh.index_count              = static_cast<uint32_t>(indexCount);
-                mesh.vertex_source_offset_idx = static_cast<uint32_t>(vertex_source_data.size());
-                mesh.joints_offset            = static_cast<uint32_t>(joint_data.size());
-                mesh.targets_count = static_cast<uint32_t>(morphVertices.size() / meshVertices.size());
-                mesh.vertex_count  = static_cast<uint32_t>(meshVertices.size());
-                mesh.is_animated   = !joints.empty() || !morphVertices.empty();
-
-                // Add mesh vertices. If the mesh has skinning/morphs then it is added to a secondary vertex
-                // list used specifically for animation.
-                if (!mesh.is_animated)
-                {
-                    mesh.vertex_offset_idx[0] = static_cast<uint32_t>(vertex_data.size());
-                    mesh.vertex_offset_idx[1] = mesh.vertex_offset_idx[0];
-                    vertex_data.reserve(vertex_data.size() + mesh.vertex_count);
-                    for (auto const &[vertPosition, vertNormal, vertUV] : meshVertices)
-                    {
-                        Vertex vertex       = {};
-                        vertex.position_uvx = float4(vertPosition, vertUV.x);
-                        vertex.normal_uvy   = float4(vertNormal, vertUV.y);
-                        vertex_data.push_back(vertex);
-                    }
-                }
-                else
-                {
-                    // For every animated instance, allocate two slots
-                    // for animated vertex data generated from vertex source data.
-                    vertex_data.reserve(vertex_data.size() + 2ULL * mesh.vertex_count);
-                    mesh.vertex_offset_idx[0] = static_cast<uint32_t>(vertex_data.size());
-                    vertex_data.resize(vertex_data.size() + mesh.vertex_count);
-                    mesh.vertex_offset_idx[1] = static_cast<uint32_t>(vertex_data.size());
-                    vertex_data.resize(vertex_data.size() + mesh.vertex_count);
-
-                    vertex_source_data.reserve(
-                        vertex_source_data.size()
-                        + (static_cast<size_t>(mesh.vertex_count) * mesh.targets_count));
-                    for (size_t j = 0; j < mesh.vertex_count; ++j)
-                    {
-                        Vertex vertex       = {};
-                        vertex.position_uvx = float4(meshVertices[j].position, meshVertices[j].uv.x);
-                        vertex.normal_uvy   = float4(meshVertices[j].normal, meshVertices[j].uv.y);
-                        vertex_source_data.push_back(vertex);
-                        for (uint32_t k = 0; k < mesh.targets_count; ++k)
-                        {
-                            Vertex target_vertex = {};
-                            target_vertex.position_uvx =
-                                float4(morphVertices[j * mesh.targets_count + k].position,
-                                    morphVertices[j * mesh.targets_count + k].uv.x);
-                            target_vertex.normal_uvy =
-                                float4(morphVertices[j * mesh.targets_count + k].normal,
-                                    morphVertices[j * mesh.targets_count + k].uv.y);
-                            vertex_source_data.push_back(target_vertex);
-                        }
-                    }
-                }
-
-                if (mesh_index >= mesh_infos_.size())
+            index_heap_.reset();
+            vertex_heap_.reset();
+            vertex_source_heap_.reset();
+            joint_heap_.reset();
+            meshlet_allocator_.reset();
+            meshlet_pack_allocator_.reset();
+            mesh_allocations_.clear();
+            mesh_infos_.clear();
+            build_meshes.resize(mesh_count);
+            std::iota(build_meshes.begin(), build_meshes.end(), 0U);
+        }
+        else
+        {
+            for (uint32_t const mesh_index : mesh_tracker_.getRemoved())
+            {
+                releaseMesh(mesh_index);
+            }
+            build_meshes = mesh_tracker_.getChanged();
+            for (uint32_t const i : build_meshes)
+            {
+                releaseMesh(gfxSceneGetObjectHandle<GfxMesh>(scene_, i));
+            }
+        }
+        std::vector<MeshBuildData> build_data(build_meshes.size());
+        MeshCache const            mesh_cache(render_options.capsaicin_mesh_cache_path);
+        MeshBuildSettings          build_settings;
+        build_settings.lod_mode       = render_options.capsaicin_lod_mode;
+        build_settings.lod_offset     = render_options.capsaicin_lod_offset;
+        build_settings.lod_aggressive = render_options.capsaicin_lod_aggressive;
+        build_settings.meshlets       = hasMeshlets;
+        build_settings.meshlet_cull   = hasMeshletCull;
+
+        // Prepare mesh data for loading to GPU. Each mesh is processed independently and only writes to
+        // its own output so that meshes can be built in parallel, all offsets are relative to the meshes
+        // own data.
+        ParallelFor(0U, static_cast<uint32_t>(build_meshes.size()), [&](uint32_t const j) {
+            uint32_t const i   = build_meshes[j];
+            MeshBuildData &out = build_data[j];
+
+            // Check for previously processed results in the mesh cache
+            uint64_t cache_key = 0;
+            if (mesh_cache.isEnabled())
+            {
+                cache_key = MeshCache::CalculateKey(meshes[i], render_options.capsaicin_lod_mode,
+                    render_options.capsaicin_lod_offset, render_options.capsaicin_lod_aggressive, hasMeshlets,
+                    hasMeshletCull);
+                if (mesh_cache.load(cache_key, out))
                 {
-                    mesh_infos_.resize(static_cast<size_t>(mesh_index) + 1);
+                    return;
                 }
+            }
+            BuildMesh(meshes[i], build_settings, out);
 
-                if (hasMeshlets)
-                {
-                    // Create meshlets
-                    {
-                        constexpr size_t max_vertices  = 64;
-                        constexpr size_t max_triangles = 64;
-                        constexpr float  cone_weight   = 1.0F;
-
-                        // Build meshlets
-                        size_t const                 indexCountLOD = meshIndices.size();
-                        std::vector<meshopt_Meshlet> meshlets(
-                            meshopt_buildMeshletsBound(indexCountLOD, max_vertices, max_triangles));
-                        std::vector<uint32_t> meshletVertices(meshlets.size() * max_vertices);
-                        std::vector<uint8_t>  meshletTriangles(meshlets.size() * max_triangles * 3);
-                        meshlets.resize(meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(),
-                            meshletTriangles.data(), meshIndices.data(), indexCountLOD,
-                            &meshVertices[0].position.x, mesh.vertex_count, sizeof(GfxVertex), max_vertices,
-                            max_triangles, cone_weight));
-
-                        // Collapse used memory from worst case usage
-                        meshopt_Meshlet const &lastMeshlet = meshlets.back();
-                        meshletVertices.resize(lastMeshlet.vertex_offset + lastMeshlet.vertex_count);
-                        meshletTriangles.resize(
-                            lastMeshlet.triangle_offset + ((lastMeshlet.triangle_count * 3 + 3) & ~3U));
-
-                        // Optimise meshlet layout
-                        for (auto &[vertexOffset, triangleOffset, vertexCount, triangleCount] : meshlets)
-                        {
-                            meshopt_optimizeMeshlet(&meshletVertices[vertexOffset],
-                                &meshletTriangles[triangleOffset], triangleCount, vertexCount);
-                        }
-
-                        mesh.meshlet_count      = static_cast<uint32_t>(meshlets.size());
-                        mesh.meshlet_offset_idx = static_cast<uint32_t>(meshlet_data.size());
-
-                        std::vector<uint32_t> indices;
-                        for (auto &[meshlet_vertex_offset, meshlet_triangle_offset, meshlet_vertex_count,
-                                 meshlet_triangle_count] : meshlets)
-                        {
-                            // Add packed meshlet data. Each meshlet contains limited number of
-                            // vertices/triangles, so we store them using a packed lower bit representation.
-                            // These packed vertex indices act as offsets to the base mesh which is itself
-                            // stored as a vertex offset in the global vertex buffer
-                            // (instance.vertex_offset_idx)
-                            auto const dataOffset = static_cast<uint32_t>(meshlet_pack_data.size());
-                            for (uint32_t j = 0; j < meshlet_vertex_count; ++j)
-                            {
-                                meshlet_pack_data.push_back(
-                                    meshletVertices[static_cast<size_t>(meshlet_vertex_offset) + j]);
-                            }
-
-                            // Meshlet indices are also stored packed in lower bit representation. These are
-                            // used to order the meshlet vertices into triangles.
-                            auto const indexMeshletOffset = static_cast<uint32_t>(indices.size());
-                            for (size_t j = 0; j < meshlet_triangle_count; ++j)
-                            {
-                                // Indices are packed into same data buffer as vertices. Since they are only 8
-                                // bit we can pack them into a 32bit uint inorder to avoid issues with reading
-                                // buffers in HLSL
-                                size_t const offset = static_cast<size_t>(meshlet_triangle_offset) + (j * 3);
-                                meshlet_pack_data.push_back(
-                                    static_cast<uint32_t>(meshletTriangles[offset])
-                                    | (static_cast<uint32_t>(meshletTriangles[offset + 1]) << 10)
-                                    | (static_cast<uint32_t>(meshletTriangles[offset + 2]) << 20));
-
-                                // Remap index buffer to meshlet indices so that primitiveIDs match
-                                indices.push_back(
-                                    meshletVertices[meshletTriangles[offset]
-                                                    + static_cast<size_t>(meshlet_vertex_offset)]);
-                                indices.push_back(
-                                    meshletVertices[meshletTriangles[offset + 1]
-                                                    + static_cast<size_t>(meshlet_vertex_offset)]);
-                                indices.push_back(
-                                    meshletVertices[meshletTriangles[offset + 2]
-                                                    + static_cast<size_t>(meshlet_vertex_offset)]);
-                            }
-
-                            // Add the new meshlet
-                            Meshlet m              = {};
-                            m.vertex_count         = static_cast<uint16_t>(meshlet_vertex_count);
-                            m.triangle_count       = static_cast<uint16_t>(meshlet_triangle_count);
-                            m.data_offset_idx      = dataOffset;
-                            m.mesh_prim_offset_idx = indexMeshletOffset / 3;
-                            meshlet_data.push_back(m);
-
-                            if (hasMeshletCull)
-                            {
-                                meshopt_Bounds const bounds =
-                                    meshopt_computeMeshletBounds(&meshletVertices[meshlet_vertex_offset],
-                                        &meshletTriangles[meshlet_triangle_offset], meshlet_triangle_count,
-                                        &meshVertices[0].position.x, mesh.vertex_count, sizeof(GfxVertex));
-
-                                MeshletCull m2 = {};
-                                m2.sphere      = float4(
-                                    bounds.center[0], bounds.center[1], bounds.center[2], bounds.radius);
-                                m2.cone = float4(bounds.cone_axis[0], bounds.cone_axis[1],
-                                    bounds.cone_axis[2], bounds.cone_cutoff);
-                                meshlet_cull_data.push_back(m2);
-                            }
-                        }
-                        index_data.insert(index_data.end(), indices.begin(), indices.end());
-                    }
-                }
-                else
-                {
-                    // Must add indices in normally
-                    for (auto const &index : meshIndices)
-                    {
-                        index_data.push_back(index);
-                    }
-                }
-                mesh_infos_[mesh_index] = mesh;
+            if (mesh_cache.isEnabled())
+            {
+                mesh_cache.save(cache_key, out);
+            }
+        });
 
-                for (auto const &[jointJoints, jointWeights] : joints)
-                {
-                    joint_data.emplace_back(jointJoints, jointWeights);
-                }
-            };
+        // Encode the vertex data into the compact GPU layout if enabled. The mesh cache always stores full
+        // precision vertices so the layout can be changed without invalidating it.
+        std::vector<std::vector<CompactVertex>> compact_vertices;
+        std::vector<std::vector<CompactVertex>> compact_vertex_source;
+        if (compact_vertices_)
+        {
+            compact_vertices.resize(build_data.size());
+            compact_vertex_source.resize(build_data.size());
+            ParallelFor(0, static_cast<uint32_t>(build_data.size()), [&](uint32_t const j) {
+                compact_vertices[j].assign(build_data[j].vertices.cbegin(), build_data[j].vertices.cend());
+                compact_vertex_source[j].assign(
+                    build_data[j].vertex_source.cbegin(), build_data[j].vertex_source.cend());
+            });
+        }
 
-            // Check current LOD mode and load meshes accordingly
-            if (render_options.capsaicin_lod_mode == 0)
+        // Allocate space for each processed mesh within the geometry heaps. Meshes are allocated in the same
+        // order as they are stored in the scene so the output is independent of the order in which the meshes
+        // were processed.
+        std::vector<BufferUpload> index_uploads;
+        std::vector<BufferUpload> vertex_uploads;
+        std::vector<BufferUpload> vertex_source_uploads;
+        std::vector<BufferUpload> joint_uploads;
+        std::vector<BufferUpload> meshlet_uploads;
+        std::vector<BufferUpload> meshlet_pack_uploads;
+        std::vector<BufferUpload> meshlet_cull_uploads;
+        for (uint32_t j = 0; j < static_cast<uint32_t>(build_meshes.size()); ++j)
+        {
+            MeshBuildData &mesh_data = build_data[j];
+            MeshInfo      &mesh      = mesh_data.mesh;
+
+            MeshAllocation allocation      = {};
+            allocation.index_count         = static_cast<uint32_t>(mesh_data.indices.size());
+            allocation.vertex_count        = static_cast<uint32_t>(mesh_data.vertices.size());
+            allocation.vertex_source_count = static_cast<uint32_t>(mesh_data.vertex_source.size());
+            allocation.joint_count         = static_cast<uint32_t>(mesh_data.joints.size());
+            allocation.meshlet_count       = static_cast<uint32_t>(mesh_data.meshlets.size());
+            allocation.meshlet_pack_count  = static_cast<uint32_t>(mesh_data.meshlet_pack.size());
+
+            uint32_t const vertex_offset = vertex_heap_.allocate(allocation.vertex_count);
+            mesh.index_offset_idx        = index_heap_.allocate(allocation.index_count);
+            mesh.vertex_offset_idx[0] += vertex_offset;
+            mesh.vertex_offset_idx[1] += vertex_offset;
+            mesh.vertex_source_offset_idx  = vertex_source_heap_.allocate(allocation.vertex_source_count);
+            mesh.joints_offset             = joint_heap_.allocate(allocation.joint_count);
+            mesh.meshlet_offset_idx        = meshlet_allocator_.allocate(allocation.meshlet_count);
+            allocation.meshlet_pack_offset = meshlet_pack_allocator_.allocate(allocation.meshlet_pack_count);
+
+            // Meshlet pack offsets must be made absolute now that the final location is known
+            for (Meshlet &meshlet : mesh_data.meshlets)
             {
-                // Default mode just loads meshes unaltered
-                loadMesh(meshes[i].vertices, meshes[i].indices, meshes[i].morph_targets, meshes[i].joints);
+                meshlet.data_offset_idx += allocation.meshlet_pack_offset;
             }
-            else if (render_options.capsaicin_lod_mode >= 1)
-            {
-                if (constexpr uint32_t minIndicesCap = 20;
-                    render_options.capsaicin_lod_mode == 2
-                    || (render_options.capsaicin_lod_offset != 0 && meshes[i].indices.size() > minIndicesCap))
-                {
-                    // Reindex index buffer to remove duplicated vertices
-                    size_t const indexCount           = meshes[i].indices.size();
-                    size_t const unindexedVertexCount = meshes[i].vertices.size();
-                    size_t const morphCount = meshes[i].morph_targets.size() / meshes[i].vertices.size();
-                    std::vector<meshopt_Stream> streams;
-                    streams.reserve(1 + morphCount);
-                    streams.emplace_back(meshes[i].vertices.data(), sizeof(GfxVertex), sizeof(GfxVertex));
-                    if (!meshes[i].joints.empty())
-                    {
-                        streams.emplace_back(meshes[i].joints.data(), sizeof(GfxJoint), sizeof(GfxJoint));
-                    }
-                    for (size_t j = 0; j < morphCount; ++j)
-                    {
-                        streams.emplace_back(meshes[i].morph_targets.data() + (j * meshes[i].vertices.size()),
-                            sizeof(GfxVertex), sizeof(GfxVertex));
-                    }
-                    std::vector<uint32_t> remap(indexCount);
-                    size_t                vertexCount =
-                        meshopt_generateVertexRemapMulti(remap.data(), meshes[i].indices.data(), indexCount,
-                            unindexedVertexCount, streams.data(), streams.size());
-                    std::vector<uint32_t> indexBuffer(indexCount);
-                    meshopt_remapIndexBuffer(
-                        indexBuffer.data(), meshes[i].indices.data(), indexCount, remap.data());
-                    std::vector<GfxVertex> vertexBuffer(vertexCount);
-                    meshopt_remapVertexBuffer(vertexBuffer.data(), meshes[i].vertices.data(),
-                        unindexedVertexCount, sizeof(GfxVertex), remap.data());
-                    std::vector<GfxVertex> morphVertices(morphCount * vertexCount);
-                    for (size_t morph = 0; morph < morphCount; ++morph)
-                    {
-                        meshopt_remapVertexBuffer(morphVertices.data() + (morph * vertexCount),
-                            meshes[i].morph_targets.data() + (morph * unindexedVertexCount),
-                            unindexedVertexCount, sizeof(GfxVertex), remap.data());
-                    }
 
-                    // Get mesh LOD data
-                    if (render_options.capsaicin_lod_mode == 1)
-                    {
-                        // If using Manual mode we can just generate a single LOD for the requested LOD level
-                        generateLOD(
-                            render_options.capsaicin_lod_offset, vertexBuffer, indexBuffer, indexBuffer);
-
-                        // Compact the vertex buffer by removing unused vertices
-                        auto const vertexCountOriginal = vertexCount;
-                        vertexCount = meshopt_optimizeVertexFetch(vertexBuffer.data(), indexBuffer.data(),
-                            indexBuffer.size(), vertexBuffer.data(), vertexCount, sizeof(GfxVertex));
-                        vertexBuffer.resize(vertexCount);
-                        for (size_t morph = 0; morph < morphCount; ++morph)
-                        {
-                            meshopt_optimizeVertexFetch(morphVertices.data() + (morph * vertexCount),
-                                indexBuffer.data(), indexBuffer.size(),
-                                morphVertices.data() + (morph * vertexCountOriginal), vertexCountOriginal,
-                                sizeof(GfxVertex));
-                        }
-                        morphVertices.resize(morphCount * vertexCount);
-                    }
-
-                    loadMesh(vertexBuffer, indexBuffer, morphVertices, meshes[i].joints);
-                }
-                else
-                {
-                    // Just use default
-                    loadMesh(
-                        meshes[i].vertices, meshes[i].indices, meshes[i].morph_targets, meshes[i].joints);
-                }
+            index_uploads.emplace_back(
+                mesh.index_offset_idx, allocation.index_count, mesh_data.indices.data());
+            vertex_uploads.emplace_back(vertex_offset, allocation.vertex_count,
+                compact_vertices_ ? static_cast<void const *>(compact_vertices[j].data())
+                                  : static_cast<void const *>(mesh_data.vertices.data()));
+            vertex_source_uploads.emplace_back(mesh.vertex_source_offset_idx, allocation.vertex_source_count,
+                compact_vertices_ ? static_cast<void const *>(compact_vertex_source[j].data())
+                                  : static_cast<void const *>(mesh_data.vertex_source.data()));
+            joint_uploads.emplace_back(mesh.joints_offset, allocation.joint_count, mesh_data.joints.data());
+            meshlet_uploads.emplace_back(
+                mesh.meshlet_offset_idx, allocation.meshlet_count, mesh_data.meshlets.data());
+            meshlet_pack_uploads.emplace_back(
+                allocation.meshlet_pack_offset, allocation.meshlet_pack_count, mesh_data.meshlet_pack.data());
+            meshlet_cull_uploads.emplace_back(mesh.meshlet_offset_idx,
+                static_cast<uint32_t>(mesh_data.meshlet_cull.size()), mesh_data.meshlet_cull.data());
+
+            uint32_t const mesh_index = gfxSceneGetObjectHandle<GfxMesh>(scene_, build_meshes[j]);
+            if (mesh_index >= mesh_infos_.size())
+            {
+                mesh_infos_.resize(static_cast<size_t>(mesh_index) + 1);
+                mesh_allocations_.resize(static_cast<size_t>(mesh_index) + 1);
             }
+            mesh_infos_[mesh_index]       = mesh;
+            mesh_allocations_[mesh_index] = allocation;
         }
 
         // Add any skinning hierarchies
@@ -1336,69 +1164,70 @@ void CapsaicinInternal::updateSceneMeshes() noexcept
             joint_matrix_count += static_cast<uint32_t>(skin_ref->joint_matrices.size());
         }
 
-        // Copy data into GPU buffers
-        gfxDestroyBuffer(gfx_, index_buffer_);
-        index_buffer_ =
-            gfxCreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(index_data.size()), index_data.data());
-        index_buffer_.setName("IndexBuffer");
-        gfxDestroyBuffer(gfx_, vertex_buffer_);
-        vertex_buffer_ =
-            gfxCreateBuffer<Vertex>(gfx_, static_cast<uint32_t>(vertex_data.size()), vertex_data.data());
-        vertex_buffer_.setName("VertexBuffer");
-        gfxDestroyBuffer(gfx_, vertex_source_buffer_);
-        vertex_source_buffer_ = gfxCreateBuffer<Vertex>(
-            gfx_, static_cast<uint32_t>(vertex_source_data.size()), vertex_source_data.data());
-        vertex_source_buffer_.setName("VertexSourceBuffer");
-        gfxDestroyBuffer(gfx_, joint_buffer_);
-        joint_buffer_ =
-            gfxCreateBuffer<Joint>(gfx_, static_cast<uint32_t>(joint_data.size()), joint_data.data());
-        joint_buffer_.setName("JointBuffer");
+        // Grow the GPU buffers if needed and upload only the data for the processed meshes
+        index_heap_.update();
+        vertex_heap_.update();
+        vertex_source_heap_.update();
+        joint_heap_.update();
+        uploadBufferRanges(index_heap_.getBuffer(), index_heap_.getStride(), index_uploads);
+        uploadBufferRanges(vertex_heap_.getBuffer(), vertex_heap_.getStride(), vertex_uploads);
+        uploadBufferRanges(
+            vertex_source_heap_.getBuffer(), vertex_source_heap_.getStride(), vertex_source_uploads);
+        uploadBufferRanges(joint_heap_.getBuffer(), joint_heap_.getStride(), joint_uploads);
         gfxDestroyBuffer(gfx_, joint_matrices_buffer_);
         joint_matrices_buffer_ = gfxCreateBuffer<glm::mat4>(gfx_, joint_matrix_count);
         if (hasMeshlets)
         {
-            // Resizing must be exact as otherwise the copy buffer command will fail
-            checkSharedBuffer("Meshlets", meshlet_data.size() * sizeof(Meshlet), true);
-            GfxBuffer upload_buffer = gfxCreateBuffer<Meshlet>(
-                gfx_, static_cast<uint32_t>(meshlet_data.size()), meshlet_data.data(), kGfxCpuAccess_Write);
-            gfxCommandCopyBuffer(gfx_, getSharedBuffer("Meshlets"), upload_buffer);
-            gfxDestroyBuffer(gfx_, upload_buffer);
-
-            checkSharedBuffer("MeshletPack", meshlet_pack_data.size() * sizeof(uint32_t), true);
-            upload_buffer = gfxCreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(meshlet_pack_data.size()),
-                meshlet_pack_data.data(), kGfxCpuAccess_Write);
-            gfxCommandCopyBuffer(gfx_, getSharedBuffer("MeshletPack"), upload_buffer);
-            gfxDestroyBuffer(gfx_, upload_buffer);
+            // Meshlet buffers are shared buffers so are resized (retaining existing contents) to match the
+            // current allocator capacity
+            checkSharedBuffer("Meshlets",
+                static_cast<uint64_t>(meshlet_allocator_.getCapacity()) * sizeof(Meshlet), false,
+                !rebuild_all);
+            uploadBufferRanges(getSharedBuffer("Meshlets"), sizeof(Meshlet), meshlet_uploads);
+
+            checkSharedBuffer("MeshletPack",
+                static_cast<uint64_t>(meshlet_pack_allocator_.getCapacity()) * sizeof(uint32_t), false,
+                !rebuild_all);
+            uploadBufferRanges(getSharedBuffer("MeshletPack"), sizeof(uint32_t), meshlet_pack_uploads);
 
             if (hasMeshletCull)
             {
-                checkSharedBuffer("MeshletCull", meshlet_cull_data.size() * sizeof(MeshletCull), true);
-                upload_buffer =
-                    gfxCreateBuffer<MeshletCull>(gfx_, static_cast<uint32_t>(meshlet_cull_data.size()),
-                        meshlet_cull_data.data(), kGfxCpuAccess_Write);
-                gfxCommandCopyBuffer(gfx_, getSharedBuffer("MeshletCull"), upload_buffer);
-                gfxDestroyBuffer(gfx_, upload_buffer);
+                checkSharedBuffer("MeshletCull",
+                    static_cast<uint64_t>(meshlet_allocator_.getCapacity()) * sizeof(MeshletCull), false,
+                    !rebuild_all);
+                uploadBufferRanges(getSharedBuffer("MeshletCull"), sizeof(MeshletCull), meshlet_cull_uploads);
             }
         }
-
-        // NVIDIA-specific fix
-        if (gfx_.getVendorId() == 0x10DEU) // NVIDIA
-        {
-            vertex_buffer_.setStride(4);
-        }
     }
 }
 
 void CapsaicinInternal::updateSceneInstances() noexcept
 {
+    GfxInstance const *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
+    uint32_t const     instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
+
+    // Check whether any instance has changed which mesh or material it references. Changes to just the
+    // instance transform are handled separately and do not require the instance data to be re-built
+    if (frame_index_ == 0 || animation_updated_ || scene_updated_)
+    {
+        if (instance_tracker_.update(instances, instance_count, [](GfxInstance const &instance) {
+                size_t hash = 0x12345678U;
+                hash        = HashCombine(hash, static_cast<uint64_t>(instance.mesh));
+                hash        = HashCombine(hash, static_cast<uint64_t>(instance.material));
+                hash        = HashCombine(hash, instance.weights.size());
+                return hash;
+            }))
+        {
+            instances_updated_ = true;
+        }
+    }
+
     // Update the instance information
-    if ((instances_updated_ || mesh_updated_) && gfxSceneGetObjectCount<GfxInstance>(scene_) > 0)
+    if ((instances_updated_ || mesh_updated_) && instance_count > 0)
     {
         GfxCommandEvent const command_event(gfx_, "BuildInstances");
 
-        bool const         hasMeshlets    = hasSharedBuffer("Meshlets");
-        GfxInstance const *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
-        uint32_t const     instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
+        bool const hasMeshlets = hasSharedBuffer("Meshlets");
 
         // Populate instance-related data.
         triangle_count_           = 0;
@@ -1497,12 +1326,17 @@ void CapsaicinInternal::updateSceneTransforms() noexcept
     GfxInstance const *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
     uint32_t const     instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
     // Check whether we need to re-build our transform data
-    size_t const transform_hash = transform_hash_;
-    if (frame_index_ == 0 || animation_updated_)
+    if (frame_index_ == 0 || animation_updated_ || scene_updated_)
     {
-        transform_hash_ = HashReduce(instances, instance_count);
+        transform_updated_ = transform_tracker_.update(
+            instances, instance_count,
+            [](GfxInstance const &instance) { return std::hash<glm::mat4> {}(instance.transform); },
+            [this](uint32_t const i) { return gfxSceneGetObjectHandle<GfxInstance>(scene_, i); });
+    }
+    else
+    {
+        transform_updated_ = false;
     }
-    transform_updated_ = transform_hash != transform_hash_;
 
     // Update per-instance transform data
     if (transform_updated_ || mesh_updated_)
@@ -1546,11 +1380,33 @@ void CapsaicinInternal::updateSceneTransforms() noexcept
             gfxCommandCopyBuffer(gfx_, prev_transform_buffer_, transform_buffer_);
         }
 
-        // Update the transform buffer
-        gfxDestroyBuffer(gfx_, transform_buffer_);
-        transform_buffer_ = gfxCreateBuffer<glm::mat4x3>(
-            gfx_, static_cast<uint32_t>(transform_data.size()), transform_data.data());
-        transform_buffer_.setName("TransformBuffer");
+        if (transform_buffer_.getCount() == static_cast<uint32_t>(transform_data.size()))
+        {
+            // Upload only the transforms that have changed into the existing buffer
+            if (transform_updated_)
+            {
+                std::vector<BufferUpload> uploads;
+                for (uint32_t const i : transform_tracker_.getChanged())
+                {
+                    uint32_t const instance_index = gfxSceneGetObjectHandle<GfxInstance>(scene_, i);
+                    if (instance_index >= instance_data_.size())
+                    {
+                        continue;
+                    }
+                    uint32_t const transform_index = instance_data_[instance_index].transform_index;
+                    uploads.emplace_back(transform_index, 1U, &transform_data[transform_index]);
+                }
+                uploadBufferRanges(transform_buffer_, sizeof(glm::mat4x3), uploads);
+            }
+        }
+        else
+        {
+            // Update the transform buffer
+            gfxDestroyBuffer(gfx_, transform_buffer_);
+            transform_buffer_ = gfxCreateBuffer<glm::mat4x3>(
+                gfx_, static_cast<uint32_t>(transform_data.size()), transform_data.data());
+            transform_buffer_.setName("TransformBuffer");
+        }
         if (prev_transform_buffer_.getCount() != static_cast<uint32_t>(transform_data.size()))
         {
             // Previous transform buffer should match current due to rebuild
@@ -1571,42 +1427,76 @@ void CapsaicinInternal::updateSceneTransforms() noexcept
 
 void CapsaicinInternal::updateSceneMaterials() noexcept
 {
-    if (mesh_updated_) // Currently we don't support changing materials without also changing meshes
+    GfxMaterial const *materials      = gfxSceneGetObjects<GfxMaterial>(scene_);
+    uint32_t const     material_count = gfxSceneGetObjectCount<GfxMaterial>(scene_);
+
+    // Check whether any materials have changed
+    if (frame_index_ == 0 || animation_updated_ || scene_updated_ || mesh_updated_)
     {
-        size_t const material_hash = material_hash_;
-        material_hash_ =
-            HashReduce(gfxSceneGetObjects<GfxMaterial>(scene_), gfxSceneGetObjectCount<GfxMaterial>(scene_));
-        materials_updated_ = material_hash != material_hash_;
+        materials_updated_ = material_tracker_.update(materials, material_count);
+    }
+    else
+    {
+        materials_updated_ = false;
+    }
 
-        if (materials_updated_)
+    if (materials_updated_)
+    {
+        auto const convertMaterial = [](GfxMaterial const &gfxMaterial) {
+            bool const     noAlpha     = gfxMaterial.albedo.w >= 1.0F && !gfxMaterial.albedo_map;
+            uint32_t const doubleSided = (gfxMaterial.flags & kGfxMaterialFlag_DoubleSided) != 0 ? 1 : 0;
+            uint32_t const alphaMode   = noAlpha                                              ? 0
+                                       : gfxMaterial.alpha_mode == GfxMaterialAlphaMode_Blend ? 2
+                                       : gfxMaterial.alpha_mode == GfxMaterialAlphaMode_Mask  ? 1
+                                                                                              : 0;
+            return Material {.albedo = float4(float3(gfxMaterial.albedo),
+                                 glm::uintBitsToFloat(gfxMaterial.albedo_map)),
+                .emissivity =
+                    float4(gfxMaterial.emissivity, glm::uintBitsToFloat(gfxMaterial.emissivity_map)),
+                .metallicity_roughness =
+                    float4(gfxMaterial.metallicity, glm::uintBitsToFloat(gfxMaterial.metallicity_map),
+                        gfxMaterial.roughness, glm::uintBitsToFloat(gfxMaterial.roughness_map)),
+                .normal_alpha_side =
+                    float4(glm::uintBitsToFloat(gfxMaterial.normal_map), gfxMaterial.albedo.w,
+                        glm::uintBitsToFloat(doubleSided), glm::uintBitsToFloat(alphaMode))};
+        };
+
+        // If only the contents of existing materials have changed then just those materials are updated in
+        // place, adding/removing materials or images requires a complete rebuild
+        std::vector<uint32_t> const &changed     = material_tracker_.getChanged();
+        uint32_t const               image_count = gfxSceneGetObjectCount<GfxImage>(scene_);
+        auto const                   texture_count = static_cast<uint32_t>(
+            std::ranges::count_if(texture_atlas_, [](GfxTexture const &texture) { return !!texture; }));
+        if (!scene_updated_ && !material_tracker_.getCountChanged() && material_buffer_
+            && texture_count == image_count && std::ranges::all_of(changed, [&](uint32_t const i) {
+                   return gfxSceneGetObjectHandle<GfxMaterial>(scene_, i) < material_buffer_.getCount();
+               }))
+        {
+            GfxCommandEvent const command_event(gfx_, "UpdateMaterials");
+
+            std::vector<Material>     material_data(changed.size());
+            std::vector<BufferUpload> uploads;
+            uploads.reserve(changed.size());
+            for (size_t j = 0; j < changed.size(); ++j)
+            {
+                uint32_t const i              = changed[j];
+                uint32_t const material_index = gfxSceneGetObjectHandle<GfxMaterial>(scene_, i);
+                material_data[j]              = convertMaterial(materials[i]);
+                uploads.emplace_back(material_index, 1U, &material_data[j]);
+            }
+            uploadBufferRanges(material_buffer_, sizeof(Material), uploads);
+        }
+        else
         {
             // Rebuild materials buffer
             gfxDestroyBuffer(gfx_, material_buffer_);
 
-            GfxMaterial const    *materials      = gfxSceneGetObjects<GfxMaterial>(scene_);
-            uint32_t const        material_count = gfxSceneGetObjectCount<GfxMaterial>(scene_);
             std::vector<Material> material_data;
             material_data.reserve(material_count);
 
             for (uint32_t i = 0; i < material_count; ++i)
             {
-                bool const     noAlpha  = materials[i].albedo.w >= 1.0F && !materials[i].albedo_map;
-                Material const material = {.albedo = float4(float3(materials[i].albedo),
-                                               glm::uintBitsToFloat(materials[i].albedo_map)),
-                    .emissivity =
-                        float4(materials[i].emissivity, glm::uintBitsToFloat(materials[i].emissivity_map)),
-                    .metallicity_roughness =
-                        float4(materials[i].metallicity, glm::uintBitsToFloat(materials[i].metallicity_map),
-                            materials[i].roughness, glm::uintBitsToFloat(materials[i].roughness_map)),
-                    .normal_alpha_side = float4(glm::uintBitsToFloat(materials[i].normal_map),
-                        materials[i].albedo.w,
-                        glm::uintBitsToFloat(
-                            static_cast<uint32_t>((materials[i].flags & kGfxMaterialFlag_DoubleSided) != 0)),
-                        glm::uintBitsToFloat(
-                            materials[i].alpha_mode == GfxMaterialAlphaMode_Blend && !noAlpha  ? 2
-                            : materials[i].alpha_mode == GfxMaterialAlphaMode_Mask && !noAlpha ? 1
-                                                                                               : 0))};
-
+                Material const material       = convertMaterial(materials[i]);
                 uint32_t const material_index = gfxSceneGetObjectHandle<GfxMaterial>(scene_, i);
 
                 if (material_index >= material_data.size())
@@ -1628,8 +1518,6 @@ void CapsaicinInternal::updateSceneMaterials() noexcept
             }
             texture_atlas_.clear();
 
-            uint32_t const image_count = gfxSceneGetObjectCount<GfxImage>(scene_);
-
             for (uint32_t i = 0; i < image_count; ++i)
             {
                 GfxConstRef const image_ref = gfxSceneGetObjectHandle<GfxImage>(scene_, i);
@@ -1800,14 +1688,15 @@ bool CapsaicinInternal::updateSceneAnimatedGeometry() noexcept
 
 void CapsaicinInternal::updateSceneBVH(bool const animationGPUUpdated) noexcept
 {
-    if (animationGPUUpdated || mesh_updated_ || transform_updated_ || instances_updated_)
+    if (animationGPUUpdated || meshes_rebuilt_ || transform_updated_ || instances_updated_)
     {
         GfxCommandEvent const command_event(gfx_, "BuildBVH");
         GfxInstance const    *instances      = gfxSceneGetObjects<GfxInstance>(scene_);
         uint32_t const        instance_count = gfxSceneGetObjectCount<GfxInstance>(scene_);
 
-        // Check if performing an update or complete rebuild
-        bool const freshBuild = mesh_updated_ || !acceleration_structure_ || instances_updated_;
+        // Check if performing an update or complete rebuild. Animated vertices and moved instances only
+        // require an update, a complete rebuild is only needed when the mesh buffers have been rebuilt
+        bool const freshBuild = meshes_rebuilt_ || !acceleration_structure_ || instances_updated_;
         if (freshBuild)
         {
             destroyAccelerationStructure();
@@ -1874,9 +1763,11 @@ void CapsaicinInternal::updateSceneBVH(bool const animationGPUUpdated) noexcept
 
                 // Build the mesh into acceleration structure
                 GfxBuffer const index_buffer = gfxCreateBufferRange<uint32_t>(
-                    gfx_, index_buffer_, instance.index_offset_idx, instance.index_count);
-                GfxBuffer const vertex_buffer = gfxCreateBufferRange<Vertex>(gfx_, vertex_buffer_,
-                    instance.vertex_offset_idx[vertex_data_index_], mesh_info.vertex_count);
+                    gfx_, index_heap_.getBuffer(), instance.index_offset_idx, instance.index_count);
+                uint64_t const  vertex_stride = vertex_heap_.getStride();
+                GfxBuffer const vertex_buffer = gfxCreateBufferRange(gfx_, vertex_heap_.getBuffer(),
+                    instance.vertex_offset_idx[vertex_data_index_] * vertex_stride,
+                    mesh_info.vertex_count * vertex_stride);
 
                 GfxConstRef<GfxMaterial> const material_ref = instances[i].material;
                 // The mesh is set as opaque based on the alpha mode flag, we also check if it actually has
@@ -1889,7 +1780,8 @@ void CapsaicinInternal::updateSceneBVH(bool const animationGPUUpdated) noexcept
                         ? kGfxBuildRaytracingPrimitiveFlag_Opaque
                         : 0;
 
-                gfxRaytracingPrimitiveBuild(gfx_, rt_mesh, index_buffer, vertex_buffer, 0, opaqueFlag);
+                gfxRaytracingPrimitiveBuild(gfx_, rt_mesh, index_buffer, vertex_buffer,
+                    static_cast<uint32_t>(vertex_stride), opaqueFlag);
 
                 gfxDestroyBuffer(gfx_, index_buffer);
                 gfxDestroyBuffer(gfx_, vertex_buffer);
@@ -1910,12 +1802,15 @@ void CapsaicinInternal::updateSceneBVH(bool const animationGPUUpdated) noexcept
                     uint32_t const index_count  = instance.index_count;
                     uint32_t const index_offset = instance.index_offset_idx;
 
-                    GfxBuffer const index_buffer =
-                        gfxCreateBufferRange<uint32_t>(gfx_, index_buffer_, index_offset, index_count);
-                    GfxBuffer const vertex_buffer = gfxCreateBufferRange<Vertex>(gfx_, vertex_buffer_,
-                        instance.vertex_offset_idx[vertex_data_index_], mesh_info.vertex_count);
+                    GfxBuffer const index_buffer = gfxCreateBufferRange<uint32_t>(
+                        gfx_, index_heap_.getBuffer(), index_offset, index_count);
+                    uint64_t const  vertex_stride = vertex_heap_.getStride();
+                    GfxBuffer const vertex_buffer = gfxCreateBufferRange(gfx_, vertex_heap_.getBuffer(),
+                        instance.vertex_offset_idx[vertex_data_index_] * vertex_stride,
+                        mesh_info.vertex_count * vertex_stride);
 
-                    gfxRaytracingPrimitiveUpdate(gfx_, rt_mesh, index_buffer, vertex_buffer, sizeof(Vertex));
+                    gfxRaytracingPrimitiveUpdate(
+                        gfx_, rt_mesh, index_buffer, vertex_buffer, static_cast<uint32_t>(vertex_stride));
 
                     gfxDestroyBuffer(gfx_, index_buffer);
                     gfxDestroyBuffer(gfx_, vertex_buffer);
@@ -22,6 +22,7 @@ THE SOFTWARE.
 #pragma once
 
 #include "gpu_shared.h"
+#include "resource_handle.h"
 
 #include <dxgiformat.h>
 #include <map>
@@ -130,6 +131,13 @@ constexpr BitMask<SharedTexture::Flags> operator^(
 
 using SharedTextureList = std::vector<SharedTexture>;
 
+/**
+ * Gets the number of bits used to store each pixel of a texture format.
+ * @param format The texture format.
+ * @return The bits per pixel (0 if the format is not supported).
+ */
+uint32_t GetBitsPerPixel(DXGI_FORMAT format) noexcept;
+
 using DebugViewList = std::vector<std::string_view>;
 
 /**
@@ -187,6 +195,11 @@ using SharedBufferList = std::vector<SharedBuffer>;
 
 using ComponentList = std::vector<std::string_view>;
 
+using SharedTextureHandle = ResourceHandle<SharedTexture>;
+using SharedBufferHandle  = ResourceHandle<SharedBuffer>;
+template<typename T>
+using ComponentHandle = ResourceHandle<T>;
+
 /**
  * A macro for easy creation of render options from a struct.
  * @param  variable The member variable name.
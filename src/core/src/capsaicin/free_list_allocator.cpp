@@ -0,0 +1,110 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "free_list_allocator.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace Capsaicin
+{
+uint32_t FreeListAllocator::allocate(uint32_t const count) noexcept
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    auto const fits  = [count](auto const &item) { return item.second >= count; };
+    auto       range = std::ranges::find_if(free_ranges_, fits);
+    if (range == free_ranges_.end())
+    {
+        grow(count);
+        range = std::ranges::find_if(free_ranges_, fits);
+        assert(range != free_ranges_.end());
+    }
+    auto const [offset, rangeCount] = *range;
+    free_ranges_.erase(range);
+    if (rangeCount > count)
+    {
+        free_ranges_.emplace(offset + count, rangeCount - count);
+    }
+    used_ += count;
+    return offset;
+}
+
+void FreeListAllocator::free(uint32_t offset, uint32_t count) noexcept
+{
+    if (count == 0)
+    {
+        return;
+    }
+    assert(used_ >= count && offset + count <= capacity_);
+    used_ -= count;
+
+    // Merge with the following free range
+    if (auto const next = free_ranges_.find(offset + count); next != free_ranges_.end())
+    {
+        count += next->second;
+        free_ranges_.erase(next);
+    }
+    // Merge with the preceding free range
+    if (auto next = free_ranges_.lower_bound(offset); next != free_ranges_.begin())
+    {
+        if (auto const previous = std::prev(next); previous->first + previous->second == offset)
+        {
+            previous->second += count;
+            return;
+        }
+    }
+    free_ranges_.emplace(offset, count);
+}
+
+void FreeListAllocator::reset() noexcept
+{
+    free_ranges_.clear();
+    if (capacity_ > 0)
+    {
+        free_ranges_.emplace(0, capacity_);
+    }
+    used_ = 0;
+}
+
+void FreeListAllocator::grow(uint32_t const count) noexcept
+{
+    // Grow geometrically to limit the number of times the backing memory needs to be re-created
+    constexpr uint32_t minCapacity = 1024;
+    uint32_t const     capacity    = std::max({capacity_ + count, capacity_ + (capacity_ >> 1), minCapacity});
+
+    // Extend the last free range if it touches the end of the current capacity
+    uint32_t offset = capacity_;
+    if (!free_ranges_.empty())
+    {
+        if (auto const last = std::prev(free_ranges_.end()); last->first + last->second == capacity_)
+        {
+            offset = last->first;
+            free_ranges_.erase(last);
+        }
+    }
+    free_ranges_.emplace(offset, capacity - offset);
+    capacity_ = capacity;
+}
+} // namespace Capsaicin
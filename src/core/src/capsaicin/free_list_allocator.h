@@ -0,0 +1,81 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+namespace Capsaicin
+{
+/**
+ * A CPU side free-list allocator used to sub-allocate ranges of elements from a larger linear allocation.
+ * Free ranges are kept sorted by offset and are coalesced with their neighbours on release. Allocations use
+ * first-fit and the capacity is grown automatically when no free range is large enough, existing
+ * allocations never move.
+ */
+class FreeListAllocator
+{
+public:
+    /** Defaulted constructor. */
+    FreeListAllocator() noexcept = default;
+
+    /**
+     * Allocate a range of elements, growing the capacity if required.
+     * @param count The number of elements to allocate.
+     * @return The offset of the first element of the allocated range (0 if count is 0).
+     */
+    [[nodiscard]] uint32_t allocate(uint32_t count) noexcept;
+
+    /**
+     * Release a previously allocated range of elements.
+     * @param offset The offset of the first element (as returned by allocate).
+     * @param count  The number of elements in the allocation.
+     */
+    void free(uint32_t offset, uint32_t count) noexcept;
+
+    /** Release all allocations, the current capacity is retained. */
+    void reset() noexcept;
+
+    /**
+     * Gets the total number of elements managed by the allocator.
+     * @return The capacity.
+     */
+    [[nodiscard]] uint32_t getCapacity() const noexcept { return capacity_; }
+
+    /**
+     * Gets the number of currently allocated elements.
+     * @return The used element count.
+     */
+    [[nodiscard]] uint32_t getUsed() const noexcept { return used_; }
+
+private:
+    /**
+     * Increase the capacity so that a range of the requested size is available.
+     * @param count The number of elements that must be allocatable.
+     */
+    void grow(uint32_t count) noexcept;
+
+    std::map<uint32_t, uint32_t> free_ranges_;  /**< Free ranges, maps offset to element count */
+    uint32_t                     capacity_ = 0; /**< Total number of managed elements */
+    uint32_t                     used_     = 0; /**< Number of currently allocated elements */
+};
+} // namespace Capsaicin
@@ -0,0 +1,82 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "geometry_heap.h"
+
+#include <algorithm>
+
+namespace Capsaicin
+{
+void GeometryHeap::initialise(GfxContext const &gfx, std::string_view const &name, uint32_t const stride,
+    uint32_t const bufferStride) noexcept
+{
+    gfx_           = gfx;
+    name_          = name;
+    stride_        = stride;
+    buffer_stride_ = bufferStride != 0 ? bufferStride : stride;
+    if (buffer_)
+    {
+        buffer_.setStride(buffer_stride_);
+    }
+}
+
+void GeometryHeap::destroy() noexcept
+{
+    gfxDestroyBuffer(gfx_, buffer_);
+    buffer_    = {};
+    allocator_ = {};
+}
+
+uint32_t GeometryHeap::allocate(uint32_t const count) noexcept
+{
+    return allocator_.allocate(count);
+}
+
+void GeometryHeap::free(uint32_t const offset, uint32_t const count) noexcept
+{
+    allocator_.free(offset, count);
+}
+
+void GeometryHeap::reset() noexcept
+{
+    allocator_.reset();
+}
+
+bool GeometryHeap::update() noexcept
+{
+    uint64_t const size = static_cast<uint64_t>(std::max(allocator_.getCapacity(), 1U)) * stride_;
+    if (buffer_ && buffer_.getSize() >= size)
+    {
+        return false;
+    }
+    GfxBuffer const buffer = gfxCreateBuffer(gfx_, size);
+    if (buffer_)
+    {
+        gfxCommandCopyBuffer(gfx_, buffer, 0, buffer_, 0, buffer_.getSize());
+        gfxDestroyBuffer(gfx_, buffer_);
+    }
+    buffer_ = buffer;
+    buffer_.setName(name_.c_str());
+    buffer_.setStride(buffer_stride_);
+    return true;
+}
+} // namespace Capsaicin
@@ -0,0 +1,101 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "free_list_allocator.h"
+
+#include <gfx.h>
+#include <string>
+#include <string_view>
+
+namespace Capsaicin
+{
+/**
+ * A persistent GPU buffer that is sub-allocated into ranges using a free-list allocator.
+ * The buffer is only ever grown (preserving existing contents) so that the offsets of existing allocations
+ * remain stable as other allocations are added or removed.
+ */
+class GeometryHeap
+{
+public:
+    /** Defaulted constructor. */
+    GeometryHeap() noexcept = default;
+
+    /**
+     * Initialise the heap. No GPU memory is allocated until the first allocation.
+     * @param gfx          The graphics context.
+     * @param name         The name given to the GPU buffer.
+     * @param stride       The size of each element in bytes.
+     * @param bufferStride (Optional) The stride to set on the GPU buffer if it differs from the element size.
+     */
+    void initialise(GfxContext const &gfx, std::string_view const &name, uint32_t stride,
+        uint32_t bufferStride = 0) noexcept;
+
+    /** Release the GPU buffer and all allocations. */
+    void destroy() noexcept;
+
+    /**
+     * Allocate a range of elements.
+     * The GPU buffer is not resized until update is called.
+     * @param count The number of elements to allocate.
+     * @return The offset of the first element of the allocated range.
+     */
+    [[nodiscard]] uint32_t allocate(uint32_t count) noexcept;
+
+    /**
+     * Release a previously allocated range of elements.
+     * @param offset The offset of the first element (as returned by allocate).
+     * @param count  The number of elements in the allocation.
+     */
+    void free(uint32_t offset, uint32_t count) noexcept;
+
+    /** Release all allocations, the GPU buffer is retained. */
+    void reset() noexcept;
+
+    /**
+     * Grow the GPU buffer (if required) so that it can contain all current allocations.
+     * Any existing buffer contents are copied into the new buffer.
+     * @return True if the buffer was re-created, False otherwise.
+     */
+    bool update() noexcept;
+
+    /**
+     * Gets the GPU buffer.
+     * @return The buffer.
+     */
+    [[nodiscard]] GfxBuffer const &getBuffer() const noexcept { return buffer_; }
+
+    /**
+     * Gets the size of each element in bytes.
+     * @return The element stride.
+     */
+    [[nodiscard]] uint32_t getStride() const noexcept { return stride_; }
+
+private:
+    GfxContext        gfx_;
+    GfxBuffer         buffer_;
+    FreeListAllocator allocator_;
+    std::string       name_;
+    uint32_t          stride_        = 0;
+    uint32_t          buffer_stride_ = 0;
+};
+} // namespace Capsaicin
@@ -21,9 +21,11 @@ THE SOFTWARE.
 ********************************************************************/
 #pragma once
 
-#include "capsaicin_internal.h"
+#include "parallel.h"
 
-#include <ppl.h>
+#include <cstring>
+#include <gfx_scene.h>
+#include <vector>
 
 namespace Capsaicin
 {
@@ -36,8 +38,8 @@ size_t HashCombine(size_t seed, TYPE const &value)
 template<typename TYPE>
 size_t HashReduce(TYPE const *values, uint32_t count)
 {
-    size_t const result = concurrency::parallel_reduce(
-        values, values + count, static_cast<size_t>(0x12345678U),
+    size_t const result = ParallelReduce(
+        values, count, static_cast<size_t>(0x12345678U),
         [](TYPE const *start, TYPE const *end, size_t hash) -> size_t {
             for (auto j = start; j < end; ++j)
             {
@@ -48,124 +50,359 @@ size_t HashReduce(TYPE const *values, uint32_t count)
         [](size_t const hash1, size_t const hash2) -> size_t { return HashCombine(hash1, hash2); });
     return result;
 }
+
+/**
+ * Hash a block of memory.
+ * @param hash The initial hash value to combine with.
+ * @param data The memory to hash.
+ * @param size Size of the memory block in bytes.
+ * @return The combined hash value.
+ */
+inline uint64_t HashBytes(uint64_t hash, void const *data, size_t const size) noexcept
+{
+    // FNV-1a operating on 64bit words at a time with an additional shift to mix upper bits back down
+    constexpr uint64_t prime = 0x00000100000001B3;
+    auto const        *bytes = static_cast<uint8_t const *>(data);
+    size_t             i     = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(uint64_t));
+        hash ^= word;
+        hash *= prime;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; ++i)
+    {
+        hash ^= static_cast<uint64_t>(bytes[i]);
+        hash *= prime;
+    }
+    return hash;
+}
+
+/**
+ * Hash the entire contents of an array.
+ * Large arrays are split into fixed size chunks that are hashed in parallel and then combined in order, so
+ * the result only depends on the array contents.
+ * @tparam TYPE Type of the array elements, must not contain padding.
+ * @param hash   The initial hash value to combine with.
+ * @param values The array to hash.
+ * @return The combined hash value.
+ */
+template<typename TYPE>
+uint64_t HashContents(uint64_t const hash, std::vector<TYPE> const &values) noexcept
+{
+    constexpr size_t chunkSize = 64 * 1024;
+    uint64_t const   count     = values.size();
+    size_t const     size      = values.size() * sizeof(TYPE);
+    uint64_t const   seed      = HashBytes(hash, &count, sizeof(count));
+    if (size <= chunkSize)
+    {
+        return HashBytes(seed, values.data(), size);
+    }
+    auto const *const     bytes      = reinterpret_cast<uint8_t const *>(values.data());
+    auto const            chunkCount = static_cast<uint32_t>((size + chunkSize - 1) / chunkSize);
+    std::vector<uint64_t> chunks(chunkCount);
+    ParallelFor(0U, chunkCount, [&](uint32_t const chunk) {
+        size_t const offset = chunk * chunkSize;
+        chunks[chunk]       = HashBytes(seed, bytes + offset, std::min(chunkSize, size - offset));
+    });
+    return HashBytes(seed, chunks.data(), chunks.size() * sizeof(uint64_t));
+}
+
+/**
+ * Tracks changes to a list of scene objects using per-object content hashes.
+ * Each update rehashes every object in parallel and records which objects differ from the previous update.
+ * Objects are identified by a key (such as their scene handle) so that an object keeps its history when other
+ * objects are added or removed. This allows callers to only rebuild the data for objects that actually
+ * changed.
+ */
+class HashTracker
+{
+public:
+    /**
+     * Update the stored hashes and determine which objects have changed.
+     * @tparam TYPE   Type of the objects being tracked.
+     * @tparam Hasher Type of the hash function.
+     * @tparam Key    Type of the key function.
+     * @param values Array of objects to check.
+     * @param count  Number of objects.
+     * @param hasher Function used to hash an object.
+     * @param key    Function used to get the unique key of an object from its index within values.
+     * @return True if any object was added, removed or changed, False otherwise.
+     */
+    template<typename TYPE, typename Hasher, typename Key>
+    bool update(TYPE const *values, uint32_t const count, Hasher const &hasher, Key const &key) noexcept
+    {
+        std::vector<size_t> hashes(count);
+        ParallelFor(0U, count, [&](uint32_t const i) { hashes[i] = hasher(values[i]); });
+
+        count_changed_ = !valid_ || count != count_;
+        count_         = count;
+        valid_         = true;
+        changed_.clear();
+        removed_.clear();
+        std::vector<uint8_t> seen(present_.size(), 0);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t const index = key(i);
+            if (index >= present_.size())
+            {
+                hashes_.resize(static_cast<size_t>(index) + 1, 0);
+                present_.resize(static_cast<size_t>(index) + 1, 0);
+                seen.resize(static_cast<size_t>(index) + 1, 0);
+            }
+            if (present_[index] == 0 || hashes_[index] != hashes[i])
+            {
+                changed_.push_back(i);
+            }
+            hashes_[index]  = hashes[i];
+            present_[index] = 1;
+            seen[index]     = 1;
+        }
+        for (uint32_t index = 0; index < static_cast<uint32_t>(present_.size()); ++index)
+        {
+            if (present_[index] != 0 && seen[index] == 0)
+            {
+                present_[index] = 0;
+                removed_.push_back(index);
+            }
+        }
+        return !changed_.empty() || !removed_.empty();
+    }
+
+    /**
+     * Update the stored hashes using the index of each object as its key.
+     * @tparam TYPE   Type of the objects being tracked.
+     * @tparam Hasher Type of the hash function.
+     * @param values Array of objects to check.
+     * @param count  Number of objects.
+     * @param hasher Function used to hash an object.
+     * @return True if any object was added, removed or changed, False otherwise.
+     */
+    template<typename TYPE, typename Hasher>
+    bool update(TYPE const *values, uint32_t const count, Hasher const &hasher) noexcept
+    {
+        return update(values, count, hasher, [](uint32_t const i) { return i; });
+    }
+
+    /**
+     * Update the stored hashes using the default std::hash and the index of each object as its key.
+     * @tparam TYPE Type of the objects being tracked.
+     * @param values Array of objects to check.
+     * @param count  Number of objects.
+     * @return True if any object was added, removed or changed, False otherwise.
+     */
+    template<typename TYPE>
+    bool update(TYPE const *values, uint32_t const count) noexcept
+    {
+        return update(values, count, std::hash<TYPE> {});
+    }
+
+    /**
+     * Gets the indices (within the values passed to update) of objects that were added or changed during the
+     * last update.
+     * @return The list of changed object indices.
+     */
+    [[nodiscard]] std::vector<uint32_t> const &getChanged() const noexcept { return changed_; }
+
+    /**
+     * Gets the keys of objects that were removed during the last update.
+     * @return The list of removed object keys.
+     */
+    [[nodiscard]] std::vector<uint32_t> const &getRemoved() const noexcept { return removed_; }
+
+    /**
+     * Check if the number of tracked objects changed during the last update.
+     * @return True if count changed, False otherwise.
+     */
+    [[nodiscard]] bool getCountChanged() const noexcept { return count_changed_; }
+
+    /**
+     * Check if the tracker contains valid history (i.e. has been updated since creation or last reset).
+     * @return True if valid, False otherwise.
+     */
+    [[nodiscard]] bool isValid() const noexcept { return valid_; }
+
+    /** Clear all stored hashes so that every object is reported as changed on the next update. */
+    void reset() noexcept
+    {
+        hashes_.clear();
+        present_.clear();
+        changed_.clear();
+        removed_.clear();
+        count_         = 0;
+        count_changed_ = true;
+        valid_         = false;
+    }
+
+private:
+    std::vector<size_t>   hashes_;               /**< Hash of each object from the last update, by key */
+    std::vector<uint8_t>  present_;              /**< Whether each key was present in the last update */
+    std::vector<uint32_t> changed_;              /**< Indices of objects changed during the last update */
+    std::vector<uint32_t> removed_;              /**< Keys of objects removed during the last update */
+    uint32_t              count_         = 0;    /**< Number of objects in the last update */
+    bool                  count_changed_ = true; /**< True if the object count changed in the last update */
+    bool                  valid_         = false; /**< True if the tracker has been updated since reset */
+};
 } // namespace Capsaicin
 
 namespace std
 {
 template<>
-struct hash<GfxMesh>
+struct hash<glm::mat4>
 {
-    size_t operator()(GfxMesh const &value) const noexcept
+    size_t operator()(glm::mat4 const &value) const noexcept
     {
         size_t hash = 0x12345678U;
 
-        hash = Capsaicin::HashCombine(hash, value.bounds_min);
-        hash = Capsaicin::HashCombine(hash, value.bounds_max);
-        hash = Capsaicin::HashCombine(hash, value.vertices.size());
-        hash = Capsaicin::HashCombine(hash, value.indices.size());
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            hash = Capsaicin::HashCombine(hash, value[i >> 2U][i & 0x3U]);
+        }
 
         return hash;
     }
 };
 
 template<>
-struct hash<GfxInstance>
+struct hash<glm::vec4>
 {
-    size_t operator()(GfxInstance const &value) const noexcept
+    size_t operator()(glm::vec4 const &value) const noexcept
     {
         size_t hash = 0x12345678U;
 
-        hash = Capsaicin::HashCombine(hash, static_cast<uint64_t>(value.mesh));
-        hash = Capsaicin::HashCombine(hash, static_cast<uint64_t>(value.material));
-        hash = Capsaicin::HashCombine(hash, value.transform);
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            hash = Capsaicin::HashCombine(hash, value[i]);
+        }
 
         return hash;
     }
 };
 
 template<>
-struct hash<GfxLight>
+struct hash<glm::vec3>
 {
-    size_t operator()(GfxLight const &value) const noexcept
+    size_t operator()(glm::vec3 const &value) const noexcept
+    {
+        size_t hash = 0x12345678U;
+
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            hash = Capsaicin::HashCombine(hash, value[i]);
+        }
+
+        return hash;
+    }
+};
+
+template<>
+struct hash<glm::vec2>
+{
+    size_t operator()(glm::vec2 const &value) const noexcept
+    {
+        size_t hash = 0x12345678U;
+
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            hash = Capsaicin::HashCombine(hash, value[i]);
+        }
+
+        return hash;
+    }
+};
+
+template<>
+struct hash<GfxVertex>
+{
+    size_t operator()(GfxVertex const &value) const noexcept
     {
         size_t hash = 0x12345678U;
 
-        hash = Capsaicin::HashCombine(hash, value.color);
-        hash = Capsaicin::HashCombine(hash, value.intensity);
         hash = Capsaicin::HashCombine(hash, value.position);
-        hash = Capsaicin::HashCombine(hash, value.direction);
-        hash = Capsaicin::HashCombine(hash, value.range);
-        hash = Capsaicin::HashCombine(hash, value.inner_cone_angle);
-        hash = Capsaicin::HashCombine(hash, value.outer_cone_angle);
+        hash = Capsaicin::HashCombine(hash, value.normal);
+        hash = Capsaicin::HashCombine(hash, value.uv);
 
         return hash;
     }
 };
 
 template<>
-struct hash<GfxMaterial>
+struct hash<GfxMesh>
 {
-    size_t operator()(GfxMaterial const &value) const noexcept
+    size_t operator()(GfxMesh const &value) const noexcept
     {
         size_t hash = 0x12345678U;
 
-        hash = Capsaicin::HashCombine(hash, value.albedo);
-        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.albedo_map));
-        hash = Capsaicin::HashCombine(hash, value.emissivity);
-        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.emissivity_map));
-        hash = Capsaicin::HashCombine(hash, value.metallicity);
-        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.metallicity_map));
-        hash = Capsaicin::HashCombine(hash, value.roughness);
-        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.roughness_map));
-        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.normal_map));
+        hash = Capsaicin::HashCombine(hash, value.bounds_min);
+        hash = Capsaicin::HashCombine(hash, value.bounds_max);
+
+        // Every vertex, index, morph target and joint is hashed so that any in place edit is detected, meshes
+        // are only rehashed on frames where the scene may have changed
+        uint64_t contents = 0xCBF29CE484222325;
+        contents          = Capsaicin::HashContents(contents, value.vertices);
+        contents          = Capsaicin::HashContents(contents, value.indices);
+        contents          = Capsaicin::HashContents(contents, value.morph_targets);
+        contents          = Capsaicin::HashContents(contents, value.joints);
+        hash              = Capsaicin::HashCombine(hash, contents);
 
         return hash;
     }
 };
 
 template<>
-struct hash<glm::mat4>
+struct hash<GfxInstance>
 {
-    size_t operator()(glm::mat4 const &value) const noexcept
+    size_t operator()(GfxInstance const &value) const noexcept
     {
         size_t hash = 0x12345678U;
 
-        for (uint32_t i = 0; i < 16; ++i)
-        {
-            hash = Capsaicin::HashCombine(hash, value[i >> 2U][i & 0x3U]);
-        }
+        hash = Capsaicin::HashCombine(hash, static_cast<uint64_t>(value.mesh));
+        hash = Capsaicin::HashCombine(hash, static_cast<uint64_t>(value.material));
+        hash = Capsaicin::HashCombine(hash, value.transform);
 
         return hash;
     }
 };
 
 template<>
-struct hash<glm::vec4>
+struct hash<GfxLight>
 {
-    size_t operator()(glm::vec4 const &value) const noexcept
+    size_t operator()(GfxLight const &value) const noexcept
     {
         size_t hash = 0x12345678U;
 
-        for (uint32_t i = 0; i < 4; ++i)
-        {
-            hash = Capsaicin::HashCombine(hash, value[i]);
-        }
+        hash = Capsaicin::HashCombine(hash, value.color);
+        hash = Capsaicin::HashCombine(hash, value.intensity);
+        hash = Capsaicin::HashCombine(hash, value.position);
+        hash = Capsaicin::HashCombine(hash, value.direction);
+        hash = Capsaicin::HashCombine(hash, value.range);
+        hash = Capsaicin::HashCombine(hash, value.inner_cone_angle);
+        hash = Capsaicin::HashCombine(hash, value.outer_cone_angle);
 
         return hash;
     }
 };
 
 template<>
-struct hash<glm::vec3>
+struct hash<GfxMaterial>
 {
-    size_t operator()(glm::vec3 const &value) const noexcept
+    size_t operator()(GfxMaterial const &value) const noexcept
     {
         size_t hash = 0x12345678U;
 
-        for (uint32_t i = 0; i < 3; ++i)
-        {
-            hash = Capsaicin::HashCombine(hash, value[i]);
-        }
+        hash = Capsaicin::HashCombine(hash, value.albedo);
+        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.albedo_map));
+        hash = Capsaicin::HashCombine(hash, value.emissivity);
+        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.emissivity_map));
+        hash = Capsaicin::HashCombine(hash, value.metallicity);
+        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.metallicity_map));
+        hash = Capsaicin::HashCombine(hash, value.roughness);
+        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.roughness_map));
+        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.normal_map));
+        hash = Capsaicin::HashCombine(hash, static_cast<uint32_t>(value.alpha_mode));
+        hash = Capsaicin::HashCombine(hash, value.flags);
 
         return hash;
     }
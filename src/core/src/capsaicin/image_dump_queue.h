@@ -0,0 +1,181 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Bounded queue of image dumps that are encoded and written to disk by a pool of background threads.
+ * Images reference the mapped memory of a readback buffer directly so no copy is made on the render thread.
+ * The total size of queued and in progress images is capped, pushing an image that would exceed the cap
+ * blocks until enough earlier images have completed. Completed images are handed back so that the resources
+ * they own can be released on the thread that owns the gfx context.
+ * @tparam Image Description of an image to write along with the resources owning its data, must be default
+ *  constructible and movable.
+ */
+template<typename Image>
+class ImageDumpQueue
+{
+public:
+    /** Function used to encode and write an image, called from the worker threads. */
+    using Encoder = std::function<void(Image const &)>;
+
+    /** Defaulted constructor. */
+    ImageDumpQueue() noexcept = default;
+
+    /** Destructor, waits for all remaining images to be written. */
+    ~ImageDumpQueue() noexcept { stop(); }
+
+    ImageDumpQueue(ImageDumpQueue const &other)                = delete;
+    ImageDumpQueue(ImageDumpQueue &&other) noexcept            = delete;
+    ImageDumpQueue &operator=(ImageDumpQueue const &other)     = delete;
+    ImageDumpQueue &operator=(ImageDumpQueue &&other) noexcept = delete;
+
+    /**
+     * Start the worker threads.
+     * @param encoder         The function used to write each image.
+     * @param threadCount     Number of worker threads to use.
+     * @param maxPendingBytes Maximum combined size of all queued and in progress images.
+     */
+    void start(Encoder encoder, uint32_t const threadCount, size_t const maxPendingBytes) noexcept
+    {
+        stop();
+        encoder_           = std::move(encoder);
+        max_pending_bytes_ = maxPendingBytes;
+        stopping_          = false;
+        threads_.reserve(std::max(threadCount, 1U));
+        for (uint32_t i = 0; i < std::max(threadCount, 1U); ++i)
+        {
+            threads_.emplace_back([this] { worker(); });
+        }
+    }
+
+    /**
+     * Add an image to the queue.
+     * If the queue is full this blocks until enough space is available. An image larger than the cap is
+     * accepted once the queue is empty.
+     * @param image The image to add.
+     * @param bytes The size of the memory held by the image that is counted against the cap.
+     */
+    void push(Image &&image, size_t const bytes) noexcept
+    {
+        {
+            std::unique_lock lock(mutex_);
+            // Apply backpressure to the caller instead of letting outstanding readback memory grow without
+            // bound
+            job_completed_.wait(
+                lock, [&] { return pending_bytes_ == 0 || pending_bytes_ + bytes <= max_pending_bytes_; });
+            pending_bytes_ += bytes;
+            jobs_.emplace_back(std::move(image), bytes);
+        }
+        work_available_.notify_one();
+    }
+
+    /** Block until all queued images have been written. */
+    void flush() noexcept
+    {
+        std::unique_lock lock(mutex_);
+        job_completed_.wait(lock, [&] { return jobs_.empty() && active_jobs_ == 0; });
+    }
+
+    /** Write all remaining images and stop the worker threads. */
+    void stop() noexcept
+    {
+        {
+            std::scoped_lock const lock(mutex_);
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+        // Workers drain the remaining jobs before exiting
+        threads_.clear();
+    }
+
+    /**
+     * Take all images completed since the last call.
+     * @return The images that are no longer referenced by the workers and can be released.
+     */
+    [[nodiscard]] std::vector<Image> takeCompleted() noexcept
+    {
+        std::scoped_lock const lock(mutex_);
+        return std::exchange(completed_, {});
+    }
+
+    /**
+     * Check if the worker threads are running.
+     * @return True if started, False otherwise.
+     */
+    [[nodiscard]] bool isStarted() const noexcept { return !threads_.empty(); }
+
+private:
+    /** An image waiting to be written along with its size. */
+    using Job = std::pair<Image, size_t>;
+
+    /** Main loop of each worker thread. */
+    void worker() noexcept
+    {
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock lock(mutex_);
+                work_available_.wait(lock, [&] { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty())
+                {
+                    return;
+                }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+                ++active_jobs_;
+            }
+            encoder_(job.first);
+            {
+                std::scoped_lock const lock(mutex_);
+                --active_jobs_;
+                pending_bytes_ -= job.second;
+                completed_.push_back(std::move(job.first));
+            }
+            job_completed_.notify_all();
+        }
+    }
+
+    Encoder                   encoder_;
+    std::vector<std::jthread> threads_;
+    std::mutex                mutex_;
+    std::condition_variable   work_available_;          /**< Signalled when a job is pushed or on stop */
+    std::condition_variable   job_completed_;           /**< Signalled when a job has been written */
+    std::deque<Job>           jobs_;                    /**< Jobs waiting for a worker */
+    std::vector<Image>        completed_;               /**< Images of written jobs */
+    size_t                    pending_bytes_     = 0;     /**< Size of all queued and in progress jobs */
+    size_t                    max_pending_bytes_ = 0;     /**< Cap on pending_bytes_ */
+    uint32_t                  active_jobs_       = 0;     /**< Number of jobs currently being written */
+    bool                      stopping_          = false; /**< Set when the workers should exit */
+};
+} // namespace Capsaicin
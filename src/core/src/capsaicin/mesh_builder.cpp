@@ -0,0 +1,387 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "mesh_builder.h"
+
+#include <cmath>
+#include <meshoptimizer.h>
+#include <tuple>
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Generate a single LOD level for a mesh.
+ * @param       settings          The settings used to process the mesh.
+ * @param       offsetLOD         The LOD level to generate.
+ * @param       vertexBuffer      The mesh vertices.
+ * @param       indexBuffer       The mesh indices.
+ * @param [out] indexBufferOut    The output index buffer (may be the same as the input).
+ * @param       indexBufferOffset Offset into the output index buffer to write to.
+ * @return The index offset, index count and absolute LOD error of the generated LOD.
+ */
+std::tuple<size_t, size_t, float> GenerateLOD(MeshBuildSettings const &settings, uint32_t const offsetLOD,
+    std::vector<GfxVertex> const &vertexBuffer, std::vector<uint32_t> const &indexBuffer,
+    std::vector<uint32_t> &indexBufferOut, size_t const indexBufferOffset = 0) noexcept
+{
+    size_t const vertexCount = vertexBuffer.size();
+    size_t       indexCount  = indexBuffer.size();
+
+    // Generate LOD. Note: mesh optimizer creates LODs by removing indices from the
+    // index buffer and doesn't attempt to move vertices
+    float const threshold = std::pow(0.5F, static_cast<float>(offsetLOD));
+    auto const  targetIndexCount =
+        static_cast<size_t>(fmax(static_cast<float>(indexCount) * threshold, 6.0F));
+    constexpr float    baseTargetError = 0.1F;
+    float              targetError     = baseTargetError * static_cast<float>(offsetLOD);
+    constexpr uint32_t options         = meshopt_SimplifyLockBorder;
+
+    float lodError = 0.0F;
+    indexBufferOut.resize(indexBufferOffset + indexBuffer.size());
+    indexCount = meshopt_simplify(indexBufferOut.data() + indexBufferOffset, indexBuffer.data(), indexCount,
+        &vertexBuffer[0].position.x, vertexCount, sizeof(GfxVertex), targetIndexCount, targetError, options,
+        &lodError);
+
+    uint32_t retries = 1;
+    while (indexCount == 0 && retries <= offsetLOD)
+    {
+        // Simplify has gone way overboard, try and back off until it works
+        targetError = baseTargetError * static_cast<float>(offsetLOD - retries);
+        indexCount  = meshopt_simplify(indexBufferOut.data() + indexBufferOffset, indexBuffer.data(),
+             indexBuffer.size(), &vertexBuffer[0].position.x, vertexCount, sizeof(GfxVertex),
+             targetIndexCount, targetError, options, &lodError);
+        ++retries;
+    }
+    indexBufferOut.resize(indexBufferOffset + indexCount);
+
+    if (settings.lod_aggressive && indexCount > 100
+        && static_cast<float>(indexCount) / static_cast<float>(targetIndexCount) > 2.0F)
+    {
+        // If simplify doest reduce by as many indices as we want then fall back to a
+        // less accurate but cruder simplification technique
+        auto indexCount2 = meshopt_simplifySloppy(indexBufferOut.data() + indexBufferOffset,
+            indexBuffer.data(), indexCount, &vertexBuffer[0].position.x, vertexCount, sizeof(GfxVertex),
+            targetIndexCount, targetError, &lodError);
+
+        retries = 1;
+        while (indexCount2 == 0 && retries <= offsetLOD)
+        {
+            // Sloppy simplification can at time completely remove all indices in this
+            // case we back off until we get a value that works much like the back off
+            // for regular simplify
+            targetError = baseTargetError * static_cast<float>(offsetLOD - retries);
+            indexCount2 = meshopt_simplifySloppy(indexBufferOut.data() + indexBufferOffset,
+                indexBuffer.data(), indexCount, &vertexBuffer[0].position.x, vertexCount, sizeof(GfxVertex),
+                targetIndexCount, targetError, &lodError);
+            ++retries;
+        }
+        if (indexCount2 != 0)
+        {
+            // We only use the output of sloppy simplification if it is actually valid.
+            // If the fall-back still couldn't find anything then we ignore the output
+            // of sloppy entirely
+            indexBufferOut.resize(indexBufferOffset + indexCount2);
+            indexCount = indexCount2;
+        }
+    }
+    // mesh optimizer outputs the LOD error as a relative metric, to convert it to an absolute
+    // value as it needs to be scaled
+    lodError *= meshopt_simplifyScale(&vertexBuffer[0].position.x, vertexCount, sizeof(GfxVertex));
+    return std::make_tuple(indexBufferOffset, indexCount, lodError);
+}
+
+/**
+ * Copy a (possibly re-indexed) mesh into the GPU mesh data, generating meshlets if requested.
+ * @param       settings      The settings used to process the mesh.
+ * @param       meshVertices  The mesh vertices.
+ * @param       meshIndices   The mesh indices.
+ * @param       morphVertices The morph target vertices.
+ * @param       joints        The skinning joints.
+ * @param [out] out           The processed mesh data.
+ */
+void LoadMesh(MeshBuildSettings const &settings, std::vector<GfxVertex> const &meshVertices,
+    std::vector<uint32_t> const &meshIndices, std::vector<GfxVertex> const &morphVertices,
+    std::vector<GfxJoint> const &joints, MeshBuildData &out) noexcept
+{
+    // Get mesh values
+    auto const indexCount = meshIndices.size();
+    MeshInfo  &mesh       = out.mesh;
+    mesh.index_count      = static_cast<uint32_t>(indexCount);
+    mesh.targets_count    = static_cast<uint32_t>(morphVertices.size() / meshVertices.size());
+    mesh.vertex_count     = static_cast<uint32_t>(meshVertices.size());
+    mesh.is_animated      = !joints.empty() || !morphVertices.empty();
+
+    // Add mesh vertices. If the mesh has skinning/morphs then it is added to a secondary vertex
+    // list used specifically for animation.
+    if (!mesh.is_animated)
+    {
+        mesh.vertex_offset_idx[0] = 0;
+        mesh.vertex_offset_idx[1] = 0;
+        out.vertices.reserve(mesh.vertex_count);
+        for (auto const &[vertPosition, vertNormal, vertUV] : meshVertices)
+        {
+            Vertex vertex       = {};
+            vertex.position_uvx = float4(vertPosition, vertUV.x);
+            vertex.normal_uvy   = float4(vertNormal, vertUV.y);
+            out.vertices.push_back(vertex);
+        }
+    }
+    else
+    {
+        // For every animated instance, allocate two slots
+        // for animated vertex data generated from vertex source data.
+        mesh.vertex_offset_idx[0] = 0;
+        mesh.vertex_offset_idx[1] = mesh.vertex_count;
+        out.vertices.resize(2ULL * mesh.vertex_count);
+
+        out.vertex_source.reserve(static_cast<size_t>(mesh.vertex_count) * (1 + mesh.targets_count));
+        for (size_t j = 0; j < mesh.vertex_count; ++j)
+        {
+            Vertex vertex       = {};
+            vertex.position_uvx = float4(meshVertices[j].position, meshVertices[j].uv.x);
+            vertex.normal_uvy   = float4(meshVertices[j].normal, meshVertices[j].uv.y);
+            out.vertex_source.push_back(vertex);
+            for (uint32_t k = 0; k < mesh.targets_count; ++k)
+            {
+                Vertex target_vertex       = {};
+                target_vertex.position_uvx = float4(morphVertices[j * mesh.targets_count + k].position,
+                    morphVertices[j * mesh.targets_count + k].uv.x);
+                target_vertex.normal_uvy   = float4(morphVertices[j * mesh.targets_count + k].normal,
+                    morphVertices[j * mesh.targets_count + k].uv.y);
+                out.vertex_source.push_back(target_vertex);
+            }
+        }
+    }
+
+    if (settings.meshlets)
+    {
+        // Create meshlets
+        {
+            constexpr size_t max_vertices  = 64;
+            constexpr size_t max_triangles = 64;
+            constexpr float  cone_weight   = 1.0F;
+
+            // Build meshlets
+            size_t const                 indexCountLOD = meshIndices.size();
+            std::vector<meshopt_Meshlet> meshlets(
+                meshopt_buildMeshletsBound(indexCountLOD, max_vertices, max_triangles));
+            std::vector<uint32_t> meshletVertices(meshlets.size() * max_vertices);
+            std::vector<uint8_t>  meshletTriangles(meshlets.size() * max_triangles * 3);
+            meshlets.resize(meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(),
+                meshletTriangles.data(), meshIndices.data(), indexCountLOD,
+                &meshVertices[0].position.x, mesh.vertex_count, sizeof(GfxVertex), max_vertices,
+                max_triangles, cone_weight));
+
+            // Collapse used memory from worst case usage
+            meshopt_Meshlet const &lastMeshlet = meshlets.back();
+            meshletVertices.resize(lastMeshlet.vertex_offset + lastMeshlet.vertex_count);
+            meshletTriangles.resize(
+                lastMeshlet.triangle_offset + ((lastMeshlet.triangle_count * 3 + 3) & ~3U));
+
+            // Optimise meshlet layout
+            for (auto &[vertexOffset, triangleOffset, vertexCount, triangleCount] : meshlets)
+            {
+                meshopt_optimizeMeshlet(&meshletVertices[vertexOffset],
+                    &meshletTriangles[triangleOffset], triangleCount, vertexCount);
+            }
+
+            mesh.meshlet_count      = static_cast<uint32_t>(meshlets.size());
+            mesh.meshlet_offset_idx = 0;
+
+            std::vector<uint32_t> &indices = out.indices;
+            for (auto &[meshlet_vertex_offset, meshlet_triangle_offset, meshlet_vertex_count,
+                     meshlet_triangle_count] : meshlets)
+            {
+                // Add packed meshlet data. Each meshlet contains limited number of
+                // vertices/triangles, so we store them using a packed lower bit representation.
+                // These packed vertex indices act as offsets to the base mesh which is itself
+                // stored as a vertex offset in the global vertex buffer
+                // (instance.vertex_offset_idx)
+                auto const dataOffset = static_cast<uint32_t>(out.meshlet_pack.size());
+                for (uint32_t j = 0; j < meshlet_vertex_count; ++j)
+                {
+                    out.meshlet_pack.push_back(
+                        meshletVertices[static_cast<size_t>(meshlet_vertex_offset) + j]);
+                }
+
+                // Meshlet indices are also stored packed in lower bit representation. These are
+                // used to order the meshlet vertices into triangles.
+                auto const indexMeshletOffset = static_cast<uint32_t>(indices.size());
+                for (size_t j = 0; j < meshlet_triangle_count; ++j)
+                {
+                    // Indices are packed into same data buffer as vertices. Since they are only 8
+                    // bit we can pack them into a 32bit uint inorder to avoid issues with reading
+                    // buffers in HLSL
+                    size_t const offset = static_cast<size_t>(meshlet_triangle_offset) + (j * 3);
+                    out.meshlet_pack.push_back(
+                        static_cast<uint32_t>(meshletTriangles[offset])
+                        | (static_cast<uint32_t>(meshletTriangles[offset + 1]) << 10)
+                        | (static_cast<uint32_t>(meshletTriangles[offset + 2]) << 20));
+
+                    // Remap index buffer to meshlet indices so that primitiveIDs match
+                    indices.push_back(
+                        meshletVertices[meshletTriangles[offset]
+                                        + static_cast<size_t>(meshlet_vertex_offset)]);
+                    indices.push_back(
+                        meshletVertices[meshletTriangles[offset + 1]
+                                        + static_cast<size_t>(meshlet_vertex_offset)]);
+                    indices.push_back(
+                        meshletVertices[meshletTriangles[offset + 2]
+                                        + static_cast<size_t>(meshlet_vertex_offset)]);
+                }
+
+                // Add the new meshlet
+                Meshlet m              = {};
+                m.vertex_count         = static_cast<uint16_t>(meshlet_vertex_count);
+                m.triangle_count       = static_cast<uint16_t>(meshlet_triangle_count);
+                m.data_offset_idx      = dataOffset;
+                m.mesh_prim_offset_idx = indexMeshletOffset / 3;
+                out.meshlets.push_back(m);
+
+                if (settings.meshlet_cull)
+                {
+                    meshopt_Bounds const bounds =
+                        meshopt_computeMeshletBounds(&meshletVertices[meshlet_vertex_offset],
+                            &meshletTriangles[meshlet_triangle_offset], meshlet_triangle_count,
+                            &meshVertices[0].position.x, mesh.vertex_count, sizeof(GfxVertex));
+
+                    MeshletCull m2 = {};
+                    m2.sphere      = float4(
+                        bounds.center[0], bounds.center[1], bounds.center[2], bounds.radius);
+                    m2.cone = float4(bounds.cone_axis[0], bounds.cone_axis[1],
+                        bounds.cone_axis[2], bounds.cone_cutoff);
+                    out.meshlet_cull.push_back(m2);
+                }
+            }
+        }
+    }
+    else
+    {
+        // Must add indices in normally
+        out.indices.assign(meshIndices.begin(), meshIndices.end());
+    }
+
+    out.joints.reserve(joints.size());
+    for (auto const &[jointJoints, jointWeights] : joints)
+    {
+        out.joints.emplace_back(jointJoints, jointWeights);
+    }
+}
+} // namespace
+
+void BuildMesh(GfxMesh const &source, MeshBuildSettings const &settings, MeshBuildData &out) noexcept
+{
+    out = {};
+
+    // Check current LOD mode and load meshes accordingly
+    if (settings.lod_mode == 0)
+    {
+        // Default mode just loads meshes unaltered
+        LoadMesh(settings, source.vertices, source.indices, source.morph_targets, source.joints, out);
+    }
+    else if (settings.lod_mode >= 1)
+    {
+        if (constexpr uint32_t minIndicesCap = 20;
+            settings.lod_mode == 2 || (settings.lod_offset != 0 && source.indices.size() > minIndicesCap))
+        {
+            // Reindex index buffer to remove duplicated vertices
+            size_t const indexCount           = source.indices.size();
+            size_t const unindexedVertexCount = source.vertices.size();
+            size_t const morphCount           = source.morph_targets.size() / source.vertices.size();
+            std::vector<meshopt_Stream> streams;
+            streams.reserve(1 + morphCount);
+            streams.emplace_back(source.vertices.data(), sizeof(GfxVertex), sizeof(GfxVertex));
+            if (!source.joints.empty())
+            {
+                streams.emplace_back(source.joints.data(), sizeof(GfxJoint), sizeof(GfxJoint));
+            }
+            for (size_t j = 0; j < morphCount; ++j)
+            {
+                streams.emplace_back(source.morph_targets.data() + (j * source.vertices.size()),
+                    sizeof(GfxVertex), sizeof(GfxVertex));
+            }
+            std::vector<uint32_t> remap(indexCount);
+            size_t                vertexCount = meshopt_generateVertexRemapMulti(remap.data(),
+                source.indices.data(), indexCount, unindexedVertexCount, streams.data(), streams.size());
+            std::vector<uint32_t> indexBuffer(indexCount);
+            meshopt_remapIndexBuffer(indexBuffer.data(), source.indices.data(), indexCount, remap.data());
+            std::vector<GfxVertex> vertexBuffer(vertexCount);
+            meshopt_remapVertexBuffer(vertexBuffer.data(), source.vertices.data(), unindexedVertexCount,
+                sizeof(GfxVertex), remap.data());
+            std::vector<GfxVertex> morphVertices(morphCount * vertexCount);
+            for (size_t morph = 0; morph < morphCount; ++morph)
+            {
+                meshopt_remapVertexBuffer(morphVertices.data() + (morph * vertexCount),
+                    source.morph_targets.data() + (morph * unindexedVertexCount), unindexedVertexCount,
+                    sizeof(GfxVertex), remap.data());
+            }
+            std::vector<GfxJoint> joints(source.joints.empty() ? 0 : vertexCount);
+            if (!joints.empty())
+            {
+                meshopt_remapVertexBuffer(joints.data(), source.joints.data(), unindexedVertexCount,
+                    sizeof(GfxJoint), remap.data());
+            }
+
+            // Get mesh LOD data
+            if (settings.lod_mode == 1)
+            {
+                // If using Manual mode we can just generate a single LOD for the requested LOD level
+                GenerateLOD(settings, settings.lod_offset, vertexBuffer, indexBuffer, indexBuffer);
+
+                // Compact the vertex buffer by removing unused vertices. The same remap must be applied to
+                // every per-vertex stream so that they remain in sync with the vertices
+                auto const            vertexCountOriginal = vertexCount;
+                std::vector<uint32_t> fetchRemap(vertexCountOriginal);
+                vertexCount = meshopt_optimizeVertexFetchRemap(
+                    fetchRemap.data(), indexBuffer.data(), indexBuffer.size(), vertexCountOriginal);
+                meshopt_remapIndexBuffer(
+                    indexBuffer.data(), indexBuffer.data(), indexBuffer.size(), fetchRemap.data());
+                meshopt_remapVertexBuffer(vertexBuffer.data(), vertexBuffer.data(), vertexCountOriginal,
+                    sizeof(GfxVertex), fetchRemap.data());
+                vertexBuffer.resize(vertexCount);
+                std::vector<GfxVertex> fetchMorphVertices(morphCount * vertexCount);
+                for (size_t morph = 0; morph < morphCount; ++morph)
+                {
+                    meshopt_remapVertexBuffer(fetchMorphVertices.data() + (morph * vertexCount),
+                        morphVertices.data() + (morph * vertexCountOriginal), vertexCountOriginal,
+                        sizeof(GfxVertex), fetchRemap.data());
+                }
+                morphVertices.swap(fetchMorphVertices);
+                if (!joints.empty())
+                {
+                    meshopt_remapVertexBuffer(joints.data(), joints.data(), vertexCountOriginal,
+                        sizeof(GfxJoint), fetchRemap.data());
+                    joints.resize(vertexCount);
+                }
+            }
+
+            LoadMesh(settings, vertexBuffer, indexBuffer, morphVertices, joints, out);
+        }
+        else
+        {
+            // Just use default
+            LoadMesh(settings, source.vertices, source.indices, source.morph_targets, source.joints, out);
+        }
+    }
+}
+} // namespace Capsaicin
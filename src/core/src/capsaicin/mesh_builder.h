@@ -0,0 +1,78 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "gpu_shared.h"
+
+#include <gfx_scene.h>
+#include <vector>
+
+namespace Capsaicin
+{
+struct MeshInfo
+{
+    uint vertex_offset_idx[2];
+    uint index_offset_idx;
+    uint index_count;
+    uint vertex_source_offset_idx;
+    uint joints_offset;
+    uint targets_count;
+    uint vertex_count;
+    uint meshlet_count;      /**< Number of meshlets in mesh */
+    uint meshlet_offset_idx; /**< Absolute offset into Meshlet buffer for first meshlet */
+    bool is_animated;
+};
+
+/** Intermediate mesh data generated for each mesh before being combined into the scene buffers. */
+struct MeshBuildData
+{
+    MeshInfo                 mesh = {}; /**< Mesh info, all offsets are relative to the data below */
+    std::vector<uint32_t>    indices;
+    std::vector<Vertex>      vertices; /**< Mesh vertices (or empty animated vertex slots) */
+    std::vector<Vertex>      vertex_source;
+    std::vector<Joint>       joints;
+    std::vector<Meshlet>     meshlets;
+    std::vector<uint32_t>    meshlet_pack;
+    std::vector<MeshletCull> meshlet_cull;
+};
+
+/** Settings that effect how a mesh is processed, these match the equivalent capsaicin render options. */
+struct MeshBuildSettings
+{
+    uint32_t lod_mode       = 0;     /**< The LOD mode (capsaicin_lod_mode) */
+    uint32_t lod_offset     = 0;     /**< The LOD offset (capsaicin_lod_offset) */
+    bool     lod_aggressive = false; /**< Aggressive LOD simplification (capsaicin_lod_aggressive) */
+    bool     meshlets       = false; /**< True to generate meshlet data */
+    bool     meshlet_cull   = false; /**< True to generate meshlet culling data */
+};
+
+/**
+ * Process a mesh into the data required for loading to GPU.
+ * Indices and skinning data are copied, vertex data is copied to the vertex list for static meshes or to the
+ * vertex source list for animated ones. LODs and meshlets are generated as requested by the settings. The
+ * output only depends on the input mesh and settings so any number of meshes can be built in parallel.
+ * @param       mesh     The source mesh.
+ * @param       settings The settings used to process the mesh.
+ * @param [out] out      The processed mesh data, all offsets are relative to the meshes own data.
+ */
+void BuildMesh(GfxMesh const &mesh, MeshBuildSettings const &settings, MeshBuildData &out) noexcept;
+} // namespace Capsaicin
@@ -0,0 +1,208 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "mesh_cache.h"
+
+#include "atomic_file.h"
+#include "hash_reduce.h"
+
+#include <fstream>
+#include <meshoptimizer.h>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kMeshCacheMagic   = 0x4853454DU; /**< 'MESH' */
+constexpr uint32_t kMeshCacheVersion = 2U; /**< Must be incremented whenever mesh processing changes */
+constexpr uint64_t kMeshCacheAlign   = 16U; /**< Alignment of each data section within a cache file */
+
+/**
+ * Header found at the start of every cache file.
+ * Each data array follows the header in the same order as the counts array. Each section begins at an
+ * offset aligned to kMeshCacheAlign so that a cache file can be directly memory mapped.
+ */
+struct MeshCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t mesh_info_size; /**< Size of MeshInfo used when writing (detects layout changes) */
+    uint32_t vertex_size;    /**< Size of Vertex used when writing (detects layout changes) */
+    uint64_t counts[7];      /**< Element count of each data array */
+};
+
+constexpr uint64_t AlignOffset(uint64_t const offset) noexcept
+{
+    return (offset + kMeshCacheAlign - 1) & ~(kMeshCacheAlign - 1);
+}
+
+template<typename T>
+uint64_t HashVector(uint64_t const hash, std::vector<T> const &values) noexcept
+{
+    uint64_t const count = values.size();
+    return HashBytes(HashBytes(hash, &count, sizeof(count)), values.data(), values.size() * sizeof(T));
+}
+
+template<typename T>
+uint64_t HashValue(uint64_t const hash, T const &value) noexcept
+{
+    return HashBytes(hash, &value, sizeof(T));
+}
+} // namespace
+
+MeshCache::MeshCache(std::filesystem::path directory) noexcept
+    : directory_(std::move(directory))
+{}
+
+bool MeshCache::isEnabled() const noexcept
+{
+    return !directory_.empty();
+}
+
+uint64_t MeshCache::CalculateKey(GfxMesh const &mesh, uint32_t const lodMode, uint32_t const lodOffset,
+    bool const lodAggressive, bool const meshlets, bool const meshletCull) noexcept
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    hash          = HashValue(hash, kMeshCacheVersion);
+    hash          = HashValue(hash, static_cast<uint32_t>(MESHOPTIMIZER_VERSION));
+    hash          = HashVector(hash, mesh.vertices);
+    hash          = HashVector(hash, mesh.indices);
+    hash          = HashVector(hash, mesh.morph_targets);
+    hash          = HashVector(hash, mesh.joints);
+    // Only include LOD settings that actually effect the output
+    uint32_t const lodAggressiveFlag = lodMode > 0 && lodAggressive ? 1 : 0;
+    hash                             = HashValue(hash, lodMode);
+    hash                             = HashValue(hash, lodMode > 0 ? lodOffset : 0U);
+    hash                             = HashValue(hash, lodAggressiveFlag);
+    hash = HashValue(hash, static_cast<uint32_t>(meshlets) | (static_cast<uint32_t>(meshletCull) << 1));
+    return hash;
+}
+
+bool MeshCache::load(uint64_t const key, MeshBuildData &out) const noexcept
+{
+    if (!isEnabled())
+    {
+        return false;
+    }
+    std::ifstream file(getFilePath(key), std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    auto const fileSize = static_cast<uint64_t>(file.tellg());
+    if (fileSize < sizeof(MeshCacheHeader))
+    {
+        return false;
+    }
+    std::vector<char> data(fileSize);
+    file.seekg(0);
+    if (!file.read(data.data(), static_cast<std::streamsize>(fileSize)))
+    {
+        return false;
+    }
+
+    MeshCacheHeader header;
+    memcpy(&header, data.data(), sizeof(MeshCacheHeader));
+    if (header.magic != kMeshCacheMagic || header.version != kMeshCacheVersion || header.key != key
+        || header.mesh_info_size != sizeof(MeshInfo) || header.vertex_size != sizeof(Vertex))
+    {
+        return false;
+    }
+
+    uint64_t   offset      = AlignOffset(sizeof(MeshCacheHeader));
+    auto const readSection = [&]<typename T>(std::vector<T> &values, uint64_t const count) {
+        uint64_t const size = count * sizeof(T);
+        if (offset + size > fileSize)
+        {
+            return false;
+        }
+        values.resize(count);
+        memcpy(values.data(), data.data() + offset, size);
+        offset = AlignOffset(offset + size);
+        return true;
+    };
+    if (offset + sizeof(MeshInfo) > fileSize)
+    {
+        return false;
+    }
+    memcpy(&out.mesh, data.data() + offset, sizeof(MeshInfo));
+    offset = AlignOffset(offset + sizeof(MeshInfo));
+    return readSection(out.indices, header.counts[0]) && readSection(out.vertices, header.counts[1])
+        && readSection(out.vertex_source, header.counts[2]) && readSection(out.joints, header.counts[3])
+        && readSection(out.meshlets, header.counts[4]) && readSection(out.meshlet_pack, header.counts[5])
+        && readSection(out.meshlet_cull, header.counts[6]);
+}
+
+bool MeshCache::save(uint64_t const key, MeshBuildData const &data) const noexcept
+{
+    if (!isEnabled())
+    {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec)
+    {
+        GFX_PRINTLN("Error: Failed to create mesh cache directory: %s", directory_.string().c_str());
+        return false;
+    }
+
+    MeshCacheHeader const header = {.magic = kMeshCacheMagic,
+        .version                           = kMeshCacheVersion,
+        .key                               = key,
+        .mesh_info_size                    = sizeof(MeshInfo),
+        .vertex_size                       = sizeof(Vertex),
+        .counts = {data.indices.size(), data.vertices.size(), data.vertex_source.size(), data.joints.size(),
+            data.meshlets.size(), data.meshlet_pack.size(), data.meshlet_cull.size()}};
+
+    // Write to a unique temporary file first and then move into place so that concurrent readers never see a
+    // partially written entry and concurrent writers of the same entry never share a file
+    return WriteFileAtomic(getFilePath(key), [&](std::ofstream &file) {
+        uint64_t   offset       = 0;
+        auto const writeSection = [&](void const *values, uint64_t const size) {
+            constexpr char padding[kMeshCacheAlign] = {};
+            file.write(static_cast<char const *>(values), static_cast<std::streamsize>(size));
+            uint64_t const alignedOffset = AlignOffset(offset + size);
+            file.write(padding, static_cast<std::streamsize>(alignedOffset - offset - size));
+            offset = alignedOffset;
+        };
+        writeSection(&header, sizeof(header));
+        writeSection(&data.mesh, sizeof(data.mesh));
+        writeSection(data.indices.data(), data.indices.size() * sizeof(uint32_t));
+        writeSection(data.vertices.data(), data.vertices.size() * sizeof(Vertex));
+        writeSection(data.vertex_source.data(), data.vertex_source.size() * sizeof(Vertex));
+        writeSection(data.joints.data(), data.joints.size() * sizeof(Joint));
+        writeSection(data.meshlets.data(), data.meshlets.size() * sizeof(Meshlet));
+        writeSection(data.meshlet_pack.data(), data.meshlet_pack.size() * sizeof(uint32_t));
+        writeSection(data.meshlet_cull.data(), data.meshlet_cull.size() * sizeof(MeshletCull));
+        return file.good();
+    });
+}
+
+std::filesystem::path MeshCache::getFilePath(uint64_t const key) const noexcept
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.mesh", static_cast<unsigned long long>(key));
+    return directory_ / name;
+}
+} // namespace Capsaicin
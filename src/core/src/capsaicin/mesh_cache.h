@@ -0,0 +1,93 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "mesh_builder.h"
+
+#include <filesystem>
+
+namespace Capsaicin
+{
+/**
+ * A persistent on-disk cache of processed mesh data.
+ * Each mesh is stored in its own file named using a hash of the source mesh contents and all settings that
+ * effect how it is processed. As entries are content addressed they never need to be invalidated, any change
+ * to the source mesh or settings simply results in a different key.
+ */
+class MeshCache
+{
+public:
+    /** Defaulted constructor. */
+    MeshCache() noexcept = default;
+
+    /**
+     * Construct a mesh cache using the specified directory.
+     * @param directory The directory to store cache files in (created on first write if required).
+     */
+    explicit MeshCache(std::filesystem::path directory) noexcept;
+
+    /**
+     * Check if the cache has a valid directory to operate in.
+     * @return True if cache is enabled, False otherwise.
+     */
+    [[nodiscard]] bool isEnabled() const noexcept;
+
+    /**
+     * Calculate the cache key for a mesh.
+     * @param mesh          The source mesh.
+     * @param lodMode       The LOD mode used to process the mesh (capsaicin_lod_mode).
+     * @param lodOffset     The LOD offset used to process the mesh (capsaicin_lod_offset).
+     * @param lodAggressive The aggressive LOD setting used to process the mesh (capsaicin_lod_aggressive).
+     * @param meshlets      True if meshlet data is generated.
+     * @param meshletCull   True if meshlet culling data is generated.
+     * @return The key identifying the processed mesh data.
+     */
+    [[nodiscard]] static uint64_t CalculateKey(GfxMesh const &mesh, uint32_t lodMode, uint32_t lodOffset,
+        bool lodAggressive, bool meshlets, bool meshletCull) noexcept;
+
+    /**
+     * Load processed mesh data from the cache.
+     * @param key       The key of the mesh to load.
+     * @param [out] out The loaded mesh data.
+     * @return True if a valid cache entry was found and loaded, False otherwise.
+     */
+    bool load(uint64_t key, MeshBuildData &out) const noexcept;
+
+    /**
+     * Store processed mesh data in the cache.
+     * @param key  The key of the mesh to store.
+     * @param data The mesh data to store.
+     * @return True if the cache entry was written successfully, False otherwise.
+     */
+    bool save(uint64_t key, MeshBuildData const &data) const noexcept;
+
+private:
+    /**
+     * Get the file used to store a cache entry.
+     * @param key The key of the cache entry.
+     * @return The file path.
+     */
+    [[nodiscard]] std::filesystem::path getFilePath(uint64_t key) const noexcept;
+
+    std::filesystem::path directory_; /**< Directory used to store cache files (empty if disabled) */
+};
+} // namespace Capsaicin
@@ -0,0 +1,253 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#ifdef _WIN32
+#    include <ppl.h>
+#else
+#    include <atomic>
+#    include <condition_variable>
+#    include <mutex>
+#    include <thread>
+#endif
+
+namespace Capsaicin
+{
+#ifndef _WIN32
+namespace Detail
+{
+/**
+ * Persistent set of worker threads used by ParallelFor.
+ * Workers are created once on first use and then sleep until a job is submitted, this avoids the cost of
+ * creating new threads every time ParallelFor is called. Only a single job can be active at a time, callers
+ * that find the pool busy (including nested calls made from within a job) should run their work inline.
+ */
+class ThreadPool
+{
+public:
+    using Job = void (*)(void const *data);
+
+    ThreadPool(ThreadPool const &)            = delete;
+    ThreadPool &operator=(ThreadPool const &) = delete;
+
+    /**
+     * Gets the process wide thread pool.
+     * @return The thread pool.
+     */
+    static ThreadPool &Get() noexcept
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    /**
+     * Gets the maximum number of threads that can execute a job, including the calling thread.
+     * @return The thread count.
+     */
+    [[nodiscard]] uint32_t getThreadCount() const noexcept
+    {
+        return static_cast<uint32_t>(workers_.size()) + 1;
+    }
+
+    /**
+     * Execute a job on multiple threads and wait for it to complete.
+     * The calling thread also executes the job.
+     * @param threadCount Number of threads that should execute the job (including the calling thread).
+     * @param job         The function executed by each thread.
+     * @param data        User data passed to the job.
+     * @return True if the job was executed, False if the pool was already busy.
+     */
+    bool run(uint32_t const threadCount, Job const job, void const *data) noexcept
+    {
+        if (busy_.exchange(true, std::memory_order_acquire))
+        {
+            return false;
+        }
+        {
+            std::scoped_lock const lock(mutex_);
+            job_       = job;
+            data_      = data;
+            requested_ = std::min(threadCount - 1, static_cast<uint32_t>(workers_.size()));
+            pending_   = requested_;
+            ++generation_;
+        }
+        wake_.notify_all();
+        job(data);
+        {
+            std::unique_lock lock(mutex_);
+            done_.wait(lock, [this] { return pending_ == 0; });
+        }
+        busy_.store(false, std::memory_order_release);
+        return true;
+    }
+
+private:
+    ThreadPool() noexcept
+    {
+        uint32_t const workerCount = std::max(std::thread::hardware_concurrency(), 1U) - 1;
+        workers_.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() noexcept
+    {
+        {
+            std::scoped_lock const lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        workers_.clear();
+    }
+
+    void workerLoop(uint32_t const index) noexcept
+    {
+        uint64_t seen = 0;
+        for (;;)
+        {
+            std::unique_lock lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_)
+            {
+                return;
+            }
+            seen = generation_;
+            if (index >= requested_)
+            {
+                continue;
+            }
+            Job const         job  = job_;
+            void const *const data = data_;
+            lock.unlock();
+            job(data);
+            lock.lock();
+            if (--pending_ == 0)
+            {
+                done_.notify_one();
+            }
+        }
+    }
+
+    std::atomic<bool>         busy_       = false;   /**< True while a job is executing */
+    std::mutex                mutex_;                /**< Protects the job state below */
+    std::condition_variable   wake_;                 /**< Signalled when a new job is submitted */
+    std::condition_variable   done_;                 /**< Signalled when the last worker finishes a job */
+    Job                       job_        = nullptr; /**< The current job */
+    void const               *data_       = nullptr; /**< User data for the current job */
+    uint64_t                  generation_ = 0;       /**< Incremented for every submitted job */
+    uint32_t                  requested_  = 0;       /**< Number of workers requested for the current job */
+    uint32_t                  pending_    = 0;       /**< Number of workers still running the current job */
+    bool                      stop_       = false;   /**< True when the workers should exit */
+    std::vector<std::jthread> workers_;              /**< The worker threads */
+};
+} // namespace Detail
+#endif
+
+/**
+ * Execute a function for each index within a range in parallel.
+ * Indices are distributed dynamically between worker threads so that uneven workloads are balanced. On
+ * Windows this maps directly to PPL, on other platforms a persistent pool of worker threads is used instead.
+ * @tparam Func Type of the function to execute, must be callable with a uint32_t index.
+ * @param begin The first index to process.
+ * @param end   One past the last index to process.
+ * @param func  The function to call for each index.
+ */
+template<typename Func>
+void ParallelFor(uint32_t const begin, uint32_t const end, Func const &func) noexcept
+{
+    if (begin >= end)
+    {
+        return;
+    }
+#ifdef _WIN32
+    concurrency::parallel_for(begin, end, 1U, func);
+#else
+    if (end - begin > 1)
+    {
+        Detail::ThreadPool   &pool   = Detail::ThreadPool::Get();
+        std::atomic<uint64_t> next   = begin;
+        auto const            worker = [&] {
+            for (uint64_t i = next.fetch_add(1, std::memory_order_relaxed); i < end;
+                i           = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                func(static_cast<uint32_t>(i));
+            }
+        };
+        auto const job = [](void const *data) { (*static_cast<decltype(worker) const *>(data))(); };
+        uint32_t const threadCount = std::min(pool.getThreadCount(), end - begin);
+        if (threadCount > 1 && pool.run(threadCount, job, &worker))
+        {
+            return;
+        }
+    }
+    // Single threaded systems, single items and nested calls made while the pool is busy all run inline
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        func(i);
+    }
+#endif
+}
+
+/**
+ * Perform a parallel reduction over a range of values.
+ * The range is split into a fixed number of contiguous blocks which are reduced in parallel and then combined
+ * in order. The block layout only depends on the number of values so the result is deterministic even for
+ * non-associative combine operations.
+ * @tparam TYPE    Type of the input values.
+ * @tparam RESULT  Type of the reduced value.
+ * @tparam Reduce  Type of the range reduce function.
+ * @tparam Combine Type of the combine function.
+ * @param values   The values to reduce.
+ * @param count    Number of values.
+ * @param identity The initial value used for each block.
+ * @param reduce   Function used to reduce a block, called as reduce(start, end, identity).
+ * @param combine  Function used to combine the results of two blocks, called as combine(left, right).
+ * @return The reduced value.
+ */
+template<typename TYPE, typename RESULT, typename Reduce, typename Combine>
+RESULT ParallelReduce(TYPE const *values, uint32_t const count, RESULT const &identity, Reduce const &reduce,
+    Combine const &combine) noexcept
+{
+    constexpr uint32_t blockSize  = 1024;
+    uint32_t const     blockCount = (count + blockSize - 1) / blockSize;
+    if (blockCount <= 1)
+    {
+        return reduce(values, values + count, identity);
+    }
+    std::vector<RESULT> results(blockCount, identity);
+    ParallelFor(0U, blockCount, [&](uint32_t const block) {
+        uint32_t const start = block * blockSize;
+        results[block]       = reduce(values + start, values + std::min(start + blockSize, count), identity);
+    });
+    RESULT result = results[0];
+    for (uint32_t block = 1; block < blockCount; ++block)
+    {
+        result = combine(result, results[block]);
+    }
+    return result;
+}
+} // namespace Capsaicin
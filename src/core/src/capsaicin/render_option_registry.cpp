@@ -0,0 +1,173 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "render_option_registry.h"
+
+#include <algorithm>
+
+namespace Capsaicin
+{
+void RenderOptionRegistry::compile(RenderOptionList const &options) noexcept
+{
+    ++generation_;
+    sourceNames_.clear();
+    sourceHandles_.clear();
+    sourceNames_.reserve(options.size());
+    sourceHandles_.reserve(options.size());
+    for (auto const &[name, option] : options)
+    {
+        Handle handle;
+        if (auto const i = handles_.find(name); i != handles_.end())
+        {
+            handle = i->second;
+        }
+        else
+        {
+            handle = static_cast<Handle>(values_.size());
+            handles_.emplace(name, handle);
+            values_.emplace_back(option);
+            generations_.push_back(generation_);
+        }
+        sourceNames_.push_back(name);
+        sourceHandles_.push_back(handle);
+        if (values_[handle] != option)
+        {
+            values_[handle]      = option;
+            generations_[handle] = generation_;
+        }
+    }
+    updateGroupGenerations();
+}
+
+bool RenderOptionRegistry::update(RenderOptionList const &options) noexcept
+{
+    if (options.size() != sourceNames_.size())
+    {
+        compile(options);
+        return true;
+    }
+    bool   changed = false;
+    size_t index   = 0;
+    for (auto const &[name, option] : options)
+    {
+        // Names are compared by address, which is stable for the string literal names used by all options.
+        // This detects an option being replaced by an erase and insert that leaves the list size unchanged
+        if (name.data() != sourceNames_[index].data() || name.size() != sourceNames_[index].size())
+        {
+            compile(options);
+            return true;
+        }
+        Handle const handle = sourceHandles_[index++];
+        if (option == values_[handle])
+        {
+            continue;
+        }
+        if (!changed)
+        {
+            ++generation_;
+            changed = true;
+        }
+        values_[handle]      = option;
+        generations_[handle] = generation_;
+    }
+    if (changed)
+    {
+        updateGroupGenerations();
+    }
+    return changed;
+}
+
+RenderOptionRegistry::Handle RenderOptionRegistry::getHandle(std::string_view const &name) const noexcept
+{
+    if (auto const i = handles_.find(name); i != handles_.end())
+    {
+        return i->second;
+    }
+    return InvalidHandle;
+}
+
+RenderOptionRegistry::GroupHandle RenderOptionRegistry::addGroup(
+    std::string_view const &name, RenderOptionList const &options) noexcept
+{
+    std::vector<Handle> members;
+    members.reserve(options.size());
+    for (auto const &option : options)
+    {
+        if (Handle const handle = getHandle(option.first); handle != InvalidHandle)
+        {
+            members.push_back(handle);
+        }
+    }
+    GroupHandle group;
+    if (auto const i = groupHandles_.find(name); i != groupHandles_.end())
+    {
+        group = i->second;
+    }
+    else
+    {
+        group = static_cast<GroupHandle>(groups_.size());
+        groupHandles_.emplace(name, group);
+        groups_.emplace_back();
+        groupGenerations_.push_back(0);
+    }
+    groups_[group] = std::move(members);
+    // A new or replaced group always counts as changed so its users re-read their options
+    groupGenerations_[group] = ++generation_;
+    return group;
+}
+
+RenderOptionRegistry::GroupHandle RenderOptionRegistry::getGroup(std::string_view const &name) const noexcept
+{
+    if (auto const i = groupHandles_.find(name); i != groupHandles_.end())
+    {
+        return i->second;
+    }
+    return InvalidGroupHandle;
+}
+
+uint64_t RenderOptionRegistry::getGeneration(Handle const handle) const noexcept
+{
+    return handle < generations_.size() ? generations_[handle] : 0;
+}
+
+uint64_t RenderOptionRegistry::getGroupGeneration(GroupHandle const group) const noexcept
+{
+    return group < groupGenerations_.size() ? groupGenerations_[group] : 0;
+}
+
+bool RenderOptionRegistry::checkChanged(GroupHandle const group, uint64_t &generation) const noexcept
+{
+    bool const changed = group >= groupGenerations_.size() || groupGenerations_[group] > generation;
+    generation         = generation_;
+    return changed;
+}
+
+void RenderOptionRegistry::updateGroupGenerations() noexcept
+{
+    for (GroupHandle group = 0; group < static_cast<GroupHandle>(groups_.size()); ++group)
+    {
+        for (Handle const handle : groups_[group])
+        {
+            groupGenerations_[group] = std::max(groupGenerations_[group], generations_[handle]);
+        }
+    }
+}
+} // namespace Capsaicin
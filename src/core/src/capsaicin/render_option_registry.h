@@ -0,0 +1,155 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "capsaicin_internal_types.h"
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * A compiled view of the render options.
+ * Option names are resolved once to dense handles and the values are kept in a flat array that is
+ * synchronised with the options list once per frame. Every option records the generation in which it last
+ * changed, options can also be collected into groups (for instance all the options of a render technique)
+ * whose generation is the latest of their members. This allows a user to check if any option it depends on
+ * has changed in O(1) instead of looking up every option by name each frame.
+ */
+class RenderOptionRegistry
+{
+public:
+    using Handle      = uint32_t;
+    using GroupHandle = uint32_t;
+
+    static constexpr Handle      InvalidHandle      = std::numeric_limits<uint32_t>::max();
+    static constexpr GroupHandle InvalidGroupHandle = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Compile an options list, must be called whenever options are added to or removed from the list.
+     * Existing handles remain valid, options that are no longer in the list keep their last value.
+     * @param options The options list.
+     */
+    void compile(RenderOptionList const &options) noexcept;
+
+    /**
+     * Synchronise the stored values with the options list and advance the generation of any that changed.
+     * The list is recompiled automatically if any option has been added to, removed from or replaced within
+     * it.
+     * @param options The options list.
+     * @return True if any option changed, False otherwise.
+     */
+    bool update(RenderOptionList const &options) noexcept;
+
+    /**
+     * Get the handle of an option.
+     * @param name The name of the option.
+     * @return The option handle, InvalidHandle if the option is unknown.
+     */
+    [[nodiscard]] Handle getHandle(std::string_view const &name) const noexcept;
+
+    /**
+     * Get the value of an option.
+     * @tparam T Generic type parameter of the requested option.
+     * @param handle The option handle.
+     * @return The options value (default initialised if handle is invalid or typename does not match).
+     */
+    template<typename T>
+    [[nodiscard]] T const &getValue(Handle const handle) const noexcept
+    {
+        if (handle < values_.size())
+        {
+            if (auto const value = std::get_if<T>(&values_[handle]); value != nullptr)
+            {
+                return *value;
+            }
+        }
+        static T unknown;
+        return unknown;
+    }
+
+    /**
+     * Add a named group of options, replaces any existing group with the same name.
+     * @param name    The name of the group.
+     * @param options The options to add to the group, options not known to the registry are ignored.
+     * @return The group handle.
+     */
+    GroupHandle addGroup(std::string_view const &name, RenderOptionList const &options) noexcept;
+
+    /**
+     * Get the handle of a group.
+     * @param name The name of the group.
+     * @return The group handle, InvalidGroupHandle if the group is unknown.
+     */
+    [[nodiscard]] GroupHandle getGroup(std::string_view const &name) const noexcept;
+
+    /**
+     * Get the current generation, this is advanced every time any option changes.
+     * @return The generation.
+     */
+    [[nodiscard]] uint64_t getGeneration() const noexcept { return generation_; }
+
+    /**
+     * Get the generation in which an option last changed.
+     * @param handle The option handle.
+     * @return The generation (0 if handle is invalid).
+     */
+    [[nodiscard]] uint64_t getGeneration(Handle handle) const noexcept;
+
+    /**
+     * Get the generation in which any option within a group last changed.
+     * @param group The group handle.
+     * @return The generation (0 if group is invalid).
+     */
+    [[nodiscard]] uint64_t getGroupGeneration(GroupHandle group) const noexcept;
+
+    /**
+     * Check if any option within a group has changed and mark the changes as seen.
+     * Unknown groups are always reported as changed so that callers fall back to reading the options list.
+     * @param group                 The group handle.
+     * @param [in,out] generation   The generation last seen by the caller (start with 0), this is updated to
+     *                              the current generation.
+     * @return True if any option changed since the passed in generation, False otherwise.
+     */
+    bool checkChanged(GroupHandle group, uint64_t &generation) const noexcept;
+
+private:
+    /** Recalculate the generation of every group. */
+    void updateGroupGenerations() noexcept;
+
+    std::map<std::string, Handle, std::less<>> handles_;       /**< Map of option name to handle */
+    std::vector<Option>                        values_;        /**< Current value of each option */
+    std::vector<uint64_t>                      generations_;   /**< Generation each option last changed */
+    std::vector<std::string_view>              sourceNames_;   /**< Names in the compiled options list */
+    std::vector<Handle>                        sourceHandles_; /**< Handles in the compiled options list */
+    uint64_t                                   generation_ = 0;
+
+    std::map<std::string, GroupHandle, std::less<>> groupHandles_;     /**< Map of group name to handle */
+    std::vector<std::vector<Handle>>                groups_;           /**< Option handles in each group */
+    std::vector<uint64_t>                           groupGenerations_; /**< Latest generation of each group */
+};
+} // namespace Capsaicin
@@ -0,0 +1,46 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace Capsaicin
+{
+/**
+ * Typed index used to access a shared texture, shared buffer or component without a name lookup.
+ * Handles are resolved from a name once the render techniques have been negotiated and remain valid until the
+ * next negotiation (i.e. they should be resolved in a render technique's `init` function).
+ * @tparam T The type of resource the handle refers to.
+ */
+template<typename T>
+struct ResourceHandle
+{
+    static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    uint32_t index = InvalidIndex; /**< Index of the resource in the owning list */
+
+    [[nodiscard]] constexpr bool isValid() const noexcept { return index != InvalidIndex; }
+
+    constexpr explicit operator bool() const noexcept { return isValid(); }
+};
+} // namespace Capsaicin
@@ -0,0 +1,122 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "shared_texture_aliasing.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace Capsaicin
+{
+uint32_t SharedTextureAliasing::addTexture(
+    uint64_t const key, uint64_t const size, bool const transient, bool const cleared) noexcept
+{
+    textures_.push_back({.key = key,
+        .size                 = size,
+        .first_use            = std::numeric_limits<uint32_t>::max(),
+        .last_use             = 0,
+        .allocation           = static_cast<uint32_t>(textures_.size()),
+        .transient            = transient,
+        .cleared              = cleared});
+    return static_cast<uint32_t>(textures_.size() - 1);
+}
+
+void SharedTextureAliasing::addAccess(uint32_t const texture, uint32_t const pass, bool const read) noexcept
+{
+    auto &current = textures_[texture];
+    if (current.first_use == std::numeric_limits<uint32_t>::max() || current.first_use == pass)
+    {
+        current.first_use = pass;
+        // Reading the contents before they are written this frame means they must persist from the last one
+        current.transient = current.transient && !read;
+    }
+    current.last_use = std::max(current.last_use, pass);
+}
+
+void SharedTextureAliasing::pack() noexcept
+{
+    // Assigning allocations in order of first use is optimal for interval graphs
+    std::vector<uint32_t> order(textures_.size());
+    std::iota(order.begin(), order.end(), 0U);
+    std::ranges::stable_sort(order, [this](uint32_t const a, uint32_t const b) {
+        return textures_[a].first_use < textures_[b].first_use;
+    });
+
+    struct Allocation
+    {
+        uint64_t key;
+        uint32_t last_use;
+        uint32_t owner;
+    };
+    std::vector<Allocation> allocations;
+    allocation_count_ = 0;
+    total_size_       = 0;
+    aliased_size_     = 0;
+    for (uint32_t const index : order)
+    {
+        auto &texture = textures_[index];
+        total_size_ += texture.size;
+        // Textures that are never accessed have no lifetime to share
+        bool const used = texture.first_use != std::numeric_limits<uint32_t>::max();
+        if (texture.transient && !texture.cleared && used)
+        {
+            // Pick the allocation that was released last to leave the earlier ones for other textures
+            Allocation *best = nullptr;
+            for (auto &allocation : allocations)
+            {
+                if (allocation.key == texture.key && allocation.last_use < texture.first_use
+                    && (best == nullptr || allocation.last_use > best->last_use))
+                {
+                    best = &allocation;
+                }
+            }
+            if (best != nullptr)
+            {
+                texture.allocation = best->owner;
+                best->last_use     = texture.last_use;
+                continue;
+            }
+        }
+        texture.allocation = index;
+        aliased_size_ += texture.size;
+        ++allocation_count_;
+        if (texture.transient && used)
+        {
+            allocations.push_back({.key = texture.key, .last_use = texture.last_use, .owner = index});
+        }
+    }
+}
+
+uint32_t SharedTextureAliasing::getAllocation(uint32_t const texture) const noexcept
+{
+    return textures_[texture].allocation;
+}
+
+void SharedTextureAliasing::reset() noexcept
+{
+    textures_.clear();
+    allocation_count_ = 0;
+    total_size_       = 0;
+    aliased_size_     = 0;
+}
+} // namespace Capsaicin
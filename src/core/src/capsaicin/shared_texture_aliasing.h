@@ -0,0 +1,109 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Lifetime analysis used to alias shared textures that are never in use at the same time during a frame.
+ * Each texture records the passes accessing it, textures that are only written before being read within a
+ * frame are transient and can reuse the allocation of another transient texture with the same key whose
+ * last use precedes their first use. All other textures keep their own allocation.
+ * This class does not touch the GPU so that the packing can be evaluated on the CPU.
+ */
+class SharedTextureAliasing
+{
+public:
+    /** Defaulted constructor. */
+    SharedTextureAliasing() noexcept = default;
+
+    /**
+     * Adds a texture.
+     * @param key       Textures may only share an allocation if their keys match (i.e. same format and size).
+     * @param size      The size of the allocation in bytes.
+     * @param transient False if the texture must keep its own allocation (i.e. history or accumulation).
+     * @param cleared   True if the texture is cleared at the start of each frame, it can then only be the
+     *                  first user of an allocation.
+     * @return The index of the new texture.
+     */
+    uint32_t addTexture(uint64_t key, uint64_t size, bool transient, bool cleared) noexcept;
+
+    /**
+     * Records an access to a texture, passes must be recorded in execution order.
+     * @param texture The texture index.
+     * @param pass    The index of the pass accessing the texture.
+     * @param read    True if the pass reads the existing texture contents.
+     */
+    void addAccess(uint32_t texture, uint32_t pass, bool read) noexcept;
+
+    /** Assigns an allocation to every texture, must be called once all accesses have been added. */
+    void pack() noexcept;
+
+    /**
+     * Gets the texture owning the allocation used by a texture.
+     * @param texture The texture index.
+     * @return The index of the owning texture (equal to texture if it has its own allocation).
+     */
+    [[nodiscard]] uint32_t getAllocation(uint32_t texture) const noexcept;
+
+    /**
+     * Gets the number of separate allocations after packing.
+     * @return The allocation count.
+     */
+    [[nodiscard]] uint32_t getAllocationCount() const noexcept { return allocation_count_; }
+
+    /**
+     * Gets the memory used if every texture had its own allocation.
+     * @return The size in bytes.
+     */
+    [[nodiscard]] uint64_t getTotalSize() const noexcept { return total_size_; }
+
+    /**
+     * Gets the memory used after packing.
+     * @return The size in bytes.
+     */
+    [[nodiscard]] uint64_t getAliasedSize() const noexcept { return aliased_size_; }
+
+    /** Removes all textures. */
+    void reset() noexcept;
+
+private:
+    struct Texture
+    {
+        uint64_t key;
+        uint64_t size;
+        uint32_t first_use;
+        uint32_t last_use;
+        uint32_t allocation;
+        bool     transient;
+        bool     cleared;
+    };
+
+    std::vector<Texture> textures_;
+    uint32_t             allocation_count_ = 0;
+    uint64_t             total_size_       = 0;
+    uint64_t             aliased_size_     = 0;
+};
+} // namespace Capsaicin
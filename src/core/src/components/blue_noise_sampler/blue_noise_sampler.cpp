@@ -58,8 +58,8 @@ BlueNoiseSampler::RenderOptions BlueNoiseSampler::convertOptions(RenderOptionLis
 
 bool BlueNoiseSampler::init([[maybe_unused]] CapsaicinInternal const &capsaicin) noexcept
 {
-    sobolBuffer          = gfxCreateBuffer(gfx_, sizeof(Sobol256x256), Sobol256x256);
-    rankingTileBuffer    = gfxCreateBuffer(gfx_, sizeof(RankingTiles), RankingTiles);
+    // Tables are stored packed with 4 8bit values per word and are unpacked in the shader when read
+    sobolBuffer          = gfxCreateBuffer(gfx_, sizeof(SobolFirstSample), SobolFirstSample);
     scramblingTileBuffer = gfxCreateBuffer(gfx_, sizeof(ScramblingTiles), ScramblingTiles);
     return true;
 }
@@ -92,7 +92,6 @@ void BlueNoiseSampler::run([[maybe_unused]] CapsaicinInternal &capsaicin) noexce
 void BlueNoiseSampler::terminate() noexcept
 {
     gfxDestroyBuffer(gfx_, sobolBuffer);
-    gfxDestroyBuffer(gfx_, rankingTileBuffer);
     gfxDestroyBuffer(gfx_, scramblingTileBuffer);
 }
 
@@ -100,7 +99,6 @@ void BlueNoiseSampler::addProgramParameters(
     [[maybe_unused]] CapsaicinInternal const &capsaicin, GfxProgram const &program) const noexcept
 {
     gfxProgramSetParameter(gfx_, program, "g_SobolBuffer", sobolBuffer);
-    gfxProgramSetParameter(gfx_, program, "g_RankingTile", rankingTileBuffer);
     gfxProgramSetParameter(gfx_, program, "g_ScramblingTile", scramblingTileBuffer);
     gfxProgramSetParameter(gfx_, program, "g_RandomSeed", randomSeed);
 }
@@ -93,7 +93,6 @@ class BlueNoiseSampler final
 private:
     RenderOptions options;
     GfxBuffer     sobolBuffer;
-    GfxBuffer     rankingTileBuffer;
     GfxBuffer     scramblingTileBuffer;
     uint32_t      randomSeed = 0;
 };
@@ -25,7 +25,6 @@ THE SOFTWARE.
 
 // Requires the following data to be defined in any shader that uses this file
 StructuredBuffer<uint> g_SobolBuffer;
-StructuredBuffer<uint> g_RankingTile;
 StructuredBuffer<uint> g_ScramblingTile;
 uint g_RandomSeed;
 
@@ -33,18 +32,19 @@ uint g_RandomSeed;
 
 namespace NoExport
 {
-    float samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(uint2 pixel, uint index, uint dimension)
+    float samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(uint2 pixel, uint dimension)
     {
         // A Low-Discrepancy Sampler that Distributes Monte Carlo Errors as a Blue Noise in Screen Space - Heitz etal
-
-        // Xor index based on optimized ranking
-        uint rankedSampleIndex = index ^ g_RankingTile[dimension + (pixel.x + pixel.y * 128) * 8];
+        // Both tables store 4 8bit values per word. As the tile is optimised for a single sample per pixel
+        // the ranking tile is all zero and only the first Sobol sample is ever used.
+        dimension &= 255;
 
         // Fetch value in sequence
-        uint value = g_SobolBuffer[dimension + rankedSampleIndex * 256];
+        uint value = (g_SobolBuffer[dimension >> 2] >> ((dimension & 3) << 3)) & 0xFF;
 
         // If the dimension is optimized, xor sequence value based on optimized scrambling
-        value = value ^ g_ScramblingTile[(dimension % 8) + (pixel.x + pixel.y * 128) * 8];
+        uint key = dimension & 7;
+        value = value ^ ((g_ScramblingTile[(key >> 2) + (pixel.x + pixel.y * 128) * 2] >> ((key & 3) << 3)) & 0xFF);
 
         // Convert to float and return
         return (0.5f + value) / 256.0f;
@@ -72,7 +72,7 @@ class BlueNoiseSampler
         {
             dimension = 0;
         }
-        float s = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, 0, dimension++);
+        float s = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, dimension++);
 
         // https://blog.demofox.org/2017/10/31/animating-noise-for-integration-over-time/
         return fmod(s + (index & 255) * GOLDEN_RATIO, 1.0f);
@@ -88,8 +88,8 @@ class BlueNoiseSampler
         {
             dimension = 0;
         }
-        float s1 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, 0, dimension++);
-        float s2 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, 0, dimension++);
+        float s1 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, dimension++);
+        float s2 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, dimension++);
 
         return fmod(float2(s1, s2) + (index & 255) * GOLDEN_RATIO, 1.0f);
     }
@@ -104,9 +104,9 @@ class BlueNoiseSampler
         {
             dimension = 0;
         }
-        float s1 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, 0, dimension++);
-        float s2 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, 0, dimension++);
-        float s3 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, 0, dimension++);
+        float s1 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, dimension++);
+        float s2 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, dimension++);
+        float s3 = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, dimension++);
 
         return fmod(float3(s1, s2, s3) + (index & 255) * GOLDEN_RATIO, 1.0f);
     }
@@ -141,7 +141,7 @@ class BlueNoiseSampler1D
      */
     float rand()
     {
-        float s = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, 0, dimension);
+        float s = NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, dimension);
         return fmod(s + (index++ & 255) * GOLDEN_RATIO, 1.0f);
     }
 };
@@ -198,8 +198,8 @@ class BlueNoiseSampler2D
      */
     float2 rand2()
     {
-        float2 s = float2(NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, 0, dimension),
-        NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, 0, dimension + 1));
+        float2 s = float2(NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, dimension),
+        NoExport::samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp(pixel, dimension + 1));
 
         return fmod(s + (index++ & 255) * GOLDEN_RATIO, 1.0f);
     }
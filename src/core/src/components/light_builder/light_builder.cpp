@@ -92,11 +92,13 @@ bool LightBuilder::init(CapsaicinInternal const &capsaicin) noexcept
     lightCountBuffer = gfxCreateBuffer<uint32_t>(gfx_, 1);
     lightCountBuffer.setName("LightCountBuffer");
 
-    options = convertOptions(capsaicin.getOptions());
+    options          = convertOptions(capsaicin.getOptions());
+    optionGroup      = capsaicin.getOptionRegistry().getGroup(getName());
+    optionGeneration = 0;
 
     // Setup initial light counts for current scene
     auto const scene = capsaicin.getScene();
-    lightHash = HashReduce(gfxSceneGetObjects<GfxLight>(scene), gfxSceneGetObjectCount<GfxLight>(scene));
+    deltaLightTracker.reset();
     uint const deltaLightCount = (options.delta_light_enable) ? gfxSceneGetObjectCount<GfxLight>(scene) : 0;
     GfxLight const *lights     = gfxSceneGetObjects<GfxLight>(scene);
     directionalLightCount      = 0;
@@ -138,15 +140,10 @@ bool LightBuilder::init(CapsaicinInternal const &capsaicin) noexcept
 
 void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
 {
-    auto optionsNew = convertOptions(capsaicin.getOptions());
-    auto scene      = capsaicin.getScene();
-
-    // Check whether we need to update lighting structures
-    size_t const oldLightHash = lightHash;
-    if (options.delta_light_enable && !capsaicin.getPaused())
-    {
-        lightHash = HashReduce(gfxSceneGetObjects<GfxLight>(scene), gfxSceneGetObjectCount<GfxLight>(scene));
-    }
+    auto optionsNew = capsaicin.getOptionRegistry().checkChanged(optionGroup, optionGeneration)
+                        ? convertOptions(capsaicin.getOptions())
+                        : options;
+    auto scene = capsaicin.getScene();
 
     if (!options.area_light_enable
         && (capsaicin.getMeshesUpdated() || (areaLightTotal > 0 && capsaicin.getTransformsUpdated())))
@@ -171,22 +168,42 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
     lightIndexesChanged = (oldEnvironmentMapCount != environmentMapCount)
                        || (oldAreaLightCount != areaLightCount) || (oldDeltaLightCount != deltaLightCount)
                        || cullLowChanged || capsaicin.getFrameIndex() == 0;
-    bool const areaLightUpdated =
+
+    // Delta lights can only be changed by loading a scene or playing animations so they are only checked
+    // when one of those happens
+    bool deltaLightsChanged = false;
+    if (optionsNew.delta_light_enable
+        && (lightIndexesChanged || capsaicin.getSceneUpdated() || capsaicin.getAnimationUpdated()))
+    {
+        deltaLightsChanged = deltaLightTracker.update(
+            gfxSceneGetObjects<GfxLight>(scene), gfxSceneGetObjectCount<GfxLight>(scene));
+    }
+
+    bool const emissiveInstancesChanged =
         optionsNew.area_light_enable
         && (capsaicin.getMeshesUpdated() || capsaicin.getInstancesUpdated() || capsaicin.getFrameIndex() == 0
             || areaLightTotal == numeric_limits<uint32_t>::max()
-            || (areaLightCount > 0 && capsaicin.getTransformsUpdated())
             || options.low_emission_area_lights_disable != optionsNew.low_emission_area_lights_disable
             || cullLowChanged);
+    bool const areaLightUpdated =
+        emissiveInstancesChanged
+        || (optionsNew.area_light_enable && areaLightCount > 0 && capsaicin.getTransformsUpdated());
     bool const deltaLightUpdated =
-        optionsNew.delta_light_enable && (oldLightHash != lightHash || capsaicin.getFrameIndex() == 0);
+        optionsNew.delta_light_enable && (deltaLightsChanged || capsaicin.getFrameIndex() == 0);
     bool const envMapUpdated = optionsNew.environment_light_enable
                             && (capsaicin.getEnvironmentMapUpdated() || capsaicin.getFrameIndex() == 0);
     if (deltaLightUpdated || envMapUpdated || areaLightUpdated || lightIndexesChanged)
     {
         lightsUpdated = true;
 
-        // Update lights
+        // Lights are patched in place unless any light has moved within the list
+        GfxLight const *lights      = gfxSceneGetObjects<GfxLight>(scene);
+        bool const      listChanged = lightIndexesChanged || emissiveInstancesChanged
+                                 || lightBuffer.getCount() < glm::max(getLightCount(), 1U);
+        bool const      fullRebuild = layout.needsRebuild(
+            listChanged, lights, deltaLightUpdated ? deltaLightTracker.getChanged() : vector<uint32_t>());
+
+        if (fullRebuild)
         {
             TimedSection const timedSection(*this, "UpdateLights");
 
@@ -194,8 +211,7 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
             // represent any type of supported light (area, point, directional etc.) by re-interpreting
             // the bits stored in each light struct based on the type of light stored. All delta lights
             // (point/spot/direction) are added to the list directly on the CPU at the beginning of the
-            // list.
-            vector<Light> allLightData;
+            // list. A copy of these is kept so that they can later be updated in place.
 
             // Add the environment map to the light list
             // Note: other parts require that the environment map is always first in the list
@@ -203,105 +219,30 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
             {
                 Light const light =
                     MakeEnvironmentLight(environmentMap.getMipLevels(), environmentMap.getWidth());
-                allLightData.push_back(light);
+                layout.beginRebuild(&light);
+            }
+            else
+            {
+                layout.beginRebuild(nullptr);
             }
 
             // Add delta lights to the list
             // Lights are added by type to improve gpu performance
-            GfxLight const *lights = gfxSceneGetObjects<GfxLight>(scene);
-
             // Infinite lights are always added first such that directional lights appear after environment
             // lights as this is useful for some renderers
-            directionalLightCount = 0;
-            for (uint32_t i = 0; i < deltaLightCount; ++i)
-            {
-                if (lights[i].type == kGfxLightType_Directional)
-                {
-                    // Create new directional light
-                    Light const light = MakeDirectionalLight(
-                        lights[i].color * lights[i].intensity, lights[i].direction, lights[i].range);
-                    allLightData.push_back(light);
-                    ++directionalLightCount;
-                }
-            }
-
-            pointLightCount = 0;
-            for (uint32_t i = 0; i < deltaLightCount; ++i)
-            {
-                if (lights[i].type == kGfxLightType_Point)
-                {
-                    // Create new point light
-                    Light const light = MakePointLight(
-                        lights[i].color * lights[i].intensity, lights[i].position, lights[i].range);
-                    allLightData.push_back(light);
-                    ++pointLightCount;
-                }
-            }
-
-            spotLightCount = 0;
-            for (uint32_t i = 0; i < deltaLightCount; ++i)
-            {
-                if (lights[i].type == kGfxLightType_Spot)
-                {
-                    // Create new spotlight
-                    Light const light = MakeSpotLight(lights[i].color * lights[i].intensity,
-                        lights[i].position, lights[i].range, lights[i].direction, lights[i].outer_cone_angle,
-                        lights[i].inner_cone_angle);
-                    allLightData.push_back(light);
-                    ++spotLightCount;
-                }
-            }
+            auto const deltaLightCounts = layout.addDeltaLights(lights, deltaLightCount);
+            directionalLightCount       = deltaLightCounts.directional;
+            pointLightCount             = deltaLightCounts.point;
+            spotLightCount              = deltaLightCounts.spot;
 
             // Check if meshes were updated and add any area lights to the list
+            auto const &lightData = layout.getLights();
             if (areaLightCount > 0)
             {
-                // Create a mapping table that maps each emissive instance into the final light buffer
-                // list. Surfaces are mapped by their instanceID and primitiveID (zero index incrementing
-                // value per triangle in mesh). Since not all instances have emissive meshes and that each
-                // emissive mesh has different primitive counts we need to map (instanceID|primitiveID)
-                // pairs to an ID into the light buffer. The `lightInstanceBuffer` contains a lookup by
-                // instanceID and returns the start offset into the light buffer for that instance. Those
-                // values can then be offset by the primitiveID to get the exact light location. As many
-                // instances are going to contain zero valid emissive meshes the buffer is sparsely
-                // populated.
-                vector<uint32_t> lightInstancePrimitiveOffset;
-                areaLightTotal              = 0;
-                areaLightCount              = 0;
-                auto const areaLightStartID = static_cast<uint32_t>(allLightData.size());
-                lightInstancePrimitiveOffset.resize(gfxSceneGetObjectCount<GfxInstance>(scene));
-                for (uint32_t i = 0; i < gfxSceneGetObjectCount<GfxInstance>(scene); ++i)
-                {
-                    auto const &instance = gfxSceneGetObjects<GfxInstance>(scene)[i];
-                    if (instance.mesh && instance.material && gfxMaterialIsEmissive(*instance.material))
-                    {
-                        auto primitives = static_cast<uint32_t>(instance.mesh->indices.size()) / 3;
-
-                        areaLightTotal += primitives;
-                        if (optionsNew.low_emission_area_lights_disable)
-                        {
-                            // Check base luminance of emissive material
-                            if (luminance(instance.material->emissivity) < optionsNew.low_emission_threshold)
-                            {
-                                continue;
-                            }
-                        }
-                        lightInstancePrimitiveOffset[i] = areaLightCount + areaLightStartID;
-                        areaLightCount += primitives;
-                    }
-                }
-
-                if (!lightInstancePrimitiveOffset.empty())
-                {
-                    // Create light mesh buffer
-                    gfxDestroyBuffer(gfx_, lightInstanceBuffer);
-                    lightInstanceBuffer = gfxCreateBuffer<uint32_t>(gfx_,
-                        static_cast<uint32_t>(lightInstancePrimitiveOffset.size()),
-                        lightInstancePrimitiveOffset.data());
-                    lightInstanceBuffer.setName("LightInstanceBuffer");
-                }
+                updateEmissiveInstances(capsaicin, optionsNew, static_cast<uint32_t>(lightData.size()));
             }
 
-            uint32_t const lightCount = areaLightCount + static_cast<uint32_t>(allLightData.size());
+            uint32_t const lightCount = areaLightCount + static_cast<uint32_t>(lightData.size());
             uint32_t const numLights =
                 glm::max(lightCount, 1U); // Always allocate buffers even when no lights
             if (lightBuffer.getCount() < numLights)
@@ -321,84 +262,69 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
                 // Swapping is faster so just don't look at the constant cast
                 swap(lightBuffer, const_cast<GfxBuffer &>(capsaicin.getSharedBuffer("PrevLightBuffer")));
             }
-            if (!allLightData.empty())
+            if (!lightData.empty())
             {
                 // Copy delta lights to start of buffer (after any environment maps)
                 GfxBuffer const upload_buffer = gfxCreateBuffer<Light>(gfx_,
-                    static_cast<uint32_t>(allLightData.size()), allLightData.data(), kGfxCpuAccess_Write);
+                    static_cast<uint32_t>(lightData.size()), lightData.data(), kGfxCpuAccess_Write);
                 gfxCommandCopyBuffer(
-                    gfx_, lightBuffer, 0, upload_buffer, 0, allLightData.size() * sizeof(Light));
+                    gfx_, lightBuffer, 0, upload_buffer, 0, lightData.size() * sizeof(Light));
                 gfxDestroyBuffer(gfx_, upload_buffer);
             }
             gfxCommandClearBuffer(gfx_, lightCountBuffer, lightCount);
         }
+        else
+        {
+            TimedSection const timedSection(*this, "PatchLights");
+
+            // The list is updated in place so the current contents become the previous frames lights
+            if (hasPreviousLightBuffer)
+            {
+                gfxCommandCopyBuffer(gfx_, capsaicin.getSharedBuffer("PrevLightBuffer"), lightBuffer);
+            }
+
+            vector<CapsaicinInternal::BufferUpload> uploads;
+            if (envMapUpdated && environmentMapCount != 0)
+            {
+                layout.patchEnvironmentLight(
+                    MakeEnvironmentLight(environmentMap.getMipLevels(), environmentMap.getWidth()));
+                uploads.emplace_back(0U, 1U, &layout.getLights()[0]);
+            }
+            if (deltaLightUpdated)
+            {
+                for (uint32_t const slot : layout.patchDeltaLights(lights, deltaLightTracker.getChanged()))
+                {
+                    uploads.emplace_back(slot, 1U, &layout.getLights()[slot]);
+                }
+            }
+            capsaicin.uploadBufferRanges(lightBuffer, sizeof(Light), uploads);
+        }
 
         // Gather the area lights
-        if (areaLightCount > 0)
+        if (areaLightCount > 0 && (fullRebuild || areaLightUpdated))
         {
             // The initial delta lights were added top the light list using the CPU but for area lights we
             // use a GPU shader to write all lights in parallel.
             TimedSection const timedSection(*this, "GatherAreaLights");
-
-            // Create a list of valid instance|meshlet pairs that contain emissive meshlets.
-            vector<DrawData> drawData;
-            uint32_t const   instanceCount = gfxSceneGetObjectCount<GfxInstance>(capsaicin.getScene());
-            for (uint32_t i = 0; i < instanceCount; ++i)
+            if (fullRebuild)
             {
-                if (GfxConstRef const instanceRef = gfxSceneGetObjectHandle<GfxInstance>(scene, i);
-                    instanceRef->mesh && instanceRef->material
-                    && gfxMaterialIsEmissive(*instanceRef->material))
+                gatherAreaLights(
+                    capsaicin, drawDataBuffer, static_cast<uint32_t>(layout.getDrawData().size()));
+            }
+            else
+            {
+                // Only the instances that have moved need their lights to be re-gathered
+                vector<DrawData> const movedDrawData =
+                    layout.getMovedDrawData(capsaicin.getTransformsChanged());
+                if (!movedDrawData.empty())
                 {
-                    if (optionsNew.low_emission_area_lights_disable)
-                    {
-                        if (luminance(instanceRef->material->emissivity) < optionsNew.low_emission_threshold)
-                        {
-                            continue;
-                        }
-                    }
-                    uint32_t const  instanceIndex = capsaicin.getInstanceIdData()[i];
-                    Instance const &instance      = capsaicin.getInstanceData()[instanceIndex];
-                    for (uint32_t j = 0; j < instance.meshlet_count; ++j)
-                    {
-                        drawData.emplace_back(instance.meshlet_offset_idx + j, instanceIndex);
-                    }
+                    auto const      drawCount = static_cast<uint32_t>(movedDrawData.size());
+                    GfxBuffer const movedDrawDataBuffer =
+                        gfxCreateBuffer<DrawData>(gfx_, drawCount, movedDrawData.data());
+                    gatherAreaLights(capsaicin, movedDrawDataBuffer, drawCount);
+                    gfxDestroyBuffer(gfx_, movedDrawDataBuffer);
                 }
             }
-            auto            drawCount      = static_cast<uint32_t>(drawData.size());
-            GfxBuffer const drawDataBuffer = gfxCreateBuffer<DrawData>(gfx_, drawCount, drawData.data());
-
-            // The shader is actually a compute kernel, but it functions identically to a mesh shader. We run
-            // a mesh shader group for each entry in the draw call list. Each shader group is then responsible
-            // for collecting and writing primitives into the light list. A downside of this approach is that
-            // the number of primitives per meshlet may not fully fill our group size which can lead to unused
-            // threads. Attempting to merge meshlets to improve occupancy is outside the scope of what's
-            // required here, and we leave it as an optimisation for the asset writer/processor.
-            gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_DrawDataBuffer", drawDataBuffer);
-            gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_DrawCount", drawCount);
-            gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_LightBuffer", lightBuffer);
-            gfxProgramSetParameter(
-                gfx_, gatherAreaLightsProgram, "g_LightInstanceBuffer", lightInstanceBuffer);
-
-            gfxProgramSetParameter(
-                gfx_, gatherAreaLightsProgram, "g_MaterialBuffer", capsaicin.getMaterialBuffer());
-            gfxProgramSetParameter(
-                gfx_, gatherAreaLightsProgram, "g_VertexBuffer", capsaicin.getVertexBuffer());
-            gfxProgramSetParameter(
-                gfx_, gatherAreaLightsProgram, "g_VertexDataIndex", capsaicin.getVertexDataIndex());
-            gfxProgramSetParameter(
-                gfx_, gatherAreaLightsProgram, "g_MeshletBuffer", capsaicin.getSharedBuffer("Meshlets"));
-            gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_MeshletPackBuffer",
-                capsaicin.getSharedBuffer("MeshletPack"));
-            gfxProgramSetParameter(
-                gfx_, gatherAreaLightsProgram, "g_InstanceBuffer", capsaicin.getInstanceBuffer());
-            gfxProgramSetParameter(
-                gfx_, gatherAreaLightsProgram, "g_TransformBuffer", capsaicin.getTransformBuffer());
-
-            // Draw meshlets
-            gfxCommandBindKernel(gfx_, gatherAreaLightsKernel);
-            gfxCommandDispatch(gfx_, drawCount, 1, 1);
-
-            gfxDestroyBuffer(gfx_, drawDataBuffer);
         }
 
         if (hasPreviousLightBuffer && lightIndexesChanged)
@@ -422,6 +348,112 @@ void LightBuilder::run(CapsaicinInternal &capsaicin) noexcept
     options = optionsNew;
 }
 
+void LightBuilder::updateEmissiveInstances(
+    CapsaicinInternal const &capsaicin, RenderOptions const &newOptions, uint32_t const startID) noexcept
+{
+    // Create a mapping table that maps each emissive instance into the final light buffer list. Surfaces are
+    // mapped by their instanceID and primitiveID (zero index incrementing value per triangle in mesh). Since
+    // not all instances have emissive meshes and that each emissive mesh has different primitive counts we
+    // need to map (instanceID|primitiveID) pairs to an ID into the light buffer. The `lightInstanceBuffer`
+    // contains a lookup by instanceID and returns the start offset into the light buffer for that instance.
+    // Those values can then be offset by the primitiveID to get the exact light location. As many instances
+    // are going to contain zero valid emissive meshes the buffer is sparsely populated.
+    // At the same time a list of valid instance|meshlet pairs that contain emissive meshlets is created, this
+    // is kept so that the lights of individual instances can be re-gathered.
+    auto const         scene         = capsaicin.getScene();
+    uint32_t const     instanceCount = gfxSceneGetObjectCount<GfxInstance>(scene);
+    GfxInstance const *instances     = gfxSceneGetObjects<GfxInstance>(scene);
+    vector<uint32_t>   lightInstancePrimitiveOffset(instanceCount);
+    layout.beginEmissiveInstances(instanceCount);
+    areaLightTotal = 0;
+    areaLightCount = 0;
+    for (uint32_t i = 0; i < instanceCount; ++i)
+    {
+        auto const &instance = instances[i];
+        if (instance.mesh && instance.material && gfxMaterialIsEmissive(*instance.material))
+        {
+            auto const primitives = static_cast<uint32_t>(instance.mesh->indices.size()) / 3;
+
+            areaLightTotal += primitives;
+            if (newOptions.low_emission_area_lights_disable)
+            {
+                // Check base luminance of emissive material
+                if (luminance(instance.material->emissivity) < newOptions.low_emission_threshold)
+                {
+                    continue;
+                }
+            }
+            lightInstancePrimitiveOffset[i] = areaLightCount + startID;
+            areaLightCount += primitives;
+
+            uint32_t const  instanceIndex = capsaicin.getInstanceIdData()[i];
+            Instance const &instanceData  = capsaicin.getInstanceData()[instanceIndex];
+            layout.addEmissiveInstance(
+                i, instanceIndex, instanceData.meshlet_offset_idx, instanceData.meshlet_count);
+        }
+    }
+
+    if (!lightInstancePrimitiveOffset.empty())
+    {
+        // Create light mesh buffer
+        gfxDestroyBuffer(gfx_, lightInstanceBuffer);
+        lightInstanceBuffer = gfxCreateBuffer<uint32_t>(
+            gfx_, instanceCount, lightInstancePrimitiveOffset.data());
+        lightInstanceBuffer.setName("LightInstanceBuffer");
+    }
+
+    auto const &drawData  = layout.getDrawData();
+    auto const  drawCount = static_cast<uint32_t>(drawData.size());
+    if (drawDataBuffer.getCount() < drawCount || drawDataBuffer.getCount() == 0)
+    {
+        gfxDestroyBuffer(gfx_, drawDataBuffer);
+        drawDataBuffer = gfxCreateBuffer<DrawData>(gfx_, glm::max(drawCount, 1U));
+        drawDataBuffer.setName("LightDrawDataBuffer");
+    }
+    if (drawCount > 0)
+    {
+        GfxBuffer const uploadBuffer =
+            gfxCreateBuffer<DrawData>(gfx_, drawCount, drawData.data(), kGfxCpuAccess_Write);
+        gfxCommandCopyBuffer(gfx_, drawDataBuffer, 0, uploadBuffer, 0, drawCount * sizeof(DrawData));
+        gfxDestroyBuffer(gfx_, uploadBuffer);
+    }
+}
+
+void LightBuilder::gatherAreaLights(
+    CapsaicinInternal const &capsaicin, GfxBuffer const &drawBuffer, uint32_t const drawCount) noexcept
+{
+    // The shader is actually a compute kernel, but it functions identically to a mesh shader. We run a mesh
+    // shader group for each entry in the draw call list. Each shader group is then responsible for collecting
+    // and writing primitives into the light list. A downside of this approach is that the number of
+    // primitives per meshlet may not fully fill our group size which can lead to unused threads. Attempting
+    // to merge meshlets to improve occupancy is outside the scope of what's required here, and we leave it
+    // as an optimisation for the asset writer/processor.
+    if (drawCount == 0)
+    {
+        return;
+    }
+    gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_DrawDataBuffer", drawBuffer);
+    gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_DrawCount", drawCount);
+    gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_LightBuffer", lightBuffer);
+    gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_LightInstanceBuffer", lightInstanceBuffer);
+
+    gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_MaterialBuffer", capsaicin.getMaterialBuffer());
+    gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_VertexBuffer", capsaicin.getVertexBuffer());
+    gfxProgramSetParameter(
+        gfx_, gatherAreaLightsProgram, "g_VertexDataIndex", capsaicin.getVertexDataIndex());
+    gfxProgramSetParameter(
+        gfx_, gatherAreaLightsProgram, "g_MeshletBuffer", capsaicin.getSharedBuffer("Meshlets"));
+    gfxProgramSetParameter(
+        gfx_, gatherAreaLightsProgram, "g_MeshletPackBuffer", capsaicin.getSharedBuffer("MeshletPack"));
+    gfxProgramSetParameter(gfx_, gatherAreaLightsProgram, "g_InstanceBuffer", capsaicin.getInstanceBuffer());
+    gfxProgramSetParameter(
+        gfx_, gatherAreaLightsProgram, "g_TransformBuffer", capsaicin.getTransformBuffer());
+
+    // Draw meshlets
+    gfxCommandBindKernel(gfx_, gatherAreaLightsKernel);
+    gfxCommandDispatch(gfx_, drawCount, 1, 1);
+}
+
 void LightBuilder::terminate() noexcept
 {
     gfxDestroyBuffer(gfx_, lightBuffer);
@@ -430,6 +462,9 @@ void LightBuilder::terminate() noexcept
     lightCountBuffer = {};
     gfxDestroyBuffer(gfx_, lightInstanceBuffer);
     lightInstanceBuffer = {};
+    gfxDestroyBuffer(gfx_, drawDataBuffer);
+    drawDataBuffer = {};
+    layout.clear();
 
     gfxDestroyKernel(gfx_, gatherAreaLightsKernel);
     gatherAreaLightsKernel = {};
@@ -587,4 +622,9 @@ bool LightBuilder::getLightIndexesChanged() const
 {
     return lightIndexesChanged;
 }
+
+GfxBuffer const &LightBuilder::getLightBuffer() const
+{
+    return lightBuffer;
+}
 } // namespace Capsaicin
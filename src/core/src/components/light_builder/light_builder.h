@@ -22,6 +22,11 @@ THE SOFTWARE.
 #pragma once
 
 #include "components/component.h"
+#include "hash_reduce.h"
+#include "light_builder_shared.h"
+#include "light_list_layout.h"
+#include "lights/lights_shared.h"
+#include "render_option_registry.h"
 
 namespace Capsaicin
 {
@@ -195,10 +200,36 @@ class LightBuilder final
      */
     [[nodiscard]] bool getLightIndexesChanged() const;
 
+    /**
+     * Gets the buffer holding the light list.
+     * @note The buffer may be larger than the current light count, see @getLightCount().
+     * @return The light buffer.
+     */
+    [[nodiscard]] GfxBuffer const &getLightBuffer() const;
+
 private:
-    RenderOptions options;
+    /**
+     * Rebuild the list of emissive instances and the mapping of their primitives into the light list.
+     * @param capsaicin  Current framework context.
+     * @param newOptions The render options for the current frame.
+     * @param startID    Index within the light list of the first area light.
+     */
+    void updateEmissiveInstances(
+        CapsaicinInternal const &capsaicin, RenderOptions const &newOptions, uint32_t startID) noexcept;
+
+    /**
+     * Write area lights into the light list.
+     * @param capsaicin  Current framework context.
+     * @param drawBuffer Buffer containing the DrawData of each meshlet to gather.
+     * @param drawCount  Number of meshlets to gather.
+     */
+    void gatherAreaLights(
+        CapsaicinInternal const &capsaicin, GfxBuffer const &drawBuffer, uint32_t drawCount) noexcept;
+
+    RenderOptions                     options;
+    RenderOptionRegistry::GroupHandle optionGroup      = RenderOptionRegistry::InvalidGroupHandle;
+    uint64_t                          optionGeneration = 0; /**< Last option generation converted */
 
-    size_t   lightHash       = 0;
     uint32_t areaLightTotal  = std::numeric_limits<uint32_t>::max(); /**< Number of area lights in meshes */
     uint32_t areaLightCount  = 0;       /**< Number of area lights in light buffer */
     uint32_t pointLightCount = 0;       /**< Number of point lights in light buffer */
@@ -215,6 +246,10 @@ class LightBuilder final
     GfxBuffer lightCountBuffer;    /**< Buffer used to hold number of lights in light buffer */
     GfxBuffer lightInstanceBuffer; /**< Buffer used to hold the offset into light buffer for first primitive
                                       of an instance */
+    GfxBuffer drawDataBuffer;      /**< Buffer used to hold the DrawData of every emissive meshlet */
+
+    HashTracker     deltaLightTracker; /**< Per delta light change tracking */
+    LightListLayout layout;            /**< Placement of the CPU added lights and emissive instances */
 
     GfxProgram gatherAreaLightsProgram;
     GfxKernel  gatherAreaLightsKernel;
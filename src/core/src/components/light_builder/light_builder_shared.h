@@ -23,6 +23,8 @@ THE SOFTWARE.
 #ifndef LIGHT_BUILDER_SHARED_H
 #define LIGHT_BUILDER_SHARED_H
 
+#include "gpu_shared.h"
+
 struct DrawData
 {
     uint meshletIndex;
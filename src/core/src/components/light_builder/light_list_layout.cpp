@@ -0,0 +1,184 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "light_list_layout.h"
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Check if a scene light is one of the delta light types added to the light list.
+ * @param light The scene light.
+ * @return True if supported.
+ */
+bool IsSupportedDeltaLight(GfxLight const &light) noexcept
+{
+    return light.type == kGfxLightType_Directional || light.type == kGfxLightType_Point
+        || light.type == kGfxLightType_Spot;
+}
+
+/**
+ * Make the light list entry for a delta light.
+ * @param light The scene light, must be a supported type.
+ * @return The light list entry.
+ */
+Light MakeDeltaLight(GfxLight const &light) noexcept
+{
+    if (light.type == kGfxLightType_Directional)
+    {
+        return MakeDirectionalLight(light.color * light.intensity, light.direction, light.range);
+    }
+    if (light.type == kGfxLightType_Point)
+    {
+        return MakePointLight(light.color * light.intensity, light.position, light.range);
+    }
+    return MakeSpotLight(light.color * light.intensity, light.position, light.range, light.direction,
+        light.outer_cone_angle, light.inner_cone_angle);
+}
+} // namespace
+
+void LightListLayout::beginRebuild(Light const *environmentLight) noexcept
+{
+    lights_.clear();
+    deltaLightSlots_.clear();
+    if (environmentLight != nullptr)
+    {
+        lights_.push_back(*environmentLight);
+    }
+}
+
+LightListLayout::DeltaLightCounts LightListLayout::addDeltaLights(
+    GfxLight const *lights, uint32_t const lightCount) noexcept
+{
+    deltaLightSlots_.assign(lightCount, InvalidSlot);
+    auto const addLights = [&](GfxLightType const type) {
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < lightCount; ++i)
+        {
+            if (lights[i].type == type)
+            {
+                deltaLightSlots_[i] = static_cast<uint32_t>(lights_.size());
+                lights_.push_back(MakeDeltaLight(lights[i]));
+                ++count;
+            }
+        }
+        return count;
+    };
+    DeltaLightCounts counts;
+    counts.directional = addLights(kGfxLightType_Directional);
+    counts.point       = addLights(kGfxLightType_Point);
+    counts.spot        = addLights(kGfxLightType_Spot);
+    return counts;
+}
+
+bool LightListLayout::needsRebuild(
+    bool const listChanged, GfxLight const *lights, std::vector<uint32_t> const &changedLights) const noexcept
+{
+    if (listChanged)
+    {
+        return true;
+    }
+    for (uint32_t const i : changedLights)
+    {
+        uint32_t const slot = i < deltaLightSlots_.size() ? deltaLightSlots_[i] : InvalidSlot;
+        if (slot == InvalidSlot)
+        {
+            if (IsSupportedDeltaLight(lights[i]))
+            {
+                return true;
+            }
+            continue;
+        }
+        Light current = lights_[slot];
+        if (MakeDeltaLight(lights[i]).get_light_type() != current.get_light_type())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<uint32_t> LightListLayout::patchDeltaLights(
+    GfxLight const *lights, std::vector<uint32_t> const &changedLights) noexcept
+{
+    std::vector<uint32_t> slots;
+    for (uint32_t const i : changedLights)
+    {
+        if (uint32_t const slot = i < deltaLightSlots_.size() ? deltaLightSlots_[i] : InvalidSlot;
+            slot != InvalidSlot)
+        {
+            lights_[slot] = MakeDeltaLight(lights[i]);
+            slots.push_back(slot);
+        }
+    }
+    return slots;
+}
+
+void LightListLayout::patchEnvironmentLight(Light const &environmentLight) noexcept
+{
+    lights_[0] = environmentLight;
+}
+
+void LightListLayout::beginEmissiveInstances(uint32_t const instanceCount) noexcept
+{
+    emissiveInstances_.clear();
+    emissiveInstanceLookup_.assign(instanceCount, InvalidSlot);
+    drawData_.clear();
+}
+
+void LightListLayout::addEmissiveInstance(uint32_t const sceneInstance, uint32_t const instanceIndex,
+    uint32_t const meshletOffset, uint32_t const meshletCount) noexcept
+{
+    emissiveInstanceLookup_[sceneInstance] = static_cast<uint32_t>(emissiveInstances_.size());
+    emissiveInstances_.push_back({static_cast<uint32_t>(drawData_.size()), meshletCount});
+    for (uint32_t j = 0; j < meshletCount; ++j)
+    {
+        drawData_.emplace_back(meshletOffset + j, instanceIndex);
+    }
+}
+
+std::vector<DrawData> LightListLayout::getMovedDrawData(
+    std::vector<uint32_t> const &changedInstances) const noexcept
+{
+    // Only the instances that have moved need their lights to be re-gathered
+    std::vector<DrawData> movedDrawData;
+    for (uint32_t const i : changedInstances)
+    {
+        if (i < emissiveInstanceLookup_.size() && emissiveInstanceLookup_[i] != InvalidSlot)
+        {
+            EmissiveInstance const &instance = emissiveInstances_[emissiveInstanceLookup_[i]];
+            movedDrawData.insert(movedDrawData.end(), drawData_.cbegin() + instance.drawOffset,
+                drawData_.cbegin() + instance.drawOffset + instance.drawCount);
+        }
+    }
+    return movedDrawData;
+}
+
+void LightListLayout::clear() noexcept
+{
+    lights_.clear();
+    deltaLightSlots_.clear();
+    emissiveInstances_.clear();
+    emissiveInstanceLookup_.clear();
+    drawData_.clear();
+}
+} // namespace Capsaicin
@@ -0,0 +1,152 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "light_builder_shared.h"
+#include "lights/lights_shared.h"
+
+#include <gfx_scene.h>
+#include <limits>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * CPU side layout of the light list built by LightBuilder.
+ * Keeps the environment and delta lights added on the CPU along with where each scene light and emissive
+ * instance was placed in the list, so that later changes can be patched in place instead of rebuilding the
+ * whole list. No GPU resources are held so the update decisions can be tested on their own.
+ */
+class LightListLayout
+{
+public:
+    static constexpr uint32_t InvalidSlot = std::numeric_limits<uint32_t>::max();
+
+    /** Number of lights of each type added by addDeltaLights(). */
+    struct DeltaLightCounts
+    {
+        uint32_t directional = 0;
+        uint32_t point       = 0;
+        uint32_t spot        = 0;
+    };
+
+    /**
+     * Start a new light list, this also clears the delta light slots.
+     * @param environmentLight (Optional) The environment light, this is always first in the list.
+     */
+    void beginRebuild(Light const *environmentLight) noexcept;
+
+    /**
+     * Add the supported scene lights to the list.
+     * Lights are added by type to improve gpu performance, directional lights are added first so that they
+     * follow any environment light.
+     * @param lights     The scene lights.
+     * @param lightCount Number of scene lights.
+     * @return The number of lights of each type that were added.
+     */
+    DeltaLightCounts addDeltaLights(GfxLight const *lights, uint32_t lightCount) noexcept;
+
+    /**
+     * Check if the light list has to be rebuilt rather than patched in place.
+     * Lights are patched in place unless any light has moved within the list. A delta light changing type
+     * moves it as lights are grouped by type, as does a scene light that was not previously in the list.
+     * @param listChanged   True if lights were added or removed, the emissive instances changed or the light
+     *                      buffer is too small.
+     * @param lights        The scene lights.
+     * @param changedLights Indexes of the scene lights that have changed.
+     * @return True if the list needs to be rebuilt.
+     */
+    [[nodiscard]] bool needsRebuild(
+        bool listChanged, GfxLight const *lights, std::vector<uint32_t> const &changedLights) const noexcept;
+
+    /**
+     * Update changed delta lights in place.
+     * @note Only valid if needsRebuild() returned false for the same changes.
+     * @param lights        The scene lights.
+     * @param changedLights Indexes of the scene lights that have changed.
+     * @return The list indexes of the updated lights.
+     */
+    std::vector<uint32_t> patchDeltaLights(
+        GfxLight const *lights, std::vector<uint32_t> const &changedLights) noexcept;
+
+    /**
+     * Update the environment light in place.
+     * @note Only valid if the list was started with an environment light.
+     * @param environmentLight The new environment light.
+     */
+    void patchEnvironmentLight(Light const &environmentLight) noexcept;
+
+    /**
+     * Remove all emissive instances.
+     * @param instanceCount Number of scene instances.
+     */
+    void beginEmissiveInstances(uint32_t instanceCount) noexcept;
+
+    /**
+     * Add the meshlets of an emissive instance, these are used to gather its area lights.
+     * @param sceneInstance Index of the scene instance, as used by CapsaicinInternal::getTransformsChanged().
+     * @param instanceIndex Index of the instance within the instance buffer.
+     * @param meshletOffset Index of the first meshlet of the instance.
+     * @param meshletCount  Number of meshlets in the instance.
+     */
+    void addEmissiveInstance(uint32_t sceneInstance, uint32_t instanceIndex, uint32_t meshletOffset,
+        uint32_t meshletCount) noexcept;
+
+    /**
+     * Get the meshlets that need their area lights re-gathered after instances have moved.
+     * @param changedInstances Indexes of the scene instances whose transforms changed.
+     * @return The draw data of every meshlet of the changed emissive instances.
+     */
+    [[nodiscard]] std::vector<DrawData> getMovedDrawData(
+        std::vector<uint32_t> const &changedInstances) const noexcept;
+
+    /**
+     * Gets the environment and delta lights at the start of the list.
+     * @return The lights.
+     */
+    [[nodiscard]] std::vector<Light> const &getLights() const noexcept { return lights_; }
+
+    /**
+     * Gets the draw data of every emissive meshlet.
+     * @return The draw data.
+     */
+    [[nodiscard]] std::vector<DrawData> const &getDrawData() const noexcept { return drawData_; }
+
+    /** Release all stored data. */
+    void clear() noexcept;
+
+private:
+    /** Range of emissive meshlets belonging to an instance. */
+    struct EmissiveInstance
+    {
+        uint32_t drawOffset; /**< Offset of the first meshlet within drawData_ */
+        uint32_t drawCount;  /**< Number of meshlets */
+    };
+
+    std::vector<Light>            lights_;            /**< Environment and delta lights in list */
+    std::vector<uint32_t>         deltaLightSlots_;   /**< List index of each scene light or InvalidSlot */
+    std::vector<EmissiveInstance> emissiveInstances_; /**< Emissive instances within the light list */
+    std::vector<uint32_t> emissiveInstanceLookup_; /**< Index of each scene instance within emissiveInstances_
+                                                      (or InvalidSlot if not emissive) */
+    std::vector<DrawData> drawData_;               /**< Instance|meshlet pairs of all emissive meshlets */
+};
+} // namespace Capsaicin
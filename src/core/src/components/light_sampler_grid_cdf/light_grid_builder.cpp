@@ -0,0 +1,583 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "light_grid_builder.h"
+
+#include "parallel.h"
+#include "utilities/pcg_hash.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Capsaicin
+{
+namespace
+{
+/** Must match THRESHOLD_RADIANCE in light_sampler_grid_cdf.comp. */
+constexpr float ThresholdRadiance = 1.0F / 2048.0F;
+
+/** Must match LIGHT_SAMPLE_GRID_JITTER_SCALE in light_sampler_grid.hlsl. */
+constexpr float JitterScale = 0.5F;
+
+/** Reproduction of the PCG based Random class in random_number_generator.hlsl. */
+struct Random
+{
+    uint32_t rngState;
+
+    Random(uint32_t const randomSeed, uint32_t const seed, uint32_t const index) noexcept
+    {
+        uint32_t const inc = (index << 1) | 1U;
+        rngState           = (MakeSeed(seed, randomSeed) + inc) * 747796405U + inc;
+    }
+
+    uint32_t randInt() noexcept
+    {
+        uint32_t const state = rngState;
+        rngState             = rngState * 747796405U + 2891336453U;
+        uint32_t word        = ((state >> ((state >> 28U) + 4U)) ^ state) * 277803737U;
+        word                 = (word >> 22U) ^ word;
+        return word;
+    }
+
+    float rand() noexcept { return static_cast<float>(randInt() >> 8) * 0x1.0p-24F; }
+};
+
+float Luminance(float3 const &color) noexcept
+{
+    return dot(color, float3(0.2126F, 0.7152F, 0.0722F));
+}
+
+float Saturate(float const value) noexcept
+{
+    return glm::clamp(value, 0.0F, 1.0F);
+}
+
+float Squared(float const value) noexcept
+{
+    return value * value;
+}
+
+/**
+ * Get a corner of a bounding box, in the same order the shaders visit them.
+ * @param minBB  Bounding box minimum values.
+ * @param maxBB  Bounding box maximum values.
+ * @param corner The corner index (range [0, 8)).
+ * @return The corner position.
+ */
+float3 GetCorner(float3 const &minBB, float3 const &maxBB, uint32_t const corner) noexcept
+{
+    return {(corner & 4U) != 0 ? maxBB.x : minBB.x, (corner & 2U) != 0 ? maxBB.y : minBB.y,
+        (corner & 1U) != 0 ? maxBB.z : minBB.z};
+}
+
+/**
+ * Check if a spot light cone intersects a cells bounding sphere (fast cone-sphere test (Hale)).
+ * @note Both sides of the test are evaluated and then selected between so that it can be used within branch
+ * free loops.
+ * @param direction      Negated spot direction.
+ * @param sinAngle       Sine of the cone angle.
+ * @param tanAngle       Tangent of the cone angle.
+ * @param lightDirection Vector from the light to the cell centre.
+ * @param radius         Radius of the cells bounding sphere.
+ * @return True if the cone intersects the sphere.
+ */
+bool SpotIntersect(float3 const &direction, float const sinAngle, float const tanAngle,
+    float3 const &lightDirection, float const radius) noexcept
+{
+    float const  offset = radius * sinAngle;
+    float3 const c      = (lightDirection * sinAngle) - (direction * radius);
+    float const  lenA   = dot(c, direction);
+    bool const   cone   = dot(c, c) <= Squared(lenA) * (Squared(tanAngle) + 1.0F);
+    bool const   sphere = dot(lightDirection, lightDirection) <= Squared(radius);
+    return dot(lightDirection + (direction * offset), direction) < 0.0F ? cone : sphere;
+}
+
+/**
+ * Get the position and extent of a cells jittered bounding box, matches LightSamplerGrid::getCellJitteredBB.
+ * @param config       The grid configuration.
+ * @param cellID       The 3D cell index.
+ * @param [out] extent The bounding box size.
+ * @return The bounding box minimum values.
+ */
+float3 GetCellJitteredBB(
+    LightSamplingConfiguration const &config, uint3 const &cellID, float3 &extent) noexcept
+{
+    extent = config.cellSize * ((2.0F * JitterScale) + 1.0F);
+    return ((float3(cellID) - JitterScale) * config.cellSize) + config.sceneMin;
+}
+
+/**
+ * Get the normal of an octahedron face, matches LightSamplerGrid::getCellNormal.
+ * @param cellFace The face index (range [0, 8)).
+ * @return The face normal.
+ */
+float3 GetCellNormal(uint32_t const cellFace) noexcept
+{
+    return normalize(float3((cellFace & 0x1) != 0 ? -1.0F : 1.0F, (cellFace & 0x2) != 0 ? -1.0F : 1.0F,
+        (cellFace & 0x4) != 0 ? -1.0F : 1.0F));
+}
+
+/**
+ * Call a function for each cell of a grid in parallel.
+ * @tparam Func Type of function to call, called as func(cellIndex, minBB, extent, normal).
+ * @param config   The grid configuration.
+ * @param settings The build settings.
+ * @param func     The function to call, cellIndex is the offset of the cells first element.
+ */
+template<typename Func>
+void ForEachCell(LightSamplingConfiguration const &config, LightGridBuilder::Settings const &settings,
+    Func const &func) noexcept
+{
+    uint32_t const faces     = settings.octahedronSampling ? 8 : 1;
+    uint32_t const cellCount = config.numCells.x * config.numCells.y * config.numCells.z * faces;
+    ParallelFor(0, cellCount, [&](uint32_t const cell) {
+        // Cells (and then faces) are stored in x, y, z order which is the same as the GPU indexing
+        uint32_t const cellFace = cell % faces;
+        uint32_t       linear   = cell / faces;
+        uint3          cellID;
+        cellID.x = linear % config.numCells.x;
+        linear /= config.numCells.x;
+        cellID.y = linear % config.numCells.y;
+        cellID.z = linear / config.numCells.y;
+        float3       extent;
+        float3 const minBB  = GetCellJitteredBB(config, cellID, extent);
+        float3 const normal = settings.octahedronSampling ? GetCellNormal(cellFace) : float3(0.0F);
+        func(cell * config.numCells.w, minBB, extent, normal);
+    });
+}
+} // namespace
+
+void LightGridBuilder::AreaLights::resize(size_t const size) noexcept
+{
+    position.resize(size);
+    direction.resize(size);
+    radiance.resize(size);
+    radianceNormal.resize(size);
+    vertex0.resize(size);
+    vertex1.resize(size);
+    vertex2.resize(size);
+    area.resize(size);
+    range.resize(size);
+}
+
+void LightGridBuilder::PointLights::resize(size_t const size) noexcept
+{
+    position.resize(size);
+    direction.resize(size);
+    radiance.resize(size);
+    range.resize(size);
+    recipRange4.resize(size);
+    sinAngle.resize(size);
+    tanAngle.resize(size);
+    spot.resize(size);
+}
+
+void LightGridBuilder::setLights(std::vector<Light> const &lightList,
+    std::array<float3, 6> const &environmentRadiance, EmissiveSampler const &emissiveSampler) noexcept
+{
+    environment = environmentRadiance;
+
+    // Lights are grouped by type so that sampleCell() can evaluate each type with its own loop, the weights
+    // are output with the infinite lights first followed by the point/spot lights and then the area lights
+    auto const            lightCount = static_cast<uint32_t>(lightList.size());
+    std::vector<uint32_t> typeIndex(lightCount);
+    uint32_t              infiniteCount = 0;
+    uint32_t              pointCount    = 0;
+    uint32_t              areaCount     = 0;
+    for (uint32_t index = 0; index < lightCount; ++index)
+    {
+        Light light = lightList[index];
+        switch (light.get_light_type())
+        {
+        case kLight_Area: typeIndex[index] = areaCount++; break;
+        case kLight_Point:
+        case kLight_Spot: typeIndex[index] = pointCount++; break;
+        default: typeIndex[index] = infiniteCount++; break;
+        }
+    }
+    infiniteLights.resize(infiniteCount);
+    pointLights.resize(pointCount);
+    areaLights.resize(areaCount);
+    slots.resize(lightCount);
+
+    ParallelFor(0, lightCount, [&](uint32_t const index) {
+        Light          light = lightList[index];
+        uint32_t const typed = typeIndex[index];
+        switch (light.get_light_type())
+        {
+        case kLight_Area:
+        {
+            slots[index]             = infiniteCount + pointCount + typed;
+            float3 const v0          = float3(light.v1);
+            float3 const v1          = float3(light.v2);
+            float3 const v2          = float3(light.v3);
+            float3 const emissivity  = float3(light.radiance);
+            float3 const lightCross  = cross(v1 - v0, v2 - v0);
+            float const  crossLength = length(lightCross);
+            areaLights.vertex0.set(typed, v0);
+            areaLights.vertex1.set(typed, v1);
+            areaLights.vertex2.set(typed, v2);
+            areaLights.position.set(typed, (v0 + v1 + v2) * 0.3333333333333F);
+            areaLights.direction.set(typed, lightCross / crossLength);
+            areaLights.area[typed] = 0.5F * crossLength;
+            areaLights.range[typed] =
+                sqrtf(glm::max(emissivity.x, glm::max(emissivity.y, emissivity.z)) / ThresholdRadiance);
+            areaLights.radiance.set(typed, emissivity);
+            areaLights.radianceNormal.set(typed, emissivity);
+            uint32_t const texture = glm::floatBitsToUint(light.radiance.w);
+            if (texture != UINT_MAX && emissiveSampler)
+            {
+                float4 const textureValue = emissiveSampler(texture,
+                    glm::unpackHalf2x16(glm::floatBitsToUint(light.v1.w)),
+                    glm::unpackHalf2x16(glm::floatBitsToUint(light.v2.w)),
+                    glm::unpackHalf2x16(glm::floatBitsToUint(light.v3.w)));
+                // The volume sampling includes texture alpha while the normal sampling does not
+                areaLights.radiance.set(typed, emissivity * float3(textureValue) * textureValue.w);
+                areaLights.radianceNormal.set(typed, emissivity * float3(textureValue));
+            }
+            break;
+        }
+        case kLight_Point:
+        case kLight_Spot:
+            slots[index] = infiniteCount + typed;
+            pointLights.position.set(typed, float3(light.v1));
+            pointLights.direction.set(typed, float3(light.v2));
+            pointLights.radiance.set(typed, float3(light.radiance));
+            pointLights.range[typed]       = light.v1.w;
+            pointLights.recipRange4[typed] = 1.0F / Squared(Squared(light.v1.w));
+            pointLights.sinAngle[typed]    = light.v2.w;
+            pointLights.tanAngle[typed]    = light.v3.z;
+            pointLights.spot[typed]        = light.get_light_type() == kLight_Spot ? 1 : 0;
+            break;
+        case kLight_Direction:
+            slots[index]          = typed;
+            infiniteLights[typed] = {kLight_Direction, float3(light.v2), float3(light.radiance)};
+            break;
+        case kLight_Environment:
+        {
+            slots[index] = typed;
+            // Sum in the same order as the shader samples each face
+            float3 radiance = environmentRadiance[4] + environmentRadiance[5] + environmentRadiance[2]
+                            + environmentRadiance[3] + environmentRadiance[0] + environmentRadiance[1];
+            radiance *= 4.0F * glm::pi<float>() / 6.0F;
+            infiniteLights[typed] = {kLight_Environment, float3(0.0F), radiance};
+            break;
+        }
+        }
+    });
+}
+
+uint32_t LightGridBuilder::GetGridSize(
+    LightSamplingConfiguration const &config, Settings const &settings) noexcept
+{
+    return config.numCells.x * config.numCells.y * config.numCells.z * config.numCells.w
+         * (settings.octahedronSampling ? 8 : 1);
+}
+
+void LightGridBuilder::buildCDF(LightSamplingConfiguration const &config, Settings const &settings,
+    std::vector<uint32_t> &cellsIndex, std::vector<float> &cellsCDF) const noexcept
+{
+    uint32_t const gridSize = GetGridSize(config, settings);
+    cellsIndex.assign(gridSize, 0);
+    cellsCDF.assign(gridSize, 0.0F);
+    auto const     totalLights      = static_cast<uint32_t>(slots.size());
+    uint32_t const maxLightsPerCell = config.numCells.w - 1;
+    ForEachCell(config, settings,
+        [&](uint32_t const cellIndex, float3 const &minBB, float3 const &extent, float3 const &normal) {
+            // All light weights are evaluated up front, the lights are then still visited in list order
+            thread_local std::vector<float> weights;
+            weights.resize(totalLights);
+            sampleCell(minBB, extent, normal, settings, weights.data());
+            uint32_t const startIndex   = cellIndex + 1;
+            uint32_t       storedLights = 0;
+            float          totalWeight  = 0.0F;
+            for (uint32_t lightIndex = 0; lightIndex < totalLights; ++lightIndex)
+            {
+                float const y = weights[slots[lightIndex]];
+                if (y <= 0.0F)
+                {
+                    continue;
+                }
+                // Store only the most important lights
+                totalWeight += y;
+                if (settings.hasAllLights || storedLights < maxLightsPerCell)
+                {
+                    ++storedLights;
+                    cellsIndex[cellIndex + storedLights] = lightIndex;
+                    cellsCDF[cellIndex + storedLights]   = y;
+                    continue;
+                }
+                // Find the lowest contributing light and replace, the first of any equal lights is used
+                uint32_t       smallestLight = UINT_MAX;
+                float          smallestCDF   = y;
+                uint32_t const writeIndex    = startIndex + storedLights;
+                for (uint32_t light = startIndex; light < writeIndex; ++light)
+                {
+                    if (cellsCDF[light] < smallestCDF)
+                    {
+                        smallestLight = light;
+                        smallestCDF   = cellsCDF[light];
+                    }
+                }
+                if (smallestLight != UINT_MAX)
+                {
+                    cellsIndex[smallestLight] = lightIndex;
+                    cellsCDF[smallestLight]   = y;
+                }
+            }
+
+            // Add table for cells light list
+            cellsIndex[cellIndex] = storedLights;
+
+            // Convert to a normalised CDF
+            float runningCDF = 0.0F;
+            for (uint32_t i = startIndex; i <= cellIndex + storedLights; ++i)
+            {
+                runningCDF += cellsCDF[i];
+                cellsCDF[i] = runningCDF;
+            }
+            float const recipMaxCDF = 1.0F / runningCDF;
+            for (uint32_t j = startIndex; j < cellIndex + storedLights; ++j)
+            {
+                cellsCDF[j] *= recipMaxCDF;
+            }
+            cellsCDF[cellIndex + storedLights] = 1.0F;
+
+            // Write out max cdf to cell table
+            cellsCDF[cellIndex] = settings.hasAllLights ? recipMaxCDF : runningCDF / totalWeight;
+        });
+}
+
+void LightGridBuilder::buildStream(LightSamplingConfiguration const &config, Settings const &settings,
+    uint32_t const randomSeed, uint32_t const frameIndex, std::vector<uint32_t> &cellsIndex,
+    std::vector<float2> &cellsReservoirs) const noexcept
+{
+    uint32_t const gridSize = GetGridSize(config, settings);
+    cellsIndex.assign(gridSize, 0);
+    cellsReservoirs.assign(gridSize, float2(0.0F));
+    auto const     totalLights       = static_cast<uint32_t>(slots.size());
+    uint32_t const reservoirsPerCell = config.numCells.w;
+    ForEachCell(config, settings,
+        [&](uint32_t const cellStart, float3 const &minBB, float3 const &extent, float3 const &normal) {
+            // Every reservoir of a cell shares the same light weights
+            thread_local std::vector<float> weights;
+            weights.resize(totalLights);
+            sampleCell(minBB, extent, normal, settings, weights.data());
+            for (uint32_t reservoirID = 0; reservoirID < glm::min(reservoirsPerCell, totalLights);
+                ++reservoirID)
+            {
+                // Each reservoir streams through every reservoirsPerCell light starting at its own offset
+                uint32_t const cellIndex         = cellStart + reservoirID;
+                Random         randomNG          = Random(randomSeed, cellIndex, frameIndex);
+                uint32_t       storedLight       = UINT_MAX;
+                float          storedLightWeight = 0.0F;
+                float          totalWeight       = 0.0F;
+                float          j                 = randomNG.rand();
+                float          pNone             = 1.0F;
+                for (uint32_t lightIndex = reservoirID; lightIndex < totalLights;
+                    lightIndex += reservoirsPerCell)
+                {
+                    float const sampleWeight = weights[slots[lightIndex]];
+                    // Must avoid 0 samples at the start of the stream to avoid division by 0
+                    if (sampleWeight > 0.0F)
+                    {
+                        totalWeight += sampleWeight;
+                        float const p = sampleWeight / totalWeight;
+                        j -= p * pNone;
+                        pNone *= (1.0F - p);
+                        if (j <= 0.0F)
+                        {
+                            storedLight       = lightIndex;
+                            storedLightWeight = sampleWeight;
+                            j                 = randomNG.rand();
+                            pNone             = 1.0F;
+                        }
+                    }
+                }
+                cellsIndex[cellIndex] = storedLight;
+                if (settings.resample)
+                {
+                    float const storeValue =
+                        (storedLightWeight > 0.0F) ? totalWeight / storedLightWeight : 0.0F;
+                    cellsReservoirs[cellIndex] = float2(storeValue, totalWeight);
+                }
+                else
+                {
+                    cellsReservoirs[cellIndex] = float2(storedLightWeight, totalWeight);
+                }
+            }
+        });
+}
+
+void LightGridBuilder::sampleCell(float3 const &minBB, float3 const &extent, float3 const &normal,
+    Settings const &settings, float *weights) const noexcept
+{
+    // Note: The point light overlap weighting (LIGHT_SAMPLE_VOLUME_OVERLAP) does not effect the result of the
+    // shader version so is not reproduced here
+    float3 const extentCentre = extent * 0.5F;
+    float3 const centre       = minBB + extentCentre;
+    float3 const maxBB        = minBB + extent;
+    float const  radius       = length(extentCentre);
+    bool const   octahedron   = settings.octahedronSampling;
+    auto const   isInside     = [&minBB, &maxBB](float3 const &position) -> bool {
+        return (position.x >= minBB.x) & (position.y >= minBB.y) & (position.z >= minBB.z)
+             & (position.x <= maxBB.x) & (position.y <= maxBB.y) & (position.z <= maxBB.z);
+    };
+    // When sampling by normal the cell corners facing away from the cell normal are skipped
+    auto const cornerWeight = [&](float3 const &position, float3 const &lightVector) {
+        float const lightLength = sqrtf(dot(lightVector, lightVector));
+        bool const  skip =
+            octahedron & !isInside(position) & (dot(lightVector / lightLength, normal) >= 0.7071F);
+        return skip ? 0.0F : 1.0F;
+    };
+    std::array<float3, 8> corners;
+    for (uint32_t corner = 0; corner < 8; ++corner)
+    {
+        corners[corner] = GetCorner(minBB, maxBB, corner);
+    }
+
+    // Directional and environment lights are constant at all points, when sampling by normal directional
+    // lights facing away from the cell are culled and only the environment faces that the normal straddles
+    // are used
+    float3 environmentNormal = float3(0.0F);
+    if (octahedron)
+    {
+        float count = 0.0F;
+        for (uint32_t axis = 3; axis-- > 0;)
+        {
+            if (normal[axis] != 0.0F)
+            {
+                environmentNormal += environment[axis * 2 + (normal[axis] < 0.0F ? 1 : 0)];
+                ++count;
+            }
+        }
+        environmentNormal *= 4.0F * glm::pi<float>() / count;
+    }
+    for (InfiniteLight const &light : infiniteLights)
+    {
+        float3 radiance = light.radiance;
+        if (octahedron && light.type == kLight_Environment)
+        {
+            radiance = environmentNormal;
+        }
+        else if (octahedron && dot(light.direction, normal) <= -0.7071F)
+        {
+            radiance = float3(0.0F);
+        }
+        *weights++ = Luminance(radiance);
+    }
+
+    // Point and spot lights are culled by the range of their sphere and the spot cone, the contribution is
+    // either evaluated at the cell centre or at all 8 corners of the cell which are then interpolated. Each
+    // step is its own loop over the light arrays and culls are applied as selects so that the loops contain
+    // no branches and can be vectorised.
+    auto const   pointCount   = static_cast<uint32_t>(pointLights.range.size());
+    float *const pointWeights = weights;
+    auto const   pointFalloff = [this](uint32_t const index, float3 const &lightVector) {
+        float const distSqr = dot(lightVector, lightVector);
+        return Saturate(1.0F - (Squared(distSqr) * pointLights.recipRange4[index])) / (0.0001F + distSqr);
+    };
+    if (settings.centroidBuild)
+    {
+        for (uint32_t index = 0; index < pointCount; ++index)
+        {
+            pointWeights[index] = pointFalloff(index, centre - pointLights.position.get(index));
+        }
+    }
+    else
+    {
+        std::fill_n(pointWeights, pointCount, 0.0F);
+        for (float3 const &corner : corners)
+        {
+            for (uint32_t index = 0; index < pointCount; ++index)
+            {
+                float3 const position    = pointLights.position.get(index);
+                float3 const lightVector = corner - position;
+                pointWeights[index] += pointFalloff(index, lightVector) * cornerWeight(position, lightVector);
+            }
+        }
+    }
+    for (uint32_t index = 0; index < pointCount; ++index)
+    {
+        float3 const position       = pointLights.position.get(index);
+        float3 const lightDirection = centre - position;
+        bool culled = dot(lightDirection, lightDirection) > Squared(radius + pointLights.range[index]);
+        culled |= (pointLights.spot[index] != 0)
+                & !SpotIntersect(pointLights.direction.get(index), pointLights.sinAngle[index],
+                    pointLights.tanAngle[index], lightDirection, radius);
+        // Cull by visibility by checking if light is above plane
+        culled |= octahedron & !isInside(position) & (dot(position - centre, normal) <= -0.7071F);
+        float const falloff = settings.centroidBuild ? pointWeights[index] : 0.125F * pointWeights[index];
+        float const weight  = Luminance(pointLights.radiance.get(index) * falloff);
+        pointWeights[index] = culled ? 0.0F : weight;
+    }
+    weights += pointCount;
+
+    // Area light contribution is emission scaled by surface area converted to solid angle, this is evaluated
+    // in the same way as the point lights
+    auto const   areaCount   = static_cast<uint32_t>(areaLights.area.size());
+    float *const areaWeights = weights;
+    auto const   areaPDF     = [this](uint32_t const index, float3 const &lightVector) {
+        float const lightLengthSqr = dot(lightVector, lightVector);
+        float const recipLengthSqr = (lightLengthSqr != 0.0F) ? 1.0F / lightLengthSqr : 0.0F;
+        return Saturate(fabsf(dot(areaLights.direction.get(index), lightVector / sqrtf(lightLengthSqr))))
+             * recipLengthSqr;
+    };
+    if (settings.centroidBuild)
+    {
+        for (uint32_t index = 0; index < areaCount; ++index)
+        {
+            areaWeights[index] = areaPDF(index, centre - areaLights.position.get(index));
+        }
+    }
+    else
+    {
+        std::fill_n(areaWeights, areaCount, 0.0F);
+        for (float3 const &corner : corners)
+        {
+            for (uint32_t index = 0; index < areaCount; ++index)
+            {
+                float3 const position    = areaLights.position.get(index);
+                float3 const lightVector = corner - position;
+                areaWeights[index] += areaPDF(index, lightVector) * cornerWeight(position, lightVector);
+            }
+        }
+    }
+    for (uint32_t index = 0; index < areaCount; ++index)
+    {
+        float3 const position = areaLights.position.get(index);
+        float const  area     = areaLights.area[index];
+        // Quick cull based on range of sphere falloff
+        bool culled = settings.threshold & (length(centre - position) > (radius + areaLights.range[index]));
+        // Cull by visibility by checking if triangle is above plane
+        culled |= octahedron & !isInside(position)
+                & (dot(areaLights.vertex0.get(index) - centre, normal) <= -0.7071F)
+                & (dot(areaLights.vertex1.get(index) - centre, normal) <= -0.7071F)
+                & (dot(areaLights.vertex2.get(index) - centre, normal) <= -0.7071F);
+        float const  scale = settings.centroidBuild ? area * areaWeights[index]
+                                                    : area * 0.125F * areaWeights[index];
+        float3 const radiance =
+            octahedron ? areaLights.radianceNormal.get(index) : areaLights.radiance.get(index);
+        float const weight = Luminance(radiance * scale);
+        areaWeights[index] = culled ? 0.0F : weight;
+    }
+}
+} // namespace Capsaicin
@@ -0,0 +1,191 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "light_sampler_grid_shared.h"
+#include "lights/lights_shared.h"
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * CPU implementation of the light sampling grid builds.
+ * This mirrors the Build kernels in light_sampler_grid_cdf.comp and light_sampler_grid_stream_build.comp
+ * using the same cell layout, light weights and random sequences so that their output can be validated
+ * against. Cells are built in parallel, which also allows grids for static scenes to be precomputed and
+ * uploaded using LightSamplerGridCDF::setPrecomputedGrid().
+ */
+class LightGridBuilder
+{
+public:
+    /** Build settings, each matches the shader define used by the GPU build. */
+    struct Settings
+    {
+        bool octahedronSampling = false; /**< Build a cell per face normal (*_USE_OCTAHEDRON_SAMPLING) */
+        bool hasAllLights       = false; /**< Store all lights per cell (LIGHTSAMPLERCDF_HAS_ALL_LIGHTS) */
+        bool threshold          = false; /**< Cull weak area lights (LIGHTSAMPLERCDF_USE_THRESHOLD) */
+        bool centroidBuild      = false; /**< Sample cell centroids (LIGHT_SAMPLE_VOLUME_CENTROID) */
+        bool resample           = false; /**< Resampled weights (LIGHTSAMPLERSTREAM_RES_USE_RESAMPLE) */
+
+        bool operator==(Settings const &other) const noexcept = default;
+    };
+
+    /**
+     * Function used to sample an emissive texture of an area light.
+     * Called as emissiveSampler(texture, uv0, uv1, uv2) and should return the texture value at the centroid
+     * of the triangle using the mip level matching its footprint, as done by sampleLightVolume().
+     */
+    using EmissiveSampler =
+        std::function<float4(uint32_t texture, float2 const &uv0, float2 const &uv1, float2 const &uv2)>;
+
+    /**
+     * Set the lights to build the grid from.
+     * @note Any per light values that do not depend on the cell are evaluated once here.
+     * @param lights              The light list in the same order as LightBuilder::getLightBuffer().
+     * @param environmentRadiance Radiance of each environment map face at the mip level stored in the
+     *                            environment light, ordered +x, -x, +y, -y, +z, -z.
+     * @param emissiveSampler     (Optional) Function used to sample emissive textures, textured area lights
+     *                            use an untextured emission if not provided.
+     */
+    void setLights(std::vector<Light> const &lights, std::array<float3, 6> const &environmentRadiance,
+        EmissiveSampler const &emissiveSampler = {}) noexcept;
+
+    /**
+     * Get the number of elements in each output buffer of a grid.
+     * @param config   The grid configuration.
+     * @param settings The build settings.
+     * @return The number of elements.
+     */
+    [[nodiscard]] static uint32_t GetGridSize(
+        LightSamplingConfiguration const &config, Settings const &settings) noexcept;
+
+    /**
+     * Build the grid used by LightSamplerGridCDF.
+     * @param config          The grid configuration (numCells.w includes the cell header).
+     * @param settings        The build settings.
+     * @param [out] cellsIndex The per cell light count followed by the stored light indexes.
+     * @param [out] cellsCDF   The per cell CDF scale followed by the normalised CDF of the stored lights.
+     */
+    void buildCDF(LightSamplingConfiguration const &config, Settings const &settings,
+        std::vector<uint32_t> &cellsIndex, std::vector<float> &cellsCDF) const noexcept;
+
+    /**
+     * Build the grid used by LightSamplerGridStream.
+     * @note Only the serial reservoir build is reproduced, the parallel (RES_MANYLIGHTS) build merges
+     * reservoirs using wave operations so its random choices cannot be matched.
+     * @param config               The grid configuration (numCells.w is the number of reservoirs per cell).
+     * @param settings             The build settings.
+     * @param randomSeed           The global seed used by RandomNumberGenerator ('random_seed').
+     * @param frameIndex           The frame index the GPU build would be run on.
+     * @param [out] cellsIndex      The selected light of each reservoir (-1 if none).
+     * @param [out] cellsReservoirs The weights of each reservoir.
+     */
+    void buildStream(LightSamplingConfiguration const &config, Settings const &settings, uint32_t randomSeed,
+        uint32_t frameIndex, std::vector<uint32_t> &cellsIndex,
+        std::vector<float2> &cellsReservoirs) const noexcept;
+
+private:
+    /** Array of vectors stored as separate component arrays. */
+    struct Float3Array
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+
+        void resize(size_t const size) noexcept
+        {
+            x.resize(size);
+            y.resize(size);
+            z.resize(size);
+        }
+
+        void set(size_t const index, float3 const &value) noexcept
+        {
+            x[index] = value.x;
+            y[index] = value.y;
+            z[index] = value.z;
+        }
+
+        [[nodiscard]] float3 get(size_t const index) const noexcept { return {x[index], y[index], z[index]}; }
+    };
+
+    /** Cell independent values of the area lights. */
+    struct AreaLights
+    {
+        Float3Array        position;       /**< Triangle centroid */
+        Float3Array        direction;      /**< Triangle normal */
+        Float3Array        radiance;       /**< Emission used by sampleLightVolume() */
+        Float3Array        radianceNormal; /**< Emission used by sampleLightVolumeNormal() */
+        Float3Array        vertex0;        /**< First triangle vertex */
+        Float3Array        vertex1;        /**< Second triangle vertex */
+        Float3Array        vertex2;        /**< Third triangle vertex */
+        std::vector<float> area;           /**< Triangle surface area */
+        std::vector<float> range;          /**< Range used by the threshold cull */
+
+        void resize(size_t size) noexcept;
+    };
+
+    /** Cell independent values of the point and spot lights. */
+    struct PointLights
+    {
+        Float3Array          position;    /**< Light position */
+        Float3Array          direction;   /**< Negated spot direction */
+        Float3Array          radiance;    /**< Light emission */
+        std::vector<float>   range;       /**< Light range */
+        std::vector<float>   recipRange4; /**< Reciprocal of the range to the 4th power */
+        std::vector<float>   sinAngle;    /**< Spot light cone sine */
+        std::vector<float>   tanAngle;    /**< Spot light cone tangent */
+        std::vector<uint8_t> spot;        /**< Non-zero for spot lights */
+
+        void resize(size_t size) noexcept;
+    };
+
+    /** Directional or environment light, these are constant over a cell and are few so are kept as is. */
+    struct InfiniteLight
+    {
+        LightType type;
+        float3    direction; /**< Direction to the light */
+        float3    radiance;  /**< Emission used by sampleLightVolume() */
+    };
+
+    /**
+     * Evaluate the weight of every light for a cell.
+     * Each light type is evaluated by a separate branch free loop over its arrays.
+     * @param minBB          The cell jittered bounding box minimum values.
+     * @param extent         The cell jittered bounding box size.
+     * @param normal         The cell face normal (only used with octahedron sampling).
+     * @param settings       The build settings.
+     * @param [out] weights  The weight of each light, ordered by the slots of each light.
+     */
+    void sampleCell(float3 const &minBB, float3 const &extent, float3 const &normal, Settings const &settings,
+        float *weights) const noexcept;
+
+    std::vector<InfiniteLight> infiniteLights;
+    PointLights                pointLights;
+    AreaLights                 areaLights;
+    std::vector<uint32_t>      slots; /**< Position of each light within the weights output by sampleCell() */
+    std::array<float3, 6>      environment = {}; /**< Environment face radiance (+x, -x, +y, -y, +z, -z) */
+};
+} // namespace Capsaicin
@@ -26,6 +26,8 @@ THE SOFTWARE.
 #include "components/light_builder/light_builder.h"
 #include "components/random_number_generator/random_number_generator.h"
 
+#include <optional>
+
 namespace Capsaicin
 {
 LightSamplerGridCDF::LightSamplerGridCDF() noexcept
@@ -46,6 +48,7 @@ RenderOptionList LightSamplerGridCDF::getRenderOptions() noexcept
     newOptions.emplace(RENDER_OPTION_MAKE(light_grid_cdf_octahedron_sampling, options));
     newOptions.emplace(RENDER_OPTION_MAKE(light_grid_cdf_centroid_build, options));
     newOptions.emplace(RENDER_OPTION_MAKE(light_grid_cdf_cell_overlap, options));
+    newOptions.emplace(RENDER_OPTION_MAKE(light_grid_cdf_cpu_build, options));
     return newOptions;
 }
 
@@ -59,6 +62,7 @@ LightSamplerGridCDF::RenderOptions LightSamplerGridCDF::convertOptions(
     RENDER_OPTION_GET(light_grid_cdf_octahedron_sampling, newOptions, options)
     RENDER_OPTION_GET(light_grid_cdf_centroid_build, newOptions, options)
     RENDER_OPTION_GET(light_grid_cdf_cell_overlap, newOptions, options)
+    RENDER_OPTION_GET(light_grid_cdf_cpu_build, newOptions, options)
     return newOptions;
 }
 
@@ -73,6 +77,8 @@ ComponentList LightSamplerGridCDF::getComponents() const noexcept
 bool LightSamplerGridCDF::init(CapsaicinInternal const &capsaicin) noexcept
 {
     initKernels(capsaicin);
+    optionGroup      = capsaicin.getOptionRegistry().getGroup(getName());
+    optionGeneration = 0;
 
     configBuffer = gfxCreateBuffer<LightSamplingConfiguration>(gfx_, 1);
     configBuffer.setName("Capsaicin_LightSamplerGridCDF_ConfigBuffer");
@@ -85,7 +91,9 @@ bool LightSamplerGridCDF::init(CapsaicinInternal const &capsaicin) noexcept
 void LightSamplerGridCDF::run(CapsaicinInternal &capsaicin) noexcept
 {
     // Update internal options
-    auto const optionsNew   = convertOptions(capsaicin.getOptions());
+    auto const optionsNew   = capsaicin.getOptionRegistry().checkChanged(optionGroup, optionGeneration)
+                                ? convertOptions(capsaicin.getOptions())
+                                : options;
     auto const lightBuilder = capsaicin.getComponent<LightBuilder>();
 
     recompileFlag =
@@ -104,7 +112,8 @@ void LightSamplerGridCDF::run(CapsaicinInternal &capsaicin) noexcept
         || optionsNew.light_grid_cdf_centroid_build != options.light_grid_cdf_centroid_build
         || optionsNew.light_grid_cdf_cell_overlap != options.light_grid_cdf_cell_overlap
         || lightBuilder->getLightSettingsUpdated() || config.numCells.x == 0 /*i.e. uninitialised*/;
-    options = optionsNew;
+    bool const cpuBuildUpdated = optionsNew.light_grid_cdf_cpu_build != options.light_grid_cdf_cpu_build;
+    options                    = optionsNew;
 
     if (recompileFlag)
     {
@@ -166,8 +175,85 @@ void LightSamplerGridCDF::run(CapsaicinInternal &capsaicin) noexcept
         lightSettingsUpdatedFlag = true;
     }
 
+    bool const rebuild =
+        lightSettingsUpdatedFlag || recompileFlag || cpuBuildUpdated || lightBuilder->getLightsUpdated();
+    if (rebuild)
+    {
+        ++gridGeneration;
+    }
+
+    // Find the newest copy of the light list that has finished reading back, older copies are discarded
+    std::optional<Readback> ready;
+    for (auto &readback : readbacks)
+    {
+        --readback.framesRemaining;
+    }
+    while (!readbacks.empty() && readbacks.front().framesRemaining == 0)
+    {
+        if (ready.has_value())
+        {
+            gfxDestroyBuffer(gfx_, ready->buffer);
+        }
+        ready = readbacks.front();
+        readbacks.pop_front();
+    }
+
+    // The area lights are gathered into the light list on the GPU so a CPU build has to use a copy read back
+    // to the CPU, the GPU build is used until the copy is available
+    if (options.light_grid_cdf_cpu_build && rebuild && lightBuilder->getLightCount() > 0)
+    {
+        Readback readback;
+        readback.framesRemaining = gfxGetBackBufferCount(gfx_);
+        readback.lightCount      = lightBuilder->getLightCount();
+        readback.generation      = gridGeneration;
+        readback.buffer = gfxCreateBuffer<Light>(gfx_, readback.lightCount, nullptr, kGfxCpuAccess_Read);
+        readback.buffer.setName("Capsaicin_LightSamplerGridCDF_ReadbackBuffer");
+        gfxCommandCopyBuffer(gfx_, readback.buffer, 0, lightBuilder->getLightBuffer(), 0,
+            readback.lightCount * sizeof(Light));
+        readbacks.push_back(readback);
+    }
+
+    if (ready.has_value())
+    {
+        // Copies made before the last change to the lights or grid options are out of date
+        if (options.light_grid_cdf_cpu_build && ready->generation == gridGeneration)
+        {
+            TimedSection const timedSection(*this, "BuildLightSamplerCPU");
+            buildPrecomputedGrid(gfxBufferGetData<Light>(gfx_, ready->buffer), ready->lightCount);
+        }
+        gfxDestroyBuffer(gfx_, ready->buffer);
+    }
+
+    // Upload any grid that was built on the CPU in place of the GPU build
+    bool usePrecomputed = false;
+    if (!precomputedIndex.empty())
+    {
+        usePrecomputed = precomputedConfig.numCells == config.numCells
+                      && precomputedConfig.cellSize == config.cellSize
+                      && precomputedConfig.sceneMin == config.sceneMin
+                      && precomputedSettings == getBuildSettings()
+                      && precomputedIndex.size() == lightDataLength
+                      && precomputedCDF.size() == lightDataLength;
+        if (usePrecomputed)
+        {
+            TimedSection const timedSection(*this, "UploadLightSampler");
+
+            uint64_t const  dataSize    = static_cast<uint64_t>(lightDataLength) * sizeof(uint);
+            GfxBuffer const indexUpload = gfxCreateBuffer<uint>(
+                gfx_, lightDataLength, precomputedIndex.data(), kGfxCpuAccess_Write);
+            GfxBuffer const cdfUpload =
+                gfxCreateBuffer<float>(gfx_, lightDataLength, precomputedCDF.data(), kGfxCpuAccess_Write);
+            gfxCommandCopyBuffer(gfx_, lightIndexBuffer, 0, indexUpload, 0, dataSize);
+            gfxCommandCopyBuffer(gfx_, lightCDFBuffer, 0, cdfUpload, 0, dataSize);
+            gfxDestroyBuffer(gfx_, indexUpload);
+            gfxDestroyBuffer(gfx_, cdfUpload);
+        }
+        precomputedIndex = {};
+        precomputedCDF   = {};
+    }
+
     // Create the light sampling structure
-    if (lightSettingsUpdatedFlag || recompileFlag || lightBuilder->getLightsUpdated())
+    if (!usePrecomputed && rebuild)
     {
         TimedSection const timedSection(*this, "BuildLightSampler");
 
@@ -207,6 +293,13 @@ void LightSamplerGridCDF::terminate() noexcept
     lightIndexBuffer = {};
     gfxDestroyBuffer(gfx_, lightCDFBuffer);
     lightCDFBuffer = {};
+    for (auto const &readback : readbacks)
+    {
+        gfxDestroyBuffer(gfx_, readback.buffer);
+    }
+    readbacks.clear();
+    precomputedIndex = {};
+    precomputedCDF   = {};
 
     gfxDestroyKernel(gfx_, buildKernel);
     buildKernel = {};
@@ -247,6 +340,8 @@ void LightSamplerGridCDF::renderGUI(CapsaicinInternal &capsaicin) const noexcept
         // ImGui::Checkbox("Octahedral Sampling",
         // &capsaicin.getOption<bool>("light_grid_cdf_octahedron_sampling"));
         ImGui::Checkbox("Fast Centroid Build", &capsaicin.getOption<bool>("light_grid_cdf_centroid_build"));
+        ImGui::Checkbox(
+            "Build on CPU (Static Scenes)", &capsaicin.getOption<bool>("light_grid_cdf_cpu_build"));
     }
 }
 
@@ -309,6 +404,52 @@ std::string_view LightSamplerGridCDF::getHeaderFile() const noexcept
     return "\"components/light_sampler_grid_cdf/light_sampler_grid_cdf.hlsl\"";
 }
 
+LightSamplingConfiguration const &LightSamplerGridCDF::getConfiguration() const noexcept
+{
+    return config;
+}
+
+LightGridBuilder::Settings LightSamplerGridCDF::getBuildSettings() const noexcept
+{
+    LightGridBuilder::Settings settings;
+    settings.octahedronSampling = options.light_grid_cdf_octahedron_sampling;
+    settings.hasAllLights       = options.light_grid_cdf_lights_per_cell == 0;
+    settings.threshold          = options.light_grid_cdf_threshold;
+    settings.centroidBuild      = options.light_grid_cdf_centroid_build;
+    return settings;
+}
+
+void LightSamplerGridCDF::setPrecomputedGrid(LightSamplingConfiguration const &gridConfig,
+    LightGridBuilder::Settings const &settings, std::vector<uint32_t> cellsIndex,
+    std::vector<float> cellsCDF) noexcept
+{
+    precomputedConfig   = gridConfig;
+    precomputedSettings = settings;
+    precomputedIndex    = std::move(cellsIndex);
+    precomputedCDF      = std::move(cellsCDF);
+}
+
+void LightSamplerGridCDF::buildPrecomputedGrid(Light const *lights, uint32_t const lightCount) noexcept
+{
+    std::vector<Light> lightList(lights, lights + lightCount);
+    for (Light &light : lightList)
+    {
+        LightType const type = light.get_light_type();
+        if (type == kLight_Environment
+            || (type == kLight_Area && glm::floatBitsToUint(light.radiance.w) != UINT_MAX))
+        {
+            return;
+        }
+    }
+    LightGridBuilder builder;
+    builder.setLights(lightList, {});
+    std::vector<uint32_t>            cellsIndex;
+    std::vector<float>               cellsCDF;
+    LightGridBuilder::Settings const settings = getBuildSettings();
+    builder.buildCDF(config, settings, cellsIndex, cellsCDF);
+    setPrecomputedGrid(config, settings, std::move(cellsIndex), std::move(cellsCDF));
+}
+
 bool LightSamplerGridCDF::initKernels(CapsaicinInternal const &capsaicin) noexcept
 {
     boundsProgram = capsaicin.createProgram("components/light_sampler_grid_cdf/light_sampler_grid_cdf");
@@ -24,8 +24,11 @@ THE SOFTWARE.
 #include "capsaicin_internal.h"
 #include "components/component.h"
 #include "components/light_sampler/light_sampler.h"
+#include "light_grid_builder.h"
 #include "light_sampler_grid_shared.h"
 
+#include <deque>
+
 namespace Capsaicin
 {
 class LightSamplerGridCDF final
@@ -64,6 +67,8 @@ class LightSamplerGridCDF final
         bool light_grid_cdf_centroid_build =
             false; /**< Use faster but simpler cell centroid sampling during build */
         bool light_grid_cdf_cell_overlap = false; /**< Use light-cell overlap to weight point/spotlights  */
+        bool light_grid_cdf_cpu_build =
+            false; /**< Build the grid on the CPU from a copy of the lights, intended for static scenes */
     };
 
     /**
@@ -144,10 +149,56 @@ class LightSamplerGridCDF final
      */
     [[nodiscard]] std::string_view getHeaderFile() const noexcept override;
 
+    /**
+     * Get the current grid configuration.
+     * @note Only valid after the first call to LightSamplerGridCDF::run().
+     * @return The configuration.
+     */
+    [[nodiscard]] LightSamplingConfiguration const &getConfiguration() const noexcept;
+
+    /**
+     * Get the settings needed to build a grid on the CPU that matches the current options.
+     * @return The build settings.
+     */
+    [[nodiscard]] LightGridBuilder::Settings getBuildSettings() const noexcept;
+
+    /**
+     * Use a grid built on the CPU (e.g. precomputed offline for a static scene) instead of the GPU build.
+     * @note The grid is uploaded during the next call to LightSamplerGridCDF::run() and is discarded if it no
+     * longer matches the current configuration. It is then used until the lights or grid options change.
+     * @param gridConfig The configuration used to build the grid.
+     * @param settings   The settings used to build the grid.
+     * @param cellsIndex The light indexes output by LightGridBuilder::buildCDF().
+     * @param cellsCDF   The light CDFs output by LightGridBuilder::buildCDF().
+     */
+    void setPrecomputedGrid(LightSamplingConfiguration const &gridConfig,
+        LightGridBuilder::Settings const &settings, std::vector<uint32_t> cellsIndex,
+        std::vector<float> cellsCDF) noexcept;
+
 private:
+    /** A copy of the light list being read back from the GPU for a CPU build. */
+    struct Readback
+    {
+        GfxBuffer buffer;              /**< CPU readable copy of the light buffer */
+        uint32_t  framesRemaining = 0; /**< Number of frames until the copy has completed */
+        uint32_t  lightCount      = 0; /**< Number of lights in the copy */
+        uint64_t  generation      = 0; /**< Grid generation of the copy */
+    };
+
     bool initKernels(CapsaicinInternal const &capsaicin) noexcept;
 
-    RenderOptions options;
+    /**
+     * Build the grid on the CPU from a copy of the light list and pass it to setPrecomputedGrid().
+     * @note Environment radiance and emissive textures are only available on the GPU, light lists containing
+     * either keep using the GPU build.
+     * @param lights     The light list.
+     * @param lightCount Number of lights in the list.
+     */
+    void buildPrecomputedGrid(Light const *lights, uint32_t lightCount) noexcept;
+
+    RenderOptions                     options;
+    RenderOptionRegistry::GroupHandle optionGroup      = RenderOptionRegistry::InvalidGroupHandle;
+    uint64_t                          optionGeneration = 0; /**< Last option generation converted */
     bool          recompileFlag =
         false; /**< Flag to indicate if option change requires a shader recompile this frame */
     bool lightSettingsUpdatedFlag = false; /**< Flag to indicate if option change effects light samples */
@@ -157,6 +208,13 @@ class LightSamplerGridCDF final
     GfxBuffer lightIndexBuffer; /**< Buffer used to hold light indexes for all lights in each cell */
     GfxBuffer lightCDFBuffer;   /**< Buffer used to hold light CDF for all lights in each cell */
 
+    LightSamplingConfiguration precomputedConfig = {uint4 {0}, float3 {0}, float3 {0}, float3 {0}};
+    LightGridBuilder::Settings precomputedSettings;
+    std::vector<uint32_t>      precomputedIndex; /**< Pending CPU built light indexes (empty if none) */
+    std::vector<float>         precomputedCDF;   /**< Pending CPU built light CDFs */
+    std::deque<Readback>       readbacks;        /**< Light list copies pending a CPU build */
+    uint64_t gridGeneration = 0; /**< Incremented every time the grid has to be rebuilt */
+
     GfxProgram boundsProgram;
     GfxKernel  buildKernel;
 };
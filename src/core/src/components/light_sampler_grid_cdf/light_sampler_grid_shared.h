@@ -31,7 +31,7 @@ struct LightSamplingConstants
     uint maxNumLightsPerCell;
 };
 
-#ifdef __cplusplus
+#if defined(__cplusplus) && defined(_MSC_VER)
 #    pragma warning(push)
 #    pragma warning(disable : 4324) // structure was padded due to alignment specifier
 #endif
@@ -52,7 +52,7 @@ struct LightSamplingConfiguration
     float pad3;
 #endif
 };
-#ifdef __cplusplus
+#if defined(__cplusplus) && defined(_MSC_VER)
 #    pragma warning(pop)
 #endif
 
@@ -82,6 +82,8 @@ ComponentList LightSamplerGridStream::getComponents() const noexcept
 bool LightSamplerGridStream::init(CapsaicinInternal const &capsaicin) noexcept
 {
     initKernels(capsaicin);
+    optionGroup      = capsaicin.getOptionRegistry().getGroup(getName());
+    optionGeneration = 0;
 
     boundsLengthBuffer = gfxCreateBuffer<uint>(gfx_, 1);
     boundsLengthBuffer.setName("Capsaicin_LightSamplerGridStream_BoundsCountBuffer");
@@ -116,7 +118,9 @@ bool LightSamplerGridStream::init(CapsaicinInternal const &capsaicin) noexcept
 void LightSamplerGridStream::run(CapsaicinInternal &capsaicin) noexcept
 {
     // Update internal options
-    auto const optionsNew   = convertOptions(capsaicin.getOptions());
+    auto const optionsNew   = capsaicin.getOptionRegistry().checkChanged(optionGroup, optionGeneration)
+                                ? convertOptions(capsaicin.getOptions())
+                                : options;
     auto const lightBuilder = capsaicin.getComponent<LightBuilder>();
 
     // Sanity check input options
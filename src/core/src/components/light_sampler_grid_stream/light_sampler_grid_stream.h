@@ -196,7 +196,9 @@ class LightSamplerGridStream final
     bool initBoundsBuffers() noexcept;
     bool initLightIndexBuffer() noexcept;
 
-    RenderOptions options;
+    RenderOptions                     options;
+    RenderOptionRegistry::GroupHandle optionGroup      = RenderOptionRegistry::InvalidGroupHandle;
+    uint64_t                          optionGeneration = 0; /**< Last option generation converted */
     bool          recompileFlag =
         false; /**< Flag to indicate if option change requires a shader recompile this frame */
     bool lightSettingsUpdatedFlag = false; /**< Flag to indicate if option change effects light samples */
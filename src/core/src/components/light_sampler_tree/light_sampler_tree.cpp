@@ -0,0 +1,230 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "light_sampler_tree.h"
+
+#include "capsaicin_internal.h"
+#include "components/light_builder/light_builder.h"
+#include "components/random_number_generator/random_number_generator.h"
+
+#include <optional>
+
+namespace Capsaicin
+{
+LightSamplerTree::LightSamplerTree() noexcept
+    : LightSampler(Name)
+{}
+
+LightSamplerTree::~LightSamplerTree() noexcept
+{
+    terminate();
+}
+
+ComponentList LightSamplerTree::getComponents() const noexcept
+{
+    ComponentList components;
+    components.emplace_back(COMPONENT_MAKE(LightBuilder));
+    components.emplace_back(COMPONENT_MAKE(RandomNumberGenerator));
+    return components;
+}
+
+bool LightSamplerTree::init([[maybe_unused]] CapsaicinInternal const &capsaicin) noexcept
+{
+    // Always allocate buffers even when there is no tree
+    nodeBuffer = gfxCreateBuffer<LightTreeNode>(gfx_, 1);
+    nodeBuffer.setName("Capsaicin_LightSamplerTree_NodeBuffer");
+    bitTrailBuffer = gfxCreateBuffer<uint2>(gfx_, 1);
+    bitTrailBuffer.setName("Capsaicin_LightSamplerTree_BitTrailBuffer");
+    return !!nodeBuffer && !!bitTrailBuffer;
+}
+
+void LightSamplerTree::run(CapsaicinInternal &capsaicin) noexcept
+{
+    auto const lightBuilder = capsaicin.getComponent<LightBuilder>();
+    if (lightBuilder->getLightIndexesChanged())
+    {
+        ++lightIndexGeneration;
+    }
+
+    // Find the newest copy of the light list that has finished reading back, older copies are discarded
+    std::optional<Readback> ready;
+    for (auto &readback : readbacks)
+    {
+        --readback.framesRemaining;
+    }
+    while (!readbacks.empty() && readbacks.front().framesRemaining == 0)
+    {
+        if (ready.has_value())
+        {
+            gfxDestroyBuffer(gfx_, ready->buffer);
+        }
+        ready = readbacks.front();
+        readbacks.pop_front();
+    }
+
+    // The area lights are gathered into the light list on the GPU so the tree has to be built from a copy
+    // read back to the CPU
+    if (lightBuilder->getLightsUpdated())
+    {
+        Readback readback;
+        readback.framesRemaining = gfxGetBackBufferCount(gfx_);
+        readback.lightCount      = lightBuilder->getLightCount();
+        readback.infiniteCount =
+            lightBuilder->getEnvironmentLightCount() + lightBuilder->getDirectionalLightCount();
+        readback.generation = lightIndexGeneration;
+        if (readback.lightCount > 0)
+        {
+            readback.buffer =
+                gfxCreateBuffer<Light>(gfx_, readback.lightCount, nullptr, kGfxCpuAccess_Read);
+            readback.buffer.setName("Capsaicin_LightSamplerTree_ReadbackBuffer");
+            gfxCommandCopyBuffer(gfx_, readback.buffer, 0, lightBuilder->getLightBuffer(), 0,
+                readback.lightCount * sizeof(Light));
+        }
+        readbacks.push_back(readback);
+    }
+
+    if (ready.has_value())
+    {
+        TimedSection const timedSection(*this, "BuildLightTree");
+        Light const       *lights =
+            ready->lightCount > 0 ? gfxBufferGetData<Light>(gfx_, ready->buffer) : nullptr;
+        if (ready->generation == treeGeneration && ready->lightCount == tree.getLightCount()
+            && lights != nullptr)
+        {
+            // Only the light positions have changed so the existing topology can be kept
+            tree.refit(lights);
+        }
+        else
+        {
+            tree.build(lights, ready->lightCount, ready->infiniteCount);
+        }
+        treeGeneration = ready->generation;
+        gfxDestroyBuffer(gfx_, ready->buffer);
+        uploadTree();
+    }
+
+    // Until a tree is available for the current light list the light indexes in the tree would be wrong
+    bool const wasValid      = treeValid;
+    treeValid                = treeGeneration == lightIndexGeneration;
+    lightSettingsUpdatedFlag = treeValid != wasValid;
+}
+
+bool LightSamplerTree::needsRecompile(CapsaicinInternal const &capsaicin) const noexcept
+{
+    auto const lightBuilder = capsaicin.getComponent<LightBuilder>();
+    return lightBuilder->needsRecompile(capsaicin);
+}
+
+std::vector<std::string> LightSamplerTree::getShaderDefines(CapsaicinInternal const &capsaicin) const noexcept
+{
+    auto const  lightBuilder = capsaicin.getComponent<LightBuilder>();
+    std::vector baseDefines(lightBuilder->getShaderDefines(capsaicin));
+    return baseDefines;
+}
+
+void LightSamplerTree::addProgramParameters(
+    CapsaicinInternal const &capsaicin, GfxProgram const &program) const noexcept
+{
+    auto const lightBuilder = capsaicin.getComponent<LightBuilder>();
+    lightBuilder->addProgramParameters(capsaicin, program);
+
+    auto const rng = capsaicin.getComponent<RandomNumberGenerator>();
+    rng->addProgramParameters(capsaicin, program);
+
+    // An empty tree causes the shader to fall back to uniform sampling
+    uint32_t const nodeCount     = treeValid ? static_cast<uint32_t>(tree.getNodes().size()) : 0;
+    uint32_t const infiniteCount = treeValid ? tree.getInfiniteCount() : 0;
+    gfxProgramSetParameter(gfx_, program, "g_LightTree_Nodes", nodeBuffer);
+    gfxProgramSetParameter(gfx_, program, "g_LightTree_BitTrails", bitTrailBuffer);
+    gfxProgramSetParameter(gfx_, program, "g_LightTree_NodeCount", nodeCount);
+    gfxProgramSetParameter(gfx_, program, "g_LightTree_InfiniteCount", infiniteCount);
+}
+
+bool LightSamplerTree::getLightSettingsUpdated(CapsaicinInternal const &capsaicin) const noexcept
+{
+    auto const lightBuilder = capsaicin.getComponent<LightBuilder>();
+    return lightSettingsUpdatedFlag || lightBuilder->getLightSettingsUpdated();
+}
+
+std::string_view LightSamplerTree::getHeaderFile() const noexcept
+{
+    return "\"components/light_sampler_tree/light_sampler_tree.hlsl\"";
+}
+
+void LightSamplerTree::terminate() noexcept
+{
+    for (auto const &readback : readbacks)
+    {
+        gfxDestroyBuffer(gfx_, readback.buffer);
+    }
+    readbacks.clear();
+    tree.clear();
+    treeGeneration = std::numeric_limits<uint64_t>::max();
+    treeValid      = false;
+
+    gfxDestroyBuffer(gfx_, nodeBuffer);
+    nodeBuffer = {};
+    gfxDestroyBuffer(gfx_, bitTrailBuffer);
+    bitTrailBuffer = {};
+}
+
+void LightSamplerTree::uploadTree() noexcept
+{
+    std::vector<LightTreeNode> const &nodes = tree.getNodes();
+    if (!nodes.empty())
+    {
+        auto const nodeCount = static_cast<uint32_t>(nodes.size());
+        if (nodeBuffer.getCount() < nodeCount)
+        {
+            gfxDestroyBuffer(gfx_, nodeBuffer);
+            nodeBuffer = gfxCreateBuffer<LightTreeNode>(gfx_, nodeCount);
+            nodeBuffer.setName("Capsaicin_LightSamplerTree_NodeBuffer");
+        }
+        GfxBuffer const uploadBuffer =
+            gfxCreateBuffer<LightTreeNode>(gfx_, nodeCount, nodes.data(), kGfxCpuAccess_Write);
+        gfxCommandCopyBuffer(gfx_, nodeBuffer, 0, uploadBuffer, 0, nodeCount * sizeof(LightTreeNode));
+        gfxDestroyBuffer(gfx_, uploadBuffer);
+    }
+
+    // Trails are split into low and high words as shaders do not support 64bit integers everywhere
+    std::vector<uint64_t> const &bitTrails = tree.getBitTrails();
+    if (!bitTrails.empty())
+    {
+        auto const        trailCount = static_cast<uint32_t>(bitTrails.size());
+        std::vector<uint2> trails(trailCount);
+        for (uint32_t i = 0; i < trailCount; ++i)
+        {
+            trails[i] = uint2(static_cast<uint32_t>(bitTrails[i]), static_cast<uint32_t>(bitTrails[i] >> 32));
+        }
+        if (bitTrailBuffer.getCount() < trailCount)
+        {
+            gfxDestroyBuffer(gfx_, bitTrailBuffer);
+            bitTrailBuffer = gfxCreateBuffer<uint2>(gfx_, trailCount);
+            bitTrailBuffer.setName("Capsaicin_LightSamplerTree_BitTrailBuffer");
+        }
+        GfxBuffer const uploadBuffer =
+            gfxCreateBuffer<uint2>(gfx_, trailCount, trails.data(), kGfxCpuAccess_Write);
+        gfxCommandCopyBuffer(gfx_, bitTrailBuffer, 0, uploadBuffer, 0, trailCount * sizeof(uint2));
+        gfxDestroyBuffer(gfx_, uploadBuffer);
+    }
+}
+} // namespace Capsaicin
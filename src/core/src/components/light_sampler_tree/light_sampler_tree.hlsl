@@ -0,0 +1,385 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#ifndef LIGHT_SAMPLER_TREE_HLSL
+#define LIGHT_SAMPLER_TREE_HLSL
+
+/*
+// Requires the following data to be defined in any shader that uses this file
+TextureCube g_EnvironmentBuffer;
+Texture2D g_TextureMaps[] : register(space99);
+SamplerState g_TextureSampler;
+*/
+
+#include "light_sampler_tree_shared.h"
+
+StructuredBuffer<LightTreeNode> g_LightTree_Nodes;
+StructuredBuffer<uint2> g_LightTree_BitTrails;
+uint g_LightTree_NodeCount;
+uint g_LightTree_InfiniteCount;
+
+#include "components/light_builder/light_builder.hlsl"
+#include "lights/light_sampling.hlsl"
+#ifdef LIGHT_SAMPLER_ENABLE_RESERVOIR
+#include "lights/reservoir.hlsl"
+#endif
+
+namespace LightSamplerTree
+{
+    /** Cosine of the difference of two angles, clamped to 1 if the difference is negative. */
+    float cosSubClamped(float sinA, float cosA, float sinB, float cosB)
+    {
+        return cosA > cosB ? 1.0f : cosA * cosB + sinA * sinB;
+    }
+
+    /** Sine of the difference of two angles, clamped to 0 if the difference is negative. */
+    float sinSubClamped(float sinA, float cosA, float sinB, float cosB)
+    {
+        return cosA > cosB ? 0.0f : sinA * cosB - cosA * sinB;
+    }
+
+    /**
+     * Estimate the contribution of the lights below a tree node to a receiver.
+     * @note Must match LightTree::LightBounds::importance.
+     * @param node     The tree node.
+     * @param position Current position on surface.
+     * @param normal   Shading normal vector at current position.
+     * @return The importance (zero if none of the lights can reach the receiver).
+     */
+    float importance(LightTreeNode node, float3 position, float3 normal)
+    {
+        const float power = node.boundsMin.w;
+        if (power <= 0.0f)
+        {
+            return 0.0f;
+        }
+        // Distance to the bounds is clamped so that receivers close to or inside the bounds are not overweighted
+        const float3 center = 0.5f * (node.boundsMin.xyz + node.boundsMax.xyz);
+        const float3 toReceiver = position - center;
+        const float centerDist2 = dot(toReceiver, toReceiver);
+        const float distanceSqr = max(max(centerDist2, 0.5f * length(node.boundsMax.xyz - node.boundsMin.xyz)), 1e-4f);
+        const float3 direction = centerDist2 > 0.0f ? toReceiver * rsqrt(centerDist2) : node.axis.xyz;
+
+        // Angle subtended by the bounds as seen from the receiver
+        float cosThetaB = -1.0f;
+        const float3 radius = node.boundsMax.xyz - center;
+        const float radiusSqr = dot(radius, radius);
+        if (centerDist2 >= radiusSqr && any(position < node.boundsMin.xyz || position > node.boundsMax.xyz))
+        {
+            cosThetaB = sqrt(max(1.0f - radiusSqr / centerDist2, 0.0f));
+        }
+        const float sinThetaB = sqrt(max(1.0f - cosThetaB * cosThetaB, 0.0f));
+
+        // Minimum angle between the emission cone and the direction to the receiver
+        const float cosThetaO = node.axis.w;
+        const float cosThetaE = node.boundsMax.w;
+        const float cosThetaW = dot(node.axis.xyz, direction);
+        const float sinThetaW = sqrt(max(1.0f - cosThetaW * cosThetaW, 0.0f));
+        const float sinThetaO = sqrt(max(1.0f - cosThetaO * cosThetaO, 0.0f));
+        const float cosThetaX = cosSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+        const float sinThetaX = sinSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+        const float cosThetaP = cosSubClamped(sinThetaX, cosThetaX, sinThetaB, cosThetaB);
+        if (cosThetaP <= cosThetaE)
+        {
+            return 0.0f;
+        }
+        float nodeImportance = power * cosThetaP / distanceSqr;
+
+        // Minimum angle between the receiver normal and the bounds, surfaces may be lit from either side
+        if (any(normal != 0.0f))
+        {
+            const float cosThetaI = abs(dot(direction, normal));
+            const float sinThetaI = sqrt(max(1.0f - cosThetaI * cosThetaI, 0.0f));
+            nodeImportance *= cosSubClamped(sinThetaI, cosThetaI, sinThetaB, cosThetaB);
+        }
+        return max(nodeImportance, 0.0f);
+    }
+
+    /**
+     * Get the probability of sampling an infinite light instead of the tree.
+     * @note Each infinite light is given the same probability as the whole tree.
+     * @return The probability.
+     */
+    float getInfiniteProbability()
+    {
+        const uint treeCount = g_LightTree_NodeCount == 0 ? 0 : 1;
+        return g_LightTree_InfiniteCount == 0 ? 0.0f
+            : (float)g_LightTree_InfiniteCount / (float)(g_LightTree_InfiniteCount + treeCount);
+    }
+
+    /**
+     * Sample a light by traversing the light tree.
+     * @param u        Uniform random number in the range [0, 1).
+     * @param position Current position on surface.
+     * @param normal   Shading normal vector at current position.
+     * @param lightPDF (Out) The PDF for the calculated sample (is equal to zero if no valid samples could be found).
+     * @return The index of the new light sample.
+     */
+    uint sampleTree(float u, float3 position, float3 normal, out float lightPDF)
+    {
+        lightPDF = 0.0f;
+        const float infiniteProbability = getInfiniteProbability();
+        if (u < infiniteProbability)
+        {
+            lightPDF = infiniteProbability / (float)g_LightTree_InfiniteCount;
+            return min((uint)(u / infiniteProbability * (float)g_LightTree_InfiniteCount), g_LightTree_InfiniteCount - 1);
+        }
+        u = min((u - infiniteProbability) / (1.0f - infiniteProbability), 0.99999994f);
+
+        float pdf = 1.0f - infiniteProbability;
+        LightTreeNode node = g_LightTree_Nodes[0];
+        if (node.isLeaf != 0 && importance(node, position, normal) <= 0.0f)
+        {
+            return 0;
+        }
+        while (node.isLeaf == 0)
+        {
+            const LightTreeNode firstChild = g_LightTree_Nodes[node.index];
+            const LightTreeNode secondChild = g_LightTree_Nodes[node.index + 1];
+            const float firstImportance = importance(firstChild, position, normal);
+            const float total = firstImportance + importance(secondChild, position, normal);
+            if (total <= 0.0f)
+            {
+                return 0;
+            }
+            const float firstProbability = firstImportance / total;
+            if (u < firstProbability)
+            {
+                node = firstChild;
+                u = min(u / firstProbability, 0.99999994f);
+                pdf *= firstProbability;
+            }
+            else
+            {
+                node = secondChild;
+                u = min((u - firstProbability) / (1.0f - firstProbability), 0.99999994f);
+                pdf *= 1.0f - firstProbability;
+            }
+        }
+        lightPDF = pdf;
+        return node.index;
+    }
+
+    /**
+     * Calculate the PDF of sampling a given light from the light tree.
+     * @param lightID  The index of the given light.
+     * @param position The position on the surface currently being shaded.
+     * @param normal   Shading normal vector at current position.
+     * @return The calculated PDF with respect to the light.
+     */
+    float sampleTreePDF(uint lightID, float3 position, float3 normal)
+    {
+        const float infiniteProbability = getInfiniteProbability();
+        if (lightID < g_LightTree_InfiniteCount)
+        {
+            return infiniteProbability / (float)g_LightTree_InfiniteCount;
+        }
+
+        // Replay the choices made along the path to the light
+        float pdf = 1.0f - infiniteProbability;
+        const uint2 trail = g_LightTree_BitTrails[lightID];
+        LightTreeNode node = g_LightTree_Nodes[0];
+        if (node.isLeaf != 0 && importance(node, position, normal) <= 0.0f)
+        {
+            return 0.0f;
+        }
+        uint depth = 0;
+        while (node.isLeaf == 0)
+        {
+            const LightTreeNode firstChild = g_LightTree_Nodes[node.index];
+            const LightTreeNode secondChild = g_LightTree_Nodes[node.index + 1];
+            const float firstImportance = importance(firstChild, position, normal);
+            const float total = firstImportance + importance(secondChild, position, normal);
+            if (total <= 0.0f)
+            {
+                return 0.0f;
+            }
+            const float firstProbability = firstImportance / total;
+            const uint bits = depth < 32 ? trail.x : trail.y;
+            if ((bits & (1u << (depth & 31))) == 0)
+            {
+                node = firstChild;
+                pdf *= firstProbability;
+            }
+            else
+            {
+                node = secondChild;
+                pdf *= 1.0f - firstProbability;
+            }
+            ++depth;
+        }
+        return pdf;
+    }
+}
+
+/**
+ * Get a sample light.
+ * @tparam RNG The type of random number sampler to be used.
+ * @param randomNG Random number generator used to sample lights.
+ * @param position Current position on surface.
+ * @param normal   Shading normal vector at current position.
+ * @param lightPDF (Out) The PDF for the calculated sample (is equal to zero if no valid samples could be found).
+ * @return The index of the new light sample
+ */
+template<typename RNG>
+uint sampleLights(inout RNG randomNG, float3 position, float3 normal, out float lightPDF)
+{
+    uint totalLights = getNumberLights();
+
+    // Return invalid sample if there are no lights
+    if (totalLights == 0)
+    {
+        lightPDF = 0.0f;
+        return 0;
+    }
+
+    // Fall back to uniform sampling while the tree is being built
+    if (g_LightTree_NodeCount == 0 && g_LightTree_InfiniteCount == 0)
+    {
+        lightPDF = 1.0f / (float)totalLights;
+        return randomNG.randInt(totalLights);
+    }
+    return LightSamplerTree::sampleTree(randomNG.rand(), position, normal, lightPDF);
+}
+
+/**
+ * Calculate the PDF of sampling a given light.
+ * @tparam RNG The type of random number sampler to be used.
+ * @param randomNG Random number generator used to sample lights.
+ * @param lightID  The index of the given light.
+ * @param position The position on the surface currently being shaded.
+ * @param normal   Shading normal vector at current position.
+ * @return The calculated PDF with respect to the light.
+ */
+template<typename RNG>
+float sampleLightsPDF(inout RNG randomNG, uint lightID, float3 position, float3 normal)
+{
+    if (g_LightTree_NodeCount == 0 && g_LightTree_InfiniteCount == 0)
+    {
+        return 1.0f / (float)getNumberLights();
+    }
+    return LightSamplerTree::sampleTreePDF(lightID, position, normal);
+}
+
+#ifdef LIGHT_SAMPLER_ENABLE_RESERVOIR
+/**
+ * Sample multiple lights into a reservoir.
+ * @tparam numSampledLights Number of lights to sample.
+ * @tparam RNG The type of random number sampler to be used.
+ * @param randomNG      Random number generator used to sample lights.
+ * @param position      Current position on surface.
+ * @param normal        Shading normal vector at current position.
+ * @param viewDirection View direction vector at current position.
+ * @param material      Material for current surface position.
+ * @return Reservoir containing combined samples.
+ */
+template<uint numSampledLights, typename RNG>
+Reservoir sampleLightsList(inout RNG randomNG, float3 position, float3 normal, float3 viewDirection, MaterialBRDF material)
+{
+    // Return invalid sample if there are no lights
+    if (numSampledLights == 0 || getNumberLights() == 0)
+    {
+        return MakeReservoir();
+    }
+
+    // Create reservoir updater
+    ReservoirUpdater updater = MakeReservoirUpdater();
+
+    // Loop through until we have the requested number of lights
+    for (uint lightsAdded = 0; lightsAdded < numSampledLights; ++lightsAdded)
+    {
+        // Choose a light to sample from
+        float lightPDF;
+        const uint lightIndex = sampleLights(randomNG, position, normal, lightPDF);
+        if (lightPDF == 0.0f)
+        {
+            continue;
+        }
+
+        // Add the light sample to the reservoir
+        updateReservoir(updater, randomNG, lightIndex, lightPDF, material, position, normal, viewDirection, numSampledLights);
+    }
+
+    // Get finalised reservoir for return
+    return updater.reservoir;
+}
+
+/**
+ * Sample multiple lights into a reservoir using cone angle.
+ * @tparam numSampledLights Number of lights to sample.
+ * @tparam RNG The type of random number sampler to be used.
+ * @param randomNG      Random number generator used to sample lights.
+ * @param position      Current position on surface.
+ * @param normal        Shading normal vector at current position.
+ * @param viewDirection View direction vector at current position.
+ * @param solidAngle    Solid angle around view direction of visible ray cone.
+ * @param material      Material for current surface position.
+ * @return Reservoir containing combined samples.
+ */
+template<uint numSampledLights, typename RNG>
+Reservoir sampleLightsListCone(inout RNG randomNG, float3 position, float3 normal, float3 viewDirection, float solidAngle, MaterialBRDF material)
+{
+    // Return invalid sample if there are no lights
+    if (numSampledLights == 0 || getNumberLights() == 0)
+    {
+        return MakeReservoir();
+    }
+
+    // Create reservoir updater
+    ReservoirUpdater updater = MakeReservoirUpdater();
+
+    // Loop through until we have the requested number of lights
+    for (uint lightsAdded = 0; lightsAdded < numSampledLights; ++lightsAdded)
+    {
+        // Choose a light to sample from
+        float lightPDF;
+        const uint lightIndex = sampleLights(randomNG, position, normal, lightPDF);
+        if (lightPDF == 0.0f)
+        {
+            continue;
+        }
+
+        // Add the light sample to the reservoir
+        updateReservoirCone(updater, randomNG, lightIndex, lightPDF, material, position, normal, viewDirection, solidAngle, numSampledLights);
+    }
+
+    // Get finalised reservoir for return
+    return updater.reservoir;
+}
+
+/**
+ * Calculate the PDF of sampling a given light using one of the reservoir list sampling functions.
+ * @tparam numSampledLights Number of lights sampled.
+ * @param randomNG Random number generator used to sample lights.
+ * @param lightID  The index of the given light.
+ * @param position The position on the surface currently being shaded.
+ * @param normal   Shading normal vector at current position.
+ * @return The calculated PDF with respect to the light.
+ */
+template<uint numSampledLights, typename RNG>
+float sampleLightsListPDF(inout RNG randomNG, uint lightID, float3 position, float3 normal)
+{
+    return sampleLightsPDF(randomNG, lightID, position, normal);
+}
+#endif
+
+#endif // LIGHT_SAMPLER_TREE_HLSL
@@ -0,0 +1,43 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#ifndef LIGHT_SAMPLER_TREE_SHARED_H
+#define LIGHT_SAMPLER_TREE_SHARED_H
+
+#include "gpu_shared.h"
+
+/**
+ * A node of the light tree.
+ * Each node bounds the position, emitted power and emission directions of all lights below it. Emission
+ * directions are bounded by a cone around an axis (theta_o) plus a falloff angle past the cone edge
+ * (theta_e) beyond which no light is emitted.
+ */
+struct LightTreeNode
+{
+    float4 boundsMin; /*< .xyz = minimum of the world space bounds, .w = bound on the emitted power */
+    float4 boundsMax; /*< .xyz = maximum of the world space bounds, .w = cosine of theta_e */
+    float4 axis;      /*< .xyz = orientation cone axis, .w = cosine of theta_o */
+    uint   index;     /*< Light index for leaves, index of the first child otherwise (2nd child follows it) */
+    uint   isLeaf;    /*< Non-zero if the node is a leaf containing a single light */
+    uint2  padding;
+};
+
+#endif
@@ -0,0 +1,700 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "light_tree.h"
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace Capsaicin
+{
+namespace
+{
+using LightBounds = LightTree::LightBounds;
+
+constexpr uint32_t BinCount = 12;
+// Ranges with at least this many lights are binned in parallel
+constexpr uint32_t ParallelBinSize = 64 * 1024;
+// Ranges with fewer lights than this are built as independent subtrees in parallel
+constexpr uint32_t ParallelSubtreeSize = 16 * 1024;
+
+float Luminance(float3 const &rgb) noexcept
+{
+    return dot(rgb, float3(0.2126F, 0.7152F, 0.0722F));
+}
+
+float SafeSqrt(float const value) noexcept
+{
+    return glm::sqrt(glm::max(value, 0.0F));
+}
+
+/** Cosine of the difference of two angles, clamped to 1 if the difference is negative. */
+float CosSubClamped(float const sinA, float const cosA, float const sinB, float const cosB) noexcept
+{
+    return cosA > cosB ? 1.0F : cosA * cosB + sinA * sinB;
+}
+
+/** Sine of the difference of two angles, clamped to 0 if the difference is negative. */
+float SinSubClamped(float const sinA, float const cosA, float const sinB, float const cosB) noexcept
+{
+    return cosA > cosB ? 0.0F : sinA * cosB - cosA * sinB;
+}
+
+/**
+ * Merge two direction cones into the smallest cone bounding both.
+ * @param [in,out] axis     Axis of the 1st cone, replaced with the merged axis.
+ * @param [in,out] cosTheta Cosine of the 1st cone angle, replaced with the merged angle.
+ * @param otherAxis         Axis of the 2nd cone.
+ * @param otherCosTheta     Cosine of the 2nd cone angle.
+ */
+void MergeCones(float3 &axis, float &cosTheta, float3 const &otherAxis, float const otherCosTheta) noexcept
+{
+    // Cones covering the entire sphere are common (area and point lights) so are handled without any trig
+    if (cosTheta <= -1.0F)
+    {
+        return;
+    }
+    if (otherCosTheta <= -1.0F)
+    {
+        axis     = otherAxis;
+        cosTheta = -1.0F;
+        return;
+    }
+    float const theta      = glm::acos(glm::clamp(cosTheta, -1.0F, 1.0F));
+    float const otherTheta = glm::acos(glm::clamp(otherCosTheta, -1.0F, 1.0F));
+    float const thetaD     = glm::acos(glm::clamp(dot(axis, otherAxis), -1.0F, 1.0F));
+    if (glm::min(thetaD + otherTheta, glm::pi<float>()) <= theta)
+    {
+        return;
+    }
+    if (glm::min(thetaD + theta, glm::pi<float>()) <= otherTheta)
+    {
+        axis     = otherAxis;
+        cosTheta = otherCosTheta;
+        return;
+    }
+    // Rotate the 1st axis towards the 2nd so that the new cone just contains both
+    float const  thetaO = 0.5F * (theta + thetaD + otherTheta);
+    float3 const rotationAxis = cross(axis, otherAxis);
+    if (thetaO >= glm::pi<float>() || dot(rotationAxis, rotationAxis) == 0.0F)
+    {
+        cosTheta = -1.0F;
+        return;
+    }
+    float3 const k      = normalize(rotationAxis);
+    float const  thetaR = thetaO - theta;
+    axis     = normalize(axis * glm::cos(thetaR) + cross(k, axis) * glm::sin(thetaR));
+    cosTheta = glm::cos(thetaO);
+}
+
+/**
+ * Evaluate the surface area orientation heuristic (SAOH) cost of a set of lights.
+ * @param bounds     The light bounds.
+ * @param nodeExtent Extent of the spatial bounds of the node being split.
+ * @param axis       The split axis, used to discourage splitting thin nodes along their shortest axis.
+ * @return The cost.
+ */
+float EvaluateCost(LightBounds const &bounds, float3 const &nodeExtent, uint32_t const axis) noexcept
+{
+    if (bounds.power <= 0.0F)
+    {
+        return 0.0F;
+    }
+    float const thetaO    = glm::acos(glm::clamp(bounds.cosThetaO, -1.0F, 1.0F));
+    float const thetaE    = glm::acos(glm::clamp(bounds.cosThetaE, -1.0F, 1.0F));
+    float const thetaW    = glm::min(thetaO + thetaE, glm::pi<float>());
+    float const sinThetaO = SafeSqrt(1.0F - bounds.cosThetaO * bounds.cosThetaO);
+    // Solid angle measure of the emission cone including falloff
+    float const orientation =
+        2.0F * glm::pi<float>() * (1.0F - bounds.cosThetaO)
+        + 0.5F * glm::pi<float>()
+              * (2.0F * thetaW * sinThetaO - glm::cos(thetaO - 2.0F * thetaW) - 2.0F * thetaO * sinThetaO
+                  + bounds.cosThetaO);
+    float3 const extent      = bounds.boundsMax - bounds.boundsMin;
+    float const  surfaceArea = 2.0F * (extent.x * extent.y + extent.x * extent.z + extent.y * extent.z);
+    float const  regulariser = glm::max(nodeExtent.x, glm::max(nodeExtent.y, nodeExtent.z))
+                            / glm::max(nodeExtent[axis], std::numeric_limits<float>::min());
+    return bounds.power * orientation * regulariser * surfaceArea;
+}
+
+struct RangeBounds
+{
+    float3 boundsMin         = float3(std::numeric_limits<float>::max());
+    float3 boundsMax         = float3(std::numeric_limits<float>::lowest());
+    float3 centroidBoundsMin = float3(std::numeric_limits<float>::max());
+    float3 centroidBoundsMax = float3(std::numeric_limits<float>::lowest());
+
+    void grow(RangeBounds const &other) noexcept
+    {
+        boundsMin         = glm::min(boundsMin, other.boundsMin);
+        boundsMax         = glm::max(boundsMax, other.boundsMax);
+        centroidBoundsMin = glm::min(centroidBoundsMin, other.centroidBoundsMin);
+        centroidBoundsMax = glm::max(centroidBoundsMax, other.centroidBoundsMax);
+    }
+};
+
+using Bins = std::array<LightBounds, 3 * BinCount>;
+
+/** Shared state used while building a tree. */
+struct BuildContext
+{
+    std::vector<LightBounds> const &bounds;    /**< Bounds of each light */
+    std::vector<float3>             centroids; /**< Centroid of each light */
+    uint32_t                       *indices;   /**< Light indices, partitioned as the tree is built */
+};
+
+RangeBounds ComputeBounds(BuildContext const &context, uint32_t const first, uint32_t const count) noexcept
+{
+    auto const reduce = [&context](uint32_t const *start, uint32_t const *end, RangeBounds result) {
+        for (uint32_t const *index = start; index < end; ++index)
+        {
+            result.boundsMin         = glm::min(result.boundsMin, context.bounds[*index].boundsMin);
+            result.boundsMax         = glm::max(result.boundsMax, context.bounds[*index].boundsMax);
+            result.centroidBoundsMin = glm::min(result.centroidBoundsMin, context.centroids[*index]);
+            result.centroidBoundsMax = glm::max(result.centroidBoundsMax, context.centroids[*index]);
+        }
+        return result;
+    };
+    if (count < ParallelBinSize)
+    {
+        return reduce(context.indices + first, context.indices + first + count, RangeBounds());
+    }
+    return ParallelReduce(context.indices + first, count, RangeBounds(), reduce,
+        [](RangeBounds left, RangeBounds const &right) {
+            left.grow(right);
+            return left;
+        });
+}
+
+uint32_t GetBin(float3 const &centroid, RangeBounds const &range, uint32_t const axis) noexcept
+{
+    float const extent = range.centroidBoundsMax[axis] - range.centroidBoundsMin[axis];
+    auto const  bin    = static_cast<uint32_t>(
+        (centroid[axis] - range.centroidBoundsMin[axis]) * (static_cast<float>(BinCount) / extent));
+    return glm::min(bin, BinCount - 1);
+}
+
+/**
+ * Split a range of lights into two children.
+ * @return The number of lights in the 1st child.
+ */
+uint32_t SplitRange(BuildContext &context, uint32_t const first, uint32_t const count, uint32_t const depth,
+    RangeBounds const &range) noexcept
+{
+    uint32_t *const begin          = context.indices + first;
+    float3 const    centroidExtent = range.centroidBoundsMax - range.centroidBoundsMin;
+    uint32_t const  largestAxis    = centroidExtent.x > centroidExtent.y
+                                       ? (centroidExtent.x > centroidExtent.z ? 0 : 2)
+                                       : (centroidExtent.y > centroidExtent.z ? 1 : 2);
+    if (depth >= LightTree::MaxSAOHDepth || centroidExtent[largestAxis] <= 0.0F)
+    {
+        // Median splits bound the remaining depth by log2 of the light count
+        std::nth_element(begin, begin + count / 2, begin + count,
+            [&context, largestAxis](uint32_t const left, uint32_t const right) {
+                return context.centroids[left][largestAxis] < context.centroids[right][largestAxis];
+            });
+        return count / 2;
+    }
+
+    auto const reduce = [&context, &range, &centroidExtent](
+                            uint32_t const *start, uint32_t const *end, Bins bins) {
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            if (centroidExtent[axis] <= 0.0F)
+            {
+                continue;
+            }
+            for (uint32_t const *index = start; index < end; ++index)
+            {
+                uint32_t const bin = GetBin(context.centroids[*index], range, axis);
+                bins[axis * BinCount + bin].grow(context.bounds[*index]);
+            }
+        }
+        return bins;
+    };
+    Bins bins;
+    if (count < ParallelBinSize)
+    {
+        bins = reduce(begin, begin + count, Bins());
+    }
+    else
+    {
+        bins = ParallelReduce(begin, count, Bins(), reduce, [](Bins left, Bins const &right) {
+            for (uint32_t i = 0; i < left.size(); ++i)
+            {
+                left[i].grow(right[i]);
+            }
+            return left;
+        });
+    }
+
+    // Sweep the bins of each axis to find the split plane with the lowest cost
+    float3 const nodeExtent = range.boundsMax - range.boundsMin;
+    float        bestCost   = std::numeric_limits<float>::max();
+    uint32_t     bestAxis   = largestAxis;
+    uint32_t     bestBin    = BinCount / 2;
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+        if (centroidExtent[axis] <= 0.0F)
+        {
+            continue;
+        }
+        std::array<float, BinCount - 1> belowCost {};
+        LightBounds                     below;
+        for (uint32_t i = 0; i < BinCount - 1; ++i)
+        {
+            below.grow(bins[axis * BinCount + i]);
+            belowCost[i] = EvaluateCost(below, nodeExtent, axis);
+        }
+        LightBounds above;
+        for (uint32_t i = BinCount - 1; i > 0; --i)
+        {
+            above.grow(bins[axis * BinCount + i]);
+            if (float const cost = belowCost[i - 1] + EvaluateCost(above, nodeExtent, axis); cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin  = i;
+            }
+        }
+    }
+    uint32_t const *middle = std::partition(begin, begin + count, [&](uint32_t const index) {
+        return GetBin(context.centroids[index], range, bestAxis) < bestBin;
+    });
+    auto const firstCount = static_cast<uint32_t>(middle - begin);
+    // Bins may be empty on one side if all lights fell into a single bin
+    return firstCount == 0 || firstCount == count ? count / 2 : firstCount;
+}
+
+/**
+ * Build a subtree serially.
+ * @param nodes The node list, nodes[rootIndex] must already exist.
+ */
+void BuildSubtree(BuildContext &context, std::vector<LightTreeNode> &nodes, uint32_t const rootIndex,
+    uint32_t const first, uint32_t const count, uint32_t const depth) noexcept
+{
+    struct Task
+    {
+        uint32_t node;
+        uint32_t first;
+        uint32_t count;
+        uint32_t depth;
+    };
+    std::vector<Task> tasks = {
+        {rootIndex, first, count, depth}
+    };
+    while (!tasks.empty())
+    {
+        Task const task = tasks.back();
+        tasks.pop_back();
+        if (task.count == 1)
+        {
+            nodes[task.node].index  = context.indices[task.first];
+            nodes[task.node].isLeaf = 1;
+            continue;
+        }
+        uint32_t const firstCount = SplitRange(
+            context, task.first, task.count, task.depth, ComputeBounds(context, task.first, task.count));
+        auto const child        = static_cast<uint32_t>(nodes.size());
+        nodes[task.node].index  = child;
+        nodes[task.node].isLeaf = 0;
+        nodes.resize(nodes.size() + 2);
+        tasks.push_back({child + 1, task.first + firstCount, task.count - firstCount, task.depth + 1});
+        tasks.push_back({child, task.first, firstCount, task.depth + 1});
+    }
+}
+} // namespace
+
+LightTree::LightBounds LightTree::LightBounds::Make(Light light) noexcept
+{
+    LightBounds bounds;
+    switch (light.get_light_type())
+    {
+    case kLight_Point:
+        bounds.boundsMin = float3(light.v1);
+        bounds.boundsMax = float3(light.v1);
+        bounds.power     = 4.0F * glm::pi<float>() * Luminance(float3(light.radiance));
+        bounds.cosThetaO = -1.0F;
+        bounds.cosThetaE = 0.0F;
+        break;
+    case kLight_Spot:
+    {
+        // Full intensity is emitted within the inner cone, falling off until the outer cone
+        float const cosOuter = -light.v3.y / light.v3.x;
+        float const cosInner = glm::min(cosOuter + 1.0F / light.v3.x, 1.0F);
+        bounds.boundsMin     = float3(light.v1);
+        bounds.boundsMax     = float3(light.v1);
+        bounds.axis          = -float3(light.v2);
+        bounds.power         = 4.0F * glm::pi<float>() * Luminance(float3(light.radiance));
+        bounds.cosThetaO     = cosInner;
+        bounds.cosThetaE     = glm::cos(glm::acos(cosOuter) - glm::acos(cosInner));
+        break;
+    }
+    case kLight_Area:
+    {
+        float3 const v1(light.v1);
+        float3 const v2(light.v2);
+        float3 const v3(light.v3);
+        float3 const normal = cross(v2 - v1, v3 - v1);
+        float const  length = glm::length(normal);
+        bounds.boundsMin    = glm::min(v1, glm::min(v2, v3));
+        bounds.boundsMax    = glm::max(v1, glm::max(v2, v3));
+        bounds.axis         = length > 0.0F ? normal / length : float3(0.0F, 0.0F, 1.0F);
+        // Area lights are double-sided, so they emit in all directions
+        bounds.power        = 2.0F * glm::pi<float>() * Luminance(float3(light.radiance)) * 0.5F * length;
+        bounds.cosThetaO    = -1.0F;
+        bounds.cosThetaE    = 0.0F;
+        break;
+    }
+    default:
+        // Infinite lights are not bounded
+        break;
+    }
+    return bounds;
+}
+
+void LightTree::LightBounds::grow(LightBounds const &other) noexcept
+{
+    if (other.power <= 0.0F)
+    {
+        return;
+    }
+    if (power <= 0.0F)
+    {
+        *this = other;
+        return;
+    }
+    boundsMin = glm::min(boundsMin, other.boundsMin);
+    boundsMax = glm::max(boundsMax, other.boundsMax);
+    MergeCones(axis, cosThetaO, other.axis, other.cosThetaO);
+    cosThetaE = glm::min(cosThetaE, other.cosThetaE);
+    power += other.power;
+}
+
+float LightTree::LightBounds::importance(float3 const &position, float3 const &normal) const noexcept
+{
+    if (power <= 0.0F)
+    {
+        return 0.0F;
+    }
+    // Distance to the bounds is clamped so that receivers close to or inside the bounds are not overweighted
+    float3 const center      = 0.5F * (boundsMin + boundsMax);
+    float3 const toReceiver  = position - center;
+    float const  centerDist2 = dot(toReceiver, toReceiver);
+    float const  distanceSqr =
+        glm::max(glm::max(centerDist2, 0.5F * glm::length(boundsMax - boundsMin)), 1e-4F);
+    float3 const direction   = centerDist2 > 0.0F ? toReceiver * glm::inversesqrt(centerDist2) : axis;
+
+    // Angle subtended by the bounds as seen from the receiver
+    float        cosThetaB = -1.0F;
+    float3 const radius    = boundsMax - center;
+    if (float const radiusSqr = dot(radius, radius);
+        centerDist2 >= radiusSqr && any(lessThan(position, boundsMin) || greaterThan(position, boundsMax)))
+    {
+        cosThetaB = SafeSqrt(1.0F - radiusSqr / centerDist2);
+    }
+    float const sinThetaB = SafeSqrt(1.0F - cosThetaB * cosThetaB);
+
+    // Minimum angle between the emission cone and the direction to the receiver
+    float const cosThetaW = dot(axis, direction);
+    float const sinThetaW = SafeSqrt(1.0F - cosThetaW * cosThetaW);
+    float const sinThetaO = SafeSqrt(1.0F - cosThetaO * cosThetaO);
+    float const cosThetaX = CosSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+    float const sinThetaX = SinSubClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+    float const cosThetaP = CosSubClamped(sinThetaX, cosThetaX, sinThetaB, cosThetaB);
+    if (cosThetaP <= cosThetaE)
+    {
+        return 0.0F;
+    }
+    float importance = power * cosThetaP / distanceSqr;
+
+    // Minimum angle between the receiver normal and the bounds, surfaces may be lit from either side
+    if (normal != float3(0.0F))
+    {
+        float const cosThetaI  = glm::abs(dot(direction, normal));
+        float const sinThetaI  = SafeSqrt(1.0F - cosThetaI * cosThetaI);
+        importance            *= CosSubClamped(sinThetaI, cosThetaI, sinThetaB, cosThetaB);
+    }
+    return glm::max(importance, 0.0F);
+}
+
+void LightTree::build(Light const *lights, uint32_t const lightCount, uint32_t const infiniteCount) noexcept
+{
+    clear();
+    this->lightCount    = lightCount;
+    this->infiniteCount = glm::min(infiniteCount, lightCount);
+    bitTrails.resize(lightCount, 0);
+    uint32_t const count = lightCount - this->infiniteCount;
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::vector<LightBounds> bounds(lightCount);
+    std::vector<uint32_t>    indices(count);
+    std::iota(indices.begin(), indices.end(), this->infiniteCount);
+    BuildContext context = {bounds, std::vector<float3>(lightCount), indices.data()};
+    ParallelFor(this->infiniteCount, lightCount, [&](uint32_t const i) {
+        bounds[i]            = LightBounds::Make(lights[i]);
+        context.centroids[i] = 0.5F * (bounds[i].boundsMin + bounds[i].boundsMax);
+    });
+
+    // Split the top of the tree until the remaining ranges are small enough to be built independently
+    struct Subtree
+    {
+        uint32_t                   node;
+        uint32_t                   first;
+        uint32_t                   count;
+        uint32_t                   depth;
+        std::vector<LightTreeNode> nodes;
+    };
+    std::vector<Subtree> subtrees;
+    std::vector<Subtree> pending = {
+        {0, 0, count, 0, {}}
+    };
+    nodes.reserve(2 * static_cast<size_t>(count) - 1);
+    nodes.resize(1);
+    while (!pending.empty())
+    {
+        Subtree task = std::move(pending.back());
+        pending.pop_back();
+        if (task.count < ParallelSubtreeSize)
+        {
+            subtrees.push_back(std::move(task));
+            continue;
+        }
+        uint32_t const firstCount = SplitRange(
+            context, task.first, task.count, task.depth, ComputeBounds(context, task.first, task.count));
+        auto const child        = static_cast<uint32_t>(nodes.size());
+        nodes[task.node].index  = child;
+        nodes[task.node].isLeaf = 0;
+        nodes.resize(nodes.size() + 2);
+        pending.push_back({child + 1, task.first + firstCount, task.count - firstCount, task.depth + 1, {}});
+        pending.push_back({child, task.first, firstCount, task.depth + 1, {}});
+    }
+    ParallelFor(0U, static_cast<uint32_t>(subtrees.size()), [&](uint32_t const i) {
+        Subtree &subtree = subtrees[i];
+        subtree.nodes.resize(1);
+        BuildSubtree(context, subtree.nodes, 0, subtree.first, subtree.count, subtree.depth);
+    });
+
+    // Append the subtrees to the node list, the subtree root replaces its placeholder node
+    for (auto const &subtree : subtrees)
+    {
+        auto const base = static_cast<uint32_t>(nodes.size()) - 1;
+        for (uint32_t i = 0; i < subtree.nodes.size(); ++i)
+        {
+            LightTreeNode node = subtree.nodes[i];
+            if (node.isLeaf == 0)
+            {
+                node.index += base;
+            }
+            if (i == 0)
+            {
+                nodes[subtree.node] = node;
+            }
+            else
+            {
+                nodes.push_back(node);
+            }
+        }
+    }
+
+    // Record the path to each light
+    leafNodes.resize(lightCount, 0);
+    struct Visit
+    {
+        uint32_t node;
+        uint64_t trail;
+        uint32_t depth;
+    };
+    std::vector<Visit> visits = {
+        {0, 0, 0}
+    };
+    while (!visits.empty())
+    {
+        Visit const visit = visits.back();
+        visits.pop_back();
+        if (LightTreeNode const &node = nodes[visit.node]; node.isLeaf != 0)
+        {
+            bitTrails[node.index] = visit.trail;
+            leafNodes[node.index] = visit.node;
+        }
+        else
+        {
+            visits.push_back({node.index, visit.trail, visit.depth + 1});
+            visits.push_back({node.index + 1, visit.trail | (1ULL << visit.depth), visit.depth + 1});
+        }
+    }
+
+    nodeBounds.resize(nodes.size());
+    for (uint32_t i = this->infiniteCount; i < lightCount; ++i)
+    {
+        nodeBounds[leafNodes[i]] = bounds[i];
+    }
+    updateNodes();
+}
+
+void LightTree::refit(Light const *lights) noexcept
+{
+    ParallelFor(infiniteCount, lightCount,
+        [&](uint32_t const i) { nodeBounds[leafNodes[i]] = LightBounds::Make(lights[i]); });
+    updateNodes();
+}
+
+void LightTree::clear() noexcept
+{
+    nodes.clear();
+    nodeBounds.clear();
+    leafNodes.clear();
+    bitTrails.clear();
+    lightCount    = 0;
+    infiniteCount = 0;
+}
+
+uint32_t LightTree::sample(
+    float u, float3 const &position, float3 const &normal, float &lightPMF) const noexcept
+{
+    lightPMF = 0.0F;
+    if (lightCount == 0)
+    {
+        return 0;
+    }
+    float const infiniteProbability = getInfiniteProbability();
+    if (u < infiniteProbability)
+    {
+        lightPMF = infiniteProbability / static_cast<float>(infiniteCount);
+        return glm::min(
+            static_cast<uint32_t>(u / infiniteProbability * static_cast<float>(infiniteCount)),
+            infiniteCount - 1);
+    }
+    u = glm::min((u - infiniteProbability) / (1.0F - infiniteProbability), 0.99999994F);
+
+    float    pmf  = 1.0F - infiniteProbability;
+    uint32_t node = 0;
+    while (nodes[node].isLeaf == 0)
+    {
+        uint32_t const child           = nodes[node].index;
+        float const    firstImportance = nodeBounds[child].importance(position, normal);
+        float const    total           = firstImportance + nodeBounds[child + 1].importance(position, normal);
+        if (total <= 0.0F)
+        {
+            return 0;
+        }
+        float const firstProbability = firstImportance / total;
+        if (u < firstProbability)
+        {
+            node = child;
+            u    = glm::min(u / firstProbability, 0.99999994F);
+            pmf *= firstProbability;
+        }
+        else
+        {
+            node = child + 1;
+            u    = glm::min((u - firstProbability) / (1.0F - firstProbability), 0.99999994F);
+            pmf *= 1.0F - firstProbability;
+        }
+    }
+    if (node == 0 && nodeBounds[0].importance(position, normal) <= 0.0F)
+    {
+        return 0;
+    }
+    lightPMF = pmf;
+    return nodes[node].index;
+}
+
+float LightTree::pmf(uint32_t const light, float3 const &position, float3 const &normal) const noexcept
+{
+    if (light >= lightCount)
+    {
+        return 0.0F;
+    }
+    float const infiniteProbability = getInfiniteProbability();
+    if (light < infiniteCount)
+    {
+        return infiniteProbability / static_cast<float>(infiniteCount);
+    }
+
+    float    pmf   = 1.0F - infiniteProbability;
+    uint64_t trail = bitTrails[light];
+    uint32_t node  = 0;
+    while (nodes[node].isLeaf == 0)
+    {
+        uint32_t const child           = nodes[node].index;
+        float const    firstImportance = nodeBounds[child].importance(position, normal);
+        float const    total           = firstImportance + nodeBounds[child + 1].importance(position, normal);
+        if (total <= 0.0F)
+        {
+            return 0.0F;
+        }
+        float const firstProbability = firstImportance / total;
+        if ((trail & 1) == 0)
+        {
+            node  = child;
+            pmf  *= firstProbability;
+        }
+        else
+        {
+            node  = child + 1;
+            pmf  *= 1.0F - firstProbability;
+        }
+        trail >>= 1;
+    }
+    if (node == 0 && nodeBounds[0].importance(position, normal) <= 0.0F)
+    {
+        return 0.0F;
+    }
+    return pmf;
+}
+
+float LightTree::getInfiniteProbability() const noexcept
+{
+    // Each infinite light is given the same probability as the whole tree
+    uint32_t const treeCount = nodes.empty() ? 0 : 1;
+    return infiniteCount == 0
+             ? 0.0F
+             : static_cast<float>(infiniteCount) / static_cast<float>(infiniteCount + treeCount);
+}
+
+void LightTree::updateNodes() noexcept
+{
+    // Children are always stored after their parent so a reverse pass visits them first
+    for (auto node = static_cast<uint32_t>(nodes.size()); node-- > 0;)
+    {
+        if (nodes[node].isLeaf == 0)
+        {
+            nodeBounds[node] = nodeBounds[nodes[node].index];
+            nodeBounds[node].grow(nodeBounds[nodes[node].index + 1]);
+        }
+    }
+    ParallelFor(0U, static_cast<uint32_t>(nodes.size()), [&](uint32_t const i) {
+        LightBounds const &bounds = nodeBounds[i];
+        LightTreeNode     &node   = nodes[i];
+        node.boundsMin            = float4(bounds.boundsMin, bounds.power);
+        node.boundsMax            = float4(bounds.boundsMax, bounds.cosThetaE);
+        node.axis                 = float4(bounds.axis, bounds.cosThetaO);
+        node.padding              = uint2(0);
+    });
+}
+} // namespace Capsaicin
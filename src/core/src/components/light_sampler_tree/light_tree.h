@@ -0,0 +1,147 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "light_sampler_tree_shared.h"
+#include "lights/lights_shared.h"
+
+#include <limits>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * A bounding volume hierarchy over a light list used to importance sample lights (light tree).
+ * Each node bounds the position, power and emission directions of the lights below it, allowing the
+ * importance of a whole subtree to be estimated for a given receiver. Sampling descends from the root
+ * choosing children proportionally to their importance, the probability of any light can be recovered by
+ * replaying the same choices along the path recorded in its bit trail.
+ * Infinite lights (environment and directional) cannot be bounded so must be at the start of the light list,
+ * they are skipped by the tree and instead sampled uniformly with the same probability as the whole tree.
+ * This class is a CPU only reference of the sampling done in light_sampler_tree.hlsl.
+ */
+class LightTree
+{
+public:
+    /** Bounds of the lights contained within a subtree. */
+    struct LightBounds
+    {
+        float3 boundsMin = float3(std::numeric_limits<float>::max());
+        float3 boundsMax = float3(std::numeric_limits<float>::lowest());
+        float3 axis      = float3(0.0F, 0.0F, 1.0F); /**< Orientation cone axis */
+        float  power     = 0.0F;                     /**< Bound on the emitted power */
+        float  cosThetaO = 1.0F;                     /**< Cosine of the orientation cone angle */
+        float  cosThetaE = 1.0F;                     /**< Cosine of the emission falloff angle */
+
+        /**
+         * Make the bounds of a single light.
+         * @param light The light to bound, must not be an infinite light.
+         * @return The light bounds.
+         */
+        static LightBounds Make(Light light) noexcept;
+
+        /**
+         * Merge another set of bounds into this one.
+         * @param other The bounds to merge.
+         */
+        void grow(LightBounds const &other) noexcept;
+
+        /**
+         * Estimate the contribution of the bounded lights to a receiver.
+         * @param position Position of the receiver.
+         * @param normal   Shading normal at the receiver.
+         * @return The importance (zero if none of the lights can reach the receiver).
+         */
+        [[nodiscard]] float importance(float3 const &position, float3 const &normal) const noexcept;
+    };
+
+    /** Maximum depth before the build switches to median splits, keeps bit trails within 64 bits. */
+    static constexpr uint32_t MaxSAOHDepth = 32;
+
+    /**
+     * Build the tree over a light list.
+     * @param lights        The light list.
+     * @param lightCount    Number of lights in the list.
+     * @param infiniteCount Number of infinite lights at the start of the list.
+     */
+    void build(Light const *lights, uint32_t lightCount, uint32_t infiniteCount) noexcept;
+
+    /**
+     * Update the bounds of the existing tree to new light positions, the tree topology is retained.
+     * @param lights The light list, must contain the same lights in the same order as used to build.
+     */
+    void refit(Light const *lights) noexcept;
+
+    /** Release all nodes. */
+    void clear() noexcept;
+
+    /**
+     * Sample a light, infinite lights are included.
+     * @param u              Uniform random number in the range [0, 1).
+     * @param position       Position of the receiver.
+     * @param normal         Shading normal at the receiver.
+     * @param [out] lightPMF The probability of selecting the returned light (zero if no light could be
+     *                       sampled).
+     * @return The index of the sampled light.
+     */
+    [[nodiscard]] uint32_t sample(
+        float u, float3 const &position, float3 const &normal, float &lightPMF) const noexcept;
+
+    /**
+     * Calculate the probability of sampling a given light.
+     * @param light    Index of the light.
+     * @param position Position of the receiver.
+     * @param normal   Shading normal at the receiver.
+     * @return The probability of the light being returned by sample().
+     */
+    [[nodiscard]] float pmf(uint32_t light, float3 const &position, float3 const &normal) const noexcept;
+
+    [[nodiscard]] std::vector<LightTreeNode> const &getNodes() const noexcept { return nodes; }
+
+    /**
+     * Gets the path from the root to each light, bit N is set if the 2nd child is taken at depth N.
+     * @return The bit trail of each light in the light list (zero for infinite lights).
+     */
+    [[nodiscard]] std::vector<uint64_t> const &getBitTrails() const noexcept { return bitTrails; }
+
+    [[nodiscard]] uint32_t getLightCount() const noexcept { return lightCount; }
+
+    [[nodiscard]] uint32_t getInfiniteCount() const noexcept { return infiniteCount; }
+
+private:
+    /**
+     * Gets the probability of sampling an infinite light instead of the tree.
+     * @return The probability.
+     */
+    [[nodiscard]] float getInfiniteProbability() const noexcept;
+
+    /** Write the GPU node data from the node bounds. */
+    void updateNodes() noexcept;
+
+    std::vector<LightTreeNode> nodes;             /**< Nodes in GPU layout, root first */
+    std::vector<LightBounds>   nodeBounds;        /**< Bounds of each node */
+    std::vector<uint32_t>      leafNodes;         /**< Leaf node index of each tree light */
+    std::vector<uint64_t>      bitTrails;         /**< Path to each light */
+    uint32_t                   lightCount    = 0; /**< Number of lights in the list used to build */
+    uint32_t                   infiniteCount = 0; /**< Number of infinite lights skipped by the tree */
+};
+} // namespace Capsaicin
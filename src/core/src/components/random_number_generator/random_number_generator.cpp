@@ -23,7 +23,6 @@ THE SOFTWARE.
 #include "random_number_generator.h"
 
 #include "capsaicin_internal.h"
-#include "components/stratified_sampler/stratified_sampler.h"
 
 #include <random>
 
@@ -60,40 +59,15 @@ RandomNumberGenerator::RenderOptions RandomNumberGenerator::convertOptions(
 bool RandomNumberGenerator::init(CapsaicinInternal const &capsaicin) noexcept
 {
     options = convertOptions(capsaicin.getOptions());
-    if (!capsaicin.hasComponent("StratifiedSampler")
-        || capsaicin.getOption<uint32_t>("stratified_sampler_seed") != options.random_seed
-        || capsaicin.getOption<bool>("stratified_sampler_deterministic") != options.random_deterministic)
+    // Random number generator seeds are generated on the fly from a hash of the input seed and this seed
+    if (options.random_deterministic)
     {
-        auto const     seedDimensions = max(capsaicin.getRenderDimensions(), uint2(1920, 1080));
-        uint64_t const seedBufferSize = static_cast<uint64_t>(seedDimensions.x) * seedDimensions.y;
-
-        vector<uint32_t> seedBufferData;
-        seedBufferData.reserve(seedBufferSize);
-        if (options.random_deterministic)
-        {
-            mt19937 gen(options.random_seed);
-            for (uint32_t i = 0; i < seedBufferSize; ++i)
-            {
-                seedBufferData.push_back(gen());
-            }
-        }
-        else
-        {
-            random_device rd;
-            mt19937       gen(rd());
-            for (uint32_t i = 0; i < seedBufferSize; ++i)
-            {
-                seedBufferData.push_back(gen());
-            }
-        }
-        seedBuffer = gfxCreateBuffer<uint32_t>(
-            gfx_, static_cast<uint32_t>(seedBufferData.size()), seedBufferData.data());
-        seedBuffer.setName("RandomNumberGenerator_SeedBuffer");
+        seed = options.random_seed;
     }
     else
     {
-        // Reuse the stratified sampler seed buffer if it is available and matches our own
-        seedBuffer = {};
+        random_device rd;
+        seed = rd();
     }
     return true;
 }
@@ -101,63 +75,22 @@ bool RandomNumberGenerator::init(CapsaicinInternal const &capsaicin) noexcept
 void RandomNumberGenerator::run(CapsaicinInternal &capsaicin) noexcept
 {
     // Check for option changed
-    auto const optionsNew            = convertOptions(capsaicin.getOptions());
-    bool       usingStratifiedBuffer = !seedBuffer;
-    bool       update                = false;
-    if (usingStratifiedBuffer)
-    {
-        usingStratifiedBuffer =
-            capsaicin.getOption<uint32_t>("stratified_sampler_seed") == optionsNew.random_seed
-            && capsaicin.getOption<bool>("stratified_sampler_deterministic")
-                   == optionsNew.random_deterministic;
-        if (!usingStratifiedBuffer)
-        {
-            init(capsaicin);
-            update = true;
-        }
-    }
-    else
-    {
-        // Check if seed buffer needs to be re-initialised
-        auto const seedDimensions = max(capsaicin.getRenderDimensions(), uint2(1920, 1080));
-        update                    = optionsNew.random_deterministic != options.random_deterministic
-              || (options.random_deterministic && (optionsNew.random_seed != options.random_seed))
-              || (sizeof(uint32_t) * seedDimensions.x * seedDimensions.y > seedBuffer.getSize());
-    }
+    auto const optionsNew = convertOptions(capsaicin.getOptions());
+    bool const update     = optionsNew.random_deterministic != options.random_deterministic
+                    || (options.random_deterministic && (optionsNew.random_seed != options.random_seed));
     options = optionsNew;
 
     if (update)
     {
-        GfxCommandEvent const command_event(gfx_, "InitRandomNumberGenerator");
-
-        gfxDestroyBuffer(gfx_, seedBuffer);
-
         init(capsaicin);
     }
 }
 
-void RandomNumberGenerator::terminate() noexcept
-{
-    gfxDestroyBuffer(gfx_, seedBuffer);
-    seedBuffer = {};
-}
+void RandomNumberGenerator::terminate() noexcept {}
 
 void RandomNumberGenerator::addProgramParameters(
     [[maybe_unused]] CapsaicinInternal const &capsaicin, GfxProgram const &program) const noexcept
 {
-    if (!!seedBuffer)
-    {
-        gfxProgramSetParameter(gfx_, program, "g_RandomSeedBuffer", seedBuffer);
-        gfxProgramSetParameter(gfx_, program, "g_RandomSeedBufferSize",
-            static_cast<uint32_t>(seedBuffer.getSize() / sizeof(uint32_t)));
-    }
-    else
-    {
-        auto const stratifiedSampler =
-            dynamic_pointer_cast<StratifiedSampler>(capsaicin.getComponent("StratifiedSampler"));
-        gfxProgramSetParameter(gfx_, program, "g_RandomSeedBuffer", stratifiedSampler->seedBuffer);
-        gfxProgramSetParameter(gfx_, program, "g_RandomSeedBufferSize",
-            static_cast<uint32_t>(stratifiedSampler->seedBuffer.getSize() / sizeof(uint32_t)));
-    }
+    gfxProgramSetParameter(gfx_, program, "g_RandomSeed", seed);
 }
 } // namespace Capsaicin
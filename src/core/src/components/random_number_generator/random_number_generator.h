@@ -92,6 +92,6 @@ class RandomNumberGenerator final
 
 private:
     RenderOptions options;
-    GfxBuffer     seedBuffer;
+    uint32_t      seed = 0; /**< Global seed used to generate all random number generator seeds on the GPU */
 };
 } // namespace Capsaicin
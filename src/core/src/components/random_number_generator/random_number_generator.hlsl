@@ -23,9 +23,25 @@ THE SOFTWARE.
 #ifndef RANDOM_NUMBER_GENERATOR_HLSL
 #define RANDOM_NUMBER_GENERATOR_HLSL
 
+#include "math/hash.hlsl"
+
 // Requires the following data to be defined in any shader that uses this file
-StructuredBuffer<uint> g_RandomSeedBuffer;
-uint g_RandomSeedBufferSize;
+uint g_RandomSeed;
+
+namespace NoExport
+{
+    /**
+     * Generate the initial random state seed for a random number generator.
+     * Seeds are calculated from a counter based hash of the input seed and the global seed so that no seed
+     * table is required.
+     * @param seed Seed value to initialise random with (e.g. 2D pixel index).
+     * @return The new seed.
+     */
+    uint makeRandomSeed(uint seed)
+    {
+        return pcgHash(seed + pcgHash(g_RandomSeed));
+    }
+}
 
 class Random
 {
@@ -94,7 +110,7 @@ Random MakeRandom(uint seed)
 {
     Random ret =
     {
-        g_RandomSeedBuffer[seed % g_RandomSeedBufferSize] * 747796405U + 2891336453u
+        NoExport::makeRandomSeed(seed) * 747796405U + 2891336453u
     };
     return ret;
 }
@@ -110,7 +126,7 @@ Random MakeRandom(uint seed, uint index)
     const uint inc = (index << 1) | 1U;
     Random ret =
     {
-        (g_RandomSeedBuffer[seed % g_RandomSeedBufferSize] + inc) * 747796405U + inc
+        (NoExport::makeRandomSeed(seed) + inc) * 747796405U + inc
     };
     return ret;
 }
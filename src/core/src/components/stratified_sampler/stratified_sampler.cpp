@@ -58,32 +58,18 @@ StratifiedSampler::RenderOptions StratifiedSampler::convertOptions(RenderOptionL
 
 bool StratifiedSampler::init(CapsaicinInternal const &capsaicin) noexcept
 {
-    options                       = convertOptions(capsaicin.getOptions());
-    auto const     seedDimensions = max(capsaicin.getRenderDimensions(), uint2(1920, 1080));
-    uint64_t const seedBufferSize = static_cast<uint64_t>(seedDimensions.x) * seedDimensions.y;
-
-    vector<uint32_t> seedBufferData;
-    seedBufferData.reserve(seedBufferSize);
+    options = convertOptions(capsaicin.getOptions());
+    // Per-sequence seeds are generated on the fly from a hash of the sequence index and this seed. This
+    // avoids having to generate and upload a seed table that scales with resolution
     if (options.stratified_sampler_deterministic)
     {
-        mt19937 gen(options.stratified_sampler_seed);
-        for (uint32_t i = 0; i < seedBufferSize; ++i)
-        {
-            seedBufferData.push_back(gen());
-        }
+        seed = options.stratified_sampler_seed;
     }
     else
     {
         random_device rd;
-        mt19937       gen(rd());
-        for (uint32_t i = 0; i < seedBufferSize; ++i)
-        {
-            seedBufferData.push_back(gen());
-        }
+        seed = rd();
     }
-    seedBuffer =
-        gfxCreateBuffer<uint32_t>(gfx_, static_cast<uint32_t>(seedBufferData.size()), seedBufferData.data());
-    seedBuffer.setName("StratifiedSampler_SeedBuffer");
 
     if (!sobolBuffer)
     {
@@ -103,23 +89,14 @@ void StratifiedSampler::run(CapsaicinInternal &capsaicin) noexcept
             && (optionsNew.stratified_sampler_seed != options.stratified_sampler_seed));
     options = optionsNew;
 
-    // Check if seed buffer needs to be re-initialised
-    auto const seedDimensions = max(capsaicin.getRenderDimensions(), uint2(1920, 1080));
-    if (uint64_t const seedBufferSize = sizeof(uint32_t) * seedDimensions.x * seedDimensions.y;
-        update || seedBufferSize > seedBuffer.getSize())
+    if (update)
     {
-        GfxCommandEvent const command_event(gfx_, "InitStratifiedSampler");
-
-        gfxDestroyBuffer(gfx_, seedBuffer);
-
         init(capsaicin);
     }
 }
 
 void StratifiedSampler::terminate() noexcept
 {
-    gfxDestroyBuffer(gfx_, seedBuffer);
-    seedBuffer = {};
     gfxDestroyBuffer(gfx_, sobolBuffer);
     sobolBuffer = {};
 }
@@ -127,9 +104,7 @@ void StratifiedSampler::terminate() noexcept
 void StratifiedSampler::addProgramParameters(
     [[maybe_unused]] CapsaicinInternal const &capsaicin, GfxProgram const &program) const noexcept
 {
-    gfxProgramSetParameter(gfx_, program, "g_SeedBuffer", seedBuffer);
     gfxProgramSetParameter(gfx_, program, "g_SobolXorsBuffer", sobolBuffer);
-    gfxProgramSetParameter(
-        gfx_, program, "g_SeedBufferSize", static_cast<uint32_t>(seedBuffer.getSize() / sizeof(uint32_t)));
+    gfxProgramSetParameter(gfx_, program, "g_StratifiedSamplerSeed", seed);
 }
 } // namespace Capsaicin
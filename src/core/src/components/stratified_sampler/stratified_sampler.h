@@ -92,9 +92,7 @@ class StratifiedSampler final
 
 private:
     RenderOptions options;
-    GfxBuffer     seedBuffer;
+    uint32_t      seed = 0; /**< Global seed used to generate all sequence seeds on the GPU */
     GfxBuffer     sobolBuffer;
-
-    friend class RandomNumberGenerator;
 };
 } // namespace Capsaicin
@@ -23,13 +23,26 @@ THE SOFTWARE.
 #ifndef STRATIFIED_SAMPLER_HLSL
 #define STRATIFIED_SAMPLER_HLSL
 
+#include "math/hash.hlsl"
+
 // Requires the following data to be defined in any shader that uses this file
-StructuredBuffer<uint> g_SeedBuffer;
 StructuredBuffer<uint> g_SobolXorsBuffer;
-uint g_SeedBufferSize;
+uint g_StratifiedSamplerSeed;
 
 namespace NoExport
 {
+    /**
+     * Generate the initial seed for a sequence.
+     * Seeds are calculated from a counter based hash of the sequence index and the global seed. The hash is
+     * a bijection so every index within a frame gets a unique seed.
+     * @param index Index of the sequence (e.g. 1D pixel index).
+     * @return The new seed.
+     */
+    uint makeSeed(uint index)
+    {
+        return pcgHash(index + pcgHash(g_StratifiedSamplerSeed));
+    }
+
     /**
      * Generate a random number.
      * @param index Index into the sequence of the value to return.
@@ -183,7 +196,7 @@ StratifiedSampler MakeStratifiedSampler(uint seed, uint index, uint dimension =
     StratifiedSampler ret =
     {
         index,
-        g_SeedBuffer[seed % g_SeedBufferSize],
+        NoExport::makeSeed(seed),
         dimension,
     };
     return ret;
@@ -266,7 +279,7 @@ StratifiedSampler1D MakeStratifiedSampler1D(uint seed, uint dimension = 0)
     StratifiedSampler1D ret =
     {
         0,
-        g_SeedBuffer[seed % g_SeedBufferSize],
+        NoExport::makeSeed(seed),
         dimension % 64,
     };
     ret.seed = NoExport::randomHash(dimension / 64, ret.seed);
@@ -343,7 +356,7 @@ StratifiedSampler2D MakeStratifiedSampler2D(uint seed, uint dimension = 0)
     StratifiedSampler2D ret =
     {
         0,
-        g_SeedBuffer[seed % g_SeedBufferSize],
+        NoExport::makeSeed(seed),
         dimension % 63,
     };
     ret.seed = NoExport::randomHash(dimension / 63, ret.seed);
@@ -0,0 +1,56 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#ifndef VERTEX_FORMAT_HLSL
+#define VERTEX_FORMAT_HLSL
+
+// This file is only found when the compact vertex layout is enabled (capsaicin_compact_vertices), in which
+// case its directory is added to the shader include paths and it replaces the default Vertex in gpu_shared.h.
+// The layout must match CompactVertex in gpu_shared.h.
+
+#include "../../math/pack.hlsl"
+
+struct Vertex
+{
+    float3 position; /**< Position (full precision as required for acceleration structure builds) */
+    uint   normal;   /**< Octahedral encoded normal */
+    uint   uv;       /**< Half precision UV */
+
+    float3 getPosition() { return position; }
+
+    float2 getUV() { return unpackHalf2(uv); }
+
+    float3 getNormal() { return unpackOctahedral(normal); }
+
+    void setVertex(float3 newPosition, float3 newNormal, float2 newUV)
+    {
+        // Encoded identically to CompactVertex::setVertex in gpu_shared.h: degenerate (zero, infinite or NaN)
+        // normals are stored as +Z and UVs are clamped to the largest half value to avoid overflowing to
+        // infinity for heavily tiled UVs
+        float length = abs(newNormal.x) + abs(newNormal.y) + abs(newNormal.z);
+        position     = newPosition;
+        normal       = packOctahedral(length > 0.0f && !isinf(length) ? newNormal : float3(0.0f, 0.0f, 1.0f));
+        uv           = packHalf2(clamp(newUV, -65504.0f, 65504.0f));
+    }
+};
+
+#endif // VERTEX_FORMAT_HLSL
@@ -24,6 +24,7 @@ THE SOFTWARE.
 
 #ifdef __cplusplus
 #    define GLM_ENABLE_EXPERIMENTAL
+#    include <glm/gtc/packing.hpp>
 #    include <glm/gtx/compatibility.hpp>
 #    include <glm/gtx/type_aligned.hpp>
 
@@ -141,6 +142,11 @@ struct Material
                                // opaque, 1 clip, 2 blend)
 };
 
+#if !defined(__cplusplus) && __has_include("vertex_format.hlsl")
+// The compact vertex layout is selected by adding its directory to the shader include paths (see
+// capsaicin_compact_vertices)
+#    include "vertex_format.hlsl"
+#else
 struct Vertex
 {
     float4 position_uvx; /**< Position with UV.x placed in last element */
@@ -158,6 +164,61 @@ struct Vertex
         normal_uvy   = float4(normal, uv.y);
     }
 };
+#endif
+
+#ifdef __cplusplus
+/**
+ * Compact GPU vertex layout, must match the HLSL Vertex declared in geometry/compact_vertex/vertex_format.hlsl.
+ * Positions are kept at full precision so that the buffer can still be passed directly to acceleration
+ * structure builds, normals are octahedral encoded into 2 16bit snorms and UVs are stored as half precision.
+ */
+struct CompactVertex
+{
+    glm::vec3 position; /**< Position */
+    uint      normal;   /**< Octahedral encoded normal */
+    uint      uv;       /**< Half precision UV */
+
+    CompactVertex() = default;
+
+    explicit CompactVertex(Vertex const &vertex) noexcept
+    {
+        setVertex(float3(vertex.position_uvx), float3(vertex.normal_uvy),
+            float2(vertex.position_uvx.w, vertex.normal_uvy.w));
+    }
+
+    float3 getPosition() const noexcept { return position; }
+
+    float2 getUV() const noexcept { return glm::unpackHalf2x16(uv); }
+
+    float3 getNormal() const noexcept
+    {
+        glm::vec2 const octahedral = glm::unpackSnorm2x16(normal);
+        glm::vec3 value(octahedral, 1.0F - glm::abs(octahedral.x) - glm::abs(octahedral.y));
+        float const fold = glm::clamp(-value.z, 0.0F, 1.0F);
+        value.x += value.x >= 0.0F ? -fold : fold;
+        value.y += value.y >= 0.0F ? -fold : fold;
+        return glm::normalize(value);
+    }
+
+    void setVertex(float3 const &newPosition, float3 const &newNormal, float2 const &newUV) noexcept
+    {
+        position           = newPosition;
+        float const length = glm::abs(newNormal.x) + glm::abs(newNormal.y) + glm::abs(newNormal.z);
+        // Degenerate (zero, infinite or NaN) normals are stored as +Z, must match Vertex::setVertex in HLSL
+        bool const valid      = length > 0.0F && !glm::isinf(length);
+        glm::vec2  octahedral = valid ? glm::vec2(newNormal.x, newNormal.y) / length : glm::vec2(0.0F);
+        if (valid && newNormal.z < 0.0F)
+        {
+            glm::vec2 const signs(octahedral.x >= 0.0F ? 1.0F : -1.0F, octahedral.y >= 0.0F ? 1.0F : -1.0F);
+            octahedral = (1.0F - glm::abs(glm::vec2(octahedral.y, octahedral.x))) * signs;
+        }
+        normal = glm::packSnorm2x16(octahedral);
+        // Clamp to the largest half value to avoid overflowing to infinity for heavily tiled UVs
+        uv = glm::packHalf2x16(glm::clamp(glm::vec2(newUV), glm::vec2(-65504.0F), glm::vec2(65504.0F)));
+    }
+};
+static_assert(sizeof(CompactVertex) == 20, "CompactVertex must match the HLSL layout");
+#endif
 
 struct Joint
 {
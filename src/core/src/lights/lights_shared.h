@@ -25,6 +25,10 @@ THE SOFTWARE.
 
 #include "../gpu_shared.h"
 
+#ifdef __cplusplus
+#    include <bit>
+#endif
+
 enum LightType
 {
     kLight_Point = 0xFFF0FF80,
@@ -54,7 +58,7 @@ struct Light
 #ifndef __cplusplus
         uint index = asuint(v3.w);
 #else
-        const uint index = *reinterpret_cast<uint *>(&v3.w);
+        const uint index = std::bit_cast<uint>(v3.w);
 #endif
         if (index < (uint)kLight_Point)
         {
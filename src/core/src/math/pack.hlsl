@@ -320,8 +320,8 @@ uint packSnorm1x16(float value)
  */
 uint packSnorm2x16(float2 value)
 {
-    int2 packedValue = int2(clamp(value, -1.0f, 1.0f) * 32767.0f + (0.5f * sign(value))) & 0xFFFF;
-    return packedValue.x | (packedValue.y << 8);
+    uint2 packedValue = uint2(int2(clamp(value, -1.0f, 1.0f) * 32767.0f + (0.5f * sign(value)))) & 0xFFFFu;
+    return packedValue.x | (packedValue.y << 16);
 }
 
 /**
@@ -332,8 +332,8 @@ uint packSnorm2x16(float2 value)
  */
 uint2 packSnorm3x16(float3 value)
 {
-    int3 packedValue = int3(clamp(value, -1.0f, 1.0f) * 32767.0f + (0.5f * sign(value))) & 0xFFFF;
-    return packedValue.x | (packedValue.y << 8) | (packedValue.z << 16);
+    uint3 packedValue = uint3(int3(clamp(value, -1.0f, 1.0f) * 32767.0f + (0.5f * sign(value)))) & 0xFFFFu;
+    return uint2(packedValue.x | (packedValue.y << 16), packedValue.z);
 }
 
 /**
@@ -344,8 +344,8 @@ uint2 packSnorm3x16(float3 value)
  */
 uint2 packSnorm4x16(float4 value)
 {
-    int4 packedValue = int4(clamp(value, -1.0f, 1.0f) * 32767.0f + (0.5f * sign(value))) & 0xFFFF;
-    return packedValue.x | (packedValue.y << 8) | (packedValue.z << 16) | (packedValue.w << 24);
+    uint4 packedValue = uint4(int4(clamp(value, -1.0f, 1.0f) * 32767.0f + (0.5f * sign(value)))) & 0xFFFFu;
+    return uint2(packedValue.x | (packedValue.y << 16), packedValue.z | (packedValue.w << 16));
 }
 
 /**
@@ -503,6 +503,37 @@ float2 unpackUVs(float packedValue)
     return float2(unpackHalf2(uv));
 }
 
+/**
+ * Pack a unit length vector into 2 16bit snorm values using an octahedral mapping.
+ * @param value Input normalised vector to pack.
+ * @return Packed 16bit snorms.
+ */
+uint packOctahedral(float3 value)
+{
+    float  length     = abs(value.x) + abs(value.y) + abs(value.z);
+    float2 octahedral = length > 0.0f ? value.xy / length : 0.0f;
+    if (value.z < 0.0f)
+    {
+        float2 signs = select(octahedral >= 0.0f, 1.0f, -1.0f);
+        octahedral   = (1.0f - abs(octahedral.yx)) * signs;
+    }
+    return packSnorm2x16(octahedral);
+}
+
+/**
+ * Convert octahedral mapped 16bit snorms to a unit length vector.
+ * @param packedValue Input snorm values to convert.
+ * @return Converted normalised vector.
+ */
+float3 unpackOctahedral(uint packedValue)
+{
+    float2 octahedral = unpackSnorm2x16(packedValue);
+    float3 value      = float3(octahedral, 1.0f - abs(octahedral.x) - abs(octahedral.y));
+    float  fold       = saturate(-value.z);
+    value.xy += select(value.xy >= 0.0f, -fold, fold);
+    return normalize(value);
+}
+
 /**
  * Pack SDR (0->1) color values to a single uint.
  * @param color Input colour value to pack.
@@ -22,83 +22,7 @@ THE SOFTWARE.
 #include "color_grading.h"
 
 #include "capsaicin_internal.h"
-
-#include <fstream>
-
-namespace
-{
-
-class Tokenizer
-{
-public:
-    explicit Tokenizer(std::string const &fileName)
-    {
-        memset(token_.data(), 0, token_.size());
-        std::filesystem::path const filePath = fileName;
-        data_.resize(std::filesystem::file_size(filePath));
-        std::ifstream readFile(filePath);
-        if (readFile.read(data_.data(), static_cast<std::streamsize>(data_.size())); readFile)
-        {
-            advanceToNextToken();
-        }
-        else
-        {
-            GFX_ASSERTMSG(0, "Failed to read color grading file");
-            data_.clear();
-        }
-    }
-
-    [[nodiscard]] char const *getToken() const { return token_.data(); }
-
-    bool advanceToNextToken()
-    {
-        char c         = 0;
-        bool has_token = false;
-        memset(token_.data(), 0, token_.size());
-        auto token_cursor = data_cursor_;
-
-        while (readNextCharacter(c))
-        {
-            switch (c)
-            {
-            case ' ':
-            case '\r':
-            case '\n':
-                if (!has_token)
-                {
-                    token_cursor = data_cursor_;
-                }
-                else
-                {
-                    size_t const token_size = std::min(data_cursor_ - token_cursor - 1, token_.size() - 1);
-                    memcpy(token_.data(), &data_[token_cursor], token_size);
-                    return true;
-                }
-                break;
-            default: has_token = true; break;
-            }
-        }
-
-        return false;
-    }
-
-private:
-    bool readNextCharacter(char &c)
-    {
-        if (data_cursor_ >= data_.size())
-        {
-            return false; // EOF
-        }
-        c = data_[data_cursor_++];
-        return true;
-    }
-
-    std::vector<char>     data_;
-    std::array<char, 256> token_ {};
-    size_t                data_cursor_ = 0;
-};
-
-} // unnamed namespace
+#include "color_grading_lut.h"
 
 namespace Capsaicin
 {
@@ -117,6 +41,8 @@ RenderOptionList ColorGrading::getRenderOptions() noexcept
     RenderOptionList newOptions;
     newOptions.emplace(RENDER_OPTION_MAKE(color_grading_enable, options_));
     newOptions.emplace(RENDER_OPTION_MAKE(color_grading_file, options_));
+    newOptions.emplace(RENDER_OPTION_MAKE(color_grading_lut_cache, options_));
+    newOptions.emplace(RENDER_OPTION_MAKE(color_grading_lut_cache_half, options_));
     return newOptions;
 }
 
@@ -125,6 +51,8 @@ ColorGrading::RenderOptions ColorGrading::convertOptions(RenderOptionList const
     RenderOptions newOptions;
     RENDER_OPTION_GET(color_grading_enable, newOptions, options)
     RENDER_OPTION_GET(color_grading_file, newOptions, options)
+    RENDER_OPTION_GET(color_grading_lut_cache, newOptions, options)
+    RENDER_OPTION_GET(color_grading_lut_cache_half, newOptions, options)
     return newOptions;
 }
 
@@ -325,111 +253,53 @@ bool ColorGrading::openLUTFile(std::string const &fileName, CapsaicinInternal co
             kGfxResult_InvalidOperation, "Failed to open Color Grading file `%s'", fileName.c_str());
         return false;
     }
-    else
-    {
-        // Use tokenizer to split the input LUT file into each entry
-        Tokenizer tokenizer(fileName);
-
-        uint32_t            token_index = 0;
-        uint32_t            lut_size    = 0;
-        std::vector<float4> lut_data;
-        bool                failed = true;
-
-        do
-        {
-            switch (token_index)
-            {
-            case 0:
-                // The first token of a .cube file should specify the LUT type, we only support 3D LUT files
-                if (strcmp(tokenizer.getToken(), "LUT_3D_SIZE") != 0)
-                {
-                    GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
-                        "Invalid Color Grading file, only 3D LUT files accepted");
-                }
-                break;
-            case 1:
-                // The second element specifies the LUT size in each dimension. i.e. a size of x results in a
-                // table with x*x*x entries
-                lut_size = static_cast<uint32_t>(std::stoi(tokenizer.getToken()));
-                if ((lut_size == 0U) || lut_size > 100)
-                {
-                    GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
-                        "Invalid Color Grading file, invalid or un-found LUT size");
-                }
-                else
-                {
-                    lut_data.resize(static_cast<size_t>(lut_size) * lut_size * lut_size);
-                }
-                break;
-            default:
-            {
-                // All entries after the first 2 are the actually LUT data elements
-                uint32_t const lut_index = (token_index - 2);
-                // Check if number of elements exceeds expected LUT size
-                if (lut_index >= 3 * lut_data.size())
-                {
-                    GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
-                        "Invalid Color Grading file, found elements exceeds specified LUT size");
-                }
-                else
-                {
-                    // Add element to LUT data
-                    if ((lut_index % 3) == 0U)
-                    {
-                        lut_data[lut_index / 3].w = 1.0F;
-                    }
-                    lut_data[lut_index / 3][lut_index % 3] = std::stof(tokenizer.getToken());
-                }
-            }
-            break;
-            }
-            ++token_index;
-        }
-        while (tokenizer.advanceToNextToken());
 
-        // Check if number of found elements exactly matches specified LUT size
-        if (token_index - 2 != 3 * lut_data.size())
-        {
-            GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
-                "Invalid Color Grading file, found elements does not match specified LUT size");
-        }
-        else if (!lut_data.empty())
+    // Use any compiled sidecar if it is still valid, otherwise parse the source file
+    uint32_t            lut_size = 0;
+    std::vector<float4> lut_data;
+    bool const          use_cache = capsaicin.getOption<bool>("color_grading_lut_cache");
+    bool const          use_half  = capsaicin.getOption<bool>("color_grading_lut_cache_half");
+    if (!use_cache || !LoadLutCache(fileName, use_half, lut_size, lut_data))
+    {
+        if (!LoadCubeFile(fileName, lut_size, lut_data))
         {
-            // Upload the LUT data into a 3D texture
-            gfxDestroyTexture(gfx_, lut_buffer_);
-            lut_buffer_ = gfxCreateTexture3D(gfx_, lut_size, lut_size, lut_size, DXGI_FORMAT_R8G8B8A8_UNORM);
-            // We lazily load the upload kernel so that it is only loaded when actually needed (assumed LUT
-            // updates occur infrequently)
-            GfxProgram const upload_program =
-                capsaicin.createProgram("render_techniques/color_grading/color_grading_upload");
-            GfxKernel const upload_kernel = gfxCreateComputeKernel(gfx_, upload_program, "Upload");
-            GfxBuffer const upload_buffer =
-                gfxCreateBuffer<float4>(gfx_, static_cast<uint32_t>(lut_data.size()), lut_data.data());
-
-            gfxProgramSetParameter(gfx_, upload_program, "g_RWLutBuffer", lut_buffer_);
-            gfxProgramSetParameter(gfx_, upload_program, "g_UploadBuffer", upload_buffer);
-            gfxProgramSetParameter(gfx_, upload_program, "g_LutSize", lut_size);
-
-            uint32_t const *num_threads = gfxKernelGetNumThreads(gfx_, upload_kernel);
-            uint32_t const  num_groups_x =
-                (static_cast<uint32_t>(lut_data.size()) + num_threads[0] - 1) / num_threads[0];
-
-            gfxCommandBindKernel(gfx_, upload_kernel);
-            gfxCommandDispatch(gfx_, num_groups_x, 1, 1);
-            gfxDestroyBuffer(gfx_, upload_buffer);
-            gfxDestroyKernel(gfx_, upload_kernel);
-            gfxDestroyProgram(gfx_, upload_program);
-            failed = false;
+            return false;
         }
-
-        if (!failed)
+        if (use_cache)
         {
-            // Only set the internal file if it was successfully loaded
-            options_.color_grading_file = fileName;
-            return true;
+            // Failure is not an error as the source file may be in a read only location
+            SaveLutCache(fileName, lut_size, lut_data, use_half);
         }
     }
-    return false;
+
+    // Upload the LUT data into a 3D texture
+    gfxDestroyTexture(gfx_, lut_buffer_);
+    lut_buffer_ = gfxCreateTexture3D(gfx_, lut_size, lut_size, lut_size, DXGI_FORMAT_R8G8B8A8_UNORM);
+    // We lazily load the upload kernel so that it is only loaded when actually needed (assumed LUT
+    // updates occur infrequently)
+    GfxProgram const upload_program =
+        capsaicin.createProgram("render_techniques/color_grading/color_grading_upload");
+    GfxKernel const upload_kernel = gfxCreateComputeKernel(gfx_, upload_program, "Upload");
+    GfxBuffer const upload_buffer =
+        gfxCreateBuffer<float4>(gfx_, static_cast<uint32_t>(lut_data.size()), lut_data.data());
+
+    gfxProgramSetParameter(gfx_, upload_program, "g_RWLutBuffer", lut_buffer_);
+    gfxProgramSetParameter(gfx_, upload_program, "g_UploadBuffer", upload_buffer);
+    gfxProgramSetParameter(gfx_, upload_program, "g_LutSize", lut_size);
+
+    uint32_t const *num_threads = gfxKernelGetNumThreads(gfx_, upload_kernel);
+    uint32_t const  num_groups_x =
+        (static_cast<uint32_t>(lut_data.size()) + num_threads[0] - 1) / num_threads[0];
+
+    gfxCommandBindKernel(gfx_, upload_kernel);
+    gfxCommandDispatch(gfx_, num_groups_x, 1, 1);
+    gfxDestroyBuffer(gfx_, upload_buffer);
+    gfxDestroyKernel(gfx_, upload_kernel);
+    gfxDestroyProgram(gfx_, upload_program);
+
+    // Only set the internal file if it was successfully loaded
+    options_.color_grading_file = fileName;
+    return true;
 }
 
 std::string ColorGrading::getSceneLUTFile(CapsaicinInternal const &capsaicin) noexcept
@@ -44,8 +44,11 @@ class ColorGrading final : public RenderTechnique
 
     struct RenderOptions
     {
-        bool        color_grading_enable = false;
-        std::string color_grading_file   = ""; /**< Filename of LUT to use */
+        bool        color_grading_enable         = false;
+        std::string color_grading_file           = "";    /**< Filename of LUT to use */
+        bool        color_grading_lut_cache      = false; /**< Write a compiled sidecar next to each LUT file
+                                                            ('<file>.cube.bin') to skip parsing on reload */
+        bool        color_grading_lut_cache_half = false; /**< Store LUT sidecars using half precision */
     };
 
     /**
@@ -0,0 +1,357 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#include "color_grading_lut.h"
+
+#include "atomic_file.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <gfx.h>
+
+namespace
+{
+/** Size of each block of LUT data that is parsed in parallel. */
+constexpr size_t kLutParseChunkSize = 64 * 1024;
+
+/** Identifier and version of compiled LUT sidecar files. */
+constexpr uint32_t kLutCacheMagic   = 0x4C425543; // 'CUBL'
+constexpr uint32_t kLutCacheVersion = 1;
+
+/** Header of a compiled LUT sidecar file, followed by 3 floats or halves per LUT entry. */
+struct LutCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t lutSize;
+    uint32_t half;       /**< Non-zero if values are stored as half precision */
+    uint64_t sourceSize; /**< Size of the source '.cube' file the sidecar was compiled from */
+    int64_t  sourceTime; /**< Last write time of the source '.cube' file the sidecar was compiled from */
+};
+
+bool IsSpace(char const c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+char const *SkipSpaces(char const *cursor, char const *end) noexcept
+{
+    while (cursor < end && IsSpace(*cursor))
+    {
+        ++cursor;
+    }
+    return cursor;
+}
+
+char const *FindLineEnd(char const *cursor, char const *end) noexcept
+{
+    auto const *lineEnd = static_cast<char const *>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+    return lineEnd != nullptr ? lineEnd : end;
+}
+
+/** Check if a line contains data (i.e. is not empty or a comment), returns start of the data if so. */
+char const *GetLineData(char const *line, char const *lineEnd) noexcept
+{
+    char const *data = SkipSpaces(line, lineEnd);
+    return data < lineEnd && *data != '#' ? data : nullptr;
+}
+
+/** Parse a sequence of floats from a line, fails if the line does not contain exactly count values. */
+bool ParseFloats(char const *cursor, char const *end, float *values, uint32_t const count) noexcept
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        cursor = SkipSpaces(cursor, end);
+        // from_chars does not accept a leading '+'
+        if (cursor < end && *cursor == '+')
+        {
+            ++cursor;
+        }
+        auto const [next, error] = std::from_chars(cursor, end, values[i]);
+        if (error != std::errc())
+        {
+            return false;
+        }
+        cursor = next;
+    }
+    return SkipSpaces(cursor, end) == end;
+}
+
+bool ReadFile(std::filesystem::path const &filePath, std::vector<char> &data) noexcept
+{
+    std::error_code ec;
+    auto const      fileSize = std::filesystem::file_size(filePath, ec);
+    if (ec)
+    {
+        return false;
+    }
+    std::ifstream file(filePath, std::ios::binary);
+    data.resize(fileSize);
+    return file.is_open() && file.read(data.data(), static_cast<std::streamsize>(fileSize));
+}
+
+/**
+ * Get the properties of a source file used to validate any compiled sidecar.
+ * @param filePath         Path of the source '.cube' file.
+ * @param [out] sourceSize The size of the file.
+ * @param [out] sourceTime The last write time of the file.
+ * @return True on success, False otherwise.
+ */
+bool GetLutSourceInfo(
+    std::filesystem::path const &filePath, uint64_t &sourceSize, int64_t &sourceTime) noexcept
+{
+    std::error_code ec;
+    sourceSize      = std::filesystem::file_size(filePath, ec);
+    auto const time = std::filesystem::last_write_time(filePath, ec);
+    sourceTime      = static_cast<int64_t>(time.time_since_epoch().count());
+    return !ec;
+}
+} // unnamed namespace
+
+namespace Capsaicin
+{
+bool ParseCubeFile(std::vector<char> const &data, uint32_t &lutSize, std::vector<float4> &lutData) noexcept
+{
+    char const *cursor = data.data();
+    char const *end    = cursor + data.size();
+    lutSize            = 0;
+    while (cursor < end)
+    {
+        char const *lineEnd = FindLineEnd(cursor, end);
+        char const *line    = GetLineData(cursor, lineEnd);
+        if (line != nullptr && (isdigit(static_cast<unsigned char>(*line)) != 0 || *line == '-'
+                                   || *line == '+' || *line == '.'))
+        {
+            // Reached the start of the table data
+            break;
+        }
+        cursor = lineEnd < end ? lineEnd + 1 : end;
+        if (line == nullptr)
+        {
+            continue;
+        }
+        std::string_view const keyword(line, static_cast<size_t>(
+                                                 std::find_if(line, lineEnd, IsSpace) - line));
+        char const *value = SkipSpaces(line + keyword.size(), lineEnd);
+        if (keyword == "LUT_3D_SIZE")
+        {
+            if (auto const [next, error] = std::from_chars(value, lineEnd, lutSize); error != std::errc())
+            {
+                lutSize = 0;
+            }
+        }
+        else if (keyword == "LUT_1D_SIZE")
+        {
+            GFX_PRINT_ERROR(
+                kGfxResult_InvalidParameter, "Invalid Color Grading file, only 3D LUT files accepted");
+            return false;
+        }
+        else if (keyword == "DOMAIN_MIN" || keyword == "DOMAIN_MAX")
+        {
+            // Only the default domain is supported
+            float3 domain;
+            if (float const expected = keyword == "DOMAIN_MIN" ? 0.0F : 1.0F;
+                !ParseFloats(value, lineEnd, &domain.x, 3) || domain != float3(expected))
+            {
+                GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
+                    "Invalid Color Grading file, only LUTs with a [0, 1] domain are supported");
+                return false;
+            }
+        }
+        // Any other keywords (e.g. TITLE) do not effect the LUT data and are ignored
+    }
+    if (lutSize == 0 || lutSize > 100)
+    {
+        GFX_PRINT_ERROR(
+            kGfxResult_InvalidParameter, "Invalid Color Grading file, invalid or un-found LUT size");
+        return false;
+    }
+
+    // Split remaining data into blocks that each start at the beginning of a line
+    std::vector<char const *> chunks = {cursor};
+    while (chunks.back() < end)
+    {
+        char const *chunkEnd = std::min(chunks.back() + kLutParseChunkSize, end);
+        chunkEnd             = chunkEnd < end ? FindLineEnd(chunkEnd, end) : end;
+        chunks.push_back(chunkEnd < end ? chunkEnd + 1 : end);
+    }
+    auto const            chunkCount = static_cast<uint32_t>(chunks.size() - 1);
+    std::vector<uint32_t> chunkOffsets(chunkCount + 1, 0);
+    auto const            forEachLine = [&](uint32_t const chunk, auto const &func) {
+        for (char const *line = chunks[chunk]; line < chunks[chunk + 1];)
+        {
+            char const *lineEnd = FindLineEnd(line, chunks[chunk + 1]);
+            if (char const *lineData = GetLineData(line, lineEnd); lineData != nullptr)
+            {
+                func(lineData, lineEnd);
+            }
+            line = lineEnd + 1;
+        }
+    };
+    Capsaicin::ParallelFor(0U, chunkCount, [&](uint32_t const chunk) {
+        uint32_t count = 0;
+        forEachLine(chunk, [&count](char const *, char const *) { ++count; });
+        chunkOffsets[chunk + 1] = count;
+    });
+    for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+    }
+
+    // Check if number of found elements exactly matches specified LUT size
+    lutData.resize(static_cast<size_t>(lutSize) * lutSize * lutSize);
+    if (chunkOffsets.back() != lutData.size())
+    {
+        GFX_PRINT_ERROR(kGfxResult_InvalidParameter,
+            "Invalid Color Grading file, found elements does not match specified LUT size");
+        return false;
+    }
+    std::atomic_bool valid = true;
+    Capsaicin::ParallelFor(0U, chunkCount, [&](uint32_t const chunk) {
+        uint32_t index = chunkOffsets[chunk];
+        forEachLine(chunk, [&](char const *line, char const *lineEnd) {
+            float4 &entry = lutData[index++];
+            entry.w       = 1.0F;
+            if (!ParseFloats(line, lineEnd, &entry.x, 3))
+            {
+                valid.store(false, std::memory_order_relaxed);
+            }
+        });
+    });
+    if (!valid)
+    {
+        GFX_PRINT_ERROR(kGfxResult_InvalidParameter, "Invalid Color Grading file, failed to parse LUT data");
+        return false;
+    }
+    return true;
+}
+
+bool LoadCubeFile(
+    std::filesystem::path const &filePath, uint32_t &lutSize, std::vector<float4> &lutData) noexcept
+{
+    std::vector<char> data;
+    if (!ReadFile(filePath, data))
+    {
+        GFX_PRINT_ERROR(
+            kGfxResult_InvalidOperation, "Failed to read Color Grading file `%s'", filePath.string().c_str());
+        return false;
+    }
+    return ParseCubeFile(data, lutSize, lutData);
+}
+
+std::filesystem::path GetLutCachePath(std::filesystem::path const &filePath) noexcept
+{
+    auto cachePath = filePath;
+    cachePath += ".bin";
+    return cachePath;
+}
+
+bool LoadLutCache(std::filesystem::path const &filePath, bool const half, uint32_t &lutSize,
+    std::vector<float4> &lutData) noexcept
+{
+    uint64_t sourceSize;
+    int64_t  sourceTime;
+    if (!GetLutSourceInfo(filePath, sourceSize, sourceTime))
+    {
+        return false;
+    }
+    std::vector<char> data;
+    if (!ReadFile(GetLutCachePath(filePath), data) || data.size() < sizeof(LutCacheHeader))
+    {
+        return false;
+    }
+    LutCacheHeader header;
+    memcpy(&header, data.data(), sizeof(LutCacheHeader));
+    size_t const count     = static_cast<size_t>(header.lutSize) * header.lutSize * header.lutSize;
+    size_t const entrySize = 3 * (half ? sizeof(uint16_t) : sizeof(float));
+    // A sidecar stored with a different precision is recompiled so that changes to the option take effect
+    if (header.magic != kLutCacheMagic || header.version != kLutCacheVersion
+        || header.half != (half ? 1U : 0U) || header.sourceSize != sourceSize
+        || header.sourceTime != sourceTime || header.lutSize == 0 || header.lutSize > 100
+        || data.size() != sizeof(LutCacheHeader) + count * entrySize)
+    {
+        return false;
+    }
+    lutSize = header.lutSize;
+    lutData.resize(count);
+    char const *values = data.data() + sizeof(LutCacheHeader);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (half)
+        {
+            std::array<uint16_t, 3> entry;
+            memcpy(entry.data(), values + i * entrySize, entrySize);
+            lutData[i] = float4(glm::unpackHalf1x16(entry[0]), glm::unpackHalf1x16(entry[1]),
+                glm::unpackHalf1x16(entry[2]), 1.0F);
+        }
+        else
+        {
+            memcpy(&lutData[i], values + i * entrySize, entrySize);
+            lutData[i].w = 1.0F;
+        }
+    }
+    return true;
+}
+
+bool SaveLutCache(std::filesystem::path const &filePath, uint32_t const lutSize,
+    std::vector<float4> const &lutData, bool const half) noexcept
+{
+    LutCacheHeader header = {.magic = kLutCacheMagic,
+        .version                    = kLutCacheVersion,
+        .lutSize                    = lutSize,
+        .half                       = half ? 1U : 0U,
+        .sourceSize                 = 0,
+        .sourceTime                 = 0};
+    if (!GetLutSourceInfo(filePath, header.sourceSize, header.sourceTime))
+    {
+        return false;
+    }
+    std::vector<char> data(sizeof(LutCacheHeader));
+    memcpy(data.data(), &header, sizeof(LutCacheHeader));
+    for (auto const &entry : lutData)
+    {
+        if (half)
+        {
+            std::array<uint16_t, 3> const values = {
+                glm::packHalf1x16(entry.x), glm::packHalf1x16(entry.y), glm::packHalf1x16(entry.z)};
+            data.insert(data.end(), reinterpret_cast<char const *>(values.data()),
+                reinterpret_cast<char const *>(values.data() + values.size()));
+        }
+        else
+        {
+            data.insert(data.end(), reinterpret_cast<char const *>(&entry.x),
+                reinterpret_cast<char const *>(&entry.x + 3));
+        }
+    }
+
+    // Write to a unique temporary file first and then move into place so that a partially written sidecar is
+    // never used and concurrent writers never share a file
+    return WriteFileAtomic(GetLutCachePath(filePath), [&data](std::ofstream &file) {
+        return file.write(data.data(), static_cast<std::streamsize>(data.size())).good();
+    });
+}
+
+} // namespace Capsaicin
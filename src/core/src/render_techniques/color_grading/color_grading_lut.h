@@ -0,0 +1,83 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "gpu_shared.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Parse the contents of a '.cube' file.
+ * The header keywords are read serially after which the table data is split into fixed size blocks aligned to
+ * line boundaries. The number of entries in each block is counted and then each block is parsed directly into
+ * its place in the output in parallel.
+ * @param data           The file contents.
+ * @param [out] lutSize  The size of each dimension of the LUT.
+ * @param [out] lutData  The LUT entries.
+ * @return True on success, False otherwise.
+ */
+bool ParseCubeFile(std::vector<char> const &data, uint32_t &lutSize, std::vector<float4> &lutData) noexcept;
+
+/**
+ * Read and parse a '.cube' file stored on disk.
+ * @param filePath       Path of the '.cube' file.
+ * @param [out] lutSize  The size of each dimension of the LUT.
+ * @param [out] lutData  The LUT entries.
+ * @return True on success, False otherwise.
+ */
+bool LoadCubeFile(
+    std::filesystem::path const &filePath, uint32_t &lutSize, std::vector<float4> &lutData) noexcept;
+
+/**
+ * Get the path of the compiled sidecar of a '.cube' file ('<file>.cube.bin').
+ * @param filePath Path of the source '.cube' file.
+ * @return The sidecar path.
+ */
+std::filesystem::path GetLutCachePath(std::filesystem::path const &filePath) noexcept;
+
+/**
+ * Load the compiled sidecar of a '.cube' file.
+ * The sidecar is only used if it was compiled from the current version of the source file using the
+ * requested precision.
+ * @param filePath       Path of the source '.cube' file.
+ * @param half           True if the sidecar is expected to store half precision values.
+ * @param [out] lutSize  The size of each dimension of the LUT.
+ * @param [out] lutData  The LUT entries.
+ * @return True on success, False if there is no valid sidecar.
+ */
+bool LoadLutCache(std::filesystem::path const &filePath, bool half, uint32_t &lutSize,
+    std::vector<float4> &lutData) noexcept;
+
+/**
+ * Write the compiled sidecar of a '.cube' file.
+ * @param filePath Path of the source '.cube' file.
+ * @param lutSize  The size of each dimension of the LUT.
+ * @param lutData  The LUT entries.
+ * @param half     True to store values using half precision.
+ * @return True on success, False otherwise.
+ */
+bool SaveLutCache(std::filesystem::path const &filePath, uint32_t lutSize, std::vector<float4> const &lutData,
+    bool half) noexcept;
+} // namespace Capsaicin
@@ -0,0 +1,145 @@
+#include "ct_acceleration_structure.h"
+
+#include "parallel.h"
+
+namespace Capsaicin
+{
+void CtAccelerationStructure::clear() noexcept
+{
+    m_blases.clear();
+    m_tlas.clear();
+    m_instances.clear();
+}
+
+uint32_t CtAccelerationStructure::addBlas(std::vector<CtBvh::Triangle>&& triangles) noexcept
+{
+    const auto blas = static_cast<uint32_t>(m_blases.size());
+    m_blases.emplace_back().triangles = std::move(triangles);
+    return blas;
+}
+
+void CtAccelerationStructure::buildBlases() noexcept
+{
+    std::vector<uint32_t> pending;
+    for (uint32_t i = 0u; i < static_cast<uint32_t>(m_blases.size()); ++i)
+    {
+        if (!m_blases[i].built)
+        {
+            pending.push_back(i);
+        }
+    }
+    // Each BLAS build only parallelises internally once large, so building many small ones at once is what
+    // keeps all threads busy
+    ParallelFor(0u, static_cast<uint32_t>(pending.size()), [&](const uint32_t i) {
+        Blas& blas = m_blases[pending[i]];
+        blas.bvh.build(blas.triangles);
+        blas.built = true;
+    });
+
+    uint32_t nodeOffset     = 0u;
+    uint32_t triangleOffset = 0u;
+    for (Blas& blas : m_blases)
+    {
+        blas.nodeOffset     = nodeOffset;
+        blas.triangleOffset = triangleOffset;
+        nodeOffset += static_cast<uint32_t>(blas.bvh.getNodes().size());
+        triangleOffset += static_cast<uint32_t>(blas.triangles.size());
+    }
+}
+
+void CtAccelerationStructure::buildTlas(const std::vector<InstanceDesc>& instances) noexcept
+{
+    // Instances of empty geometry have no BLAS root to point at so are skipped
+    std::vector<const InstanceDesc*> descs;
+    std::vector<CtBvh::Bounds>       bounds;
+    descs.reserve(instances.size());
+    bounds.reserve(instances.size());
+    for (const InstanceDesc& instance : instances)
+    {
+        const CtBvh::Bounds blasBounds = m_blases[instance.blas].bvh.getBounds();
+        if (blasBounds.min.x > blasBounds.max.x)
+        {
+            continue;
+        }
+        // Transform the corners of the object space bounds into world space
+        CtBvh::Bounds worldBounds;
+        for (uint32_t corner = 0u; corner < 8u; ++corner)
+        {
+            const glm::vec3 position((corner & 1u) != 0u ? blasBounds.max.x : blasBounds.min.x,
+                (corner & 2u) != 0u ? blasBounds.max.y : blasBounds.min.y,
+                (corner & 4u) != 0u ? blasBounds.max.z : blasBounds.min.z);
+            worldBounds.grow(glm::vec3(instance.transform * glm::vec4(position, 1.0f)));
+        }
+        descs.push_back(&instance);
+        bounds.push_back(worldBounds);
+    }
+    // Single instance leaves allow the GPU traversal to switch to the BLAS directly from a leaf
+    const auto count = static_cast<uint32_t>(descs.size());
+    m_tlas.build(bounds.data(), count, 1u);
+
+    const std::vector<uint32_t>& order = m_tlas.getPrimitiveIndices();
+    m_instances.resize(count);
+    for (uint32_t i = 0u; i < count; ++i)
+    {
+        const InstanceDesc& desc          = *descs[order[i]];
+        const glm::mat4     worldToObject = glm::transpose(glm::inverse(desc.transform));
+        Instance&           instance      = m_instances[i];
+        instance.worldToObject[0]         = worldToObject[0];
+        instance.worldToObject[1]         = worldToObject[1];
+        instance.worldToObject[2]         = worldToObject[2];
+        instance.blasRoot                 = m_blases[desc.blas].nodeOffset;
+        instance.instanceIndex            = desc.instanceIndex;
+        instance.padding[0]               = 0u;
+        instance.padding[1]               = 0u;
+    }
+}
+
+void CtAccelerationStructure::getBlasData(
+    std::vector<CtBvh::Node>& nodes, std::vector<CtBvh::Triangle>& triangles) const noexcept
+{
+    nodes.clear();
+    triangles.clear();
+    for (const Blas& blas : m_blases)
+    {
+        for (CtBvh::Node node : blas.bvh.getNodes())
+        {
+            node.leftFirst += node.isLeaf() ? blas.triangleOffset : blas.nodeOffset;
+            nodes.push_back(node);
+        }
+        triangles.insert(triangles.end(), blas.triangles.cbegin(), blas.triangles.cend());
+    }
+}
+
+CtBvh::Hit CtAccelerationStructure::intersect(
+    const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax) const noexcept
+{
+    CtBvh::Hit hit;
+    hit.t = tMax;
+    m_tlas.traverse(origin, direction, hit, [&](const uint32_t instanceSlot, CtBvh::Hit& currentHit) {
+        const Instance& instance = m_instances[instanceSlot];
+        const glm::mat4 worldToObject =
+            glm::transpose(glm::mat4(instance.worldToObject[0], instance.worldToObject[1],
+                instance.worldToObject[2], glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)));
+        // The direction is not normalised so hit distances remain valid in world space
+        const glm::vec3 objectOrigin    = glm::vec3(worldToObject * glm::vec4(origin, 1.0f));
+        const glm::vec3 objectDirection = glm::vec3(worldToObject * glm::vec4(direction, 0.0f));
+        for (const Blas& blas : m_blases)
+        {
+            if (blas.nodeOffset != instance.blasRoot || blas.bvh.getNodes().empty())
+            {
+                continue;
+            }
+            blas.bvh.traverse(objectOrigin, objectDirection, currentHit,
+                [&](const uint32_t primitive, CtBvh::Hit& blasHit) {
+                    if (CtBvh::intersectTriangle(blas.triangles[primitive], blas.triangleOffset + primitive,
+                            objectOrigin, objectDirection, tMin, blasHit))
+                    {
+                        blasHit.instance = instanceSlot;
+                    }
+                });
+            break;
+        }
+    });
+    return hit;
+}
+} // namespace Capsaicin
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "ct_bvh.h"
+
+namespace Capsaicin
+{
+/**
+ * Two-level acceleration structure built on the CPU.
+ * Each unique piece of geometry gets its own bottom level hierarchy (BLAS) in object space, these are
+ * referenced by a small top level hierarchy (TLAS) built over the world space bounds of the instances. Moving
+ * an instance only requires the TLAS to be rebuilt and deforming geometry only requires its BLAS to be refit.
+ */
+class CtAccelerationStructure
+{
+public:
+    /** Instance in the layout used for traversal, stored in TLAS leaf order. Must match CtBvhInstance. */
+    struct Instance
+    {
+        glm::vec4 worldToObject[3]; /**< Rows of the inverse instance transform */
+        uint32_t  blasRoot;         /**< Index of the BLAS root within the combined BLAS node list */
+        uint32_t  instanceIndex;    /**< Index of the scene instance */
+        uint32_t  padding[2];
+    };
+    static_assert(sizeof(Instance) == 64, "CtAccelerationStructure::Instance must match the GPU layout");
+
+    /** Description of an instance used to build the TLAS. */
+    struct InstanceDesc
+    {
+        glm::mat4 transform;     /**< Object to world transform */
+        uint32_t  blas;          /**< Index of the referenced BLAS */
+        uint32_t  instanceIndex; /**< Index of the scene instance */
+    };
+
+    /** Release all BLASes and the TLAS. */
+    void clear() noexcept;
+
+    /**
+     * Add a new BLAS.
+     * @param triangles The object space triangles of the geometry.
+     * @return The index of the new BLAS.
+     */
+    uint32_t addBlas(std::vector<CtBvh::Triangle>&& triangles) noexcept;
+
+    /**
+     * Build all BLASes that were added since the last call in parallel.
+     */
+    void buildBlases() noexcept;
+
+    /**
+     * Refit an existing BLAS to deformed geometry, the topology of the hierarchy is retained.
+     * @tparam GetTriangle Type of function returning the new vertices of a triangle, called as
+     *                     getTriangle(primitiveIndex, glm::vec3 (&vertices)[3]).
+     * @param blas        The index of the BLAS to refit.
+     * @param getTriangle Function used to get the updated triangle vertices.
+     */
+    template<typename GetTriangle>
+    void refitBlas(uint32_t blas, GetTriangle&& getTriangle) noexcept
+    {
+        Blas&                      blasData = m_blases[blas];
+        std::vector<CtBvh::Bounds> bounds(blasData.triangles.size());
+        for (size_t i = 0; i < blasData.triangles.size(); ++i)
+        {
+            CtBvh::Triangle& triangle = blasData.triangles[i];
+            glm::vec3        vertices[3];
+            getTriangle(triangle.primitiveIndex, vertices);
+            triangle.v0 = vertices[0];
+            triangle.e1 = vertices[1] - vertices[0];
+            triangle.e2 = vertices[2] - vertices[0];
+            bounds[i]   = triangle.getBounds();
+        }
+        blasData.bvh.refit(bounds.data());
+    }
+
+    /**
+     * Build the TLAS over a set of instances.
+     * @param instances The instances to add, every referenced BLAS must have been built. Instances of
+     *                  empty BLASes are skipped.
+     */
+    void buildTlas(const std::vector<InstanceDesc>& instances) noexcept;
+
+    /**
+     * Gets the nodes and triangles of all BLASes combined into single lists.
+     * Child and primitive indices are made absolute so the lists can be uploaded directly.
+     * @param [out] nodes     The combined BLAS nodes.
+     * @param [out] triangles The combined triangles in leaf order.
+     */
+    void getBlasData(std::vector<CtBvh::Node>& nodes, std::vector<CtBvh::Triangle>& triangles) const noexcept;
+
+    [[nodiscard]] const std::vector<CtBvh::Node>& getTlasNodes() const noexcept { return m_tlas.getNodes(); }
+
+    [[nodiscard]] const std::vector<Instance>& getInstances() const noexcept { return m_instances; }
+
+    [[nodiscard]] uint32_t getBlasCount() const noexcept { return static_cast<uint32_t>(m_blases.size()); }
+
+    /**
+     * Find the closest intersection along a world space ray.
+     * This is a CPU reference of the GPU traversal in ct_bvh.hlsl.
+     * @return The closest hit, hit.instance is the instance slot and hit.primitive the slot within the
+     *         combined triangle list (both invalid if nothing was hit).
+     */
+    [[nodiscard]] CtBvh::Hit intersect(
+        const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax) const noexcept;
+
+private:
+    struct Blas
+    {
+        CtBvh                        bvh;
+        std::vector<CtBvh::Triangle> triangles;
+        uint32_t                     nodeOffset     = 0u; /**< Offset of the root within the combined nodes */
+        uint32_t                     triangleOffset = 0u; /**< Offset within the combined triangles */
+        bool                         built          = false;
+    };
+
+    std::vector<Blas>     m_blases;
+    CtBvh                 m_tlas;
+    std::vector<Instance> m_instances;
+};
+} // namespace Capsaicin
@@ -0,0 +1,430 @@
+#include "ct_bvh.h"
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace
+{
+using Bounds = Capsaicin::CtBvh::Bounds;
+using Node   = Capsaicin::CtBvh::Node;
+
+constexpr uint32_t BIN_COUNT           = 16u;
+constexpr float    TRAVERSAL_COST      = 1.0f;
+// Nodes with at least this many primitives bin their primitives in parallel.
+constexpr uint32_t PARALLEL_BIN_SIZE   = 64u * 1024u;
+// Nodes with fewer primitives than this are built as independent subtrees in parallel.
+constexpr uint32_t PARALLEL_SUBTREE_SIZE = 16u * 1024u;
+
+struct Bin
+{
+    Bounds   bounds;
+    uint32_t count = 0u;
+};
+
+using Bins = std::array<Bin, 3u * BIN_COUNT>;
+
+// Only go wide for large inputs so that building many small hierarchies concurrently does not oversubscribe.
+template<typename Func>
+void forEachPrimitive(uint32_t count, const Func& func)
+{
+    if (count < PARALLEL_BIN_SIZE)
+    {
+        for (uint32_t i = 0u; i < count; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+    Capsaicin::ParallelFor(0u, count, func);
+}
+
+struct RangeBounds
+{
+    Bounds bounds;
+    Bounds centroidBounds;
+};
+
+struct Split
+{
+    uint32_t axis = 0u;
+    uint32_t bin  = 0u;
+    float    cost = std::numeric_limits<float>::max();
+};
+
+/** Shared state used while building a hierarchy. */
+struct BuildContext
+{
+    const Bounds*          bounds;
+    std::vector<glm::vec3> centroids;
+    uint32_t*              indices;
+    uint32_t               maxLeafSize;
+};
+
+uint32_t getBin(const glm::vec3& centroid, const Bounds& centroidBounds, uint32_t axis)
+{
+    const float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+    const float scale  = static_cast<float>(BIN_COUNT) / extent;
+    const auto  bin    = static_cast<uint32_t>((centroid[axis] - centroidBounds.min[axis]) * scale);
+    return std::min(bin, BIN_COUNT - 1u);
+}
+
+RangeBounds computeBounds(const BuildContext& context, uint32_t first, uint32_t count)
+{
+    const auto reduce = [&context](const uint32_t* start, const uint32_t* end, RangeBounds result) {
+        for (const uint32_t* index = start; index < end; ++index)
+        {
+            result.bounds.grow(context.bounds[*index]);
+            result.centroidBounds.grow(context.centroids[*index]);
+        }
+        return result;
+    };
+    if (count < PARALLEL_BIN_SIZE)
+    {
+        return reduce(context.indices + first, context.indices + first + count, RangeBounds());
+    }
+    return Capsaicin::ParallelReduce(context.indices + first, count, RangeBounds(), reduce,
+        [](RangeBounds left, const RangeBounds& right) {
+            left.bounds.grow(right.bounds);
+            left.centroidBounds.grow(right.centroidBounds);
+            return left;
+        });
+}
+
+Split findSplit(const BuildContext& context, uint32_t first, uint32_t count, const RangeBounds& range)
+{
+    const auto reduce = [&context, &range](const uint32_t* start, const uint32_t* end, Bins bins) {
+        for (uint32_t axis = 0u; axis < 3u; ++axis)
+        {
+            if (range.centroidBounds.max[axis] <= range.centroidBounds.min[axis])
+            {
+                continue;
+            }
+            for (const uint32_t* index = start; index < end; ++index)
+            {
+                const uint32_t binIndex = getBin(context.centroids[*index], range.centroidBounds, axis);
+                Bin&           bin      = bins[axis * BIN_COUNT + binIndex];
+                bin.bounds.grow(context.bounds[*index]);
+                ++bin.count;
+            }
+        }
+        return bins;
+    };
+    Bins bins;
+    if (count < PARALLEL_BIN_SIZE)
+    {
+        bins = reduce(context.indices + first, context.indices + first + count, Bins());
+    }
+    else
+    {
+        const auto combine = [](Bins left, const Bins& right) {
+            for (uint32_t i = 0u; i < left.size(); ++i)
+            {
+                left[i].bounds.grow(right[i].bounds);
+                left[i].count += right[i].count;
+            }
+            return left;
+        };
+        bins = Capsaicin::ParallelReduce(context.indices + first, count, Bins(), reduce, combine);
+    }
+
+    // Sweep the bins of each axis to evaluate the SAH cost of each split plane
+    Split       best;
+    const float invArea = 1.0f / std::max(range.bounds.getSurfaceArea(), std::numeric_limits<float>::min());
+    for (uint32_t axis = 0u; axis < 3u; ++axis)
+    {
+        if (range.centroidBounds.max[axis] <= range.centroidBounds.min[axis])
+        {
+            continue;
+        }
+        std::array<float, BIN_COUNT - 1u> leftCost {};
+        Bounds                            leftBounds;
+        uint32_t                          leftCount = 0u;
+        for (uint32_t i = 0u; i < BIN_COUNT - 1u; ++i)
+        {
+            const Bin& bin = bins[axis * BIN_COUNT + i];
+            leftBounds.grow(bin.bounds);
+            leftCount += bin.count;
+            leftCost[i] = leftCount > 0u ? leftBounds.getSurfaceArea() * static_cast<float>(leftCount) : 0.0f;
+        }
+        Bounds   rightBounds;
+        uint32_t rightCount = 0u;
+        for (uint32_t i = BIN_COUNT - 1u; i > 0u; --i)
+        {
+            const Bin& bin = bins[axis * BIN_COUNT + i];
+            rightBounds.grow(bin.bounds);
+            rightCount += bin.count;
+            if (rightCount == 0u || rightCount == count)
+            {
+                continue;
+            }
+            const float rightCost = rightBounds.getSurfaceArea() * static_cast<float>(rightCount);
+            const float cost      = TRAVERSAL_COST + (leftCost[i - 1u] + rightCost) * invArea;
+            if (cost < best.cost)
+            {
+                best = {axis, i, cost};
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * Split a node range into two children.
+ * @return The number of primitives in the left child, 0 if the node should be a leaf.
+ */
+uint32_t splitNode(BuildContext& context, uint32_t first, uint32_t count, const RangeBounds& range)
+{
+    if (count <= 1u)
+    {
+        return 0u;
+    }
+    const Split split = findSplit(context, first, count, range);
+    if (split.cost >= static_cast<float>(count))
+    {
+        if (count <= context.maxLeafSize)
+        {
+            return 0u;
+        }
+        if (split.cost == std::numeric_limits<float>::max())
+        {
+            // All centroids are coincident so just split the range in half
+            return count / 2u;
+        }
+    }
+    uint32_t* const begin = context.indices + first;
+    const uint32_t* middle =
+        std::partition(begin, begin + count, [&context, &range, &split](const uint32_t index) {
+            return getBin(context.centroids[index], range.centroidBounds, split.axis) < split.bin;
+        });
+    return static_cast<uint32_t>(middle - begin);
+}
+
+void setNodeBounds(Node& node, const Bounds& bounds)
+{
+    node.boundsMin = bounds.min;
+    node.boundsMax = bounds.max;
+}
+
+/**
+ * Build a subtree serially.
+ * @param nodes The node list, nodes[rootIndex] must already exist.
+ */
+void buildSubtree(BuildContext& context, std::vector<Node>& nodes, uint32_t rootIndex, uint32_t first,
+    uint32_t count, const RangeBounds& rootRange)
+{
+    struct Task
+    {
+        uint32_t    node;
+        uint32_t    first;
+        uint32_t    count;
+        RangeBounds range;
+    };
+    std::vector<Task> tasks = {{rootIndex, first, count, rootRange}};
+    while (!tasks.empty())
+    {
+        const Task task = tasks.back();
+        tasks.pop_back();
+        setNodeBounds(nodes[task.node], task.range.bounds);
+
+        const uint32_t leftCount = splitNode(context, task.first, task.count, task.range);
+        if (leftCount == 0u)
+        {
+            nodes[task.node].leftFirst      = task.first;
+            nodes[task.node].primitiveCount = task.count;
+            continue;
+        }
+        const auto leftChild            = static_cast<uint32_t>(nodes.size());
+        nodes[task.node].leftFirst      = leftChild;
+        nodes[task.node].primitiveCount = 0u;
+        nodes.resize(nodes.size() + 2u);
+        tasks.push_back({leftChild + 1u, task.first + leftCount, task.count - leftCount,
+            computeBounds(context, task.first + leftCount, task.count - leftCount)});
+        tasks.push_back({leftChild, task.first, leftCount, computeBounds(context, task.first, leftCount)});
+    }
+}
+} // namespace
+
+namespace Capsaicin
+{
+void CtBvh::build(const Bounds* bounds, uint32_t count, uint32_t maxLeafSize) noexcept
+{
+    clear();
+    if (count == 0u)
+    {
+        return;
+    }
+    m_primitiveIndices.resize(count);
+    std::iota(m_primitiveIndices.begin(), m_primitiveIndices.end(), 0u);
+
+    BuildContext context = {bounds, std::vector<glm::vec3>(count), m_primitiveIndices.data(), maxLeafSize};
+    forEachPrimitive(count, [&](const uint32_t i) { context.centroids[i] = bounds[i].getCentroid(); });
+
+    // Split the top of the tree until the remaining nodes are small enough to be built independently
+    struct Subtree
+    {
+        uint32_t          node;
+        uint32_t          first;
+        uint32_t          count;
+        RangeBounds       range;
+        std::vector<Node> nodes;
+    };
+    std::vector<Subtree> subtrees;
+    std::vector<Subtree> pending = {{0u, 0u, count, computeBounds(context, 0u, count), {}}};
+    m_nodes.resize(1);
+    while (!pending.empty())
+    {
+        Subtree task = std::move(pending.back());
+        pending.pop_back();
+        if (task.count < PARALLEL_SUBTREE_SIZE)
+        {
+            subtrees.push_back(std::move(task));
+            continue;
+        }
+        setNodeBounds(m_nodes[task.node], task.range.bounds);
+        const uint32_t leftCount = splitNode(context, task.first, task.count, task.range);
+        if (leftCount == 0u)
+        {
+            m_nodes[task.node].leftFirst      = task.first;
+            m_nodes[task.node].primitiveCount = task.count;
+            continue;
+        }
+        const auto leftChild              = static_cast<uint32_t>(m_nodes.size());
+        m_nodes[task.node].leftFirst      = leftChild;
+        m_nodes[task.node].primitiveCount = 0u;
+        m_nodes.resize(m_nodes.size() + 2u);
+        pending.push_back({leftChild + 1u, task.first + leftCount, task.count - leftCount,
+            computeBounds(context, task.first + leftCount, task.count - leftCount), {}});
+        pending.push_back(
+            {leftChild, task.first, leftCount, computeBounds(context, task.first, leftCount), {}});
+    }
+
+    // Build the remaining subtrees in parallel, each into its own node list
+    ParallelFor(0u, static_cast<uint32_t>(subtrees.size()), [&](const uint32_t i) {
+        Subtree& subtree = subtrees[i];
+        subtree.nodes.resize(1);
+        buildSubtree(context, subtree.nodes, 0u, subtree.first, subtree.count, subtree.range);
+    });
+
+    // Append the subtrees to the node list, the subtree root replaces its placeholder node
+    for (const Subtree& subtree : subtrees)
+    {
+        const auto base = static_cast<uint32_t>(m_nodes.size()) - 1u;
+        for (uint32_t i = 0u; i < subtree.nodes.size(); ++i)
+        {
+            Node node = subtree.nodes[i];
+            if (!node.isLeaf())
+            {
+                node.leftFirst += base;
+            }
+            if (i == 0u)
+            {
+                m_nodes[subtree.node] = node;
+            }
+            else
+            {
+                m_nodes.push_back(node);
+            }
+        }
+    }
+}
+
+void CtBvh::build(std::vector<Triangle>& triangles) noexcept
+{
+    const auto          count = static_cast<uint32_t>(triangles.size());
+    std::vector<Bounds> bounds(count);
+    forEachPrimitive(count, [&](const uint32_t i) { bounds[i] = triangles[i].getBounds(); });
+    build(bounds.data(), count);
+
+    std::vector<Triangle> ordered(count);
+    forEachPrimitive(count, [&](const uint32_t i) { ordered[i] = triangles[m_primitiveIndices[i]]; });
+    triangles.swap(ordered);
+}
+
+void CtBvh::refit(const Bounds* bounds) noexcept
+{
+    // Children are always stored after their parent so a reverse sweep visits them first
+    for (auto node = m_nodes.rbegin(); node != m_nodes.rend(); ++node)
+    {
+        Bounds nodeBounds;
+        if (node->isLeaf())
+        {
+            for (uint32_t i = 0u; i < node->primitiveCount; ++i)
+            {
+                nodeBounds.grow(bounds[node->leftFirst + i]);
+            }
+        }
+        else
+        {
+            nodeBounds.grow(Bounds {m_nodes[node->leftFirst].boundsMin, m_nodes[node->leftFirst].boundsMax});
+            nodeBounds.grow(
+                Bounds {m_nodes[node->leftFirst + 1u].boundsMin, m_nodes[node->leftFirst + 1u].boundsMax});
+        }
+        setNodeBounds(*node, nodeBounds);
+    }
+}
+
+void CtBvh::clear() noexcept
+{
+    m_nodes.clear();
+    m_primitiveIndices.clear();
+}
+
+CtBvh::Hit CtBvh::intersect(const std::vector<Triangle>& triangles, const glm::vec3& origin,
+    const glm::vec3& direction, float tMin, float tMax) const noexcept
+{
+    Hit hit;
+    hit.t = tMax;
+    traverse(origin, direction, hit, [&](const uint32_t primitive, Hit& currentHit) {
+        intersectTriangle(triangles[primitive], primitive, origin, direction, tMin, currentHit);
+    });
+    return hit;
+}
+
+float CtBvh::intersectBounds(
+    const Node& node, const glm::vec3& origin, const glm::vec3& invDirection, float tMax) noexcept
+{
+    const glm::vec3 t0    = (node.boundsMin - origin) * invDirection;
+    const glm::vec3 t1    = (node.boundsMax - origin) * invDirection;
+    const glm::vec3 tNear = glm::min(t0, t1);
+    const glm::vec3 tFar  = glm::max(t0, t1);
+    const float     entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    const float     exit  = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tMax));
+    return entry <= exit ? entry : std::numeric_limits<float>::max();
+}
+
+bool CtBvh::intersectTriangle(const Triangle& triangle, uint32_t primitive, const glm::vec3& origin,
+    const glm::vec3& direction, float tMin, Hit& hit) noexcept
+{
+    const glm::vec3 p           = glm::cross(direction, triangle.e2);
+    const float     determinant = glm::dot(triangle.e1, p);
+    if (glm::abs(determinant) < std::numeric_limits<float>::epsilon())
+    {
+        return false;
+    }
+    const float     invDeterminant = 1.0f / determinant;
+    const glm::vec3 s              = origin - triangle.v0;
+    const float     u              = glm::dot(s, p) * invDeterminant;
+    if (u < 0.0f || u > 1.0f)
+    {
+        return false;
+    }
+    const glm::vec3 q = glm::cross(s, triangle.e1);
+    const float     v = glm::dot(direction, q) * invDeterminant;
+    if (v < 0.0f || u + v > 1.0f)
+    {
+        return false;
+    }
+    const float t = glm::dot(triangle.e2, q) * invDeterminant;
+    if (t < tMin || t >= hit.t)
+    {
+        return false;
+    }
+    hit.t            = t;
+    hit.barycentrics = glm::vec2(u, v);
+    hit.primitive    = primitive;
+    return true;
+}
+} // namespace Capsaicin
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * Bounding volume hierarchy built on the CPU using binned SAH.
+ * The hierarchy is stored as a flattened BVH2 where the children of an interior node are always stored next
+ * to each other. The node layout matches CtBvhNode in shared.h so the node array can be uploaded directly.
+ */
+class CtBvh
+{
+public:
+    /** Maximum traversal stack depth, must match ct_bvh.hlsl. */
+    static constexpr uint32_t STACK_SIZE = 64u;
+
+    /** Default maximum number of primitives in a leaf. */
+    static constexpr uint32_t MAX_LEAF_SIZE = 8u;
+
+    /** Axis aligned bounding box. */
+    struct Bounds
+    {
+        glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+
+        void grow(const glm::vec3& point) noexcept
+        {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+
+        void grow(const Bounds& bounds) noexcept
+        {
+            min = glm::min(min, bounds.min);
+            max = glm::max(max, bounds.max);
+        }
+
+        [[nodiscard]] glm::vec3 getCentroid() const noexcept { return 0.5f * (min + max); }
+
+        [[nodiscard]] float getSurfaceArea() const noexcept
+        {
+            const glm::vec3 extent = glm::max(max - min, glm::vec3(0.0f));
+            return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+        }
+    };
+
+    /** Flattened BVH node. */
+    struct Node
+    {
+        glm::vec3 boundsMin;
+        uint32_t  leftFirst; /**< Index of the left child (interior) or of the first primitive (leaf) */
+        glm::vec3 boundsMax;
+        uint32_t  primitiveCount; /**< Number of primitives in a leaf, 0 for interior nodes */
+
+        [[nodiscard]] bool isLeaf() const noexcept { return primitiveCount > 0; }
+    };
+    static_assert(sizeof(Node) == 32, "CtBvh::Node must match the GPU node layout");
+
+    /** Triangle in the layout used for traversal, stored in leaf order. */
+    struct Triangle
+    {
+        glm::vec3 v0;
+        uint32_t  primitiveIndex; /**< Index of the triangle within its mesh */
+        glm::vec3 e1;             /**< Edge v1 - v0 */
+        uint32_t  padding0;
+        glm::vec3 e2; /**< Edge v2 - v0 */
+        uint32_t  padding1;
+
+        [[nodiscard]] Bounds getBounds() const noexcept
+        {
+            Bounds bounds;
+            bounds.grow(v0);
+            bounds.grow(v0 + e1);
+            bounds.grow(v0 + e2);
+            return bounds;
+        }
+    };
+    static_assert(sizeof(Triangle) == 48, "CtBvh::Triangle must match the GPU triangle layout");
+
+    /** Closest hit result of a ray query. */
+    struct Hit
+    {
+        float     t            = std::numeric_limits<float>::max();
+        glm::vec2 barycentrics = glm::vec2(0.0f); /**< Barycentrics of v1 and v2 */
+        uint32_t  primitive    = std::numeric_limits<uint32_t>::max(); /**< Primitive slot in leaf order */
+        uint32_t  instance     = std::numeric_limits<uint32_t>::max(); /**< Instance slot (two-level only) */
+    };
+
+    /**
+     * Build the hierarchy over a set of primitives.
+     * Large nodes are binned in parallel and independent subtrees are built in parallel, the result is
+     * deterministic regardless of thread count.
+     * @param bounds      The bounding box of each primitive.
+     * @param count       Number of primitives.
+     * @param maxLeafSize Maximum number of primitives in a leaf.
+     */
+    void build(const Bounds* bounds, uint32_t count, uint32_t maxLeafSize = MAX_LEAF_SIZE) noexcept;
+
+    /**
+     * Build the hierarchy over a set of triangles.
+     * @param triangles The triangles to build over, these are re-ordered into leaf order.
+     */
+    void build(std::vector<Triangle>& triangles) noexcept;
+
+    /**
+     * Update the node bounds without changing the topology, used when primitives have moved.
+     * @param bounds The bounding box of each primitive in leaf order.
+     */
+    void refit(const Bounds* bounds) noexcept;
+
+    /** Release all nodes. */
+    void clear() noexcept;
+
+    /**
+     * Find the closest intersection along a ray by traversing the hierarchy.
+     * This is a CPU reference of the GPU traversal in ct_bvh.hlsl.
+     * @tparam Intersect Type of primitive intersection function, called as intersect(primitive, hit) and
+     *                   should update hit if a closer intersection is found.
+     * @param origin    The ray origin.
+     * @param direction The ray direction.
+     * @param hit       The closest hit, hit.t should be initialised to the maximum ray distance.
+     * @param intersect The primitive intersection function.
+     */
+    template<typename Intersect>
+    void traverse(const glm::vec3& origin, const glm::vec3& direction, Hit& hit, Intersect&& intersect) const
+    {
+        const glm::vec3 invDirection = 1.0f / direction;
+        if (m_nodes.empty()
+            || intersectBounds(m_nodes[0], origin, invDirection, hit.t) == std::numeric_limits<float>::max())
+        {
+            return;
+        }
+        uint32_t        stack[STACK_SIZE];
+        uint32_t        stackSize = 0;
+        uint32_t        nodeIndex = 0;
+        while (true)
+        {
+            const Node& node = m_nodes[nodeIndex];
+            if (node.isLeaf())
+            {
+                for (uint32_t i = 0; i < node.primitiveCount; ++i)
+                {
+                    intersect(node.leftFirst + i, hit);
+                }
+            }
+            else
+            {
+                // Visit the nearest child first and defer the other one
+                float nearT = intersectBounds(m_nodes[node.leftFirst], origin, invDirection, hit.t);
+                float farT  = intersectBounds(m_nodes[node.leftFirst + 1], origin, invDirection, hit.t);
+                uint32_t nearChild = node.leftFirst;
+                uint32_t farChild  = node.leftFirst + 1;
+                if (farT < nearT)
+                {
+                    std::swap(nearT, farT);
+                    std::swap(nearChild, farChild);
+                }
+                if (nearT < hit.t)
+                {
+                    if (farT < hit.t && stackSize < STACK_SIZE)
+                    {
+                        stack[stackSize++] = farChild;
+                    }
+                    nodeIndex = nearChild;
+                    continue;
+                }
+            }
+            if (stackSize == 0)
+            {
+                break;
+            }
+            nodeIndex = stack[--stackSize];
+        }
+    }
+
+    /**
+     * Find the closest intersection with the triangles passed to build.
+     * @param triangles The triangles in leaf order.
+     * @param origin    The ray origin.
+     * @param direction The ray direction.
+     * @param tMin      The minimum hit distance.
+     * @param tMax      The maximum hit distance.
+     * @return The closest hit (hit.primitive is invalid if nothing was hit).
+     */
+    [[nodiscard]] Hit intersect(const std::vector<Triangle>& triangles, const glm::vec3& origin,
+        const glm::vec3& direction, float tMin, float tMax) const noexcept;
+
+    /**
+     * Intersect a ray with a bounding box.
+     * @return The entry distance or float max if the box is missed.
+     */
+    [[nodiscard]] static float intersectBounds(
+        const Node& node, const glm::vec3& origin, const glm::vec3& invDirection, float tMax) noexcept;
+
+    /**
+     * Intersect a ray with a triangle (Moller-Trumbore, no back-face culling).
+     * @return True if the triangle was hit within (tMin, hit.t), in which case hit is updated.
+     */
+    static bool intersectTriangle(const Triangle& triangle, uint32_t primitive, const glm::vec3& origin,
+        const glm::vec3& direction, float tMin, Hit& hit) noexcept;
+
+    [[nodiscard]] const std::vector<Node>& getNodes() const noexcept { return m_nodes; }
+
+    /**
+     * Gets the bounds of the whole hierarchy.
+     * @return The root node bounds (empty if nothing has been built).
+     */
+    [[nodiscard]] Bounds getBounds() const noexcept
+    {
+        return m_nodes.empty() ? Bounds() : Bounds {m_nodes[0].boundsMin, m_nodes[0].boundsMax};
+    }
+
+    /**
+     * Gets the primitive order of the leaves.
+     * @return List mapping each leaf primitive slot to the index of the primitive passed to build.
+     */
+    [[nodiscard]] const std::vector<uint32_t>& getPrimitiveIndices() const noexcept
+    {
+        return m_primitiveIndices;
+    }
+
+private:
+    std::vector<Node>     m_nodes;
+    std::vector<uint32_t> m_primitiveIndices;
+};
+} // namespace Capsaicin
@@ -0,0 +1,179 @@
+#ifndef CT_BVH_HLSL
+#define CT_BVH_HLSL
+
+#include "shared.h"
+#include "math/math_constants.hlsl"
+
+// Must match CtBvh::STACK_SIZE.
+#define CT_BVH_STACK_SIZE 64
+
+StructuredBuffer<CtBvhNode> g_TlasNodes;
+StructuredBuffer<CtBvhInstance> g_BvhInstances; // In TLAS leaf order.
+StructuredBuffer<CtBvhNode> g_BlasNodes;        // All BLASes, child and primitive indices are absolute.
+StructuredBuffer<CtBvhTriangle> g_BvhTriangles; // Object space triangles of all BLASes in leaf order.
+
+struct CtBvhHit
+{
+    float t;
+    float2 barycentrics; // Barycentrics of v1 and v2.
+    uint primitive;      // Triangle slot in leaf order.
+    uint instance;       // Instance slot in TLAS leaf order.
+};
+
+// Returns the entry distance or FLT_MAX if the box is missed.
+float intersectBounds(CtBvhNode node, float3 origin, float3 invDirection, float tMax)
+{
+    float3 t0 = (node.boundsMin - origin) * invDirection;
+    float3 t1 = (node.boundsMax - origin) * invDirection;
+    float3 tNear = min(t0, t1);
+    float3 tFar = max(t0, t1);
+    float entry = max(max(tNear.x, tNear.y), max(tNear.z, 0.0f));
+    float exit = min(min(tFar.x, tFar.y), min(tFar.z, tMax));
+    return entry <= exit ? entry : FLT_MAX;
+}
+
+// Moller-Trumbore without back-face culling, updates hit if closer than the current hit.
+bool intersectTriangle(CtBvhTriangle tri, uint primitive, float3 origin, float3 direction, float tMin, inout CtBvhHit hit)
+{
+    float3 p = cross(direction, tri.e2);
+    float determinant = dot(tri.e1, p);
+    if (abs(determinant) < FLT_EPSILON)
+    {
+        return false;
+    }
+    float invDeterminant = 1.0f / determinant;
+    float3 s = origin - tri.v0;
+    float u = dot(s, p) * invDeterminant;
+    if (u < 0.0f || u > 1.0f)
+    {
+        return false;
+    }
+    float3 q = cross(s, tri.e1);
+    float v = dot(direction, q) * invDeterminant;
+    if (v < 0.0f || u + v > 1.0f)
+    {
+        return false;
+    }
+    float t = dot(tri.e2, q) * invDeterminant;
+    if (t < tMin || t >= hit.t)
+    {
+        return false;
+    }
+    hit.t = t;
+    hit.barycentrics = float2(u, v);
+    hit.primitive = primitive;
+    return true;
+}
+
+// Two-level stack based closest hit traversal, mirrors CtAccelerationStructure::intersect.
+// Both levels share one stack, entries above the TLAS stack size when entering an instance belong to its BLAS.
+CtBvhHit traceBvh(float3 origin, float3 direction, float tMin, float tMax)
+{
+    CtBvhHit hit;
+    hit.t = tMax;
+    hit.barycentrics = 0.0f;
+    hit.primitive = 0xFFFFFFFFu;
+    hit.instance = 0xFFFFFFFFu;
+
+    float3 invDirection = 1.0f / direction;
+    if (intersectBounds(g_TlasNodes[0], origin, invDirection, hit.t) == FLT_MAX)
+    {
+        // This also handles empty scenes which only contain an empty root node.
+        return hit;
+    }
+    uint stack[CT_BVH_STACK_SIZE];
+    uint stackSize = 0;
+    uint nodeIndex = 0;
+    // Ray in the space of the level currently being traversed
+    float3 rayOrigin = origin;
+    float3 rayDirection = direction;
+    float3 rayInvDirection = invDirection;
+    uint instanceSlot = 0xFFFFFFFFu;
+    uint tlasStackSize = 0;
+    while (true)
+    {
+        CtBvhNode node = instanceSlot == 0xFFFFFFFFu ? g_TlasNodes[nodeIndex] : g_BlasNodes[nodeIndex];
+        if (node.primitiveCount > 0)
+        {
+            if (instanceSlot == 0xFFFFFFFFu)
+            {
+                // TLAS leaves contain a single instance, enter its BLAS in object space. The direction is not
+                // normalised so hit distances remain valid in world space.
+                instanceSlot = node.leftFirst;
+                CtBvhInstance instance = g_BvhInstances[instanceSlot];
+                float3x4 worldToObject = float3x4(instance.worldToObject0, instance.worldToObject1, instance.worldToObject2);
+                rayOrigin = mul(worldToObject, float4(origin, 1.0f));
+                rayDirection = mul(worldToObject, float4(direction, 0.0f));
+                rayInvDirection = 1.0f / rayDirection;
+                tlasStackSize = stackSize;
+                nodeIndex = instance.blasRoot;
+                if (intersectBounds(g_BlasNodes[nodeIndex], rayOrigin, rayInvDirection, hit.t) < hit.t)
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                for (uint i = 0; i < node.primitiveCount; ++i)
+                {
+                    uint primitive = node.leftFirst + i;
+                    if (intersectTriangle(g_BvhTriangles[primitive], primitive, rayOrigin, rayDirection, tMin, hit))
+                    {
+                        hit.instance = instanceSlot;
+                    }
+                }
+            }
+        }
+        else
+        {
+            // Visit the nearest child first and defer the other one.
+            uint nearChild = node.leftFirst;
+            uint farChild = node.leftFirst + 1;
+            float nearT, farT;
+            if (instanceSlot == 0xFFFFFFFFu)
+            {
+                nearT = intersectBounds(g_TlasNodes[nearChild], rayOrigin, rayInvDirection, hit.t);
+                farT = intersectBounds(g_TlasNodes[farChild], rayOrigin, rayInvDirection, hit.t);
+            }
+            else
+            {
+                nearT = intersectBounds(g_BlasNodes[nearChild], rayOrigin, rayInvDirection, hit.t);
+                farT = intersectBounds(g_BlasNodes[farChild], rayOrigin, rayInvDirection, hit.t);
+            }
+            if (farT < nearT)
+            {
+                float tempT = nearT;
+                nearT = farT;
+                farT = tempT;
+                uint tempChild = nearChild;
+                nearChild = farChild;
+                farChild = tempChild;
+            }
+            if (nearT < hit.t)
+            {
+                if (farT < hit.t && stackSize < CT_BVH_STACK_SIZE)
+                {
+                    stack[stackSize++] = farChild;
+                }
+                nodeIndex = nearChild;
+                continue;
+            }
+        }
+        if (instanceSlot != 0xFFFFFFFFu && stackSize == tlasStackSize)
+        {
+            // The BLAS is exhausted, continue with the TLAS in world space.
+            instanceSlot = 0xFFFFFFFFu;
+            rayOrigin = origin;
+            rayDirection = direction;
+            rayInvDirection = invDirection;
+        }
+        if (stackSize == 0)
+        {
+            break;
+        }
+        nodeIndex = stack[--stackSize];
+    }
+    return hit;
+}
+
+#endif // CT_BVH_HLSL
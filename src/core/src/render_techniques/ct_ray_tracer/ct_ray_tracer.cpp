@@ -3,8 +3,11 @@
 #include "capsaicin_internal.h"
 #include "shared.h"
 
+#include <cstring>
 #include <gpu_shared.h>
+#include <map>
 #include <string_view>
+#include <tuple>
 
 #define ENABLE_PIX 0
 
@@ -17,6 +20,69 @@ namespace
 {
 constexpr std::string_view RT_PROGRAM_NAME             = "render_techniques/ct_ray_tracer/ct_ray_tracer";
 constexpr std::string_view SHADE_VERTICES_PROGRAM_NAME = "render_techniques/ct_ray_tracer/shade_vertices";
+
+// Maximum number of thread groups in a single dispatch dimension.
+constexpr uint32_t MAX_DISPATCH_GROUPS = 65535u;
+
+// Synchronously copies ranges of a GPU buffer to the CPU, each range is given as {offset, size} in bytes and
+// the ranges are packed one after another in the result.
+std::vector<uint8_t> readbackBuffer(
+    GfxContext gfx, const GfxBuffer& buffer, const std::vector<std::pair<uint64_t, uint64_t>>& ranges)
+{
+    uint64_t totalSize = 0;
+    for (const auto& range : ranges)
+    {
+        totalSize += range.second;
+    }
+    std::vector<uint8_t> data(totalSize);
+    if (data.empty())
+    {
+        return data;
+    }
+    GfxBuffer readback = gfxCreateBuffer(gfx, totalSize, nullptr, kGfxCpuAccess_Read);
+    uint64_t  offset   = 0;
+    for (const auto& range : ranges)
+    {
+        if (range.second > 0)
+        {
+            gfxCommandCopyBuffer(gfx, readback, offset, buffer, range.first, range.second);
+        }
+        offset += range.second;
+    }
+    gfxFinish(gfx);
+    memcpy(data.data(), gfxBufferGetData(gfx, readback), data.size());
+    gfxDestroyBuffer(gfx, readback);
+    return data;
+}
+
+// Synchronously copies the contents of a GPU buffer to the CPU.
+std::vector<uint8_t> readbackBuffer(GfxContext gfx, const GfxBuffer& buffer)
+{
+    return readbackBuffer(gfx, buffer, {{0, buffer.getSize()}});
+}
+
+// Creates a structured buffer from a list, empty lists are replaced by a single default element so the
+// buffer can always be bound.
+template<typename TYPE>
+GfxBuffer createListBuffer(GfxContext gfx, std::vector<TYPE> data, const TYPE& emptyValue, const char* name)
+{
+    if (data.empty())
+    {
+        data.push_back(emptyValue);
+    }
+    GfxBuffer buffer = gfxCreateBuffer<TYPE>(gfx, static_cast<uint32_t>(data.size()), data.data());
+    buffer.setName(name);
+    return buffer;
+}
+
+// Node used to represent an empty hierarchy, its bounds can never be hit.
+Capsaicin::CtBvh::Node getEmptyNode()
+{
+    Capsaicin::CtBvh::Node emptyNode = {};
+    emptyNode.boundsMin              = glm::vec3(std::numeric_limits<float>::max());
+    emptyNode.boundsMax              = glm::vec3(-std::numeric_limits<float>::max());
+    return emptyNode;
+}
 } // namespace
 
 namespace Capsaicin
@@ -90,35 +156,43 @@ void CtRayTracer::render(CapsaicinInternal& capsaicin) noexcept
     uint32_t                             debugModeIndex =
         glm::clamp(newOptions.debugMode, 0u, static_cast<uint32_t>(DebugMode::Count) - 1);
 
-    if (!m_vertexCache)
+    if (!m_vertexCacheOffsetBuffer || capsaicin.getMeshesUpdated() || capsaicin.getInstancesUpdated())
     {
-        // Get a buffer for the shaded vertices.
-        m_vertexCache = gfxCreateBuffer<Vertex>(gfx_, capsaicin.getVertexBuffer().getCount());
-        m_vertexCache.setName("Vertex Cache");
+        buildVertexCacheLayout(capsaicin);
     }
 
-    const auto     scene        = capsaicin.getScene();
-    const uint32_t numInstances = gfxSceneGetInstanceCount(scene);
-    const auto*    instances    = gfxSceneGetInstances(scene);
-
-    // Per instance offset to the vertex cache data.
-    // It's needed for triangles traversing in the RT shader.
-    std::vector<uint32_t> vertexCacheOffset;
-    // Properly resize the cache offsets.
-    vertexCacheOffset.resize(numInstances);
-    uint32_t currentVertexCacheOffset = 0u;
+    // Geometry changes rebuild the BLASes, animation only refits them and any change to the instances or
+    // their transforms rebuilds the (small) TLAS.
+    const bool rebuildBlases =
+        !m_blasNodeBuffer || capsaicin.getMeshesUpdated() || capsaicin.getInstancesUpdated();
+    if (rebuildBlases)
+    {
+        buildBlases(capsaicin);
+    }
+    else if (capsaicin.getAnimationUpdated() && !m_animatedBlases.empty())
+    {
+        refitBlases(capsaicin);
+    }
+    if (rebuildBlases || capsaicin.getTransformsUpdated() || capsaicin.getAnimationUpdated())
+    {
+        buildTlas(capsaicin);
+    }
 
     // Vertices shading.
+    if (m_shadedVertexCount > 0u)
     {
         const auto& gpuVertexShadingConstants = capsaicin.allocateConstantBuffer<VertexShadingConstants>(1);
         {
             VertexShadingConstants drawConstants = {};
             drawConstants.view                   = capsaicin.getCameraMatrices().view;
+            drawConstants.numInstances           = m_shadedInstanceCount;
+            drawConstants.numVertices            = m_shadedVertexCount;
 
             gfxBufferGetData<VertexShadingConstants>(gfx_, gpuVertexShadingConstants)[0] = drawConstants;
         }
 
         gfxProgramSetParameter(gfx_, m_shadeVerticesProgram, "g_Constants", gpuVertexShadingConstants);
+        gfxProgramSetParameter(gfx_, m_shadeVerticesProgram, "g_InstanceData", m_instanceDataBuffer);
         gfxProgramSetParameter(gfx_, m_shadeVerticesProgram, "g_VertexCache", m_vertexCache);
         gfxProgramSetParameter(gfx_, m_shadeVerticesProgram, "g_InputVertices", capsaicin.getVertexBuffer());
         gfxProgramSetParameter(
@@ -130,29 +204,14 @@ void CtRayTracer::render(CapsaicinInternal& capsaicin) noexcept
         gfxCommandBindKernel(gfx_, m_shadeVerticesKernel);
         const uint32_t* groupSize = gfxKernelGetNumThreads(gfx_, m_shadeVerticesKernel);
 
-        for (uint32_t instanceId = 0u; instanceId < numInstances; ++instanceId)
+        // All instances are shaded by a single dispatch, it is only split when it would exceed the maximum
+        // dispatch size.
+        const uint32_t verticesPerDispatch = MAX_DISPATCH_GROUPS * groupSize[0];
+        for (uint32_t firstVertex = 0u; firstVertex < m_shadedVertexCount; firstVertex += verticesPerDispatch)
         {
-            const auto instance = instances[instanceId];
-            const auto meshInfo = capsaicin.getMeshInfo(static_cast<uint32_t>(instance.mesh));
-
-            InstanceData instanceData = {};
-            instanceData.instanceId   = instanceId;
-            instanceData.vertexOffset = currentVertexCacheOffset;
-            instanceData.numVertices  = meshInfo.vertex_count;
-            // TODO I can allocate one big buffer and then just set instance id on each iteration.
-            // will it be more performant?
-            const auto& gpuInstanceData = capsaicin.allocateConstantBuffer<InstanceData>(1);
-            gfxBufferGetData<InstanceData>(gfx_, gpuInstanceData)[0] = instanceData;
-
-            gfxProgramSetParameter(gfx_, m_shadeVerticesProgram, "g_InstanceData", gpuInstanceData);
-
-            const uint32_t groupCount = (meshInfo.vertex_count + groupSize[0] - 1u) / groupSize[0];
-            gfxCommandDispatch(gfx_, groupCount, 1, 1);
-            gfxDestroyBuffer(gfx_, gpuInstanceData);
-
-            // Track these numbers here to pass it to the RT pass.
-            vertexCacheOffset[instanceId] = currentVertexCacheOffset;
-            currentVertexCacheOffset += meshInfo.vertex_count;
+            const uint32_t vertexCount = std::min(m_shadedVertexCount - firstVertex, verticesPerDispatch);
+            gfxProgramSetParameter(gfx_, m_shadeVerticesProgram, "g_FirstVertex", firstVertex);
+            gfxCommandDispatch(gfx_, (vertexCount + groupSize[0] - 1u) / groupSize[0], 1, 1);
         }
         gfxDestroyBuffer(gfx_, gpuVertexShadingConstants);
     }
@@ -163,7 +222,8 @@ void CtRayTracer::render(CapsaicinInternal& capsaicin) noexcept
         const auto& gpuRtConstants = capsaicin.allocateConstantBuffer<RtConstants>(1);
         {
             RtConstants drawConstants    = {};
-            drawConstants.numInstances   = numInstances;
+            drawConstants.invView        = capsaicin.getCameraMatrices().inv_view;
+            drawConstants.numInstances   = gfxSceneGetInstanceCount(capsaicin.getScene());
             drawConstants.resolution     = {colorTexture.getWidth(), colorTexture.getHeight()};
             drawConstants.invResolution  = 1.0f / static_cast<glm::vec2>(drawConstants.resolution);
             drawConstants.lensDistortion = newOptions.lensDistortion;
@@ -172,16 +232,17 @@ void CtRayTracer::render(CapsaicinInternal& capsaicin) noexcept
             gfxBufferGetData<RtConstants>(gfx_, gpuRtConstants)[0] = drawConstants;
         }
 
-        const auto& gpuVertexCacheOffset = gfxCreateBuffer<uint32_t>(
-            gfx_, static_cast<uint32_t>(vertexCacheOffset.size()), vertexCacheOffset.data());
-
         {
             gfxProgramSetParameter(gfx_, m_rtProgram, "g_Constants", gpuRtConstants);
             gfxProgramSetParameter(gfx_, m_rtProgram, "g_VertexCache", m_vertexCache);
             gfxProgramSetParameter(gfx_, m_rtProgram, "g_InstanceBuffer", capsaicin.getInstanceBuffer());
             gfxProgramSetParameter(gfx_, m_rtProgram, "g_IndexBuffer", capsaicin.getIndexBuffer());
-            gfxProgramSetParameter(gfx_, m_rtProgram, "g_VertexOffsetBuffer", gpuVertexCacheOffset);
+            gfxProgramSetParameter(gfx_, m_rtProgram, "g_VertexOffsetBuffer", m_vertexCacheOffsetBuffer);
             gfxProgramSetParameter(gfx_, m_rtProgram, "g_MaterialBuffer", capsaicin.getMaterialBuffer());
+            gfxProgramSetParameter(gfx_, m_rtProgram, "g_TlasNodes", m_tlasNodeBuffer);
+            gfxProgramSetParameter(gfx_, m_rtProgram, "g_BvhInstances", m_bvhInstanceBuffer);
+            gfxProgramSetParameter(gfx_, m_rtProgram, "g_BlasNodes", m_blasNodeBuffer);
+            gfxProgramSetParameter(gfx_, m_rtProgram, "g_BvhTriangles", m_bvhTriangleBuffer);
             gfxProgramSetParameter(gfx_, m_rtProgram, "g_Output", capsaicin.getSharedTexture("Color"));
 
             gfxCommandBindKernel(gfx_, m_rtKernels[debugModeIndex]);
@@ -191,7 +252,6 @@ void CtRayTracer::render(CapsaicinInternal& capsaicin) noexcept
             gfxCommandDispatch(gfx_, groupCount.x, groupCount.y, 1u);
         }
 
-        gfxDestroyBuffer(gfx_, gpuVertexCacheOffset);
         gfxDestroyBuffer(gfx_, gpuRtConstants);
     }
 }
@@ -201,6 +261,220 @@ void CtRayTracer::terminate() noexcept
     // TODO remove members
     gfxDestroyBuffer(gfx_, m_vertexCache);
     m_vertexCache = {};
+    gfxDestroyBuffer(gfx_, m_instanceDataBuffer);
+    m_instanceDataBuffer = {};
+    gfxDestroyBuffer(gfx_, m_vertexCacheOffsetBuffer);
+    m_vertexCacheOffsetBuffer = {};
+    m_shadedInstanceCount     = 0u;
+    m_shadedVertexCount       = 0u;
+    gfxDestroyBuffer(gfx_, m_tlasNodeBuffer);
+    m_tlasNodeBuffer = {};
+    gfxDestroyBuffer(gfx_, m_bvhInstanceBuffer);
+    m_bvhInstanceBuffer = {};
+    gfxDestroyBuffer(gfx_, m_blasNodeBuffer);
+    m_blasNodeBuffer = {};
+    gfxDestroyBuffer(gfx_, m_bvhTriangleBuffer);
+    m_bvhTriangleBuffer = {};
+    m_accelerationStructure.clear();
+    m_instanceBlas.clear();
+    m_animatedBlases.clear();
+}
+
+void CtRayTracer::buildVertexCacheLayout(CapsaicinInternal& capsaicin) noexcept
+{
+    const auto     scene        = capsaicin.getScene();
+    const uint32_t numInstances = gfxSceneGetInstanceCount(scene);
+    const auto*    instances    = gfxSceneGetInstances(scene);
+
+    // Every instance gets its own range of the vertex cache, the ranges are the prefix sum of the instance
+    // vertex counts. Instances without vertices are not shaded.
+    std::vector<uint32_t>     vertexCacheOffsets(numInstances, 0u);
+    std::vector<InstanceData> instanceData;
+    instanceData.reserve(numInstances);
+    uint32_t vertexCount = 0u;
+    for (uint32_t instanceId = 0u; instanceId < numInstances; ++instanceId)
+    {
+        const auto& meshInfo = capsaicin.getMeshInfo(static_cast<uint32_t>(instances[instanceId].mesh));
+        vertexCacheOffsets[instanceId] = vertexCount;
+        if (meshInfo.vertex_count > 0u)
+        {
+            instanceData.push_back({instanceId, vertexCount, meshInfo.vertex_count, 0u});
+            vertexCount += meshInfo.vertex_count;
+        }
+    }
+    m_shadedInstanceCount = static_cast<uint32_t>(instanceData.size());
+    m_shadedVertexCount   = vertexCount;
+
+    gfxDestroyBuffer(gfx_, m_instanceDataBuffer);
+    m_instanceDataBuffer =
+        createListBuffer(gfx_, std::move(instanceData), InstanceData {}, "CtShadeVerticesInstanceData");
+    gfxDestroyBuffer(gfx_, m_vertexCacheOffsetBuffer);
+    m_vertexCacheOffsetBuffer =
+        createListBuffer(gfx_, std::move(vertexCacheOffsets), 0u, "CtVertexCacheOffsets");
+
+    // Get a buffer for the shaded vertices, this uses the same layout as the scene vertex buffer. Instanced
+    // meshes are shaded once per instance so this can be larger than the scene vertex buffer.
+    const uint32_t vertexStride = capsaicin.getVertexStride();
+    const uint64_t cacheSize    = std::max(static_cast<uint64_t>(vertexCount), 1ULL) * vertexStride;
+    if (!m_vertexCache || m_vertexCache.getSize() != cacheSize || m_vertexCache.getStride() != vertexStride)
+    {
+        gfxDestroyBuffer(gfx_, m_vertexCache);
+        m_vertexCache = gfxCreateBuffer(gfx_, cacheSize);
+        m_vertexCache.setStride(vertexStride);
+        m_vertexCache.setName("Vertex Cache");
+    }
+}
+
+void CtRayTracer::buildBlases(const CapsaicinInternal& capsaicin) noexcept
+{
+    const auto     scene        = capsaicin.getScene();
+    const uint32_t numInstances = gfxSceneGetInstanceCount(scene);
+    const auto&    instanceData = capsaicin.getInstanceData();
+
+    const std::vector<uint8_t> indexData  = readbackBuffer(gfx_, capsaicin.getIndexBuffer());
+    const std::vector<uint8_t> vertexData = readbackBuffer(gfx_, capsaicin.getVertexBuffer());
+    const auto*                indices    = reinterpret_cast<const uint32_t*>(indexData.data());
+    const uint32_t             vertexDataIndex = capsaicin.getVertexDataIndex();
+    const uint32_t             vertexStride    = capsaicin.getVertexStride();
+
+    // Every vertex layout stores the position in the first 3 floats.
+    const auto getPosition = [&](uint32_t vertexIndex) {
+        glm::vec3 position;
+        memcpy(
+            &position, vertexData.data() + static_cast<size_t>(vertexIndex) * vertexStride, sizeof(position));
+        return position;
+    };
+
+    // Instances referencing the same index range and vertex data share a BLAS.
+    m_accelerationStructure.clear();
+    m_animatedBlases.clear();
+    m_instanceBlas.assign(numInstances, std::numeric_limits<uint32_t>::max());
+    std::map<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>, uint32_t> blasMap;
+    for (uint32_t instanceId = 0u; instanceId < numInstances; ++instanceId)
+    {
+        const uint32_t instanceHandle = gfxSceneGetObjectHandle<GfxInstance>(scene, instanceId);
+        if (instanceHandle >= instanceData.size())
+        {
+            continue;
+        }
+        const Instance& instance = instanceData[instanceHandle];
+        const auto      key      = std::make_tuple(instance.index_offset_idx, instance.index_count,
+            instance.vertex_offset_idx[0], instance.vertex_offset_idx[1]);
+        if (const auto found = blasMap.find(key); found != blasMap.end())
+        {
+            m_instanceBlas[instanceId] = found->second;
+            continue;
+        }
+
+        const uint32_t               vertexOffset = instance.vertex_offset_idx[vertexDataIndex];
+        std::vector<CtBvh::Triangle> triangles(instance.index_count / 3u);
+        for (uint32_t primitive = 0u; primitive < static_cast<uint32_t>(triangles.size()); ++primitive)
+        {
+            const uint32_t*  index    = indices + instance.index_offset_idx + primitive * 3u;
+            const glm::vec3  v0       = getPosition(vertexOffset + index[0]);
+            CtBvh::Triangle& triangle = triangles[primitive];
+            triangle.v0               = v0;
+            triangle.primitiveIndex   = primitive;
+            triangle.e1               = getPosition(vertexOffset + index[1]) - v0;
+            triangle.padding0         = 0u;
+            triangle.e2               = getPosition(vertexOffset + index[2]) - v0;
+            triangle.padding1         = 0u;
+        }
+        const uint32_t blas        = m_accelerationStructure.addBlas(std::move(triangles));
+        blasMap[key]               = blas;
+        m_instanceBlas[instanceId] = blas;
+
+        if (instance.vertex_offset_idx[0] != instance.vertex_offset_idx[1])
+        {
+            // Animated vertices are double buffered, keep the topology so the BLAS can be refit later
+            AnimatedBlas animated   = {blas, instanceHandle, 0u, {}};
+            animated.indices.assign(indices + instance.index_offset_idx,
+                indices + instance.index_offset_idx + instance.index_count);
+            for (const uint32_t index : animated.indices)
+            {
+                animated.vertexCount = std::max(animated.vertexCount, index + 1u);
+            }
+            m_animatedBlases.push_back(std::move(animated));
+        }
+    }
+    m_accelerationStructure.buildBlases();
+    uploadBlases();
+}
+
+void CtRayTracer::refitBlases(const CapsaicinInternal& capsaicin) noexcept
+{
+    const auto&    instanceData    = capsaicin.getInstanceData();
+    const uint32_t vertexDataIndex = capsaicin.getVertexDataIndex();
+    const uint32_t vertexStride    = capsaicin.getVertexStride();
+
+    // Read back only the current animated vertex ranges
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+    ranges.reserve(m_animatedBlases.size());
+    for (const AnimatedBlas& animated : m_animatedBlases)
+    {
+        const uint32_t vertexOffset =
+            instanceData[animated.instanceHandle].vertex_offset_idx[vertexDataIndex];
+        ranges.emplace_back(static_cast<uint64_t>(vertexOffset) * vertexStride,
+            static_cast<uint64_t>(animated.vertexCount) * vertexStride);
+    }
+    const std::vector<uint8_t> vertexData = readbackBuffer(gfx_, capsaicin.getVertexBuffer(), ranges);
+
+    uint64_t rangeOffset = 0;
+    for (uint32_t i = 0u; i < static_cast<uint32_t>(m_animatedBlases.size()); ++i)
+    {
+        const AnimatedBlas& animated = m_animatedBlases[i];
+        const uint8_t*      vertices = vertexData.data() + rangeOffset;
+        rangeOffset += ranges[i].second;
+        m_accelerationStructure.refitBlas(
+            animated.blas, [&](const uint32_t primitive, glm::vec3(&positions)[3]) {
+                for (uint32_t vertex = 0u; vertex < 3u; ++vertex)
+                {
+                    const uint32_t index = animated.indices[primitive * 3u + vertex];
+                    memcpy(&positions[vertex], vertices + static_cast<size_t>(index) * vertexStride,
+                        sizeof(glm::vec3));
+                }
+            });
+    }
+    uploadBlases();
+}
+
+void CtRayTracer::buildTlas(const CapsaicinInternal& capsaicin) noexcept
+{
+    const auto     scene        = capsaicin.getScene();
+    const uint32_t numInstances = gfxSceneGetInstanceCount(scene);
+    const auto*    instances    = gfxSceneGetInstances(scene);
+
+    std::vector<CtAccelerationStructure::InstanceDesc> descs;
+    const uint32_t instanceCount = std::min(numInstances, static_cast<uint32_t>(m_instanceBlas.size()));
+    descs.reserve(instanceCount);
+    for (uint32_t instanceId = 0u; instanceId < instanceCount; ++instanceId)
+    {
+        if (m_instanceBlas[instanceId] != std::numeric_limits<uint32_t>::max())
+        {
+            descs.push_back({instances[instanceId].transform, m_instanceBlas[instanceId], instanceId});
+        }
+    }
+    m_accelerationStructure.buildTlas(descs);
+
+    // An empty scene is represented by a single empty root node.
+    gfxDestroyBuffer(gfx_, m_tlasNodeBuffer);
+    m_tlasNodeBuffer =
+        createListBuffer(gfx_, m_accelerationStructure.getTlasNodes(), getEmptyNode(), "CtTlasNodes");
+    gfxDestroyBuffer(gfx_, m_bvhInstanceBuffer);
+    m_bvhInstanceBuffer = createListBuffer(
+        gfx_, m_accelerationStructure.getInstances(), CtAccelerationStructure::Instance {}, "CtBvhInstances");
+}
+
+void CtRayTracer::uploadBlases() noexcept
+{
+    std::vector<CtBvh::Node>     nodes;
+    std::vector<CtBvh::Triangle> triangles;
+    m_accelerationStructure.getBlasData(nodes, triangles);
+    gfxDestroyBuffer(gfx_, m_blasNodeBuffer);
+    m_blasNodeBuffer = createListBuffer(gfx_, std::move(nodes), getEmptyNode(), "CtBlasNodes");
+    gfxDestroyBuffer(gfx_, m_bvhTriangleBuffer);
+    m_bvhTriangleBuffer =
+        createListBuffer(gfx_, std::move(triangles), CtBvh::Triangle {}, "CtBvhTriangles");
 }
 
 void CtRayTracer::renderGUI([[maybe_unused]] CapsaicinInternal& capsaicin) const noexcept {}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ct_acceleration_structure.h"
 #include "render_technique.h"
 
 #include <gfx_scene.h>
@@ -87,6 +88,37 @@ class CtRayTracer : public RenderTechnique
     void renderGUI(CapsaicinInternal& capsaicin) const noexcept override;
 
 protected:
+    /**
+     * Compute the vertex cache range of every instance and upload the vertex shading records.
+     * This only needs to be repeated when meshes or instances change.
+     * @param capsaicin The current capsaicin context.
+     */
+    void buildVertexCacheLayout(CapsaicinInternal& capsaicin) noexcept;
+
+    /**
+     * Build a BLAS for every unique piece of scene geometry and upload them.
+     * Instances of the same static mesh share a BLAS. The processed geometry only exists on the GPU so it is
+     * read back first.
+     * @param capsaicin The current capsaicin context.
+     */
+    void buildBlases(const CapsaicinInternal& capsaicin) noexcept;
+
+    /**
+     * Refit the BLASes of animated geometry to the current animated vertices and upload them.
+     * Only the animated vertex ranges are read back.
+     * @param capsaicin The current capsaicin context.
+     */
+    void refitBlases(const CapsaicinInternal& capsaicin) noexcept;
+
+    /**
+     * Build the TLAS over the current instance transforms and upload it.
+     * @param capsaicin The current capsaicin context.
+     */
+    void buildTlas(const CapsaicinInternal& capsaicin) noexcept;
+
+    /** Upload the combined BLAS nodes and triangles. */
+    void uploadBlases() noexcept;
+
     RenderOptions options;
 
     GfxProgram m_shadeVerticesProgram;
@@ -95,5 +127,26 @@ class CtRayTracer : public RenderTechnique
     std::array<GfxKernel, static_cast<uint32_t>(DebugMode::Count)> m_rtKernels;
 
     GfxBuffer m_vertexCache;
+    GfxBuffer m_instanceDataBuffer;      /**< Vertex shading record of each instance with vertices */
+    GfxBuffer m_vertexCacheOffsetBuffer; /**< Vertex cache offset of each scene instance */
+    uint32_t  m_shadedInstanceCount = 0u;
+    uint32_t  m_shadedVertexCount   = 0u;
+
+    /** BLAS of animated geometry that must be refit whenever the animated vertices change. */
+    struct AnimatedBlas
+    {
+        uint32_t              blas;
+        uint32_t              instanceHandle; /**< Any instance referencing the BLAS */
+        uint32_t              vertexCount;
+        std::vector<uint32_t> indices; /**< Triangle indices relative to the instance vertex offset */
+    };
+
+    CtAccelerationStructure   m_accelerationStructure;
+    std::vector<uint32_t>     m_instanceBlas; /**< BLAS index of each scene instance (invalid if none) */
+    std::vector<AnimatedBlas> m_animatedBlases;
+    GfxBuffer                 m_tlasNodeBuffer;
+    GfxBuffer                 m_bvhInstanceBuffer;
+    GfxBuffer                 m_blasNodeBuffer;
+    GfxBuffer                 m_bvhTriangleBuffer;
 };
 } // namespace Capsaicin
@@ -9,7 +9,7 @@
 
 #endif
 
-// Per draw call data
+// Vertex shading record of an instance, vertexOffset is the prefix sum of the vertex counts
 struct InstanceData
 {
     uint instanceId;
@@ -22,19 +22,53 @@ struct InstanceData
 struct VertexShadingConstants
 {
     float4x4 view;
+    uint     numInstances; // Number of InstanceData records
+    uint     numVertices;  // Total number of vertices to shade
 };
 
 struct RtConstants
 {
-    uint2  resolution;
-    float2 invResolution;
-    uint   numInstances;
-    float  lensDistortion;
-    uint   frameIndex;
+    float4x4 invView; // Rays are generated in view space but the BVH is built in world space
+    uint2    resolution;
+    float2   invResolution;
+    uint     numInstances;
+    float    lensDistortion;
+    uint     frameIndex;
 };
 
 // TODO Move to some header?
 #ifndef __cplusplus
+// Must match CtBvh::Node.
+struct CtBvhNode
+{
+    float3 boundsMin;
+    uint   leftFirst;
+    float3 boundsMax;
+    uint   primitiveCount;
+};
+
+// Must match CtBvh::Triangle.
+struct CtBvhTriangle
+{
+    float3 v0;
+    uint   primitiveIndex;
+    float3 e1;
+    uint   padding0;
+    float3 e2;
+    uint   padding1;
+};
+
+// Must match CtAccelerationStructure::Instance.
+struct CtBvhInstance
+{
+    float4 worldToObject0;
+    float4 worldToObject1;
+    float4 worldToObject2;
+    uint   blasRoot;
+    uint   instanceIndex;
+    uint2  padding;
+};
+
 struct CtRay
 {
     float3 o;
@@ -405,6 +405,21 @@ GI1::HashGridCache::HashGridCache(GI1 &gi1)
     , radiance_cache_debug_stats_used_bucket_buffer_(
           radiance_cache_hash_buffer_uint_[HASHGRIDCACHE_DEBUGSTATSUSEDBUCKETBUFFER])
     , radiance_cache_debug_stats_buffer_(radiance_cache_hash_buffer_float_[HASHGRIDCACHE_DEBUGSTATSBUFFER])
+    , radiance_cache_bucket_hash_buffer_(radiance_cache_hash_buffer_uint_[HASHGRIDCACHE_BUCKETHASHBUFFER])
+    , radiance_cache_stats_buffer_(radiance_cache_hash_buffer_uint_[HASHGRIDCACHE_STATSBUFFER])
+    , radiance_cache_migrate_hash_buffer_(radiance_cache_hash_buffer_uint_[HASHGRIDCACHE_MIGRATEHASHBUFFER])
+    , radiance_cache_migrate_decay_tile_buffer_(
+          radiance_cache_hash_buffer_uint_[HASHGRIDCACHE_MIGRATEDECAYTILEBUFFER])
+    , radiance_cache_migrate_bucket_hash_buffer_(
+          radiance_cache_hash_buffer_uint_[HASHGRIDCACHE_MIGRATEBUCKETHASHBUFFER])
+    , radiance_cache_migrate_value_buffer_(
+          radiance_cache_hash_buffer_uint2_[HASHGRIDCACHE_MIGRATEVALUEBUFFER])
+    , radiance_cache_migrate_value_indirect_buffer_(
+          radiance_cache_hash_buffer_uint2_[HASHGRIDCACHE_MIGRATEVALUEINDIRECTBUFFER])
+    , radiance_cache_migrate_packed_tile_count_buffer_(
+          radiance_cache_hash_buffer_uint_[HASHGRIDCACHE_MIGRATEPACKEDTILECOUNTBUFFER])
+    , radiance_cache_migrate_packed_tile_index_buffer_(
+          radiance_cache_hash_buffer_uint_[HASHGRIDCACHE_MIGRATEPACKEDTILEINDEXBUFFER])
 {}
 
 GI1::HashGridCache::~HashGridCache()
@@ -433,13 +448,20 @@ GI1::HashGridCache::~HashGridCache()
     {
         gfxDestroyBuffer(gfx_, buffer);
     }
+
+    for (GfxBuffer const &buffer : radiance_cache_stats_readback_buffers_)
+    {
+        gfxDestroyBuffer(gfx_, buffer);
+    }
 }
 
 void GI1::HashGridCache::ensureMemoryIsAllocated(
     RenderOptions const &options, std::string_view const &debug_view)
 {
     uint32_t const max_ray_count        = self.screen_probes_.max_ray_count;
-    uint32_t const num_buckets          = 1U << options.gi1_hash_grid_cache_num_buckets;
+    uint32_t const num_buckets          = 1U << (options.gi1_hash_grid_cache_adaptive
+                                                         ? resize_policy_.getNumBuckets()
+                                                         : options.gi1_hash_grid_cache_num_buckets);
     uint32_t const num_tiles_per_bucket = 1U << options.gi1_hash_grid_cache_num_tiles_per_bucket;
     uint32_t const size_tile_mip0       = options.gi1_hash_grid_cache_tile_cell_ratio;
     uint32_t const size_tile_mip1       = size_tile_mip0 >> 1;
@@ -471,6 +493,7 @@ void GI1::HashGridCache::ensureMemoryIsAllocated(
     {
         gfxDestroyBuffer(gfx_, radiance_cache_hash_buffer_);
         gfxDestroyBuffer(gfx_, radiance_cache_decay_tile_buffer_);
+        gfxDestroyBuffer(gfx_, radiance_cache_bucket_hash_buffer_);
 
         radiance_cache_hash_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
         radiance_cache_hash_buffer_.setName("GI1_RadianceCache_HashBuffer");
@@ -478,11 +501,39 @@ void GI1::HashGridCache::ensureMemoryIsAllocated(
         radiance_cache_decay_tile_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
         radiance_cache_decay_tile_buffer_.setName("GI1_RadianceCache_DecayTileBuffer");
 
+        radiance_cache_bucket_hash_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+        radiance_cache_bucket_hash_buffer_.setName("GI1_RadianceCache_BucketHashBuffer");
+
         gfxCommandClearBuffer(gfx_, radiance_cache_hash_buffer_); // clear the radiance cache
     }
 
     debug_total_memory_size_in_bytes += radiance_cache_hash_buffer_.getSize();
     debug_total_memory_size_in_bytes += radiance_cache_decay_tile_buffer_.getSize();
+    debug_total_memory_size_in_bytes += radiance_cache_bucket_hash_buffer_.getSize();
+
+    // The occupancy statistics are always gathered as they only amount to a couple of counters
+    if (!radiance_cache_stats_buffer_)
+    {
+        radiance_cache_stats_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+        radiance_cache_stats_buffer_.setName("GI1_RadianceCache_StatsBuffer");
+
+        gfxCommandClearBuffer(gfx_, radiance_cache_stats_buffer_);
+
+        for (uint32_t i = 0; i < ARRAYSIZE(radiance_cache_stats_readback_buffers_); ++i)
+        {
+            char buffer[64];
+            GFX_SNPRINTF(buffer, sizeof(buffer), "GI1_RadianceCache_StatsReadbackBuffer%u", i);
+
+            // Overflow count followed by the live tile count
+            radiance_cache_stats_readback_buffers_[i] =
+                gfxCreateBuffer<uint32_t>(gfx_, 2, nullptr, kGfxCpuAccess_Read);
+            radiance_cache_stats_readback_buffers_[i].setName(buffer);
+
+            radiance_cache_stats_readback_is_pending_[i] = false; // Don't read-back unfilled buffers
+        }
+    }
+
+    debug_total_memory_size_in_bytes += radiance_cache_stats_buffer_.getSize();
 
     if (!radiance_cache_value_buffer_ || num_cells != num_cells_)
     {
@@ -605,6 +656,18 @@ void GI1::HashGridCache::ensureMemoryIsAllocated(
     debug_total_memory_size_in_bytes += radiance_cache_packed_tile_index_buffer0_.getSize();
     debug_total_memory_size_in_bytes += radiance_cache_packed_tile_index_buffer1_.getSize();
 
+    // Both tables are alive while migrating
+    if (migrate_num_buckets_ != 0)
+    {
+        debug_total_memory_size_in_bytes += radiance_cache_migrate_hash_buffer_.getSize();
+        debug_total_memory_size_in_bytes += radiance_cache_migrate_decay_tile_buffer_.getSize();
+        debug_total_memory_size_in_bytes += radiance_cache_migrate_bucket_hash_buffer_.getSize();
+        debug_total_memory_size_in_bytes += radiance_cache_migrate_value_buffer_.getSize();
+        debug_total_memory_size_in_bytes += radiance_cache_migrate_value_indirect_buffer_.getSize();
+        debug_total_memory_size_in_bytes += radiance_cache_migrate_packed_tile_count_buffer_.getSize();
+        debug_total_memory_size_in_bytes += radiance_cache_migrate_packed_tile_index_buffer_.getSize();
+    }
+
     // The 'packedCell' buffer is not necessary for drawing, but rather used
     // when debugging our hash cells.
     // So, we only allocate the memory when debugging the hash grid radiance
@@ -839,6 +902,122 @@ void GI1::HashGridCache::ensureMemoryIsAllocated(
     debug_total_memory_size_in_bytes_      = debug_total_memory_size_in_bytes;
 }
 
+void GI1::HashGridCache::beginMigration(uint32_t const num_buckets, bool const use_multibounce)
+{
+    cancelMigration();
+
+    uint32_t const num_tiles = (1U << num_buckets) * num_tiles_per_bucket_;
+    uint32_t const num_cells = num_tiles * num_cells_per_tile_;
+
+    radiance_cache_migrate_hash_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+    radiance_cache_migrate_hash_buffer_.setName("GI1_RadianceCache_MigrateHashBuffer");
+
+    radiance_cache_migrate_decay_tile_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+    radiance_cache_migrate_decay_tile_buffer_.setName("GI1_RadianceCache_MigrateDecayTileBuffer");
+
+    radiance_cache_migrate_bucket_hash_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+    radiance_cache_migrate_bucket_hash_buffer_.setName("GI1_RadianceCache_MigrateBucketHashBuffer");
+
+    radiance_cache_migrate_value_buffer_ = gfxCreateBuffer<uint2>(gfx_, num_cells);
+    radiance_cache_migrate_value_buffer_.setName("GI1_RadianceCache_MigrateValueBuffer");
+
+    if (use_multibounce)
+    {
+        radiance_cache_migrate_value_indirect_buffer_ = gfxCreateBuffer<uint2>(gfx_, num_cells);
+        radiance_cache_migrate_value_indirect_buffer_.setName("GI1_RadianceCache_MigrateValueIndirectBuffer");
+    }
+
+    radiance_cache_migrate_packed_tile_count_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, 1);
+    radiance_cache_migrate_packed_tile_count_buffer_.setName(
+        "GI1_RadianceCache_MigratePackedTileCountBuffer");
+
+    radiance_cache_migrate_packed_tile_index_buffer_ = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+    radiance_cache_migrate_packed_tile_index_buffer_.setName(
+        "GI1_RadianceCache_MigratePackedTileIndexBuffer");
+
+    gfxCommandClearBuffer(gfx_, radiance_cache_migrate_hash_buffer_);
+    gfxCommandClearBuffer(gfx_, radiance_cache_migrate_packed_tile_count_buffer_);
+
+    migrate_num_buckets_ = num_buckets;
+    migrate_tile_offset_ = 0;
+    migrate_tile_count_  = 0;
+}
+
+void GI1::HashGridCache::finishMigration()
+{
+    GFX_ASSERT(migrate_num_buckets_ != 0 && migrate_tile_offset_ >= num_tiles_);
+    uint32_t const num_buckets = 1U << migrate_num_buckets_;
+    uint32_t const num_tiles   = num_buckets * num_tiles_per_bucket_;
+
+    std::swap(radiance_cache_hash_buffer_, radiance_cache_migrate_hash_buffer_);
+    std::swap(radiance_cache_decay_tile_buffer_, radiance_cache_migrate_decay_tile_buffer_);
+    std::swap(radiance_cache_bucket_hash_buffer_, radiance_cache_migrate_bucket_hash_buffer_);
+    std::swap(radiance_cache_value_buffer_, radiance_cache_migrate_value_buffer_);
+    std::swap(radiance_cache_value_indirect_buffer_, radiance_cache_migrate_value_indirect_buffer_);
+
+    // The migrated tiles get purged next frame, so they replace the packed tiles of the current frame
+    bool const ping_pong                = radiance_cache_hash_buffer_ping_pong_ != 0;
+    GfxBuffer &packed_tile_count_buffer = ping_pong ? radiance_cache_packed_tile_count_buffer1_
+                                                    : radiance_cache_packed_tile_count_buffer0_;
+    GfxBuffer &packed_tile_index_buffer = ping_pong ? radiance_cache_packed_tile_index_buffer1_
+                                                    : radiance_cache_packed_tile_index_buffer0_;
+    GfxBuffer &other_tile_index_buffer  = ping_pong ? radiance_cache_packed_tile_index_buffer0_
+                                                    : radiance_cache_packed_tile_index_buffer1_;
+    gfxCommandCopyBuffer(gfx_, packed_tile_count_buffer, radiance_cache_migrate_packed_tile_count_buffer_);
+    std::swap(packed_tile_index_buffer, radiance_cache_migrate_packed_tile_index_buffer_);
+
+    radiance_cache_hash_buffer_.setName("GI1_RadianceCache_HashBuffer");
+    radiance_cache_decay_tile_buffer_.setName("GI1_RadianceCache_DecayTileBuffer");
+    radiance_cache_bucket_hash_buffer_.setName("GI1_RadianceCache_BucketHashBuffer");
+    radiance_cache_value_buffer_.setName("GI1_RadianceCache_ValueBuffer");
+    if (radiance_cache_value_indirect_buffer_)
+    {
+        radiance_cache_value_indirect_buffer_.setName("GI1_RadianceCache_ValueIndirectBuffer");
+    }
+    packed_tile_index_buffer.setName(ping_pong ? "GI1_RadianceCache_PackedTileIndexBuffer1"
+                                               : "GI1_RadianceCache_PackedTileIndexBuffer0");
+
+    gfxDestroyBuffer(gfx_, other_tile_index_buffer);
+    other_tile_index_buffer = gfxCreateBuffer<uint32_t>(gfx_, num_tiles);
+    other_tile_index_buffer.setName(ping_pong ? "GI1_RadianceCache_PackedTileIndexBuffer0"
+                                              : "GI1_RadianceCache_PackedTileIndexBuffer1");
+    gfxCommandClearBuffer(gfx_, other_tile_index_buffer);
+
+    // Release the previous table along with any buffer sized after it; the latter are then recreated by
+    // the next call to ensureMemoryIsAllocated()
+    cancelMigration();
+    for (GfxBuffer *buffer :
+        {&radiance_cache_update_tile_buffer_, &radiance_cache_update_cell_value_buffer_,
+            &radiance_cache_update_cell_value_indirect_buffer_, &radiance_cache_debug_cell_buffer_,
+            &radiance_cache_debug_decay_cell_buffer_,
+            &radiance_cache_debug_stats_bucket_overflow_count_buffer_})
+    {
+        gfxDestroyBuffer(gfx_, *buffer);
+        *buffer = {};
+    }
+
+    num_buckets_ = num_buckets;
+    num_tiles_   = num_tiles;
+    num_cells_   = num_tiles * num_cells_per_tile_;
+}
+
+void GI1::HashGridCache::cancelMigration()
+{
+    for (GfxBuffer *buffer :
+        {&radiance_cache_migrate_hash_buffer_, &radiance_cache_migrate_decay_tile_buffer_,
+            &radiance_cache_migrate_bucket_hash_buffer_, &radiance_cache_migrate_value_buffer_,
+            &radiance_cache_migrate_value_indirect_buffer_, &radiance_cache_migrate_packed_tile_count_buffer_,
+            &radiance_cache_migrate_packed_tile_index_buffer_})
+    {
+        gfxDestroyBuffer(gfx_, *buffer);
+        *buffer = {};
+    }
+
+    migrate_num_buckets_ = 0;
+    migrate_tile_offset_ = 0;
+    migrate_tile_count_  = 0;
+}
+
 GI1::WorldSpaceReSTIR::WorldSpaceReSTIR(GI1 &gi1)
     : Base(gi1)
 {}
@@ -1264,7 +1443,12 @@ RenderOptionList GI1::getRenderOptions() noexcept
     newOptions.emplace(RENDER_OPTION_MAKE(gi1_hash_grid_cache_debug_max_cell_decay, options_));
     newOptions.emplace(RENDER_OPTION_MAKE(gi1_hash_grid_cache_debug_stats, options_));
     newOptions.emplace(RENDER_OPTION_MAKE(gi1_hash_grid_cache_debug_max_bucket_overflow, options_));
+    newOptions.emplace(RENDER_OPTION_MAKE(gi1_hash_grid_cache_adaptive, options_));
+    newOptions.emplace(RENDER_OPTION_MAKE(gi1_hash_grid_cache_adaptive_min_memory, options_));
+    newOptions.emplace(RENDER_OPTION_MAKE(gi1_hash_grid_cache_adaptive_max_memory, options_));
     newOptions.emplace(RENDER_OPTION_MAKE(gi1_reservoir_cache_cell_size, options_));
+    newOptions.emplace(RENDER_OPTION_MAKE(gi1_cache_snapshot_directory, options_));
+    newOptions.emplace(RENDER_OPTION_MAKE(gi1_cache_snapshot_save_frame, options_));
     newOptions.emplace(RENDER_OPTION_MAKE(gi1_glossy_reflections_halfres, options_));
     newOptions.emplace(RENDER_OPTION_MAKE(gi1_glossy_reflections_denoiser_mode, options_));
     newOptions.emplace(RENDER_OPTION_MAKE(gi1_glossy_reflections_low_roughness_threshold, options_));
@@ -1314,7 +1498,12 @@ GI1::RenderOptions GI1::convertOptions(RenderOptionList const &options) noexcept
     RENDER_OPTION_GET(gi1_hash_grid_cache_debug_max_cell_decay, newOptions, options)
     RENDER_OPTION_GET(gi1_hash_grid_cache_debug_stats, newOptions, options)
     RENDER_OPTION_GET(gi1_hash_grid_cache_debug_max_bucket_overflow, newOptions, options)
+    RENDER_OPTION_GET(gi1_hash_grid_cache_adaptive, newOptions, options)
+    RENDER_OPTION_GET(gi1_hash_grid_cache_adaptive_min_memory, newOptions, options)
+    RENDER_OPTION_GET(gi1_hash_grid_cache_adaptive_max_memory, newOptions, options)
     RENDER_OPTION_GET(gi1_reservoir_cache_cell_size, newOptions, options)
+    RENDER_OPTION_GET(gi1_cache_snapshot_directory, newOptions, options)
+    RENDER_OPTION_GET(gi1_cache_snapshot_save_frame, newOptions, options)
     RENDER_OPTION_GET(gi1_glossy_reflections_halfres, newOptions, options)
     RENDER_OPTION_GET(gi1_glossy_reflections_denoiser_mode, newOptions, options)
     RENDER_OPTION_GET(gi1_glossy_reflections_low_roughness_threshold, newOptions, options)
@@ -1397,6 +1586,13 @@ DebugViewList GI1::getDebugViews() const noexcept
 
 bool GI1::init(CapsaicinInternal const &capsaicin) noexcept
 {
+    RenderOptionRegistry const &option_registry = capsaicin.getOptionRegistry();
+
+    option_group_         = option_registry.getGroup(getName());
+    option_generation_    = 0;
+    alpha_testing_option_ = option_registry.getHandle("visibility_buffer_disable_alpha_testing");
+    resolveSharedResources(capsaicin);
+
     draw_command_buffer_ = gfxCreateBuffer<uint4>(gfx_, 1);
     draw_command_buffer_.setName("GI1_DrawCommandBuffer");
 
@@ -1405,7 +1601,7 @@ bool GI1::init(CapsaicinInternal const &capsaicin) noexcept
     dispatch_command_buffer_.setName("GI1_DispatchCommandBuffer");
 
     // Set up the base defines based on available features
-    auto const                light_sampler = capsaicin.getComponent<LightSamplerGridStream>();
+    auto *const               light_sampler = capsaicin.getComponent(shared_.light_sampler);
     std::vector const         defines(light_sampler->getShaderDefines(capsaicin));
     std::vector<char const *> base_defines;
     base_defines.reserve(defines.size());
@@ -1417,7 +1613,7 @@ bool GI1::init(CapsaicinInternal const &capsaicin) noexcept
     {
         base_defines.push_back("DISABLE_ALPHA_TESTING");
     }
-    if (capsaicin.hasSharedTexture("OcclusionAndBentNormal"))
+    if (shared_.occlusion_and_bent_normal)
     {
         base_defines.push_back("HAS_OCCLUSION");
     }
@@ -1463,22 +1659,22 @@ bool GI1::init(CapsaicinInternal const &capsaicin) noexcept
 
     GfxDrawState const resolve_lighting_draw_state;
     gfxDrawStateSetColorTarget(
-        resolve_lighting_draw_state, 0, capsaicin.getSharedTexture("GlobalIllumination").getFormat());
+        resolve_lighting_draw_state, 0, capsaicin.getSharedTexture(shared_.global_illumination).getFormat());
 
     GfxDrawState const debug_screen_probes_draw_state;
     gfxDrawStateSetColorTarget(
-        debug_screen_probes_draw_state, 0, capsaicin.getSharedTexture("Debug").getFormat());
+        debug_screen_probes_draw_state, 0, capsaicin.getSharedTexture(shared_.debug).getFormat());
 
     GfxDrawState const debug_hash_grid_cells_draw_state;
     gfxDrawStateSetColorTarget(
-        debug_hash_grid_cells_draw_state, 0, capsaicin.getSharedTexture("Debug").getFormat());
+        debug_hash_grid_cells_draw_state, 0, capsaicin.getSharedTexture(shared_.debug).getFormat());
     gfxDrawStateSetDepthStencilTarget(debug_hash_grid_cells_draw_state, depth_buffer_.getFormat());
     gfxDrawStateSetCullMode(debug_hash_grid_cells_draw_state, D3D12_CULL_MODE_NONE);
     gfxDrawStateSetDepthFunction(debug_hash_grid_cells_draw_state, D3D12_COMPARISON_FUNC_GREATER);
 
     GfxDrawState const debug_reflection_draw_state;
     gfxDrawStateSetColorTarget(
-        debug_reflection_draw_state, 0, capsaicin.getSharedTexture("Debug").getFormat());
+        debug_reflection_draw_state, 0, capsaicin.getSharedTexture(shared_.debug).getFormat());
 
     gi1_program_        = capsaicin.createProgram("render_techniques/gi1/gi1");
     resolve_gi1_kernel_ = gfxCreateGraphicsKernel(gfx_, gi1_program_, resolve_lighting_draw_state,
@@ -1637,6 +1833,8 @@ bool GI1::init(CapsaicinInternal const &capsaicin) noexcept
 
     purge_tiles_kernel_ = gfxCreateComputeKernel(
         gfx_, gi1_program_, "PurgeTiles", debug_hash_cells_defines.data(), debug_hash_cells_define_count);
+    migrate_tiles_kernel_ =
+        gfxCreateComputeKernel(gfx_, gi1_program_, "MigrateTiles", base_defines.data(), base_define_count);
     update_tiles_kernel_ =
         gfxCreateComputeKernel(gfx_, gi1_program_, "UpdateTiles", base_defines.data(), base_define_count);
     resolve_cells_kernel_ =
@@ -1695,6 +1893,13 @@ bool GI1::init(CapsaicinInternal const &capsaicin) noexcept
     filter_gi_kernel_ =
         gfxCreateComputeKernel(gfx_, gi1_program_, "FilterGI", base_defines.data(), base_define_count);
 
+    // Adaptive sizing starts from the user-set table size
+    if (hash_grid_cache_.resize_policy_.getNumBuckets() == 0)
+    {
+        hash_grid_cache_.resize_policy_.reset(options_.gi1_hash_grid_cache_num_buckets,
+            options_.gi1_hash_grid_cache_num_tiles_per_bucket);
+    }
+
     // Ensure our scratch memory is allocated
     screen_probes_.ensureMemoryIsAllocated(capsaicin);
     hash_grid_cache_.ensureMemoryIsAllocated(options_, debug_view_);
@@ -1715,12 +1920,20 @@ bool GI1::init(CapsaicinInternal const &capsaicin) noexcept
 
 void GI1::render(CapsaicinInternal &capsaicin) noexcept
 {
-    RenderOptions const options            = convertOptions(capsaicin.getOptions());
-    auto                light_sampler      = capsaicin.getComponent<LightSamplerGridStream>();
-    auto                brdf_lut           = capsaicin.getComponent<BrdfLut>();
-    auto                prefilter_ibl      = capsaicin.getComponent<PrefilterIBL>();
-    auto                blue_noise_sampler = capsaicin.getComponent<BlueNoiseSampler>();
-    auto const          rng                = capsaicin.getComponent<RandomNumberGenerator>();
+    // Options only need converting if any of them have changed since the last frame. Options mapped from the
+    // visibility buffer belong to its group so must be checked separately
+    RenderOptionRegistry const &option_registry = capsaicin.getOptionRegistry();
+    uint64_t const              last_generation = option_generation_;
+    bool const                  options_changed =
+        option_registry.checkChanged(option_group_, option_generation_)
+        || option_registry.getGeneration(alpha_testing_option_) > last_generation;
+
+    RenderOptions const options = options_changed ? convertOptions(capsaicin.getOptions()) : options_;
+    auto *const         light_sampler      = capsaicin.getComponent(shared_.light_sampler);
+    auto *const         brdf_lut           = capsaicin.getComponent(shared_.brdf_lut);
+    auto *const         prefilter_ibl      = capsaicin.getComponent(shared_.prefilter_ibl);
+    auto *const         blue_noise_sampler = capsaicin.getComponent(shared_.blue_noise_sampler);
+    auto *const         rng                = capsaicin.getComponent(shared_.rng);
 
     auto const debug_view = capsaicin.getCurrentDebugView();
     bool const needs_debug_view =
@@ -1744,9 +1957,25 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
         || options_.gi1_hash_grid_cache_debug_propagate != options.gi1_hash_grid_cache_debug_propagate
         || options_.gi1_use_multibounce != options.gi1_use_multibounce || capsaicin.getFrameIndex() == 0;
 
+    bool const needs_hash_grid_resize_reset =
+        options_.gi1_hash_grid_cache_adaptive != options.gi1_hash_grid_cache_adaptive
+        || options_.gi1_hash_grid_cache_num_buckets != options.gi1_hash_grid_cache_num_buckets
+        || options_.gi1_hash_grid_cache_num_tiles_per_bucket
+               != options.gi1_hash_grid_cache_num_tiles_per_bucket
+        || options_.gi1_hash_grid_cache_tile_cell_ratio != options.gi1_hash_grid_cache_tile_cell_ratio
+        || options_.gi1_use_multibounce != options.gi1_use_multibounce;
+
     options_    = options;
     debug_view_ = debug_view;
 
+    // Restart the adaptive sizing whenever the user changes the table layout
+    if (needs_hash_grid_resize_reset)
+    {
+        hash_grid_cache_.cancelMigration();
+        hash_grid_cache_.resize_policy_.reset(
+            options_.gi1_hash_grid_cache_num_buckets, options_.gi1_hash_grid_cache_num_tiles_per_bucket);
+    }
+
     if (needs_recompile)
     {
         terminate();
@@ -1761,18 +1990,18 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
 
         GfxDrawState const debug_screen_probes_draw_state;
         gfxDrawStateSetColorTarget(
-            debug_screen_probes_draw_state, 0, capsaicin.getSharedTexture("Debug").getFormat());
+            debug_screen_probes_draw_state, 0, capsaicin.getSharedTexture(shared_.debug).getFormat());
 
         GfxDrawState const debug_hash_grid_cells_draw_state;
         gfxDrawStateSetColorTarget(
-            debug_hash_grid_cells_draw_state, 0, capsaicin.getSharedTexture("Debug").getFormat());
+            debug_hash_grid_cells_draw_state, 0, capsaicin.getSharedTexture(shared_.debug).getFormat());
         gfxDrawStateSetDepthStencilTarget(debug_hash_grid_cells_draw_state, depth_buffer_.getFormat());
         gfxDrawStateSetCullMode(debug_hash_grid_cells_draw_state, D3D12_CULL_MODE_NONE);
         gfxDrawStateSetDepthFunction(debug_hash_grid_cells_draw_state, D3D12_COMPARISON_FUNC_GREATER);
 
         GfxDrawState const debug_reflection_draw_state;
         gfxDrawStateSetColorTarget(
-            debug_reflection_draw_state, 0, capsaicin.getSharedTexture("Debug").getFormat());
+            debug_reflection_draw_state, 0, capsaicin.getSharedTexture(shared_.debug).getFormat());
 
         debug_screen_probes_kernel_ =
             gfxCreateGraphicsKernel(gfx_, gi1_program_, debug_screen_probes_draw_state, "DebugScreenProbes");
@@ -1795,6 +2024,17 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
     glossy_reflections_.ensureMemoryIsAllocated(capsaicin);
     gi_denoiser_.ensureMemoryIsAllocated(capsaicin);
 
+    // Warm start the freshly cleared caches from a previous run
+    if (capsaicin.getFrameIndex() == 0)
+    {
+        restoreCacheSnapshot(capsaicin, capsaicin.getFrameIndex());
+    }
+    if (options_.gi1_cache_snapshot_save_frame != 0
+        && options_.gi1_cache_snapshot_save_frame == capsaicin.getFrameIndex())
+    {
+        cache_snapshot_save_pending_ = true;
+    }
+
     if (capsaicin.getRenderDimensionsUpdated())
     {
         depth_buffer_      = capsaicin.resizeRenderTexture(depth_buffer_);
@@ -1882,6 +2122,18 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
     hash_grid_cache_constant_data.first_cell_offset_tile_mip2 = hash_grid_cache_.first_cell_offset_tile_mip2_;
     hash_grid_cache_constant_data.first_cell_offset_tile_mip3 = hash_grid_cache_.first_cell_offset_tile_mip3_;
     hash_grid_cache_constant_data.buffer_ping_pong = hash_grid_cache_.radiance_cache_hash_buffer_ping_pong_;
+    if (hash_grid_cache_.migrate_num_buckets_ != 0)
+    {
+        // Spread the migration over a fixed number of frames
+        uint32_t const migrate_slice_size =
+            (hash_grid_cache_.num_tiles_ + HashGridCache::migration_frame_count_ - 1)
+            / HashGridCache::migration_frame_count_;
+        hash_grid_cache_.migrate_tile_count_ = GFX_MIN(
+            migrate_slice_size, hash_grid_cache_.num_tiles_ - hash_grid_cache_.migrate_tile_offset_);
+        hash_grid_cache_constant_data.migrate_num_buckets = 1U << hash_grid_cache_.migrate_num_buckets_;
+        hash_grid_cache_constant_data.migrate_tile_offset = hash_grid_cache_.migrate_tile_offset_;
+        hash_grid_cache_constant_data.migrate_tile_count  = hash_grid_cache_.migrate_tile_count_;
+    }
     hash_grid_cache_constant_data.max_sample_count = options_.gi1_hash_grid_cache_max_sample_count;
     hash_grid_cache_constant_data.discard_multibounce_ray_probability =
         options_.gi1_hash_grid_cache_discard_multibounce_ray_probability;
@@ -1979,7 +2231,7 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
     // Bind the shader parameters
     float const near_far[] = {camera.nearZ, camera.farZ};
 
-    gfxProgramSetParameter(gfx_, gi1_program_, "g_Exposure", capsaicin.getSharedBuffer("Exposure"));
+    gfxProgramSetParameter(gfx_, gi1_program_, "g_Exposure", capsaicin.getSharedBuffer(shared_.exposure));
     gfxProgramSetParameter(gfx_, gi1_program_, "g_Eye", camera.eye);
     gfxProgramSetParameter(gfx_, gi1_program_, "g_NearFar", near_far);
     gfxProgramSetParameter(gfx_, gi1_program_, "g_FrameIndex", frame_index);
@@ -1992,28 +2244,31 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
     gfxProgramSetParameter(
         gfx_, gi1_program_, "g_DisableAlbedoTextures", options_.gi1_disable_albedo_textures ? 1 : 0);
     gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_DepthBuffer", capsaicin.getSharedTexture("VisibilityDepth"));
+        gfx_, gi1_program_, "g_DepthBuffer", capsaicin.getSharedTexture(shared_.visibility_depth));
     gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_GeometryNormalBuffer", capsaicin.getSharedTexture("GeometryNormal"));
+        gfx_, gi1_program_, "g_GeometryNormalBuffer", capsaicin.getSharedTexture(shared_.geometry_normal));
     gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_ShadingNormalBuffer", capsaicin.getSharedTexture("ShadingNormal"));
-    gfxProgramSetParameter(gfx_, gi1_program_, "g_VelocityBuffer", capsaicin.getSharedTexture("Velocity"));
-    gfxProgramSetParameter(gfx_, gi1_program_, "g_GradientsBuffer", capsaicin.getSharedTexture("Gradients"));
-    gfxProgramSetParameter(gfx_, gi1_program_, "g_RoughnessBuffer", capsaicin.getSharedTexture("Roughness"));
-    gfxProgramSetParameter(gfx_, gi1_program_, "g_OcclusionAndBentNormalBuffer",
-        capsaicin.getSharedTexture("OcclusionAndBentNormal"));
-    gfxProgramSetParameter(gfx_, gi1_program_, "g_NearFieldGlobalIlluminationBuffer",
-        capsaicin.getSharedTexture("NearFieldGlobalIllumination"));
+        gfx_, gi1_program_, "g_ShadingNormalBuffer", capsaicin.getSharedTexture(shared_.shading_normal));
     gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_VisibilityBuffer", capsaicin.getSharedTexture("Visibility"));
+        gfx_, gi1_program_, "g_VelocityBuffer", capsaicin.getSharedTexture(shared_.velocity));
     gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_PreviousDepthBuffer", capsaicin.getSharedTexture("PrevVisibilityDepth"));
+        gfx_, gi1_program_, "g_GradientsBuffer", capsaicin.getSharedTexture(shared_.gradients));
     gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_PreviousNormalBuffer", capsaicin.getSharedTexture("PrevGeometryNormal"));
+        gfx_, gi1_program_, "g_RoughnessBuffer", capsaicin.getSharedTexture(shared_.roughness));
+    gfxProgramSetParameter(gfx_, gi1_program_, "g_OcclusionAndBentNormalBuffer",
+        capsaicin.getSharedTexture(shared_.occlusion_and_bent_normal));
+    gfxProgramSetParameter(gfx_, gi1_program_, "g_NearFieldGlobalIlluminationBuffer",
+        capsaicin.getSharedTexture(shared_.near_field_global_illumination));
     gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_PreviousDetailsBuffer", capsaicin.getSharedTexture("PrevShadingNormal"));
+        gfx_, gi1_program_, "g_VisibilityBuffer", capsaicin.getSharedTexture(shared_.visibility));
+    gfxProgramSetParameter(gfx_, gi1_program_, "g_PreviousDepthBuffer",
+        capsaicin.getSharedTexture(shared_.prev_visibility_depth));
+    gfxProgramSetParameter(gfx_, gi1_program_, "g_PreviousNormalBuffer",
+        capsaicin.getSharedTexture(shared_.prev_geometry_normal));
+    gfxProgramSetParameter(gfx_, gi1_program_, "g_PreviousDetailsBuffer",
+        capsaicin.getSharedTexture(shared_.prev_shading_normal));
     gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_PreviousRoughnessBuffer", capsaicin.getSharedTexture("PrevRoughness"));
+        gfx_, gi1_program_, "g_PreviousRoughnessBuffer", capsaicin.getSharedTexture(shared_.prev_roughness));
 
     blue_noise_sampler->addProgramParameters(capsaicin, gi1_program_);
 
@@ -2030,9 +2285,9 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
 
     gfxProgramSetParameter(gfx_, gi1_program_, "g_IrradianceBuffer", irradiance_buffer_);
     gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_ReflectionBuffer", capsaicin.getSharedTexture("Reflection"));
-    gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_PreviousReflectionBuffer", capsaicin.getSharedTexture("PrevReflection"));
+        gfx_, gi1_program_, "g_ReflectionBuffer", capsaicin.getSharedTexture(shared_.reflection));
+    gfxProgramSetParameter(gfx_, gi1_program_, "g_PreviousReflectionBuffer",
+        capsaicin.getSharedTexture(shared_.prev_reflection));
 
     gfxProgramSetParameter(gfx_, gi1_program_, "g_DrawCommandBuffer", draw_command_buffer_);
     gfxProgramSetParameter(gfx_, gi1_program_, "g_DispatchCommandBuffer", dispatch_command_buffer_);
@@ -2040,12 +2295,12 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
     {
         gfxProgramSetParameter(gfx_, gi1_program_, "g_DispatchRaysCommandBuffer", dispatch_command_buffer_);
     }
-    gfxProgramSetParameter(
-        gfx_, gi1_program_, "g_GlobalIlluminationBuffer", capsaicin.getSharedTexture("GlobalIllumination"));
+    gfxProgramSetParameter(gfx_, gi1_program_, "g_GlobalIlluminationBuffer",
+        capsaicin.getSharedTexture(shared_.global_illumination));
     gfxProgramSetParameter(gfx_, gi1_program_, "g_PrevCombinedIlluminationBuffer",
-        capsaicin.getSharedTexture("PrevCombinedIllumination"));
+        capsaicin.getSharedTexture(shared_.prev_combined_illumination));
     gfxProgramSetParameter(gfx_, gi1_program_, "g_OcclusionAndBentNormalBuffer",
-        capsaicin.getSharedTexture("OcclusionAndBentNormal"));
+        capsaicin.getSharedTexture(shared_.occlusion_and_bent_normal));
 
     gfxProgramSetParameter(gfx_, gi1_program_, "g_Scene", capsaicin.getAccelerationStructure());
 
@@ -2639,7 +2894,7 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
     // Ray traced reflections for surface with roughness under gi1_glossy_reflections_low_roughness_threshold
     if (options_.gi1_disable_specular_materials)
     {
-        gfxCommandClearTexture(gfx_, capsaicin.getSharedTexture("Reflection"));
+        gfxCommandClearTexture(gfx_, capsaicin.getSharedTexture(shared_.reflection));
     }
     else
     {
@@ -2934,7 +3189,7 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
 
         TimedSection const timed_section(*this, "ResolveGI1");
 
-        gfxCommandBindColorTarget(gfx_, 0, capsaicin.getSharedTexture("GlobalIllumination"));
+        gfxCommandBindColorTarget(gfx_, 0, capsaicin.getSharedTexture(shared_.global_illumination));
         gfxCommandBindKernel(gfx_, resolve_gi1_kernel_);
         gfxCommandDraw(gfx_, 3);
     }
@@ -3058,7 +3313,7 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
     {
         TimedSection const timed_section(*this, "DebugScreenProbes");
 
-        gfxCommandBindColorTarget(gfx_, 0, capsaicin.getSharedTexture("Debug"));
+        gfxCommandBindColorTarget(gfx_, 0, capsaicin.getSharedTexture(shared_.debug));
         gfxCommandBindKernel(gfx_, debug_screen_probes_kernel_);
         gfxCommandDraw(gfx_, 3);
     }
@@ -3071,7 +3326,7 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
         gfxCommandBindKernel(gfx_, generate_draw_kernel_);
         gfxCommandDispatch(gfx_, 1, 1, 1);
         gfxCommandClearTexture(gfx_, depth_buffer_);
-        gfxCommandBindColorTarget(gfx_, 0, capsaicin.getSharedTexture("Debug"));
+        gfxCommandBindColorTarget(gfx_, 0, capsaicin.getSharedTexture(shared_.debug));
         gfxCommandBindDepthStencilTarget(gfx_, depth_buffer_);
         gfxCommandBindKernel(gfx_, debug_hash_grid_cells_kernel_);
         gfxCommandMultiDrawIndirect(gfx_, draw_command_buffer_, 1);
@@ -3081,10 +3336,19 @@ void GI1::render(CapsaicinInternal &capsaicin) noexcept
     if (debug_view_ == "Reflection")
     {
         TimedSection const timed_section(*this, "DebugReflection");
-        gfxCommandBindColorTarget(gfx_, 0, capsaicin.getSharedTexture("Debug"));
+        gfxCommandBindColorTarget(gfx_, 0, capsaicin.getSharedTexture(shared_.debug));
         gfxCommandBindKernel(gfx_, debug_reflection_kernel_);
         gfxCommandDraw(gfx_, 3);
     }
+    // Gather the cache occupancy and resize the cache accordingly
+    adaptHashGridCache(frame_index);
+
+    // Save the caches once any resize has completed so that the snapshot matches the table in use
+    if (cache_snapshot_save_pending_ && hash_grid_cache_.migrate_num_buckets_ == 0)
+    {
+        cache_snapshot_save_pending_ = false;
+        saveCacheSnapshot(capsaicin, frame_index);
+    }
 
     // Release our constant buffers
     gfxDestroyBuffer(gfx_, gi1_constants);
@@ -3139,6 +3403,7 @@ void GI1::terminate() noexcept
     gfxDestroyKernel(gfx_, interpolate_screen_probes_kernel_);
 
     gfxDestroyKernel(gfx_, purge_tiles_kernel_);
+    gfxDestroyKernel(gfx_, migrate_tiles_kernel_);
     gfxDestroyKernel(gfx_, populate_multibounce_cells_kernel_);
     gfxDestroyKernel(gfx_, update_multibounce_cells_kernel_);
     gfxDestroyKernel(gfx_, populate_cells_kernel_);
@@ -3231,6 +3496,51 @@ void GI1::renderGUI(CapsaicinInternal &capsaicin) const noexcept
                 static_cast<uint32_t>(glm::clamp(num_tiles_per_bucket, 1, 8)));
         }
 
+        if (auto adaptive = capsaicin.getOption<bool>("gi1_hash_grid_cache_adaptive");
+            ImGui::Checkbox("Adaptive Size", &adaptive))
+        {
+            capsaicin.setOption<bool>("gi1_hash_grid_cache_adaptive", adaptive);
+        }
+        if (capsaicin.getOption<bool>("gi1_hash_grid_cache_adaptive"))
+        {
+            auto min_memory = static_cast<int32_t>(
+                capsaicin.getOption<uint32_t>("gi1_hash_grid_cache_adaptive_min_memory"));
+            if (ImGui::SliderInt("Min Memory Size (MB)", &min_memory, 16, 4096))
+            {
+                capsaicin.setOption<uint32_t>("gi1_hash_grid_cache_adaptive_min_memory",
+                    static_cast<uint32_t>(glm::clamp(min_memory, 16, 4096)));
+            }
+
+            auto max_memory = static_cast<int32_t>(
+                capsaicin.getOption<uint32_t>("gi1_hash_grid_cache_adaptive_max_memory"));
+            if (ImGui::SliderInt("Max Memory Size (MB)", &max_memory, 16, 8192))
+            {
+                capsaicin.setOption<uint32_t>("gi1_hash_grid_cache_adaptive_max_memory",
+                    static_cast<uint32_t>(glm::clamp(max_memory, 16, 8192)));
+            }
+
+            ImGui::Text("Current Number of Buckets : 1 << %u%s",
+                hash_grid_cache_.resize_policy_.getNumBuckets(),
+                hash_grid_cache_.migrate_num_buckets_ != 0 ? " (resizing)" : "");
+        }
+
+        float const load_factor = hash_grid_cache_.num_tiles_ != 0
+                                    ? static_cast<float>(hash_grid_cache_.stats_live_tile_count_)
+                                          / static_cast<float>(hash_grid_cache_.num_tiles_)
+                                    : 0.0F;
+        ImGui::Text(
+            "Live Tiles : %u (%.1f%%)", hash_grid_cache_.stats_live_tile_count_, 100.0F * load_factor);
+        ImGui::Text("Overflowing Insertions : %u", hash_grid_cache_.stats_overflow_count_);
+
+        if (!options_.gi1_cache_snapshot_directory.empty())
+        {
+            ImGui::Text("Warm Start Tiles : %u", cache_snapshot_restored_tile_count_);
+            if (ImGui::Button("Save Warm Start Snapshot"))
+            {
+                capsaicin.setOption<uint32_t>("gi1_cache_snapshot_save_frame", capsaicin.getFrameIndex() + 1);
+            }
+        }
+
         auto &debug_stats = capsaicin.getOption<bool>("gi1_hash_grid_cache_debug_stats");
         ImGui::Checkbox("Debug Statistics", &debug_stats);
         if (debug_stats && ImGui::CollapsingHeader("Hash Grid Cache", ImGuiTreeNodeFlags_DefaultOpen))
@@ -3289,5 +3599,279 @@ void GI1::clearHashGridCache() const
         gfxCommandClearBuffer(gfx_, hash_grid_cache_.radiance_cache_packed_tile_count_buffer0_);
         gfxCommandClearBuffer(gfx_, hash_grid_cache_.radiance_cache_packed_tile_count_buffer1_);
     }
+    if (hash_grid_cache_.migrate_num_buckets_ != 0)
+    {
+        // Also drop the tiles that were already migrated
+        gfxCommandClearBuffer(gfx_, hash_grid_cache_.radiance_cache_migrate_hash_buffer_);
+        gfxCommandClearBuffer(gfx_, hash_grid_cache_.radiance_cache_migrate_packed_tile_count_buffer_);
+    }
+}
+
+void GI1::adaptHashGridCache(uint32_t const frame_index)
+{
+    auto &cache = hash_grid_cache_;
+
+    // Copy the occupancy counters for delayed read-back
+    {
+        TimedSection const timed_section(*this, "CopyRadianceCacheStats");
+
+        uint32_t const  copy_index         = (frame_index + 0) % kGfxConstant_BackBufferCount;
+        GfxBuffer const destination_buffer = cache.radiance_cache_stats_readback_buffers_[copy_index];
+        GfxBuffer const packed_tile_count_buffer =
+            (cache.radiance_cache_hash_buffer_ping_pong_ != 0
+                    ? cache.radiance_cache_packed_tile_count_buffer1_
+                    : cache.radiance_cache_packed_tile_count_buffer0_);
+        gfxCommandCopyBuffer(
+            gfx_, destination_buffer, 0, cache.radiance_cache_stats_buffer_, 0, sizeof(uint32_t));
+        gfxCommandCopyBuffer(
+            gfx_, destination_buffer, sizeof(uint32_t), packed_tile_count_buffer, 0, sizeof(uint32_t));
+
+        cache.radiance_cache_stats_readback_is_pending_[copy_index] = true;
+    }
+
+    // Rehash the next slice of tiles into the resized table
+    if (cache.migrate_num_buckets_ != 0)
+    {
+        TimedSection const timed_section(*this, "MigrateRadianceCache");
+
+        uint32_t const *num_threads  = gfxKernelGetNumThreads(gfx_, migrate_tiles_kernel_);
+        uint32_t const  num_groups_x = (cache.migrate_tile_count_ + num_threads[0] - 1) / num_threads[0];
+
+        gfxCommandBindKernel(gfx_, migrate_tiles_kernel_);
+        gfxCommandDispatch(gfx_, num_groups_x, 1, 1);
+
+        cache.migrate_tile_offset_ += cache.migrate_tile_count_;
+        if (cache.migrate_tile_offset_ >= cache.num_tiles_)
+        {
+            cache.resize_policy_.resize(cache.resize_policy_settings_, cache.migrate_num_buckets_);
+            cache.finishMigration();
+
+            // Any pending counters relate to the previous table and would skew the policy
+            std::fill_n(cache.radiance_cache_stats_readback_is_pending_,
+                ARRAYSIZE(cache.radiance_cache_stats_readback_is_pending_), false);
+        }
+    }
+
+    // Read-back stats
+    if (uint32_t const readback_index = (frame_index + 1) % kGfxConstant_BackBufferCount;
+        cache.radiance_cache_stats_readback_is_pending_[readback_index])
+    {
+        auto const *stats = static_cast<uint32_t const *>(
+            gfxBufferGetData(gfx_, cache.radiance_cache_stats_readback_buffers_[readback_index]));
+        cache.stats_overflow_count_  = stats[0];
+        cache.stats_live_tile_count_ = stats[1];
+
+        cache.radiance_cache_stats_readback_is_pending_[readback_index] = false;
+
+        if (options_.gi1_hash_grid_cache_adaptive && cache.migrate_num_buckets_ == 0)
+        {
+            uint64_t const bytes_per_tile = HashGridCacheResizePolicy::GetBytesPerTile(
+                cache.num_cells_per_tile_, options_.gi1_use_multibounce);
+            auto const [min_num_buckets, max_num_buckets] =
+                HashGridCacheResizePolicy::GetBucketRange(bytes_per_tile * cache.num_tiles_per_bucket_,
+                    uint64_t {options_.gi1_hash_grid_cache_adaptive_min_memory} << 20,
+                    uint64_t {options_.gi1_hash_grid_cache_adaptive_max_memory} << 20);
+            cache.resize_policy_settings_.min_num_buckets = min_num_buckets;
+            cache.resize_policy_settings_.max_num_buckets = max_num_buckets;
+
+            if (uint32_t const num_buckets = cache.resize_policy_.update(
+                    cache.resize_policy_settings_, cache.stats_live_tile_count_, cache.stats_overflow_count_);
+                num_buckets != cache.resize_policy_.getNumBuckets())
+            {
+                cache.beginMigration(num_buckets, options_.gi1_use_multibounce);
+            }
+        }
+    }
+}
+
+GI1CacheSnapshot::Layout GI1::getCacheSnapshotLayout() const noexcept
+{
+    GI1CacheSnapshot::Layout layout;
+    layout.cell_size             = options_.gi1_hash_grid_cache_cell_size;
+    layout.min_cell_size         = options_.gi1_hash_grid_cache_min_cell_size;
+    layout.tile_cell_ratio       = options_.gi1_hash_grid_cache_tile_cell_ratio;
+    layout.num_tiles_per_bucket  = hash_grid_cache_.num_tiles_per_bucket_;
+    layout.num_cells_per_tile    = hash_grid_cache_.num_cells_per_tile_;
+    layout.use_multibounce       = options_.gi1_use_multibounce ? 1U : 0U;
+    layout.reservoir_num_entries = WorldSpaceReSTIR::kConstant_NumEntries;
+    layout.reservoir_num_samples =
+        static_cast<uint32_t>(world_space_restir_.reservoir_indirect_sample_normal_buffers_[0].getCount());
+    return layout;
+}
+
+void GI1::saveCacheSnapshot(CapsaicinInternal const &capsaicin, uint32_t const frame_index)
+{
+    auto const &scenes = capsaicin.getCurrentScenes();
+    if (options_.gi1_cache_snapshot_directory.empty() || scenes.empty())
+    {
+        return;
+    }
+
+    TimedSection const timed_section(*this, "SaveCacheSnapshot");
+
+    auto const    &cache        = hash_grid_cache_;
+    auto const    &restir       = world_space_restir_;
+    uint32_t const restir_index = restir.reservoir_indirect_sample_buffer_index_;
+
+    // Copy the current caches into CPU visible memory, this stalls the GPU but only happens on request
+    std::vector<GfxBuffer> buffers = {restir.reservoir_hash_buffers_[restir_index],
+        restir.reservoir_hash_count_buffers_[restir_index],
+        restir.reservoir_hash_index_buffers_[restir_index],
+        restir.reservoir_hash_value_buffers_[restir_index],
+        restir.reservoir_indirect_sample_normal_buffers_[restir_index],
+        restir.reservoir_indirect_sample_reservoir_buffers_[restir_index], cache.radiance_cache_hash_buffer_,
+        cache.radiance_cache_decay_tile_buffer_, cache.radiance_cache_bucket_hash_buffer_,
+        cache.radiance_cache_value_buffer_};
+    if (options_.gi1_use_multibounce)
+    {
+        buffers.push_back(cache.radiance_cache_value_indirect_buffer_);
+    }
+    std::vector<GfxBuffer> readback_buffers;
+    for (GfxBuffer const &buffer : buffers)
+    {
+        GfxBuffer const readback_buffer =
+            gfxCreateBuffer(gfx_, buffer.getSize(), nullptr, kGfxCpuAccess_Read);
+        gfxCommandCopyBuffer(gfx_, readback_buffer, 0, buffer, 0, buffer.getSize());
+        readback_buffers.push_back(readback_buffer);
+    }
+    gfxFinish(gfx_);
+
+    auto const data = [&](size_t const index) {
+        return index < readback_buffers.size()
+                 ? static_cast<uint32_t const *>(gfxBufferGetData(gfx_, readback_buffers[index]))
+                 : nullptr;
+    };
+    GI1CacheSnapshot snapshot;
+    snapshot.captureHashGrid(getCacheSnapshotLayout(), frame_index, cache.num_tiles_, data(6), data(7),
+        data(8), data(9), data(10));
+    snapshot.captureReservoirs(data(0), data(1), data(2), data(3), data(4), data(5));
+    for (GfxBuffer const &readback_buffer : readback_buffers)
+    {
+        gfxDestroyBuffer(gfx_, readback_buffer);
+    }
+
+    auto const file_path = GI1CacheSnapshot::GetFilePath(options_.gi1_cache_snapshot_directory, scenes[0],
+        capsaicin.getCurrentEnvironmentMap(), capsaicin.getSceneCurrentCamera());
+    if (!snapshot.save(file_path))
+    {
+        GFX_PRINTLN("Error: Failed to save GI1 cache snapshot: %s", file_path.string().c_str());
+    }
+}
+
+void GI1::restoreCacheSnapshot(CapsaicinInternal const &capsaicin, uint32_t const frame_index)
+{
+    cache_snapshot_restored_tile_count_ = 0;
+    auto const &scenes                  = capsaicin.getCurrentScenes();
+    if (options_.gi1_cache_snapshot_directory.empty() || scenes.empty())
+    {
+        return;
+    }
+
+    auto const file_path = GI1CacheSnapshot::GetFilePath(options_.gi1_cache_snapshot_directory, scenes[0],
+        capsaicin.getCurrentEnvironmentMap(), capsaicin.getSceneCurrentCamera());
+    if (!std::filesystem::exists(file_path))
+    {
+        return;
+    }
+    GI1CacheSnapshot snapshot;
+    if (!snapshot.load(file_path))
+    {
+        GFX_PRINTLN("Error: Failed to load GI1 cache snapshot: %s", file_path.string().c_str());
+        return;
+    }
+    auto const layout = getCacheSnapshotLayout();
+    if (!snapshot.isHashGridCompatible(layout))
+    {
+        GFX_PRINTLN("Warning: Ignoring GI1 cache snapshot with different settings: %s",
+            file_path.string().c_str());
+        return;
+    }
+
+    TimedSection const timed_section(*this, "RestoreCacheSnapshot");
+
+    auto const upload = [&](GfxBuffer const &buffer, std::vector<uint32_t> const &values) {
+        if (values.empty())
+        {
+            return;
+        }
+        uint64_t const  size          = values.size() * sizeof(uint32_t);
+        GfxBuffer const upload_buffer = gfxCreateBuffer(gfx_, size, values.data(), kGfxCpuAccess_Write);
+        gfxCommandCopyBuffer(gfx_, buffer, 0, upload_buffer, 0, size);
+        gfxDestroyBuffer(gfx_, upload_buffer);
+    };
+
+    // Tiles are rehashed into the current table so any resize in progress is no longer needed
+    auto &cache = hash_grid_cache_;
+    cache.cancelMigration();
+
+    GI1CacheSnapshot::HashGridBuffers hash_grid_buffers;
+    uint32_t const                    tile_count =
+        snapshot.restoreHashGrid(cache.num_buckets_, frame_index, hash_grid_buffers);
+    upload(cache.radiance_cache_hash_buffer_, hash_grid_buffers.hash);
+    upload(cache.radiance_cache_decay_tile_buffer_, hash_grid_buffers.decay_tile);
+    upload(cache.radiance_cache_bucket_hash_buffer_, hash_grid_buffers.bucket_hash);
+    upload(cache.radiance_cache_value_buffer_, hash_grid_buffers.value);
+    upload(cache.radiance_cache_value_indirect_buffer_, hash_grid_buffers.value_indirect);
+
+    // The restored tiles must be in the previous frame's packed list so that they are aged and purged
+    bool const ping_pong = cache.radiance_cache_hash_buffer_ping_pong_ != 0;
+    upload(ping_pong ? cache.radiance_cache_packed_tile_count_buffer0_
+                     : cache.radiance_cache_packed_tile_count_buffer1_,
+        {tile_count});
+    upload(ping_pong ? cache.radiance_cache_packed_tile_index_buffer0_
+                     : cache.radiance_cache_packed_tile_index_buffer1_,
+        hash_grid_buffers.packed_tile_index);
+    cache_snapshot_restored_tile_count_ = tile_count;
+
+    // Reservoirs are indexed by ray so can only be reused at the same render resolution
+    if (snapshot.isReservoirCompatible(layout))
+    {
+        auto          &restir         = world_space_restir_;
+        uint32_t const previous_index = 1 - restir.reservoir_indirect_sample_buffer_index_;
+
+        GI1CacheSnapshot::ReservoirBuffers reservoir_buffers;
+        snapshot.restoreReservoirs(reservoir_buffers);
+        upload(restir.reservoir_hash_buffers_[previous_index], reservoir_buffers.hash);
+        upload(restir.reservoir_hash_count_buffers_[previous_index], reservoir_buffers.hash_count);
+        upload(restir.reservoir_hash_index_buffers_[previous_index], reservoir_buffers.hash_index);
+        upload(restir.reservoir_hash_value_buffers_[previous_index], reservoir_buffers.hash_value);
+        upload(restir.reservoir_indirect_sample_normal_buffers_[previous_index],
+            reservoir_buffers.indirect_sample_normal);
+        upload(restir.reservoir_indirect_sample_reservoir_buffers_[previous_index],
+            reservoir_buffers.indirect_sample_reservoir);
+    }
+}
+
+void GI1::resolveSharedResources(CapsaicinInternal const &capsaicin) noexcept
+{
+    shared_.exposure = capsaicin.getSharedBufferHandle("Exposure");
+
+    shared_.visibility_depth    = capsaicin.getSharedTextureHandle("VisibilityDepth");
+    shared_.geometry_normal     = capsaicin.getSharedTextureHandle("GeometryNormal");
+    shared_.shading_normal      = capsaicin.getSharedTextureHandle("ShadingNormal");
+    shared_.velocity            = capsaicin.getSharedTextureHandle("Velocity");
+    shared_.gradients           = capsaicin.getSharedTextureHandle("Gradients");
+    shared_.roughness           = capsaicin.getSharedTextureHandle("Roughness");
+    shared_.visibility          = capsaicin.getSharedTextureHandle("Visibility");
+    shared_.reflection          = capsaicin.getSharedTextureHandle("Reflection");
+    shared_.global_illumination = capsaicin.getSharedTextureHandle("GlobalIllumination");
+    shared_.debug               = capsaicin.getSharedTextureHandle("Debug");
+
+    shared_.prev_visibility_depth      = capsaicin.getSharedTextureHandle("PrevVisibilityDepth");
+    shared_.prev_geometry_normal       = capsaicin.getSharedTextureHandle("PrevGeometryNormal");
+    shared_.prev_shading_normal        = capsaicin.getSharedTextureHandle("PrevShadingNormal");
+    shared_.prev_roughness             = capsaicin.getSharedTextureHandle("PrevRoughness");
+    shared_.prev_reflection            = capsaicin.getSharedTextureHandle("PrevReflection");
+    shared_.prev_combined_illumination = capsaicin.getSharedTextureHandle("PrevCombinedIllumination");
+
+    shared_.occlusion_and_bent_normal = capsaicin.getSharedTextureHandle("OcclusionAndBentNormal");
+    shared_.near_field_global_illumination =
+        capsaicin.getSharedTextureHandle("NearFieldGlobalIllumination");
+
+    shared_.light_sampler      = capsaicin.getComponentHandle<LightSamplerGridStream>();
+    shared_.brdf_lut           = capsaicin.getComponentHandle<BrdfLut>();
+    shared_.prefilter_ibl      = capsaicin.getComponentHandle<PrefilterIBL>();
+    shared_.blue_noise_sampler = capsaicin.getComponentHandle<BlueNoiseSampler>();
+    shared_.rng                = capsaicin.getComponentHandle<RandomNumberGenerator>();
 }
 } // namespace Capsaicin
@@ -21,13 +21,22 @@ THE SOFTWARE.
 ********************************************************************/
 #pragma once
 
+#include "gi1_cache_snapshot.h"
 #include "gi1_shared.h"
+#include "hash_grid_cache_resize_policy.h"
+#include "render_option_registry.h"
 #include "render_technique.h"
 
 #include <gfx_scene.h>
 
 namespace Capsaicin
 {
+class BlueNoiseSampler;
+class BrdfLut;
+class LightSamplerGridStream;
+class PrefilterIBL;
+class RandomNumberGenerator;
+
 class GI1 final : public RenderTechnique
 {
 public:
@@ -68,8 +77,14 @@ class GI1 final : public RenderTechnique
         uint32_t gi1_hash_grid_cache_debug_max_cell_decay      = 0; // Debug cells touched this frame
         bool     gi1_hash_grid_cache_debug_stats               = false;
         uint32_t gi1_hash_grid_cache_debug_max_bucket_overflow = 64;
+        bool     gi1_hash_grid_cache_adaptive                  = false; // Resize the cache to its occupancy
+        uint32_t gi1_hash_grid_cache_adaptive_min_memory       = 256;   // MiB
+        uint32_t gi1_hash_grid_cache_adaptive_max_memory       = 2048;  // MiB
         float    gi1_reservoir_cache_cell_size                 = 16.0F;
 
+        std::string gi1_cache_snapshot_directory  = ""; // Warm start snapshots are disabled when empty
+        uint32_t    gi1_cache_snapshot_save_frame = 0;  // Frame to save the snapshot at, 0 to never save
+
         bool     gi1_glossy_reflections_halfres                            = true;
         uint32_t gi1_glossy_reflections_denoiser_mode                      = 1; // Atrous Ratio Estimator
         bool     gi1_glossy_reflections_cleanup_fireflies                  = true;
@@ -149,6 +164,65 @@ class GI1 final : public RenderTechnique
     void generateDispatch(GfxBuffer const &count_buffer, uint32_t group_size) const;
     void generateDispatchRays(GfxBuffer const &count_buffer) const;
     void clearHashGridCache() const;
+    void adaptHashGridCache(uint32_t frame_index);
+
+    /**
+     * Gets the layout of the radiance and reservoir caches, snapshots can only be restored into an identical
+     * layout.
+     * @return The cache layout.
+     */
+    [[nodiscard]] GI1CacheSnapshot::Layout getCacheSnapshotLayout() const noexcept;
+
+    /**
+     * Reads back the radiance and reservoir caches and saves them to the snapshot of the current scene.
+     * @param capsaicin   Current framework context.
+     * @param frame_index The current frame index.
+     */
+    void saveCacheSnapshot(CapsaicinInternal const &capsaicin, uint32_t frame_index);
+
+    /**
+     * Restores the radiance and reservoir caches from the snapshot of the current scene, if any.
+     * Must be called once the caches have been cleared and allocated.
+     * @param capsaicin   Current framework context.
+     * @param frame_index The current frame index.
+     */
+    void restoreCacheSnapshot(CapsaicinInternal const &capsaicin, uint32_t frame_index);
+
+    /**
+     * Resolves the handles of the shared textures, buffers and components accessed every frame.
+     * @param capsaicin Current framework context.
+     */
+    void resolveSharedResources(CapsaicinInternal const &capsaicin) noexcept;
+
+    // Handles of the shared resources accessed every frame, resolved on init:
+    struct SharedResources
+    {
+        SharedBufferHandle  exposure;
+        SharedTextureHandle visibility_depth;
+        SharedTextureHandle geometry_normal;
+        SharedTextureHandle shading_normal;
+        SharedTextureHandle velocity;
+        SharedTextureHandle gradients;
+        SharedTextureHandle roughness;
+        SharedTextureHandle occlusion_and_bent_normal;
+        SharedTextureHandle near_field_global_illumination;
+        SharedTextureHandle visibility;
+        SharedTextureHandle prev_visibility_depth;
+        SharedTextureHandle prev_geometry_normal;
+        SharedTextureHandle prev_shading_normal;
+        SharedTextureHandle prev_roughness;
+        SharedTextureHandle reflection;
+        SharedTextureHandle prev_reflection;
+        SharedTextureHandle global_illumination;
+        SharedTextureHandle prev_combined_illumination;
+        SharedTextureHandle debug;
+
+        ComponentHandle<LightSamplerGridStream> light_sampler;
+        ComponentHandle<BrdfLut>                brdf_lut;
+        ComponentHandle<PrefilterIBL>           prefilter_ibl;
+        ComponentHandle<BlueNoiseSampler>       blue_noise_sampler;
+        ComponentHandle<RandomNumberGenerator>  rng;
+    };
 
     class Base
     {
@@ -241,6 +315,23 @@ class GI1 final : public RenderTechnique
 
         void ensureMemoryIsAllocated(RenderOptions const &options, std::string_view const &debug_view);
 
+        /**
+         * Allocates the resized table and starts migrating the live tiles into it.
+         * The tiles are rehashed a slice per frame while the current table keeps on being used, the resized
+         * table is only swapped in once all slices have been processed.
+         * @param num_buckets     The new bucket count (log2).
+         * @param use_multibounce True if the indirect cell values need migrating as well.
+         */
+        void beginMigration(uint32_t num_buckets, bool use_multibounce);
+
+        /** Swaps the fully migrated table in, must be called after the last slice has been dispatched. */
+        void finishMigration();
+
+        /** Drops any pending migration. */
+        void cancelMigration();
+
+        static constexpr uint32_t migration_frame_count_ = 8; /**< Frames a migration is spread over */
+
         uint32_t max_ray_count_                         = 0;
         uint32_t max_combined_ray_count_                = 0;
         uint32_t num_buckets_                           = 0;
@@ -302,6 +393,25 @@ class GI1 final : public RenderTechnique
         GfxBuffer &radiance_cache_debug_stats_buffer_;
         GfxBuffer  radiance_cache_debug_stats_readback_buffers_[kGfxConstant_BackBufferCount];
         bool       radiance_cache_debug_stats_readback_is_pending_[kGfxConstant_BackBufferCount];
+        GfxBuffer &radiance_cache_bucket_hash_buffer_;
+        GfxBuffer &radiance_cache_stats_buffer_;
+        GfxBuffer  radiance_cache_stats_readback_buffers_[kGfxConstant_BackBufferCount];
+        bool       radiance_cache_stats_readback_is_pending_[kGfxConstant_BackBufferCount];
+        GfxBuffer &radiance_cache_migrate_hash_buffer_;
+        GfxBuffer &radiance_cache_migrate_decay_tile_buffer_;
+        GfxBuffer &radiance_cache_migrate_bucket_hash_buffer_;
+        GfxBuffer &radiance_cache_migrate_value_buffer_;
+        GfxBuffer &radiance_cache_migrate_value_indirect_buffer_;
+        GfxBuffer &radiance_cache_migrate_packed_tile_count_buffer_;
+        GfxBuffer &radiance_cache_migrate_packed_tile_index_buffer_;
+
+        HashGridCacheResizePolicy           resize_policy_;
+        HashGridCacheResizePolicy::Settings resize_policy_settings_;
+        uint32_t                            migrate_num_buckets_   = 0; // log2, 0 when not migrating
+        uint32_t                            migrate_tile_offset_   = 0;
+        uint32_t                            migrate_tile_count_    = 0; // tiles in the slice of this frame
+        uint32_t                            stats_live_tile_count_ = 0;
+        uint32_t                            stats_overflow_count_  = 0;
 
         std::vector<float> debug_bucket_occupancy_histogram_;
         std::vector<float> debug_bucket_overflow_histogram_;
@@ -391,8 +501,15 @@ class GI1 final : public RenderTechnique
         uint32_t   color_buffer_index_ = 0;
     };
 
-    RenderOptions    options_;
-    std::string_view debug_view_;
+    RenderOptions                     options_;
+    RenderOptionRegistry::GroupHandle option_group_      = RenderOptionRegistry::InvalidGroupHandle;
+    uint64_t                          option_generation_ = 0; /**< Last option generation converted */
+    RenderOptionRegistry::Handle      alpha_testing_option_ =
+        RenderOptionRegistry::InvalidHandle; /**< Mapped visibility buffer option (owned by another group) */
+    std::string_view                  debug_view_;
+    SharedResources                   shared_;
+    bool                              cache_snapshot_save_pending_        = false;
+    uint32_t                          cache_snapshot_restored_tile_count_ = 0;
     GfxTexture       depth_buffer_;
     GfxTexture       irradiance_buffer_;
     GfxBuffer        draw_command_buffer_;
@@ -438,6 +555,7 @@ class GI1 final : public RenderTechnique
 
     // Hash grid cache kernels:
     GfxKernel purge_tiles_kernel_;
+    GfxKernel migrate_tiles_kernel_;
     GfxKernel populate_multibounce_cells_kernel_;
     GfxKernel populate_cells_kernel_;
     GfxKernel update_multibounce_cells_kernel_;
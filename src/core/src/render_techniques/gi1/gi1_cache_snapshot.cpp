@@ -0,0 +1,340 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "gi1_cache_snapshot.h"
+
+#include "atomic_file.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kGI1CacheSnapshotMagic = 0x43314947U; /**< 'GI1C' */
+/** Must be incremented whenever the cache encoding changes */
+constexpr uint32_t kGI1CacheSnapshotVersion = 1U;
+
+/**
+ * Header found at the start of every snapshot file.
+ * Each data array follows the header in the same order as the counts array.
+ */
+struct GI1CacheSnapshotHeader
+{
+    uint32_t                 magic;
+    uint32_t                 version;
+    GI1CacheSnapshot::Layout layout;
+    uint64_t                 counts[7]; /**< Element count of each data array */
+};
+
+/**
+ * Combines the hash of a file path with an existing hash value.
+ * Paths are made absolute and normalised first so that different spellings of the same file match.
+ * @param hash     The hash value to combine with (FNV-1a).
+ * @param filePath The file path.
+ * @return The combined hash value.
+ */
+uint64_t HashPath(uint64_t hash, std::filesystem::path const &filePath) noexcept
+{
+    std::error_code ec;
+    auto            fullPath = std::filesystem::weakly_canonical(filePath, ec);
+    if (ec)
+    {
+        fullPath = filePath.lexically_normal();
+    }
+    for (auto const c : fullPath.generic_u8string())
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x00000100000001B3;
+    }
+    // Separate consecutive paths so that moving characters between them changes the hash
+    hash ^= 0xFF;
+    hash *= 0x00000100000001B3;
+    return hash;
+}
+} // namespace
+
+void GI1CacheSnapshot::captureHashGrid(Layout const &layout, uint32_t const frame_index,
+    uint32_t const num_tiles, uint32_t const *hash, uint32_t const *decay_tile, uint32_t const *bucket_hash,
+    uint32_t const *value, uint32_t const *value_indirect) noexcept
+{
+    layout_ = layout;
+    tiles_.clear();
+    values_.clear();
+    values_indirect_.clear();
+
+    // Evicted tiles have their hash cleared so only live tiles are kept
+    size_t const cell_value_count = 2 * static_cast<size_t>(layout.num_cells_per_tile);
+    for (uint32_t tile_index = 0; tile_index < num_tiles; ++tile_index)
+    {
+        if (hash[tile_index] == 0)
+        {
+            continue;
+        }
+        tiles_.push_back({.hash = hash[tile_index],
+            .age                = frame_index - decay_tile[tile_index], // account for integer wraparound
+            .bucket_hash        = bucket_hash[tile_index]});
+        size_t const offset = tile_index * cell_value_count;
+        values_.insert(values_.end(), value + offset, value + offset + cell_value_count);
+        if (layout.use_multibounce != 0)
+        {
+            values_indirect_.insert(
+                values_indirect_.end(), value_indirect + offset, value_indirect + offset + cell_value_count);
+        }
+    }
+}
+
+void GI1CacheSnapshot::captureReservoirs(uint32_t const *hash, uint32_t const *hash_count,
+    uint32_t const *hash_index, uint32_t const *hash_value, uint32_t const *indirect_sample_normal,
+    uint32_t const *indirect_sample_reservoir) noexcept
+{
+    reservoir_entries_.clear();
+
+    // Only the entries used during the frame have a hash, their reservoirs are stored contiguously
+    uint32_t value_count = 0;
+    for (uint32_t entry_index = 0; entry_index < layout_.reservoir_num_entries; ++entry_index)
+    {
+        if (hash[entry_index] == 0)
+        {
+            continue;
+        }
+        reservoir_entries_.push_back({.entry_index = entry_index,
+            .hash                                  = hash[entry_index],
+            .count                                 = hash_count[entry_index],
+            .index                                 = hash_index[entry_index]});
+        value_count = std::max(value_count, hash_index[entry_index] + hash_count[entry_index]);
+    }
+    value_count = std::min(value_count, layout_.reservoir_num_entries);
+    reservoir_values_.assign(hash_value, hash_value + value_count);
+    reservoir_normals_.assign(indirect_sample_normal, indirect_sample_normal + layout_.reservoir_num_samples);
+    reservoir_reservoirs_.assign(
+        indirect_sample_reservoir, indirect_sample_reservoir + 4 * size_t {layout_.reservoir_num_samples});
+}
+
+uint32_t GI1CacheSnapshot::restoreHashGrid(
+    uint32_t const num_buckets, uint32_t const frame_index, HashGridBuffers &buffers) const noexcept
+{
+    uint32_t const num_tiles        = num_buckets * layout_.num_tiles_per_bucket;
+    size_t const   cell_value_count = 2 * static_cast<size_t>(layout_.num_cells_per_tile);
+    buffers.hash.assign(num_tiles, 0);
+    buffers.decay_tile.assign(num_tiles, 0);
+    buffers.bucket_hash.assign(num_tiles, 0);
+    buffers.value.assign(num_tiles * cell_value_count, 0);
+    buffers.value_indirect.assign(layout_.use_multibounce != 0 ? num_tiles * cell_value_count : 0, 0);
+    buffers.packed_tile_index.clear();
+
+    // Rehash all tiles using the same probing as 'HashGridCache_InsertCell()'
+    for (size_t i = 0; i < tiles_.size(); ++i)
+    {
+        Tile const    &tile         = tiles_[i];
+        uint32_t const bucket_index = tile.bucket_hash % num_buckets;
+        for (uint32_t bucket_offset = 0; bucket_offset < layout_.num_tiles_per_bucket; ++bucket_offset)
+        {
+            uint32_t const tile_index = bucket_offset + bucket_index * layout_.num_tiles_per_bucket;
+            if (buffers.hash[tile_index] == tile.hash)
+            {
+                break; // stale duplicate of an already restored tile
+            }
+            if (buffers.hash[tile_index] != 0)
+            {
+                continue;
+            }
+            buffers.hash[tile_index]        = tile.hash;
+            buffers.decay_tile[tile_index]  = frame_index - tile.age; // account for integer wraparound
+            buffers.bucket_hash[tile_index] = tile.bucket_hash;
+            std::copy_n(values_.begin() + static_cast<ptrdiff_t>(i * cell_value_count), cell_value_count,
+                buffers.value.begin() + static_cast<ptrdiff_t>(tile_index * cell_value_count));
+            if (layout_.use_multibounce != 0)
+            {
+                std::copy_n(values_indirect_.begin() + static_cast<ptrdiff_t>(i * cell_value_count),
+                    cell_value_count,
+                    buffers.value_indirect.begin() + static_cast<ptrdiff_t>(tile_index * cell_value_count));
+            }
+            buffers.packed_tile_index.push_back(tile_index);
+            break;
+        }
+    }
+    return static_cast<uint32_t>(buffers.packed_tile_index.size());
+}
+
+void GI1CacheSnapshot::restoreReservoirs(ReservoirBuffers &buffers) const noexcept
+{
+    buffers.hash.assign(layout_.reservoir_num_entries, 0);
+    buffers.hash_count.assign(layout_.reservoir_num_entries, 0);
+    buffers.hash_index.assign(layout_.reservoir_num_entries, 0);
+    for (auto const &entry : reservoir_entries_)
+    {
+        buffers.hash[entry.entry_index]       = entry.hash;
+        buffers.hash_count[entry.entry_index] = entry.count;
+        buffers.hash_index[entry.entry_index] = entry.index;
+    }
+    buffers.hash_value.assign(layout_.reservoir_num_entries, 0);
+    std::ranges::copy(reservoir_values_, buffers.hash_value.begin());
+    buffers.indirect_sample_normal    = reservoir_normals_;
+    buffers.indirect_sample_reservoir = reservoir_reservoirs_;
+}
+
+bool GI1CacheSnapshot::isHashGridCompatible(Layout const &layout) const noexcept
+{
+    return !tiles_.empty() && layout.cell_size == layout_.cell_size
+        && layout.min_cell_size == layout_.min_cell_size && layout.tile_cell_ratio == layout_.tile_cell_ratio
+        && layout.num_tiles_per_bucket == layout_.num_tiles_per_bucket
+        && layout.num_cells_per_tile == layout_.num_cells_per_tile
+        && layout.use_multibounce == layout_.use_multibounce;
+}
+
+bool GI1CacheSnapshot::isReservoirCompatible(Layout const &layout) const noexcept
+{
+    // Reservoirs are indexed by ray so the render resolution must also be the same
+    return !reservoir_entries_.empty() && layout.reservoir_num_entries == layout_.reservoir_num_entries
+        && layout.reservoir_num_samples == layout_.reservoir_num_samples;
+}
+
+bool GI1CacheSnapshot::load(std::filesystem::path const &filePath) noexcept
+{
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    auto const fileSize = static_cast<uint64_t>(file.tellg());
+    if (fileSize < sizeof(GI1CacheSnapshotHeader))
+    {
+        return false;
+    }
+    std::vector<char> data(fileSize);
+    file.seekg(0);
+    if (!file.read(data.data(), static_cast<std::streamsize>(fileSize)))
+    {
+        return false;
+    }
+
+    GI1CacheSnapshotHeader header;
+    memcpy(&header, data.data(), sizeof(GI1CacheSnapshotHeader));
+    if (header.magic != kGI1CacheSnapshotMagic || header.version != kGI1CacheSnapshotVersion)
+    {
+        return false;
+    }
+    uint64_t const cell_value_count = 2 * uint64_t {header.layout.num_cells_per_tile};
+    if (header.counts[1] != header.counts[0] * cell_value_count
+        || header.counts[2] != (header.layout.use_multibounce != 0 ? header.counts[1] : 0)
+        || header.counts[4] > header.layout.reservoir_num_entries
+        || header.counts[5] != (header.counts[3] > 0 ? header.layout.reservoir_num_samples : 0)
+        || header.counts[6] != 4 * header.counts[5])
+    {
+        return false;
+    }
+
+    uint64_t   offset      = sizeof(GI1CacheSnapshotHeader);
+    auto const readSection = [&]<typename T>(std::vector<T> &values, uint64_t const count) {
+        uint64_t const size = count * sizeof(T);
+        if (offset + size > fileSize)
+        {
+            return false;
+        }
+        values.resize(count);
+        memcpy(values.data(), data.data() + offset, size);
+        offset += size;
+        return true;
+    };
+    layout_ = header.layout;
+    if (!readSection(tiles_, header.counts[0]) || !readSection(values_, header.counts[1])
+        || !readSection(values_indirect_, header.counts[2])
+        || !readSection(reservoir_entries_, header.counts[3])
+        || !readSection(reservoir_values_, header.counts[4])
+        || !readSection(reservoir_normals_, header.counts[5])
+        || !readSection(reservoir_reservoirs_, header.counts[6]))
+    {
+        *this = {};
+        return false;
+    }
+    for (auto const &entry : reservoir_entries_)
+    {
+        if (entry.entry_index >= layout_.reservoir_num_entries)
+        {
+            *this = {};
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GI1CacheSnapshot::save(std::filesystem::path const &filePath) const noexcept
+{
+    std::error_code ec;
+    if (filePath.has_parent_path())
+    {
+        std::filesystem::create_directories(filePath.parent_path(), ec);
+        if (ec)
+        {
+            return false;
+        }
+    }
+
+    GI1CacheSnapshotHeader const header = {.magic = kGI1CacheSnapshotMagic,
+        .version                                  = kGI1CacheSnapshotVersion,
+        .layout                                   = layout_,
+        .counts = {tiles_.size(), values_.size(), values_indirect_.size(), reservoir_entries_.size(),
+            reservoir_values_.size(), reservoir_normals_.size(), reservoir_reservoirs_.size()}};
+
+    // Written atomically so that a partially written snapshot is never picked up by a later run
+    return WriteFileAtomic(filePath, [&](std::ofstream &file) {
+        auto const writeSection = [&]<typename T>(std::vector<T> const &values) {
+            file.write(reinterpret_cast<char const *>(values.data()),
+                static_cast<std::streamsize>(values.size() * sizeof(T)));
+        };
+        file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        writeSection(tiles_);
+        writeSection(values_);
+        writeSection(values_indirect_);
+        writeSection(reservoir_entries_);
+        writeSection(reservoir_values_);
+        writeSection(reservoir_normals_);
+        writeSection(reservoir_reservoirs_);
+        return file.good();
+    });
+}
+
+std::filesystem::path GI1CacheSnapshot::GetFilePath(std::filesystem::path const &directory,
+    std::filesystem::path const &scene, std::filesystem::path const &environmentMap,
+    std::string_view const &camera) noexcept
+{
+    // Scenes with the same name in different directories must not share a snapshot so the full paths are
+    // hashed as well, only the names are kept readable
+    uint64_t hash = HashPath(0xcbf29ce484222325, scene);
+    hash          = HashPath(hash, environmentMap);
+
+    std::string fileName = scene.stem().string() + '_';
+    fileName += environmentMap.empty() ? std::string("None") : environmentMap.stem().string();
+    fileName += '_';
+    fileName.append(camera);
+    std::erase_if(fileName, [](unsigned char const c) { return std::isspace(c); });
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "_%016llx.gi1cache", static_cast<unsigned long long>(hash));
+    return directory / (fileName + suffix);
+}
+} // namespace Capsaicin
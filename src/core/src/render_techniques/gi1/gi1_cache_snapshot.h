@@ -0,0 +1,187 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * CPU copy of the GI1 radiance and reservoir caches, used to warm start later runs from a converged state.
+ * Only the live hash grid tiles and the used reservoir hash entries are kept so that snapshots stay compact.
+ * Tile decay is stored as an age relative to the frame the snapshot was taken at, which allows restoring at
+ * any frame index, and tiles are rehashed on restore so the bucket count may differ between runs.
+ */
+class GI1CacheSnapshot
+{
+public:
+    /** Cache layout, each cache can only be restored into one with an identical layout. */
+    struct Layout
+    {
+        float    cell_size             = 0.0F; /**< gi1_hash_grid_cache_cell_size */
+        float    min_cell_size         = 0.0F; /**< gi1_hash_grid_cache_min_cell_size */
+        uint32_t tile_cell_ratio       = 0;    /**< gi1_hash_grid_cache_tile_cell_ratio */
+        uint32_t num_tiles_per_bucket  = 0;    /**< Number of tiles per bucket (not log2) */
+        uint32_t num_cells_per_tile    = 0;    /**< Number of cells per tile, including all mip levels */
+        uint32_t use_multibounce       = 0;    /**< 1 if indirect cell values are stored */
+        uint32_t reservoir_num_entries = 0;    /**< Number of entries in the reservoir hash table */
+        uint32_t reservoir_num_samples = 0;    /**< Number of indirect samples (one per ray) */
+    };
+
+    /** Full size contents of the hash grid cache buffers. */
+    struct HashGridBuffers
+    {
+        std::vector<uint32_t> hash;
+        std::vector<uint32_t> decay_tile;
+        std::vector<uint32_t> bucket_hash;
+        std::vector<uint32_t> value;          /**< 2 values per cell */
+        std::vector<uint32_t> value_indirect; /**< 2 values per cell, empty without multi-bounce */
+        std::vector<uint32_t> packed_tile_index;
+    };
+
+    /** Full size contents of the previous frame's reservoir buffers. */
+    struct ReservoirBuffers
+    {
+        std::vector<uint32_t> hash;
+        std::vector<uint32_t> hash_count;
+        std::vector<uint32_t> hash_index;
+        std::vector<uint32_t> hash_value;
+        std::vector<uint32_t> indirect_sample_normal;
+        std::vector<uint32_t> indirect_sample_reservoir; /**< 4 values per sample */
+    };
+
+    /**
+     * Captures the hash grid cache from its read back buffers.
+     * @param layout          The cache layout.
+     * @param frame_index     The frame index the decay values are relative to.
+     * @param num_tiles       The number of tiles in the table.
+     * @param hash            The tile hashes.
+     * @param decay_tile      The frame index each tile was last touched at.
+     * @param bucket_hash     The bucket hash of each tile.
+     * @param value           The cell values.
+     * @param value_indirect  The indirect cell values, only read when multi-bounce is in use.
+     */
+    void captureHashGrid(Layout const &layout, uint32_t frame_index, uint32_t num_tiles, uint32_t const *hash,
+        uint32_t const *decay_tile, uint32_t const *bucket_hash, uint32_t const *value,
+        uint32_t const *value_indirect) noexcept;
+
+    /**
+     * Captures the reservoir cache from its read back buffers.
+     * Buffer sizes are taken from the layout passed to 'captureHashGrid()' which must be called first.
+     * @param hash                      The entry hashes.
+     * @param hash_count                The number of reservoirs in each entry.
+     * @param hash_index                The index of the first reservoir of each entry within the value list.
+     * @param hash_value                The sample index of each reservoir.
+     * @param indirect_sample_normal    The packed normal of each sample.
+     * @param indirect_sample_reservoir The packed reservoir of each sample.
+     */
+    void captureReservoirs(uint32_t const *hash, uint32_t const *hash_count, uint32_t const *hash_index,
+        uint32_t const *hash_value, uint32_t const *indirect_sample_normal,
+        uint32_t const *indirect_sample_reservoir) noexcept;
+
+    /**
+     * Rebuilds the hash grid cache buffers, tiles that no longer fit their bucket are dropped.
+     * @param       num_buckets The number of buckets in the table (not log2).
+     * @param       frame_index The current frame index.
+     * @param [out] buffers     The rebuilt buffers.
+     * @return The number of restored tiles.
+     */
+    uint32_t restoreHashGrid(
+        uint32_t num_buckets, uint32_t frame_index, HashGridBuffers &buffers) const noexcept;
+
+    /**
+     * Rebuilds the reservoir cache buffers.
+     * @param [out] buffers The rebuilt buffers.
+     */
+    void restoreReservoirs(ReservoirBuffers &buffers) const noexcept;
+
+    /**
+     * Checks if the hash grid cache can be restored into a cache using a given layout.
+     * @param layout The cache layout.
+     * @return True if compatible, False otherwise.
+     */
+    [[nodiscard]] bool isHashGridCompatible(Layout const &layout) const noexcept;
+
+    /**
+     * Checks if the reservoir cache can be restored into a cache using a given layout.
+     * @param layout The cache layout.
+     * @return True if compatible, False otherwise.
+     */
+    [[nodiscard]] bool isReservoirCompatible(Layout const &layout) const noexcept;
+
+    [[nodiscard]] uint32_t getTileCount() const noexcept { return static_cast<uint32_t>(tiles_.size()); }
+
+    /**
+     * Loads a snapshot from disk.
+     * @param filePath The snapshot file.
+     * @return True if a valid snapshot was loaded, False otherwise.
+     */
+    bool load(std::filesystem::path const &filePath) noexcept;
+
+    /**
+     * Saves the snapshot to disk.
+     * @param filePath The snapshot file (its directory is created if required).
+     * @return True if the file was written successfully, False otherwise.
+     */
+    bool save(std::filesystem::path const &filePath) const noexcept;
+
+    /**
+     * Gets the file used to store the snapshot for a given scene and camera.
+     * @param directory      The directory snapshots are stored in.
+     * @param scene          The scene file.
+     * @param environmentMap The environment map file (may be empty).
+     * @param camera         The camera name.
+     * @return The file path.
+     */
+    [[nodiscard]] static std::filesystem::path GetFilePath(std::filesystem::path const &directory,
+        std::filesystem::path const &scene, std::filesystem::path const &environmentMap,
+        std::string_view const &camera) noexcept;
+
+private:
+    struct Tile
+    {
+        uint32_t hash;
+        uint32_t age; /**< Frames since the tile was last touched */
+        uint32_t bucket_hash;
+    };
+
+    struct ReservoirEntry
+    {
+        uint32_t entry_index;
+        uint32_t hash;
+        uint32_t count;
+        uint32_t index;
+    };
+
+    Layout                      layout_;
+    std::vector<Tile>           tiles_;
+    std::vector<uint32_t>       values_;          /**< Cell values of all tiles, in tile order */
+    std::vector<uint32_t>       values_indirect_; /**< Indirect cell values of all tiles, in tile order */
+    std::vector<ReservoirEntry> reservoir_entries_;
+    std::vector<uint32_t>       reservoir_values_;
+    std::vector<uint32_t>       reservoir_normals_;
+    std::vector<uint32_t>       reservoir_reservoirs_;
+};
+} // namespace Capsaicin
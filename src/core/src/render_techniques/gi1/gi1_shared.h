@@ -80,6 +80,9 @@ struct HashGridCacheConstants
     uint                   first_cell_offset_tile_mip2;
     uint                   first_cell_offset_tile_mip3;
     uint                   buffer_ping_pong;
+    uint                   migrate_num_buckets; // bucket count of the table being migrated into
+    uint                   migrate_tile_offset; // first tile of the slice migrated this frame
+    uint                   migrate_tile_count;
     float                  max_sample_count;
     float                  discard_multibounce_ray_probability;
     float                  max_multibounce_sample_count;
@@ -123,6 +126,13 @@ enum HashGridBufferNamesUint
     HASHGRIDCACHE_DEBUGSTATSBUCKETOVERFLOWBUFFER,
     HASHGRIDCACHE_DEBUGSTATSFREEBUCKETBUFFER,
     HASHGRIDCACHE_DEBUGSTATSUSEDBUCKETBUFFER,
+    HASHGRIDCACHE_BUCKETHASHBUFFER,
+    HASHGRIDCACHE_STATSBUFFER,
+    HASHGRIDCACHE_MIGRATEHASHBUFFER,
+    HASHGRIDCACHE_MIGRATEDECAYTILEBUFFER,
+    HASHGRIDCACHE_MIGRATEBUCKETHASHBUFFER,
+    HASHGRIDCACHE_MIGRATEPACKEDTILECOUNTBUFFER,
+    HASHGRIDCACHE_MIGRATEPACKEDTILEINDEXBUFFER,
     HASHGRID_UINT_BUFFER_COUNT
 };
 
@@ -131,6 +141,8 @@ enum HashGridBufferNamesUint2
     HASHGRIDCACHE_VALUEBUFFER = 0,
     HASHGRIDCACHE_VALUEINDIRECTBUFFER,
     HASHGRIDCACHE_MULTIBOUNCEINFOBUFFER,
+    HASHGRIDCACHE_MIGRATEVALUEBUFFER,
+    HASHGRIDCACHE_MIGRATEVALUEINDIRECTBUFFER,
     HASHGRID_UINT2_BUFFER_COUNT
 };
 
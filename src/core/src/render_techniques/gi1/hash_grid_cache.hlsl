@@ -84,6 +84,18 @@ RWStructuredBuffer<float4> g_HashGridCache_BuffersFloat4[] : register(space98);
 #define                    g_HashGridCache_DebugStatsFreeBucketCountBuffer     g_HashGridCache_BuffersUint  [HASHGRIDCACHE_DEBUGSTATSFREEBUCKETBUFFER]
 #define                    g_HashGridCache_DebugStatsUsedBucketCountBuffer     g_HashGridCache_BuffersUint  [HASHGRIDCACHE_DEBUGSTATSUSEDBUCKETBUFFER]
 #define                    g_HashGridCache_DebugStatsBuffer                    g_HashGridCache_BuffersFloat [HASHGRIDCACHE_DEBUGSTATSBUFFER]
+#define                    g_HashGridCache_BucketHashBuffer                    g_HashGridCache_BuffersUint  [HASHGRIDCACHE_BUCKETHASHBUFFER]
+#define                    g_HashGridCache_StatsBuffer                         g_HashGridCache_BuffersUint  [HASHGRIDCACHE_STATSBUFFER]
+#define                    g_HashGridCache_MigrateHashBuffer                   g_HashGridCache_BuffersUint  [HASHGRIDCACHE_MIGRATEHASHBUFFER]
+#define                    g_HashGridCache_MigrateDecayTileBuffer              g_HashGridCache_BuffersUint  [HASHGRIDCACHE_MIGRATEDECAYTILEBUFFER]
+#define                    g_HashGridCache_MigrateBucketHashBuffer             g_HashGridCache_BuffersUint  [HASHGRIDCACHE_MIGRATEBUCKETHASHBUFFER]
+#define                    g_HashGridCache_MigratePackedTileCountBuffer        g_HashGridCache_BuffersUint  [HASHGRIDCACHE_MIGRATEPACKEDTILECOUNTBUFFER]
+#define                    g_HashGridCache_MigratePackedTileIndexBuffer        g_HashGridCache_BuffersUint  [HASHGRIDCACHE_MIGRATEPACKEDTILEINDEXBUFFER]
+#define                    g_HashGridCache_MigrateValueBuffer                  g_HashGridCache_BuffersUint2 [HASHGRIDCACHE_MIGRATEVALUEBUFFER]
+#define                    g_HashGridCache_MigrateValueIndirectBuffer          g_HashGridCache_BuffersUint2 [HASHGRIDCACHE_MIGRATEVALUEINDIRECTBUFFER]
+
+// The always-on statistics gathered for resizing the cache (see HashGridCacheResizePolicy):
+#define kHashGridCache_StatsOverflowCount 0 // the number of insertions that found their bucket full
 
 //!
 //! Hash-grid radiance caching common functions.
@@ -119,6 +131,7 @@ struct HashGridCache_Data
 struct HashGridCache_Desc
 {
     uint bucket_index;   // bucket index
+    uint bucket_hash;    // bucket hash, kept per tile so that the cache can be rehashed when resized
     uint tile_hash;      // tile hash
     uint2 cell_offset;   // cell offset within the tile
 #ifdef DEBUG_HASH_CELLS
@@ -150,10 +163,11 @@ HashGridCache_Desc HashGridCache_GetDesc(in HashGridCache_Data data)
     uint3 d = asuint(int3(signed_d));             //
     uint1 t = uint(hit_distance < hit_tile_size);
 
-    uint bucket_index = pcgHash(l +
+    uint bucket_hash  = pcgHash(l +
                         pcgHash(c.x + pcgHash(c.y + pcgHash(c.z +
                         pcgHash(d.x + pcgHash(d.y + pcgHash(d.z +
-                        pcgHash(t)))))))) % g_HashGridCacheConstants.num_buckets;
+                        pcgHash(t))))))));
+    uint bucket_index = bucket_hash % g_HashGridCacheConstants.num_buckets;
 
     uint tile_hash  = max(1,
                       xxHash(l +
@@ -180,6 +194,7 @@ HashGridCache_Desc HashGridCache_GetDesc(in HashGridCache_Data data)
 
     HashGridCache_Desc desc;
     desc.bucket_index  = bucket_index;
+    desc.bucket_hash   = bucket_hash;
     desc.tile_hash     = tile_hash;
     desc.cell_offset   = cell_offset;
 #ifdef DEBUG_HASH_CELLS
@@ -260,6 +275,7 @@ uint HashGridCache_InsertCell(in HashGridCache_Data data, out uint tile_index, o
         if (previous_hash == 0)
         {
             is_new_tile = true;
+            g_HashGridCache_BucketHashBuffer[tile_index] = desc.bucket_hash;
             break;  // inserted new tile and cell
         }
         if (previous_hash == desc.tile_hash)
@@ -267,8 +283,9 @@ uint HashGridCache_InsertCell(in HashGridCache_Data data, out uint tile_index, o
     }
     if (bucket_offset >= g_HashGridCacheConstants.num_tiles_per_bucket)
     {
-    #ifdef DEBUG_HASH_STATS
         uint previous_value;
+        InterlockedAdd(g_HashGridCache_StatsBuffer[kHashGridCache_StatsOverflowCount], 1, previous_value);
+    #ifdef DEBUG_HASH_STATS
         InterlockedAdd(g_HashGridCache_DebugStatsBucketOverflowCountBuffer[desc.bucket_index], 1, previous_value);
     #endif
         return kGI1_InvalidId; // too much collisions, out of tiles :(
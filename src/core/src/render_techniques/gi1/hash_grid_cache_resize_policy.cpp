@@ -0,0 +1,134 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "hash_grid_cache_resize_policy.h"
+
+#include <algorithm>
+
+namespace Capsaicin
+{
+void HashGridCacheResizePolicy::reset(
+    uint32_t const num_buckets, uint32_t const num_tiles_per_bucket) noexcept
+{
+    num_buckets_          = num_buckets;
+    num_tiles_per_bucket_ = num_tiles_per_bucket;
+    load_factor_          = 0.0F;
+    overflow_ratio_       = 0.0F;
+    has_history_          = false;
+    grow_frames_          = 0;
+    shrink_frames_        = 0;
+    cooldown_frames_      = 0;
+}
+
+uint32_t HashGridCacheResizePolicy::update(
+    Settings const &settings, uint32_t const live_tiles, uint32_t const overflow_count) noexcept
+{
+    auto const  capacity       = static_cast<float>(1ULL << (num_buckets_ + num_tiles_per_bucket_));
+    float const load_factor    = static_cast<float>(live_tiles) / capacity;
+    float const overflow_ratio = static_cast<float>(overflow_count) / capacity;
+    if (!has_history_)
+    {
+        load_factor_    = load_factor;
+        overflow_ratio_ = overflow_ratio;
+        has_history_    = true;
+    }
+    else
+    {
+        load_factor_ += settings.smoothing * (load_factor - load_factor_);
+        overflow_ratio_ += settings.smoothing * (overflow_ratio - overflow_ratio_);
+    }
+
+    // The bounds may have changed since the last resize, in which case they are enforced right away
+    uint32_t const max_num_buckets = std::clamp(settings.max_num_buckets, kMinNumBuckets, kMaxNumBuckets);
+    uint32_t const min_num_buckets = std::clamp(settings.min_num_buckets, kMinNumBuckets, max_num_buckets);
+    if (num_buckets_ > max_num_buckets || num_buckets_ < min_num_buckets)
+    {
+        return std::clamp(num_buckets_, min_num_buckets, max_num_buckets);
+    }
+
+    if (cooldown_frames_ > 0)
+    {
+        --cooldown_frames_;
+        return num_buckets_;
+    }
+
+    // Shrinking doubles the load factor, so it is only allowed when the result stays below the grow
+    // threshold; together with the delays this provides the hysteresis that prevents oscillations
+    bool const should_grow =
+        load_factor_ > settings.grow_load_factor || overflow_ratio_ > settings.grow_overflow_ratio;
+    bool const should_shrink = !should_grow && load_factor_ < settings.shrink_load_factor
+                            && 2.0F * load_factor_ < settings.grow_load_factor
+                            && overflow_ratio_ < 0.1F * settings.grow_overflow_ratio;
+    grow_frames_   = should_grow && num_buckets_ < max_num_buckets ? grow_frames_ + 1 : 0;
+    shrink_frames_ = should_shrink && num_buckets_ > min_num_buckets ? shrink_frames_ + 1 : 0;
+
+    if (grow_frames_ > 0 && grow_frames_ >= settings.grow_delay)
+    {
+        return num_buckets_ + 1;
+    }
+    if (shrink_frames_ > 0 && shrink_frames_ >= settings.shrink_delay)
+    {
+        return num_buckets_ - 1;
+    }
+    return num_buckets_;
+}
+
+void HashGridCacheResizePolicy::resize(Settings const &settings, uint32_t const num_buckets) noexcept
+{
+    // Rescale the running averages to the new capacity rather than waiting for them to converge again
+    float const scale = num_buckets > num_buckets_
+                          ? 1.0F / static_cast<float>(1U << (num_buckets - num_buckets_))
+                          : static_cast<float>(1U << (num_buckets_ - num_buckets));
+    load_factor_ *= scale;
+    overflow_ratio_ *= scale;
+    num_buckets_     = num_buckets;
+    grow_frames_     = 0;
+    shrink_frames_   = 0;
+    cooldown_frames_ = settings.cooldown;
+}
+
+uint64_t HashGridCacheResizePolicy::GetBytesPerTile(
+    uint32_t const num_cells_per_tile, bool const use_multibounce) noexcept
+{
+    // Per cell: value (uint2) and update accumulators, doubled for multi-bounce; per tile: hash, decay,
+    // bucket hash and packed indices
+    uint64_t const bytes_per_cell = (2 * sizeof(uint32_t) + 4 * sizeof(uint32_t)) * (use_multibounce ? 2 : 1);
+    return 5 * sizeof(uint32_t) + bytes_per_cell * num_cells_per_tile;
+}
+
+std::pair<uint32_t, uint32_t> HashGridCacheResizePolicy::GetBucketRange(
+    uint64_t bytes_per_bucket, uint64_t const min_bytes, uint64_t const max_bytes) noexcept
+{
+    bytes_per_bucket         = std::max(bytes_per_bucket, uint64_t {1});
+    uint32_t max_num_buckets = kMinNumBuckets;
+    while (max_num_buckets < kMaxNumBuckets && (bytes_per_bucket << (max_num_buckets + 1)) <= max_bytes)
+    {
+        ++max_num_buckets;
+    }
+    uint32_t min_num_buckets = kMinNumBuckets;
+    while (min_num_buckets < max_num_buckets && (bytes_per_bucket << min_num_buckets) < min_bytes)
+    {
+        ++min_num_buckets;
+    }
+    return {min_num_buckets, max_num_buckets};
+}
+} // namespace Capsaicin
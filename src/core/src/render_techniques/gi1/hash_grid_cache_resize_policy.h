@@ -0,0 +1,112 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+namespace Capsaicin
+{
+/**
+ * CPU model of the policy used for resizing the GI1 hash grid cache.
+ * Kept free of any GPU state so that it can be driven by recorded or synthetic statistics. The table size is
+ * expressed as the base 2 logarithm of its bucket count, the bucket size itself is never changed.
+ */
+class HashGridCacheResizePolicy
+{
+public:
+    struct Settings
+    {
+        uint32_t min_num_buckets     = 8;     /**< Smallest allowed bucket count (log2) */
+        uint32_t max_num_buckets     = 20;    /**< Largest allowed bucket count (log2) */
+        float    grow_load_factor    = 0.75F; /**< Averaged load factor above which the table grows */
+        float    shrink_load_factor  = 0.2F;  /**< Averaged load factor below which the table shrinks */
+        float    grow_overflow_ratio = 0.01F; /**< Averaged failed insertions per tile above which it grows */
+        float    smoothing           = 0.1F;  /**< Weight of the newest frame in the running averages */
+        uint32_t grow_delay          = 8;     /**< Frames a grow condition must hold before resizing */
+        uint32_t shrink_delay        = 240;   /**< Frames a shrink condition must hold before resizing */
+        uint32_t cooldown            = 60;    /**< Frames without any decision following a resize */
+    };
+
+    static constexpr uint32_t kMinNumBuckets = 8;  /**< Hard lower limit on the bucket count (log2) */
+    static constexpr uint32_t kMaxNumBuckets = 24; /**< Hard upper limit on the bucket count (log2) */
+
+    /**
+     * Restarts the policy from a given table size, dropping any accumulated statistics.
+     * @param num_buckets          The current bucket count (log2).
+     * @param num_tiles_per_bucket The number of tiles per bucket (log2).
+     */
+    void reset(uint32_t num_buckets, uint32_t num_tiles_per_bucket) noexcept;
+
+    /**
+     * Feeds the statistics of a single frame.
+     * @param settings       The policy settings.
+     * @param live_tiles     The number of tiles in use at the end of the frame.
+     * @param overflow_count The number of insertions that failed because their bucket was full.
+     * @return The bucket count (log2) the table should be resized to, equal to the current one if the
+     *  table should be kept as is.
+     */
+    [[nodiscard]] uint32_t update(
+        Settings const &settings, uint32_t live_tiles, uint32_t overflow_count) noexcept;
+
+    /**
+     * Commits a resize once the table has been migrated to its new size.
+     * @param settings    The policy settings.
+     * @param num_buckets The new bucket count (log2).
+     */
+    void resize(Settings const &settings, uint32_t num_buckets) noexcept;
+
+    [[nodiscard]] uint32_t getNumBuckets() const noexcept { return num_buckets_; }
+
+    [[nodiscard]] float getLoadFactor() const noexcept { return load_factor_; }
+
+    [[nodiscard]] float getOverflowRatio() const noexcept { return overflow_ratio_; }
+
+    /**
+     * Gets the memory used by a single tile of the hash grid cache, as allocated by GI1.
+     * @param num_cells_per_tile The number of cells in each tile (all mip levels).
+     * @param use_multibounce    True if the cache also stores multi-bounce values.
+     * @return The size of a tile in bytes, including all its cells.
+     */
+    [[nodiscard]] static uint64_t GetBytesPerTile(uint32_t num_cells_per_tile, bool use_multibounce) noexcept;
+
+    /**
+     * Gets the range of bucket counts whose memory footprint fits the requested bounds.
+     * @param bytes_per_bucket The memory used by a single bucket, including all its tiles and cells.
+     * @param min_bytes        The lower memory bound.
+     * @param max_bytes        The upper memory bound.
+     * @return The smallest and largest allowed bucket counts (log2), the upper bound takes precedence.
+     */
+    [[nodiscard]] static std::pair<uint32_t, uint32_t> GetBucketRange(
+        uint64_t bytes_per_bucket, uint64_t min_bytes, uint64_t max_bytes) noexcept;
+
+private:
+    uint32_t num_buckets_          = 0;
+    uint32_t num_tiles_per_bucket_ = 0;
+    float    load_factor_          = 0.0F;
+    float    overflow_ratio_       = 0.0F;
+    bool     has_history_          = false;
+    uint32_t grow_frames_          = 0;
+    uint32_t shrink_frames_        = 0;
+    uint32_t cooldown_frames_      = 0;
+};
+} // namespace Capsaicin
@@ -68,23 +68,10 @@ bool ImageMetrics::init(CapsaicinInternal const &capsaicin) noexcept
     options = convertOptions(capsaicin.getOptions());
     if (options.image_metrics_enable)
     {
-        // Initialise image comparison helpers
-        if (!metricMSE.initialise(capsaicin, GPUImageMetrics::Type::HDR_RGB, GPUImageMetrics::Operation::MSE))
-        {
-            return false;
-        }
-        if (!metricRMAE.initialise(
-                capsaicin, GPUImageMetrics::Type::HDR_RGB, GPUImageMetrics::Operation::RMAE))
-        {
-            return false;
-        }
-        if (!metricSMAPE.initialise(
-                capsaicin, GPUImageMetrics::Type::HDR_RGB, GPUImageMetrics::Operation::SMAPE))
-        {
-            return false;
-        }
-        if (!metricSSIM.initialise(
-                capsaicin, GPUImageMetrics::Type::HDR_RGB, GPUImageMetrics::Operation::SSIM))
+        // Initialise image comparison helper, all metrics are calculated together in a single fused pass
+        if (!metrics.initialise(capsaicin, GPUImageMetrics::Type::HDR_RGB,
+                {GPUImageMetrics::Operation::MSE, GPUImageMetrics::Operation::RMAE,
+                    GPUImageMetrics::Operation::SMAPE, GPUImageMetrics::Operation::SSIM}))
         {
             return false;
         }
@@ -148,21 +135,19 @@ void ImageMetrics::render(CapsaicinInternal &capsaicin) noexcept
     options = newOptions;
 
     auto const &colourBuffer = capsaicin.getSharedTexture("Color");
-    metricMSE.compareAsync(colourBuffer, referenceImage);
-    metricRMAE.compareAsync(colourBuffer, referenceImage);
-    metricSMAPE.compareAsync(colourBuffer, referenceImage);
-    metricSSIM.compareAsync(colourBuffer, referenceImage);
+    metrics.compareAsync(colourBuffer, referenceImage);
 
-    if (options.image_metrics_save_to_file && capsaicin.getFrameIndex() > metricMSE.getAsyncDelay())
+    if (options.image_metrics_save_to_file && capsaicin.getFrameIndex() > metrics.getAsyncDelay())
     {
-        auto const mse = static_cast<double>(metricMSE.getMetricValue());
+        using Operation = GPUImageMetrics::Operation;
+        auto const mse = static_cast<double>(metrics.getMetricValue(Operation::MSE));
         // RMSE = sqrt(MSE)
         double const rmse = sqrt(mse);
         // PSNR = 20log10(MaxValue) - 10log10(MSE)
         double const psnr  = -10.0 * log10(mse);
-        auto const   rmae  = static_cast<double>(metricRMAE.getMetricValue());
-        auto const   smape = static_cast<double>(metricSMAPE.getMetricValue());
-        auto const   ssim  = static_cast<double>(metricSSIM.getMetricValue());
+        auto const   rmae  = static_cast<double>(metrics.getMetricValue(Operation::RMAE));
+        auto const   smape = static_cast<double>(metrics.getMetricValue(Operation::SMAPE));
+        auto const   ssim  = static_cast<double>(metrics.getMetricValue(Operation::SSIM));
 
         // Write values to file
         outputFile << std::setprecision(10) << mse << ',' << rmse << ',' << psnr << ',' << rmae << ','
@@ -184,9 +169,9 @@ void ImageMetrics::renderGUI(CapsaicinInternal &capsaicin) const noexcept
         // Nothing to do as there is no image to compare
         return;
     }
-    double const mse = (capsaicin.getFrameIndex() > metricMSE.getAsyncDelay())
-                         ? static_cast<double>(metricMSE.getMetricValue())
-                         : 0.0;
+    bool const   valid = capsaicin.getFrameIndex() > metrics.getAsyncDelay();
+    double const mse =
+        valid ? static_cast<double>(metrics.getMetricValue(GPUImageMetrics::Operation::MSE)) : 0.0;
     ImGui::Text("PQ-MSE  :  %f", mse);
     // RMSE = sqrt(MSE)
     double const rmse = sqrt(mse);
@@ -194,17 +179,14 @@ void ImageMetrics::renderGUI(CapsaicinInternal &capsaicin) const noexcept
     // PSNR = 20log10(MaxValue) - 10log10(MSE)
     double const psnr = -10.0 * log10(mse);
     ImGui::Text("PQ-PSNR :  %f", psnr);
-    double const rmae = (capsaicin.getFrameIndex() > metricRMAE.getAsyncDelay())
-                          ? static_cast<double>(metricRMAE.getMetricValue())
-                          : 0.0;
+    double const rmae =
+        valid ? static_cast<double>(metrics.getMetricValue(GPUImageMetrics::Operation::RMAE)) : 0.0;
     ImGui::Text("PQ-RMAE :  %f", rmae);
-    double const smape = (capsaicin.getFrameIndex() > metricSMAPE.getAsyncDelay())
-                           ? static_cast<double>(metricSMAPE.getMetricValue())
-                           : 0.0;
+    double const smape =
+        valid ? static_cast<double>(metrics.getMetricValue(GPUImageMetrics::Operation::SMAPE)) : 0.0;
     ImGui::Text("PQ-SMAPE :  %f", smape);
-    double const ssim = (capsaicin.getFrameIndex() > metricSSIM.getAsyncDelay())
-                          ? static_cast<double>(metricSSIM.getMetricValue())
-                          : 0.0;
+    double const ssim =
+        valid ? static_cast<double>(metrics.getMetricValue(GPUImageMetrics::Operation::SSIM)) : 0.0;
     ImGui::Text("PQ-SSIM :  %f", ssim);
 }
 
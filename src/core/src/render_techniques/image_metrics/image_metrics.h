@@ -99,10 +99,7 @@ class ImageMetrics final : public RenderTechnique
     RenderOptions options;
     bool          needsInit = false;
 
-    GPUImageMetrics metricMSE;
-    GPUImageMetrics metricRMAE;
-    GPUImageMetrics metricSMAPE;
-    GPUImageMetrics metricSSIM;
+    GPUImageMetrics metrics; /**< Fused MSE, RMAE, SMAPE and SSIM metrics */
     GfxTexture      referenceImage;
 
     std::ofstream outputFile;
@@ -32,11 +32,27 @@ GPUImageMetrics::~GPUImageMetrics() noexcept
 }
 
 bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths,
-    Type const type, Operation operation) noexcept
+    Type const type, Operation const operation) noexcept
 {
+    return initialise(gfxIn, shaderPaths, type, std::vector {operation});
+}
+
+bool GPUImageMetrics::initialise(
+    CapsaicinInternal const &capsaicin, Type const type, Operation const operation) noexcept
+{
+    return initialise(capsaicin.getGfx(), capsaicin.getShaderPaths(), type, operation);
+}
+
+bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths,
+    Type const type, std::vector<Operation> const &operations) noexcept
+{
+    if (operations.empty())
+    {
+        return false;
+    }
     gfx = gfxIn;
 
-    if (type != currentType || operation != currentOperation)
+    if (type != currentType || operations != currentOperations)
     {
         // If configuration has changed then need to recompile kernels
         gfxDestroyProgram(gfx, metricsProgram);
@@ -44,6 +60,13 @@ bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::strin
         gfxDestroyKernel(gfx, metricsKernel);
         metricsKernel = {};
 
+        if ((operations.size() > 1) != isFused())
+        {
+            // Fused metrics use a different metric buffer type
+            gfxDestroyBuffer(gfx, metricBuffer);
+            metricBuffer = {};
+        }
+
         if (!metricBufferTemp.empty())
         {
             for (auto &i : metricBufferTemp)
@@ -52,11 +75,13 @@ bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::strin
             }
         }
     }
-    currentType      = type;
-    currentOperation = operation;
+    currentType       = type;
+    currentOperations = operations;
 
     static constexpr std::array<std::string_view, 6> typeName = {
         "MSE", "RMSE", "PSNR", "RMAE", "SMAPE", "SSIM"};
+    std::string_view const operationName =
+        isFused() ? "Fused" : typeName[static_cast<uint32_t>(currentOperations[0])];
 
     if (metricBufferTemp.empty())
     {
@@ -64,9 +89,10 @@ bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::strin
         metricBufferTemp.reserve(backBufferCount);
         for (uint32_t i = 0; i < backBufferCount; ++i)
         {
-            GfxBuffer   buffer = gfxCreateBuffer<float>(gfx, 1, nullptr, kGfxCpuAccess_Read);
+            // Sized to hold all components of the fused metrics
+            GfxBuffer   buffer = gfxCreateBuffer<float>(gfx, 4, nullptr, kGfxCpuAccess_Read);
             std::string name   = "GPUImageMetrics_";
-            name.append(typeName[static_cast<uint32_t>(operation)]);
+            name.append(operationName);
             name += "Buffer";
             name += std::to_string(i);
             buffer.setName(name.c_str());
@@ -84,9 +110,10 @@ bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::strin
 
     if (!metricBuffer)
     {
-        metricBuffer     = gfxCreateBuffer<float>(gfx, 8160 /*required @ 1080p*/);
+        metricBuffer = isFused() ? gfxCreateBuffer<float4>(gfx, 8160 /*required @ 1080p*/)
+                                 : gfxCreateBuffer<float>(gfx, 8160 /*required @ 1080p*/);
         std::string name = "GPUImageMetrics_Metrics";
-        name.append(typeName[static_cast<uint32_t>(operation)]);
+        name.append(operationName);
         name += "Buffer";
         metricBuffer.setName(name.c_str());
     }
@@ -116,44 +143,64 @@ bool GPUImageMetrics::initialise(GfxContext const &gfxIn, std::vector<std::strin
         {
             baseDefines.push_back("INPUT_LINEAR");
         }
-        if (currentOperation == Operation::PSNR)
+        if (isFused())
+        {
+            // Each accumulator component is only calculated once no matter how many operations use it
+            static constexpr std::array<char const *, 4> componentDefines = {
+                "CALCULATE_MSE", "CALCULATE_RMAE", "CALCULATE_SMAPE", "CALCULATE_SSIM"};
+            std::array<bool, 4> componentUsed = {};
+            for (auto const operation : currentOperations)
+            {
+                componentUsed[getFusedComponent(operation)] = true;
+            }
+            baseDefines.push_back("FUSED_METRICS");
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                if (componentUsed[i])
+                {
+                    baseDefines.push_back(componentDefines[i]);
+                }
+            }
+        }
+        else if (currentOperations[0] == Operation::PSNR)
         {
             baseDefines.push_back("CALCULATE_PSNR");
         }
-        else if (currentOperation == Operation::MSE)
+        else if (currentOperations[0] == Operation::MSE)
         {
             baseDefines.push_back("CALCULATE_MSE");
         }
-        else if (currentOperation == Operation::RMSE)
+        else if (currentOperations[0] == Operation::RMSE)
         {
             baseDefines.push_back("CALCULATE_RMSE");
         }
-        else if (currentOperation == Operation::RMAE)
+        else if (currentOperations[0] == Operation::RMAE)
         {
             baseDefines.push_back("CALCULATE_RMAE");
         }
-        else if (currentOperation == Operation::SMAPE)
+        else if (currentOperations[0] == Operation::SMAPE)
         {
             baseDefines.push_back("CALCULATE_SMAPE");
         }
-        else if (currentOperation == Operation::SSIM)
+        else if (currentOperations[0] == Operation::SSIM)
         {
             baseDefines.push_back("CALCULATE_SSIM");
         }
         metricsKernel = gfxCreateComputeKernel(gfx, metricsProgram, "ComputeMetric", baseDefines.data(),
             static_cast<uint32_t>(baseDefines.size()));
     }
-    if (!reducer.initialise(gfx, shaderPaths, GPUReduce::Type::Float, GPUReduce::Operation::Sum))
+    if (!reducer.initialise(gfx, shaderPaths, isFused() ? GPUReduce::Type::Float4 : GPUReduce::Type::Float,
+            GPUReduce::Operation::Sum))
     {
         return false;
     }
     return !!metricsKernel;
 }
 
-bool GPUImageMetrics::initialise(
-    CapsaicinInternal const &capsaicin, Type const type, Operation const operation) noexcept
+bool GPUImageMetrics::initialise(CapsaicinInternal const &capsaicin, Type const type,
+    std::vector<Operation> const &operations) noexcept
 {
-    return initialise(capsaicin.getGfx(), capsaicin.getShaderPaths(), type, operation);
+    return initialise(capsaicin.getGfx(), capsaicin.getShaderPaths(), type, operations);
 }
 
 bool GPUImageMetrics::compare(GfxTexture const &sourceImage, GfxTexture const &referenceImage) noexcept
@@ -163,11 +210,11 @@ bool GPUImageMetrics::compare(GfxTexture const &sourceImage, GfxTexture const &r
         return false;
     }
 
-    gfxCommandCopyBuffer(gfx, metricBufferTemp[0].second, 0, metricBuffer, 0, sizeof(float));
+    gfxCommandCopyBuffer(gfx, metricBufferTemp[0].second, 0, metricBuffer, 0, metricBuffer.getStride());
     // Force the operation to complete and then read back to CPU
     gfxFinish(gfx);
-    auto const newValue = *gfxBufferGetData<float>(gfx, metricBufferTemp[0].second);
-    currentValue        = convertMetric(newValue, referenceImage.getWidth() * referenceImage.getHeight());
+    updateMetricValues(gfxBufferGetData<float>(gfx, metricBufferTemp[0].second),
+        referenceImage.getWidth() * referenceImage.getHeight());
     return true;
 }
 
@@ -182,19 +229,25 @@ bool GPUImageMetrics::compareAsync(GfxTexture const &sourceImage, GfxTexture con
     uint32_t const bufferIndex = gfxGetBackBufferIndex(gfx);
     if (metricBufferTemp[bufferIndex].first != 0.0F)
     {
-        auto const newValue = *gfxBufferGetData<float>(gfx, metricBufferTemp[bufferIndex].second);
-        currentValue        = convertMetric(newValue, referenceImage.getWidth() * referenceImage.getHeight());
+        updateMetricValues(gfxBufferGetData<float>(gfx, metricBufferTemp[bufferIndex].second),
+            referenceImage.getWidth() * referenceImage.getHeight());
     }
 
     // Begin copy of new value (will take 'bufferIndex' number of frames to become valid)
-    gfxCommandCopyBuffer(gfx, metricBufferTemp[bufferIndex].second, 0, metricBuffer, 0, sizeof(float));
-    metricBufferTemp[bufferIndex].first = currentValue;
+    gfxCommandCopyBuffer(
+        gfx, metricBufferTemp[bufferIndex].second, 0, metricBuffer, 0, metricBuffer.getStride());
+    metricBufferTemp[bufferIndex].first = 1.0F;
     return true;
 }
 
 float GPUImageMetrics::getMetricValue() const noexcept
 {
-    return currentValue;
+    return currentValues[static_cast<uint32_t>(currentOperations[0])];
+}
+
+float GPUImageMetrics::getMetricValue(Operation const operation) const noexcept
+{
+    return currentValues[static_cast<uint32_t>(operation)];
 }
 
 uint32_t GPUImageMetrics::getAsyncDelay() const noexcept
@@ -238,7 +291,8 @@ bool GPUImageMetrics::compareInternal(
     {
         std::string const bufferName = metricBuffer.getName();
         gfxDestroyBuffer(gfx, metricBuffer);
-        metricBuffer = gfxCreateBuffer<float>(gfx, numOutputValues);
+        metricBuffer = isFused() ? gfxCreateBuffer<float4>(gfx, numOutputValues)
+                                 : gfxCreateBuffer<float>(gfx, numOutputValues);
         metricBuffer.setName(bufferName.c_str());
     }
 
@@ -267,11 +321,40 @@ bool GPUImageMetrics::compareInternal(
     return true;
 }
 
-float GPUImageMetrics::convertMetric(float const value, uint32_t const totalSamples) const noexcept
+bool GPUImageMetrics::isFused() const noexcept
+{
+    return currentOperations.size() > 1;
+}
+
+uint32_t GPUImageMetrics::getFusedComponent(Operation const operation) noexcept
+{
+    switch (operation)
+    {
+    case Operation::RMAE: return 1;
+    case Operation::SMAPE: return 2;
+    case Operation::SSIM: return 3;
+    case Operation::MSE:
+    case Operation::RMSE:
+    case Operation::PSNR:
+    default: return 0;
+    }
+}
+
+void GPUImageMetrics::updateMetricValues(float const *values, uint32_t const totalSamples) noexcept
+{
+    for (auto const operation : currentOperations)
+    {
+        float const value = isFused() ? values[getFusedComponent(operation)] : values[0];
+        currentValues[static_cast<uint32_t>(operation)] = convertMetric(value, totalSamples, operation);
+    }
+}
+
+float GPUImageMetrics::convertMetric(
+    float const value, uint32_t const totalSamples, Operation const operation) const noexcept
 {
     auto const totalPixels = static_cast<double>(totalSamples);
     double     ret         = static_cast<double>(value) / totalPixels;
-    switch (currentOperation)
+    switch (operation)
     {
     case Operation::MSE:
         // MSE = [1/(width*height)]Sum([Ref.x.y - Src.x.y]^2)
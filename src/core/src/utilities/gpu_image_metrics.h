@@ -24,6 +24,8 @@ THE SOFTWARE.
 #include "gpu_reduce.h"
 #include "gpu_shared.h"
 
+#include <array>
+
 namespace Capsaicin
 {
 class CapsaicinInternal;
@@ -77,6 +79,29 @@ class GPUImageMetrics
      */
     bool initialise(CapsaicinInternal const &capsaicin, Type type, Operation operation) noexcept;
 
+    /**
+     * Initialise the internal data to calculate multiple metrics at once.
+     * @note When more than one operation is requested all metrics are calculated in a single fused pass
+     * that reads each image once and performs a single reduction and read back for all of them.
+     * @param gfxIn       Active gfx context.
+     * @param shaderPaths Paths to shader files based on current working directory.
+     * @param type        The object type to reduce.
+     * @param operations  The list of operations to perform.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths, Type type,
+        std::vector<Operation> const &operations) noexcept;
+
+    /**
+     * Initialise the internal data to calculate multiple metrics at once.
+     * @param capsaicin  Current framework context.
+     * @param type       The type of data in the images.
+     * @param operations The list of operations to perform.
+     * @return True, if any initialisation/changes succeeded.
+     */
+    bool initialise(
+        CapsaicinInternal const &capsaicin, Type type, std::vector<Operation> const &operations) noexcept;
+
     /**
      * Generate comparison metrics for 2 different images.
      * @note This will flush the current GPU pipeline so only call this function is no other work is to be
@@ -104,6 +129,14 @@ class GPUImageMetrics
      */
     [[nodiscard]] float getMetricValue() const noexcept;
 
+    /**
+     * Read back the value of the most recent calculated metric for a specific operation.
+     * @note The operation must be one of those passed to 'initialise'.
+     * @param operation The operation to get the value of.
+     * @return The calculated metric value, Zero if no value is available.
+     */
+    [[nodiscard]] float getMetricValue(Operation operation) const noexcept;
+
     /**
      * Get the number of frames of delay there is when using 'compareAsync'.
      * @return The number of frames worth of delay.
@@ -116,17 +149,38 @@ class GPUImageMetrics
 
     bool compareInternal(GfxTexture const &sourceImage, GfxTexture const &referenceImage) noexcept;
 
-    [[nodiscard]] float convertMetric(float value, uint32_t totalSamples) const noexcept;
+    /**
+     * Check if multiple metrics are calculated in a single fused pass.
+     * @return True if fused, False otherwise.
+     */
+    [[nodiscard]] bool isFused() const noexcept;
+
+    /**
+     * Get the component of the fused metric accumulator that holds the data for an operation.
+     * @param operation The operation to get the component of.
+     * @return The component index.
+     */
+    [[nodiscard]] static uint32_t getFusedComponent(Operation operation) noexcept;
+
+    /**
+     * Update the current metric values from read back data.
+     * @param values       The read back metric values (one per accumulator component).
+     * @param totalSamples The number of samples used to generate the values.
+     */
+    void updateMetricValues(float const *values, uint32_t totalSamples) noexcept;
+
+    [[nodiscard]] float convertMetric(float value, uint32_t totalSamples, Operation operation) const noexcept;
 
     GfxContext gfx;
 
-    Type      currentType      = Type::HDR_RGB;
-    Operation currentOperation = Operation::RMSE;
+    Type                   currentType       = Type::HDR_RGB;
+    std::vector<Operation> currentOperations = {Operation::RMSE};
 
     GfxBuffer metricBuffer; /**< Buffer used to hold calculated metric */
     std::vector<std::pair<float, GfxBuffer>>
-          metricBufferTemp;    /**< Buffer used to copy back calculated metric into CPU memory */
-    float currentValue = 1.0F; /**< Most recent calculated metric value */
+        metricBufferTemp; /**< Buffer used to copy back calculated metric into CPU memory */
+    std::array<float, 6> currentValues = {
+        1.0F, 1.0F, 1.0F, 1.0F, 1.0F, 1.0F}; /**< Most recent calculated metric values for each operation */
 
     GfxProgram metricsProgram;
     GfxKernel  metricsKernel;
@@ -22,8 +22,8 @@ THE SOFTWARE.
 
 #include "gpu_sort.h"
 
-#include "buffer_view.h"
 #include "capsaicin_internal.h"
+#include "gpu_sort_simulator.h"
 
 #define FFX_CPU
 #ifdef __clang__
@@ -42,25 +42,40 @@ THE SOFTWARE.
 
 namespace Capsaicin
 {
+static_assert(sizeof(GPUSortConstants) == sizeof(FfxParallelSortConstants));
+static_assert(GPUSORT_BLOCK_SIZE == FFX_PARALLELSORT_ELEMENTS_PER_THREAD * FFX_PARALLELSORT_THREADGROUP_SIZE);
+static_assert(GPUSORT_BITS_PER_PASS == FFX_PARALLELSORT_SORT_BITS_PER_PASS);
+
 GPUSort::~GPUSort() noexcept
 {
     terminate();
 }
 
-bool GPUSort::initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths,
+bool GPUSort::initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPathsIn,
     Type const type, Operation const operation) noexcept
 {
-    gfx = gfxIn;
+    gfx         = gfxIn;
+    shaderPaths = shaderPathsIn;
 
     if (!parallelSortCBBuffer)
     {
         // Currently we just allocate enough for a max number of 16 segments
-        parallelSortCBBuffer = gfxCreateBuffer<FfxParallelSortConstants>(gfx, 1 * 16);
+        parallelSortCBBuffer = gfxCreateBuffer<GPUSortConstants>(gfx, 1 * 16);
         parallelSortCBBuffer.setName("ParallelSortCBBuffer");
         countScatterArgsBuffer = gfxCreateBuffer<uint>(gfx, 3 * 16);
         countScatterArgsBuffer.setName("CountScatterArgsBuffer");
         reduceScanArgsBuffer = gfxCreateBuffer<uint>(gfx, 3 * 16);
         reduceScanArgsBuffer.setName("ReduceScanArgsBuffer");
+        segmentBuffer = gfxCreateBuffer<GPUSortSegment>(gfx, 16);
+        segmentBuffer.setName("SegmentBuffer");
+        keyRangeBuffer = gfxCreateBuffer<uint>(gfx, 2);
+        keyRangeBuffer.setName("KeyRangeBuffer");
+        passArgsBuffer = gfxCreateBuffer<uint>(gfx, GPUSORT_MAX_PASSES * GPUSORT_PASS_ARGS_SIZE);
+        passArgsBuffer.setName("PassArgsBuffer");
+        for (uint i = 0; i < GPUSORT_MAX_PASSES * 3; ++i)
+        {
+            passArgs[i] = gfxCreateBufferRange<uint>(gfx, passArgsBuffer, i * 3, 3);
+        }
     }
 
     if (type != currentType || operation != currentOperation)
@@ -82,6 +97,22 @@ bool GPUSort::initialise(GfxContext const &gfxIn, std::vector<std::string> const
         scatter = {};
         gfxDestroyKernel(gfx, scatterPayload);
         scatterPayload = {};
+        gfxDestroyKernel(gfx, setupIndirectSegmented);
+        setupIndirectSegmented = {};
+        gfxDestroyKernel(gfx, countSegmented);
+        countSegmented = {};
+        gfxDestroyKernel(gfx, countReduceSegmented);
+        countReduceSegmented = {};
+        gfxDestroyKernel(gfx, scanSegmented);
+        scanSegmented = {};
+        gfxDestroyKernel(gfx, scanAddSegmented);
+        scanAddSegmented = {};
+        gfxDestroyKernel(gfx, scatterSegmented);
+        scatterSegmented = {};
+        gfxDestroyKernel(gfx, scatterPayloadSegmented);
+        scatterPayloadSegmented = {};
+        gfxDestroyKernel(gfx, setupPasses);
+        setupPasses = {};
     }
     currentType      = type;
     currentOperation = operation;
@@ -95,6 +126,14 @@ bool GPUSort::initialise(GfxContext const &gfxIn, std::vector<std::string> const
         gfxDestroyKernel(gfx, scanAdd);
         gfxDestroyKernel(gfx, scatter);
         gfxDestroyKernel(gfx, scatterPayload);
+        gfxDestroyKernel(gfx, setupIndirectSegmented);
+        gfxDestroyKernel(gfx, countSegmented);
+        gfxDestroyKernel(gfx, countReduceSegmented);
+        gfxDestroyKernel(gfx, scanSegmented);
+        gfxDestroyKernel(gfx, scanAddSegmented);
+        gfxDestroyKernel(gfx, scatterSegmented);
+        gfxDestroyKernel(gfx, scatterPayloadSegmented);
+        gfxDestroyKernel(gfx, setupPasses);
 
         std::vector<char const *> includePaths;
         includePaths.reserve(shaderPaths.size());
@@ -109,6 +148,10 @@ bool GPUSort::initialise(GfxContext const &gfxIn, std::vector<std::string> const
         {
         case Type::Float: baseDefines.push_back("TYPE=float"); break;
         case Type::UInt: baseDefines.push_back("TYPE=uint"); break;
+        case Type::UInt64:
+            baseDefines.push_back("TYPE=uint2");
+            baseDefines.push_back("KEY64");
+            break;
         default: break;
         }
         switch (currentOperation)
@@ -131,9 +174,25 @@ bool GPUSort::initialise(GfxContext const &gfxIn, std::vector<std::string> const
             gfx, sortProgram, "scatter", baseDefines.data(), static_cast<uint32_t>(baseDefines.size()));
         scatterPayload = gfxCreateComputeKernel(gfx, sortProgram, "scatterPayload", baseDefines.data(),
             static_cast<uint32_t>(baseDefines.size()));
+        setupIndirectSegmented = gfxCreateComputeKernel(gfx, sortProgram, "setupIndirectSegmented",
+            baseDefines.data(), static_cast<uint32_t>(baseDefines.size()));
+        countSegmented = gfxCreateComputeKernel(gfx, sortProgram, "countSegmented", baseDefines.data(),
+            static_cast<uint32_t>(baseDefines.size()));
+        countReduceSegmented = gfxCreateComputeKernel(gfx, sortProgram, "countReduceSegmented",
+            baseDefines.data(), static_cast<uint32_t>(baseDefines.size()));
+        scanSegmented = gfxCreateComputeKernel(gfx, sortProgram, "scanSegmented", baseDefines.data(),
+            static_cast<uint32_t>(baseDefines.size()));
+        scanAddSegmented = gfxCreateComputeKernel(gfx, sortProgram, "scanAddSegmented", baseDefines.data(),
+            static_cast<uint32_t>(baseDefines.size()));
+        scatterSegmented = gfxCreateComputeKernel(gfx, sortProgram, "scatterSegmented", baseDefines.data(),
+            static_cast<uint32_t>(baseDefines.size()));
+        scatterPayloadSegmented = gfxCreateComputeKernel(gfx, sortProgram, "scatterPayloadSegmented",
+            baseDefines.data(), static_cast<uint32_t>(baseDefines.size()));
+        setupPasses = gfxCreateComputeKernel(
+            gfx, sortProgram, "setupPasses", baseDefines.data(), static_cast<uint32_t>(baseDefines.size()));
     }
 
-    return !!scatterPayload;
+    return !!setupPasses;
 }
 
 bool GPUSort::initialise(
@@ -150,6 +209,17 @@ void GPUSort::terminate() noexcept
     countScatterArgsBuffer = {};
     gfxDestroyBuffer(gfx, reduceScanArgsBuffer);
     reduceScanArgsBuffer = {};
+    gfxDestroyBuffer(gfx, segmentBuffer);
+    segmentBuffer = {};
+    gfxDestroyBuffer(gfx, keyRangeBuffer);
+    keyRangeBuffer = {};
+    for (auto &args : passArgs)
+    {
+        gfxDestroyBuffer(gfx, args);
+        args = {};
+    }
+    gfxDestroyBuffer(gfx, passArgsBuffer);
+    passArgsBuffer = {};
 
     gfxDestroyBuffer(gfx, scratchBuffer);
     scratchBuffer = {};
@@ -177,6 +247,22 @@ void GPUSort::terminate() noexcept
     scatter = {};
     gfxDestroyKernel(gfx, scatterPayload);
     scatterPayload = {};
+    gfxDestroyKernel(gfx, setupIndirectSegmented);
+    setupIndirectSegmented = {};
+    gfxDestroyKernel(gfx, countSegmented);
+    countSegmented = {};
+    gfxDestroyKernel(gfx, countReduceSegmented);
+    countReduceSegmented = {};
+    gfxDestroyKernel(gfx, scanSegmented);
+    scanSegmented = {};
+    gfxDestroyKernel(gfx, scanAddSegmented);
+    scanAddSegmented = {};
+    gfxDestroyKernel(gfx, scatterSegmented);
+    scatterSegmented = {};
+    gfxDestroyKernel(gfx, scatterPayloadSegmented);
+    scatterPayloadSegmented = {};
+    gfxDestroyKernel(gfx, setupPasses);
+    setupPasses = {};
 }
 
 void GPUSort::sortIndirect(
@@ -225,11 +311,30 @@ void GPUSort::sortPayloadSegmented(
     sortInternalSegmented(sourceBuffer, numKeys, 0, UINT_MAX, nullptr, &sourcePayload);
 }
 
+void GPUSort::sortIndirectSegmentedOffsets(GfxBuffer const &sourceBuffer, uint const numSegments,
+    GfxBuffer const &segmentOffsets, uint const maxNumKeys) noexcept
+{
+    sortInternalSegmented(sourceBuffer, {}, maxNumKeys, numSegments, &segmentOffsets, nullptr, true);
+}
+
+void GPUSort::sortIndirectPayloadSegmentedOffsets(GfxBuffer const &sourceBuffer, uint const numSegments,
+    GfxBuffer const &segmentOffsets, uint const maxNumKeys, GfxBuffer const &sourcePayload) noexcept
+{
+    sortInternalSegmented(sourceBuffer, {}, maxNumKeys, numSegments, &segmentOffsets, &sourcePayload, true);
+}
+
+void GPUSort::setKeyBits(uint const keyBitsIn) noexcept
+{
+    keyBits = keyBitsIn;
+}
+
 void GPUSort::sortInternal(GfxBuffer const &sourceBuffer, uint const maxNumKeys, GfxBuffer const *numKeys,
     GfxBuffer const *sourcePayload) noexcept
 {
-    // Check if we have payload to also sort
-    bool const hasPayload = sourcePayload != nullptr;
+    // Check if we have payload to also sort (not supported with 64bit keys)
+    bool const hasPayload = sourcePayload != nullptr && currentType != Type::UInt64;
+    // 64bit keys always use the payload kernels to move the key word not being sorted
+    bool const useScatterPayload = hasPayload || currentType == Type::UInt64;
 
     // Check if indirect
     bool const indirect = (numKeys != nullptr);
@@ -274,57 +379,45 @@ void GPUSort::sortInternal(GfxBuffer const &sourceBuffer, uint const maxNumKeys,
     }
 
     // Setup ping-pong buffers
-    if (!sourcePongBuffer || ((sourcePongBuffer.getSize() / sizeof(uint)) < maxNumKeys))
-    {
-        gfxDestroyBuffer(gfx, sourcePongBuffer);
-        sourcePongBuffer = gfxCreateBuffer<uint>(gfx, maxNumKeys);
-        sourcePongBuffer.setName("SourcePongBuffer");
-    }
-    if (hasPayload && (!payloadPongBuffer || ((payloadPongBuffer.getSize() / sizeof(uint)) < maxNumKeys)))
-    {
-        gfxDestroyBuffer(gfx, payloadPongBuffer);
-        payloadPongBuffer = gfxCreateBuffer<uint>(gfx, maxNumKeys);
-        payloadPongBuffer.setName("PayloadPongBuffer");
-    }
+    createPongBuffers(maxNumKeys, hasPayload);
     GfxBuffer const *readBuffer(&sourceBuffer);
     GfxBuffer const *writeBuffer(&sourcePongBuffer);
     GfxBuffer const *readPayloadBuffer(sourcePayload);
     GfxBuffer const *writePayloadBuffer(&payloadPongBuffer);
+    uint const       passCount =
+        preparePasses(numThreadGroupsToRun, numReducedThreadGroupsToRun, 1, indirect);
+    if ((passCount & 1) != 0)
+    {
+        // Sort from a copy so that the final pass writes back into the source buffers
+        copyToPong(sourceBuffer, hasPayload ? sourcePayload : nullptr, maxNumKeys);
+        std::swap(readBuffer, writeBuffer);
+        std::swap(readPayloadBuffer, writePayloadBuffer);
+    }
 
-    // Perform Radix Sort (currently only support 32-bit key/payload sorting
-    for (uint32_t shift = 0; shift < 32U; shift += FFX_PARALLELSORT_SORT_BITS_PER_PASS)
+    // Perform Radix Sort (32-bit key words with optional 32-bit payload)
+    GfxBuffer const *countScatterArgs = indirect ? &countScatterArgsBuffer : nullptr;
+    GfxBuffer const *reduceScanArgs   = indirect ? &reduceScanArgsBuffer : nullptr;
+    for (uint pass = 0; pass < passCount; ++pass)
     {
+        uint const shift = pass * FFX_PARALLELSORT_SORT_BITS_PER_PASS;
+
         // Sort Count
         {
             gfxProgramSetParameter(gfx, sortProgram, "CShiftBit", shift);
             gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBuffer);
             gfxProgramSetParameter(gfx, sortProgram, "SrcBuffer", *readBuffer);
             gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBuffer);
+            gfxProgramSetParameter(gfx, sortProgram, "TrackKeyRange", derivePasses && pass == 0 ? 1U : 0U);
 
-            gfxCommandBindKernel(gfx, count);
-            if (indirect)
-            {
-                gfxCommandDispatchIndirect(gfx, countScatterArgsBuffer);
-            }
-            else
-            {
-                gfxCommandDispatch(gfx, numThreadGroupsToRun, 1, 1);
-            }
+            dispatchPass(count, pass, 0, countScatterArgs, numThreadGroupsToRun);
+            setupDerivedPasses(pass);
         }
 
         // Sort Reduce
         {
             gfxProgramSetParameter(gfx, sortProgram, "ReduceTable", reducedScratchBuffer);
 
-            gfxCommandBindKernel(gfx, countReduce);
-            if (indirect)
-            {
-                gfxCommandDispatchIndirect(gfx, reduceScanArgsBuffer);
-            }
-            else
-            {
-                gfxCommandDispatch(gfx, numReducedThreadGroupsToRun, 1, 1);
-            }
+            dispatchPass(countReduce, pass, 1, reduceScanArgs, numReducedThreadGroupsToRun);
         }
 
         // Sort Scan
@@ -332,22 +425,13 @@ void GPUSort::sortInternal(GfxBuffer const &sourceBuffer, uint const maxNumKeys,
             // First do scan prefix of reduced values
             gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", reducedScratchBuffer);
             gfxProgramSetParameter(gfx, sortProgram, "ScanDst", reducedScratchBuffer);
-            gfxCommandBindKernel(gfx, scan);
-            gfxCommandDispatch(gfx, 1, 1, 1);
+            dispatchPass(scan, pass, 2, nullptr, 1);
 
             // Next do scan prefix on the histogram with partial sums that we just did
             gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", scratchBuffer);
             gfxProgramSetParameter(gfx, sortProgram, "ScanDst", scratchBuffer);
             gfxProgramSetParameter(gfx, sortProgram, "ScanScratch", reducedScratchBuffer);
-            gfxCommandBindKernel(gfx, scanAdd);
-            if (indirect)
-            {
-                gfxCommandDispatchIndirect(gfx, reduceScanArgsBuffer);
-            }
-            else
-            {
-                gfxCommandDispatch(gfx, numReducedThreadGroupsToRun, 1, 1);
-            }
+            dispatchPass(scanAdd, pass, 1, reduceScanArgs, numReducedThreadGroupsToRun);
         }
 
         // Sort Scatter
@@ -357,20 +441,9 @@ void GPUSort::sortInternal(GfxBuffer const &sourceBuffer, uint const maxNumKeys,
             {
                 gfxProgramSetParameter(gfx, sortProgram, "SrcPayload", *readPayloadBuffer);
                 gfxProgramSetParameter(gfx, sortProgram, "DstPayload", *writePayloadBuffer);
-                gfxCommandBindKernel(gfx, scatterPayload);
-            }
-            else
-            {
-                gfxCommandBindKernel(gfx, scatter);
-            }
-            if (indirect)
-            {
-                gfxCommandDispatchIndirect(gfx, countScatterArgsBuffer);
-            }
-            else
-            {
-                gfxCommandDispatch(gfx, numThreadGroupsToRun, 1, 1);
             }
+            dispatchPass(useScatterPayload ? scatterPayload : scatter, pass, 0, countScatterArgs,
+                numThreadGroupsToRun);
         }
 
         // Swap read/write sources
@@ -380,275 +453,168 @@ void GPUSort::sortInternal(GfxBuffer const &sourceBuffer, uint const maxNumKeys,
 }
 
 void GPUSort::sortInternalSegmented(GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeysList,
-    uint const maxNumKeys, uint numSegments, GfxBuffer const *numKeys,
-    GfxBuffer const *sourcePayload) noexcept
+    uint const maxNumKeys, uint numSegments, GfxBuffer const *numKeys, GfxBuffer const *sourcePayload,
+    bool const keyOffsets) noexcept
 {
-    // Check if we have payload to also sort
-    bool const hasPayload = sourcePayload != nullptr;
+    // Check if we have payload to also sort (not supported with 64bit keys)
+    bool const hasPayload = sourcePayload != nullptr && currentType != Type::UInt64;
+    // 64bit keys always use the payload kernels to move the key word not being sorted
+    bool const useScatterPayload = hasPayload || currentType == Type::UInt64;
 
     // Check if indirect
     bool const isIndirect = (numKeys != nullptr);
 
     numSegments = isIndirect ? numSegments : static_cast<uint>(numKeysList.size());
+    if (numSegments == 0)
+    {
+        return;
+    }
 
-    std::vector<BufferView<FfxParallelSortConstants>> parallelSortCBBufferViews;
-    parallelSortCBBufferViews.reserve(numSegments);
-    std::vector<BufferView<uint>> countScatterArgsBufferViews;
-    std::vector<BufferView<uint>> reduceScanArgsBufferViews;
-    std::vector<uint>             numThreadGroupsToRun;
-    std::vector<uint>             numReducedThreadGroupsToRun;
+    // All segments are sorted together, each thread group finds its segment using the per segment offsets
+    // into the shared key, sum and reduce tables
+    uint numThreadGroupsToRun        = 0;
+    uint numReducedThreadGroupsToRun = 0;
+    uint totalKeys                   = 0;
     if (isIndirect)
     {
         // Check if the buffers are big enough for all the requested segments
-        if (countScatterArgsBuffer.getCount() < 4 * numSegments)
-        {
-            gfxDestroyBuffer(gfx, countScatterArgsBuffer);
-            countScatterArgsBuffer = gfxCreateBuffer<uint>(gfx, 4 * numSegments); // Uses 4 for alignment
-            countScatterArgsBuffer.setName("CountScatterArgsBuffer");
-            gfxDestroyBuffer(gfx, reduceScanArgsBuffer);
-            reduceScanArgsBuffer = gfxCreateBuffer<uint>(gfx, 4 * numSegments);
-            reduceScanArgsBuffer.setName("ReduceScanArgsBuffer");
-        }
         if (parallelSortCBBuffer.getCount() < numSegments)
         {
             gfxDestroyBuffer(gfx, parallelSortCBBuffer);
-            parallelSortCBBuffer = gfxCreateBuffer<FfxParallelSortConstants>(gfx, numSegments);
+            parallelSortCBBuffer = gfxCreateBuffer<GPUSortConstants>(gfx, numSegments);
             parallelSortCBBuffer.setName("ParallelSortCBBuffer");
         }
-        // Create the individual views into the buffers
-        countScatterArgsBufferViews.reserve(numSegments);
-        reduceScanArgsBufferViews.reserve(numSegments);
-        std::vector<BufferView<uint>> numKeysViews;
-        numKeysViews.reserve(numSegments);
-        for (uint i = 0; i < numSegments; ++i)
+        if (segmentBuffer.getCount() < numSegments)
         {
-            parallelSortCBBufferViews.emplace_back(gfx, parallelSortCBBuffer, i, 1);
-            countScatterArgsBufferViews.emplace_back(gfx, countScatterArgsBuffer, i * 4, 3);
-            reduceScanArgsBufferViews.emplace_back(gfx, reduceScanArgsBuffer, i * 4, 3);
-            numKeysViews.emplace_back(gfx, *numKeys, i, 1);
+            gfxDestroyBuffer(gfx, segmentBuffer);
+            segmentBuffer = gfxCreateBuffer<GPUSortSegment>(gfx, numSegments);
+            segmentBuffer.setName("SegmentBuffer");
         }
 
-        // Run the indirect sort setup kernel
-        gfxCommandBindKernel(gfx, setupIndirect);
-        for (uint i = 0; i < numSegments; ++i)
-        {
-            gfxProgramSetParameter(gfx, sortProgram, "CBufferUAV", parallelSortCBBufferViews[i].buffer);
-            gfxProgramSetParameter(
-                gfx, sortProgram, "CountScatterArgs", countScatterArgsBufferViews[i].buffer);
-            gfxProgramSetParameter(gfx, sortProgram, "ReduceScanArgs", reduceScanArgsBufferViews[i].buffer);
-            gfxProgramSetParameter(gfx, sortProgram, "numKeys", numKeysViews[i].buffer);
+        // Run the indirect sort setup kernel, this calculates the parameters of all segments at once
+        gfxProgramSetParameter(gfx, sortProgram, "CBufferUAV", parallelSortCBBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "SegmentsUAV", segmentBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "CountScatterArgs", countScatterArgsBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "ReduceScanArgs", reduceScanArgsBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "numKeys", *numKeys);
+        gfxProgramSetParameter(gfx, sortProgram, "NumSegments", numSegments);
+        gfxProgramSetParameter(gfx, sortProgram, "SegmentKeyStride", keyOffsets ? 0U : maxNumKeys);
 
-            gfxCommandDispatch(gfx, 1, 1, 1);
-        }
+        gfxCommandBindKernel(gfx, setupIndirectSegmented);
+        gfxCommandDispatch(gfx, 1, 1, 1);
+        totalKeys = keyOffsets ? maxNumKeys : maxNumKeys * numSegments;
     }
     else
     {
-        std::vector<FfxParallelSortConstants> constantBufferData;
-        constantBufferData.resize(numSegments);
-        numThreadGroupsToRun.resize(numSegments);
-        numReducedThreadGroupsToRun.resize(numSegments);
-        for (uint i = 0; i < numSegments; ++i)
+        std::vector<uint> keyOffsetList;
+        keyOffsetList.reserve(numSegments);
+        for (uint i = 0, offset = 0; i < numSegments; ++i)
         {
-            memset(&constantBufferData[i], 0, sizeof(FfxParallelSortConstants));
-            ffxParallelSortSetConstantAndDispatchData(numKeysList[i], 800, constantBufferData[i],
-                numThreadGroupsToRun[i], numReducedThreadGroupsToRun[i]);
+            keyOffsetList.push_back(offset);
+            offset += numKeysList[i];
         }
-        gfxDestroyBuffer(gfx, parallelSortCBBuffer);
-        parallelSortCBBuffer =
-            gfxCreateBuffer<FfxParallelSortConstants>(gfx, numSegments, constantBufferData.data());
-        parallelSortCBBuffer.setName("ParallelSortCBBuffer");
-        for (uint i = 0; i < numSegments; ++i)
+        auto const dispatch = GPUSortSimulator::MakeDispatch(keyOffsetList, numKeysList);
+        if (dispatch.numThreadGroups == 0)
         {
-            parallelSortCBBufferViews.emplace_back(gfx, parallelSortCBBuffer, i, 1);
+            return; // Nothing to sort
         }
+        gfxDestroyBuffer(gfx, parallelSortCBBuffer);
+        parallelSortCBBuffer = gfxCreateBuffer<GPUSortConstants>(gfx, numSegments, dispatch.constants.data());
+        parallelSortCBBuffer.setName("ParallelSortCBBuffer");
+        gfxDestroyBuffer(gfx, segmentBuffer);
+        segmentBuffer = gfxCreateBuffer<GPUSortSegment>(gfx, numSegments, dispatch.segments.data());
+        segmentBuffer.setName("SegmentBuffer");
+        numThreadGroupsToRun        = dispatch.numThreadGroups;
+        numReducedThreadGroupsToRun = dispatch.numReduceThreadGroups;
+        totalKeys                   = dispatch.numKeys;
     }
 
     // Make scratch buffers
-    std::vector<uint> scratchBufferCount;
-    std::vector<uint> reducedScratchBufferCount;
-    uint              totalScratchBufferCount        = 0;
-    uint              totalReducedScratchBufferCount = 0;
-    uint              totalKeys                      = 0;
-    // Size each buffer based on maxNumKeys or exact segment size of known
-    scratchBufferCount.resize(numSegments);
-    reducedScratchBufferCount.resize(numSegments);
-    for (uint i = 0; i < numSegments; ++i)
-    {
-        uint const bufferSize = isIndirect ? maxNumKeys : numKeysList[i];
-        ffxParallelSortCalculateScratchResourceSize(
-            bufferSize, scratchBufferCount[i], reducedScratchBufferCount[i]);
-        scratchBufferCount[i] /= sizeof(uint); // Convert from size to count
-        reducedScratchBufferCount[i] /= sizeof(uint);
-        totalScratchBufferCount += scratchBufferCount[i];
-        totalReducedScratchBufferCount += reducedScratchBufferCount[i];
-        totalKeys += bufferSize;
-    }
-    if (!scratchBuffer || (scratchBuffer.getCount() < totalScratchBufferCount))
+    uint scratchBufferCount        = 0;
+    uint reducedScratchBufferCount = 0;
+    GPUSortSimulator::GetScratchSize(numSegments, totalKeys, scratchBufferCount, reducedScratchBufferCount);
+    if (!scratchBuffer || (scratchBuffer.getCount() < scratchBufferCount))
     {
         gfxDestroyBuffer(gfx, scratchBuffer);
-        scratchBuffer = gfxCreateBuffer<uint>(gfx, totalScratchBufferCount);
+        scratchBuffer = gfxCreateBuffer<uint>(gfx, scratchBufferCount);
         scratchBuffer.setName("ScratchBuffer");
     }
-    if (!reducedScratchBuffer || (reducedScratchBuffer.getCount() < totalReducedScratchBufferCount))
+    if (!reducedScratchBuffer || (reducedScratchBuffer.getCount() < reducedScratchBufferCount))
     {
         gfxDestroyBuffer(gfx, reducedScratchBuffer);
-        reducedScratchBuffer = gfxCreateBuffer<uint>(gfx, totalReducedScratchBufferCount);
+        reducedScratchBuffer = gfxCreateBuffer<uint>(gfx, reducedScratchBufferCount);
         reducedScratchBuffer.setName("ReducedScratchBuffer");
     }
 
     // Setup ping-pong buffers
-    if (!sourcePongBuffer || (sourcePongBuffer.getCount() < totalKeys))
-    {
-        gfxDestroyBuffer(gfx, sourcePongBuffer);
-        sourcePongBuffer = gfxCreateBuffer<uint>(gfx, totalKeys);
-        sourcePongBuffer.setName("SourcePongBuffer");
-    }
-    if (hasPayload && (!payloadPongBuffer || (payloadPongBuffer.getCount() < totalKeys)))
-    {
-        gfxDestroyBuffer(gfx, payloadPongBuffer);
-        payloadPongBuffer = gfxCreateBuffer<uint>(gfx, totalKeys);
-        payloadPongBuffer.setName("PayloadPongBuffer");
-    }
-    std::vector<BufferView<uint>> sourceBufferViews;
-    std::vector<BufferView<uint>> sourcePongBufferViews;
-    std::vector<BufferView<uint>> scratchBufferViews;
-    std::vector<BufferView<uint>> reducedScratchBufferViews;
-    std::vector<BufferView<uint>> sourcePayloadViews;
-    std::vector<BufferView<uint>> payloadPongBufferViews;
-    // Set buffer views
-    sourceBufferViews.reserve(numSegments);
-    sourcePongBufferViews.reserve(numSegments);
-    scratchBufferViews.reserve(numSegments);
-    reducedScratchBufferViews.reserve(numSegments);
-    sourcePayloadViews.reserve(numSegments);
-    payloadPongBufferViews.reserve(numSegments);
-    for (uint i = 0, offset = 0, scratchOffset = 0, reduceOffset = 0; i < numSegments; ++i)
+    createPongBuffers(totalKeys, hasPayload);
+    GfxBuffer const *readBuffer(&sourceBuffer);
+    GfxBuffer const *writeBuffer(&sourcePongBuffer);
+    GfxBuffer const *readPayloadBuffer(sourcePayload);
+    GfxBuffer const *writePayloadBuffer(&payloadPongBuffer);
+    uint const       passCount =
+        preparePasses(numThreadGroupsToRun, numReducedThreadGroupsToRun, numSegments, isIndirect);
+    if ((passCount & 1) != 0)
     {
-        uint const bufferSize = isIndirect ? maxNumKeys : numKeysList[i];
-        sourceBufferViews.emplace_back(gfx, sourceBuffer, offset, bufferSize);
-        sourcePongBufferViews.emplace_back(gfx, sourcePongBuffer, offset, bufferSize);
-        scratchBufferViews.emplace_back(gfx, scratchBuffer, scratchOffset, scratchBufferCount[i]);
-        reducedScratchBufferViews.emplace_back(
-            gfx, reducedScratchBuffer, reduceOffset, reducedScratchBufferCount[i]);
-
-        if (hasPayload)
-        {
-            sourcePayloadViews.emplace_back(gfx, *sourcePayload, offset, bufferSize);
-            payloadPongBufferViews.emplace_back(gfx, payloadPongBuffer, offset, bufferSize);
-        }
-        offset += bufferSize;
-        scratchOffset += scratchBufferCount[i];
-        reduceOffset += reducedScratchBufferCount[i];
+        // Sort from a copy so that the final pass writes back into the source buffers, keys outside of any
+        // segment are left untouched
+        copyToPong(sourceBuffer, hasPayload ? sourcePayload : nullptr, totalKeys);
+        std::swap(readBuffer, writeBuffer);
+        std::swap(readPayloadBuffer, writePayloadBuffer);
     }
 
-    std::vector<BufferView<uint>> const *readBuffer(&sourceBufferViews);
-    std::vector<BufferView<uint>> const *writeBuffer(&sourcePongBufferViews);
-    std::vector<BufferView<uint>> const *readPayloadBuffer(&sourcePayloadViews);
-    std::vector<BufferView<uint>> const *writePayloadBuffer(&payloadPongBufferViews);
-
-    // Perform Radix Sort (currently only support 32-bit key/payload sorting
-    for (uint32_t shift = 0; shift < 32U; shift += FFX_PARALLELSORT_SORT_BITS_PER_PASS)
+    gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBuffer);
+    gfxProgramSetParameter(gfx, sortProgram, "Segments", segmentBuffer);
+    gfxProgramSetParameter(gfx, sortProgram, "NumSegments", numSegments);
+    gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBuffer);
+    gfxProgramSetParameter(gfx, sortProgram, "ReduceTable", reducedScratchBuffer);
+    gfxProgramSetParameter(gfx, sortProgram, "ScanScratch", reducedScratchBuffer);
+
+    // Perform Radix Sort (32-bit key words with optional 32-bit payload)
+    GfxBuffer const *countScatterArgs = isIndirect ? &countScatterArgsBuffer : nullptr;
+    GfxBuffer const *reduceScanArgs   = isIndirect ? &reduceScanArgsBuffer : nullptr;
+    for (uint pass = 0; pass < passCount; ++pass)
     {
+        uint const shift = pass * FFX_PARALLELSORT_SORT_BITS_PER_PASS;
+
         // Sort Count
         {
             gfxProgramSetParameter(gfx, sortProgram, "CShiftBit", shift);
-            gfxCommandBindKernel(gfx, count);
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SrcBuffer", (*readBuffer)[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBufferViews[i].buffer);
-                if (isIndirect)
-                {
-                    gfxCommandDispatchIndirect(gfx, countScatterArgsBufferViews[i].buffer);
-                }
-                else
-                {
-                    gfxCommandDispatch(gfx, numThreadGroupsToRun[i], 1, 1);
-                }
-            }
+            gfxProgramSetParameter(gfx, sortProgram, "SrcBuffer", *readBuffer);
+            gfxProgramSetParameter(gfx, sortProgram, "TrackKeyRange", derivePasses && pass == 0 ? 1U : 0U);
+
+            dispatchPass(countSegmented, pass, 0, countScatterArgs, numThreadGroupsToRun);
+            setupDerivedPasses(pass);
         }
 
         // Sort Reduce
         {
-            gfxCommandBindKernel(gfx, countReduce);
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ReduceTable", reducedScratchBufferViews[i].buffer);
-                if (isIndirect)
-                {
-                    gfxCommandDispatchIndirect(gfx, reduceScanArgsBufferViews[i].buffer);
-                }
-                else
-                {
-                    gfxCommandDispatch(gfx, numReducedThreadGroupsToRun[i], 1, 1);
-                }
-            }
+            dispatchPass(countReduceSegmented, pass, 1, reduceScanArgs, numReducedThreadGroupsToRun);
         }
 
         // Sort Scan
         {
-            // First do scan prefix of reduced values
-            gfxCommandBindKernel(gfx, scan);
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", reducedScratchBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanDst", reducedScratchBufferViews[i].buffer);
-                gfxCommandDispatch(gfx, 1, 1, 1);
-            }
+            // First do scan prefix of reduced values, using a single thread group per segment
+            gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", reducedScratchBuffer);
+            gfxProgramSetParameter(gfx, sortProgram, "ScanDst", reducedScratchBuffer);
+            dispatchPass(scanSegmented, pass, 2, nullptr, numSegments);
 
             // Next do scan prefix on the histogram with partial sums that we just did
-            gfxCommandBindKernel(gfx, scanAdd);
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", scratchBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanDst", scratchBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "ScanScratch", reducedScratchBufferViews[i].buffer);
-                if (isIndirect)
-                {
-                    gfxCommandDispatchIndirect(gfx, reduceScanArgsBufferViews[i].buffer);
-                }
-                else
-                {
-                    gfxCommandDispatch(gfx, numReducedThreadGroupsToRun[i], 1, 1);
-                }
-            }
+            gfxProgramSetParameter(gfx, sortProgram, "ScanSrc", scratchBuffer);
+            gfxProgramSetParameter(gfx, sortProgram, "ScanDst", scratchBuffer);
+            dispatchPass(scanAddSegmented, pass, 1, reduceScanArgs, numReducedThreadGroupsToRun);
         }
 
         // Sort Scatter
         {
+            gfxProgramSetParameter(gfx, sortProgram, "DstBuffer", *writeBuffer);
             if (hasPayload)
             {
-                gfxCommandBindKernel(gfx, scatterPayload);
-            }
-            else
-            {
-                gfxCommandBindKernel(gfx, scatter);
-            }
-            for (uint i = 0; i < numSegments; ++i)
-            {
-                gfxProgramSetParameter(gfx, sortProgram, "CBuffer", parallelSortCBBufferViews[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SrcBuffer", (*readBuffer)[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "DstBuffer", (*writeBuffer)[i].buffer);
-                gfxProgramSetParameter(gfx, sortProgram, "SumTable", scratchBufferViews[i].buffer);
-                if (hasPayload)
-                {
-                    gfxProgramSetParameter(gfx, sortProgram, "SrcPayload", (*readPayloadBuffer)[i].buffer);
-                    gfxProgramSetParameter(gfx, sortProgram, "DstPayload", (*writePayloadBuffer)[i].buffer);
-                }
-                if (isIndirect)
-                {
-                    gfxCommandDispatchIndirect(gfx, countScatterArgsBufferViews[i].buffer);
-                }
-                else
-                {
-                    gfxCommandDispatch(gfx, numThreadGroupsToRun[i], 1, 1);
-                }
+                gfxProgramSetParameter(gfx, sortProgram, "SrcPayload", *readPayloadBuffer);
+                gfxProgramSetParameter(gfx, sortProgram, "DstPayload", *writePayloadBuffer);
             }
+            dispatchPass(useScatterPayload ? scatterPayloadSegmented : scatterSegmented, pass, 0,
+                countScatterArgs, numThreadGroupsToRun);
         }
 
         // Swap read/write sources
@@ -656,4 +622,89 @@ void GPUSort::sortInternalSegmented(GfxBuffer const &sourceBuffer, std::vector<u
         std::swap(readPayloadBuffer, writePayloadBuffer);
     }
 }
+
+void GPUSort::copyToPong(
+    GfxBuffer const &sourceBuffer, GfxBuffer const *sourcePayload, uint const numKeys) noexcept
+{
+    uint64_t const keySize  = currentType == Type::UInt64 ? sizeof(uint2) : sizeof(uint);
+    uint64_t const keysSize = glm::min(sourceBuffer.getSize(), static_cast<uint64_t>(numKeys) * keySize);
+    gfxCommandCopyBuffer(gfx, sourcePongBuffer, 0, sourceBuffer, 0, keysSize);
+    if (sourcePayload != nullptr)
+    {
+        uint64_t const payloadSize =
+            glm::min(sourcePayload->getSize(), static_cast<uint64_t>(numKeys) * sizeof(uint));
+        gfxCommandCopyBuffer(gfx, payloadPongBuffer, 0, *sourcePayload, 0, payloadSize);
+    }
+}
+
+void GPUSort::createPongBuffers(uint const numKeys, bool const hasPayload) noexcept
+{
+    uint const     keySize  = currentType == Type::UInt64 ? sizeof(uint2) : sizeof(uint);
+    uint64_t const keysSize = static_cast<uint64_t>(numKeys) * keySize;
+    if (!sourcePongBuffer || (sourcePongBuffer.getSize() < keysSize)
+        || (sourcePongBuffer.getStride() != keySize))
+    {
+        gfxDestroyBuffer(gfx, sourcePongBuffer);
+        sourcePongBuffer = gfxCreateBuffer(gfx, glm::max(keysSize, static_cast<uint64_t>(keySize)));
+        sourcePongBuffer.setStride(keySize);
+        sourcePongBuffer.setName("SourcePongBuffer");
+    }
+    if (hasPayload && (!payloadPongBuffer || (payloadPongBuffer.getCount() < numKeys)))
+    {
+        gfxDestroyBuffer(gfx, payloadPongBuffer);
+        payloadPongBuffer = gfxCreateBuffer<uint>(gfx, numKeys);
+        payloadPongBuffer.setName("PayloadPongBuffer");
+    }
+}
+
+uint GPUSort::preparePasses(uint const numThreadGroups, uint const numReduceThreadGroups,
+    uint const numScanThreadGroups, bool const indirect) noexcept
+{
+    uint const maxKeyBits = currentType == Type::UInt64 ? 64 : 32;
+    derivePasses          = keyBits == 0;
+    if (derivePasses)
+    {
+        // The first count pass accumulates the key range, setupPasses then writes the dispatch arguments of
+        // the remaining passes
+        gfxCommandClearBuffer(gfx, keyRangeBuffer, 0);
+        gfxProgramSetParameter(gfx, sortProgram, "KeyRange", keyRangeBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "PassArgs", passArgsBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "PassIndirectArgs", indirect ? 1U : 0U);
+        gfxProgramSetParameter(gfx, sortProgram, "PassThreadGroups", numThreadGroups);
+        gfxProgramSetParameter(gfx, sortProgram, "PassReduceThreadGroups", numReduceThreadGroups);
+        gfxProgramSetParameter(gfx, sortProgram, "PassScanThreadGroups", numScanThreadGroups);
+        gfxProgramSetParameter(gfx, sortProgram, "CountScatterArgs", countScatterArgsBuffer);
+        gfxProgramSetParameter(gfx, sortProgram, "ReduceScanArgs", reduceScanArgsBuffer);
+        // This is always an even number of passes so the keys end up back in the source buffer
+        return GPUSortSimulator::GetPassCount(maxKeyBits);
+    }
+    return GPUSortSimulator::GetPassCount(glm::min(keyBits, maxKeyBits));
+}
+
+void GPUSort::setupDerivedPasses(uint const pass) noexcept
+{
+    if (derivePasses && pass == 0)
+    {
+        gfxCommandBindKernel(gfx, setupPasses);
+        gfxCommandDispatch(gfx, 1, 1, 1);
+    }
+}
+
+void GPUSort::dispatchPass(GfxKernel const &kernel, uint const pass, uint const argsIndex,
+    GfxBuffer const *indirectArgs, uint const numThreadGroups) noexcept
+{
+    gfxCommandBindKernel(gfx, kernel);
+    if (derivePasses && pass > 0)
+    {
+        gfxCommandDispatchIndirect(gfx, passArgs[pass * 3 + argsIndex]);
+    }
+    else if (indirectArgs != nullptr)
+    {
+        gfxCommandDispatchIndirect(gfx, *indirectArgs);
+    }
+    else
+    {
+        gfxCommandDispatch(gfx, numThreadGroups, 1, 1);
+    }
+}
 } // namespace Capsaicin
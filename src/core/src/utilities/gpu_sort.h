@@ -22,7 +22,9 @@ THE SOFTWARE.
 #pragma once
 
 #include "gpu_shared.h"
+#include "gpu_sort_shared.h"
 
+#include <array>
 #include <gfx.h>
 #include <string>
 #include <vector>
@@ -48,6 +50,7 @@ class GPUSort
     {
         Float = 0, /* Does not support negative values */
         UInt,
+        UInt64, /* Keys are stored as uint2 (low, high), does not support payloads */
     };
 
     /** Type of sort operation to perform. */
@@ -60,12 +63,12 @@ class GPUSort
     /**
      * Initialise the internal data based on current configuration.
      * @param gfxIn         Active gfx context.
-     * @param shaderPaths Paths to shader files based on current working directory.
+     * @param shaderPathsIn Paths to shader files based on current working directory.
      * @param type        The object type to reduce.
      * @param operation   The type of operation to perform.
      * @return True, if any initialisation/changes succeeded.
      */
-    bool initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPaths, Type type,
+    bool initialise(GfxContext const &gfxIn, std::vector<std::string> const &shaderPathsIn, Type type,
         Operation operation) noexcept;
 
     /**
@@ -79,7 +82,7 @@ class GPUSort
 
     /**
      * Sort a list of keys from smallest to largest using indirect execution.
-     * @param sourceBuffer The buffer containing the keys to sort (only 32bit uint or float>=0 are supported).
+     * @param sourceBuffer The buffer containing the keys to sort (of the initialised GPUSort::Type).
      * @param numKeys      A buffer containing the number of keys in the source buffer (must be <=
      * maxNumKeys).
      * @param maxNumKeys   Value containing the number of keys in the source buffer, if exact value is unknown
@@ -89,38 +92,36 @@ class GPUSort
 
     /**
      * Sort a list of keys and associated payload from smallest to largest using indirect execution.
-     * @param sourceBuffer  The buffer containing the keys to sort (only 32bit uint or float>=0 are
-     * supported).
+     * @param sourceBuffer  The buffer containing the keys to sort (of the initialised GPUSort::Type).
      * @param numKeys       A buffer containing the number of keys in the source buffer (must be <=
      * maxNumKeys).
      * @param maxNumKeys    Value containing the number of keys in the source buffer, if exact value is
      * unknown then this should be the maximum possible number of values in the source.
      * @param sourcePayload The buffer containing the payload for each key (only 32bit payloads per key are
-     *  supported).
+     *  supported, not supported with 64bit keys).
      */
     void sortIndirectPayload(GfxBuffer const &sourceBuffer, GfxBuffer const &numKeys, uint maxNumKeys,
         GfxBuffer const &sourcePayload) noexcept;
 
     /**
      * Sort a list of keys from smallest to largest.
-     * @param sourceBuffer The buffer containing the keys to sort (only 32bit uint or float>=0 are supported).
+     * @param sourceBuffer The buffer containing the keys to sort (of the initialised GPUSort::Type).
      * @param numKeys      Value containing the number of keys in the source buffer.
      */
     void sort(GfxBuffer const &sourceBuffer, uint numKeys) noexcept;
 
     /**
      * Sort a list of keys and associated payload from smallest to largest.
-     * @param sourceBuffer  The buffer containing the keys to sort (only 32bit uint or float>=0 are
-     * supported).
+     * @param sourceBuffer  The buffer containing the keys to sort (of the initialised GPUSort::Type).
      * @param numKeys       Value containing the number of keys in the source buffer.
      * @param sourcePayload The buffer containing the payload for each key (only 32bit payloads per key are
-     *  supported).
+     *  supported, not supported with 64bit keys).
      */
     void sortPayload(GfxBuffer const &sourceBuffer, uint numKeys, GfxBuffer const &sourcePayload) noexcept;
 
     /**
      * Sort a segmented list of keys from smallest to largest using indirect execution.
-     * @param sourceBuffer The buffer containing the keys to sort (only 32bit uint or float>=0 are supported).
+     * @param sourceBuffer The buffer containing the keys to sort (of the initialised GPUSort::Type).
      * Segments within this buffer must have a stride equal to maxNumKeys.
      * @param numSegments  The number of segments to sort.
      * @param numKeys      A buffer containing the number of keys in each segment of the source buffer (must
@@ -133,60 +134,92 @@ class GPUSort
 
     /**
      * Sort a segmented list of keys and associated payload from smallest to largest using indirect execution.
-     * @param sourceBuffer  The buffer containing the keys to sort (only 32bit uint or float>=0 are
-     * supported). Segments within this buffer must have a stride equal to maxNumKeys.
+     * @param sourceBuffer  The buffer containing the keys to sort (of the initialised GPUSort::Type).
+     *  Segments within this buffer must have a stride equal to maxNumKeys.
      * @param numSegments   The number of segments to sort.
      * @param numKeys       A buffer containing the number of keys in each segment of the source buffer (must
      *  have numSegments values with each value being <= maxNumKeys).
      * @param maxNumKeys    Value containing the maximum possible number of values in each segment. This also
      * indicates the stride of each segment in the input buffer.
      * @param sourcePayload The buffer containing the payload for each key (only 32bit payloads per key are
-     *  supported).
+     *  supported, not supported with 64bit keys).
      */
     void sortIndirectPayloadSegmented(GfxBuffer const &sourceBuffer, uint numSegments,
         GfxBuffer const &numKeys, uint maxNumKeys, GfxBuffer const &sourcePayload) noexcept;
 
     /**
      * Sort a segmented list of keys from smallest to largest.
-     * @param sourceBuffer The buffer containing the keys to sort (only 32bit uint or float>=0 are supported).
+     * @param sourceBuffer The buffer containing the keys to sort (of the initialised GPUSort::Type).
      * @param numKeys      List containing the number of keys in each segment of the source buffer.
      */
     void sortSegmented(GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeys) noexcept;
 
     /**
      * Sort a segmented list of keys and associated payload from smallest to largest.
-     * @param sourceBuffer  The buffer containing the keys to sort (only 32bit uint or float>=0 are
-     * supported).
+     * @param sourceBuffer  The buffer containing the keys to sort (of the initialised GPUSort::Type).
      * @param numKeys       List containing the number of keys in each segment of the source buffer.
      * @param sourcePayload The buffer containing the payload for each key (only 32bit payloads per key are
-     *  supported).
+     *  supported, not supported with 64bit keys).
      */
     void sortPayloadSegmented(GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeys,
         GfxBuffer const &sourcePayload) noexcept;
 
+    /**
+     * Sort a segmented list of packed keys from smallest to largest using indirect execution.
+     * @param sourceBuffer   The buffer containing the keys to sort (of the initialised GPUSort::Type).
+     * @param numSegments    The number of segments to sort.
+     * @param segmentOffsets A buffer containing the index of the first key of each segment followed by the
+     *  index one past the last key of the final segment (must have numSegments + 1 increasing values).
+     * @param maxNumKeys     Value containing the maximum possible number of keys across all segments.
+     */
+    void sortIndirectSegmentedOffsets(GfxBuffer const &sourceBuffer, uint numSegments,
+        GfxBuffer const &segmentOffsets, uint maxNumKeys) noexcept;
+
+    /**
+     * Sort a segmented list of packed keys and associated payload from smallest to largest using indirect
+     * execution.
+     * @param sourceBuffer   The buffer containing the keys to sort (of the initialised GPUSort::Type).
+     * @param numSegments    The number of segments to sort.
+     * @param segmentOffsets A buffer containing the index of the first key of each segment followed by the
+     *  index one past the last key of the final segment (must have numSegments + 1 increasing values).
+     * @param maxNumKeys     Value containing the maximum possible number of keys across all segments.
+     * @param sourcePayload  The buffer containing the payload for each key (only 32bit payloads per key are
+     *  supported, not supported with 64bit keys).
+     */
+    void sortIndirectPayloadSegmentedOffsets(GfxBuffer const &sourceBuffer, uint numSegments,
+        GfxBuffer const &segmentOffsets, uint maxNumKeys, GfxBuffer const &sourcePayload) noexcept;
+
+    /**
+     * Limit subsequent sorts to the low bits of each key.
+     * Only ceil(keyBits / 4) radix passes are performed, any higher bits set in a key are ignored. If 0 then
+     * the key range is instead found on the GPU during the first count pass, the dispatches of any passes
+     * past the used key range are then issued indirectly with no thread groups.
+     * @param keyBits The number of low bits of each key that may be set (0-64, defaults to the full key width
+     *  of the sort type).
+     */
+    void setKeyBits(uint keyBits) noexcept;
+
 private:
     /** Terminates and cleans up this object. */
     void terminate() noexcept;
 
     /**
      * Internal sort implementation used to handle multiple sort cases.
-     * @param sourceBuffer  The buffer containing the keys to sort (only 32bit uint or float>=0 are
-     * supported).
+     * @param sourceBuffer  The buffer containing the keys to sort (of the initialised GPUSort::Type).
      * @param maxNumKeys    Value containing the number of keys in the source buffer, if using indirect
      *  execution and exact value is unknown then this should be the maximum possible number of values in the
      *  source.
      * @param numKeys       (Optional) If non-null, a buffer containing the number of keys in the source
      * buffer used for indirect execution. If null then @maxNumKeys is used instead.
      * @param sourcePayload (Optional) The buffer containing the payload for each key (only 32bit payloads per
-     *  key are supported).
+     *  key are supported, not supported with 64bit keys).
      */
     void sortInternal(GfxBuffer const &sourceBuffer, uint maxNumKeys, GfxBuffer const *numKeys = nullptr,
         GfxBuffer const *sourcePayload = nullptr) noexcept;
 
     /**
      * Internal sort implementation used to handle multiple sort cases.
-     * @param sourceBuffer  The buffer containing the keys to sort (only 32bit uint or float>=0 are
-     * supported).
+     * @param sourceBuffer  The buffer containing the keys to sort (of the initialised GPUSort::Type).
      * @param numKeysList   List containing the number of keys in each segment of the source buffer.
      * @param maxNumKeys    Value containing the number of keys in each segment of the source buffer, if using
      *  indirect execution and exact value is unknown then this should be the maximum possible number of
@@ -196,20 +229,75 @@ class GPUSort
      * @param numKeys       (Optional) If non-null, a buffer containing the number of keys in each segment of
      *  the source buffer (must have @numSegments values). If null then @numKeysList is used instead.
      * @param sourcePayload (Optional) The buffer containing the payload for each key (only 32bit payloads per
-     *  key are supported).
+     *  key are supported, not supported with 64bit keys).
+     * @param keyOffsets    (Optional) True if @numKeys contains @numSegments + 1 segment key offsets instead
+     *  of key counts, @maxNumKeys is then the maximum number of keys across all segments.
      */
     void sortInternalSegmented(GfxBuffer const &sourceBuffer, std::vector<uint> const &numKeysList,
         uint maxNumKeys, uint numSegments = UINT_MAX, GfxBuffer const *numKeys = nullptr,
-        GfxBuffer const *sourcePayload = nullptr) noexcept;
+        GfxBuffer const *sourcePayload = nullptr, bool keyOffsets = false) noexcept;
+
+    /**
+     * Copy keys and payload into the ping-pong buffers.
+     * Used when sorting with an odd number of passes so that the last pass writes into the source buffers.
+     * @param sourceBuffer  The buffer containing the keys to sort.
+     * @param sourcePayload (Optional) The buffer containing the payload for each key.
+     * @param numKeys       The number of keys to copy.
+     */
+    void copyToPong(GfxBuffer const &sourceBuffer, GfxBuffer const *sourcePayload, uint numKeys) noexcept;
 
-    GfxContext gfx;
+    /**
+     * Create the ping-pong buffers.
+     * @param numKeys    The number of keys to hold.
+     * @param hasPayload True if a payload is also being sorted.
+     */
+    void createPongBuffers(uint numKeys, bool hasPayload) noexcept;
+
+    /**
+     * Set up the number of radix passes for the current key bits.
+     * If the key range is derived from the keys then this also sets the parameters used by setupPasses.
+     * @param numThreadGroups       The number of count/scatter thread groups of a direct sort.
+     * @param numReduceThreadGroups The number of reduce/scan-add thread groups of a direct sort.
+     * @param numScanThreadGroups   The number of scan thread groups.
+     * @param indirect              True if the sort dispatch sizes are in the indirect argument buffers.
+     * @return The number of passes to dispatch.
+     */
+    uint preparePasses(
+        uint numThreadGroups, uint numReduceThreadGroups, uint numScanThreadGroups, bool indirect) noexcept;
+
+    /**
+     * Write the dispatch arguments of the remaining passes once the key range is known.
+     * @param pass The index of the pass whose count kernel was just dispatched.
+     */
+    void setupDerivedPasses(uint pass) noexcept;
+
+    /**
+     * Dispatch a kernel of a radix pass.
+     * @param kernel          The kernel to dispatch.
+     * @param pass            The index of the pass.
+     * @param argsIndex       The dispatch within the pass (0 count/scatter, 1 reduce/scan-add, 2 scan).
+     * @param indirectArgs    (Optional) The indirect arguments of the sort, null if using direct execution.
+     * @param numThreadGroups The number of thread groups for direct execution.
+     */
+    void dispatchPass(GfxKernel const &kernel, uint pass, uint argsIndex, GfxBuffer const *indirectArgs,
+        uint numThreadGroups) noexcept;
+
+    GfxContext               gfx;
+    std::vector<std::string> shaderPaths;
 
     Type      currentType      = Type::Float;
     Operation currentOperation = Operation::Ascending;
+    uint      keyBits          = 64;    /**< Clamped to the width of the key type */
+    bool      derivePasses     = false; /**< True if the current sort derives its pass count on the GPU */
 
     GfxBuffer parallelSortCBBuffer;
     GfxBuffer countScatterArgsBuffer;
     GfxBuffer reduceScanArgsBuffer;
+    GfxBuffer segmentBuffer;
+    GfxBuffer keyRangeBuffer;
+    GfxBuffer passArgsBuffer;
+
+    std::array<GfxBuffer, GPUSORT_MAX_PASSES * 3> passArgs; /**< Views of each dispatch in passArgsBuffer */
 
     GfxBuffer scratchBuffer;
     GfxBuffer reducedScratchBuffer;
@@ -225,5 +313,13 @@ class GPUSort
     GfxKernel  scanAdd;
     GfxKernel  scatter;
     GfxKernel  scatterPayload;
+    GfxKernel  setupIndirectSegmented;
+    GfxKernel  countSegmented;
+    GfxKernel  countReduceSegmented;
+    GfxKernel  scanSegmented;
+    GfxKernel  scanAddSegmented;
+    GfxKernel  scatterSegmented;
+    GfxKernel  scatterPayloadSegmented;
+    GfxKernel  setupPasses;
 };
 } // namespace Capsaicin
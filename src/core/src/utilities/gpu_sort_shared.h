@@ -0,0 +1,59 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#ifndef GPU_SORT_SHARED_H
+#define GPU_SORT_SHARED_H
+
+#include "gpu_shared.h"
+
+#define GPUSORT_THREADGROUP_SIZE 128 /*< Must match FFX_PARALLELSORT_THREADGROUP_SIZE */
+#define GPUSORT_ELEMENTS_PER_THREAD 4 /*< Must match FFX_PARALLELSORT_ELEMENTS_PER_THREAD */
+#define GPUSORT_BITS_PER_PASS 4 /*< Must match FFX_PARALLELSORT_SORT_BITS_PER_PASS */
+#define GPUSORT_BIN_COUNT (1 << GPUSORT_BITS_PER_PASS)
+#define GPUSORT_BLOCK_SIZE (GPUSORT_ELEMENTS_PER_THREAD * GPUSORT_THREADGROUP_SIZE)
+#define GPUSORT_MAX_THREAD_GROUPS 800 /*< Target number of count/scatter thread groups for a whole sort */
+#define GPUSORT_MAX_PASSES (64 / GPUSORT_BITS_PER_PASS) /*< Number of passes needed for the widest keys */
+#define GPUSORT_PASS_ARGS_SIZE 9 /*< Indirect arguments per pass (count/scatter, reduce/scan-add and scan) */
+
+/** Per segment sort parameters, must match the layout of FfxParallelSortConstants. */
+struct GPUSortConstants
+{
+    uint numKeys;                             /*< The number of keys to sort */
+    int  numBlocksPerThreadGroup;             /*< How many blocks of keys each thread group processes */
+    uint numThreadGroups;                     /*< How many thread groups are run for the sort */
+    uint numThreadGroupsWithAdditionalBlocks; /*< How many thread groups process an additional block */
+    uint numReduceThreadgroupPerBin;          /*< How many thread groups are summed for each reduced bin */
+    uint numScanValues;                       /*< How many values to perform scan prefix (+ add) on */
+    uint shift;                               /*< Unused, shift is passed separately */
+    uint padding;
+};
+
+/** Location of a segment within the combined buffers of a segmented sort. */
+struct GPUSortSegment
+{
+    uint keyOffset;         /*< Index of the first key of the segment */
+    uint groupOffset;       /*< Index of the first count/scatter thread group (sum table offset / bins) */
+    uint reduceGroupOffset; /*< Index of the first reduce/scan-add thread group (reduce table offset) */
+    uint padding;
+};
+
+#endif
@@ -0,0 +1,361 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "gpu_sort_simulator.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace Capsaicin
+{
+namespace
+{
+/**
+ * Find the segment that owns a thread group.
+ * @param offsets     First thread group of each segment (sorted).
+ * @param threadGroup The thread group index across all segments.
+ * @return The index of the last segment whose first thread group is not after @threadGroup.
+ */
+uint FindSegment(std::vector<uint> const &offsets, uint const threadGroup) noexcept
+{
+    auto const it = std::upper_bound(offsets.cbegin(), offsets.cend(), threadGroup);
+    return static_cast<uint>(std::distance(offsets.cbegin(), it)) - 1;
+}
+
+/**
+ * Get the range of keys processed by a count/scatter thread group.
+ * @param      constants   The segment sort parameters.
+ * @param      threadGroup The thread group index within the segment.
+ * @param [out] numBlocks  The number of blocks processed by the thread group.
+ * @return The index of the first key processed by the thread group.
+ */
+uint GetThreadGroupBlockStart(
+    GPUSortConstants const &constants, uint const threadGroup, uint &numBlocks) noexcept
+{
+    auto const blocksPerThreadGroup = static_cast<uint>(constants.numBlocksPerThreadGroup);
+    uint       blockStart           = GPUSORT_BLOCK_SIZE * blocksPerThreadGroup * threadGroup;
+    numBlocks                       = blocksPerThreadGroup;
+    if (threadGroup >= constants.numThreadGroups - constants.numThreadGroupsWithAdditionalBlocks)
+    {
+        uint const firstGroup = constants.numThreadGroups - constants.numThreadGroupsWithAdditionalBlocks;
+        blockStart += (threadGroup - firstGroup) * GPUSORT_BLOCK_SIZE;
+        ++numBlocks;
+    }
+    return blockStart;
+}
+} // namespace
+
+GPUSortConstants GPUSortSimulator::MakeConstants(
+    uint const numKeys, uint const maxThreadGroups, uint &numReduceThreadGroups) noexcept
+{
+    GPUSortConstants constants = {};
+    constants.numKeys          = numKeys;
+    uint const numBlocks       = (numKeys + GPUSORT_BLOCK_SIZE - 1) / GPUSORT_BLOCK_SIZE;
+    uint const numThreadGroups = std::min(maxThreadGroups, numBlocks);
+    if (numThreadGroups == 0)
+    {
+        numReduceThreadGroups = 0;
+        return constants;
+    }
+    constants.numBlocksPerThreadGroup             = static_cast<int>(numBlocks / numThreadGroups);
+    constants.numThreadGroups                     = numThreadGroups;
+    constants.numThreadGroupsWithAdditionalBlocks = numBlocks % numThreadGroups;
+    // Each reduce thread group sums up to a block worth of count thread groups for a single bin
+    numReduceThreadGroups =
+        GPUSORT_BIN_COUNT * ((numThreadGroups + GPUSORT_BLOCK_SIZE - 1) / GPUSORT_BLOCK_SIZE);
+    constants.numReduceThreadgroupPerBin = numReduceThreadGroups / GPUSORT_BIN_COUNT;
+    constants.numScanValues              = numReduceThreadGroups;
+    return constants;
+}
+
+GPUSortSimulator::Dispatch GPUSortSimulator::MakeDispatch(
+    std::vector<uint> const &keyOffsets, std::vector<uint> const &numKeys) noexcept
+{
+    auto const numSegments = static_cast<uint>(numKeys.size());
+    uint       totalBlocks = 0;
+    for (uint const keys : numKeys)
+    {
+        totalBlocks += (keys + GPUSORT_BLOCK_SIZE - 1) / GPUSORT_BLOCK_SIZE;
+    }
+    // Share thread groups between segments based on their number of blocks
+    uint const blocksPerThreadGroup =
+        std::max((totalBlocks + GPUSORT_MAX_THREAD_GROUPS - 1) / GPUSORT_MAX_THREAD_GROUPS, 1U);
+
+    Dispatch dispatch;
+    dispatch.constants.reserve(numSegments);
+    dispatch.segments.reserve(numSegments);
+    for (uint i = 0; i < numSegments; ++i)
+    {
+        uint const numBlocks             = (numKeys[i] + GPUSORT_BLOCK_SIZE - 1) / GPUSORT_BLOCK_SIZE;
+        uint       numReduceThreadGroups = 0;
+        dispatch.constants.push_back(MakeConstants(numKeys[i],
+            (numBlocks + blocksPerThreadGroup - 1) / blocksPerThreadGroup, numReduceThreadGroups));
+        dispatch.segments.push_back(
+            {keyOffsets[i], dispatch.numThreadGroups, dispatch.numReduceThreadGroups, 0});
+        dispatch.numThreadGroups += dispatch.constants.back().numThreadGroups;
+        dispatch.numReduceThreadGroups += numReduceThreadGroups;
+        dispatch.numKeys = std::max(dispatch.numKeys, keyOffsets[i] + numKeys[i]);
+    }
+    return dispatch;
+}
+
+void GPUSortSimulator::GetScratchSize(
+    uint const numSegments, uint const maxTotalKeys, uint &sumTableSize, uint &reduceTableSize) noexcept
+{
+    // Rounding up each segment adds at most 1 thread group per segment over the target
+    uint const maxBlocks       = (maxTotalKeys + GPUSORT_BLOCK_SIZE - 1) / GPUSORT_BLOCK_SIZE + numSegments;
+    uint const maxThreadGroups = std::min(maxBlocks, GPUSORT_MAX_THREAD_GROUPS + numSegments);
+    sumTableSize               = std::max(GPUSORT_BIN_COUNT * maxThreadGroups, 1U);
+    reduceTableSize            = std::max(
+        GPUSORT_BIN_COUNT * ((maxThreadGroups + GPUSORT_BLOCK_SIZE - 1) / GPUSORT_BLOCK_SIZE + numSegments),
+        1U);
+}
+
+uint GPUSortSimulator::GetPassCount(uint const keyBits) noexcept
+{
+    uint const bits = std::clamp(keyBits, 1U, 64U);
+    return (bits + GPUSORT_BITS_PER_PASS - 1) / GPUSORT_BITS_PER_PASS;
+}
+
+uint GPUSortSimulator::GetDerivedPassCount(uint const maxKeyLow, uint const maxKeyHigh) noexcept
+{
+    uint const bits = maxKeyHigh != 0 ? 64 - static_cast<uint>(std::countl_zero(maxKeyHigh))
+                                      : 32 - static_cast<uint>(std::countl_zero(maxKeyLow));
+    uint const passCount = (bits + GPUSORT_BITS_PER_PASS - 1) / GPUSORT_BITS_PER_PASS;
+    // The first pass is always dispatched as it finds the key range
+    return std::max(passCount + (passCount & 1), 2U);
+}
+
+void GPUSortSimulator::Sort(std::vector<uint> &keys, std::vector<uint> *payload,
+    std::vector<uint> const &keyOffsets, std::vector<uint> const &numKeys, uint const keyBits,
+    bool const descending) noexcept
+{
+    uint passCount = GetPassCount(std::min(keyBits, 32U));
+    if (keyBits == 0)
+    {
+        // The GPU finds the key range from the keys read by the first count pass
+        uint maxKey = 0;
+        for (size_t segment = 0; segment < numKeys.size(); ++segment)
+        {
+            for (uint key = keyOffsets[segment]; key < keyOffsets[segment] + numKeys[segment]; ++key)
+            {
+                maxKey = std::max(maxKey, keys[key]);
+            }
+        }
+        passCount = GetDerivedPassCount(maxKey);
+    }
+    SortWords(keys, payload, 1, keyOffsets, numKeys, passCount, descending);
+}
+
+void GPUSortSimulator::Sort(std::vector<uint64_t> &keys, std::vector<uint> const &keyOffsets,
+    std::vector<uint> const &numKeys, uint const keyBits, bool const descending) noexcept
+{
+    // Keys are stored as pairs of (low, high) words to match the GPU layout
+    std::vector<uint> words;
+    words.reserve(keys.size() * 2);
+    for (uint64_t const key : keys)
+    {
+        words.push_back(static_cast<uint>(key));
+        words.push_back(static_cast<uint>(key >> 32));
+    }
+    // The GPU finds the largest of each key word from the keys read by the first count pass
+    uint maxKeyLow  = 0;
+    uint maxKeyHigh = 0;
+    for (size_t segment = 0; segment < numKeys.size(); ++segment)
+    {
+        for (uint key = keyOffsets[segment]; key < keyOffsets[segment] + numKeys[segment]; ++key)
+        {
+            maxKeyLow  = std::max(maxKeyLow, words[key * 2]);
+            maxKeyHigh = std::max(maxKeyHigh, words[key * 2 + 1]);
+        }
+    }
+    uint const passCount =
+        keyBits == 0 ? GetDerivedPassCount(maxKeyLow, maxKeyHigh) : GetPassCount(keyBits);
+    SortWords(words, nullptr, 2, keyOffsets, numKeys, passCount, descending);
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        keys[i] = (static_cast<uint64_t>(words[i * 2 + 1]) << 32) | words[i * 2];
+    }
+}
+
+void GPUSortSimulator::SortWords(std::vector<uint> &keys, std::vector<uint> *payload, uint const keyWords,
+    std::vector<uint> const &keyOffsets, std::vector<uint> const &numKeys, uint const passCount,
+    bool const descending) noexcept
+{
+    Dispatch const dispatch    = MakeDispatch(keyOffsets, numKeys);
+    auto const     numSegments = static_cast<uint>(dispatch.segments.size());
+    std::vector<uint> groupOffsets;
+    std::vector<uint> reduceGroupOffsets;
+    groupOffsets.reserve(numSegments);
+    reduceGroupOffsets.reserve(numSegments);
+    for (auto const &segment : dispatch.segments)
+    {
+        groupOffsets.push_back(segment.groupOffset);
+        reduceGroupOffsets.push_back(segment.reduceGroupOffset);
+    }
+
+    std::vector<uint> sumTable(GPUSORT_BIN_COUNT * dispatch.numThreadGroups);
+    std::vector<uint> reduceTable(dispatch.numReduceThreadGroups);
+    std::vector<uint> pongKeys(keys.size());
+    std::vector<uint> pongPayload(payload != nullptr ? payload->size() : 0);
+    std::vector<uint> *readKeys     = &keys;
+    std::vector<uint> *writeKeys    = &pongKeys;
+    std::vector<uint> *readPayload  = payload;
+    std::vector<uint> *writePayload = &pongPayload;
+
+    if ((passCount & 1) != 0)
+    {
+        // Start from a copy in the pong buffers so that the last pass writes back to the source, this
+        // matches the copy done on the GPU and leaves any keys outside of a segment untouched
+        pongKeys = keys;
+        if (payload != nullptr)
+        {
+            pongPayload = *payload;
+        }
+        std::swap(readKeys, writeKeys);
+        std::swap(readPayload, writePayload);
+    }
+    for (uint pass = 0; pass < passCount; ++pass)
+    {
+        // 64bit keys sort on the low word first followed by the high word
+        uint const keyWord  = (pass * GPUSORT_BITS_PER_PASS) / 32;
+        uint const shift    = (pass * GPUSORT_BITS_PER_PASS) % 32;
+        auto const getKey   = [&](std::vector<uint> const &buffer, uint const key) {
+            return buffer[key * keyWords + keyWord];
+        };
+        auto const getDigit = [&](uint const key) {
+            uint const digit = (key >> shift) & (GPUSORT_BIN_COUNT - 1);
+            return descending ? GPUSORT_BIN_COUNT - 1 - digit : digit;
+        };
+        // Count
+        for (uint group = 0; group < dispatch.numThreadGroups; ++group)
+        {
+            uint const  segmentIndex = FindSegment(groupOffsets, group);
+            auto const &segment      = dispatch.segments[segmentIndex];
+            auto const &constants    = dispatch.constants[segmentIndex];
+            uint const  localGroup   = group - segment.groupOffset;
+            uint        numBlocks    = 0;
+            uint const  blockStart   = GetThreadGroupBlockStart(constants, localGroup, numBlocks);
+            std::array<uint, GPUSORT_BIN_COUNT> histogram {};
+            for (uint key = blockStart;
+                key < std::min(blockStart + numBlocks * GPUSORT_BLOCK_SIZE, constants.numKeys); ++key)
+            {
+                ++histogram[getDigit(getKey(*readKeys, segment.keyOffset + key))];
+            }
+            for (uint bin = 0; bin < GPUSORT_BIN_COUNT; ++bin)
+            {
+                sumTable[segment.groupOffset * GPUSORT_BIN_COUNT + bin * constants.numThreadGroups
+                         + localGroup] = histogram[bin];
+            }
+        }
+
+        // Reduce
+        for (uint group = 0; group < dispatch.numReduceThreadGroups; ++group)
+        {
+            uint const  segmentIndex = FindSegment(reduceGroupOffsets, group);
+            auto const &segment      = dispatch.segments[segmentIndex];
+            auto const &constants    = dispatch.constants[segmentIndex];
+            uint const  localGroup   = group - segment.reduceGroupOffset;
+            uint const  binOffset =
+                segment.groupOffset * GPUSORT_BIN_COUNT
+                + (localGroup / constants.numReduceThreadgroupPerBin) * constants.numThreadGroups;
+            uint const baseIndex = (localGroup % constants.numReduceThreadgroupPerBin) * GPUSORT_BLOCK_SIZE;
+            uint       sum       = 0;
+            uint const endIndex  = std::min(baseIndex + GPUSORT_BLOCK_SIZE, constants.numThreadGroups);
+            for (uint i = baseIndex; i < endIndex; ++i)
+            {
+                sum += sumTable[binOffset + i];
+            }
+            reduceTable[segment.reduceGroupOffset + localGroup] = sum;
+        }
+
+        // Scan, a single thread group per segment
+        for (uint segmentIndex = 0; segmentIndex < numSegments; ++segmentIndex)
+        {
+            uint const reduceOffset = dispatch.segments[segmentIndex].reduceGroupOffset;
+            uint       sum          = 0;
+            for (uint i = 0; i < dispatch.constants[segmentIndex].numScanValues; ++i)
+            {
+                uint const value              = reduceTable[reduceOffset + i];
+                reduceTable[reduceOffset + i] = sum;
+                sum += value;
+            }
+        }
+
+        // Scan add
+        for (uint group = 0; group < dispatch.numReduceThreadGroups; ++group)
+        {
+            uint const  segmentIndex = FindSegment(reduceGroupOffsets, group);
+            auto const &segment      = dispatch.segments[segmentIndex];
+            auto const &constants    = dispatch.constants[segmentIndex];
+            uint const  localGroup   = group - segment.reduceGroupOffset;
+            uint const  binOffset =
+                segment.groupOffset * GPUSORT_BIN_COUNT
+                + (localGroup / constants.numReduceThreadgroupPerBin) * constants.numThreadGroups;
+            uint const baseIndex = (localGroup % constants.numReduceThreadgroupPerBin) * GPUSORT_BLOCK_SIZE;
+            uint       sum       = reduceTable[segment.reduceGroupOffset + localGroup];
+            uint const endIndex  = std::min(baseIndex + GPUSORT_BLOCK_SIZE, constants.numThreadGroups);
+            for (uint i = baseIndex; i < endIndex; ++i)
+            {
+                uint const value        = sumTable[binOffset + i];
+                sumTable[binOffset + i] = sum;
+                sum += value;
+            }
+        }
+
+        // Scatter, keys within a thread group are written in order so the sort is stable
+        for (uint group = 0; group < dispatch.numThreadGroups; ++group)
+        {
+            uint const  segmentIndex = FindSegment(groupOffsets, group);
+            auto const &segment      = dispatch.segments[segmentIndex];
+            auto const &constants    = dispatch.constants[segmentIndex];
+            uint const  localGroup   = group - segment.groupOffset;
+            std::array<uint, GPUSORT_BIN_COUNT> binOffsets {};
+            for (uint bin = 0; bin < GPUSORT_BIN_COUNT; ++bin)
+            {
+                binOffsets[bin] = sumTable[segment.groupOffset * GPUSORT_BIN_COUNT
+                                           + bin * constants.numThreadGroups + localGroup];
+            }
+            uint       numBlocks  = 0;
+            uint const blockStart = GetThreadGroupBlockStart(constants, localGroup, numBlocks);
+            for (uint key = blockStart;
+                key < std::min(blockStart + numBlocks * GPUSORT_BLOCK_SIZE, constants.numKeys); ++key)
+            {
+                uint const source = segment.keyOffset + key;
+                uint const index  = segment.keyOffset + binOffsets[getDigit(getKey(*readKeys, source))]++;
+                for (uint word = 0; word < keyWords; ++word)
+                {
+                    (*writeKeys)[index * keyWords + word] = (*readKeys)[source * keyWords + word];
+                }
+                if (payload != nullptr)
+                {
+                    (*writePayload)[index] = (*readPayload)[source];
+                }
+            }
+        }
+
+        std::swap(readKeys, writeKeys);
+        std::swap(readPayload, writePayload);
+    }
+}
+} // namespace Capsaicin
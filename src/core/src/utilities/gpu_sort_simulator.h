@@ -0,0 +1,138 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "gpu_sort_shared.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Capsaicin
+{
+/**
+ * CPU reference of the segmented GPUSort dispatches.
+ * Reproduces the work distribution and the count, reduce, scan, scan-add and scatter data flow of
+ * gpu_sort.comp using the same indexing into the sum and reduce tables. This allows the segmented sort
+ * to be validated against a plain CPU sort without requiring a GPU.
+ */
+class GPUSortSimulator
+{
+public:
+    /** Work distribution for a segmented sort, as written by the setup of a segmented sort. */
+    struct Dispatch
+    {
+        std::vector<GPUSortConstants> constants;                 /**< Sort parameters for each segment */
+        std::vector<GPUSortSegment>   segments;                  /**< Location of each segment */
+        uint                          numThreadGroups       = 0; /**< Total count/scatter thread groups */
+        uint                          numReduceThreadGroups = 0; /**< Total reduce/scan-add thread groups */
+        uint                          numKeys               = 0; /**< Size of the key range used */
+    };
+
+    /**
+     * Calculate the sort parameters for a single segment.
+     * @param      numKeys                The number of keys in the segment.
+     * @param      maxThreadGroups        The maximum number of count/scatter thread groups to use.
+     * @param [out] numReduceThreadGroups The number of reduce/scan-add thread groups required.
+     * @return The sort parameters.
+     */
+    static GPUSortConstants MakeConstants(
+        uint numKeys, uint maxThreadGroups, uint &numReduceThreadGroups) noexcept;
+
+    /**
+     * Calculate the work distribution of a segmented sort.
+     * Thread groups are shared out between segments in proportion to their number of keys so that the total
+     * stays close to GPUSORT_MAX_THREAD_GROUPS, empty segments get no thread groups.
+     * @param keyOffsets Index of the first key of each segment.
+     * @param numKeys    Number of keys in each segment (must be the same length as @keyOffsets).
+     * @return The dispatch data.
+     */
+    static Dispatch MakeDispatch(
+        std::vector<uint> const &keyOffsets, std::vector<uint> const &numKeys) noexcept;
+
+    /**
+     * Calculate the maximum sizes of the sum and reduce tables required by a segmented sort.
+     * @param      numSegments     The number of segments.
+     * @param      maxTotalKeys    The maximum number of keys across all segments.
+     * @param [out] sumTableSize    The number of sum table entries.
+     * @param [out] reduceTableSize The number of reduce table entries.
+     */
+    static void GetScratchSize(
+        uint numSegments, uint maxTotalKeys, uint &sumTableSize, uint &reduceTableSize) noexcept;
+
+    /**
+     * Get the number of radix passes needed to sort keys.
+     * @param keyBits The number of low bits of each key that may be set.
+     * @return The number of passes.
+     */
+    static uint GetPassCount(uint keyBits) noexcept;
+
+    /**
+     * Get the number of radix passes used when the key range is derived from the largest key.
+     * The count is rounded up to an even number so that the sorted keys end up back in the source buffer, at
+     * least 2 passes are used as the first pass is always performed to find the key range.
+     * @param maxKeyLow  The largest low word of any key.
+     * @param maxKeyHigh The largest high word of any key (0 for 32bit keys).
+     * @return The number of passes.
+     */
+    static uint GetDerivedPassCount(uint maxKeyLow, uint maxKeyHigh = 0) noexcept;
+
+    /**
+     * Sort keys in each segment using the same steps as the GPU segmented sort.
+     * @param [in,out] keys       The keys to sort.
+     * @param [in,out] payload    (Optional) The payload of each key, null if there is no payload.
+     * @param          keyOffsets Index of the first key of each segment.
+     * @param          numKeys    Number of keys in each segment.
+     * @param          keyBits    The number of low bits of each key that may be set, 0 to derive it from the
+     *  largest key in any segment.
+     * @param          descending True to sort from largest to smallest.
+     */
+    static void Sort(std::vector<uint> &keys, std::vector<uint> *payload, std::vector<uint> const &keyOffsets,
+        std::vector<uint> const &numKeys, uint keyBits = 32, bool descending = false) noexcept;
+
+    /**
+     * Sort 64bit keys in each segment using the same steps as the GPU segmented sort.
+     * @param [in,out] keys       The keys to sort.
+     * @param          keyOffsets Index of the first key of each segment.
+     * @param          numKeys    Number of keys in each segment.
+     * @param          keyBits    The number of low bits of each key that may be set, 0 to derive it from the
+     *  largest key in any segment.
+     * @param          descending True to sort from largest to smallest.
+     */
+    static void Sort(std::vector<uint64_t> &keys, std::vector<uint> const &keyOffsets,
+        std::vector<uint> const &numKeys, uint keyBits = 64, bool descending = false) noexcept;
+
+private:
+    /**
+     * Sort keys stored as 1 or 2 words each, 64bit keys move the word not being sorted as their payload.
+     * @param [in,out] keys       The key words to sort.
+     * @param [in,out] payload    (Optional) The payload of each key, must be null for 64bit keys.
+     * @param          keyWords   The number of words per key (1 or 2).
+     * @param          keyOffsets Index of the first key of each segment.
+     * @param          numKeys    Number of keys in each segment.
+     * @param          passCount  The number of radix passes to perform.
+     * @param          descending True to sort from largest to smallest.
+     */
+    static void SortWords(std::vector<uint> &keys, std::vector<uint> *payload, uint keyWords,
+        std::vector<uint> const &keyOffsets, std::vector<uint> const &numKeys, uint passCount,
+        bool descending) noexcept;
+};
+} // namespace Capsaicin
@@ -0,0 +1,50 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+
+namespace Capsaicin
+{
+/**
+ * CPU reproduction of pcgHash in hash.hlsl.
+ * @param value The value to hash.
+ * @return The hashed value.
+ */
+constexpr uint32_t PcgHash(uint32_t const value) noexcept
+{
+    uint32_t const state = value * 747796405U + 2891336453U;
+    uint32_t const word  = ((state >> ((state >> 28U) + 4U)) ^ state) * 277803737U;
+    return (word >> 22U) ^ word;
+}
+
+/**
+ * CPU reproduction of the per sequence seeds generated by StratifiedSampler and RandomNumberGenerator.
+ * @param index      Index of the sequence (e.g. 1D pixel index).
+ * @param globalSeed The global seed ('stratified_sampler_seed' or 'random_seed').
+ * @return The seed of the sequence.
+ */
+constexpr uint32_t MakeSeed(uint32_t const index, uint32_t const globalSeed) noexcept
+{
+    return PcgHash(index + PcgHash(globalSeed));
+}
+} // namespace Capsaicin
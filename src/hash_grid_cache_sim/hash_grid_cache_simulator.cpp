@@ -0,0 +1,381 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "hash_grid_cache_simulator.h"
+
+#include "hash_grid_cache_resize_policy.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kInvalidId    = 0xFFFFFFFFU; // kGI1_InvalidId
+constexpr float    kStepFactor   = 1e3F;        // HASHGRIDCACHE_STEP_FACTOR
+constexpr float    kSizeFactor   = 1e-3F;       // HASHGRIDCACHE_SIZE_FACTOR
+constexpr uint32_t kHitsPerBlock = 1024;        // queries processed per parallel task
+
+/** Same as 'pcgHash' in 'math/hash.hlsl'. */
+uint32_t PcgHash(uint32_t const value) noexcept
+{
+    uint32_t const state = value * 747796405U + 2891336453U;
+    uint32_t const word  = ((state >> ((state >> 28U) + 4U)) ^ state) * 277803737U;
+    return (word >> 22U) ^ word;
+}
+
+/** Same as 'xxHash' in 'math/hash.hlsl'. */
+uint32_t XxHash(uint32_t const value) noexcept
+{
+    uint32_t ret = value + 374761393U;
+    ret          = 668265263U * ((ret << 17) | (ret >> 15));
+    ret          = 2246822519U * (ret ^ (ret >> 15));
+    ret          = 3266489917U * (ret ^ (ret >> 13));
+    return ret ^ (ret >> 16);
+}
+
+/** Mixes a cell descriptor into 64 bits so that descriptors can be summed into a checksum. */
+uint64_t MixDesc(HashGridCacheSimulator::Desc const &desc) noexcept
+{
+    uint64_t value = (uint64_t {desc.bucket_hash} << 32 | desc.tile_hash)
+                   ^ (uint64_t {desc.cell_offset[0]} << 48 | uint64_t {desc.cell_offset[1]} << 16);
+    // splitmix64 finaliser
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/** Converts a float to uint the way 'asuint(int(x))' does on the GPU, so negative values wrap around. */
+uint32_t AsUint(float const value) noexcept
+{
+    return static_cast<uint32_t>(static_cast<int32_t>(value));
+}
+
+uint32_t GetNumCellsPerTile(uint32_t const tile_cell_ratio) noexcept
+{
+    // Tiles hold 4 mip levels, see GI1::HashGridCache::ensureMemoryIsAllocated()
+    uint32_t num_cells_per_tile = 0;
+    for (uint32_t mip = 0; mip < 4; ++mip)
+    {
+        uint32_t const size_tile_mip = tile_cell_ratio >> mip;
+        num_cells_per_tile += size_tile_mip * size_tile_mip;
+    }
+    return num_cells_per_tile;
+}
+} // namespace
+
+HashGridCacheSimulator::HashGridCacheSimulator(HashGridCacheSimSettings const &settings)
+    : settings_(settings)
+    , num_tiles_per_bucket_(1U << settings.num_tiles_per_bucket)
+    , num_cells_per_tile_(GetNumCellsPerTile(settings.tile_cell_ratio))
+{
+    // Same as the cell size passed by GI1::render() to the hash grid cache constants
+    auto const width  = static_cast<float>(settings.width);
+    auto const height = static_cast<float>(settings.height);
+    cell_size_        = tanf(
+        settings.fov_y * settings.cell_size * std::max(1.0F / height, height / (width * width)));
+    allocate(settings.num_buckets);
+}
+
+HashGridCacheFrameStats HashGridCacheSimulator::simulateFrame(HitFrame const &frame, bool const deterministic)
+{
+    HashGridCacheFrameStats stats;
+    stats.frame_index = frame_index_;
+    stats.hit_count   = static_cast<uint32_t>(frame.hits.size());
+
+    // Purge the tiles that have not been touched for too long, same as the 'PurgeTiles' kernel. The survivors
+    // are compacted in order so that the packed list does not depend on thread scheduling.
+    std::vector<uint8_t> keep(packed_tiles_.size());
+    ParallelFor(0U, static_cast<uint32_t>(packed_tiles_.size()), [&](uint32_t const i) {
+        uint32_t const tile_index = packed_tiles_[i];
+        // Unsigned arithmetic matches the integer wraparound handling of the GPU
+        uint32_t const tile_decay =
+            frame_index_ - decay_tile_buffer_[tile_index].load(std::memory_order_relaxed);
+        if (tile_decay >= kTileDecay)
+        {
+            hash_buffer_[tile_index].store(0, std::memory_order_relaxed);
+        }
+        else
+        {
+            keep[i] = 1;
+        }
+    });
+    std::vector<uint32_t> packed_tiles;
+    packed_tiles.reserve(packed_tiles_.size() + frame.hits.size());
+    for (size_t i = 0; i < packed_tiles_.size(); ++i)
+    {
+        if (keep[i] != 0)
+        {
+            packed_tiles.push_back(packed_tiles_[i]);
+        }
+    }
+    stats.evicted_tiles = static_cast<uint32_t>(packed_tiles_.size() - packed_tiles.size());
+
+    uint32_t const block_count = (stats.hit_count + kHitsPerBlock - 1) / kHitsPerBlock;
+    auto const get_desc = [&](uint32_t const hit) { return getDesc(frame.eye, frame.hits[hit]); };
+
+    // Look up all queries before inserting any so that hits reflect the cache state at the start of the frame
+    std::atomic<uint32_t> cached_count = 0;
+    ParallelFor(0U, block_count, [&](uint32_t const block) {
+        uint32_t const end   = std::min((block + 1) * kHitsPerBlock, stats.hit_count);
+        uint32_t       count = 0;
+        for (uint32_t hit = block * kHitsPerBlock; hit < end; ++hit)
+        {
+            count += findTile(get_desc(hit)) != kInvalidId ? 1 : 0;
+        }
+        cached_count.fetch_add(count, std::memory_order_relaxed);
+    });
+    stats.cached_count = cached_count;
+
+    // Insert all queries, same as 'PopulateScreenProbesHandleHit()'
+    std::vector<uint32_t> new_tiles(frame.hits.size());
+    std::atomic<uint32_t> new_tile_count = 0;
+    std::atomic<uint32_t> touched_count  = 0;
+    std::atomic<uint32_t> overflow_count = 0;
+    std::atomic<uint64_t> checksum       = 0;
+    auto const            insert_block   = [&](uint32_t const block) {
+        uint32_t const end      = std::min((block + 1) * kHitsPerBlock, stats.hit_count);
+        uint32_t       touched  = 0;
+        uint32_t       overflow = 0;
+        uint64_t       sum      = 0;
+        for (uint32_t hit = block * kHitsPerBlock; hit < end; ++hit)
+        {
+            Desc const desc = get_desc(hit);
+            sum += MixDesc(desc);
+            bool           is_new_tile = false;
+            uint32_t const tile_index  = insertTile(desc, is_new_tile);
+            if (tile_index == kInvalidId)
+            {
+                ++overflow;
+                continue;
+            }
+            uint32_t const previous_tile_decay =
+                decay_tile_buffer_[tile_index].exchange(frame_index_, std::memory_order_relaxed);
+            if (is_new_tile)
+            {
+                new_tiles[new_tile_count.fetch_add(1, std::memory_order_relaxed)] = tile_index;
+            }
+            touched += (is_new_tile || previous_tile_decay != frame_index_) ? 1 : 0;
+        }
+        touched_count.fetch_add(touched, std::memory_order_relaxed);
+        overflow_count.fetch_add(overflow, std::memory_order_relaxed);
+        checksum.fetch_add(sum, std::memory_order_relaxed);
+    };
+    if (deterministic)
+    {
+        for (uint32_t block = 0; block < block_count; ++block)
+        {
+            insert_block(block);
+        }
+    }
+    else
+    {
+        ParallelFor(0U, block_count, insert_block);
+    }
+    packed_tiles.insert(packed_tiles.end(), new_tiles.begin(), new_tiles.begin() + new_tile_count);
+    packed_tiles_ = std::move(packed_tiles);
+
+    descriptor_checksum_ += checksum;
+    stats.new_tiles       = new_tile_count;
+    stats.touched_tiles   = touched_count;
+    stats.overflow_count  = overflow_count;
+    stats.live_tiles      = static_cast<uint32_t>(packed_tiles_.size());
+    stats.num_buckets     = num_buckets_;
+    stats.memory_size     = GetMemorySize(settings_, num_buckets_);
+    ++frame_index_;
+    return stats;
+}
+
+uint32_t HashGridCacheSimulator::resize(uint32_t const num_buckets)
+{
+    auto const old_hash_buffer        = std::move(hash_buffer_);
+    auto const old_decay_tile_buffer  = std::move(decay_tile_buffer_);
+    auto const old_bucket_hash_buffer = std::move(bucket_hash_buffer_);
+    auto const live_tiles             = static_cast<uint32_t>(packed_tiles_.size());
+    uint32_t const old_num_tiles      = num_tiles_;
+    allocate(num_buckets);
+
+    // Walk the old table in slot order, same as the 'MigrateTiles' kernel
+    for (uint32_t tile_index = 0; tile_index < old_num_tiles; ++tile_index)
+    {
+        uint32_t const tile_hash = old_hash_buffer[tile_index].load(std::memory_order_relaxed);
+        if (tile_hash == 0)
+        {
+            continue; // free tile
+        }
+        Desc desc {};
+        desc.bucket_hash = old_bucket_hash_buffer[tile_index];
+        desc.tile_hash   = tile_hash;
+        bool           is_new_tile    = false;
+        uint32_t const new_tile_index = insertTile(desc, is_new_tile);
+        if (new_tile_index == kInvalidId || !is_new_tile)
+        {
+            continue; // resized bucket is full or tile already migrated
+        }
+        decay_tile_buffer_[new_tile_index].store(
+            old_decay_tile_buffer[tile_index].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        packed_tiles_.push_back(new_tile_index);
+    }
+    return live_tiles - static_cast<uint32_t>(packed_tiles_.size());
+}
+
+std::vector<uint32_t> HashGridCacheSimulator::getBucketOccupancyHistogram() const
+{
+    std::vector<uint32_t> histogram(num_tiles_per_bucket_ + 1);
+    for (uint32_t bucket_index = 0; bucket_index < (1U << num_buckets_); ++bucket_index)
+    {
+        uint32_t used_tiles = 0;
+        for (uint32_t bucket_offset = 0; bucket_offset < num_tiles_per_bucket_; ++bucket_offset)
+        {
+            uint32_t const tile_index = bucket_offset + bucket_index * num_tiles_per_bucket_;
+            used_tiles += hash_buffer_[tile_index].load(std::memory_order_relaxed) != 0 ? 1 : 0;
+        }
+        ++histogram[used_tiles];
+    }
+    return histogram;
+}
+
+uint64_t HashGridCacheSimulator::GetMemorySize(
+    HashGridCacheSimSettings const &settings, uint32_t const num_buckets) noexcept
+{
+    uint64_t const bytes_per_tile = HashGridCacheResizePolicy::GetBytesPerTile(
+        GetNumCellsPerTile(settings.tile_cell_ratio), settings.use_multibounce);
+    return (bytes_per_tile << settings.num_tiles_per_bucket) << num_buckets;
+}
+
+HashGridCacheSimulator::Desc HashGridCacheSimulator::getDesc(
+    float const eye[3], HitPoint const &hit) const noexcept
+{
+    float const dx       = hit.position[0] - eye[0];
+    float const dy       = hit.position[1] - eye[1];
+    float const dz       = hit.position[2] - eye[2];
+    float const distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    float const cell_size_step      = std::max(distance * cell_size_, settings_.min_cell_size);
+    float const log_step_multiplier = std::floor(std::log2(kStepFactor * cell_size_step));
+    float const hit_cell_size       = kSizeFactor * std::exp2(log_step_multiplier);
+    float const hit_tile_size       = hit_cell_size * static_cast<float>(settings_.tile_cell_ratio);
+
+    uint32_t c[3];
+    uint32_t d[3];
+    float    e[3];
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        float const signed_c = std::floor(hit.position[i] / hit_tile_size);
+        c[i]                 = AsUint(signed_c);
+        d[i]                 = AsUint(std::floor(0.5F + (0.5F * hit.direction[i] + 0.5F) * 4.0F));
+        e[i]                 = std::floor(hit.position[i] / hit_cell_size)
+                - signed_c * static_cast<float>(settings_.tile_cell_ratio);
+    }
+    uint32_t const l = AsUint(log_step_multiplier);
+    uint32_t const t = hit.distance < hit_tile_size ? 1 : 0;
+
+    // Both hashes chain the keys from the innermost 't' out to 'l', same as 'HashGridCache_GetDesc()'
+    uint32_t const keys[7]     = {d[2], d[1], d[0], c[2], c[1], c[0], l};
+    uint32_t       bucket_hash = PcgHash(t);
+    uint32_t       tile_hash   = XxHash(t);
+    for (uint32_t const key : keys)
+    {
+        bucket_hash = PcgHash(key + bucket_hash);
+        tile_hash   = XxHash(key + tile_hash);
+    }
+
+    Desc desc {};
+    desc.bucket_hash = bucket_hash;
+    desc.tile_hash   = std::max(1U, tile_hash);
+
+    // Cells are laid out on the plane most perpendicular to the query direction
+    float const abs_direction[3] = {
+        std::abs(hit.direction[0]), std::abs(hit.direction[1]), std::abs(hit.direction[2])};
+    float const max_direction = std::max(std::max(abs_direction[0], abs_direction[1]), abs_direction[2]);
+    if (abs_direction[0] == max_direction)
+    {
+        desc.cell_offset[0] = static_cast<uint32_t>(e[1]);
+        desc.cell_offset[1] = static_cast<uint32_t>(e[2]);
+    }
+    else if (abs_direction[1] == max_direction)
+    {
+        desc.cell_offset[0] = static_cast<uint32_t>(e[0]);
+        desc.cell_offset[1] = static_cast<uint32_t>(e[2]);
+    }
+    else
+    {
+        desc.cell_offset[0] = static_cast<uint32_t>(e[0]);
+        desc.cell_offset[1] = static_cast<uint32_t>(e[1]);
+    }
+    return desc;
+}
+
+uint32_t HashGridCacheSimulator::findTile(Desc const &desc) const noexcept
+{
+    uint32_t const bucket_index = desc.bucket_hash % (1U << num_buckets_);
+    for (uint32_t bucket_offset = 0; bucket_offset < num_tiles_per_bucket_; ++bucket_offset)
+    {
+        uint32_t const tile_index    = bucket_offset + bucket_index * num_tiles_per_bucket_;
+        uint32_t const previous_hash = hash_buffer_[tile_index].load(std::memory_order_relaxed);
+        if (previous_hash == 0)
+        {
+            return kInvalidId; // no other tile in bucket
+        }
+        if (previous_hash == desc.tile_hash)
+        {
+            return tile_index; // found tile
+        }
+    }
+    return kInvalidId; // not found in bucket
+}
+
+uint32_t HashGridCacheSimulator::insertTile(Desc const &desc, bool &is_new_tile) noexcept
+{
+    is_new_tile                 = false;
+    uint32_t const bucket_index = desc.bucket_hash % (1U << num_buckets_);
+    for (uint32_t bucket_offset = 0; bucket_offset < num_tiles_per_bucket_; ++bucket_offset)
+    {
+        uint32_t const tile_index    = bucket_offset + bucket_index * num_tiles_per_bucket_;
+        uint32_t       previous_hash = 0;
+        if (hash_buffer_[tile_index].compare_exchange_strong(
+                previous_hash, desc.tile_hash, std::memory_order_relaxed))
+        {
+            is_new_tile                     = true;
+            bucket_hash_buffer_[tile_index] = desc.bucket_hash;
+            return tile_index; // inserted new tile
+        }
+        if (previous_hash == desc.tile_hash)
+        {
+            return tile_index; // found existing tile
+        }
+    }
+    return kInvalidId; // too many collisions, out of tiles
+}
+
+void HashGridCacheSimulator::allocate(uint32_t const num_buckets)
+{
+    num_buckets_        = num_buckets;
+    num_tiles_          = num_tiles_per_bucket_ << num_buckets;
+    hash_buffer_        = std::make_unique<std::atomic<uint32_t>[]>(num_tiles_);
+    decay_tile_buffer_  = std::make_unique<std::atomic<uint32_t>[]>(num_tiles_);
+    bucket_hash_buffer_ = std::make_unique<uint32_t[]>(num_tiles_);
+    packed_tiles_.clear();
+}
+} // namespace Capsaicin
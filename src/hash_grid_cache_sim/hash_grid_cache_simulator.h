@@ -0,0 +1,166 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "hit_stream.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Capsaicin
+{
+/** Simulated cache layout, these mirror the matching 'gi1_hash_grid_cache_*' render options. */
+struct HashGridCacheSimSettings
+{
+    float    cell_size            = 32.0F; /**< gi1_hash_grid_cache_cell_size */
+    float    min_cell_size        = 1e-1F; /**< gi1_hash_grid_cache_min_cell_size */
+    uint32_t tile_cell_ratio      = 8;     /**< gi1_hash_grid_cache_tile_cell_ratio */
+    uint32_t num_buckets          = 14;    /**< gi1_hash_grid_cache_num_buckets (log2) */
+    uint32_t num_tiles_per_bucket = 4;     /**< gi1_hash_grid_cache_num_tiles_per_bucket (log2) */
+    bool     use_multibounce      = true;  /**< gi1_use_multibounce, only affects the memory footprint */
+    float    fov_y                = 1.5707964F; /**< Camera vertical field of view (radians) */
+    uint32_t width                = 1920;       /**< Render width */
+    uint32_t height               = 1080;       /**< Render height */
+};
+
+/** Statistics gathered over a single simulated frame. */
+struct HashGridCacheFrameStats
+{
+    uint32_t frame_index    = 0;
+    uint32_t hit_count      = 0; /**< Number of queries */
+    uint32_t cached_count   = 0; /**< Queries whose tile was already cached at the start of the frame */
+    uint32_t overflow_count = 0; /**< Queries dropped as their bucket was full */
+    uint32_t live_tiles     = 0; /**< Tiles in use at the end of the frame */
+    uint32_t new_tiles      = 0; /**< Tiles allocated this frame */
+    uint32_t evicted_tiles  = 0; /**< Tiles evicted this frame */
+    uint32_t touched_tiles  = 0; /**< Tiles that were queried this frame */
+    uint32_t num_buckets    = 0; /**< Bucket count (log2) */
+    uint64_t memory_size    = 0; /**< Memory used by the cache buffers (bytes) */
+};
+
+/**
+ * CPU port of the GI1 hash grid cache (see 'hash_grid_cache.hlsl' and the 'PurgeTiles' kernel).
+ * Cells are addressed, inserted and evicted exactly as on the GPU, including the lock-free bucket probing
+ * which runs on all available hardware threads. Only the tile bookkeeping is simulated, no radiance is
+ * stored.
+ */
+class HashGridCacheSimulator
+{
+public:
+    /** Frames before an unused tile is evicted, matches 'kHashGridCache_TileDecay'. */
+    static constexpr uint32_t kTileDecay = 50;
+
+    explicit HashGridCacheSimulator(HashGridCacheSimSettings const &settings);
+
+    /**
+     * Runs a frame: purges the decayed tiles, looks up then inserts all the queries.
+     * @param frame         The queries of the frame.
+     * @param deterministic True to insert the queries serially in stream order, so that bucket slots (and
+     *  therefore overflows) are identical from one run to the next.
+     * @return The frame statistics.
+     */
+    HashGridCacheFrameStats simulateFrame(HitFrame const &frame, bool deterministic);
+
+    /**
+     * Rehashes all live tiles into a table with a different bucket count, tiles that no longer fit their
+     * bucket are dropped. Matches the 'MigrateTiles' kernel but completes immediately.
+     * @param num_buckets The new bucket count (log2).
+     * @return The number of dropped tiles.
+     */
+    uint32_t resize(uint32_t num_buckets);
+
+    /**
+     * Gets the number of buckets for each possible occupancy.
+     * @return The histogram, indexed by the number of used tiles in a bucket.
+     */
+    [[nodiscard]] std::vector<uint32_t> getBucketOccupancyHistogram() const;
+
+    /**
+     * Gets a checksum of the cell descriptors of all queries seen so far.
+     * It is independent of the query order so can be used to detect any change to the hashing.
+     */
+    [[nodiscard]] uint64_t getDescriptorChecksum() const noexcept { return descriptor_checksum_; }
+
+    [[nodiscard]] uint32_t getNumBuckets() const noexcept { return num_buckets_; }
+
+    [[nodiscard]] uint32_t getNumTilesPerBucket() const noexcept { return num_tiles_per_bucket_; }
+
+    [[nodiscard]] uint32_t getNumCellsPerTile() const noexcept { return num_cells_per_tile_; }
+
+    /**
+     * Gets the memory used by the GPU buffers whose size depends on the table size.
+     * @param settings    The simulated cache layout.
+     * @param num_buckets The bucket count (log2).
+     * @return The size in bytes.
+     */
+    [[nodiscard]] static uint64_t GetMemorySize(
+        HashGridCacheSimSettings const &settings, uint32_t num_buckets) noexcept;
+
+    /** Cell descriptor, matches 'HashGridCache_Desc'. */
+    struct Desc
+    {
+        uint32_t bucket_hash;
+        uint32_t tile_hash;
+        uint32_t cell_offset[2];
+    };
+
+    /**
+     * Gets the descriptor of the cell for a given query, matches 'HashGridCache_GetDesc'.
+     * @param eye The camera position.
+     * @param hit The query.
+     * @return The cell descriptor.
+     */
+    [[nodiscard]] Desc getDesc(float const eye[3], HitPoint const &hit) const noexcept;
+
+    /**
+     * Finds the tile holding a cell, matches 'HashGridCache_FindCell'.
+     * @param desc The cell descriptor.
+     * @return The tile index, UINT32_MAX if not found.
+     */
+    [[nodiscard]] uint32_t findTile(Desc const &desc) const noexcept;
+
+    /**
+     * Inserts the tile holding a cell, matches 'HashGridCache_InsertCell'.
+     * @param      desc        The cell descriptor.
+     * @param [out] is_new_tile True if the tile was allocated by this call.
+     * @return The tile index, UINT32_MAX if the bucket was full.
+     */
+    uint32_t insertTile(Desc const &desc, bool &is_new_tile) noexcept;
+
+private:
+    void allocate(uint32_t num_buckets);
+
+    HashGridCacheSimSettings settings_;
+    float                    cell_size_            = 0.0F; // as computed by GI1 from the camera
+    uint32_t                 num_buckets_          = 0;    // log2
+    uint32_t                 num_tiles_per_bucket_ = 0;
+    uint32_t                 num_tiles_            = 0;
+    uint32_t                 num_cells_per_tile_   = 0;
+    uint32_t                 frame_index_          = 0;
+    uint64_t                 descriptor_checksum_  = 0;
+
+    std::unique_ptr<std::atomic<uint32_t>[]> hash_buffer_;
+    std::unique_ptr<std::atomic<uint32_t>[]> decay_tile_buffer_;
+    std::unique_ptr<uint32_t[]>              bucket_hash_buffer_;
+    std::vector<uint32_t>                    packed_tiles_; // tiles alive at the end of the last frame
+};
+} // namespace Capsaicin
@@ -0,0 +1,276 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "hit_stream.h"
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace Capsaicin
+{
+namespace
+{
+constexpr uint32_t kHitStreamMagic   = 0x53434748U; // 'HGCS'
+constexpr uint32_t kHitStreamVersion = 1;
+
+struct Vector
+{
+    float x;
+    float y;
+    float z;
+};
+
+Vector operator+(Vector const &a, Vector const &b) noexcept
+{
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+Vector operator-(Vector const &a, Vector const &b) noexcept
+{
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+Vector operator*(Vector const &a, float const b) noexcept
+{
+    return {a.x * b, a.y * b, a.z * b};
+}
+
+float Dot(Vector const &a, Vector const &b) noexcept
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Vector Cross(Vector const &a, Vector const &b) noexcept
+{
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+Vector Normalize(Vector const &a) noexcept
+{
+    return a * (1.0F / std::sqrt(Dot(a, a)));
+}
+
+/** Same as 'pcgHash' in 'math/hash.hlsl'. */
+uint32_t PcgHash(uint32_t const value) noexcept
+{
+    uint32_t const state = value * 747796405U + 2891336453U;
+    uint32_t const word  = ((state >> ((state >> 28U) + 4U)) ^ state) * 277803737U;
+    return (word >> 22U) ^ word;
+}
+
+/** Per ray random number generator, avoids any shared state between threads. */
+class Random
+{
+public:
+    explicit Random(uint32_t const seed) noexcept
+        : state_(PcgHash(seed))
+    {}
+
+    float next() noexcept
+    {
+        state_ = PcgHash(state_);
+        return static_cast<float>(state_ >> 8) * 0x1.0p-24F;
+    }
+
+private:
+    uint32_t state_;
+};
+
+struct Sphere
+{
+    Vector centre;
+    float  radius;
+};
+
+constexpr Vector kRoomMin = {-10.0F, 0.0F, -10.0F};
+constexpr Vector kRoomMax = {10.0F, 6.0F, 10.0F};
+constexpr Sphere kSpheres[] = {
+    {{3.0F, 1.0F, 2.0F}, 1.0F},
+    {{-4.0F, 2.0F, -3.0F}, 2.0F},
+    {{-1.0F, 0.5F, 5.0F}, 0.5F},
+    {{6.0F, 3.0F, -6.0F}, 1.5F},
+};
+
+/**
+ * Traces a ray against the room and spheres.
+ * @param      origin    The ray origin, must be inside the room.
+ * @param      direction The normalised ray direction.
+ * @param [out] normal    The surface normal at the hit.
+ * @return The hit distance, the room being closed a ray always hits something.
+ */
+float Trace(Vector const &origin, Vector const &direction, Vector &normal) noexcept
+{
+    // Exit distance out of the room box
+    float distance = std::numeric_limits<float>::max();
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+        float const o = (&origin.x)[axis];
+        float const d = (&direction.x)[axis];
+        if (d == 0.0F)
+        {
+            continue;
+        }
+        float const plane = d > 0.0F ? (&kRoomMax.x)[axis] : (&kRoomMin.x)[axis];
+        if (float const t = (plane - o) / d; t < distance)
+        {
+            distance          = t;
+            normal            = {0.0F, 0.0F, 0.0F};
+            (&normal.x)[axis] = d > 0.0F ? -1.0F : 1.0F;
+        }
+    }
+    for (auto const &sphere : kSpheres)
+    {
+        Vector const oc   = origin - sphere.centre;
+        float const  b    = Dot(oc, direction);
+        float const  c    = Dot(oc, oc) - sphere.radius * sphere.radius;
+        float const  disc = b * b - c;
+        if (disc < 0.0F)
+        {
+            continue;
+        }
+        if (float const t = -b - std::sqrt(disc); t > 1e-4F && t < distance)
+        {
+            distance = t;
+            normal   = Normalize(origin + direction * t - sphere.centre);
+        }
+    }
+    return std::max(distance, 0.0F);
+}
+} // namespace
+
+bool HitStreamReader::open(std::filesystem::path const &filePath, std::string &error) noexcept
+{
+    file_.open(filePath, std::ios::in | std::ios::binary);
+    if (!file_.is_open())
+    {
+        error = "Failed to open file";
+        return false;
+    }
+    uint32_t header[2] = {};
+    if (!file_.read(reinterpret_cast<char *>(header), sizeof(header)) || header[0] != kHitStreamMagic)
+    {
+        error = "Not a hit stream";
+        return false;
+    }
+    if (header[1] != kHitStreamVersion)
+    {
+        error = "Unsupported hit stream version " + std::to_string(header[1]);
+        return false;
+    }
+    return true;
+}
+
+bool HitStreamReader::readFrame(HitFrame &frame) noexcept
+{
+    uint32_t hitCount = 0;
+    if (!file_.read(reinterpret_cast<char *>(frame.eye), sizeof(frame.eye))
+        || !file_.read(reinterpret_cast<char *>(&hitCount), sizeof(hitCount)))
+    {
+        return false;
+    }
+    frame.hits.resize(hitCount);
+    return !!file_.read(reinterpret_cast<char *>(frame.hits.data()),
+        static_cast<std::streamsize>(hitCount * sizeof(HitPoint)));
+}
+
+bool HitStreamWriter::open(std::filesystem::path const &filePath) noexcept
+{
+    file_.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    uint32_t const header[2] = {kHitStreamMagic, kHitStreamVersion};
+    return file_.is_open() && !!file_.write(reinterpret_cast<char const *>(header), sizeof(header));
+}
+
+bool HitStreamWriter::writeFrame(HitFrame const &frame) noexcept
+{
+    auto const hitCount = static_cast<uint32_t>(frame.hits.size());
+    file_.write(reinterpret_cast<char const *>(frame.eye), sizeof(frame.eye));
+    file_.write(reinterpret_cast<char const *>(&hitCount), sizeof(hitCount));
+    file_.write(reinterpret_cast<char const *>(frame.hits.data()),
+        static_cast<std::streamsize>(hitCount * sizeof(HitPoint)));
+    return !!file_;
+}
+
+void GenerateSyntheticFrame(
+    SyntheticStreamSettings const &settings, uint32_t const frameIndex, HitFrame &frame) noexcept
+{
+    // Camera circles the room centre while looking slightly ahead of its path
+    float const  angle   = static_cast<float>(frameIndex) * settings.camera_speed / 5.0F;
+    Vector const eye     = {5.0F * std::cos(angle), 1.7F, 5.0F * std::sin(angle)};
+    Vector const forward = Normalize({-std::sin(angle + 0.5F), -0.1F, std::cos(angle + 0.5F)});
+    Vector const right   = Normalize(Cross(forward, {0.0F, 1.0F, 0.0F}));
+    Vector const up      = Cross(right, forward);
+    float const  tanY    = std::tan(0.5F * settings.fov_y);
+    float const  tanX    = tanY * settings.aspect;
+
+    frame.eye[0] = eye.x;
+    frame.eye[1] = eye.y;
+    frame.eye[2] = eye.z;
+    frame.hits.resize(settings.ray_count);
+
+    // Rays are generated in blocks to amortise the scheduling cost
+    constexpr uint32_t blockSize  = 1024;
+    uint32_t const     blockCount = (settings.ray_count + blockSize - 1) / blockSize;
+    uint32_t const     frameSeed  = PcgHash(settings.seed ^ PcgHash(frameIndex));
+    ParallelFor(0U, blockCount, [&](uint32_t const block) {
+        uint32_t const end = std::min((block + 1) * blockSize, settings.ray_count);
+        for (uint32_t ray = block * blockSize; ray < end; ++ray)
+        {
+            Random random(frameSeed + ray);
+
+            // Primary ray through a random pixel
+            float const  u       = 2.0F * random.next() - 1.0F;
+            float const  v       = 2.0F * random.next() - 1.0F;
+            Vector const primary = Normalize(forward + right * (u * tanX) + up * (v * tanY));
+            Vector       normal {};
+            float const  primaryDistance = Trace(eye, primary, normal);
+            Vector const origin          = eye + primary * primaryDistance + normal * 1e-3F;
+
+            // Cosine distributed probe ray over the surface hemisphere
+            float const  r1        = 2.0F * std::numbers::pi_v<float> * random.next();
+            float const  r2        = random.next();
+            float const  sinTheta  = std::sqrt(r2);
+            Vector const tangent   = Normalize(Cross(
+                normal, std::abs(normal.x) > 0.5F ? Vector {0.0F, 1.0F, 0.0F} : Vector {1.0F, 0.0F, 0.0F}));
+            Vector const bitangent = Cross(normal, tangent);
+            Vector const direction = Normalize(tangent * (sinTheta * std::cos(r1))
+                                               + bitangent * (sinTheta * std::sin(r1))
+                                               + normal * std::sqrt(1.0F - r2));
+            Vector       probeNormal {};
+            float const  distance = Trace(origin, direction, probeNormal);
+            Vector const position = origin + direction * distance;
+
+            HitPoint &hit    = frame.hits[ray];
+            hit.position[0]  = position.x;
+            hit.position[1]  = position.y;
+            hit.position[2]  = position.z;
+            hit.direction[0] = direction.x;
+            hit.direction[1] = direction.y;
+            hit.direction[2] = direction.z;
+            hit.distance     = distance;
+        }
+    });
+}
+} // namespace Capsaicin
@@ -0,0 +1,119 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Capsaicin
+{
+/** A single hash grid cache query, matches 'HashGridCache_Data' as filled in by GI1. */
+struct HitPoint
+{
+    float position[3];  /**< World space hit position */
+    float direction[3]; /**< Direction of the ray that produced the hit */
+    float distance;     /**< Distance along the ray to the hit */
+};
+
+/** All the hash grid cache queries issued during a single frame. */
+struct HitFrame
+{
+    float                 eye[3] = {0.0F, 0.0F, 0.0F}; /**< Camera position */
+    std::vector<HitPoint> hits;
+};
+
+/**
+ * Reads a recorded hit stream.
+ * A stream starts with the 'HGCS' magic and a version number, followed by the frames. Each frame stores the
+ * camera position (3 floats), the number of hits (uint32) then the tightly packed 'HitPoint' values, all in
+ * little endian order.
+ */
+class HitStreamReader
+{
+public:
+    /**
+     * Opens a stream and checks its header.
+     * @param      filePath The stream file.
+     * @param [out] error    The reason for the failure if any.
+     * @return True if successful.
+     */
+    bool open(std::filesystem::path const &filePath, std::string &error) noexcept;
+
+    /**
+     * Reads the next frame.
+     * @param [out] frame The frame read.
+     * @return False once the end of the stream is reached or if the stream is corrupted.
+     */
+    bool readFrame(HitFrame &frame) noexcept;
+
+private:
+    std::ifstream file_;
+};
+
+/** Writes a hit stream, see 'HitStreamReader' for the file layout. */
+class HitStreamWriter
+{
+public:
+    /**
+     * Creates a stream and writes its header.
+     * @param filePath The stream file.
+     * @return True if successful.
+     */
+    bool open(std::filesystem::path const &filePath) noexcept;
+
+    /**
+     * Appends a frame.
+     * @param frame The frame to write.
+     * @return True if successful.
+     */
+    bool writeFrame(HitFrame const &frame) noexcept;
+
+private:
+    std::ofstream file_;
+};
+
+/** Synthetic scene used when no recorded stream is available. */
+struct SyntheticStreamSettings
+{
+    uint32_t ray_count    = 131072;     /**< Cache queries per frame */
+    uint32_t seed         = 0;          /**< Random seed */
+    float    fov_y        = 1.5707964F; /**< Camera vertical field of view (radians) */
+    float    aspect       = 16.0F / 9.0F;
+    float    camera_speed = 0.05F; /**< Distance moved by the camera each frame (m) */
+};
+
+/**
+ * Generates a frame of synthetic hits.
+ * The scene is a closed 20m x 6m x 20m room holding a few spheres, with the camera circling its centre. Each
+ * query mimics a GI1 screen probe: a primary ray is traced through a random pixel and a probe ray is then
+ * traced over the hemisphere of the visible surface, its hit being the query. Frames only depend on the
+ * settings and frame index so may be generated in any order.
+ * @param      settings    The scene settings.
+ * @param      frameIndex  The frame to generate.
+ * @param [out] frame       The generated frame.
+ */
+void GenerateSyntheticFrame(
+    SyntheticStreamSettings const &settings, uint32_t frameIndex, HitFrame &frame) noexcept;
+} // namespace Capsaicin
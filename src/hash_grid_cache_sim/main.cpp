@@ -0,0 +1,277 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "hash_grid_cache_resize_policy.h"
+#include "hash_grid_cache_simulator.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+/** Statistics accumulated over all simulated frames. */
+struct SimulationSummary
+{
+    uint32_t frame_count        = 0;
+    uint64_t hit_count          = 0;
+    uint64_t cached_count       = 0;
+    uint64_t overflow_count     = 0;
+    uint64_t new_tiles          = 0;
+    uint64_t evicted_tiles      = 0;
+    uint64_t live_tiles         = 0;
+    uint32_t peak_live_tiles    = 0;
+    uint32_t peak_overflow      = 0;
+    uint64_t peak_memory_size   = 0;
+    uint32_t resize_count       = 0;
+    uint64_t migration_overflow = 0; /**< Tiles dropped while resizing, includes stale duplicate tiles */
+
+    void add(HashGridCacheFrameStats const &stats) noexcept
+    {
+        ++frame_count;
+        hit_count        += stats.hit_count;
+        cached_count     += stats.cached_count;
+        overflow_count   += stats.overflow_count;
+        new_tiles        += stats.new_tiles;
+        evicted_tiles    += stats.evicted_tiles;
+        live_tiles       += stats.live_tiles;
+        peak_live_tiles   = max(peak_live_tiles, stats.live_tiles);
+        peak_overflow     = max(peak_overflow, stats.overflow_count);
+        peak_memory_size  = max(peak_memory_size, stats.memory_size);
+    }
+};
+
+double ToMiB(uint64_t const bytes) noexcept
+{
+    return static_cast<double>(bytes) / static_cast<double>(1 << 20);
+}
+
+double Ratio(uint64_t const numerator, uint64_t const denominator) noexcept
+{
+    return denominator > 0 ? static_cast<double>(numerator) / static_cast<double>(denominator) : 0.0;
+}
+
+void PrintSummary(SimulationSummary const &summary, HashGridCacheSimulator const &simulator,
+    HashGridCacheSimSettings const &settings)
+{
+    uint32_t const tiles_per_bucket = simulator.getNumTilesPerBucket();
+    uint64_t const num_tiles        = uint64_t {tiles_per_bucket} << simulator.getNumBuckets();
+    double const   frames           = max(summary.frame_count, 1U);
+    cout << setprecision(4) << fixed;
+    cout << "Frames                 : " << summary.frame_count << '\n';
+    cout << "Buckets                : 2^" << simulator.getNumBuckets() << " x " << tiles_per_bucket
+         << " tiles x " << simulator.getNumCellsPerTile() << " cells\n";
+    cout << "Memory                 : "
+         << ToMiB(HashGridCacheSimulator::GetMemorySize(settings, simulator.getNumBuckets())) << " MiB (peak "
+         << ToMiB(summary.peak_memory_size) << " MiB)\n";
+    cout << "Queries per frame      : " << static_cast<double>(summary.hit_count) / frames << '\n';
+    cout << "Cache hit rate         : " << Ratio(summary.cached_count, summary.hit_count) << '\n';
+    cout << "Overflow rate          : " << Ratio(summary.overflow_count, summary.hit_count) << " (peak "
+         << summary.peak_overflow << " per frame)\n";
+    cout << "Live tiles             : " << static_cast<double>(summary.live_tiles) / frames << " average, "
+         << summary.peak_live_tiles << " peak\n";
+    cout << "Load factor            : " << Ratio(summary.live_tiles, num_tiles * summary.frame_count)
+         << " average, " << Ratio(summary.peak_live_tiles, num_tiles) << " peak\n";
+    cout << "Churn per frame        : " << static_cast<double>(summary.new_tiles) / frames << " new, "
+         << static_cast<double>(summary.evicted_tiles) / frames << " evicted\n";
+    if (summary.resize_count > 0)
+    {
+        cout << "Resizes                : " << summary.resize_count << " (" << summary.migration_overflow
+             << " tiles dropped, including stale duplicates)\n";
+    }
+    cout << "Bucket occupancy       :";
+    for (uint32_t const count : simulator.getBucketOccupancyHistogram())
+    {
+        cout << ' ' << count;
+    }
+    cout << '\n';
+    cout << "Descriptor checksum    : " << hex << setw(16) << setfill('0')
+         << simulator.getDescriptorChecksum() << dec << '\n';
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app("Capsaicin hash grid cache simulator: replays GI1 radiance cache queries on the CPU");
+
+    HashGridCacheSimSettings settings;
+    app.add_option("--cell-size", settings.cell_size, "gi1_hash_grid_cache_cell_size")
+        ->capture_default_str();
+    app.add_option("--min-cell-size", settings.min_cell_size, "gi1_hash_grid_cache_min_cell_size")
+        ->capture_default_str();
+    app.add_option("--tile-cell-ratio", settings.tile_cell_ratio, "gi1_hash_grid_cache_tile_cell_ratio")
+        ->capture_default_str()
+        ->check(CLI::IsMember({8, 16}));
+    app.add_option("--num-buckets", settings.num_buckets, "gi1_hash_grid_cache_num_buckets (log2)")
+        ->capture_default_str()
+        ->check(
+            CLI::Range(HashGridCacheResizePolicy::kMinNumBuckets, HashGridCacheResizePolicy::kMaxNumBuckets));
+    app.add_option("--num-tiles-per-bucket", settings.num_tiles_per_bucket,
+           "gi1_hash_grid_cache_num_tiles_per_bucket (log2)")
+        ->capture_default_str()
+        ->check(CLI::Range(0, 8));
+    app.add_option("--multibounce", settings.use_multibounce, "gi1_use_multibounce (only affects memory)")
+        ->capture_default_str();
+    float fov = 90.0F;
+    app.add_option("--fov", fov, "Camera vertical field of view (degrees)")->capture_default_str();
+    app.add_option("--width", settings.width, "Render width")->capture_default_str();
+    app.add_option("--height", settings.height, "Render height")->capture_default_str();
+
+    string inputPath;
+    app.add_option("-i,--input", inputPath, "Recorded hit stream (Default: generate a synthetic stream)")
+        ->check(CLI::ExistingFile);
+    uint32_t frameCount = 600;
+    app.add_option("--frames", frameCount, "Maximum number of frames to simulate")->capture_default_str();
+    SyntheticStreamSettings synthetic;
+    app.add_option("--rays", synthetic.ray_count, "Queries per frame of the synthetic stream")
+        ->capture_default_str();
+    app.add_option("--seed", synthetic.seed, "Random seed of the synthetic stream")->capture_default_str();
+    string streamPath;
+    app.add_option("--save-stream", streamPath, "Save the simulated hit stream to a file");
+    string outputPath;
+    app.add_option("-o,--output", outputPath, "Output per-frame statistics CSV file");
+    bool deterministic = false;
+    app.add_flag("--deterministic", deterministic,
+        "Insert queries serially so that results are reproducible from one run to the next");
+
+    bool     adaptive  = false;
+    uint32_t minMemory = 256;
+    uint32_t maxMemory = 2048;
+    app.add_flag("--adaptive", adaptive, "gi1_hash_grid_cache_adaptive");
+    app.add_option("--adaptive-min-memory", minMemory, "gi1_hash_grid_cache_adaptive_min_memory (MiB)")
+        ->capture_default_str();
+    app.add_option("--adaptive-max-memory", maxMemory, "gi1_hash_grid_cache_adaptive_max_memory (MiB)")
+        ->capture_default_str();
+
+    CLI11_PARSE(app, argc, argv);
+
+    try
+    {
+        settings.fov_y   = fov * numbers::pi_v<float> / 180.0F;
+        synthetic.fov_y  = settings.fov_y;
+        synthetic.aspect = static_cast<float>(settings.width) / static_cast<float>(settings.height);
+
+        HitStreamReader reader;
+        if (!inputPath.empty())
+        {
+            if (string error; !reader.open(inputPath, error))
+            {
+                cerr << "Failed to open '" << inputPath << "': " << error << '\n';
+                return 1;
+            }
+        }
+        HitStreamWriter writer;
+        if (!streamPath.empty() && !writer.open(streamPath))
+        {
+            cerr << "Failed to open output stream '" << streamPath << "'\n";
+            return 1;
+        }
+        ofstream outputFile;
+        if (!outputPath.empty())
+        {
+            outputFile.open(outputPath, ios::out | ios::trunc);
+            if (!outputFile.is_open())
+            {
+                cerr << "Failed to open output file '" << outputPath << "'\n";
+                return 1;
+            }
+            outputFile << "Frame,Hits,CachedHits,LiveTiles,LoadFactor,NewTiles,EvictedTiles,TouchedTiles,"
+                          "OverflowCount,NumBuckets,MemoryMB\n";
+        }
+
+        // The resize policy is the one used by GI1, however resizing completes immediately here whereas the
+        // GPU sees statistics a couple of frames late and migrates the table over several frames
+        HashGridCacheResizePolicy           policy;
+        HashGridCacheResizePolicy::Settings policySettings;
+        if (adaptive)
+        {
+            auto const [minNumBuckets, maxNumBuckets] = HashGridCacheResizePolicy::GetBucketRange(
+                HashGridCacheSimulator::GetMemorySize(settings, 0), uint64_t {minMemory} << 20,
+                uint64_t {maxMemory} << 20);
+            policySettings.min_num_buckets = minNumBuckets;
+            policySettings.max_num_buckets = maxNumBuckets;
+            settings.num_buckets           = clamp(settings.num_buckets, minNumBuckets, maxNumBuckets);
+            policy.reset(settings.num_buckets, settings.num_tiles_per_bucket);
+        }
+
+        HashGridCacheSimulator simulator(settings);
+        SimulationSummary      summary;
+        HitFrame               frame;
+        for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+        {
+            if (!inputPath.empty())
+            {
+                if (!reader.readFrame(frame))
+                {
+                    break;
+                }
+            }
+            else
+            {
+                GenerateSyntheticFrame(synthetic, frameIndex, frame);
+            }
+            if (!streamPath.empty() && !writer.writeFrame(frame))
+            {
+                cerr << "Failed to write output stream '" << streamPath << "'\n";
+                return 1;
+            }
+
+            HashGridCacheFrameStats const stats = simulator.simulateFrame(frame, deterministic);
+            summary.add(stats);
+            if (outputFile.is_open())
+            {
+                double const loadFactor = Ratio(stats.live_tiles,
+                    uint64_t {simulator.getNumTilesPerBucket()} << stats.num_buckets);
+                outputFile << stats.frame_index << ',' << stats.hit_count << ',' << stats.cached_count << ','
+                           << stats.live_tiles << ',' << setprecision(6) << loadFactor << ','
+                           << stats.new_tiles << ',' << stats.evicted_tiles << ',' << stats.touched_tiles
+                           << ',' << stats.overflow_count << ',' << stats.num_buckets << ','
+                           << ToMiB(stats.memory_size) << '\n';
+            }
+
+            if (adaptive)
+            {
+                if (uint32_t const numBuckets =
+                        policy.update(policySettings, stats.live_tiles, stats.overflow_count);
+                    numBuckets != policy.getNumBuckets())
+                {
+                    summary.migration_overflow += simulator.resize(numBuckets);
+                    policy.resize(policySettings, numBuckets);
+                    ++summary.resize_count;
+                }
+            }
+        }
+        PrintSummary(summary, simulator, settings);
+    }
+    catch (exception const &e)
+    {
+        cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,373 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "image_comparer.h"
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <exception>
+
+namespace
+{
+/** Number of independent accumulators used by the row kernels, allows the compiler to vectorise the loops. */
+constexpr uint32_t kLaneCount = 8;
+
+/** Radius of the SSIM Gaussian window (11x11 window with sigma=1.5). */
+constexpr int32_t kSSIMRadius = 5;
+
+/** Separable 1D Gaussian weights for the SSIM window, the outer product matches the 2D weights on the GPU. */
+std::array<float, 2 * kSSIMRadius + 1> const kSSIMWeights = [] {
+    std::array<float, 2 * kSSIMRadius + 1> weights = {};
+    double                                 total   = 0.0;
+    for (int32_t i = -kSSIMRadius; i <= kSSIMRadius; ++i)
+    {
+        total += exp(-static_cast<double>(i * i) / (2.0 * 1.5 * 1.5));
+    }
+    for (int32_t i = -kSSIMRadius; i <= kSSIMRadius; ++i)
+    {
+        weights[static_cast<size_t>(i + kSSIMRadius)] =
+            static_cast<float>(exp(-static_cast<double>(i * i) / (2.0 * 1.5 * 1.5)) / total);
+    }
+    return weights;
+}();
+
+/**
+ * Sum the per-pixel squared error, RMAE and SMAPE terms over a row.
+ * @note Matches the per-pixel calculations in 'gpu_image_metrics.comp'.
+ */
+std::array<double, 3> SumRowErrors(float const *source, float const *reference, uint32_t const count) noexcept
+{
+    std::array<float, kLaneCount> squaredError = {};
+    std::array<float, kLaneCount> rmae         = {};
+    std::array<float, kLaneCount> smape        = {};
+
+    auto const accumulate = [&](uint32_t const lane, float const input, float const ref) {
+        float const difference = ref - input;
+        float const absolute   = std::abs(difference);
+        float const divisor    = (std::abs(ref) + std::abs(input)) * 0.5F;
+
+        squaredError[lane] += difference * difference;
+        rmae[lane]         += ref != 0.0F ? absolute / ref : 0.0F;
+        smape[lane]        += divisor != 0.0F ? absolute / divisor : 0.0F;
+    };
+    uint32_t pixel = 0;
+    for (; pixel + kLaneCount <= count; pixel += kLaneCount)
+    {
+        for (uint32_t lane = 0; lane < kLaneCount; ++lane)
+        {
+            accumulate(lane, source[pixel + lane], reference[pixel + lane]);
+        }
+    }
+    for (uint32_t lane = 0; pixel < count; ++pixel, ++lane)
+    {
+        accumulate(lane, source[pixel], reference[pixel]);
+    }
+    std::array<double, 3> sums = {};
+    for (uint32_t lane = 0; lane < kLaneCount; ++lane)
+    {
+        sums[0] += static_cast<double>(squaredError[lane]);
+        sums[1] += static_cast<double>(rmae[lane]);
+        sums[2] += static_cast<double>(smape[lane]);
+    }
+    return sums;
+}
+
+/**
+ * Sum a row of values.
+ * @note Values are summed into separate lanes so that the loop can be vectorised.
+ */
+double SumRow(float const *values, uint32_t const count) noexcept
+{
+    std::array<float, kLaneCount> lanes = {};
+    uint32_t                      pixel = 0;
+    for (; pixel + kLaneCount <= count; pixel += kLaneCount)
+    {
+        for (uint32_t lane = 0; lane < kLaneCount; ++lane)
+        {
+            lanes[lane] += values[pixel + lane];
+        }
+    }
+    double sum = 0.0;
+    for (; pixel < count; ++pixel)
+    {
+        sum += static_cast<double>(values[pixel]);
+    }
+    for (float const lane : lanes)
+    {
+        sum += static_cast<double>(lane);
+    }
+    return sum;
+}
+
+/**
+ * Horizontally filter a row using the SSIM Gaussian window.
+ * Samples outside the image are skipped without renormalising the weights, the same as the GPU window.
+ */
+void FilterRow(float const *values, float *output, uint32_t const width) noexcept
+{
+    auto const filterClamped = [&](uint32_t const x) {
+        float value = 0.0F;
+        for (int32_t i = -kSSIMRadius; i <= kSSIMRadius; ++i)
+        {
+            int32_t const sample = static_cast<int32_t>(x) + i;
+            if (sample >= 0 && sample < static_cast<int32_t>(width))
+            {
+                value += values[sample] * kSSIMWeights[static_cast<size_t>(i + kSSIMRadius)];
+            }
+        }
+        output[x] = value;
+    };
+    uint32_t const border    = std::min(static_cast<uint32_t>(kSSIMRadius), width);
+    uint32_t const endBorder = std::max(border, width - border);
+    for (uint32_t x = 0; x < border; ++x)
+    {
+        filterClamped(x);
+    }
+    for (uint32_t x = border; x < endBorder; ++x)
+    {
+        float value = 0.0F;
+        for (int32_t i = -kSSIMRadius; i <= kSSIMRadius; ++i)
+        {
+            value += values[x + i] * kSSIMWeights[static_cast<size_t>(i + kSSIMRadius)];
+        }
+        output[x] = value;
+    }
+    for (uint32_t x = endBorder; x < width; ++x)
+    {
+        filterClamped(x);
+    }
+}
+
+/**
+ * Sum of the SSIM Gaussian weights that fall inside the image at a position.
+ * @param position The pixel coordinate.
+ * @param size     The image dimension.
+ */
+float WindowWeight(uint32_t const position, uint32_t const size) noexcept
+{
+    float weight = 0.0F;
+    for (int32_t i = -kSSIMRadius; i <= kSSIMRadius; ++i)
+    {
+        int32_t const sample = static_cast<int32_t>(position) + i;
+        if (sample >= 0 && sample < static_cast<int32_t>(size))
+        {
+            weight += kSSIMWeights[static_cast<size_t>(i + kSSIMRadius)];
+        }
+    }
+    return weight;
+}
+
+/**
+ * Calculate the sum of the per-pixel SSIM over an image.
+ * The GPU evaluates the full 11x11 window at every pixel, here the window moments are instead calculated
+ * using separable filters. Weighted variance and cross-correlation are then expanded from the filtered
+ * moments so that they equal the two-pass results of the GPU implementation.
+ */
+double SumSSIM(Capsaicin::MetricImage const &sourceImage, Capsaicin::MetricImage const &referenceImage)
+{
+    uint32_t const width      = referenceImage.width;
+    uint32_t const height     = referenceImage.height;
+    size_t const   pixelCount = static_cast<size_t>(width) * height;
+
+    // Horizontally filtered moments: source, reference, source^2, reference^2, source*reference
+    constexpr uint32_t              momentCount = 5;
+    std::vector<float>              moments(pixelCount * momentCount);
+    auto const                      moment = [&](uint32_t const index, uint32_t const row) {
+        return &moments[(static_cast<size_t>(index) * height + row) * width];
+    };
+    Capsaicin::ParallelFor(0U, height, [&](uint32_t const row) {
+        float const       *source    = &sourceImage.values[static_cast<size_t>(row) * width];
+        float const       *reference = &referenceImage.values[static_cast<size_t>(row) * width];
+        std::vector<float> products(width);
+        FilterRow(source, moment(0, row), width);
+        FilterRow(reference, moment(1, row), width);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            products[x] = source[x] * source[x];
+        }
+        FilterRow(products.data(), moment(2, row), width);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            products[x] = reference[x] * reference[x];
+        }
+        FilterRow(products.data(), moment(3, row), width);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            products[x] = source[x] * reference[x];
+        }
+        FilterRow(products.data(), moment(4, row), width);
+    });
+
+    std::vector<float> columnWeights(width);
+    for (uint32_t x = 0; x < width; ++x)
+    {
+        columnWeights[x] = WindowWeight(x, width);
+    }
+    float sumSquaredWeights = 0.0F;
+    for (float const weight : kSSIMWeights)
+    {
+        sumSquaredWeights += weight * weight;
+    }
+    // The 2D weights are the outer product of the 1D weights
+    sumSquaredWeights         *= sumSquaredWeights;
+    float const varianceScale  = 1.0F / (1.0F - sumSquaredWeights);
+
+    std::vector<double> rowSums(height);
+    Capsaicin::ParallelFor(0U, height, [&](uint32_t const row) {
+        // Vertically filter the moments
+        std::vector<float> filtered(static_cast<size_t>(width) * momentCount, 0.0F);
+        for (int32_t i = -kSSIMRadius; i <= kSSIMRadius; ++i)
+        {
+            int32_t const sample = static_cast<int32_t>(row) + i;
+            if (sample < 0 || sample >= static_cast<int32_t>(height))
+            {
+                continue;
+            }
+            float const weight = kSSIMWeights[static_cast<size_t>(i + kSSIMRadius)];
+            for (uint32_t index = 0; index < momentCount; ++index)
+            {
+                float const *input  = moment(index, static_cast<uint32_t>(sample));
+                float       *output = &filtered[static_cast<size_t>(index) * width];
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    output[x] += input[x] * weight;
+                }
+            }
+        }
+
+        // Calculate final SSIM
+        //  SSIM = (2 * MeanImg * MeanImg2 + c1) * (2 * CrossCorrelation + c2)
+        //                                     /
+        //       (MeanImg^2 + MeanImg2^2 + c1) * (VarianceImg + VarianceImg2 + c2)
+        //  where
+        //    c1 = (k1 * L)^2, c2 = (k2 * L), k1 = 0.01, k2 = 0.03
+        constexpr float c1        = 0.01F * 0.01F;
+        constexpr float c2        = 0.03F * 0.03F;
+        float const     rowWeight = WindowWeight(row, height);
+        float const    *meanInput = &filtered[0];
+        float const    *meanRef   = &filtered[width];
+        float const    *inputSq   = &filtered[static_cast<size_t>(width) * 2];
+        float const    *refSq     = &filtered[static_cast<size_t>(width) * 3];
+        float const    *cross     = &filtered[static_cast<size_t>(width) * 4];
+        std::vector<float> ssim(width);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            // Sum(w(a - MeanA)(b - MeanB)) = Sum(w.a.b) - 2.MeanA.MeanB + MeanA.MeanB.Sum(w)
+            float const windowTerm        = columnWeights[x] * rowWeight - 2.0F;
+            float const means             = meanInput[x] * meanRef[x];
+            float const varianceInput     = std::max(
+                (inputSq[x] + meanInput[x] * meanInput[x] * windowTerm) * varianceScale, 0.0F);
+            float const varianceReference =
+                std::max((refSq[x] + meanRef[x] * meanRef[x] * windowTerm) * varianceScale, 0.0F);
+            float const crossCorrelation = (cross[x] + means * windowTerm) * varianceScale;
+            float const value1           = (2.0F * means) + c1;
+            float const value2           = (2.0F * crossCorrelation) + c2;
+            float const divisor1 = (meanInput[x] * meanInput[x]) + (meanRef[x] * meanRef[x]) + c1;
+            float const divisor2 = varianceInput + varianceReference + c2;
+            ssim[x]              = (value1 * value2) / (divisor1 * divisor2);
+        }
+        rowSums[row] = SumRow(ssim.data(), width);
+    });
+
+    double total = 0.0;
+    for (double const sum : rowSums)
+    {
+        total += sum;
+    }
+    return total;
+}
+} // namespace
+
+namespace Capsaicin
+{
+bool CompareImages(
+    MetricImage const &sourceImage, MetricImage const &referenceImage, ImageMetricValues &values) noexcept
+{
+    if (sourceImage.width != referenceImage.width || sourceImage.height != referenceImage.height
+        || sourceImage.hdr != referenceImage.hdr || referenceImage.values.empty())
+    {
+        return false;
+    }
+    try
+    {
+        uint32_t const                     width  = referenceImage.width;
+        uint32_t const                     height = referenceImage.height;
+        std::vector<std::array<double, 3>> rowSums(height);
+        ParallelFor(0U, height, [&](uint32_t const row) {
+            size_t const offset = static_cast<size_t>(row) * width;
+            rowSums[row] = SumRowErrors(&sourceImage.values[offset], &referenceImage.values[offset], width);
+        });
+        std::array<double, 3> sums = {};
+        for (auto const &rowSum : rowSums)
+        {
+            sums[0] += rowSum[0];
+            sums[1] += rowSum[1];
+            sums[2] += rowSum[2];
+        }
+        double const totalPixels = static_cast<double>(width) * height;
+
+        // MSE = [1/(width*height)]Sum([Ref.x.y - Src.x.y]^2)
+        values.mse = sums[0] / totalPixels;
+        // RMSE = sqrt(MSE)
+        values.rmse = sqrt(values.mse);
+        // PSNR = 20log10(MaxValue) - 10log10(MSE), values are normalised so MaxValue is 1.0
+        values.psnr = -10.0 * log10(values.mse);
+        // RMAE = [1/(width*height)]Sum(Abs(Src.x.y - Ref.x.y)/Ref.x.y)
+        values.rmae = sums[1] / totalPixels;
+        // SMAPE = [100/(width*height)]Sum(Abs(Ref.x.y - Src.x.y)/([abs(Ref.x.y)+Abs(Src.x.y)]/2)
+        values.smape = 100.0 * sums[2] / totalPixels;
+        // SSIM =[1/(width*height)]Sum(SSIM(x,y))
+        values.ssim = SumSSIM(sourceImage, referenceImage) / totalPixels;
+        return true;
+    }
+    catch (std::exception const &)
+    {
+        return false;
+    }
+}
+
+std::filesystem::path FindReferenceImage(
+    std::filesystem::path const &inputFile, std::vector<std::filesystem::path> const &references)
+{
+    if (references.size() == 1)
+    {
+        return references[0];
+    }
+    std::string const     inputName = inputFile.stem().string();
+    std::filesystem::path bestMatch;
+    size_t                bestLength = 0;
+    for (auto const &reference : references)
+    {
+        std::string const referenceName = reference.stem().string();
+        if (referenceName.length() > bestLength && inputName.starts_with(referenceName)
+            && (inputName.length() == referenceName.length() || inputName[referenceName.length()] == '_'))
+        {
+            bestMatch  = reference;
+            bestLength = referenceName.length();
+        }
+    }
+    return bestMatch;
+}
+} // namespace Capsaicin
@@ -0,0 +1,73 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Capsaicin
+{
+/** Single channel image containing the perceptual values that metrics are calculated on. */
+struct MetricImage
+{
+    uint32_t           width  = 0;
+    uint32_t           height = 0;
+    bool               hdr    = false; /**< True if values are PQ encoded HDR luminance, False if SDR luma */
+    std::vector<float> values;         /**< Row major per-pixel values */
+};
+
+/** Image comparison metrics, these match those output by the 'ImageMetrics' render technique. */
+struct ImageMetricValues
+{
+    double mse   = 0.0; /**< Mean Squared Error */
+    double rmse  = 0.0; /**< Root Mean Squared Error */
+    double psnr  = 0.0; /**< Peak Signal to noise ratio */
+    double rmae  = 0.0; /**< Relative Mean Absolute Error */
+    double smape = 0.0; /**< Symmetric Mean Absolute Percentage Error */
+    double ssim  = 0.0; /**< Structural Similarity */
+};
+
+/**
+ * Calculate comparison metrics between 2 images.
+ * Work is split across rows and processed in parallel using all available hardware threads.
+ * @param      sourceImage    The input image to compare.
+ * @param      referenceImage The reference image to compare to.
+ * @param [out] values        The calculated metric values.
+ * @return True if the images could be compared, False if they have different dimensions or types.
+ */
+bool CompareImages(
+    MetricImage const &sourceImage, MetricImage const &referenceImage, ImageMetricValues &values) noexcept;
+
+/**
+ * Find the reference image matching an input image.
+ * Dumped images are named '<scene>_<environment>_<camera>_<renderer>' followed by optional suffixes such as
+ * the benchmark suffix, frame index, frame time and debug view. The reference image with the longest name
+ * that the input name starts with (up to a '_' separator) is used.
+ * @param inputFile  The input image.
+ * @param references The list of available reference images, if there is only one then it is always used.
+ * @return The matching reference image, empty if none found.
+ */
+std::filesystem::path FindReferenceImage(
+    std::filesystem::path const &inputFile, std::vector<std::filesystem::path> const &references);
+} // namespace Capsaicin
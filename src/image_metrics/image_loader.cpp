@@ -0,0 +1,136 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "image_loader.h"
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <exception>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#ifdef IMAGE_METRICS_TINYEXR_IMPLEMENTATION
+#    define TINYEXR_IMPLEMENTATION
+#endif
+#include <tinyexr.h>
+
+namespace
+{
+float Luminance(float const red, float const green, float const blue) noexcept
+{
+    return red * 0.2126F + green * 0.7152F + blue * 0.0722F;
+}
+
+/**
+ * Convert a linear value to non-linear perceptual value using the ITU Rec2100 Perceptual Quantizer.
+ * @note Matches 'decodeEOTFST2048' used by the GPU metrics.
+ */
+float DecodeEOTFST2048(float const value) noexcept
+{
+    float const powM1 = std::pow(std::max(value, 0.0F) * (80.0F / 10000.0F), 0.1593017578125F);
+    return std::pow((0.8359375F + 18.8515625F * powM1) / (1.0F + 18.6875F * powM1), 78.84375F);
+}
+
+bool LoadEXRImage(std::filesystem::path const &filePath, Capsaicin::MetricImage &image, std::string &error)
+{
+    float      *data   = nullptr;
+    int32_t     width  = 0;
+    int32_t     height = 0;
+    char const *err    = nullptr;
+    if (LoadEXR(&data, &width, &height, filePath.string().c_str(), &err) != TINYEXR_SUCCESS)
+    {
+        error = err != nullptr ? err : "Failed to load EXR";
+        FreeEXRErrorMessage(err);
+        return false;
+    }
+    image.width  = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    image.hdr    = true;
+    image.values.resize(static_cast<size_t>(image.width) * image.height);
+    // Standard MSE metrics dont work well with HDR data so values are converted to PQ encoded luminance
+    Capsaicin::ParallelFor(0U, image.height, [&](uint32_t const row) {
+        size_t const rowStart = static_cast<size_t>(row) * image.width;
+        for (size_t pixel = rowStart; pixel < rowStart + image.width; ++pixel)
+        {
+            float const *rgba   = &data[pixel * 4];
+            image.values[pixel] = DecodeEOTFST2048(Luminance(rgba[0], rgba[1], rgba[2]));
+        }
+    });
+    free(data);
+    return true;
+}
+
+bool LoadSDRImage(std::filesystem::path const &filePath, Capsaicin::MetricImage &image, std::string &error)
+{
+    int32_t width    = 0;
+    int32_t height   = 0;
+    int32_t channels = 0;
+    stbi_uc *data    = stbi_load(filePath.string().c_str(), &width, &height, &channels, 3);
+    if (data == nullptr)
+    {
+        error = stbi_failure_reason();
+        return false;
+    }
+    image.width  = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    image.hdr    = false;
+    image.values.resize(static_cast<size_t>(image.width) * image.height);
+    // Values are already gamma corrected so luma can be calculated directly
+    Capsaicin::ParallelFor(0U, image.height, [&](uint32_t const row) {
+        size_t const rowStart = static_cast<size_t>(row) * image.width;
+        for (size_t pixel = rowStart; pixel < rowStart + image.width; ++pixel)
+        {
+            stbi_uc const *rgb  = &data[pixel * 3];
+            image.values[pixel] = Luminance(rgb[0], rgb[1], rgb[2]) * (1.0F / 255.0F);
+        }
+    });
+    stbi_image_free(data);
+    return true;
+}
+} // namespace
+
+namespace Capsaicin
+{
+bool LoadMetricImage(std::filesystem::path const &filePath, MetricImage &image, std::string &error) noexcept
+{
+    try
+    {
+        std::string extension = filePath.extension().string();
+        std::ranges::transform(extension, extension.begin(), [](unsigned char const c) {
+            return static_cast<char>(std::tolower(c));
+        });
+        if (extension == ".exr")
+        {
+            return LoadEXRImage(filePath, image, error);
+        }
+        return LoadSDRImage(filePath, image, error);
+    }
+    catch (std::exception const &e)
+    {
+        error = e.what();
+        return false;
+    }
+}
+} // namespace Capsaicin
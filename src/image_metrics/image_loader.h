@@ -0,0 +1,39 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "image_comparer.h"
+
+namespace Capsaicin
+{
+/**
+ * Load an image from disk and convert it to the values used for metric calculation.
+ * EXR files are treated as HDR linear RGB and converted to PQ encoded luminance (same as
+ * 'GPUImageMetrics::Type::HDR_RGB'). All other formats (JPEG, PNG etc.) are treated as gamma corrected SDR
+ * RGB and converted to luma (same as 'GPUImageMetrics::Type::SDR_SRGB').
+ * @param      filePath Full pathname to the image file.
+ * @param [out] image   The loaded image.
+ * @param [out] error   Description of the failure if loading was unsuccessful.
+ * @return True if the image was loaded, False otherwise.
+ */
+bool LoadMetricImage(std::filesystem::path const &filePath, MetricImage &image, std::string &error) noexcept;
+} // namespace Capsaicin
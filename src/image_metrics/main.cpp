@@ -0,0 +1,179 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "image_loader.h"
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+using namespace std;
+using namespace Capsaicin;
+
+namespace
+{
+bool IsImageFile(filesystem::path const &filePath) noexcept
+{
+    string extension = filePath.extension().string();
+    ranges::transform(
+        extension, extension.begin(), [](unsigned char const c) { return static_cast<char>(tolower(c)); });
+    return extension == ".exr" || extension == ".jpeg" || extension == ".jpg" || extension == ".png";
+}
+
+/**
+ * Gather all image files from a path.
+ * @param path      A single image file or a directory to search.
+ * @param recursive True to also search sub-directories.
+ * @return The list of found image files (sorted).
+ */
+vector<filesystem::path> GatherImages(filesystem::path const &path, bool const recursive)
+{
+    vector<filesystem::path> images;
+    if (!filesystem::is_directory(path))
+    {
+        images.push_back(path);
+        return images;
+    }
+    auto const addFile = [&](filesystem::directory_entry const &entry) {
+        if (entry.is_regular_file() && IsImageFile(entry.path()))
+        {
+            images.push_back(entry.path());
+        }
+    };
+    if (recursive)
+    {
+        for (auto const &entry : filesystem::recursive_directory_iterator(path))
+        {
+            addFile(entry);
+        }
+    }
+    else
+    {
+        for (auto const &entry : filesystem::directory_iterator(path))
+        {
+            addFile(entry);
+        }
+    }
+    ranges::sort(images);
+    return images;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    CLI::App app("Capsaicin image metrics: compares dumped images against reference images on the CPU");
+
+    string referencePath;
+    app.add_option("-r,--reference", referencePath, "Reference image file or directory of reference images")
+        ->required()
+        ->check(CLI::ExistingPath);
+    vector<string> inputPaths;
+    app.add_option("-i,--input", inputPaths, "Input image files or directories of images to compare")
+        ->required()
+        ->check(CLI::ExistingPath);
+    string outputPath;
+    app.add_option("-o,--output", outputPath, "Output CSV file (Default: print to console)");
+    bool recursive = false;
+    app.add_flag("--recursive", recursive, "Search directories recursively");
+
+    CLI11_PARSE(app, argc, argv);
+
+    try
+    {
+        vector<filesystem::path> const references = GatherImages(referencePath, recursive);
+        if (references.empty())
+        {
+            cerr << "No reference images found in '" << referencePath << "'\n";
+            return 1;
+        }
+
+        ofstream outputFile;
+        if (!outputPath.empty())
+        {
+            outputFile.open(outputPath, ios::out | ios::trunc);
+            if (!outputFile.is_open())
+            {
+                cerr << "Failed to open output file '" << outputPath << "'\n";
+                return 1;
+            }
+        }
+        ostream &output = outputFile.is_open() ? static_cast<ostream &>(outputFile) : cout;
+        output << "Input,Reference,MSE,RMSE,PSNR,RMAE,SMAPE,SSIM\n";
+
+        // Reference images are commonly shared by many inputs so are only loaded once
+        map<filesystem::path, MetricImage> referenceImages;
+        bool                               failed = false;
+        for (auto const &inputPath : inputPaths)
+        {
+            for (auto const &inputFile : GatherImages(inputPath, recursive))
+            {
+                filesystem::path const referenceFile = FindReferenceImage(inputFile, references);
+                if (referenceFile.empty())
+                {
+                    cerr << "No reference image found for '" << inputFile.string() << "'\n";
+                    failed = true;
+                    continue;
+                }
+                string error;
+                auto   referenceImage = referenceImages.find(referenceFile);
+                if (referenceImage == referenceImages.end())
+                {
+                    MetricImage image;
+                    if (!LoadMetricImage(referenceFile, image, error))
+                    {
+                        cerr << "Failed to load '" << referenceFile.string() << "': " << error << '\n';
+                        failed = true;
+                        continue;
+                    }
+                    referenceImage = referenceImages.emplace(referenceFile, std::move(image)).first;
+                }
+                MetricImage inputImage;
+                if (!LoadMetricImage(inputFile, inputImage, error))
+                {
+                    cerr << "Failed to load '" << inputFile.string() << "': " << error << '\n';
+                    failed = true;
+                    continue;
+                }
+                ImageMetricValues values;
+                if (!CompareImages(inputImage, referenceImage->second, values))
+                {
+                    cerr << "Failed to compare '" << inputFile.string() << "' to '" << referenceFile.string()
+                         << "': images must have identical dimensions and dynamic range\n";
+                    failed = true;
+                    continue;
+                }
+                output << inputFile.string() << ',' << referenceFile.string() << ',' << setprecision(10)
+                       << values.mse << ',' << values.rmse << ',' << values.psnr << ',' << values.rmae << ','
+                       << values.smape << ',' << values.ssim << '\n';
+            }
+        }
+        return failed ? 1 : 0;
+    }
+    catch (exception const &e)
+    {
+        cerr << e.what() << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,140 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "atomic_file.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Capsaicin;
+
+namespace
+{
+class AtomicFileTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path()
+                   / (std::string("capsaicin_atomic_file_")
+                       + testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    [[nodiscard]] size_t countFiles() const
+    {
+        return static_cast<size_t>(std::distance(
+            std::filesystem::directory_iterator(directory_), std::filesystem::directory_iterator()));
+    }
+
+    std::filesystem::path directory_;
+};
+
+std::string ReadFile(std::filesystem::path const &filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+} // namespace
+
+TEST(AtomicFile, TempPathsAreUnique)
+{
+    std::filesystem::path const filePath = "cache/entry.bin";
+    std::set<std::filesystem::path> paths;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        auto const tempPath = GetUniqueTempPath(filePath);
+        EXPECT_EQ(tempPath.parent_path(), filePath.parent_path());
+        EXPECT_TRUE(paths.insert(tempPath).second);
+    }
+
+    std::vector<std::filesystem::path> threadPaths(8);
+    {
+        std::vector<std::jthread> threads;
+        for (auto &threadPath : threadPaths)
+        {
+            threads.emplace_back([&] { threadPath = GetUniqueTempPath(filePath); });
+        }
+    }
+    for (auto const &threadPath : threadPaths)
+    {
+        EXPECT_TRUE(paths.insert(threadPath).second);
+    }
+}
+
+TEST_F(AtomicFileTest, WritesAndReplaces)
+{
+    auto const filePath = directory_ / "file.bin";
+    EXPECT_TRUE(WriteFileAtomic(filePath, [](std::ofstream &file) { return !!file.write("first", 5); }));
+    EXPECT_EQ(ReadFile(filePath), "first");
+    EXPECT_TRUE(WriteFileAtomic(filePath, [](std::ofstream &file) { return !!file.write("second", 6); }));
+    EXPECT_EQ(ReadFile(filePath), "second");
+    EXPECT_EQ(countFiles(), 1U);
+}
+
+TEST_F(AtomicFileTest, AbortKeepsExistingFile)
+{
+    auto const filePath = directory_ / "file.bin";
+    EXPECT_TRUE(WriteFileAtomic(filePath, [](std::ofstream &file) { return !!file.write("first", 5); }));
+    EXPECT_FALSE(WriteFileAtomic(filePath, [](std::ofstream &file) {
+        file.write("partial", 7);
+        return false;
+    }));
+    EXPECT_EQ(ReadFile(filePath), "first");
+    EXPECT_EQ(countFiles(), 1U);
+}
+
+TEST_F(AtomicFileTest, ConcurrentWritersProduceCompleteFile)
+{
+    auto const               filePath = directory_ / "file.bin";
+    std::vector<std::string> contents;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        contents.emplace_back(64 * 1024, static_cast<char>('a' + i));
+    }
+    {
+        std::vector<std::jthread> threads;
+        for (auto const &content : contents)
+        {
+            threads.emplace_back([&] {
+                for (uint32_t i = 0; i < 16; ++i)
+                {
+                    // Renaming over a file that is being replaced by another thread may fail on some
+                    // platforms, which is fine as long as no partial file is ever visible
+                    WriteFileAtomic(filePath, [&](std::ofstream &file) {
+                        return !!file.write(content.data(), static_cast<std::streamsize>(content.size()));
+                    });
+                }
+            });
+        }
+    }
+    std::string const result = ReadFile(filePath);
+    EXPECT_NE(std::ranges::find(contents, result), contents.end());
+    EXPECT_EQ(countFiles(), 1U);
+}
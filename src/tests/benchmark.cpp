@@ -0,0 +1,119 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Capsaicin::Benchmark
+{
+namespace
+{
+struct Registration
+{
+    std::string name;
+    Function    function = nullptr;
+};
+
+std::vector<Registration> &GetRegistrations() noexcept
+{
+    static std::vector<Registration> registrations;
+    return registrations;
+}
+
+void const *volatile g_keepAlive = nullptr;
+} // namespace
+
+State::State(std::string_view const name, bool const quick) noexcept
+    : name_(name)
+    , quick_(quick)
+    , iterations_(quick ? 1 : 10)
+{}
+
+bool State::isQuick() const noexcept
+{
+    return quick_;
+}
+
+uint32_t State::size(uint32_t const full, uint32_t const quick) const noexcept
+{
+    return quick_ ? quick : full;
+}
+
+void State::report(std::string_view const &label, std::vector<double> &times) const noexcept
+{
+    std::ranges::sort(times);
+    double const median = times[times.size() / 2];
+    printf("%-40s %-32s median %10.3f ms   min %10.3f ms\n", name_.c_str(), std::string(label).c_str(),
+        median, times.front());
+    fflush(stdout);
+}
+
+bool Register(std::string_view const &name, Function const function) noexcept
+{
+    GetRegistrations().push_back({.name = std::string(name), .function = function});
+    return true;
+}
+
+void KeepAlive(void const *value) noexcept
+{
+    g_keepAlive = value;
+}
+} // namespace Capsaicin::Benchmark
+
+int main(int const argc, char const *const *argv)
+{
+    using namespace Capsaicin::Benchmark;
+    bool        quick  = false;
+    char const *filter = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--quick") == 0)
+        {
+            quick = true;
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else
+        {
+            printf("Usage: %s [--quick] [--filter <name>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    auto registrations = GetRegistrations();
+    std::ranges::sort(registrations, {}, &Registration::name);
+    for (auto const &[name, function] : registrations)
+    {
+        if (filter != nullptr && name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+        State state(name, quick);
+        function(state);
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Capsaicin::Benchmark
+{
+/**
+ * State passed to each benchmark.
+ * A benchmark performs any setup it requires and then times one or more workloads using run(). Each workload
+ * is executed a number of times and the median and minimum times are reported.
+ */
+class State
+{
+public:
+    /**
+     * Constructor.
+     * @param name  The name of the benchmark.
+     * @param quick True to run a reduced workload (used when checking benchmarks under ctest).
+     */
+    State(std::string_view name, bool quick) noexcept;
+
+    /**
+     * Check if the benchmark should run a reduced workload.
+     * @return True if quick mode is enabled, False otherwise.
+     */
+    [[nodiscard]] bool isQuick() const noexcept;
+
+    /**
+     * Select a workload size based on the current mode.
+     * @param full  The size used for a full run.
+     * @param quick The size used for a quick run.
+     * @return The size to use.
+     */
+    [[nodiscard]] uint32_t size(uint32_t full, uint32_t quick) const noexcept;
+
+    /**
+     * Time a workload and report the results.
+     * @tparam Func Type of the function to time.
+     * @param label Label used to identify the workload within the benchmark.
+     * @param func  The workload to time.
+     */
+    template<typename Func>
+    void run(std::string_view const &label, Func const &func) noexcept
+    {
+        // Warm up caches and allocations before timing
+        func();
+        std::vector<double> times;
+        times.reserve(iterations_);
+        for (uint32_t i = 0; i < iterations_; ++i)
+        {
+            auto const start = std::chrono::steady_clock::now();
+            func();
+            auto const end = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        report(label, times);
+    }
+
+private:
+    /**
+     * Print the results for a workload.
+     * @param label Label used to identify the workload within the benchmark.
+     * @param times The time of each iteration in milliseconds.
+     */
+    void report(std::string_view const &label, std::vector<double> &times) const noexcept;
+
+    std::string name_;
+    bool        quick_      = false;
+    uint32_t    iterations_ = 1;
+};
+
+/** Type of a benchmark function. */
+using Function = void (*)(State &state);
+
+/**
+ * Register a benchmark so that it is run by the benchmark executable.
+ * @param name     The name of the benchmark.
+ * @param function The benchmark function.
+ * @return True (allows registration during static initialisation).
+ */
+bool Register(std::string_view const &name, Function function) noexcept;
+
+/**
+ * Prevent the compiler from optimising away a computed value.
+ * @param value The value to keep.
+ */
+void KeepAlive(void const *value) noexcept;
+} // namespace Capsaicin::Benchmark
+
+/** Register a benchmark function, must be used at namespace scope in the file defining the function. */
+#define CAPSAICIN_BENCHMARK(FUNCTION)                           \
+    [[maybe_unused]] static bool const FUNCTION##_registered = \
+        Capsaicin::Benchmark::Register(#FUNCTION, FUNCTION)
@@ -0,0 +1,91 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include <cstdint>
+
+#include "components/blue_noise_sampler/blue_noise_sampler_samples.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+/** CPU reproduction of samplerBlueNoiseErrorDistribution_128x128_OptimizedFor_2d2d2d2d_1spp. */
+uint32_t SampleBlueNoise(uint32_t const x, uint32_t const y, uint32_t dimension) noexcept
+{
+    dimension            &= 255;
+    uint32_t const value  = (SobolFirstSample[dimension >> 2] >> ((dimension & 3) << 3)) & 0xFF;
+    uint32_t const key    = dimension & 7;
+    return value ^ ((ScramblingTiles[(key >> 2) + (x + y * 128) * 2] >> ((key & 3) << 3)) & 0xFF);
+}
+} // namespace
+
+TEST(BlueNoiseSampler, MatchesUnpackedTables)
+{
+    // FNV-1a hash of every pixel (row major) and dimension of the unpacked tables the packed tables were
+    // created from. The unpacked ranking tile was all zero so each value is Sobol256x256[dimension] xor
+    // ScramblingTiles[(dimension % 8) + pixel * 8]
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint32_t y = 0; y < 128; ++y)
+    {
+        for (uint32_t x = 0; x < 128; ++x)
+        {
+            for (uint32_t dimension = 0; dimension < 256; ++dimension)
+            {
+                hash = (hash ^ SampleBlueNoise(x, y, dimension)) * 1099511628211ULL;
+            }
+        }
+    }
+    EXPECT_EQ(hash, 0xA62B906A269DEBD9ULL);
+}
+
+TEST(BlueNoiseSampler, MatchesUnpackedSamples)
+{
+    struct Sample
+    {
+        uint32_t x;
+        uint32_t y;
+        uint32_t dimension;
+        uint32_t value;
+    };
+    constexpr Sample samples[] = {
+        {  0,   0,   0, 130},
+        {  0,   0,   7, 228},
+        {127,   0,   8, 231},
+        {  0, 127, 255,  14},
+        { 64,  33, 100,  53},
+        {127, 127, 129,  84},
+    };
+    for (auto const &sample : samples)
+    {
+        EXPECT_EQ(SampleBlueNoise(sample.x, sample.y, sample.dimension), sample.value)
+            << "pixel (" << sample.x << ", " << sample.y << "), dimension " << sample.dimension;
+    }
+}
+
+TEST(BlueNoiseSampler, WrapsDimensions)
+{
+    for (uint32_t dimension = 0; dimension < 256; ++dimension)
+    {
+        EXPECT_EQ(SampleBlueNoise(5, 9, dimension + 256), SampleBlueNoise(5, 9, dimension));
+        EXPECT_EQ(SampleBlueNoise(5, 9, dimension + 0xFFFFFF00U), SampleBlueNoise(5, 9, dimension));
+    }
+}
@@ -0,0 +1,72 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+#include "render_techniques/color_grading/color_grading_lut.h"
+#include "test_luts.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Measure loading '.cube' LUTs by parsing the source file and from each compiled sidecar precision. */
+void ColorGradingLut(Benchmark::State &state)
+{
+    auto const directory = std::filesystem::temp_directory_path() / "capsaicin_color_grading_lut_benchmark";
+    std::filesystem::create_directories(directory);
+    for (uint32_t const lutSize : {33U, 65U})
+    {
+        std::string const       cube = Tests::CreateIdentityCube(lutSize);
+        std::vector<char> const data(cube.begin(), cube.end());
+        auto const              filePath = directory / ("identity_" + std::to_string(lutSize) + ".cube");
+        std::ofstream(filePath, std::ios::binary)
+            .write(cube.data(), static_cast<std::streamsize>(cube.size()));
+
+        std::string const   label = std::to_string(lutSize) + "^3 ";
+        uint32_t            size  = 0;
+        std::vector<float4> lut;
+        state.run(label + "parse", [&] {
+            ParseCubeFile(data, size, lut);
+            Benchmark::KeepAlive(lut.data());
+        });
+        for (bool const half : {false, true})
+        {
+            std::string const precision = half ? "half " : "float ";
+            state.run(label + precision + "sidecar save", [&] {
+                bool const saved = SaveLutCache(filePath, size, lut, half);
+                Benchmark::KeepAlive(&saved);
+            });
+            state.run(label + precision + "sidecar load", [&] {
+                LoadLutCache(filePath, half, size, lut);
+                Benchmark::KeepAlive(lut.data());
+            });
+        }
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+}
+CAPSAICIN_BENCHMARK(ColorGradingLut);
+} // namespace
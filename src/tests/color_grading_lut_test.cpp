@@ -0,0 +1,221 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "render_techniques/color_grading/color_grading_lut.h"
+#include "test_luts.h"
+
+#include <algorithm>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace Capsaicin;
+
+namespace
+{
+std::vector<char> ToData(std::string const &text)
+{
+    return {text.begin(), text.end()};
+}
+
+void CheckIdentityLut(
+    uint32_t const lutSize, std::vector<float4> const &lutData, float const tolerance = 1e-6F)
+{
+    ASSERT_EQ(lutData.size(), static_cast<size_t>(lutSize) * lutSize * lutSize);
+    float const scale = 1.0F / static_cast<float>(lutSize - 1);
+    for (size_t i = 0; i < lutData.size(); ++i)
+    {
+        float4 const expected(static_cast<float>(i % lutSize) * scale,
+            static_cast<float>(i / lutSize % lutSize) * scale,
+            static_cast<float>(i / (static_cast<size_t>(lutSize) * lutSize)) * scale, 1.0F);
+        for (int component = 0; component < 4; ++component)
+        {
+            ASSERT_NEAR(lutData[i][component], expected[component], tolerance) << "entry " << i;
+        }
+    }
+}
+
+bool Parse(std::string const &text)
+{
+    uint32_t            lutSize = 0;
+    std::vector<float4> lutData;
+    return ParseCubeFile(ToData(text), lutSize, lutData);
+}
+
+class ColorGradingLutCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path()
+                   / (std::string("capsaicin_color_grading_lut_")
+                       + testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+        filePath_ = directory_ / "identity.cube";
+        writeCube(Tests::CreateIdentityCube(5));
+        ASSERT_TRUE(LoadCubeFile(filePath_, lutSize_, lutData_));
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    void writeCube(std::string const &text) const
+    {
+        std::ofstream file(filePath_, std::ios::binary | std::ios::trunc);
+        file << text;
+    }
+
+    std::filesystem::path directory_;
+    std::filesystem::path filePath_;
+    uint32_t              lutSize_ = 0;
+    std::vector<float4>   lutData_;
+};
+} // namespace
+
+TEST(ColorGradingLut, ParsesHeaderAndTable)
+{
+    std::string const cube = "TITLE \"Test\"\n"
+                             "# Comment\n"
+                             "  DOMAIN_MIN 0 0 0\n"
+                             "DOMAIN_MAX 1.0 1.0 1.0\n"
+                             "LUT_3D_SIZE 2\n"
+                             "\n"
+                             "0 0 0\n"
+                             "+1 0 0\n"
+                             "# Comment within the table\n"
+                             "0 1e0 0\n"
+                             "1 1 0\n"
+                             "\t0 0 .5\n"
+                             "1 0 1  \n"
+                             "0 1 1\n"
+                             "-0.25 1 1";
+    uint32_t            lutSize = 0;
+    std::vector<float4> lutData;
+    ASSERT_TRUE(ParseCubeFile(ToData(cube), lutSize, lutData));
+    EXPECT_EQ(lutSize, 2U);
+    std::vector<float4> const expected = {float4(0.0F, 0.0F, 0.0F, 1.0F), float4(1.0F, 0.0F, 0.0F, 1.0F),
+        float4(0.0F, 1.0F, 0.0F, 1.0F), float4(1.0F, 1.0F, 0.0F, 1.0F), float4(0.0F, 0.0F, 0.5F, 1.0F),
+        float4(1.0F, 0.0F, 1.0F, 1.0F), float4(0.0F, 1.0F, 1.0F, 1.0F), float4(-0.25F, 1.0F, 1.0F, 1.0F)};
+    EXPECT_EQ(lutData, expected);
+}
+
+TEST(ColorGradingLut, ParsesWindowsLineEndings)
+{
+    uint32_t            lutSize = 0;
+    std::vector<float4> lutData;
+    ASSERT_TRUE(ParseCubeFile(ToData(Tests::CreateIdentityCube(3, "\r\n")), lutSize, lutData));
+    EXPECT_EQ(lutSize, 3U);
+    CheckIdentityLut(lutSize, lutData);
+}
+
+TEST(ColorGradingLut, ParsesLargeLutInBlocks)
+{
+    // A 33^3 LUT is several times larger than the block size used to parse in parallel
+    std::string const cube = Tests::CreateIdentityCube(33);
+    ASSERT_GT(cube.size(), 4 * 64 * 1024U);
+    uint32_t            lutSize = 0;
+    std::vector<float4> lutData;
+    ASSERT_TRUE(ParseCubeFile(ToData(cube), lutSize, lutData));
+    EXPECT_EQ(lutSize, 33U);
+    CheckIdentityLut(lutSize, lutData, 1e-5F);
+}
+
+TEST(ColorGradingLut, RejectsInvalidFiles)
+{
+    std::string const table = "0 0 0\n1 0 0\n0 1 0\n1 1 0\n0 0 1\n1 0 1\n0 1 1\n1 1 1\n";
+    EXPECT_TRUE(Parse("LUT_3D_SIZE 2\n" + table));
+    EXPECT_FALSE(Parse(table)) << "missing size";
+    EXPECT_FALSE(Parse("LUT_3D_SIZE 0\n" + table)) << "invalid size";
+    EXPECT_FALSE(Parse("LUT_3D_SIZE 101\n" + table)) << "size too large";
+    EXPECT_FALSE(Parse("LUT_1D_SIZE 2\n" + table)) << "1D LUT";
+    EXPECT_FALSE(Parse("DOMAIN_MIN 0 0 0.1\nLUT_3D_SIZE 2\n" + table)) << "non default domain";
+    EXPECT_FALSE(Parse("DOMAIN_MAX 1 1\nLUT_3D_SIZE 2\n" + table)) << "malformed domain";
+    EXPECT_FALSE(Parse("LUT_3D_SIZE 2\n" + table + "1 1 1\n")) << "too many entries";
+    EXPECT_FALSE(Parse("LUT_3D_SIZE 2\n" + table.substr(6))) << "too few entries";
+    EXPECT_FALSE(Parse("LUT_3D_SIZE 2\n0 0\n" + table.substr(6))) << "too few values";
+    EXPECT_FALSE(Parse("LUT_3D_SIZE 2\n0 0 0 0\n" + table.substr(6))) << "too many values";
+    EXPECT_FALSE(Parse("LUT_3D_SIZE 2\n0 0 x\n" + table.substr(6))) << "invalid value";
+}
+
+TEST_F(ColorGradingLutCacheTest, RoundTripsFloat)
+{
+    ASSERT_TRUE(SaveLutCache(filePath_, lutSize_, lutData_, false));
+    uint32_t            lutSize = 0;
+    std::vector<float4> lutData;
+    ASSERT_TRUE(LoadLutCache(filePath_, false, lutSize, lutData));
+    EXPECT_EQ(lutSize, lutSize_);
+    EXPECT_EQ(lutData, lutData_);
+}
+
+TEST_F(ColorGradingLutCacheTest, RoundTripsHalf)
+{
+    ASSERT_TRUE(SaveLutCache(filePath_, lutSize_, lutData_, true));
+    uint32_t            lutSize = 0;
+    std::vector<float4> lutData;
+    ASSERT_TRUE(LoadLutCache(filePath_, true, lutSize, lutData));
+    EXPECT_EQ(lutSize, lutSize_);
+    CheckIdentityLut(lutSize, lutData, 1e-3F);
+}
+
+TEST_F(ColorGradingLutCacheTest, RejectsDifferentPrecision)
+{
+    uint32_t            lutSize = 0;
+    std::vector<float4> lutData;
+    ASSERT_TRUE(SaveLutCache(filePath_, lutSize_, lutData_, true));
+    EXPECT_FALSE(LoadLutCache(filePath_, false, lutSize, lutData));
+    ASSERT_TRUE(SaveLutCache(filePath_, lutSize_, lutData_, false));
+    EXPECT_FALSE(LoadLutCache(filePath_, true, lutSize, lutData));
+    EXPECT_TRUE(LoadLutCache(filePath_, false, lutSize, lutData));
+}
+
+TEST_F(ColorGradingLutCacheTest, RejectsModifiedSource)
+{
+    ASSERT_TRUE(SaveLutCache(filePath_, lutSize_, lutData_, false));
+    writeCube(Tests::CreateIdentityCube(4));
+    uint32_t            lutSize = 0;
+    std::vector<float4> lutData;
+    EXPECT_FALSE(LoadLutCache(filePath_, false, lutSize, lutData));
+}
+
+TEST_F(ColorGradingLutCacheTest, RejectsCorruptSidecar)
+{
+    ASSERT_TRUE(SaveLutCache(filePath_, lutSize_, lutData_, false));
+    auto const cachePath = GetLutCachePath(filePath_);
+    std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath) - 1);
+    uint32_t            lutSize = 0;
+    std::vector<float4> lutData;
+    EXPECT_FALSE(LoadLutCache(filePath_, false, lutSize, lutData));
+}
+
+TEST_F(ColorGradingLutCacheTest, LeavesNoTemporaryFiles)
+{
+    ASSERT_TRUE(SaveLutCache(filePath_, lutSize_, lutData_, false));
+    ASSERT_TRUE(SaveLutCache(filePath_, lutSize_, lutData_, true));
+    std::vector<std::filesystem::path> files;
+    for (auto const &entry : std::filesystem::directory_iterator(directory_))
+    {
+        files.push_back(entry.path().filename());
+    }
+    std::ranges::sort(files);
+    std::vector<std::filesystem::path> const expected = {"identity.cube", "identity.cube.bin"};
+    EXPECT_EQ(files, expected);
+}
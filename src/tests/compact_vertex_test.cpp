@@ -0,0 +1,123 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "gpu_shared.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Generate random unit length normals that cover every octant and the octahedral fold edges. */
+std::vector<float3> CreateNormals(uint32_t const count) noexcept
+{
+    std::vector<float3> normals = {float3(1.0F, 0.0F, 0.0F), float3(-1.0F, 0.0F, 0.0F),
+        float3(0.0F, 1.0F, 0.0F), float3(0.0F, -1.0F, 0.0F), float3(0.0F, 0.0F, 1.0F),
+        float3(0.0F, 0.0F, -1.0F), glm::normalize(float3(1.0F, -1.0F, 0.0F)),
+        glm::normalize(float3(-1.0F, -1.0F, -1.0F))};
+    std::mt19937                    random(1234U);
+    std::normal_distribution<float> distribution;
+    while (normals.size() < count)
+    {
+        float3 const normal(distribution(random), distribution(random), distribution(random));
+        if (glm::length(normal) > 1e-3F)
+        {
+            normals.push_back(glm::normalize(normal));
+        }
+    }
+    return normals;
+}
+} // namespace
+
+TEST(CompactVertex, MatchesHlslLayout)
+{
+    EXPECT_EQ(sizeof(CompactVertex), 20U);
+    EXPECT_EQ(offsetof(CompactVertex, normal), 12U);
+    EXPECT_EQ(offsetof(CompactVertex, uv), 16U);
+    // Normals are packed as 2 16bit snorms with the second component in the upper bits (see packSnorm2x16)
+    CompactVertex vertex;
+    vertex.setVertex(float3(0.0F), float3(1.0F, 0.0F, 0.0F), float2(0.0F));
+    EXPECT_EQ(vertex.normal, 0x00007FFFU);
+    vertex.setVertex(float3(0.0F), float3(0.0F, 1.0F, 0.0F), float2(0.0F));
+    EXPECT_EQ(vertex.normal, 0x7FFF0000U);
+    // UVs are packed as 2 halfs with V in the upper bits (see packHalf2)
+    vertex.setVertex(float3(0.0F), float3(0.0F, 0.0F, 1.0F), float2(1.0F, -2.0F));
+    EXPECT_EQ(vertex.uv, 0xC0003C00U);
+}
+
+TEST(CompactVertex, RoundTripError)
+{
+    std::vector<float3> const             normals = CreateNormals(100000);
+    std::mt19937                          random(5678U);
+    std::uniform_real_distribution<float> positions(-1000.0F, 1000.0F);
+    std::uniform_real_distribution<float> uvs(-8.0F, 8.0F);
+    float                                 maxNormalError = 0.0F;
+    float                                 maxUVError     = 0.0F;
+    for (float3 const &normal : normals)
+    {
+        float3 const position(positions(random), positions(random), positions(random));
+        float2 const uv(uvs(random), uvs(random));
+        Vertex       source;
+        source.setVertex(position, normal, uv);
+        CompactVertex const vertex(source);
+
+        // Positions are stored at full precision as they are used directly for acceleration structure builds
+        EXPECT_EQ(vertex.getPosition(), position);
+        float3 const decoded = vertex.getNormal();
+        EXPECT_NEAR(glm::length(decoded), 1.0F, 1e-5F);
+        // acos is too imprecise for the tiny angles involved so the angle is found from both sin and cos
+        float const angle = glm::atan(glm::length(glm::cross(decoded, normal)), glm::dot(decoded, normal));
+        maxNormalError    = glm::max(maxNormalError, angle);
+        float2 const uvError = glm::abs(vertex.getUV() - uv) / glm::max(glm::abs(uv), float2(1.0F));
+        maxUVError           = glm::max(maxUVError, glm::max(uvError.x, uvError.y));
+    }
+    // 16bit octahedral normals have a worst case error of roughly 0.005 degrees
+    EXPECT_LT(glm::degrees(maxNormalError), 0.01F);
+    // Half precision has an 11bit significand
+    EXPECT_LE(maxUVError, 1.0F / 2048.0F);
+}
+
+TEST(CompactVertex, ClampsOutOfRangeUVs)
+{
+    CompactVertex vertex;
+    vertex.setVertex(float3(0.0F), float3(0.0F, 0.0F, 1.0F), float2(1.0e6F, -1.0e6F));
+    float2 const uv = vertex.getUV();
+    EXPECT_EQ(uv.x, 65504.0F);
+    EXPECT_EQ(uv.y, -65504.0F);
+}
+
+TEST(CompactVertex, HandlesDegenerateNormals)
+{
+    // Zero, infinite and NaN normals are all stored as +Z, matching Vertex::setVertex in vertex_format.hlsl
+    float const infinity = std::numeric_limits<float>::infinity();
+    for (float3 const &degenerate : {float3(0.0F), float3(infinity, 0.0F, 0.0F),
+             float3(0.0F, 0.0F, -infinity), float3(std::numeric_limits<float>::quiet_NaN())})
+    {
+        CompactVertex vertex;
+        vertex.setVertex(float3(0.0F), degenerate, float2(0.0F));
+        EXPECT_EQ(vertex.normal, 0U);
+        EXPECT_EQ(vertex.getNormal(), float3(0.0F, 0.0F, 1.0F));
+    }
+}
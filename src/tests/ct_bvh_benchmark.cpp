@@ -0,0 +1,88 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+#include "parallel.h"
+#include "test_triangles.h"
+
+#include <string>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Measure BVH build time across scene sizes. */
+void CtBvhBuild(Benchmark::State &state)
+{
+    for (uint32_t const count :
+        {state.size(10000, 1000), state.size(100000, 10000), state.size(1000000, 50000)})
+    {
+        std::vector<CtBvh::Triangle> const source = Tests::CreateTriangles(count, count);
+        std::vector<CtBvh::Triangle>       triangles;
+        CtBvh                              bvh;
+        state.run(std::to_string(count) + " triangles", [&] {
+            triangles = source;
+            bvh.build(triangles);
+            Benchmark::KeepAlive(bvh.getNodes().data());
+        });
+    }
+}
+CAPSAICIN_BENCHMARK(CtBvhBuild);
+
+/** Compare tracing rays through the BVH against testing every triangle. */
+void CtBvhTrace(Benchmark::State &state)
+{
+    uint32_t const               count     = state.size(100000, 5000);
+    uint32_t const               rayCount  = state.size(100000, 1000);
+    std::vector<CtBvh::Triangle> triangles = Tests::CreateTriangles(count, 11);
+    CtBvh                        bvh;
+    bvh.build(triangles);
+    std::vector<glm::vec3> origins(rayCount);
+    std::vector<glm::vec3> directions(rayCount);
+    std::mt19937           random(12U);
+    for (uint32_t i = 0; i < rayCount; ++i)
+    {
+        Tests::CreateRay(random, origins[i], directions[i]);
+    }
+    std::vector<float> distances(rayCount);
+    state.run(std::to_string(rayCount) + " rays bvh", [&] {
+        ParallelFor(0U, rayCount, [&](uint32_t const i) {
+            distances[i] = bvh.intersect(triangles, origins[i], directions[i], 0.0F, 1e30F).t;
+        });
+        Benchmark::KeepAlive(distances.data());
+    });
+    // Brute force is only run over a subset of the rays as it is several orders of magnitude slower
+    uint32_t const bruteCount = std::max(rayCount / 1000, 1U);
+    state.run(std::to_string(bruteCount) + " rays brute force", [&] {
+        ParallelFor(0U, bruteCount, [&](uint32_t const i) {
+            CtBvh::Hit hit;
+            for (uint32_t j = 0; j < count; ++j)
+            {
+                CtBvh::intersectTriangle(triangles[j], j, origins[i], directions[i], 0.0F, hit);
+            }
+            distances[i] = hit.t;
+        });
+        Benchmark::KeepAlive(distances.data());
+    });
+}
+CAPSAICIN_BENCHMARK(CtBvhTrace);
+} // namespace
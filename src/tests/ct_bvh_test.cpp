@@ -0,0 +1,222 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "test_triangles.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Find the closest hit by testing every triangle. */
+CtBvh::Hit IntersectBruteForce(std::vector<CtBvh::Triangle> const &triangles, glm::vec3 const &origin,
+    glm::vec3 const &direction) noexcept
+{
+    CtBvh::Hit hit;
+    for (uint32_t i = 0; i < triangles.size(); ++i)
+    {
+        CtBvh::intersectTriangle(triangles[i], i, origin, direction, 0.0F, hit);
+    }
+    return hit;
+}
+
+bool Contains(CtBvh::Node const &node, CtBvh::Bounds const &bounds) noexcept
+{
+    return glm::all(glm::lessThanEqual(node.boundsMin, bounds.min))
+        && glm::all(glm::greaterThanEqual(node.boundsMax, bounds.max));
+}
+
+/** Check the structure of a BVH built over a list of triangles (in leaf order). */
+void ValidateHierarchy(CtBvh const &bvh, std::vector<CtBvh::Triangle> const &triangles, uint32_t maxLeafSize)
+{
+    auto const           &nodes = bvh.getNodes();
+    std::vector<uint32_t> covered(triangles.size(), 0);
+    std::vector<uint32_t> parents(nodes.size(), 0);
+    ASSERT_FALSE(nodes.empty());
+    for (uint32_t index = 0; index < nodes.size(); ++index)
+    {
+        CtBvh::Node const &node = nodes[index];
+        if (node.isLeaf())
+        {
+            EXPECT_LE(node.primitiveCount, maxLeafSize);
+            ASSERT_LE(node.leftFirst + node.primitiveCount, triangles.size());
+            for (uint32_t i = node.leftFirst; i < node.leftFirst + node.primitiveCount; ++i)
+            {
+                ++covered[i];
+                EXPECT_TRUE(Contains(node, triangles[i].getBounds())) << "leaf " << index;
+            }
+        }
+        else
+        {
+            // Children are stored next to each other and always after their parent
+            ASSERT_GT(node.leftFirst, index);
+            ASSERT_LT(node.leftFirst + 1, nodes.size());
+            for (uint32_t child = node.leftFirst; child <= node.leftFirst + 1; ++child)
+            {
+                ++parents[child];
+                EXPECT_TRUE(Contains(node, CtBvh::Bounds {nodes[child].boundsMin, nodes[child].boundsMax}))
+                    << "node " << index;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < covered.size(); ++i)
+    {
+        EXPECT_EQ(covered[i], 1U) << "primitive " << i;
+    }
+    EXPECT_EQ(parents[0], 0U);
+    for (uint32_t i = 1; i < parents.size(); ++i)
+    {
+        EXPECT_EQ(parents[i], 1U) << "node " << i;
+    }
+}
+} // namespace
+
+TEST(CtBvh, BuildsValidHierarchy)
+{
+    for (uint32_t const count : {1U, 7U, 100U, 20000U})
+    {
+        SCOPED_TRACE(count);
+        std::vector<CtBvh::Triangle> triangles = Tests::CreateTriangles(count, count);
+        CtBvh                        bvh;
+        bvh.build(triangles);
+        ValidateHierarchy(bvh, triangles, CtBvh::MAX_LEAF_SIZE);
+
+        // The primitive order must be a permutation that matches the re-ordered triangles
+        auto const &indices = bvh.getPrimitiveIndices();
+        ASSERT_EQ(indices.size(), count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(triangles[i].primitiveIndex, indices[i]);
+        }
+    }
+}
+
+TEST(CtBvh, IsDeterministic)
+{
+    // Large enough that the top of the tree is binned in parallel and subtrees are built in parallel
+    std::vector<CtBvh::Triangle> first  = Tests::CreateTriangles(50000, 3);
+    std::vector<CtBvh::Triangle> second = first;
+    CtBvh                        bvh1;
+    CtBvh                        bvh2;
+    bvh1.build(first);
+    bvh2.build(second);
+    ASSERT_EQ(bvh1.getNodes().size(), bvh2.getNodes().size());
+    EXPECT_EQ(memcmp(bvh1.getNodes().data(), bvh2.getNodes().data(),
+                  bvh1.getNodes().size() * sizeof(CtBvh::Node)),
+        0);
+    EXPECT_EQ(bvh1.getPrimitiveIndices(), bvh2.getPrimitiveIndices());
+}
+
+TEST(CtBvh, TraversalMatchesBruteForce)
+{
+    std::vector<CtBvh::Triangle> triangles = Tests::CreateTriangles(5000, 4);
+    CtBvh                        bvh;
+    bvh.build(triangles);
+    std::mt19937 random(5U);
+    uint32_t     hits = 0;
+    for (uint32_t ray = 0; ray < 2000; ++ray)
+    {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        Tests::CreateRay(random, origin, direction);
+        CtBvh::Hit const expected = IntersectBruteForce(triangles, origin, direction);
+        CtBvh::Hit const hit =
+            bvh.intersect(triangles, origin, direction, 0.0F, std::numeric_limits<float>::max());
+        ASSERT_EQ(hit.t, expected.t) << "ray " << ray;
+        if (expected.primitive != std::numeric_limits<uint32_t>::max())
+        {
+            ++hits;
+            // Different triangles may share the closest distance, the hit must still be valid
+            CtBvh::Hit check;
+            EXPECT_TRUE(CtBvh::intersectTriangle(
+                triangles[hit.primitive], hit.primitive, origin, direction, 0.0F, check));
+            EXPECT_EQ(check.t, hit.t);
+        }
+    }
+    // Make sure the rays actually test something
+    EXPECT_GT(hits, 500U);
+}
+
+TEST(CtBvh, RespectsRayExtents)
+{
+    std::vector<CtBvh::Triangle> triangles = Tests::CreateTriangles(1000, 6);
+    CtBvh                        bvh;
+    bvh.build(triangles);
+    std::mt19937 random(7U);
+    for (uint32_t ray = 0; ray < 500; ++ray)
+    {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        Tests::CreateRay(random, origin, direction);
+        CtBvh::Hit const closest =
+            bvh.intersect(triangles, origin, direction, 0.0F, std::numeric_limits<float>::max());
+        if (closest.primitive == std::numeric_limits<uint32_t>::max())
+        {
+            continue;
+        }
+        // Nothing can be found before the closest hit, anything found past it must be further away
+        EXPECT_EQ(bvh.intersect(triangles, origin, direction, 0.0F, closest.t).primitive,
+            std::numeric_limits<uint32_t>::max());
+        CtBvh::Hit const next = bvh.intersect(triangles, origin, direction, closest.t * 1.0001F, 1e30F);
+        if (next.primitive != std::numeric_limits<uint32_t>::max())
+        {
+            EXPECT_GT(next.t, closest.t);
+        }
+    }
+}
+
+TEST(CtBvh, RefitContainsMovedPrimitives)
+{
+    std::vector<CtBvh::Triangle> triangles = Tests::CreateTriangles(4000, 8);
+    CtBvh                        bvh;
+    bvh.build(triangles);
+    std::vector<CtBvh::Bounds> bounds(triangles.size());
+    for (uint32_t i = 0; i < triangles.size(); ++i)
+    {
+        triangles[i].v0 += glm::vec3(static_cast<float>(i % 13), -static_cast<float>(i % 7), 3.0F);
+        bounds[i] = triangles[i].getBounds();
+    }
+    bvh.refit(bounds.data());
+    ValidateHierarchy(bvh, triangles, CtBvh::MAX_LEAF_SIZE);
+
+    std::mt19937 random(9U);
+    for (uint32_t ray = 0; ray < 500; ++ray)
+    {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        Tests::CreateRay(random, origin, direction);
+        EXPECT_EQ(bvh.intersect(triangles, origin, direction, 0.0F, std::numeric_limits<float>::max()).t,
+            IntersectBruteForce(triangles, origin, direction).t);
+    }
+}
+
+TEST(CtBvh, HandlesEmptyInput)
+{
+    std::vector<CtBvh::Triangle> triangles;
+    CtBvh                        bvh;
+    bvh.build(triangles);
+    EXPECT_TRUE(bvh.getNodes().empty());
+    CtBvh::Hit const hit = bvh.intersect(triangles, glm::vec3(0.0F), glm::vec3(0.0F, 0.0F, 1.0F), 0.0F, 1.0F);
+    EXPECT_EQ(hit.primitive, std::numeric_limits<uint32_t>::max());
+}
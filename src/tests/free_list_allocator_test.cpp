@@ -0,0 +1,181 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "free_list_allocator.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace Capsaicin;
+
+TEST(FreeListAllocator, AllocatesAndFrees)
+{
+    FreeListAllocator allocator;
+    EXPECT_EQ(allocator.allocate(0), 0U);
+    EXPECT_EQ(allocator.getCapacity(), 0U);
+    uint32_t const first  = allocator.allocate(100);
+    uint32_t const second = allocator.allocate(200);
+    EXPECT_EQ(first, 0U);
+    EXPECT_EQ(second, 100U);
+    EXPECT_EQ(allocator.getUsed(), 300U);
+    EXPECT_GE(allocator.getCapacity(), 300U);
+
+    // Freed ranges are reused first-fit
+    allocator.free(first, 100);
+    EXPECT_EQ(allocator.getUsed(), 200U);
+    EXPECT_EQ(allocator.allocate(60), 0U);
+    EXPECT_EQ(allocator.allocate(40), 60U);
+    EXPECT_EQ(allocator.allocate(1), 300U);
+
+    allocator.reset();
+    EXPECT_EQ(allocator.getUsed(), 0U);
+    EXPECT_EQ(allocator.allocate(allocator.getCapacity()), 0U);
+}
+
+TEST(FreeListAllocator, CoalescesNeighbours)
+{
+    FreeListAllocator allocator;
+    ASSERT_EQ(allocator.allocate(1024), 0U);
+    ASSERT_EQ(allocator.getCapacity(), 1024U);
+    allocator.free(0, 1024);
+    uint32_t const a = allocator.allocate(100);
+    uint32_t const b = allocator.allocate(100);
+    uint32_t const c = allocator.allocate(100);
+    uint32_t const d = allocator.allocate(100);
+
+    // Merge with the following range (b then a)
+    allocator.free(b, 100);
+    allocator.free(a, 100);
+    EXPECT_EQ(allocator.allocate(200), a);
+    allocator.free(a, 200);
+
+    // Merge with the preceding range (a then b)
+    allocator.free(c, 100);
+    EXPECT_EQ(allocator.allocate(300), a);
+    allocator.free(a, 300);
+
+    // Merge with both neighbours at once, including the free tail of the capacity
+    allocator.free(d, 100);
+    EXPECT_EQ(allocator.getUsed(), 0U);
+    EXPECT_EQ(allocator.allocate(1024), 0U);
+    EXPECT_EQ(allocator.getCapacity(), 1024U);
+}
+
+TEST(FreeListAllocator, GrowsWithoutMovingAllocations)
+{
+    FreeListAllocator allocator;
+    uint32_t const    first = allocator.allocate(1000);
+    EXPECT_EQ(allocator.getCapacity(), 1024U);
+
+    // The free tail is extended rather than leaving a gap before the new capacity
+    uint32_t const second = allocator.allocate(100);
+    EXPECT_EQ(second, 1000U);
+    EXPECT_EQ(allocator.getCapacity(), 1536U);
+
+    // Large requests grow by at least the requested size
+    uint32_t const third = allocator.allocate(5000);
+    EXPECT_EQ(third, 1100U);
+    EXPECT_EQ(allocator.getCapacity(), 6536U);
+    EXPECT_EQ(first, 0U);
+    EXPECT_EQ(allocator.getUsed(), 6100U);
+
+    // Capacity is retained on reset
+    allocator.reset();
+    EXPECT_EQ(allocator.getCapacity(), 6536U);
+}
+
+TEST(FreeListAllocator, GrowsWhenFragmented)
+{
+    FreeListAllocator     allocator;
+    std::vector<uint32_t> offsets;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        offsets.push_back(allocator.allocate(64));
+    }
+    ASSERT_EQ(allocator.getCapacity(), 1024U);
+    // Free every other range leaving 512 free elements that are not contiguous
+    for (uint32_t i = 0; i < 16; i += 2)
+    {
+        allocator.free(offsets[i], 64);
+    }
+    EXPECT_EQ(allocator.getUsed(), 512U);
+    uint32_t const large = allocator.allocate(128);
+    EXPECT_EQ(large, 1024U);
+    EXPECT_GT(allocator.getCapacity(), 1024U);
+    // Holes are still used for allocations that fit them
+    EXPECT_EQ(allocator.allocate(64), offsets[0]);
+    EXPECT_EQ(allocator.allocate(32), offsets[2]);
+    EXPECT_EQ(allocator.allocate(32), offsets[2] + 32);
+}
+
+TEST(FreeListAllocator, OffsetsStayStable)
+{
+    struct Allocation
+    {
+        uint32_t offset;
+        uint32_t count;
+    };
+    FreeListAllocator       allocator;
+    std::vector<Allocation> allocations;
+    std::mt19937            random(1234);
+    uint32_t                used = 0;
+    for (uint32_t step = 0; step < 4000; ++step)
+    {
+        if (!allocations.empty() && random() % 3 == 0)
+        {
+            size_t const index = random() % allocations.size();
+            allocator.free(allocations[index].offset, allocations[index].count);
+            used -= allocations[index].count;
+            allocations.erase(allocations.begin() + static_cast<ptrdiff_t>(index));
+        }
+        else
+        {
+            uint32_t const count = 1 + random() % 300;
+            allocations.push_back({allocator.allocate(count), count});
+            used += count;
+        }
+        ASSERT_EQ(allocator.getUsed(), used);
+    }
+
+    // Existing allocations never move so they must still be disjoint and within the capacity
+    std::ranges::sort(allocations, {}, &Allocation::offset);
+    for (size_t i = 0; i < allocations.size(); ++i)
+    {
+        EXPECT_LE(allocations[i].offset + allocations[i].count, allocator.getCapacity());
+        if (i > 0)
+        {
+            EXPECT_LE(allocations[i - 1].offset + allocations[i - 1].count, allocations[i].offset);
+        }
+    }
+
+    // Releasing everything coalesces back into a single range
+    for (auto const &allocation : allocations)
+    {
+        allocator.free(allocation.offset, allocation.count);
+    }
+    uint32_t const capacity = allocator.getCapacity();
+    EXPECT_EQ(allocator.getUsed(), 0U);
+    EXPECT_EQ(allocator.allocate(capacity), 0U);
+    EXPECT_EQ(allocator.getCapacity(), capacity);
+}
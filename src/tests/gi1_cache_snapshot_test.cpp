@@ -0,0 +1,278 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "gi1_cache_snapshot.h"
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace Capsaicin;
+
+namespace
+{
+constexpr uint32_t kNumBuckets = 8;
+constexpr uint32_t kFrameIndex = 1000;
+
+GI1CacheSnapshot::Layout CreateTestLayout()
+{
+    return {.cell_size         = 32.0F,
+        .min_cell_size         = 0.1F,
+        .tile_cell_ratio       = 2,
+        .num_tiles_per_bucket  = 4,
+        .num_cells_per_tile    = 5,
+        .use_multibounce       = 1,
+        .reservoir_num_entries = 16,
+        .reservoir_num_samples = 8};
+}
+
+/**
+ * Creates cache contents with between 1 and 3 tiles in use at the front of each bucket, matching the packing
+ * produced when restoring, and every third reservoir entry in use.
+ */
+void CreateTestBuffers(
+    GI1CacheSnapshot::HashGridBuffers &hashGrid, GI1CacheSnapshot::ReservoirBuffers &reservoirs)
+{
+    auto const     layout     = CreateTestLayout();
+    uint32_t const num_tiles  = kNumBuckets * layout.num_tiles_per_bucket;
+    size_t const   num_values = 2 * size_t {num_tiles} * layout.num_cells_per_tile;
+    hashGrid.hash.assign(num_tiles, 0);
+    hashGrid.decay_tile.assign(num_tiles, 0);
+    hashGrid.bucket_hash.assign(num_tiles, 0);
+    for (uint32_t tile_index = 0; tile_index < num_tiles; ++tile_index)
+    {
+        uint32_t const bucket_index = tile_index / layout.num_tiles_per_bucket;
+        if (tile_index % layout.num_tiles_per_bucket > bucket_index % 3)
+        {
+            continue;
+        }
+        hashGrid.hash[tile_index]        = 0x1000U + tile_index;
+        hashGrid.decay_tile[tile_index]  = kFrameIndex - tile_index;
+        hashGrid.bucket_hash[tile_index] = bucket_index;
+    }
+    hashGrid.value.resize(num_values);
+    std::iota(hashGrid.value.begin(), hashGrid.value.end(), 1U);
+    hashGrid.value_indirect.resize(num_values);
+    std::iota(hashGrid.value_indirect.begin(), hashGrid.value_indirect.end(), 0x8000U);
+
+    reservoirs.hash.assign(layout.reservoir_num_entries, 0);
+    reservoirs.hash_count.assign(layout.reservoir_num_entries, 0);
+    reservoirs.hash_index.assign(layout.reservoir_num_entries, 0);
+    uint32_t index = 0;
+    for (uint32_t entry_index = 0; entry_index < layout.reservoir_num_entries; entry_index += 3)
+    {
+        reservoirs.hash[entry_index]       = 0x2000U + entry_index;
+        reservoirs.hash_count[entry_index] = 2;
+        reservoirs.hash_index[entry_index] = index;
+        index += 2;
+    }
+    reservoirs.hash_value.resize(layout.reservoir_num_entries);
+    std::iota(reservoirs.hash_value.begin(), reservoirs.hash_value.end(), 0U);
+    reservoirs.indirect_sample_normal.resize(layout.reservoir_num_samples);
+    std::iota(reservoirs.indirect_sample_normal.begin(), reservoirs.indirect_sample_normal.end(), 0x3000U);
+    reservoirs.indirect_sample_reservoir.resize(4 * size_t {layout.reservoir_num_samples});
+    std::iota(
+        reservoirs.indirect_sample_reservoir.begin(), reservoirs.indirect_sample_reservoir.end(), 0x4000U);
+}
+
+GI1CacheSnapshot CreateTestSnapshot(
+    GI1CacheSnapshot::HashGridBuffers &hashGrid, GI1CacheSnapshot::ReservoirBuffers &reservoirs)
+{
+    CreateTestBuffers(hashGrid, reservoirs);
+    auto const       layout = CreateTestLayout();
+    GI1CacheSnapshot snapshot;
+    snapshot.captureHashGrid(layout, kFrameIndex, kNumBuckets * layout.num_tiles_per_bucket,
+        hashGrid.hash.data(), hashGrid.decay_tile.data(), hashGrid.bucket_hash.data(), hashGrid.value.data(),
+        hashGrid.value_indirect.data());
+    snapshot.captureReservoirs(reservoirs.hash.data(), reservoirs.hash_count.data(),
+        reservoirs.hash_index.data(), reservoirs.hash_value.data(), reservoirs.indirect_sample_normal.data(),
+        reservoirs.indirect_sample_reservoir.data());
+    return snapshot;
+}
+
+class GI1CacheSnapshotTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path()
+                   / (std::string("capsaicin_gi1_cache_snapshot_")
+                       + testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    std::filesystem::path directory_;
+};
+} // namespace
+
+TEST_F(GI1CacheSnapshotTest, RoundTrip)
+{
+    GI1CacheSnapshot::HashGridBuffers  hashGrid;
+    GI1CacheSnapshot::ReservoirBuffers reservoirs;
+    GI1CacheSnapshot const             snapshot = CreateTestSnapshot(hashGrid, reservoirs);
+    EXPECT_EQ(snapshot.getTileCount(), 15U);
+    auto const filePath = directory_ / "snapshot.gi1cache";
+    ASSERT_TRUE(snapshot.save(filePath));
+
+    GI1CacheSnapshot loaded;
+    ASSERT_TRUE(loaded.load(filePath));
+    EXPECT_TRUE(loaded.isHashGridCompatible(CreateTestLayout()));
+    EXPECT_TRUE(loaded.isReservoirCompatible(CreateTestLayout()));
+
+    // Restoring at a later frame with the same bucket count reproduces the original buffers
+    GI1CacheSnapshot::HashGridBuffers restoredHashGrid;
+    EXPECT_EQ(loaded.restoreHashGrid(kNumBuckets, kFrameIndex + 10, restoredHashGrid), 15U);
+    EXPECT_EQ(restoredHashGrid.hash, hashGrid.hash);
+    EXPECT_EQ(restoredHashGrid.bucket_hash, hashGrid.bucket_hash);
+    for (size_t tile_index = 0; tile_index < hashGrid.hash.size(); ++tile_index)
+    {
+        if (hashGrid.hash[tile_index] != 0)
+        {
+            EXPECT_EQ(restoredHashGrid.decay_tile[tile_index], hashGrid.decay_tile[tile_index] + 10);
+        }
+    }
+    size_t const cell_value_count = 2 * size_t {CreateTestLayout().num_cells_per_tile};
+    for (uint32_t const tile_index : restoredHashGrid.packed_tile_index)
+    {
+        auto const offset = static_cast<ptrdiff_t>(tile_index * cell_value_count);
+        EXPECT_TRUE(std::equal(hashGrid.value.begin() + offset,
+            hashGrid.value.begin() + offset + static_cast<ptrdiff_t>(cell_value_count),
+            restoredHashGrid.value.begin() + offset));
+        EXPECT_TRUE(std::equal(hashGrid.value_indirect.begin() + offset,
+            hashGrid.value_indirect.begin() + offset + static_cast<ptrdiff_t>(cell_value_count),
+            restoredHashGrid.value_indirect.begin() + offset));
+    }
+
+    GI1CacheSnapshot::ReservoirBuffers restoredReservoirs;
+    loaded.restoreReservoirs(restoredReservoirs);
+    EXPECT_EQ(restoredReservoirs.hash, reservoirs.hash);
+    EXPECT_EQ(restoredReservoirs.hash_count, reservoirs.hash_count);
+    EXPECT_EQ(restoredReservoirs.hash_index, reservoirs.hash_index);
+    EXPECT_TRUE(std::equal(restoredReservoirs.hash_value.begin(), restoredReservoirs.hash_value.begin() + 12,
+        reservoirs.hash_value.begin()));
+    EXPECT_EQ(restoredReservoirs.indirect_sample_normal, reservoirs.indirect_sample_normal);
+    EXPECT_EQ(restoredReservoirs.indirect_sample_reservoir, reservoirs.indirect_sample_reservoir);
+
+    // Only the snapshot should be left behind, never any temporary files
+    for (auto const &entry : std::filesystem::directory_iterator(directory_))
+    {
+        EXPECT_EQ(entry.path(), filePath);
+    }
+}
+
+TEST_F(GI1CacheSnapshotTest, RestoresIntoDifferentBucketCount)
+{
+    GI1CacheSnapshot::HashGridBuffers  hashGrid;
+    GI1CacheSnapshot::ReservoirBuffers reservoirs;
+    GI1CacheSnapshot const             snapshot = CreateTestSnapshot(hashGrid, reservoirs);
+    GI1CacheSnapshot::HashGridBuffers  restored;
+
+    // Halving the bucket count merges pairs of buckets, tiles that no longer fit are dropped
+    uint32_t const restoredCount = snapshot.restoreHashGrid(kNumBuckets / 2, kFrameIndex, restored);
+    EXPECT_LE(restoredCount, snapshot.getTileCount());
+    EXPECT_EQ(restored.hash.size(), kNumBuckets / 2 * CreateTestLayout().num_tiles_per_bucket);
+    EXPECT_EQ(restored.packed_tile_index.size(), restoredCount);
+    for (uint32_t const tile_index : restored.packed_tile_index)
+    {
+        EXPECT_NE(restored.hash[tile_index], 0U);
+        EXPECT_EQ(restored.bucket_hash[tile_index] % (kNumBuckets / 2),
+            tile_index / CreateTestLayout().num_tiles_per_bucket);
+    }
+}
+
+TEST_F(GI1CacheSnapshotTest, RejectsIncompatibleLayout)
+{
+    GI1CacheSnapshot::HashGridBuffers  hashGrid;
+    GI1CacheSnapshot::ReservoirBuffers reservoirs;
+    GI1CacheSnapshot const             snapshot = CreateTestSnapshot(hashGrid, reservoirs);
+
+    auto layout            = CreateTestLayout();
+    layout.use_multibounce = 0;
+    EXPECT_FALSE(snapshot.isHashGridCompatible(layout));
+    EXPECT_TRUE(snapshot.isReservoirCompatible(layout));
+    layout                       = CreateTestLayout();
+    layout.reservoir_num_samples = 16;
+    EXPECT_TRUE(snapshot.isHashGridCompatible(layout));
+    EXPECT_FALSE(snapshot.isReservoirCompatible(layout));
+    EXPECT_FALSE(GI1CacheSnapshot().isHashGridCompatible(CreateTestLayout()));
+}
+
+TEST_F(GI1CacheSnapshotTest, RejectsTruncatedFile)
+{
+    GI1CacheSnapshot::HashGridBuffers  hashGrid;
+    GI1CacheSnapshot::ReservoirBuffers reservoirs;
+    auto const                         filePath = directory_ / "snapshot.gi1cache";
+    ASSERT_TRUE(CreateTestSnapshot(hashGrid, reservoirs).save(filePath));
+    auto const        fileSize = std::filesystem::file_size(filePath);
+    std::vector<char> data(fileSize);
+    std::ifstream(filePath, std::ios::binary).read(data.data(), static_cast<std::streamsize>(fileSize));
+
+    // Every truncation point must be rejected, including those within the header
+    auto const truncatedPath = directory_ / "truncated.gi1cache";
+    for (size_t size = 0; size < fileSize; ++size)
+    {
+        std::ofstream(truncatedPath, std::ios::binary | std::ios::trunc)
+            .write(data.data(), static_cast<std::streamsize>(size));
+        GI1CacheSnapshot loaded;
+        EXPECT_FALSE(loaded.load(truncatedPath)) << size;
+        EXPECT_EQ(loaded.getTileCount(), 0U) << size;
+    }
+}
+
+TEST_F(GI1CacheSnapshotTest, RejectsCorruptHeader)
+{
+    GI1CacheSnapshot::HashGridBuffers  hashGrid;
+    GI1CacheSnapshot::ReservoirBuffers reservoirs;
+    auto const                         filePath = directory_ / "snapshot.gi1cache";
+    ASSERT_TRUE(CreateTestSnapshot(hashGrid, reservoirs).save(filePath));
+    auto const        fileSize = std::filesystem::file_size(filePath);
+    std::vector<char> data(fileSize);
+    std::ifstream(filePath, std::ios::binary).read(data.data(), static_cast<std::streamsize>(fileSize));
+
+    // Magic and version
+    for (size_t const offset : {0U, 4U})
+    {
+        auto corrupt = data;
+        corrupt[offset] ^= 0x1;
+        std::ofstream(filePath, std::ios::binary | std::ios::trunc)
+            .write(corrupt.data(), static_cast<std::streamsize>(fileSize));
+        EXPECT_FALSE(GI1CacheSnapshot().load(filePath)) << offset;
+    }
+    EXPECT_FALSE(GI1CacheSnapshot().load(directory_ / "missing.gi1cache"));
+}
+
+TEST_F(GI1CacheSnapshotTest, FilePathDependsOnFullScenePath)
+{
+    auto const path = GI1CacheSnapshot::GetFilePath(directory_, "a/scene.gltf", "sky.hdr", "Main Camera");
+    EXPECT_EQ(path.parent_path(), directory_);
+    EXPECT_EQ(path.extension(), ".gi1cache");
+    EXPECT_TRUE(path.filename().string().starts_with("scene_sky_MainCamera_")) << path;
+    EXPECT_EQ(path, GI1CacheSnapshot::GetFilePath(directory_, "a/b/../scene.gltf", "sky.hdr", "Main Camera"));
+
+    // Same named scenes and environment maps in different directories must not share a snapshot
+    EXPECT_NE(path, GI1CacheSnapshot::GetFilePath(directory_, "b/scene.gltf", "sky.hdr", "Main Camera"));
+    EXPECT_NE(path, GI1CacheSnapshot::GetFilePath(directory_, "a/scene.gltf", "b/sky.hdr", "Main Camera"));
+    EXPECT_NE(path, GI1CacheSnapshot::GetFilePath(directory_, "a/scene.gltf", "sky.hdr", "Other Camera"));
+    EXPECT_NE(path, GI1CacheSnapshot::GetFilePath(directory_, "a/scene.gltf", "", "Main Camera"));
+}
@@ -0,0 +1,259 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "utilities/gpu_sort_simulator.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Segment layout of a segmented sort. */
+struct Segments
+{
+    std::vector<uint> keyOffsets;
+    std::vector<uint> numKeys;
+    uint              totalKeys = 0; /**< Size of the key buffer including any gaps */
+};
+
+/**
+ * Create random segments, optionally separated by gaps of keys that are not part of any segment.
+ * @param random      Random number generator.
+ * @param numSegments Number of segments to create.
+ * @param maxKeys     Maximum number of keys in a segment, some segments are left empty.
+ * @param strided     True to leave gaps between segments.
+ * @return The segment layout.
+ */
+Segments CreateSegments(std::mt19937 &random, uint const numSegments, uint const maxKeys, bool const strided)
+{
+    Segments segments;
+    for (uint i = 0; i < numSegments; ++i)
+    {
+        uint const keys = (i % 5 == 3) ? 0 : random() % (maxKeys + 1);
+        segments.totalKeys += strided ? random() % 100 : 0;
+        segments.keyOffsets.push_back(segments.totalKeys);
+        segments.numKeys.push_back(keys);
+        segments.totalKeys += keys;
+    }
+    segments.totalKeys += strided ? 37 : 0;
+    return segments;
+}
+
+/**
+ * Sort a segmented key buffer with std::stable_sort on the low key bits.
+ * @param [in,out] keys       The keys to sort.
+ * @param [in,out] payload    The payload of each key.
+ * @param          segments   The segment layout.
+ * @param          keyBits    The number of low bits to sort on, rounded up to whole radix passes.
+ * @param          descending True to sort from largest to smallest.
+ */
+void ReferenceSort(std::vector<uint> &keys, std::vector<uint> &payload, Segments const &segments,
+    uint const keyBits, bool const descending)
+{
+    uint const sortBits = GPUSortSimulator::GetPassCount(keyBits) * GPUSORT_BITS_PER_PASS;
+    uint const mask     = sortBits >= 32 ? UINT_MAX : (1U << sortBits) - 1;
+    for (size_t segment = 0; segment < segments.numKeys.size(); ++segment)
+    {
+        uint const                         offset = segments.keyOffsets[segment];
+        std::vector<std::pair<uint, uint>> pairs;
+        for (uint i = 0; i < segments.numKeys[segment]; ++i)
+        {
+            pairs.emplace_back(keys[offset + i], payload[offset + i]);
+        }
+        std::stable_sort(pairs.begin(), pairs.end(), [&](auto const &a, auto const &b) {
+            return descending ? (a.first & mask) > (b.first & mask) : (a.first & mask) < (b.first & mask);
+        });
+        for (uint i = 0; i < segments.numKeys[segment]; ++i)
+        {
+            keys[offset + i]    = pairs[i].first;
+            payload[offset + i] = pairs[i].second;
+        }
+    }
+}
+
+/** Check the simulator against the reference sort over key widths and sort orders. */
+void CheckSort(Segments const &segments, uint const seed)
+{
+    std::mt19937 random(seed);
+    // 12 bits checks an odd pass count, 6 bits checks keys with bits above the 2 sorted passes
+    for (uint const keyBits : {4U, 6U, 12U, 32U})
+    {
+        for (bool const descending : {false, true})
+        {
+            std::vector<uint> keys(segments.totalKeys);
+
+            uint const keyRange = keyBits == 6 ? 0xFFFU : (keyBits >= 32 ? UINT_MAX : (1U << keyBits) - 1);
+            for (uint &key : keys)
+            {
+                key = random() & keyRange;
+            }
+            std::vector<uint> payload(keys.size());
+            std::iota(payload.begin(), payload.end(), 0U);
+            std::vector<uint> expectedKeys    = keys;
+            std::vector<uint> expectedPayload = payload;
+            ReferenceSort(expectedKeys, expectedPayload, segments, keyBits, descending);
+            GPUSortSimulator::Sort(
+                keys, &payload, segments.keyOffsets, segments.numKeys, keyBits, descending);
+            ASSERT_EQ(keys, expectedKeys) << keyBits << " bits, descending " << descending;
+            ASSERT_EQ(payload, expectedPayload) << keyBits << " bits, descending " << descending;
+        }
+    }
+}
+} // namespace
+
+TEST(GPUSortSimulator, SortsStridedSegments)
+{
+    std::mt19937 random(1U);
+    CheckSort(CreateSegments(random, 23, 3000, true), 2U);
+}
+
+TEST(GPUSortSimulator, SortsPackedSegments)
+{
+    std::mt19937 random(3U);
+    CheckSort(CreateSegments(random, 40, 2000, false), 4U);
+}
+
+TEST(GPUSortSimulator, SortsSegmentsSharingThreadGroups)
+{
+    // Large segments need more blocks than there are thread groups, so each group processes several blocks
+    Segments segments;
+    segments.keyOffsets = {0, 300000, 300001, 300500};
+    segments.numKeys    = {300000, 1, 499, 250000};
+    segments.totalKeys  = 550500;
+    CheckSort(segments, 5U);
+}
+
+TEST(GPUSortSimulator, DistributesThreadGroups)
+{
+    std::mt19937 random(6U);
+    for (uint const maxKeys : {100U, 5000U, 200000U})
+    {
+        Segments const                   segments = CreateSegments(random, 30, maxKeys, true);
+        GPUSortSimulator::Dispatch const dispatch =
+            GPUSortSimulator::MakeDispatch(segments.keyOffsets, segments.numKeys);
+        ASSERT_EQ(dispatch.segments.size(), segments.numKeys.size());
+        uint groupOffset       = 0;
+        uint reduceGroupOffset = 0;
+        for (size_t i = 0; i < dispatch.segments.size(); ++i)
+        {
+            GPUSortConstants const &constants = dispatch.constants[i];
+            EXPECT_EQ(dispatch.segments[i].keyOffset, segments.keyOffsets[i]);
+            EXPECT_EQ(dispatch.segments[i].groupOffset, groupOffset);
+            EXPECT_EQ(dispatch.segments[i].reduceGroupOffset, reduceGroupOffset);
+            EXPECT_EQ(constants.numKeys, segments.numKeys[i]);
+            if (segments.numKeys[i] == 0)
+            {
+                EXPECT_EQ(constants.numThreadGroups, 0U);
+            }
+            else
+            {
+                // Every block must be processed by exactly one thread group
+                uint const numBlocks = (segments.numKeys[i] + GPUSORT_BLOCK_SIZE - 1) / GPUSORT_BLOCK_SIZE;
+                EXPECT_EQ(static_cast<uint>(constants.numBlocksPerThreadGroup) * constants.numThreadGroups
+                              + constants.numThreadGroupsWithAdditionalBlocks,
+                    numBlocks);
+            }
+            groupOffset       += constants.numThreadGroups;
+            reduceGroupOffset += constants.numScanValues;
+        }
+        EXPECT_EQ(dispatch.numThreadGroups, groupOffset);
+        EXPECT_EQ(dispatch.numReduceThreadGroups, reduceGroupOffset);
+        EXPECT_LE(dispatch.numThreadGroups, GPUSORT_MAX_THREAD_GROUPS + segments.numKeys.size());
+
+        // The scratch buffers allocated for the maximum key count must fit the dispatch
+        uint sumTableSize    = 0;
+        uint reduceTableSize = 0;
+        GPUSortSimulator::GetScratchSize(
+            static_cast<uint>(segments.numKeys.size()), segments.totalKeys, sumTableSize, reduceTableSize);
+        EXPECT_LE(GPUSORT_BIN_COUNT * dispatch.numThreadGroups, sumTableSize);
+        EXPECT_LE(dispatch.numReduceThreadGroups, reduceTableSize);
+    }
+}
+
+TEST(GPUSortSimulator, Sorts64BitKeys)
+{
+    std::mt19937                            random(7U);
+    std::uniform_int_distribution<uint64_t> distribution;
+    std::mt19937                            segmentRandom(8U);
+    Segments const                          segments = CreateSegments(segmentRandom, 9, 3000, true);
+    for (bool const descending : {false, true})
+    {
+        std::vector<uint64_t> keys(segments.totalKeys);
+        for (uint64_t &key : keys)
+        {
+            key = distribution(random);
+        }
+        std::vector<uint64_t> expected = keys;
+        for (size_t segment = 0; segment < segments.numKeys.size(); ++segment)
+        {
+            auto const begin = expected.begin() + segments.keyOffsets[segment];
+            std::sort(begin, begin + segments.numKeys[segment]);
+            if (descending)
+            {
+                std::reverse(begin, begin + segments.numKeys[segment]);
+            }
+        }
+        // A full width sort orders on the high word after the low word
+        GPUSortSimulator::Sort(keys, segments.keyOffsets, segments.numKeys, 64, descending);
+        EXPECT_EQ(keys, expected) << "descending " << descending;
+    }
+}
+
+TEST(GPUSortSimulator, DerivesPassCountFromKeys)
+{
+    EXPECT_EQ(GPUSortSimulator::GetDerivedPassCount(0), 2U);
+    EXPECT_EQ(GPUSortSimulator::GetDerivedPassCount(0xFFU), 2U);
+    EXPECT_EQ(GPUSortSimulator::GetDerivedPassCount(0x100U), 4U);
+    EXPECT_EQ(GPUSortSimulator::GetDerivedPassCount(0xFFFFU), 4U);
+    EXPECT_EQ(GPUSortSimulator::GetDerivedPassCount(0x10000U), 6U);
+    EXPECT_EQ(GPUSortSimulator::GetDerivedPassCount(UINT_MAX), 8U);
+    EXPECT_EQ(GPUSortSimulator::GetDerivedPassCount(UINT_MAX, 1), 10U);
+    EXPECT_EQ(GPUSortSimulator::GetDerivedPassCount(0, UINT_MAX), 16U);
+
+    // A derived sort must match a full width sort, keys outside of any segment do not widen the range
+    std::mt19937   random(9U);
+    Segments const segments = CreateSegments(random, 12, 2000, true);
+    for (uint const keyRange : {0U, 0x3FFU, 0xFFFFFU})
+    {
+        std::vector<uint> keys(segments.totalKeys, UINT_MAX);
+        for (size_t segment = 0; segment < segments.numKeys.size(); ++segment)
+        {
+            for (uint i = 0; i < segments.numKeys[segment]; ++i)
+            {
+                keys[segments.keyOffsets[segment] + i] = random() & keyRange;
+            }
+        }
+        std::vector<uint> payload(keys.size());
+        std::iota(payload.begin(), payload.end(), 0U);
+        std::vector<uint> expectedKeys    = keys;
+        std::vector<uint> expectedPayload = payload;
+        ReferenceSort(expectedKeys, expectedPayload, segments, 32, false);
+        GPUSortSimulator::Sort(keys, &payload, segments.keyOffsets, segments.numKeys, 0, false);
+        EXPECT_EQ(keys, expectedKeys) << "range " << keyRange;
+        EXPECT_EQ(payload, expectedPayload) << "range " << keyRange;
+    }
+}
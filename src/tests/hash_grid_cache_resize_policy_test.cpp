@@ -0,0 +1,192 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "render_techniques/gi1/hash_grid_cache_resize_policy.h"
+
+#include <gtest/gtest.h>
+
+using namespace Capsaicin;
+
+namespace
+{
+constexpr uint32_t kNumBuckets         = 10;
+constexpr uint32_t kNumTilesPerBucket  = 4;
+constexpr uint32_t kCapacity           = 1U << (kNumBuckets + kNumTilesPerBucket);
+constexpr uint32_t kMaxUpdatesPerCheck = 1000;
+
+uint32_t GetLiveTiles(float const load_factor, uint32_t const num_buckets = kNumBuckets)
+{
+    return static_cast<uint32_t>(load_factor * static_cast<float>(1U << (num_buckets + kNumTilesPerBucket)));
+}
+
+/** Counts the frames until the policy requests a resize, returns the request through num_buckets. */
+uint32_t CountFramesUntilResize(HashGridCacheResizePolicy &policy,
+    HashGridCacheResizePolicy::Settings const &settings, uint32_t const live_tiles,
+    uint32_t const overflow_count, uint32_t &num_buckets)
+{
+    for (uint32_t frame = 1; frame <= kMaxUpdatesPerCheck; ++frame)
+    {
+        num_buckets = policy.update(settings, live_tiles, overflow_count);
+        if (num_buckets != policy.getNumBuckets())
+        {
+            return frame;
+        }
+    }
+    return 0;
+}
+} // namespace
+
+TEST(HashGridCacheResizePolicy, GrowsAfterDelay)
+{
+    HashGridCacheResizePolicy::Settings const settings;
+    HashGridCacheResizePolicy                 policy;
+    policy.reset(kNumBuckets, kNumTilesPerBucket);
+    uint32_t num_buckets = 0;
+    EXPECT_EQ(
+        CountFramesUntilResize(policy, settings, GetLiveTiles(0.9F), 0, num_buckets), settings.grow_delay);
+    EXPECT_EQ(num_buckets, kNumBuckets + 1);
+}
+
+TEST(HashGridCacheResizePolicy, GrowsOnOverflow)
+{
+    HashGridCacheResizePolicy::Settings const settings;
+    HashGridCacheResizePolicy                 policy;
+    policy.reset(kNumBuckets, kNumTilesPerBucket);
+    uint32_t       num_buckets    = 0;
+    uint32_t const overflow_count = static_cast<uint32_t>(2.0F * settings.grow_overflow_ratio * kCapacity);
+    EXPECT_EQ(CountFramesUntilResize(policy, settings, GetLiveTiles(0.5F), overflow_count, num_buckets),
+        settings.grow_delay);
+    EXPECT_EQ(num_buckets, kNumBuckets + 1);
+}
+
+TEST(HashGridCacheResizePolicy, ShrinksAfterDelay)
+{
+    HashGridCacheResizePolicy::Settings const settings;
+    HashGridCacheResizePolicy                 policy;
+    policy.reset(kNumBuckets, kNumTilesPerBucket);
+    uint32_t num_buckets = 0;
+    EXPECT_EQ(
+        CountFramesUntilResize(policy, settings, GetLiveTiles(0.1F), 0, num_buckets), settings.shrink_delay);
+    EXPECT_EQ(num_buckets, kNumBuckets - 1);
+}
+
+TEST(HashGridCacheResizePolicy, KeepsSizeWithinHysteresisBand)
+{
+    HashGridCacheResizePolicy::Settings settings;
+    settings.shrink_load_factor = 0.4F;
+    HashGridCacheResizePolicy policy;
+    uint32_t                  num_buckets = 0;
+    // Between the thresholds nothing happens
+    policy.reset(kNumBuckets, kNumTilesPerBucket);
+    EXPECT_EQ(CountFramesUntilResize(policy, settings, GetLiveTiles(0.5F), 0, num_buckets), 0U);
+    // Below the shrink threshold but shrinking would immediately cross the grow threshold
+    policy.reset(kNumBuckets, kNumTilesPerBucket);
+    EXPECT_EQ(CountFramesUntilResize(policy, settings, GetLiveTiles(0.39F), 0, num_buckets), 0U);
+    // Low load but with some overflow, shrinking would only make it worse
+    policy.reset(kNumBuckets, kNumTilesPerBucket);
+    uint32_t const overflow_count = static_cast<uint32_t>(0.5F * settings.grow_overflow_ratio * kCapacity);
+    EXPECT_EQ(CountFramesUntilResize(policy, settings, GetLiveTiles(0.1F), overflow_count, num_buckets), 0U);
+}
+
+TEST(HashGridCacheResizePolicy, IgnoresShortSpikes)
+{
+    HashGridCacheResizePolicy::Settings const settings;
+    HashGridCacheResizePolicy                 policy;
+    policy.reset(kNumBuckets, kNumTilesPerBucket);
+    for (uint32_t frame = 0; frame < 100; ++frame)
+    {
+        uint32_t const live_tiles = GetLiveTiles(frame % 20 == 0 ? 1.0F : 0.5F);
+        EXPECT_EQ(policy.update(settings, live_tiles, 0), kNumBuckets) << "frame " << frame;
+    }
+    EXPECT_LT(policy.getLoadFactor(), settings.grow_load_factor);
+}
+
+TEST(HashGridCacheResizePolicy, RescalesAndCoolsDownAfterResize)
+{
+    HashGridCacheResizePolicy::Settings const settings;
+    HashGridCacheResizePolicy                 policy;
+    policy.reset(kNumBuckets, kNumTilesPerBucket);
+    uint32_t num_buckets = 0;
+    ASSERT_NE(CountFramesUntilResize(policy, settings, GetLiveTiles(1.0F), 0, num_buckets), 0U);
+    float const load_factor = policy.getLoadFactor();
+    policy.resize(settings, num_buckets);
+    EXPECT_EQ(policy.getNumBuckets(), kNumBuckets + 1);
+    EXPECT_FLOAT_EQ(policy.getLoadFactor(), 0.5F * load_factor);
+
+    // The same number of tiles now fills the larger table, which must wait out the cool down
+    uint32_t const live_tiles = GetLiveTiles(1.0F, kNumBuckets + 1);
+    EXPECT_EQ(CountFramesUntilResize(policy, settings, live_tiles, 0, num_buckets),
+        settings.cooldown + settings.grow_delay);
+    EXPECT_EQ(num_buckets, kNumBuckets + 2);
+    policy.resize(settings, kNumBuckets);
+    EXPECT_EQ(policy.getNumBuckets(), kNumBuckets);
+}
+
+TEST(HashGridCacheResizePolicy, EnforcesBucketLimits)
+{
+    HashGridCacheResizePolicy::Settings settings;
+    settings.min_num_buckets = kNumBuckets - 1;
+    settings.max_num_buckets = kNumBuckets;
+    HashGridCacheResizePolicy policy;
+    uint32_t                  num_buckets = 0;
+    // Never grows past the maximum or shrinks past the minimum
+    policy.reset(kNumBuckets, kNumTilesPerBucket);
+    EXPECT_EQ(CountFramesUntilResize(policy, settings, GetLiveTiles(1.0F), kCapacity, num_buckets), 0U);
+    policy.reset(kNumBuckets - 1, kNumTilesPerBucket);
+    EXPECT_EQ(CountFramesUntilResize(policy, settings, 0, 0, num_buckets), 0U);
+    // Tables outside the limits are resized right away, even during the cool down
+    policy.resize(settings, kNumBuckets + 2);
+    EXPECT_EQ(policy.update(settings, 0, 0), kNumBuckets);
+    policy.reset(kNumBuckets - 3, kNumTilesPerBucket);
+    EXPECT_EQ(policy.update(settings, 0, 0), kNumBuckets - 1);
+    // The limits themselves are clamped to the supported range
+    settings.min_num_buckets = 0;
+    settings.max_num_buckets = 100;
+    policy.reset(HashGridCacheResizePolicy::kMaxNumBuckets + 1, kNumTilesPerBucket);
+    EXPECT_EQ(policy.update(settings, 0, 0), HashGridCacheResizePolicy::kMaxNumBuckets);
+    policy.reset(HashGridCacheResizePolicy::kMinNumBuckets - 1, kNumTilesPerBucket);
+    EXPECT_EQ(policy.update(settings, 0, 0), HashGridCacheResizePolicy::kMinNumBuckets);
+}
+
+TEST(HashGridCacheResizePolicy, CalculatesBucketRangeFromMemory)
+{
+    using Policy = HashGridCacheResizePolicy;
+    EXPECT_EQ(Policy::GetBucketRange(1024, 1ULL << 20, 16ULL << 20), std::make_pair(10U, 14U));
+    EXPECT_EQ(Policy::GetBucketRange(1024, 1ULL << 20, (16ULL << 20) - 1), std::make_pair(10U, 13U));
+    EXPECT_EQ(Policy::GetBucketRange(1024, (1ULL << 20) + 1, 16ULL << 20), std::make_pair(11U, 14U));
+    // The maximum takes precedence over the minimum
+    EXPECT_EQ(Policy::GetBucketRange(1024, 64ULL << 20, 16ULL << 20), std::make_pair(14U, 14U));
+    // Results are limited to the supported range
+    EXPECT_EQ(Policy::GetBucketRange(1024, 0, ~0ULL >> 12),
+        std::make_pair(Policy::kMinNumBuckets, Policy::kMaxNumBuckets));
+    EXPECT_EQ(
+        Policy::GetBucketRange(1024, 0, 0), std::make_pair(Policy::kMinNumBuckets, Policy::kMinNumBuckets));
+    EXPECT_EQ(
+        Policy::GetBucketRange(0, 0, 1), std::make_pair(Policy::kMinNumBuckets, Policy::kMinNumBuckets));
+}
+
+TEST(HashGridCacheResizePolicy, CalculatesTileMemory)
+{
+    // 8x8 + 4x4 + 2x2 + 1x1 cells of 6 words (value uint2 plus 4 accumulators) and 5 words of tile data
+    EXPECT_EQ(HashGridCacheResizePolicy::GetBytesPerTile(85, false), 20U + 85U * 24U);
+    EXPECT_EQ(HashGridCacheResizePolicy::GetBytesPerTile(85, true), 20U + 85U * 48U);
+}
@@ -0,0 +1,159 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "hash_grid_cache_simulator.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace Capsaicin;
+
+namespace
+{
+constexpr uint32_t kHitsPerFrame = 8192;
+
+/**
+ * Creates a frame of queries using only integer arithmetic and exactly representable scales, so that the
+ * queries are identical on all platforms.
+ */
+HitFrame CreateTestFrame(uint32_t const frameIndex)
+{
+    constexpr float directions[6][3] = {
+        {1.0F, 0.0F, 0.0F},
+        {-1.0F, 0.0F, 0.0F},
+        {0.0F, 1.0F, 0.0F},
+        {0.0F, -1.0F, 0.0F},
+        {0.0F, 0.0F, 1.0F},
+        {0.0F, 0.0F, -1.0F},
+    };
+    HitFrame frame;
+    frame.eye[0] = 0.25F * static_cast<float>(frameIndex);
+    frame.eye[1] = 1.5F;
+    frame.eye[2] = -2.0F;
+    frame.hits.resize(kHitsPerFrame);
+    uint32_t state = frameIndex * 2654435761U + 1U;
+    for (auto &hit : frame.hits)
+    {
+        state            = state * 1664525U + 1013904223U;
+        hit.position[0]  = static_cast<float>(state >> 20) * 0.0078125F - 16.0F;
+        state            = state * 1664525U + 1013904223U;
+        hit.position[1]  = static_cast<float>(state >> 23) * 0.015625F;
+        state            = state * 1664525U + 1013904223U;
+        hit.position[2]  = static_cast<float>(state >> 20) * 0.0078125F - 16.0F;
+        auto const &axis = directions[(state >> 8) % 6];
+        std::copy_n(axis, 3, hit.direction);
+        hit.distance = static_cast<float>((state >> 4) & 0xFF) * 0.0625F;
+    }
+    return frame;
+}
+
+HashGridCacheSimSettings CreateTestSettings()
+{
+    HashGridCacheSimSettings settings;
+    settings.num_buckets = 10;
+    settings.width       = 1280;
+    settings.height      = 720;
+    return settings;
+}
+} // namespace
+
+TEST(HashGridCacheSimulator, MatchesReferenceChecksum)
+{
+    // Any change to the cell hashing (both here and in 'hash_grid_cache.hlsl') changes the checksum, the
+    // reference values must only be updated when this is intended
+    HashGridCacheSimulator  simulator(CreateTestSettings());
+    HashGridCacheFrameStats stats;
+    for (uint32_t frameIndex = 0; frameIndex < 4; ++frameIndex)
+    {
+        stats = simulator.simulateFrame(CreateTestFrame(frameIndex), true);
+    }
+    EXPECT_EQ(simulator.getDescriptorChecksum(), 0x81148E3959919F23ULL);
+    EXPECT_EQ(stats.live_tiles, 2948U);
+    EXPECT_EQ(stats.overflow_count, 0U);
+}
+
+TEST(HashGridCacheSimulator, ChecksumIsIndependentOfOrder)
+{
+    HitFrame               frame = CreateTestFrame(0);
+    HashGridCacheSimulator serial(CreateTestSettings());
+    (void)serial.simulateFrame(frame, true);
+    HashGridCacheSimulator parallel(CreateTestSettings());
+    (void)parallel.simulateFrame(frame, false);
+    std::ranges::reverse(frame.hits);
+    HashGridCacheSimulator reversed(CreateTestSettings());
+    (void)reversed.simulateFrame(frame, true);
+    EXPECT_EQ(parallel.getDescriptorChecksum(), serial.getDescriptorChecksum());
+    EXPECT_EQ(reversed.getDescriptorChecksum(), serial.getDescriptorChecksum());
+}
+
+TEST(HashGridCacheSimulator, FindsTilesAfterResize)
+{
+    HitFrame const         frame = CreateTestFrame(0);
+    HashGridCacheSimulator simulator(CreateTestSettings());
+    auto const             stats = simulator.simulateFrame(frame, true);
+    ASSERT_EQ(stats.overflow_count, 0U);
+    for (uint32_t const num_buckets : {11U, 12U})
+    {
+        ASSERT_EQ(simulator.resize(num_buckets), 0U);
+        for (auto const &hit : frame.hits)
+        {
+            ASSERT_NE(simulator.findTile(simulator.getDesc(frame.eye, hit)), UINT32_MAX);
+        }
+    }
+}
+
+TEST(HashGridCacheSimulator, ReplaysSavedStream)
+{
+    auto const filePath = std::filesystem::temp_directory_path() / "capsaicin_hash_grid_cache_sim_test.hgcs";
+    SyntheticStreamSettings streamSettings;
+    streamSettings.ray_count = 4096;
+    std::vector<HitFrame> frames(3);
+    {
+        HitStreamWriter writer;
+        ASSERT_TRUE(writer.open(filePath));
+        for (uint32_t frameIndex = 0; frameIndex < frames.size(); ++frameIndex)
+        {
+            GenerateSyntheticFrame(streamSettings, frameIndex, frames[frameIndex]);
+            ASSERT_TRUE(writer.writeFrame(frames[frameIndex]));
+        }
+    }
+    HashGridCacheSimulator generated(CreateTestSettings());
+    HashGridCacheSimulator replayed(CreateTestSettings());
+    {
+        HitStreamReader reader;
+        std::string     error;
+        ASSERT_TRUE(reader.open(filePath, error)) << error;
+        HitFrame frame;
+        for (auto const &generatedFrame : frames)
+        {
+            ASSERT_TRUE(reader.readFrame(frame));
+            ASSERT_EQ(frame.hits.size(), generatedFrame.hits.size());
+            auto const generatedStats = generated.simulateFrame(generatedFrame, true);
+            auto const replayedStats  = replayed.simulateFrame(frame, true);
+            EXPECT_EQ(replayedStats.live_tiles, generatedStats.live_tiles);
+            EXPECT_EQ(replayedStats.overflow_count, generatedStats.overflow_count);
+        }
+        EXPECT_FALSE(reader.readFrame(frame));
+    }
+    EXPECT_EQ(replayed.getDescriptorChecksum(), generated.getDescriptorChecksum());
+    std::filesystem::remove(filePath);
+}
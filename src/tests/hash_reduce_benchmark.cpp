@@ -0,0 +1,64 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+#include "hash_reduce.h"
+#include "test_meshes.h"
+
+#include <string>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Measure the cost of tracking a scene's meshes using full content hashes. */
+void HashTrackerMeshes(Benchmark::State &state)
+{
+    uint32_t const       mesh_count = state.size(64, 8);
+    std::vector<GfxMesh> meshes;
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        // Mix of small meshes and large meshes that are hashed in multiple chunks
+        meshes.push_back(Tests::CreateGridMesh(i % 8 == 0 ? state.size(256, 64) : 32, i, i % 4 == 0));
+    }
+    size_t bytes = 0;
+    for (GfxMesh const &mesh : meshes)
+    {
+        bytes += mesh.vertices.size() * sizeof(GfxVertex) + mesh.indices.size() * sizeof(uint32_t)
+               + mesh.morph_targets.size() * sizeof(GfxVertex) + mesh.joints.size() * sizeof(GfxJoint);
+    }
+    std::vector<size_t> hashes(mesh_count);
+    state.run("hash " + std::to_string(bytes >> 20) + "MiB serial", [&] {
+        for (uint32_t i = 0; i < mesh_count; ++i)
+        {
+            hashes[i] = std::hash<GfxMesh> {}(meshes[i]);
+        }
+        Benchmark::KeepAlive(hashes.data());
+    });
+    HashTracker tracker;
+    state.run("tracker update", [&] {
+        tracker.update(meshes.data(), mesh_count, std::hash<GfxMesh> {});
+        Benchmark::KeepAlive(&tracker);
+    });
+}
+CAPSAICIN_BENCHMARK(HashTrackerMeshes);
+} // namespace
@@ -0,0 +1,115 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "hash_reduce.h"
+#include "test_meshes.h"
+
+#include <gtest/gtest.h>
+
+using namespace Capsaicin;
+
+TEST(HashReduce, MeshHashDetectsAnyVertexEdit)
+{
+    // Large enough that the contents are hashed in multiple parallel chunks
+    GfxMesh const mesh     = Tests::CreateGridMesh(96, 1, true);
+    size_t const  original = std::hash<GfxMesh> {}(mesh);
+    EXPECT_EQ(std::hash<GfxMesh> {}(mesh), original);
+    ASSERT_GT(mesh.vertices.size() * sizeof(GfxVertex), 64U * 1024U);
+
+    // Previously only a strided subset of vertices was hashed, so every position must now be checked
+    GfxMesh edited = mesh;
+    for (size_t i = 0; i < edited.vertices.size(); i += 37)
+    {
+        edited.vertices[i].uv.x += 1.0F;
+        EXPECT_NE(std::hash<GfxMesh> {}(edited), original) << "vertex " << i;
+        edited.vertices[i].uv.x = mesh.vertices[i].uv.x;
+    }
+    EXPECT_EQ(std::hash<GfxMesh> {}(edited), original);
+}
+
+TEST(HashReduce, MeshHashDetectsEditsToEveryArray)
+{
+    GfxMesh const mesh     = Tests::CreateGridMesh(8, 2, true);
+    size_t const  original = std::hash<GfxMesh> {}(mesh);
+
+    GfxMesh edited = mesh;
+    std::swap(edited.indices[1], edited.indices[2]);
+    EXPECT_NE(std::hash<GfxMesh> {}(edited), original);
+
+    edited = mesh;
+    edited.morph_targets.back().normal.y = 0.5F;
+    EXPECT_NE(std::hash<GfxMesh> {}(edited), original);
+
+    edited = mesh;
+    edited.joints[edited.joints.size() / 2].joints.y = 1;
+    EXPECT_NE(std::hash<GfxMesh> {}(edited), original);
+
+    // Moving data between arrays must not produce the same hash
+    edited = mesh;
+    edited.morph_targets.clear();
+    edited.joints.clear();
+    GfxMesh moved = edited;
+    moved.vertices.pop_back();
+    moved.morph_targets.push_back(edited.vertices.back());
+    EXPECT_NE(std::hash<GfxMesh> {}(moved), std::hash<GfxMesh> {}(edited));
+}
+
+TEST(HashTracker, ReportsChangedAndRemovedObjects)
+{
+    std::vector<GfxMesh> meshes;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        meshes.push_back(Tests::CreateGridMesh(4, i, false));
+    }
+    std::vector<uint32_t> keys = {10, 11, 12, 13};
+    auto const            key  = [&](uint32_t const i) { return keys[i]; };
+
+    HashTracker tracker;
+    EXPECT_FALSE(tracker.isValid());
+    EXPECT_TRUE(tracker.update(meshes.data(), 4, std::hash<GfxMesh> {}, key));
+    EXPECT_TRUE(tracker.isValid());
+    EXPECT_TRUE(tracker.getCountChanged());
+    EXPECT_EQ(tracker.getChanged(), (std::vector<uint32_t> {0, 1, 2, 3}));
+
+    EXPECT_FALSE(tracker.update(meshes.data(), 4, std::hash<GfxMesh> {}, key));
+    EXPECT_FALSE(tracker.getCountChanged());
+    EXPECT_TRUE(tracker.getChanged().empty());
+    EXPECT_TRUE(tracker.getRemoved().empty());
+
+    // Edit a single vertex in place
+    meshes[2].vertices[5].position.x += 0.5F;
+    EXPECT_TRUE(tracker.update(meshes.data(), 4, std::hash<GfxMesh> {}, key));
+    EXPECT_EQ(tracker.getChanged(), (std::vector<uint32_t> {2}));
+
+    // Remove the first mesh, the remaining meshes keep their history through their keys
+    meshes.erase(meshes.begin());
+    keys.erase(keys.begin());
+    EXPECT_TRUE(tracker.update(meshes.data(), 3, std::hash<GfxMesh> {}, key));
+    EXPECT_TRUE(tracker.getCountChanged());
+    EXPECT_TRUE(tracker.getChanged().empty());
+    EXPECT_EQ(tracker.getRemoved(), (std::vector<uint32_t> {10}));
+
+    tracker.reset();
+    EXPECT_FALSE(tracker.isValid());
+    EXPECT_TRUE(tracker.update(meshes.data(), 3, std::hash<GfxMesh> {}, key));
+    EXPECT_EQ(tracker.getChanged().size(), 3U);
+}
@@ -0,0 +1,264 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "image_comparer.h"
+
+#include <array>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace Capsaicin;
+
+namespace
+{
+MetricImage CreateRandomImage(uint32_t const width, uint32_t const height, uint32_t const seed)
+{
+    MetricImage image;
+    image.width  = width;
+    image.height = height;
+    image.values.resize(static_cast<size_t>(width) * height);
+    std::mt19937                          generator(seed);
+    std::uniform_real_distribution<float> distribution(0.2F, 0.8F);
+    for (float &value : image.values)
+    {
+        value = distribution(generator);
+    }
+    return image;
+}
+
+/**
+ * Direct port of 'CalculateSSIM' from 'gpu_image_metrics.comp', evaluates the full 11x11 window with the
+ * two-pass variance at a single pixel.
+ */
+float ShaderSSIM(MetricImage const &source, MetricImage const &reference, uint32_t const pixelX,
+    uint32_t const pixelY)
+{
+    std::array<std::array<float, 11>, 11> gaussianWeights = {};
+    double                                total           = 0.0;
+    for (int32_t x = 0; x < 11; ++x)
+    {
+        for (int32_t y = 0; y < 11; ++y)
+        {
+            total += exp(-static_cast<double>((x - 5) * (x - 5) + (y - 5) * (y - 5)) / (2.0 * 1.5 * 1.5));
+        }
+    }
+    for (int32_t x = 0; x < 11; ++x)
+    {
+        for (int32_t y = 0; y < 11; ++y)
+        {
+            gaussianWeights[x][y] = static_cast<float>(
+                exp(-static_cast<double>((x - 5) * (x - 5) + (y - 5) * (y - 5)) / (2.0 * 1.5 * 1.5)) / total);
+        }
+    }
+    float const sumSquaredWeights = 0.0353944717F;
+
+    int32_t const offset    = 5;
+    int32_t const width     = static_cast<int32_t>(reference.width);
+    int32_t const height    = static_cast<int32_t>(reference.height);
+    int32_t const didX      = static_cast<int32_t>(pixelX);
+    int32_t const didY      = static_cast<int32_t>(pixelY);
+    auto const    getValues = [&](int32_t const x, int32_t const y) {
+        size_t const index = static_cast<size_t>(y) * reference.width + static_cast<size_t>(x);
+        return std::array {source.values[index], reference.values[index]};
+    };
+
+    float         sampleMeanInput     = 0.0F;
+    float         sampleMeanReference = 0.0F;
+    int32_t const minX                = std::max(offset - didX, 0);
+    int32_t const maxX                = std::min(offset + width - didX, 11);
+    int32_t const minY                = std::max(offset - didY, 0);
+    int32_t const maxY                = std::min(offset + height - didY, 11);
+    for (int32_t x = minX; x < maxX; ++x)
+    {
+        for (int32_t y = minY; y < maxY; ++y)
+        {
+            auto const  values      = getValues(didX + x - offset, didY + y - offset);
+            float const pixelWeight = gaussianWeights[x][y];
+            sampleMeanInput        += values[0] * pixelWeight;
+            sampleMeanReference    += values[1] * pixelWeight;
+        }
+    }
+
+    float varianceInput     = 0.0F;
+    float varianceReference = 0.0F;
+    float crossCorrelation  = 0.0F;
+    for (int32_t x = minX; x < maxX; ++x)
+    {
+        for (int32_t y = minY; y < maxY; ++y)
+        {
+            auto const  values       = getValues(didX + x - offset, didY + y - offset);
+            float const pixelWeight  = gaussianWeights[x][y];
+            float const inputSq      = values[0] - sampleMeanInput;
+            float const referenceSq  = values[1] - sampleMeanReference;
+            varianceInput           += inputSq * inputSq * pixelWeight;
+            varianceReference       += referenceSq * referenceSq * pixelWeight;
+            crossCorrelation        += inputSq * referenceSq * pixelWeight;
+        }
+    }
+    varianceInput     = std::max(varianceInput / (1.0F - sumSquaredWeights), 0.0F);
+    varianceReference = std::max(varianceReference / (1.0F - sumSquaredWeights), 0.0F);
+    crossCorrelation /= 1.0F - sumSquaredWeights;
+
+    float const c1       = 0.01F * 0.01F;
+    float const c2       = 0.03F * 0.03F;
+    float const value1   = (2.0F * sampleMeanInput * sampleMeanReference) + c1;
+    float const value2   = (2.0F * crossCorrelation) + c2;
+    float const divisor1 =
+        (sampleMeanInput * sampleMeanInput) + (sampleMeanReference * sampleMeanReference) + c1;
+    float const divisor2 = varianceInput + varianceReference + c2;
+    return (value1 * value2) / (divisor1 * divisor2);
+}
+
+/** Port of 'ComputeMetric' from 'gpu_image_metrics.comp' with the per-pixel values summed on the CPU. */
+ImageMetricValues ShaderMetrics(MetricImage const &source, MetricImage const &reference)
+{
+    double squaredError = 0.0;
+    double rmae         = 0.0;
+    double smape        = 0.0;
+    double ssim         = 0.0;
+    for (uint32_t y = 0; y < reference.height; ++y)
+    {
+        for (uint32_t x = 0; x < reference.width; ++x)
+        {
+            size_t const index    = static_cast<size_t>(y) * reference.width + x;
+            float const  input    = source.values[index];
+            float const  ref      = reference.values[index];
+            float const  divisor  = (std::abs(ref) + std::abs(input)) / 2.0F;
+            squaredError         += static_cast<double>((ref - input) * (ref - input));
+            rmae                 += ref != 0.0F ? static_cast<double>(std::abs(ref - input) / ref) : 0.0;
+            smape += divisor != 0.0F ? static_cast<double>(std::abs(ref - input) / divisor) : 0.0;
+            ssim  += static_cast<double>(ShaderSSIM(source, reference, x, y));
+        }
+    }
+    double const      totalPixels = static_cast<double>(reference.width) * reference.height;
+    ImageMetricValues values;
+    values.mse   = squaredError / totalPixels;
+    values.rmse  = sqrt(values.mse);
+    values.psnr  = -10.0 * log10(values.mse);
+    values.rmae  = rmae / totalPixels;
+    values.smape = 100.0 * smape / totalPixels;
+    values.ssim  = ssim / totalPixels;
+    return values;
+}
+
+void ExpectMatchesShader(MetricImage const &source, MetricImage const &reference)
+{
+    ImageMetricValues values;
+    ASSERT_TRUE(CompareImages(source, reference, values));
+    ImageMetricValues const expected = ShaderMetrics(source, reference);
+    EXPECT_NEAR(values.mse, expected.mse, 1e-5 * expected.mse);
+    EXPECT_NEAR(values.rmse, expected.rmse, 1e-5 * expected.rmse);
+    EXPECT_NEAR(values.psnr, expected.psnr, 1e-4);
+    EXPECT_NEAR(values.rmae, expected.rmae, 1e-5 * expected.rmae);
+    EXPECT_NEAR(values.smape, expected.smape, 1e-5 * expected.smape);
+    EXPECT_NEAR(values.ssim, expected.ssim, 1e-6);
+}
+} // namespace
+
+TEST(ImageComparer, IdenticalImages)
+{
+    MetricImage const image = CreateRandomImage(37, 23, 1);
+    ImageMetricValues values;
+    ASSERT_TRUE(CompareImages(image, image, values));
+    EXPECT_EQ(values.mse, 0.0);
+    EXPECT_EQ(values.rmse, 0.0);
+    EXPECT_TRUE(std::isinf(values.psnr));
+    EXPECT_EQ(values.rmae, 0.0);
+    EXPECT_EQ(values.smape, 0.0);
+    EXPECT_NEAR(values.ssim, 1.0, 1e-5);
+}
+
+TEST(ImageComparer, KnownOffset)
+{
+    // A constant offset has a known error and leaves variance unchanged so only the mean term of SSIM drops
+    MetricImage const reference = CreateRandomImage(40, 30, 2);
+    MetricImage       source    = reference;
+    for (float &value : source.values)
+    {
+        value += 0.1F;
+    }
+    ImageMetricValues values;
+    ASSERT_TRUE(CompareImages(source, reference, values));
+    EXPECT_NEAR(values.mse, 0.01, 1e-6);
+    EXPECT_NEAR(values.rmse, 0.1, 1e-5);
+    EXPECT_NEAR(values.psnr, 20.0, 1e-3);
+    EXPECT_LT(values.ssim, 1.0);
+    ExpectMatchesShader(source, reference);
+}
+
+TEST(ImageComparer, MatchesShader)
+{
+    // Sizes cover full vector lanes, remainders and windows clipped on every edge
+    for (auto const [width, height] : {std::array {64U, 48U}, std::array {67U, 13U}, std::array {17U, 90U}})
+    {
+        ExpectMatchesShader(
+            CreateRandomImage(width, height, width), CreateRandomImage(width, height, height + 1));
+    }
+}
+
+TEST(ImageComparer, SmallerThanWindow)
+{
+    for (auto const [width, height] :
+        {std::array {1U, 1U}, std::array {3U, 2U}, std::array {5U, 7U}, std::array {10U, 4U}})
+    {
+        MetricImage const reference = CreateRandomImage(width, height, 3);
+        ExpectMatchesShader(CreateRandomImage(width, height, 4), reference);
+
+        ImageMetricValues values;
+        ASSERT_TRUE(CompareImages(reference, reference, values));
+        EXPECT_NEAR(values.ssim, 1.0, 1e-5);
+    }
+}
+
+TEST(ImageComparer, RejectsMismatchedImages)
+{
+    MetricImage const reference = CreateRandomImage(8, 8, 5);
+    ImageMetricValues values;
+    EXPECT_FALSE(CompareImages(CreateRandomImage(8, 9, 5), reference, values));
+    MetricImage hdr = reference;
+    hdr.hdr         = true;
+    EXPECT_FALSE(CompareImages(hdr, reference, values));
+    EXPECT_FALSE(CompareImages(MetricImage(), MetricImage(), values));
+}
+
+TEST(ImageComparer, FindsReferenceByPrefix)
+{
+    std::vector<std::filesystem::path> const references = {"refs/sponza_sky_camera0_GI-1.exr",
+        "refs/sponza_sky_camera0_GI-1_debug.exr", "refs/sponza_sky_camera0_PathTracer.exr",
+        "refs/sponza_sky_camera1_GI-1.exr"};
+
+    // A single reference is used for every input
+    EXPECT_EQ(FindReferenceImage("out/anything.exr", {"refs/only.png"}), "refs/only.png");
+
+    EXPECT_EQ(FindReferenceImage("out/sponza_sky_camera0_GI-1.exr", references), references[0]);
+    EXPECT_EQ(FindReferenceImage("out/sponza_sky_camera0_GI-1_10_0.5.exr", references), references[0]);
+    EXPECT_EQ(FindReferenceImage("out/sponza_sky_camera1_GI-1_10.png", references), references[3]);
+
+    // The longest matching reference wins
+    EXPECT_EQ(FindReferenceImage("out/sponza_sky_camera0_GI-1_debug_10.exr", references), references[1]);
+
+    // Prefixes must end on a separator
+    EXPECT_EQ(FindReferenceImage("out/sponza_sky_camera0_PathTracer2.exr", references), "");
+    EXPECT_EQ(FindReferenceImage("out/sponza_sky_camera0_GI-10.exr", references), "");
+    EXPECT_EQ(FindReferenceImage("out/bistro_sky_camera0_GI-1.exr", references), "");
+}
@@ -0,0 +1,128 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "image_dump_queue.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace Capsaicin;
+
+TEST(ImageDumpQueue, PushBlocksAtCap)
+{
+    std::atomic<bool>        release = false;
+    ImageDumpQueue<uint32_t> queue;
+    queue.start([&](uint32_t) { release.wait(false); }, 1, 100);
+    queue.push(0, 60);
+    queue.push(1, 40);
+
+    // The queue is full so the next push must wait for a job to complete
+    std::atomic<bool> pushed = false;
+    std::jthread      producer([&] {
+        queue.push(2, 10);
+        pushed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(pushed);
+
+    release = true;
+    release.notify_all();
+    producer.join();
+    EXPECT_TRUE(pushed);
+    queue.flush();
+    EXPECT_EQ(queue.takeCompleted().size(), 3U);
+}
+
+TEST(ImageDumpQueue, AdmitsOversizeJob)
+{
+    std::atomic<uint32_t>    encoded = 0;
+    ImageDumpQueue<uint32_t> queue;
+    queue.start([&](uint32_t) { ++encoded; }, 2, 100);
+
+    // A job larger than the cap is accepted once nothing else is pending instead of blocking forever
+    queue.push(0, 1000);
+    queue.push(1, 1000);
+    queue.flush();
+    EXPECT_EQ(encoded, 2U);
+}
+
+TEST(ImageDumpQueue, EncodesEveryJobOnceBeforeStop)
+{
+    constexpr uint32_t                          jobCount = 1000;
+    std::array<std::atomic<uint32_t>, jobCount> encodeCounts {};
+    ImageDumpQueue<uint32_t>                    queue;
+    queue.start([&](uint32_t const image) { ++encodeCounts[image]; }, 4, 64);
+    EXPECT_TRUE(queue.isStarted());
+    for (uint32_t i = 0; i < jobCount; ++i)
+    {
+        queue.push(uint32_t {i}, 1 + (i % 8));
+    }
+    queue.stop();
+    EXPECT_FALSE(queue.isStarted());
+    for (uint32_t i = 0; i < jobCount; ++i)
+    {
+        EXPECT_EQ(encodeCounts[i], 1U) << "job " << i;
+    }
+
+    // Every image is handed back exactly once so its resources can be released
+    std::vector<uint32_t> completed = queue.takeCompleted();
+    std::ranges::sort(completed);
+    ASSERT_EQ(completed.size(), jobCount);
+    for (uint32_t i = 0; i < jobCount; ++i)
+    {
+        EXPECT_EQ(completed[i], i);
+    }
+}
+
+TEST(ImageDumpQueue, FlushWaitsForInProgressJobs)
+{
+    std::atomic<uint32_t>    encoded = 0;
+    ImageDumpQueue<uint32_t> queue;
+    queue.start(
+        [&](uint32_t) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            ++encoded;
+        },
+        2, 1024);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        queue.push(uint32_t {i}, 16);
+    }
+    queue.flush();
+    EXPECT_EQ(encoded, 10U);
+    EXPECT_TRUE(queue.isStarted());
+
+    // Completed images are only returned once
+    EXPECT_EQ(queue.takeCompleted().size(), 10U);
+    EXPECT_TRUE(queue.takeCompleted().empty());
+
+    // The queue keeps running after a flush
+    queue.push(10, 16);
+    queue.flush();
+    EXPECT_EQ(encoded, 11U);
+    EXPECT_EQ(queue.takeCompleted(), std::vector<uint32_t> {10});
+}
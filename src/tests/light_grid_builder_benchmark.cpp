@@ -0,0 +1,58 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+#include "components/light_sampler_grid_cdf/light_grid_builder.h"
+#include "test_lights.h"
+
+#include <string>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Measure the CDF and stream grid builds across light counts. */
+void LightGridBuild(Benchmark::State &state)
+{
+    LightSamplingConfiguration const config = {
+        uint4(16, 16, 16, 33), float3(6.25F), float3(-50.0F), float3(100.0F)};
+    std::array<float3, 6> const environment = {};
+    for (uint32_t const count : {state.size(100, 10), state.size(1000, 100), state.size(10000, 1000)})
+    {
+        std::vector<Light> const lights = Tests::CreateLights(count, 1, count);
+        LightGridBuilder         builder;
+        builder.setLights(lights, environment);
+        std::vector<uint32_t> cellsIndex;
+        std::vector<float>    cellsCDF;
+        std::vector<float2>   cellsReservoirs;
+        state.run(std::to_string(count) + " lights CDF", [&] {
+            builder.buildCDF(config, {}, cellsIndex, cellsCDF);
+            Benchmark::KeepAlive(cellsCDF.data());
+        });
+        state.run(std::to_string(count) + " lights stream", [&] {
+            builder.buildStream(config, {}, 1, 0, cellsIndex, cellsReservoirs);
+            Benchmark::KeepAlive(cellsReservoirs.data());
+        });
+    }
+}
+CAPSAICIN_BENCHMARK(LightGridBuild);
+} // namespace
@@ -0,0 +1,347 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "components/light_sampler_grid_cdf/light_grid_builder.h"
+#include "test_lights.h"
+
+#include <gtest/gtest.h>
+
+#include <cfloat>
+
+using namespace Capsaicin;
+
+namespace
+{
+/**
+ * Small hand placed scene with one light of each type, values are chosen so no single light dominates.
+ * @note The expected values of the golden tests were captured from this builder rather than from a GPU build,
+ * they only guard against regressions. The other tests derive their expected values independently.
+ */
+std::vector<Light> CreateGoldenLights() noexcept
+{
+    return {
+        MakeEnvironmentLight(8, 256),
+        MakeDirectionalLight(float3(0.02F, 0.015F, 0.01F), float3(0.0F, 1.0F, 0.0F), 1e6F),
+        MakePointLight(float3(50.0F, 40.0F, 30.0F), float3(2.0F, 3.0F, -4.0F), 30.0F),
+        MakeSpotLight(float3(20.0F), float3(-6.0F, 5.0F, 2.0F), 40.0F, float3(0.0F, 1.0F, -0.2F), 0.6F, 0.4F),
+        MakeAreaLight(float3(30.0F, 20.0F, 10.0F), float3(4.0F, -5.0F, 6.0F), float3(6.0F, -5.0F, 6.0F),
+            float3(4.0F, -3.0F, 7.0F)),
+        MakeAreaLight(float3(10.0F, 10.0F, 40.0F), float3(-7.0F, -2.0F, -8.0F), float3(-7.0F, 0.0F, -8.0F),
+            float3(-5.0F, -2.0F, -6.0F)),
+    };
+}
+
+std::array<float3, 6> const GoldenEnvironment = {float3(0.01F), float3(0.002F), float3(0.03F),
+    float3(0.001F), float3(0.005F), float3(0.004F)};
+
+/** 2x2x2 grid covering [-10, 10] storing the 2 most important lights per cell. */
+LightSamplingConfiguration const GoldenConfig = {
+    uint4(2, 2, 2, 3), float3(10.0F), float3(-10.0F), float3(20.0F)};
+
+/** Light luminance weights of a cell in a grid built with all lights, taken from its normalised CDF. */
+std::vector<float> GetCellWeights(
+    std::vector<uint32_t> const &cellsIndex, std::vector<float> const &cellsCDF, uint32_t const cell)
+{
+    std::vector<float> weights(cellsIndex[cell]);
+    float              previous = 0.0F;
+    for (uint32_t i = 0; i < cellsIndex[cell]; ++i)
+    {
+        weights[i] = (cellsCDF[cell + 1 + i] - previous) / cellsCDF[cell];
+        previous   = cellsCDF[cell + 1 + i];
+    }
+    return weights;
+}
+
+void ExpectNear(std::vector<float> const &values, std::vector<float> const &expected)
+{
+    ASSERT_EQ(values.size(), expected.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_NEAR(values[i], expected[i], 1e-5F * std::abs(expected[i])) << "element " << i;
+    }
+}
+} // namespace
+
+TEST(LightGridBuilder, MatchesGoldenCDFGrid)
+{
+    LightGridBuilder builder;
+    builder.setLights(CreateGoldenLights(), GoldenEnvironment);
+    std::vector<uint32_t> cellsIndex;
+    std::vector<float>    cellsCDF;
+    builder.buildCDF(GoldenConfig, {}, cellsIndex, cellsCDF);
+
+    // Each cell is its light count followed by the stored lights, or its CDF scale followed by the CDF
+    std::vector<uint32_t> const expectedIndex = {
+        2, 0, 2, 2, 3, 2, 2, 4, 2, 2, 0, 2, 2, 0, 2, 2, 0, 2, 2, 4, 2, 2, 0, 2};
+    std::vector<float> const expectedCDF = {0.52413356F, 0.44239926F, 1.0F, 0.61230654F, 0.6871953F, 1.0F,
+        0.87288344F, 0.9246698F, 1.0F, 0.51776314F, 0.4670417F, 1.0F, 0.69299442F, 0.20537378F, 1.0F,
+        0.56339353F, 0.402013F, 1.0F, 0.5164212F, 0.49033082F, 1.0F, 0.51594734F, 0.46128473F, 1.0F};
+    EXPECT_EQ(cellsIndex, expectedIndex);
+    ExpectNear(cellsCDF, expectedCDF);
+}
+
+TEST(LightGridBuilder, MatchesGoldenStreamGrid)
+{
+    LightGridBuilder builder;
+    builder.setLights(CreateGoldenLights(), GoldenEnvironment);
+    LightSamplingConfiguration config = GoldenConfig;
+    config.numCells.w                 = 2;
+    std::vector<uint32_t> cellsIndex;
+    std::vector<float2>   cellsReservoirs;
+    builder.buildStream(config, {}, 5, 7, cellsIndex, cellsReservoirs);
+
+    // Each reservoir holds the selected light and its weight followed by the total streamed weight
+    std::vector<uint32_t> const expectedIndex      = {0, 5, 2, 3, 4, 3, 2, 5, 0, 3, 2, 3, 2, 3, 2, 1};
+    std::vector<float> const    expectedReservoirs = {0.10890853F, 0.33175251F, 0.049729884F, 0.13793127F,
+        0.12655185F, 0.3007645F, 0.27801958F, 0.35996899F, 1.5398984F, 1.774258F, 0.065762743F, 0.13361368F,
+        0.12427948F, 0.28384084F, 0.081114881F, 0.16653502F, 0.10890853F, 0.61993206F, 0.06592647F,
+        0.14528947F, 0.16199946F, 0.35222346F, 0.084991306F, 0.12862694F, 0.14366807F, 0.39079347F,
+        0.06494198F, 0.15504962F, 0.12718976F, 0.32764244F, 0.015702F, 0.12995903F};
+    std::vector<float>          reservoirs;
+    for (float2 const &reservoir : cellsReservoirs)
+    {
+        reservoirs.push_back(reservoir.x);
+        reservoirs.push_back(reservoir.y);
+    }
+    EXPECT_EQ(cellsIndex, expectedIndex);
+    ExpectNear(reservoirs, expectedReservoirs);
+}
+
+TEST(LightGridBuilder, PointLightMatchesFalloff)
+{
+    // A single cell covering [0, 4] has jittered bounds [-2, 6]
+    float3 const               radiance(2.0F, 1.0F, 0.5F);
+    float3 const               position(1.0F, 7.0F, 2.0F);
+    float const                range  = 20.0F;
+    float const                lum    = 0.2126F * radiance.x + 0.7152F * radiance.y + 0.0722F * radiance.z;
+    LightSamplingConfiguration config = {uint4(1, 1, 1, 2), float3(4.0F), float3(0.0F), float3(4.0F)};
+    auto const                 falloff = [&](float3 const &point) {
+        float const distSqr = glm::dot(point - position, point - position);
+        return glm::clamp(1.0F - distSqr * distSqr / (range * range * range * range), 0.0F, 1.0F)
+             / (0.0001F + distSqr);
+    };
+    double cornerSum = 0.0;
+    for (float const x : {-2.0F, 6.0F})
+    {
+        for (float const y : {-2.0F, 6.0F})
+        {
+            for (float const z : {-2.0F, 6.0F})
+            {
+                cornerSum += falloff(float3(x, y, z));
+            }
+        }
+    }
+
+    LightGridBuilder builder;
+    builder.setLights({MakePointLight(radiance, position, range)}, {});
+    std::vector<uint32_t>      cellsIndex;
+    std::vector<float>         cellsCDF;
+    LightGridBuilder::Settings settings;
+    settings.hasAllLights = true;
+    builder.buildCDF(config, settings, cellsIndex, cellsCDF);
+    ASSERT_EQ(cellsIndex, (std::vector<uint32_t> {1, 0}));
+    EXPECT_FLOAT_EQ(cellsCDF[1], 1.0F);
+    float const cornerWeight = lum * static_cast<float>(cornerSum / 8.0);
+    EXPECT_NEAR(1.0F / cellsCDF[0], cornerWeight, 1e-5F * cornerWeight);
+
+    settings.centroidBuild = true;
+    builder.buildCDF(config, settings, cellsIndex, cellsCDF);
+    float const centroidWeight = lum * falloff(float3(2.0F));
+    EXPECT_NEAR(1.0F / cellsCDF[0], centroidWeight, 1e-5F * centroidWeight);
+
+    // Cells outside the light range are left empty
+    config.sceneMin = float3(100.0F);
+    builder.buildCDF(config, settings, cellsIndex, cellsCDF);
+    EXPECT_EQ(cellsIndex[0], 0U);
+}
+
+TEST(LightGridBuilder, InfiniteLightsMatchRadiance)
+{
+    float3 const               radiance(0.5F, 0.25F, 2.0F);
+    float3 const               direction = glm::normalize(float3(1.0F));
+    LightSamplingConfiguration config    = {uint4(1, 1, 1, 3), float3(4.0F), float3(0.0F), float3(4.0F)};
+    auto const                 lum       = [](float3 const &value) {
+        return 0.2126F * value.x + 0.7152F * value.y + 0.0722F * value.z;
+    };
+
+    LightGridBuilder builder;
+    builder.setLights(
+        {MakeEnvironmentLight(8, 256), MakeDirectionalLight(radiance, direction, 1e6F)}, GoldenEnvironment);
+    std::vector<uint32_t>      cellsIndex;
+    std::vector<float>         cellsCDF;
+    LightGridBuilder::Settings settings;
+    settings.hasAllLights = true;
+
+    // Without a normal the environment is the average of all faces over the whole sphere
+    float3 environment(0.0F);
+    for (float3 const &face : GoldenEnvironment)
+    {
+        environment += face;
+    }
+    float const environmentWeight = lum(environment) * 4.0F * glm::pi<float>() / 6.0F;
+    float const directionalWeight = lum(radiance);
+    float const totalWeight       = environmentWeight + directionalWeight;
+    builder.buildCDF(config, settings, cellsIndex, cellsCDF);
+    ASSERT_EQ(cellsIndex, (std::vector<uint32_t> {2, 0, 1}));
+    EXPECT_NEAR(1.0F / cellsCDF[0], totalWeight, 1e-5F * totalWeight);
+    EXPECT_NEAR(cellsCDF[1], environmentWeight / totalWeight, 1e-5F);
+
+    // Each octahedron face only sees the 3 environment faces it straddles, the directional light is culled
+    // by the face pointing away from it
+    settings.octahedronSampling = true;
+    builder.buildCDF(config, settings, cellsIndex, cellsCDF);
+    for (uint32_t face = 0; face < 8; ++face)
+    {
+        float3 const normal = glm::normalize(float3((face & 1) != 0 ? -1.0F : 1.0F,
+            (face & 2) != 0 ? -1.0F : 1.0F, (face & 4) != 0 ? -1.0F : 1.0F));
+        float3 const faces  = GoldenEnvironment[normal.x < 0.0F ? 1 : 0]
+                           + GoldenEnvironment[normal.y < 0.0F ? 3 : 2]
+                           + GoldenEnvironment[normal.z < 0.0F ? 5 : 4];
+        float const    faceEnvironment = lum(faces) * 4.0F * glm::pi<float>() / 3.0F;
+        bool const     culled          = glm::dot(direction, normal) <= -0.7071F;
+        float const    faceTotal       = faceEnvironment + (culled ? 0.0F : directionalWeight);
+        uint32_t const cell            = face * config.numCells.w;
+        EXPECT_EQ(cellsIndex[cell], culled ? 1U : 2U) << "face " << face;
+        EXPECT_EQ(culled, face == 7);
+        EXPECT_NEAR(1.0F / cellsCDF[cell], faceTotal, 1e-5F * faceTotal) << "face " << face;
+    }
+}
+
+TEST(LightGridBuilder, KeepsMostImportantLights)
+{
+    uint32_t const           lightCount = 300;
+    std::vector<Light> const lights     = Tests::CreateLights(lightCount, 2, 11, 20.0F);
+    LightGridBuilder         builder;
+    builder.setLights(lights, GoldenEnvironment);
+    for (bool const octahedron : {false, true})
+    {
+        LightGridBuilder::Settings settings;
+        settings.octahedronSampling = octahedron;
+        LightSamplingConfiguration config = {uint4(3, 3, 3, 9), float3(14.0F), float3(-21.0F), float3(42.0F)};
+        std::vector<uint32_t>      cellsIndex;
+        std::vector<float>         cellsCDF;
+        builder.buildCDF(config, settings, cellsIndex, cellsCDF);
+        settings.hasAllLights = true;
+        config.numCells.w     = lightCount + 1;
+        std::vector<uint32_t> allIndex;
+        std::vector<float>    allCDF;
+        builder.buildCDF(config, settings, allIndex, allCDF);
+
+        uint32_t const cellCount = LightGridBuilder::GetGridSize(config, settings) / config.numCells.w;
+        for (uint32_t cell = 0; cell < cellCount; ++cell)
+        {
+            uint32_t const     topCell    = cell * 9;
+            uint32_t const     allCell    = cell * config.numCells.w;
+            std::vector<float> allWeights = GetCellWeights(allIndex, allCDF, allCell);
+            std::vector<float> weights(lightCount, 0.0F);
+            for (uint32_t i = 0; i < allIndex[allCell]; ++i)
+            {
+                weights[allIndex[allCell + 1 + i]] = allWeights[i];
+            }
+            float const totalWeight = 1.0F / allCDF[allCell];
+
+            // The stored lights must be the strongest and their CDF must be increasing and end at 1
+            uint32_t const stored = cellsIndex[topCell];
+            ASSERT_EQ(stored, glm::min(allIndex[allCell], 8U)) << "cell " << cell;
+            std::vector<bool> isStored(lightCount, false);
+            float             storedWeight = 0.0F;
+            float             minStored    = FLT_MAX;
+            for (uint32_t i = 0; i < stored; ++i)
+            {
+                uint32_t const light = cellsIndex[topCell + 1 + i];
+                ASSERT_LT(light, lightCount);
+                EXPECT_FALSE(isStored[light]);
+                isStored[light]  = true;
+                storedWeight    += weights[light];
+                minStored        = glm::min(minStored, weights[light]);
+                EXPECT_GE(cellsCDF[topCell + 1 + i], i == 0 ? 0.0F : cellsCDF[topCell + i]);
+            }
+            if (stored == 0)
+            {
+                continue;
+            }
+            EXPECT_EQ(cellsCDF[topCell + stored], 1.0F);
+            for (uint32_t light = 0; light < lightCount; ++light)
+            {
+                if (!isStored[light])
+                {
+                    EXPECT_LE(weights[light], minStored * (1.0F + 1e-4F)) << "cell " << cell;
+                }
+            }
+            EXPECT_NEAR(cellsCDF[topCell], storedWeight / totalWeight, 1e-4F) << "cell " << cell;
+        }
+    }
+}
+
+TEST(LightGridBuilder, IsDeterministic)
+{
+    std::vector<Light> const   lights = Tests::CreateLights(2000, 1, 5);
+    LightSamplingConfiguration config = {uint4(8, 8, 8, 17), float3(12.5F), float3(-50.0F), float3(100.0F)};
+    LightGridBuilder           builder;
+    builder.setLights(lights, GoldenEnvironment);
+    std::vector<uint32_t> cellsIndex[2];
+    std::vector<float>    cellsCDF[2];
+    std::vector<float2>   cellsReservoirs[2];
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        builder.buildCDF(config, {}, cellsIndex[i], cellsCDF[i]);
+        EXPECT_EQ(cellsIndex[i].size(), LightGridBuilder::GetGridSize(config, {}));
+    }
+    EXPECT_EQ(cellsIndex[0], cellsIndex[1]);
+    EXPECT_EQ(cellsCDF[0], cellsCDF[1]);
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        builder.buildStream(config, {}, 3, 1, cellsIndex[i], cellsReservoirs[i]);
+    }
+    EXPECT_EQ(cellsIndex[0], cellsIndex[1]);
+    EXPECT_EQ(cellsReservoirs[0], cellsReservoirs[1]);
+}
+
+TEST(LightGridBuilder, StreamSelectsProportionally)
+{
+    // Directional lights have a constant weight equal to their luminance
+    std::vector<Light> lights;
+    for (float const weight : {1.0F, 2.0F, 3.0F, 4.0F})
+    {
+        lights.push_back(MakeDirectionalLight(float3(weight), float3(0.0F, 1.0F, 0.0F), 1e6F));
+    }
+    LightGridBuilder builder;
+    builder.setLights(lights, {});
+    LightSamplingConfiguration const config = {uint4(1, 1, 1, 1), float3(1.0F), float3(0.0F), float3(1.0F)};
+    uint32_t const                   frames = 20000;
+    std::vector<uint32_t>            counts(lights.size(), 0);
+    std::vector<uint32_t>            cellsIndex;
+    std::vector<float2>              cellsReservoirs;
+    for (uint32_t frame = 0; frame < frames; ++frame)
+    {
+        builder.buildStream(config, {}, 9, frame, cellsIndex, cellsReservoirs);
+        ASSERT_LT(cellsIndex[0], lights.size());
+        EXPECT_NEAR(cellsReservoirs[0].y, 10.0F, 1e-5F);
+        EXPECT_NEAR(cellsReservoirs[0].x, static_cast<float>(cellsIndex[0] + 1), 1e-5F);
+        ++counts[cellsIndex[0]];
+    }
+    for (uint32_t light = 0; light < lights.size(); ++light)
+    {
+        EXPECT_NEAR(static_cast<double>(counts[light]) / frames, (light + 1) / 10.0, 0.015)
+            << "light " << light;
+    }
+}
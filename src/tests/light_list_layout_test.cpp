@@ -0,0 +1,145 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "components/light_builder/light_list_layout.h"
+
+#include <gtest/gtest.h>
+
+using namespace Capsaicin;
+
+namespace
+{
+GfxLight MakeSceneLight(GfxLightType const type, float const intensity) noexcept
+{
+    GfxLight light;
+    light.type      = type;
+    light.intensity = intensity;
+    light.range     = 10.0F;
+    return light;
+}
+
+/** Scene with a spot, directional and point light, in an order that differs from the light list. */
+std::vector<GfxLight> CreateSceneLights() noexcept
+{
+    return {MakeSceneLight(kGfxLightType_Spot, 1.0F), MakeSceneLight(kGfxLightType_Directional, 2.0F),
+        MakeSceneLight(kGfxLightType_Point, 3.0F)};
+}
+
+LightListLayout CreateLayout(std::vector<GfxLight> const &lights) noexcept
+{
+    LightListLayout layout;
+    Light const     environmentLight = MakeEnvironmentLight(8, 256);
+    layout.beginRebuild(&environmentLight);
+    layout.addDeltaLights(lights.data(), static_cast<uint32_t>(lights.size()));
+    return layout;
+}
+
+LightType GetLightType(Light light) noexcept
+{
+    return light.get_light_type();
+}
+} // namespace
+
+TEST(LightListLayout, GroupsDeltaLightsByType)
+{
+    std::vector<GfxLight> const lights = CreateSceneLights();
+    LightListLayout             layout;
+    Light const                 environmentLight = MakeEnvironmentLight(8, 256);
+    layout.beginRebuild(&environmentLight);
+    auto const counts = layout.addDeltaLights(lights.data(), static_cast<uint32_t>(lights.size()));
+    EXPECT_EQ(counts.directional, 1U);
+    EXPECT_EQ(counts.point, 1U);
+    EXPECT_EQ(counts.spot, 1U);
+
+    ASSERT_EQ(layout.getLights().size(), 4U);
+    EXPECT_EQ(GetLightType(layout.getLights()[0]), kLight_Environment);
+    EXPECT_EQ(GetLightType(layout.getLights()[1]), kLight_Direction);
+    EXPECT_EQ(GetLightType(layout.getLights()[2]), kLight_Point);
+    EXPECT_EQ(GetLightType(layout.getLights()[3]), kLight_Spot);
+}
+
+TEST(LightListLayout, AddedLightRebuilds)
+{
+    std::vector<GfxLight> lights = CreateSceneLights();
+    LightListLayout const layout = CreateLayout(lights);
+    EXPECT_FALSE(layout.needsRebuild(false, lights.data(), {}));
+    EXPECT_TRUE(layout.needsRebuild(true, lights.data(), {}));
+
+    // A light appended to the scene has no slot in the list so cannot be patched in
+    lights.push_back(MakeSceneLight(kGfxLightType_Directional, 4.0F));
+    EXPECT_TRUE(layout.needsRebuild(false, lights.data(), {3}));
+}
+
+TEST(LightListLayout, TypeChangeRebuilds)
+{
+    std::vector<GfxLight> lights = CreateSceneLights();
+    LightListLayout const layout = CreateLayout(lights);
+
+    // Lights are grouped by type so a point light becoming a spot light moves within the list
+    lights[2].type = kGfxLightType_Spot;
+    EXPECT_TRUE(layout.needsRebuild(false, lights.data(), {2}));
+    lights[2].type = kGfxLightType_Point;
+    EXPECT_FALSE(layout.needsRebuild(false, lights.data(), {2}));
+}
+
+TEST(LightListLayout, IntensityChangePatchesInPlace)
+{
+    std::vector<GfxLight> lights = CreateSceneLights();
+    LightListLayout       layout = CreateLayout(lights);
+
+    lights[0].intensity = 5.0F;
+    lights[2].intensity = 6.0F;
+    std::vector<uint32_t> const changed = {0, 2};
+    ASSERT_FALSE(layout.needsRebuild(false, lights.data(), changed));
+    std::vector<uint32_t> const slots = layout.patchDeltaLights(lights.data(), changed);
+    EXPECT_EQ(slots, (std::vector<uint32_t> {3, 2}));
+    EXPECT_EQ(float3(layout.getLights()[3].radiance), float3(5.0F));
+    EXPECT_EQ(float3(layout.getLights()[2].radiance), float3(6.0F));
+
+    // Lights that were not changed are left as is
+    EXPECT_EQ(float3(layout.getLights()[1].radiance), float3(2.0F));
+    EXPECT_EQ(GetLightType(layout.getLights()[0]), kLight_Environment);
+}
+
+TEST(LightListLayout, TransformChangeRegathersMovedEmissiveInstance)
+{
+    std::vector<GfxLight> const lights = CreateSceneLights();
+    LightListLayout             layout = CreateLayout(lights);
+
+    // Scene instances 1 and 3 are emissive, 0 and 2 are not
+    layout.beginEmissiveInstances(4);
+    layout.addEmissiveInstance(1, 5, 10, 2);
+    layout.addEmissiveInstance(3, 7, 20, 3);
+    ASSERT_EQ(layout.getDrawData().size(), 5U);
+
+    // Moving an instance does not change the light list so only its meshlets are re-gathered
+    EXPECT_FALSE(layout.needsRebuild(false, lights.data(), {}));
+    std::vector<DrawData> const moved = layout.getMovedDrawData({0, 3, 2, 9});
+    ASSERT_EQ(moved.size(), 3U);
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(moved[i].meshletIndex, 20 + i);
+        EXPECT_EQ(moved[i].instanceIndex, 7U);
+    }
+    EXPECT_TRUE(layout.getMovedDrawData({0, 2}).empty());
+    EXPECT_EQ(layout.getMovedDrawData({1, 3}).size(), 5U);
+}
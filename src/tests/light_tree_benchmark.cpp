@@ -0,0 +1,80 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+#include "components/light_sampler_tree/light_tree.h"
+#include "test_lights.h"
+
+#include <string>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Measure light tree build and refit time across light counts. */
+void LightTreeBuild(Benchmark::State &state)
+{
+    for (uint32_t const count :
+        {state.size(10000, 1000), state.size(100000, 10000), state.size(1000000, 50000)})
+    {
+        std::vector<Light> const lights = Tests::CreateLights(count, 1, count);
+        LightTree                tree;
+        state.run(std::to_string(count) + " lights build", [&] {
+            tree.build(lights.data(), count, 1);
+            Benchmark::KeepAlive(tree.getNodes().data());
+        });
+        state.run(std::to_string(count) + " lights refit", [&] {
+            tree.refit(lights.data());
+            Benchmark::KeepAlive(tree.getNodes().data());
+        });
+    }
+}
+CAPSAICIN_BENCHMARK(LightTreeBuild);
+
+/** Measure the cost of sampling a light and evaluating its PMF with the CPU reference sampler. */
+void LightTreeSample(Benchmark::State &state)
+{
+    uint32_t const           count       = state.size(100000, 10000);
+    uint32_t const           sampleCount = state.size(100000, 1000);
+    std::vector<Light> const lights      = Tests::CreateLights(count, 1, 3);
+    LightTree                tree;
+    tree.build(lights.data(), count, 1);
+    std::mt19937                          random(4U);
+    std::uniform_real_distribution<float> unit(-1.0F, 1.0F);
+    std::vector<float3>                   positions(sampleCount);
+    for (float3 &position : positions)
+    {
+        position = float3(unit(random), unit(random), unit(random)) * 60.0F;
+    }
+    std::vector<float> pmfs(sampleCount);
+    state.run(std::to_string(sampleCount) + " samples", [&] {
+        for (uint32_t i = 0; i < sampleCount; ++i)
+        {
+            float const    u     = static_cast<float>(i) / static_cast<float>(sampleCount);
+            uint32_t const light = tree.sample(u, positions[i], float3(0.0F, 1.0F, 0.0F), pmfs[i]);
+            pmfs[i]             += tree.pmf(light, positions[i], float3(0.0F, 1.0F, 0.0F));
+        }
+        Benchmark::KeepAlive(pmfs.data());
+    });
+}
+CAPSAICIN_BENCHMARK(LightTreeSample);
+} // namespace
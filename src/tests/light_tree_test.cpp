@@ -0,0 +1,414 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "components/light_sampler_tree/light_tree.h"
+#include "test_lights.h"
+
+#include <gtest/gtest.h>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** C++ port of LightSamplerTree::cosSubClamped in light_sampler_tree.hlsl. */
+float CosSubClampedHlsl(float const sinA, float const cosA, float const sinB, float const cosB)
+{
+    return cosA > cosB ? 1.0F : cosA * cosB + sinA * sinB;
+}
+
+/** C++ port of LightSamplerTree::sinSubClamped in light_sampler_tree.hlsl. */
+float SinSubClampedHlsl(float const sinA, float const cosA, float const sinB, float const cosB)
+{
+    return cosA > cosB ? 0.0F : sinA * cosB - cosA * sinB;
+}
+
+/**
+ * Line by line C++ port of LightSamplerTree::importance in light_sampler_tree.hlsl.
+ * This reads the packed GPU node data rather than the CPU bounds so that it also checks the node packing.
+ */
+float ImportanceHlsl(LightTreeNode const &node, float3 const &position, float3 const &normal)
+{
+    float const power = node.boundsMin.w;
+    if (power <= 0.0F)
+    {
+        return 0.0F;
+    }
+    float3 const boundsMin   = float3(node.boundsMin);
+    float3 const boundsMax   = float3(node.boundsMax);
+    float3 const center      = 0.5F * (boundsMin + boundsMax);
+    float3 const toReceiver  = position - center;
+    float const  centerDist2 = glm::dot(toReceiver, toReceiver);
+    float const  distanceSqr =
+        glm::max(glm::max(centerDist2, 0.5F * glm::length(boundsMax - boundsMin)), 1e-4F);
+    float3 const direction =
+        centerDist2 > 0.0F ? toReceiver * glm::inversesqrt(centerDist2) : float3(node.axis);
+
+    float        cosThetaB = -1.0F;
+    float3 const radius    = boundsMax - center;
+    float const  radiusSqr = glm::dot(radius, radius);
+    if (centerDist2 >= radiusSqr
+        && (glm::any(glm::lessThan(position, boundsMin)) || glm::any(glm::greaterThan(position, boundsMax))))
+    {
+        cosThetaB = glm::sqrt(glm::max(1.0F - radiusSqr / centerDist2, 0.0F));
+    }
+    float const sinThetaB = glm::sqrt(glm::max(1.0F - cosThetaB * cosThetaB, 0.0F));
+
+    float const cosThetaO = node.axis.w;
+    float const cosThetaE = node.boundsMax.w;
+    float const cosThetaW = glm::dot(float3(node.axis), direction);
+    float const sinThetaW = glm::sqrt(glm::max(1.0F - cosThetaW * cosThetaW, 0.0F));
+    float const sinThetaO = glm::sqrt(glm::max(1.0F - cosThetaO * cosThetaO, 0.0F));
+    float const cosThetaX = CosSubClampedHlsl(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+    float const sinThetaX = SinSubClampedHlsl(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+    float const cosThetaP = CosSubClampedHlsl(sinThetaX, cosThetaX, sinThetaB, cosThetaB);
+    if (cosThetaP <= cosThetaE)
+    {
+        return 0.0F;
+    }
+    float nodeImportance = power * cosThetaP / distanceSqr;
+
+    if (glm::any(glm::notEqual(normal, float3(0.0F))))
+    {
+        float const cosThetaI = glm::abs(glm::dot(direction, normal));
+        float const sinThetaI = glm::sqrt(glm::max(1.0F - cosThetaI * cosThetaI, 0.0F));
+        nodeImportance *= CosSubClampedHlsl(sinThetaI, cosThetaI, sinThetaB, cosThetaB);
+    }
+    return glm::max(nodeImportance, 0.0F);
+}
+
+/**
+ * C++ port of LightSamplerTree::sampleTreePDF in light_sampler_tree.hlsl using the data uploaded to the GPU.
+ */
+float SampleTreePDFHlsl(
+    LightTree const &tree, uint32_t const lightID, float3 const &position, float3 const &normal)
+{
+    auto const    &nodes         = tree.getNodes();
+    uint32_t const infiniteCount = tree.getInfiniteCount();
+    uint32_t const treeCount     = nodes.empty() ? 0 : 1;
+    float const    infiniteProbability = infiniteCount == 0
+                                           ? 0.0F
+                                           : static_cast<float>(infiniteCount)
+                                                 / static_cast<float>(infiniteCount + treeCount);
+    if (lightID < infiniteCount)
+    {
+        return infiniteProbability / static_cast<float>(infiniteCount);
+    }
+    float         pdf = 1.0F - infiniteProbability;
+    uint2 const   trail(static_cast<uint32_t>(tree.getBitTrails()[lightID]),
+        static_cast<uint32_t>(tree.getBitTrails()[lightID] >> 32));
+    LightTreeNode node = nodes[0];
+    if (node.isLeaf != 0 && ImportanceHlsl(node, position, normal) <= 0.0F)
+    {
+        return 0.0F;
+    }
+    uint32_t depth = 0;
+    while (node.isLeaf == 0)
+    {
+        LightTreeNode const firstChild      = nodes[node.index];
+        LightTreeNode const secondChild     = nodes[node.index + 1];
+        float const         firstImportance = ImportanceHlsl(firstChild, position, normal);
+        float const         total           = firstImportance + ImportanceHlsl(secondChild, position, normal);
+        if (total <= 0.0F)
+        {
+            return 0.0F;
+        }
+        float const    firstProbability = firstImportance / total;
+        uint32_t const bits             = depth < 32 ? trail.x : trail.y;
+        if ((bits & (1U << (depth & 31))) == 0)
+        {
+            node  = firstChild;
+            pdf  *= firstProbability;
+        }
+        else
+        {
+            node  = secondChild;
+            pdf  *= 1.0F - firstProbability;
+        }
+        ++depth;
+    }
+    EXPECT_EQ(node.index, lightID);
+    return pdf;
+}
+
+/**
+ * Calculate the probability of sampling stopping at a node where no child can reach the receiver.
+ * Node importance is only a conservative bound so a subtree may turn out not to illuminate a receiver once
+ * its children are visited, such samples are returned as invalid.
+ */
+float DeadEndProbability(LightTree const &tree, float3 const &position, float3 const &normal)
+{
+    auto const &nodes = tree.getNodes();
+    if (nodes.empty())
+    {
+        return 0.0F;
+    }
+    uint32_t const infiniteCount = tree.getInfiniteCount();
+    float const    probability =
+        1.0F - static_cast<float>(infiniteCount) / static_cast<float>(infiniteCount + 1);
+    if (nodes[0].isLeaf != 0)
+    {
+        return ImportanceHlsl(nodes[0], position, normal) <= 0.0F ? probability : 0.0F;
+    }
+    float                                   deadEnd = 0.0F;
+    std::vector<std::pair<uint32_t, float>> visits  = {{0, probability}};
+    while (!visits.empty())
+    {
+        auto const [node, reach] = visits.back();
+        visits.pop_back();
+        if (nodes[node].isLeaf != 0)
+        {
+            continue;
+        }
+        uint32_t const child           = nodes[node].index;
+        float const    firstImportance = ImportanceHlsl(nodes[child], position, normal);
+        float const    total           = firstImportance + ImportanceHlsl(nodes[child + 1], position, normal);
+        if (total <= 0.0F)
+        {
+            deadEnd += reach;
+            continue;
+        }
+        visits.emplace_back(child, reach * firstImportance / total);
+        visits.emplace_back(child + 1, reach * (1.0F - firstImportance / total));
+    }
+    return deadEnd;
+}
+
+/** Create a set of receivers both inside and outside of the light bounds. */
+std::vector<std::pair<float3, float3>> CreateReceivers(uint32_t const count, uint32_t const seed)
+{
+    std::mt19937                           random(seed);
+    std::uniform_real_distribution<float>  unit(-1.0F, 1.0F);
+    std::vector<std::pair<float3, float3>> receivers;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float const  scale    = i % 2 == 0 ? 40.0F : 200.0F;
+        float3 const position = float3(unit(random), unit(random), unit(random)) * scale;
+        float3       normal(unit(random), unit(random), unit(random));
+        // Also test receivers without a normal (such as volumes)
+        normal = i % 5 == 0 || glm::length(normal) < 1e-3F ? float3(0.0F) : glm::normalize(normal);
+        receivers.emplace_back(position, normal);
+    }
+    return receivers;
+}
+
+/** Check the structure of a tree and that the bit trail of every light leads to its leaf. */
+void ValidateTree(LightTree const &tree)
+{
+    auto const &nodes     = tree.getNodes();
+    auto const &bitTrails = tree.getBitTrails();
+    ASSERT_EQ(bitTrails.size(), tree.getLightCount());
+    uint32_t const treeLightCount = tree.getLightCount() - tree.getInfiniteCount();
+    ASSERT_EQ(nodes.size(), treeLightCount == 0 ? 0 : 2 * static_cast<size_t>(treeLightCount) - 1);
+    std::vector<uint32_t> leafCount(tree.getLightCount(), 0);
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        LightTreeNode const &node = nodes[i];
+        if (node.isLeaf != 0)
+        {
+            ASSERT_GE(node.index, tree.getInfiniteCount());
+            ASSERT_LT(node.index, tree.getLightCount());
+            ++leafCount[node.index];
+            continue;
+        }
+        // Children follow their parent and bound their spatial extent and power
+        ASSERT_GT(node.index, i);
+        ASSERT_LT(node.index + 1, nodes.size());
+        float power = 0.0F;
+        for (uint32_t child = node.index; child <= node.index + 1; ++child)
+        {
+            LightTreeNode const &childNode = nodes[child];
+            EXPECT_TRUE(glm::all(glm::lessThanEqual(float3(node.boundsMin), float3(childNode.boundsMin))));
+            EXPECT_TRUE(glm::all(glm::greaterThanEqual(float3(node.boundsMax), float3(childNode.boundsMax))));
+            EXPECT_LE(node.boundsMax.w, childNode.boundsMax.w + 1e-6F) << "emission angle of node " << i;
+            power += childNode.boundsMin.w;
+        }
+        EXPECT_NEAR(node.boundsMin.w, power, 1e-4F * power) << "node " << i;
+    }
+    for (uint32_t light = 0; light < tree.getLightCount(); ++light)
+    {
+        if (light < tree.getInfiniteCount())
+        {
+            EXPECT_EQ(bitTrails[light], 0U);
+            EXPECT_EQ(leafCount[light], 0U);
+            continue;
+        }
+        EXPECT_EQ(leafCount[light], 1U) << "light " << light;
+        // Follow the trail down to the leaf
+        uint64_t trail = bitTrails[light];
+        uint32_t node  = 0;
+        uint32_t depth = 0;
+        while (nodes[node].isLeaf == 0)
+        {
+            node    = nodes[node].index + static_cast<uint32_t>(trail & 1);
+            trail >>= 1;
+            ASSERT_LE(++depth, 64U) << "light " << light;
+        }
+        EXPECT_EQ(nodes[node].index, light);
+        EXPECT_EQ(trail, 0U) << "unused trail bits for light " << light;
+    }
+}
+} // namespace
+
+TEST(LightTree, BuildsValidTree)
+{
+    for (uint32_t const count : {1U, 2U, 3U, 1000U, 40000U})
+    {
+        SCOPED_TRACE(count);
+        std::vector<Light> const lights = Tests::CreateLights(count, count > 2 ? 2 : 0, count);
+        LightTree                tree;
+        tree.build(lights.data(), count, count > 2 ? 2 : 0);
+        ValidateTree(tree);
+    }
+}
+
+TEST(LightTree, SAOHSeparatesClusters)
+{
+    // Two distant clusters of lights should be split at the root
+    std::vector<Light> lights = Tests::CreateLights(512, 0, 1, 5.0F);
+    std::vector<Light> const other = Tests::CreateLights(512, 0, 2, 5.0F);
+    for (Light light : other)
+    {
+        float4 const offset(1000.0F, 0.0F, 0.0F, 0.0F);
+        light.v1 += offset;
+        if (light.get_light_type() == kLight_Area)
+        {
+            light.v2 += offset;
+            light.v3 += offset;
+        }
+        lights.push_back(light);
+    }
+    LightTree tree;
+    tree.build(lights.data(), static_cast<uint32_t>(lights.size()), 0);
+    ValidateTree(tree);
+    auto const &nodes = tree.getNodes();
+    ASSERT_EQ(nodes[0].isLeaf, 0U);
+    LightTreeNode const &first  = nodes[nodes[0].index];
+    LightTreeNode const &second = nodes[nodes[0].index + 1];
+    float const          split  = 500.0F;
+    EXPECT_TRUE(first.boundsMax.x < split || first.boundsMin.x > split);
+    EXPECT_TRUE(second.boundsMax.x < split || second.boundsMin.x > split);
+    EXPECT_NE(first.boundsMax.x < split, second.boundsMax.x < split);
+}
+
+TEST(LightTree, BitTrailsFitDegenerateTrees)
+{
+    // Exponentially spaced lights produce a very unbalanced SAOH tree, the build must switch to median splits
+    // so that every path still fits within the 64bit trail
+    std::vector<Light> lights;
+    for (uint32_t i = 0; i < 20000; ++i)
+    {
+        float const position = glm::pow(1.01F, static_cast<float>(i % 2000)) + static_cast<float>(i / 2000);
+        lights.push_back(MakePointLight(float3(1.0F), float3(position, 0.0F, 0.0F), 100.0F));
+    }
+    LightTree tree;
+    tree.build(lights.data(), static_cast<uint32_t>(lights.size()), 0);
+    ValidateTree(tree);
+}
+
+TEST(LightTree, PMFsSumToOneAndMatchSamples)
+{
+    std::vector<Light> const lights = Tests::CreateLights(3000, 3, 7);
+    LightTree                tree;
+    tree.build(lights.data(), static_cast<uint32_t>(lights.size()), 3);
+    std::mt19937                          random(8U);
+    std::uniform_real_distribution<float> uniform(0.0F, 1.0F);
+    for (auto const &[position, normal] : CreateReceivers(32, 9))
+    {
+        // Every sample either selects a light or stops at a node that cannot reach the receiver
+        double total = DeadEndProbability(tree, position, normal);
+        for (uint32_t light = 0; light < lights.size(); ++light)
+        {
+            total += tree.pmf(light, position, normal);
+        }
+        EXPECT_NEAR(total, 1.0, 1e-4);
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            float          lightPMF;
+            uint32_t const light = tree.sample(uniform(random), position, normal, lightPMF);
+            ASSERT_LT(light, lights.size());
+            if (lightPMF > 0.0F)
+            {
+                EXPECT_NEAR(lightPMF, tree.pmf(light, position, normal), 1e-5F * lightPMF);
+            }
+        }
+    }
+}
+
+TEST(LightTree, CPUImportanceMatchesHLSL)
+{
+    std::vector<Light> const lights = Tests::CreateLights(2000, 2, 10);
+    LightTree                tree;
+    tree.build(lights.data(), static_cast<uint32_t>(lights.size()), 2);
+    for (auto const &[position, normal] : CreateReceivers(16, 11))
+    {
+        for (uint32_t light = 0; light < lights.size(); ++light)
+        {
+            float const expected = tree.pmf(light, position, normal);
+            EXPECT_NEAR(SampleTreePDFHlsl(tree, light, position, normal), expected, 1e-5F * expected + 1e-12F)
+                << "light " << light;
+        }
+    }
+}
+
+TEST(LightTree, RefitTracksMovedLights)
+{
+    std::vector<Light> lights = Tests::CreateLights(5000, 1, 12);
+    LightTree          tree;
+    tree.build(lights.data(), static_cast<uint32_t>(lights.size()), 1);
+    std::vector<uint64_t> const trails = tree.getBitTrails();
+    for (uint32_t i = 1; i < lights.size(); ++i)
+    {
+        float4 const offset(0.0F, static_cast<float>(i % 17), -static_cast<float>(i % 5), 0.0F);
+        lights[i].v1 += offset;
+        if (lights[i].get_light_type() == kLight_Area)
+        {
+            lights[i].v2 += offset;
+            lights[i].v3 += offset;
+        }
+    }
+    tree.refit(lights.data());
+    ValidateTree(tree);
+    EXPECT_EQ(tree.getBitTrails(), trails);
+    for (auto const &[position, normal] : CreateReceivers(8, 13))
+    {
+        double total = DeadEndProbability(tree, position, normal);
+        for (uint32_t light = 0; light < lights.size(); ++light)
+        {
+            float const pmf = tree.pmf(light, position, normal);
+            EXPECT_NEAR(SampleTreePDFHlsl(tree, light, position, normal), pmf, 1e-5F * pmf + 1e-12F);
+            total += pmf;
+        }
+        EXPECT_NEAR(total, 1.0, 1e-4);
+    }
+}
+
+TEST(LightTree, HandlesOnlyInfiniteLights)
+{
+    std::vector<Light> const lights = Tests::CreateLights(3, 3, 14);
+    LightTree                tree;
+    tree.build(lights.data(), 3, 3);
+    EXPECT_TRUE(tree.getNodes().empty());
+    float          lightPMF;
+    uint32_t const light = tree.sample(0.5F, float3(0.0F), float3(0.0F, 1.0F, 0.0F), lightPMF);
+    EXPECT_EQ(light, 1U);
+    EXPECT_FLOAT_EQ(lightPMF, 1.0F / 3.0F);
+}
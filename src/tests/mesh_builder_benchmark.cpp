@@ -0,0 +1,65 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+#include "mesh_builder.h"
+#include "parallel.h"
+#include "test_meshes.h"
+
+#include <string>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Compare building a scene's meshes one at a time against building them in parallel. */
+void MeshBuilderScene(Benchmark::State &state)
+{
+    uint32_t const       mesh_count = state.size(256, 16);
+    std::vector<GfxMesh> meshes;
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        meshes.push_back(Tests::CreateGridMesh(16 + (i % 8) * 8, i, i % 4 == 0));
+    }
+    std::vector<MeshBuildData> build_data(mesh_count);
+    for (MeshBuildSettings const &settings :
+        {MeshBuildSettings {}, MeshBuildSettings {.lod_mode = 1, .lod_offset = 2, .meshlets = true},
+            MeshBuildSettings {.lod_mode = 2, .meshlets = true, .meshlet_cull = true}})
+    {
+        std::string const label =
+            "lod" + std::to_string(settings.lod_mode) + (settings.meshlets ? "+meshlets" : "");
+        state.run(label + " serial", [&] {
+            for (uint32_t i = 0; i < mesh_count; ++i)
+            {
+                BuildMesh(meshes[i], settings, build_data[i]);
+            }
+            Benchmark::KeepAlive(build_data.data());
+        });
+        state.run(label + " parallel", [&] {
+            ParallelFor(
+                0U, mesh_count, [&](uint32_t const i) { BuildMesh(meshes[i], settings, build_data[i]); });
+            Benchmark::KeepAlive(build_data.data());
+        });
+    }
+}
+CAPSAICIN_BENCHMARK(MeshBuilderScene);
+} // namespace
@@ -0,0 +1,376 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "mesh_builder.h"
+#include "parallel.h"
+#include "test_mesh_compare.h"
+#include "test_meshes.h"
+
+#include <gtest/gtest.h>
+#include <meshoptimizer.h>
+#include <string>
+
+using namespace Capsaicin;
+
+namespace
+{
+class MeshBuilderSettingsTest : public testing::TestWithParam<MeshBuildSettings>
+{};
+
+/** FNV-1a hash of the raw contents of a vector, used to compare against golden values. */
+template<typename T>
+uint64_t HashBytes(std::vector<T> const &values) noexcept
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < values.size() * sizeof(T); ++i)
+    {
+        hash = (hash ^ reinterpret_cast<uint8_t const *>(values.data())[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/**
+ * Load a mesh without LODs using the serial scene mesh build from before meshes were built in parallel.
+ * This is the body of the loadMesh lambda from CapsaicinInternal::updateSceneMeshes() for the first mesh in
+ * the scene, with the scene wide lists replaced by the outputs. It is kept as a reference because the
+ * meshlet output depends on the meshoptimizer version, so cannot be stored as golden values.
+ */
+void BuildMeshSerialReference(
+    GfxMesh const &source, bool const hasMeshlets, bool const hasMeshletCull, MeshBuildData &out) noexcept
+{
+    std::vector<GfxVertex> const &meshVertices  = source.vertices;
+    std::vector<uint32_t> const  &meshIndices   = source.indices;
+    std::vector<GfxVertex> const &morphVertices = source.morph_targets;
+    std::vector<GfxJoint> const  &joints        = source.joints;
+
+    out                           = {};
+    auto const indexCount         = meshIndices.size();
+    MeshInfo  &mesh               = out.mesh;
+    mesh.index_offset_idx         = static_cast<uint32_t>(out.indices.size());
+    mesh.index_count              = static_cast<uint32_t>(indexCount);
+    mesh.vertex_source_offset_idx = static_cast<uint32_t>(out.vertex_source.size());
+    mesh.joints_offset            = static_cast<uint32_t>(out.joints.size());
+    mesh.targets_count            = static_cast<uint32_t>(morphVertices.size() / meshVertices.size());
+    mesh.vertex_count             = static_cast<uint32_t>(meshVertices.size());
+    mesh.is_animated              = !joints.empty() || !morphVertices.empty();
+
+    if (!mesh.is_animated)
+    {
+        mesh.vertex_offset_idx[0] = static_cast<uint32_t>(out.vertices.size());
+        mesh.vertex_offset_idx[1] = mesh.vertex_offset_idx[0];
+        for (auto const &[vertPosition, vertNormal, vertUV] : meshVertices)
+        {
+            Vertex vertex       = {};
+            vertex.position_uvx = float4(vertPosition, vertUV.x);
+            vertex.normal_uvy   = float4(vertNormal, vertUV.y);
+            out.vertices.push_back(vertex);
+        }
+    }
+    else
+    {
+        mesh.vertex_offset_idx[0] = static_cast<uint32_t>(out.vertices.size());
+        out.vertices.resize(out.vertices.size() + mesh.vertex_count);
+        mesh.vertex_offset_idx[1] = static_cast<uint32_t>(out.vertices.size());
+        out.vertices.resize(out.vertices.size() + mesh.vertex_count);
+        for (size_t j = 0; j < mesh.vertex_count; ++j)
+        {
+            Vertex vertex       = {};
+            vertex.position_uvx = float4(meshVertices[j].position, meshVertices[j].uv.x);
+            vertex.normal_uvy   = float4(meshVertices[j].normal, meshVertices[j].uv.y);
+            out.vertex_source.push_back(vertex);
+            for (uint32_t k = 0; k < mesh.targets_count; ++k)
+            {
+                GfxVertex const &target        = morphVertices[j * mesh.targets_count + k];
+                Vertex           target_vertex = {};
+                target_vertex.position_uvx     = float4(target.position, target.uv.x);
+                target_vertex.normal_uvy       = float4(target.normal, target.uv.y);
+                out.vertex_source.push_back(target_vertex);
+            }
+        }
+    }
+
+    if (hasMeshlets)
+    {
+        constexpr size_t max_vertices  = 64;
+        constexpr size_t max_triangles = 64;
+        constexpr float  cone_weight   = 1.0F;
+
+        size_t const                 indexCountLOD = meshIndices.size();
+        std::vector<meshopt_Meshlet> meshlets(
+            meshopt_buildMeshletsBound(indexCountLOD, max_vertices, max_triangles));
+        std::vector<uint32_t> meshletVertices(meshlets.size() * max_vertices);
+        std::vector<uint8_t>  meshletTriangles(meshlets.size() * max_triangles * 3);
+        meshlets.resize(meshopt_buildMeshlets(meshlets.data(), meshletVertices.data(),
+            meshletTriangles.data(), meshIndices.data(), indexCountLOD, &meshVertices[0].position.x,
+            mesh.vertex_count, sizeof(GfxVertex), max_vertices, max_triangles, cone_weight));
+
+        meshopt_Meshlet const &lastMeshlet = meshlets.back();
+        meshletVertices.resize(lastMeshlet.vertex_offset + lastMeshlet.vertex_count);
+        meshletTriangles.resize(lastMeshlet.triangle_offset + ((lastMeshlet.triangle_count * 3 + 3) & ~3U));
+        for (auto &[vertexOffset, triangleOffset, vertexCount, triangleCount] : meshlets)
+        {
+            meshopt_optimizeMeshlet(&meshletVertices[vertexOffset], &meshletTriangles[triangleOffset],
+                triangleCount, vertexCount);
+        }
+
+        mesh.meshlet_count      = static_cast<uint32_t>(meshlets.size());
+        mesh.meshlet_offset_idx = static_cast<uint32_t>(out.meshlets.size());
+
+        std::vector<uint32_t> indices;
+        for (auto &[meshlet_vertex_offset, meshlet_triangle_offset, meshlet_vertex_count,
+                 meshlet_triangle_count] : meshlets)
+        {
+            auto const dataOffset = static_cast<uint32_t>(out.meshlet_pack.size());
+            for (uint32_t j = 0; j < meshlet_vertex_count; ++j)
+            {
+                out.meshlet_pack.push_back(meshletVertices[static_cast<size_t>(meshlet_vertex_offset) + j]);
+            }
+            auto const indexMeshletOffset = static_cast<uint32_t>(indices.size());
+            for (size_t j = 0; j < meshlet_triangle_count; ++j)
+            {
+                size_t const offset = static_cast<size_t>(meshlet_triangle_offset) + (j * 3);
+                out.meshlet_pack.push_back(static_cast<uint32_t>(meshletTriangles[offset])
+                                           | (static_cast<uint32_t>(meshletTriangles[offset + 1]) << 10)
+                                           | (static_cast<uint32_t>(meshletTriangles[offset + 2]) << 20));
+                for (size_t corner = 0; corner < 3; ++corner)
+                {
+                    indices.push_back(meshletVertices[meshletTriangles[offset + corner]
+                                                      + static_cast<size_t>(meshlet_vertex_offset)]);
+                }
+            }
+
+            Meshlet m              = {};
+            m.vertex_count         = static_cast<uint16_t>(meshlet_vertex_count);
+            m.triangle_count       = static_cast<uint16_t>(meshlet_triangle_count);
+            m.data_offset_idx      = dataOffset;
+            m.mesh_prim_offset_idx = indexMeshletOffset / 3;
+            out.meshlets.push_back(m);
+
+            if (hasMeshletCull)
+            {
+                meshopt_Bounds const bounds =
+                    meshopt_computeMeshletBounds(&meshletVertices[meshlet_vertex_offset],
+                        &meshletTriangles[meshlet_triangle_offset], meshlet_triangle_count,
+                        &meshVertices[0].position.x, mesh.vertex_count, sizeof(GfxVertex));
+                MeshletCull m2 = {};
+                m2.sphere = float4(bounds.center[0], bounds.center[1], bounds.center[2], bounds.radius);
+                m2.cone   = float4(
+                    bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2], bounds.cone_cutoff);
+                out.meshlet_cull.push_back(m2);
+            }
+        }
+        out.indices.insert(out.indices.end(), indices.begin(), indices.end());
+    }
+    else
+    {
+        for (auto const &index : meshIndices)
+        {
+            out.indices.push_back(index);
+        }
+    }
+
+    for (auto const &[jointJoints, jointWeights] : joints)
+    {
+        out.joints.emplace_back(jointJoints, jointWeights);
+    }
+}
+} // namespace
+
+TEST_P(MeshBuilderSettingsTest, ParallelMatchesSerial)
+{
+    std::vector<GfxMesh> meshes;
+    for (uint32_t i = 0; i < 24; ++i)
+    {
+        meshes.push_back(Tests::CreateGridMesh(4 + i, i, i % 3 == 0));
+    }
+    auto const                 mesh_count = static_cast<uint32_t>(meshes.size());
+    std::vector<MeshBuildData> serial(mesh_count);
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        BuildMesh(meshes[i], GetParam(), serial[i]);
+    }
+    std::vector<MeshBuildData> parallel(mesh_count);
+    ParallelFor(0U, mesh_count, [&](uint32_t const i) { BuildMesh(meshes[i], GetParam(), parallel[i]); });
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        Tests::ExpectEqual(serial[i], parallel[i], i);
+    }
+}
+
+TEST_P(MeshBuilderSettingsTest, MeshInfoMatchesData)
+{
+    MeshBuildSettings const &settings = GetParam();
+    for (bool const animated : {false, true})
+    {
+        GfxMesh const mesh = Tests::CreateGridMesh(12, 1, animated);
+        MeshBuildData data;
+        BuildMesh(mesh, settings, data);
+        EXPECT_EQ(data.mesh.is_animated, animated);
+        EXPECT_EQ(data.mesh.index_count, data.indices.size());
+        EXPECT_EQ(data.indices.size() % 3, 0U);
+        EXPECT_GT(data.mesh.index_count, 0U);
+        for (uint32_t const index : data.indices)
+        {
+            EXPECT_LT(index, data.mesh.vertex_count);
+        }
+        EXPECT_EQ(data.joints.size(), animated ? data.mesh.vertex_count : 0U);
+        if (animated)
+        {
+            // Animated meshes reserve two vertex slots and keep the source data separately
+            EXPECT_EQ(data.mesh.vertex_offset_idx[1], data.mesh.vertex_count);
+            EXPECT_EQ(data.vertices.size(), 2ULL * data.mesh.vertex_count);
+            EXPECT_EQ(data.vertex_source.size(), data.mesh.vertex_count * (1ULL + data.mesh.targets_count));
+        }
+        else
+        {
+            EXPECT_EQ(data.mesh.vertex_offset_idx[1], 0U);
+            EXPECT_EQ(data.vertices.size(), data.mesh.vertex_count);
+            EXPECT_TRUE(data.vertex_source.empty());
+        }
+        if (settings.meshlets)
+        {
+            EXPECT_EQ(data.mesh.meshlet_count, data.meshlets.size());
+            EXPECT_EQ(data.meshlet_cull.size(), settings.meshlet_cull ? data.meshlets.size() : 0U);
+            uint32_t primitive = 0;
+            for (Meshlet const &meshlet : data.meshlets)
+            {
+                // Each meshlet must reference its own packed vertices followed by its packed triangles
+                EXPECT_EQ(meshlet.mesh_prim_offset_idx, primitive);
+                uint32_t const triangles = meshlet.data_offset_idx + meshlet.vertex_count;
+                ASSERT_LE(triangles + meshlet.triangle_count, data.meshlet_pack.size());
+                for (uint32_t triangle = 0; triangle < meshlet.triangle_count; ++triangle)
+                {
+                    uint32_t const packed = data.meshlet_pack[triangles + triangle];
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                    {
+                        uint32_t const local = (packed >> (corner * 10)) & 0x3FFU;
+                        ASSERT_LT(local, meshlet.vertex_count);
+                        EXPECT_EQ(data.meshlet_pack[meshlet.data_offset_idx + local],
+                            data.indices[3 * (primitive + triangle) + corner]);
+                    }
+                }
+                primitive += meshlet.triangle_count;
+            }
+            EXPECT_EQ(primitive * 3, data.mesh.index_count);
+        }
+        else
+        {
+            EXPECT_EQ(data.mesh.meshlet_count, 0U);
+            EXPECT_TRUE(data.meshlets.empty());
+            EXPECT_TRUE(data.meshlet_pack.empty());
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(MeshBuilder, MeshBuilderSettingsTest,
+    testing::Values(MeshBuildSettings {}, MeshBuildSettings {.meshlets = true},
+        MeshBuildSettings {.meshlets = true, .meshlet_cull = true}, MeshBuildSettings {.lod_mode = 1},
+        MeshBuildSettings {.lod_mode = 1, .lod_offset = 2},
+        MeshBuildSettings {.lod_mode = 1, .lod_offset = 3, .lod_aggressive = true, .meshlets = true},
+        MeshBuildSettings {.lod_mode = 2, .meshlets = true, .meshlet_cull = true}),
+    [](testing::TestParamInfo<MeshBuildSettings> const &info) {
+        MeshBuildSettings const &settings = info.param;
+        return "Lod" + std::to_string(settings.lod_mode) + "Offset" + std::to_string(settings.lod_offset)
+             + (settings.lod_aggressive ? "Aggressive" : "") + (settings.meshlets ? "Meshlets" : "")
+             + (settings.meshlet_cull ? "Cull" : "");
+    });
+
+TEST(MeshBuilder, UnalteredWithoutLOD)
+{
+    GfxMesh const mesh = Tests::CreateGridMesh(8, 0, false);
+    MeshBuildData data;
+    BuildMesh(mesh, MeshBuildSettings {}, data);
+    EXPECT_EQ(data.indices, mesh.indices);
+    ASSERT_EQ(data.vertices.size(), mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i)
+    {
+        EXPECT_EQ(data.vertices[i].position_uvx, float4(mesh.vertices[i].position, mesh.vertices[i].uv.x));
+        EXPECT_EQ(data.vertices[i].normal_uvy, float4(mesh.vertices[i].normal, mesh.vertices[i].uv.y));
+    }
+}
+
+TEST(MeshBuilder, ReindexRemovesDuplicateVertices)
+{
+    GfxMesh const mesh = Tests::CreateGridMesh(8, 0, false);
+    MeshBuildData data;
+    BuildMesh(mesh, MeshBuildSettings {.lod_mode = 2}, data);
+    EXPECT_EQ(data.mesh.index_count, mesh.indices.size());
+    EXPECT_EQ(data.mesh.vertex_count, 9U * 9U);
+}
+
+TEST(MeshBuilder, ResetsOutput)
+{
+    MeshBuildData data;
+    BuildMesh(Tests::CreateGridMesh(16, 0, true), MeshBuildSettings {.meshlets = true}, data);
+    MeshBuildData fresh;
+    GfxMesh const mesh = Tests::CreateGridMesh(4, 2, false);
+    BuildMesh(mesh, MeshBuildSettings {}, data);
+    BuildMesh(mesh, MeshBuildSettings {}, fresh);
+    Tests::ExpectEqual(data, fresh, 0);
+}
+
+TEST(MeshBuilder, MatchesSerialGoldenWithoutLOD)
+{
+    // Hashes of the output of the serial scene mesh build before meshes were built in parallel
+    struct Golden
+    {
+        bool     animated;
+        uint64_t indices;
+        uint64_t vertices;
+        uint64_t vertexSource;
+        uint64_t joints;
+    };
+    constexpr Golden goldens[] = {
+        {false, 0xA69D83D939421DE5ULL, 0x5354B51C806A7BADULL, 0xCBF29CE484222325ULL, 0xCBF29CE484222325ULL},
+        { true, 0xA69D83D939421DE5ULL, 0xF3FB6A6DEB5AF325ULL, 0x097620F6FFED9AADULL, 0x96A54577E7A43845ULL},
+    };
+    for (Golden const &golden : goldens)
+    {
+        GfxMesh const mesh = Tests::CreateGridMesh(6, 3, golden.animated);
+        MeshBuildData data;
+        BuildMesh(mesh, MeshBuildSettings {}, data);
+        EXPECT_EQ(HashBytes(data.indices), golden.indices) << "animated " << golden.animated;
+        EXPECT_EQ(HashBytes(data.vertices), golden.vertices) << "animated " << golden.animated;
+        EXPECT_EQ(HashBytes(data.vertex_source), golden.vertexSource) << "animated " << golden.animated;
+        EXPECT_EQ(HashBytes(data.joints), golden.joints) << "animated " << golden.animated;
+        MeshBuildData reference;
+        BuildMeshSerialReference(mesh, false, false, reference);
+        Tests::ExpectEqual(data, reference, golden.animated ? 1 : 0);
+    }
+}
+
+TEST(MeshBuilder, MatchesSerialReferenceWithMeshlets)
+{
+    for (bool const animated : {false, true})
+    {
+        for (bool const cull : {false, true})
+        {
+            GfxMesh const mesh = Tests::CreateGridMesh(14, 5, animated);
+            MeshBuildData data;
+            BuildMesh(mesh, MeshBuildSettings {.meshlets = true, .meshlet_cull = cull}, data);
+            MeshBuildData reference;
+            BuildMeshSerialReference(mesh, true, cull, reference);
+            Tests::ExpectEqual(data, reference, animated ? 1 : 0);
+            EXPECT_EQ(data.mesh.meshlet_offset_idx, reference.mesh.meshlet_offset_idx);
+        }
+    }
+}
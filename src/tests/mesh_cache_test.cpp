@@ -0,0 +1,106 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "mesh_cache.h"
+#include "test_mesh_compare.h"
+#include "test_meshes.h"
+
+#include <gtest/gtest.h>
+
+using namespace Capsaicin;
+
+namespace
+{
+class MeshCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory_ = std::filesystem::temp_directory_path()
+                   / (std::string("capsaicin_mesh_cache_")
+                       + testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory_); }
+
+    std::filesystem::path directory_;
+};
+} // namespace
+
+TEST_F(MeshCacheTest, RoundTrip)
+{
+    MeshCache const cache(directory_);
+    for (bool const animated : {false, true})
+    {
+        GfxMesh const           mesh = Tests::CreateGridMesh(10, 3, animated);
+        MeshBuildSettings const settings {.lod_mode = 2, .meshlets = true, .meshlet_cull = true};
+        MeshBuildData           data;
+        BuildMesh(mesh, settings, data);
+        uint64_t const key = MeshCache::CalculateKey(mesh, settings.lod_mode, settings.lod_offset,
+            settings.lod_aggressive, settings.meshlets, settings.meshlet_cull);
+        ASSERT_TRUE(cache.save(key, data));
+        MeshBuildData loaded;
+        ASSERT_TRUE(cache.load(key, loaded));
+        Tests::ExpectEqual(data, loaded, 0);
+    }
+
+    // Only the final entries should be left behind, never any temporary files
+    for (auto const &entry : std::filesystem::directory_iterator(directory_))
+    {
+        EXPECT_NE(entry.path().extension(), ".tmp") << entry.path();
+    }
+}
+
+TEST_F(MeshCacheTest, KeyDependsOnContentsAndSettings)
+{
+    GfxMesh const  mesh = Tests::CreateGridMesh(10, 0, false);
+    uint64_t const key  = MeshCache::CalculateKey(mesh, 1, 2, false, false, false);
+    EXPECT_EQ(key, MeshCache::CalculateKey(Tests::CreateGridMesh(10, 0, false), 1, 2, false, false, false));
+    EXPECT_NE(key, MeshCache::CalculateKey(Tests::CreateGridMesh(10, 1, false), 1, 2, false, false, false));
+    EXPECT_NE(key, MeshCache::CalculateKey(mesh, 1, 3, false, false, false));
+    EXPECT_NE(key, MeshCache::CalculateKey(mesh, 1, 2, true, false, false));
+    EXPECT_NE(key, MeshCache::CalculateKey(mesh, 1, 2, false, true, false));
+    // LOD settings are ignored when LODs are disabled
+    EXPECT_EQ(MeshCache::CalculateKey(mesh, 0, 0, false, false, false),
+        MeshCache::CalculateKey(mesh, 0, 2, true, false, false));
+}
+
+TEST_F(MeshCacheTest, RejectsInvalidEntries)
+{
+    MeshCache const cache(directory_);
+    GfxMesh const   mesh = Tests::CreateGridMesh(10, 0, false);
+    MeshBuildData   data;
+    BuildMesh(mesh, MeshBuildSettings {}, data);
+    uint64_t const key = MeshCache::CalculateKey(mesh, 0, 0, false, false, false);
+    ASSERT_TRUE(cache.save(key, data));
+    MeshBuildData loaded;
+    EXPECT_FALSE(cache.load(key + 1, loaded));
+
+    // Truncate the entry
+    auto const filePath = std::filesystem::directory_iterator(directory_)->path();
+    std::filesystem::resize_file(filePath, std::filesystem::file_size(filePath) / 2);
+    EXPECT_FALSE(cache.load(key, loaded));
+
+    EXPECT_FALSE(MeshCache().save(key, data));
+    EXPECT_FALSE(MeshCache().load(key, loaded));
+}
@@ -0,0 +1,46 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+#include "parallel.h"
+
+#include <string>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Measure the dispatch overhead of many small parallel loops, such as the per frame scene trackers. */
+void ParallelForOverhead(Benchmark::State &state)
+{
+    uint32_t const        call_count = state.size(1000, 100);
+    std::vector<uint32_t> values(64);
+    state.run(std::to_string(call_count) + " calls x 64 items", [&] {
+        for (uint32_t call = 0; call < call_count; ++call)
+        {
+            ParallelFor(0U, 64U, [&](uint32_t const i) { values[i] += i; });
+        }
+        Benchmark::KeepAlive(values.data());
+    });
+}
+CAPSAICIN_BENCHMARK(ParallelForOverhead);
+} // namespace
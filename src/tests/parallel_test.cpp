@@ -0,0 +1,144 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "parallel.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+
+using namespace Capsaicin;
+
+TEST(ParallelFor, VisitsEveryIndexOnce)
+{
+    std::vector<std::atomic<uint32_t>> visits(10000);
+    ParallelFor(0U, static_cast<uint32_t>(visits.size()), [&](uint32_t const i) { ++visits[i]; });
+    for (auto const &visit : visits)
+    {
+        EXPECT_EQ(visit.load(), 1U);
+    }
+}
+
+TEST(ParallelFor, HonoursRange)
+{
+    std::vector<std::atomic<uint32_t>> visits(100);
+    ParallelFor(20U, 30U, [&](uint32_t const i) { ++visits[i]; });
+    ParallelFor(50U, 50U, [&](uint32_t const i) { ++visits[i]; });
+    for (uint32_t i = 0; i < visits.size(); ++i)
+    {
+        EXPECT_EQ(visits[i].load(), i >= 20 && i < 30 ? 1U : 0U) << "index " << i;
+    }
+}
+
+TEST(ParallelFor, ReusesWorkerThreads)
+{
+    // Worker threads are persistent so repeated calls must not keep creating new threads
+    std::mutex                mutex;
+    std::set<std::thread::id> threads;
+    for (uint32_t call = 0; call < 64; ++call)
+    {
+        ParallelFor(0U, 256U, [&](uint32_t) {
+            std::scoped_lock const lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        });
+    }
+    EXPECT_LE(threads.size(), static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)));
+}
+
+TEST(ParallelFor, SupportsNestedCalls)
+{
+    std::vector<std::atomic<uint32_t>> visits(64 * 64);
+    ParallelFor(0U, 64U, [&](uint32_t const outer) {
+        ParallelFor(0U, 64U, [&](uint32_t const inner) { ++visits[outer * 64 + inner]; });
+    });
+    for (auto const &visit : visits)
+    {
+        EXPECT_EQ(visit.load(), 1U);
+    }
+}
+
+TEST(ParallelFor, SupportsConcurrentCallers)
+{
+    // Callers that find the pool busy run inline, every call must still complete
+    std::vector<std::atomic<uint32_t>> visits(8 * 1000);
+    std::vector<std::jthread>          callers;
+    for (uint32_t caller = 0; caller < 8; ++caller)
+    {
+        callers.emplace_back([&, caller] {
+            for (uint32_t repeat = 0; repeat < 10; ++repeat)
+            {
+                ParallelFor(caller * 1000, (caller + 1) * 1000, [&](uint32_t const i) { ++visits[i]; });
+            }
+        });
+    }
+    callers.clear();
+    for (auto const &visit : visits)
+    {
+        EXPECT_EQ(visit.load(), 10U);
+    }
+}
+
+TEST(ParallelReduce, MatchesSerialSum)
+{
+    std::vector<uint64_t> values(100000);
+    std::iota(values.begin(), values.end(), 1ULL);
+    auto const sum = ParallelReduce(
+        values.data(), static_cast<uint32_t>(values.size()), 0ULL,
+        [](uint64_t const *begin, uint64_t const *end, uint64_t total) {
+            for (; begin != end; ++begin)
+            {
+                total += *begin;
+            }
+            return total;
+        },
+        [](uint64_t const left, uint64_t const right) { return left + right; });
+    EXPECT_EQ(sum, values.size() * (values.size() + 1) / 2);
+}
+
+TEST(ParallelReduce, IsDeterministicForNonAssociativeCombine)
+{
+    std::vector<float> values(50000);
+    for (uint32_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = 1.0F / static_cast<float>(i + 1);
+    }
+    auto const reduce = [&] {
+        return ParallelReduce(
+            values.data(), static_cast<uint32_t>(values.size()), 0.0F,
+            [](float const *begin, float const *end, float total) {
+                for (; begin != end; ++begin)
+                {
+                    total += *begin;
+                }
+                return total;
+            },
+            [](float const left, float const right) { return left + right; });
+    };
+    float const first = reduce();
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(reduce(), first);
+    }
+}
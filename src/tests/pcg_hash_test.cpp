@@ -0,0 +1,132 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "utilities/pcg_hash.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Number of sequences in a 1080p frame, the previous size of the CPU generated seed buffer. */
+constexpr uint32_t FrameSize = 1920U * 1080U;
+
+constexpr std::array<uint32_t, 3> GlobalSeeds = {0U, 1U, 0xDEADBEEFU};
+
+std::vector<uint32_t> CreateSeeds(uint32_t const globalSeed)
+{
+    std::vector<uint32_t> seeds(FrameSize);
+    for (uint32_t i = 0; i < FrameSize; ++i)
+    {
+        seeds[i] = MakeSeed(i, globalSeed);
+    }
+    return seeds;
+}
+} // namespace
+
+TEST(PcgHash, MatchesReferenceValues)
+{
+    // Pins the hash so that changes to hash.hlsl or its CPU reproduction are caught
+    EXPECT_EQ(PcgHash(0U), 129708002U);
+    EXPECT_EQ(PcgHash(1U), 2831084092U);
+    EXPECT_EQ(PcgHash(0xFFFFFFFFU), 3861530882U);
+    EXPECT_EQ(MakeSeed(0U, 0U), PcgHash(PcgHash(0U)));
+    EXPECT_EQ(MakeSeed(5U, 7U), PcgHash(5U + PcgHash(7U)));
+}
+
+TEST(PcgHash, SeedsAreUniqueWithinFrame)
+{
+    for (uint32_t const globalSeed : GlobalSeeds)
+    {
+        std::vector<uint32_t> seeds = CreateSeeds(globalSeed);
+        std::ranges::sort(seeds);
+        EXPECT_EQ(std::ranges::adjacent_find(seeds), seeds.end()) << "global seed " << globalSeed;
+    }
+}
+
+TEST(PcgHash, SeedsDifferBetweenGlobalSeeds)
+{
+    std::vector<uint32_t> const seeds0 = CreateSeeds(GlobalSeeds[0]);
+    std::vector<uint32_t> const seeds1 = CreateSeeds(GlobalSeeds[1]);
+    uint32_t                    equal  = 0;
+    for (uint32_t i = 0; i < FrameSize; ++i)
+    {
+        equal += seeds0[i] == seeds1[i] ? 1U : 0U;
+    }
+    EXPECT_LT(equal, 16U);
+}
+
+TEST(PcgHash, SeedsAreUniformlyDistributed)
+{
+    // Chi-squared over 256 buckets has 255 degrees of freedom (mean 255, standard deviation ~22.6)
+    constexpr uint32_t bucketCount = 256;
+    constexpr double   expected    = static_cast<double>(FrameSize) / bucketCount;
+    for (uint32_t const globalSeed : GlobalSeeds)
+    {
+        std::array<uint32_t, bucketCount> buckets {};
+        std::array<uint32_t, 32>          bitCounts {};
+        for (uint32_t const seed : CreateSeeds(globalSeed))
+        {
+            ++buckets[seed >> 24U];
+            for (uint32_t bit = 0; bit < 32; ++bit)
+            {
+                bitCounts[bit] += (seed >> bit) & 1U;
+            }
+        }
+        double chiSquared = 0.0;
+        for (uint32_t const count : buckets)
+        {
+            double const difference  = static_cast<double>(count) - expected;
+            chiSquared              += difference * difference / expected;
+        }
+        EXPECT_LT(chiSquared, 360.0) << "global seed " << globalSeed;
+        for (uint32_t bit = 0; bit < 32; ++bit)
+        {
+            double const bias = static_cast<double>(bitCounts[bit]) / FrameSize - 0.5;
+            EXPECT_LT(std::abs(bias), 0.002) << "global seed " << globalSeed << ", bit " << bit;
+        }
+    }
+}
+
+TEST(PcgHash, NeighbouringSeedsAvalanche)
+{
+    // Neighbouring pixels should receive unrelated seeds, so on average half their bits should differ
+    for (uint32_t const globalSeed : GlobalSeeds)
+    {
+        uint64_t changedBits = 0;
+        uint32_t previous    = MakeSeed(0, globalSeed);
+        for (uint32_t i = 1; i < FrameSize; ++i)
+        {
+            uint32_t const seed  = MakeSeed(i, globalSeed);
+            changedBits         += static_cast<uint64_t>(std::popcount(seed ^ previous));
+            previous             = seed;
+        }
+        double const averageChangedBits = static_cast<double>(changedBits) / (FrameSize - 1);
+        EXPECT_NEAR(averageChangedBits, 16.0, 0.05) << "global seed " << globalSeed;
+    }
+}
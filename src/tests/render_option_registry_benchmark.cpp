@@ -0,0 +1,126 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+#include "render_option_registry.h"
+
+#include <string>
+#include <vector>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Number of render techniques and components reading their options each frame. */
+constexpr uint32_t kOptionGroupCount = 16;
+
+/** Number of options owned by each technique or component. */
+constexpr uint32_t kOptionsPerGroup = 16;
+
+/**
+ * Measure the per-frame CPU cost of checking render options. Reading every option of every group by name
+ * (as 'convertOptions' did each frame) is compared to updating the registry and checking the generation of
+ * each group.
+ */
+void RenderOptionRegistryUpdate(Benchmark::State &state)
+{
+    uint32_t const frame_count = state.size(10000, 100);
+
+    // Option names are held by the techniques, the options list only stores views of them
+    std::vector<std::string> names;
+    for (uint32_t group = 0; group < kOptionGroupCount; ++group)
+    {
+        for (uint32_t option = 0; option < kOptionsPerGroup; ++option)
+        {
+            names.push_back("technique" + std::to_string(group) + "_option_name_" + std::to_string(option));
+        }
+    }
+    RenderOptionList options;
+    for (uint32_t i = 0; i < names.size(); ++i)
+    {
+        options.emplace(names[i], i);
+    }
+
+    state.run("name lookup", [&] {
+        uint32_t sum = 0;
+        for (uint32_t frame = 0; frame < frame_count; ++frame)
+        {
+            for (auto const &name : names)
+            {
+                sum += *std::get_if<uint32_t>(&options.at(name));
+            }
+        }
+        Benchmark::KeepAlive(&sum);
+    });
+
+    RenderOptionRegistry registry;
+    registry.compile(options);
+    std::vector<RenderOptionRegistry::GroupHandle> groups;
+    std::vector<RenderOptionRegistry::Handle>      handles;
+    for (uint32_t group = 0; group < kOptionGroupCount; ++group)
+    {
+        RenderOptionList members;
+        for (uint32_t option = 0; option < kOptionsPerGroup; ++option)
+        {
+            std::string const &name = names[group * kOptionsPerGroup + option];
+            members.emplace(name, options.at(name));
+            handles.push_back(registry.getHandle(name));
+        }
+        groups.push_back(registry.addGroup(names[group * kOptionsPerGroup], members));
+    }
+    std::vector<uint64_t> seen(kOptionGroupCount, 0);
+
+    // Each group re-reads its options through their handles only when one of them has changed
+    auto const readChanged = [&](uint32_t &sum) {
+        for (uint32_t group = 0; group < kOptionGroupCount; ++group)
+        {
+            if (registry.checkChanged(groups[group], seen[group]))
+            {
+                for (uint32_t option = 0; option < kOptionsPerGroup; ++option)
+                {
+                    sum += registry.getValue<uint32_t>(handles[group * kOptionsPerGroup + option]);
+                }
+            }
+        }
+    };
+    state.run("registry unchanged", [&] {
+        uint32_t sum = 0;
+        for (uint32_t frame = 0; frame < frame_count; ++frame)
+        {
+            registry.update(options);
+            readChanged(sum);
+        }
+        Benchmark::KeepAlive(&sum);
+    });
+    state.run("registry one edit per frame", [&] {
+        uint32_t sum = 0;
+        for (uint32_t frame = 0; frame < frame_count; ++frame)
+        {
+            options.at(names[frame % names.size()]) = frame;
+            registry.update(options);
+            readChanged(sum);
+        }
+        Benchmark::KeepAlive(&sum);
+    });
+}
+CAPSAICIN_BENCHMARK(RenderOptionRegistryUpdate);
+} // namespace
@@ -0,0 +1,161 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "render_option_registry.h"
+
+#include <gtest/gtest.h>
+
+using namespace Capsaicin;
+
+namespace
+{
+RenderOptionList CreateOptions()
+{
+    return {{"enable", true}, {"count", uint32_t {4}}, {"offset", int32_t {-2}}, {"scale", 0.5F},
+        {"name", std::string("default")}};
+}
+} // namespace
+
+TEST(RenderOptionRegistry, ResolvesHandles)
+{
+    RenderOptionList const options = CreateOptions();
+    RenderOptionRegistry   registry;
+    registry.compile(options);
+
+    RenderOptionRegistry::Handle const count = registry.getHandle("count");
+    ASSERT_NE(count, RenderOptionRegistry::InvalidHandle);
+    EXPECT_NE(registry.getHandle("scale"), count);
+    EXPECT_EQ(registry.getHandle("unknown"), RenderOptionRegistry::InvalidHandle);
+    EXPECT_EQ(registry.getValue<uint32_t>(count), 4U);
+    EXPECT_EQ(registry.getValue<float>(registry.getHandle("scale")), 0.5F);
+    EXPECT_EQ(registry.getValue<std::string>(registry.getHandle("name")), "default");
+
+    // Invalid handles and mismatched types return a default value
+    EXPECT_EQ(registry.getValue<float>(count), 0.0F);
+    EXPECT_EQ(registry.getValue<uint32_t>(RenderOptionRegistry::InvalidHandle), 0U);
+    EXPECT_EQ(registry.getGeneration(RenderOptionRegistry::InvalidHandle), 0U);
+}
+
+TEST(RenderOptionRegistry, UpdatePicksUpEdits)
+{
+    RenderOptionList     options = CreateOptions();
+    RenderOptionRegistry registry;
+    registry.compile(options);
+    RenderOptionRegistry::Handle const count  = registry.getHandle("count");
+    RenderOptionRegistry::Handle const scale  = registry.getHandle("scale");
+    uint64_t const                     before = registry.getGeneration();
+    EXPECT_FALSE(registry.update(options));
+    EXPECT_EQ(registry.getGeneration(), before);
+
+    // The GUI edits values directly in the options list
+    options["count"] = uint32_t {8};
+    EXPECT_TRUE(registry.update(options));
+    EXPECT_EQ(registry.getValue<uint32_t>(count), 8U);
+    EXPECT_GT(registry.getGeneration(), before);
+    EXPECT_EQ(registry.getGeneration(count), registry.getGeneration());
+    EXPECT_LE(registry.getGeneration(scale), before);
+    EXPECT_FALSE(registry.update(options));
+
+    // Writing an identical value is not a change
+    options["count"] = uint32_t {8};
+    EXPECT_FALSE(registry.update(options));
+}
+
+TEST(RenderOptionRegistry, GroupGenerations)
+{
+    RenderOptionList     options = CreateOptions();
+    RenderOptionRegistry registry;
+    registry.compile(options);
+    RenderOptionRegistry::GroupHandle const first =
+        registry.addGroup("First", {{"enable", true}, {"count", uint32_t {4}}});
+    RenderOptionRegistry::GroupHandle const second = registry.addGroup("Second", {{"scale", 0.5F}});
+    EXPECT_EQ(registry.getGroup("First"), first);
+    EXPECT_EQ(registry.getGroup("Second"), second);
+    EXPECT_EQ(registry.getGroup("Unknown"), RenderOptionRegistry::InvalidGroupHandle);
+
+    // New groups are always reported as changed once
+    uint64_t firstSeen  = 0;
+    uint64_t secondSeen = 0;
+    EXPECT_TRUE(registry.checkChanged(first, firstSeen));
+    EXPECT_TRUE(registry.checkChanged(second, secondSeen));
+    EXPECT_FALSE(registry.checkChanged(first, firstSeen));
+    EXPECT_FALSE(registry.checkChanged(second, secondSeen));
+
+    options["count"] = uint32_t {5};
+    ASSERT_TRUE(registry.update(options));
+    EXPECT_EQ(registry.getGroupGeneration(first), registry.getGeneration());
+    EXPECT_LT(registry.getGroupGeneration(second), registry.getGeneration());
+    EXPECT_TRUE(registry.checkChanged(first, firstSeen));
+    EXPECT_FALSE(registry.checkChanged(second, secondSeen));
+    EXPECT_FALSE(registry.checkChanged(first, firstSeen));
+
+    // Unknown groups are always reported as changed so callers fall back to reading the options list
+    uint64_t unknownSeen = registry.getGeneration();
+    EXPECT_TRUE(registry.checkChanged(RenderOptionRegistry::InvalidGroupHandle, unknownSeen));
+    EXPECT_EQ(registry.getGroupGeneration(RenderOptionRegistry::InvalidGroupHandle), 0U);
+
+    // Replacing a group keeps its handle and reports it as changed
+    options["offset"] = int32_t {3};
+    ASSERT_TRUE(registry.update(options));
+    EXPECT_FALSE(registry.checkChanged(second, secondSeen));
+    EXPECT_EQ(registry.addGroup("Second", {{"scale", 0.5F}, {"offset", int32_t {3}}}), second);
+    EXPECT_TRUE(registry.checkChanged(second, secondSeen));
+}
+
+TEST(RenderOptionRegistry, DetectsStructuralChanges)
+{
+    RenderOptionList     options = CreateOptions();
+    RenderOptionRegistry registry;
+    registry.compile(options);
+    RenderOptionRegistry::Handle const count  = registry.getHandle("count");
+    RenderOptionRegistry::Handle const offset = registry.getHandle("offset");
+
+    // Erase and insert without changing the size of the list
+    options.erase("offset");
+    options.emplace("bias", 0.25F);
+    EXPECT_TRUE(registry.update(options));
+    RenderOptionRegistry::Handle const bias = registry.getHandle("bias");
+    ASSERT_NE(bias, RenderOptionRegistry::InvalidHandle);
+    EXPECT_EQ(registry.getValue<float>(bias), 0.25F);
+    EXPECT_EQ(registry.getHandle("count"), count);
+    options["bias"] = 0.75F;
+    EXPECT_TRUE(registry.update(options));
+    EXPECT_EQ(registry.getValue<float>(bias), 0.75F);
+
+    // Options that are removed keep their last value and handle
+    EXPECT_EQ(registry.getHandle("offset"), offset);
+    EXPECT_EQ(registry.getValue<int32_t>(offset), -2);
+
+    // Re-inserting an option with the same name replaces its storage within the list
+    options.erase("count");
+    options.emplace("count", uint32_t {4});
+    options["count"] = uint32_t {16};
+    EXPECT_TRUE(registry.update(options));
+    EXPECT_EQ(registry.getValue<uint32_t>(count), 16U);
+
+    // Added options are compiled with existing handles unchanged
+    options.emplace("offset", int32_t {7});
+    EXPECT_TRUE(registry.update(options));
+    EXPECT_EQ(registry.getHandle("offset"), offset);
+    EXPECT_EQ(registry.getValue<int32_t>(offset), 7);
+    EXPECT_FALSE(registry.update(options));
+}
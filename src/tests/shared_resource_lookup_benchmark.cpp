@@ -0,0 +1,184 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "benchmark.h"
+#include "resource_handle.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace Capsaicin;
+
+namespace
+{
+/** Stand in for GfxTexture/GfxBuffer, which are copied by value into the shared resource lists. */
+struct Resource
+{
+    uint64_t handle;
+    char     name[64];
+};
+
+struct Component
+{
+    virtual ~Component() = default;
+};
+
+struct LightSampler : Component
+{};
+
+/** Representative shared textures of a renderer using GI-1, the stock AOVs followed by their backups. */
+constexpr std::array<std::string_view, 36> kSharedTextures = {"Color", "ColorScaled", "Debug", "Depth",
+    "DirectLighting", "DirectLightingDiffuse", "DirectLightingSpecular", "DisocclusionMask", "Emission",
+    "GeometryNormal", "GlobalIllumination", "GlobalIlluminationDiffuse", "GlobalIlluminationSpecular",
+    "Gradients", "MeshletCull", "MeshletPack", "Meshlets", "NearFieldGlobalIllumination",
+    "OcclusionAndBentNormal", "PrevCombinedIllumination", "Reflection", "Roughness", "ShadingNormal",
+    "Velocity", "VertexNormal", "Visibility", "VisibilityDepth", "PrevVisibilityDepth", "PrevGeometryNormal",
+    "PrevShadingNormal", "PrevRoughness", "PrevReflection", "PrevVertexNormal", "PrevVisibility",
+    "PrevColor", "PrevDepth"};
+
+/** Shared textures that GI-1 looked up by name each frame before using handles, in source order. */
+constexpr std::array<std::string_view, 30> kFrameAccesses = {"Debug", "Debug", "Debug", "VisibilityDepth",
+    "GeometryNormal", "ShadingNormal", "Velocity", "Gradients", "Roughness", "OcclusionAndBentNormal",
+    "NearFieldGlobalIllumination", "Visibility", "PrevVisibilityDepth",
+    "PrevGeometryNormal", "PrevShadingNormal", "PrevRoughness", "PrevCombinedIllumination", "Reflection",
+    "PrevReflection", "GlobalIllumination", "Debug", "Debug", "Debug", "GlobalIllumination",
+    "OcclusionAndBentNormal", "Reflection", "Debug", "Debug", "Debug", "GlobalIllumination"};
+
+/** Shared buffers and components accessed by 'GI1::render()' each frame. */
+constexpr uint32_t kFrameBufferAccesses    = 1;
+constexpr uint32_t kFrameComponentAccesses = 6;
+
+/**
+ * Measure the CPU cost of the per-frame shared resource accesses made by GI-1, using the name lookups of the
+ * string based 'CapsaicinInternal' accessors and the pre-resolved handles that replace them.
+ */
+void SharedResourceLookup(Benchmark::State &state)
+{
+    uint32_t const frame_count = state.size(100000, 1000);
+
+    using ResourceList = std::vector<std::pair<std::string_view, Resource>>;
+    ResourceList textures;
+    for (auto const &name : kSharedTextures)
+    {
+        textures.emplace_back(name, Resource {});
+    }
+    ResourceList const buffers = {{"Exposure", {}}, {"Meshlets", {}}, {"MeshletCull", {}}};
+    std::vector<std::pair<std::string_view, uint32_t>> const aliased_textures;
+    std::vector<std::pair<std::string_view, std::shared_ptr<Component>>> components;
+    for (auto const &name : {"BlueNoiseSampler", "BrdfLut", "LightBuilder", "LightSamplerGridStream",
+             "PrefilterIBL", "RandomNumberGenerator", "StratifiedSampler", "Stub"})
+    {
+        components.emplace_back(name, std::make_shared<LightSampler>());
+    }
+
+    // Mirrors 'CapsaicinInternal::getSharedTexture(string_view)'
+    auto const getTextureByName = [&](std::string_view const &name) -> Resource const & {
+        if (auto const i =
+                std::ranges::find_if(textures, [&name](auto const &item) { return item.first == name; });
+            i != textures.cend())
+        {
+            return i->second;
+        }
+        if (auto const i = std::ranges::find_if(
+                aliased_textures, [&name](auto const &item) { return item.first == name; });
+            i != aliased_textures.cend())
+        {
+            return textures[i->second].second;
+        }
+        return textures.front().second;
+    };
+    // Mirrors 'CapsaicinInternal::getSharedBuffer(string_view)'
+    auto const getBufferByName = [&](std::string_view const &name) -> Resource const & {
+        auto const i =
+            std::ranges::find_if(buffers, [&name](auto const &item) { return item.first == name; });
+        return i->second;
+    };
+    // Mirrors 'CapsaicinInternal::getComponent<T>()'
+    auto const getComponentByName = [&](std::string_view const &name) {
+        auto const i =
+            std::ranges::find_if(components, [&name](auto const &item) { return item.first == name; });
+        return std::dynamic_pointer_cast<LightSampler>(i->second);
+    };
+
+    state.run("name lookup " + std::to_string(frame_count) + " frames", [&] {
+        uint64_t sum = 0;
+        for (uint32_t frame = 0; frame < frame_count; ++frame)
+        {
+            for (auto const &name : kFrameAccesses)
+            {
+                sum += getTextureByName(name).handle;
+            }
+            for (uint32_t i = 0; i < kFrameBufferAccesses; ++i)
+            {
+                sum += getBufferByName("Exposure").handle;
+            }
+            for (uint32_t i = 0; i < kFrameComponentAccesses; ++i)
+            {
+                sum += getComponentByName("LightSamplerGridStream") != nullptr ? 1 : 0;
+            }
+        }
+        Benchmark::KeepAlive(&sum);
+    });
+
+    // Handles are resolved once, as done in 'GI1::init()'
+    auto const resolve = [](auto const &list, std::string_view const &name) {
+        auto const i = std::ranges::find_if(list, [&name](auto const &item) { return item.first == name; });
+        return static_cast<uint32_t>(std::distance(list.begin(), i));
+    };
+    std::vector<ResourceHandle<Resource>> handles;
+    for (auto const &name : kFrameAccesses)
+    {
+        handles.push_back({resolve(textures, name)});
+    }
+    ResourceHandle<Resource> const     buffer_handle    = {resolve(buffers, "Exposure")};
+    ResourceHandle<LightSampler> const component_handle = {resolve(components, "LightSamplerGridStream")};
+
+    state.run("handle lookup " + std::to_string(frame_count) + " frames", [&] {
+        uint64_t sum = 0;
+        for (uint32_t frame = 0; frame < frame_count; ++frame)
+        {
+            for (auto const &handle : handles)
+            {
+                sum += handle.index < textures.size() ? textures[handle.index].second.handle : 0;
+            }
+            for (uint32_t i = 0; i < kFrameBufferAccesses; ++i)
+            {
+                sum += buffer_handle.index < buffers.size() ? buffers[buffer_handle.index].second.handle : 0;
+            }
+            for (uint32_t i = 0; i < kFrameComponentAccesses; ++i)
+            {
+                auto const *component = component_handle.index < components.size()
+                                          ? static_cast<LightSampler *>(
+                                                components[component_handle.index].second.get())
+                                          : nullptr;
+                sum += component != nullptr ? 1 : 0;
+            }
+        }
+        Benchmark::KeepAlive(&sum);
+    });
+}
+CAPSAICIN_BENCHMARK(SharedResourceLookup);
+} // namespace
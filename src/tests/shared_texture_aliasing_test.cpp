@@ -0,0 +1,162 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+
+#include "shared_texture_aliasing.h"
+
+#include <gtest/gtest.h>
+
+using namespace Capsaicin;
+
+namespace
+{
+constexpr uint64_t kKey  = 1;
+constexpr uint64_t kSize = 1024;
+
+/**
+ * Adds a transient texture that is written at its first pass and read at its last, these must differ as
+ * reading during the first pass makes the texture persistent.
+ */
+uint32_t AddTransient(SharedTextureAliasing &aliasing, uint32_t const firstPass, uint32_t const lastPass,
+    uint64_t const key = kKey, bool const cleared = false)
+{
+    uint32_t const texture = aliasing.addTexture(key, kSize, true, cleared);
+    aliasing.addAccess(texture, firstPass, false);
+    aliasing.addAccess(texture, lastPass, true);
+    return texture;
+}
+} // namespace
+
+TEST(SharedTextureAliasing, AliasesDisjointLifetimes)
+{
+    SharedTextureAliasing aliasing;
+    uint32_t const        first  = AddTransient(aliasing, 0, 1);
+    uint32_t const        second = AddTransient(aliasing, 2, 3);
+    uint32_t const        third  = AddTransient(aliasing, 4, 5);
+    aliasing.pack();
+    EXPECT_EQ(aliasing.getAllocation(first), first);
+    EXPECT_EQ(aliasing.getAllocation(second), first);
+    EXPECT_EQ(aliasing.getAllocation(third), first);
+    EXPECT_EQ(aliasing.getAllocationCount(), 1U);
+    EXPECT_EQ(aliasing.getTotalSize(), 3 * kSize);
+    EXPECT_EQ(aliasing.getAliasedSize(), kSize);
+}
+
+TEST(SharedTextureAliasing, KeepsOverlappingLifetimesSeparate)
+{
+    SharedTextureAliasing aliasing;
+    uint32_t const        first  = AddTransient(aliasing, 0, 2);
+    uint32_t const        second = AddTransient(aliasing, 1, 3);
+    // Sharing a pass is an overlap as both textures are accessed by it
+    uint32_t const third = AddTransient(aliasing, 3, 4);
+    aliasing.pack();
+    EXPECT_EQ(aliasing.getAllocation(first), first);
+    EXPECT_EQ(aliasing.getAllocation(second), second);
+    EXPECT_EQ(aliasing.getAllocation(third), first);
+    EXPECT_EQ(aliasing.getAllocationCount(), 2U);
+    EXPECT_EQ(aliasing.getAliasedSize(), 2 * kSize);
+}
+
+TEST(SharedTextureAliasing, PrefersLatestReleasedAllocation)
+{
+    // Reusing the earliest released allocation for 'third' would leave none free for 'fourth'
+    SharedTextureAliasing aliasing;
+    uint32_t const        first  = AddTransient(aliasing, 0, 1);
+    uint32_t const        second = AddTransient(aliasing, 0, 3);
+    uint32_t const        fourth = AddTransient(aliasing, 2, 6);
+    uint32_t const        third  = AddTransient(aliasing, 4, 5);
+    aliasing.pack();
+    EXPECT_EQ(aliasing.getAllocation(fourth), first);
+    EXPECT_EQ(aliasing.getAllocation(third), second);
+    EXPECT_EQ(aliasing.getAllocationCount(), 2U);
+}
+
+TEST(SharedTextureAliasing, KeepsHistoryTexturesSeparate)
+{
+    SharedTextureAliasing aliasing;
+    uint32_t const        first = AddTransient(aliasing, 0, 1);
+    // Read before being written so its contents must persist from the previous frame
+    uint32_t const history = aliasing.addTexture(kKey, kSize, true, false);
+    aliasing.addAccess(history, 2, true);
+    aliasing.addAccess(history, 3, false);
+    // Explicitly marked as persistent (i.e. accumulation)
+    uint32_t const accumulation = aliasing.addTexture(kKey, kSize, false, false);
+    aliasing.addAccess(accumulation, 4, false);
+    // Read and written by its first pass
+    uint32_t const feedback = aliasing.addTexture(kKey, kSize, true, false);
+    aliasing.addAccess(feedback, 5, false);
+    aliasing.addAccess(feedback, 5, true);
+    uint32_t const last = AddTransient(aliasing, 6, 7);
+    aliasing.pack();
+    EXPECT_EQ(aliasing.getAllocation(history), history);
+    EXPECT_EQ(aliasing.getAllocation(accumulation), accumulation);
+    EXPECT_EQ(aliasing.getAllocation(feedback), feedback);
+    // Persistent textures never give up their allocation
+    EXPECT_EQ(aliasing.getAllocation(last), first);
+    EXPECT_EQ(aliasing.getAllocationCount(), 4U);
+}
+
+TEST(SharedTextureAliasing, ClearedTexturesOnlyStartAllocations)
+{
+    SharedTextureAliasing aliasing;
+    uint32_t const        first   = AddTransient(aliasing, 0, 1);
+    uint32_t const        cleared = AddTransient(aliasing, 2, 3, kKey, true);
+    uint32_t const        last    = AddTransient(aliasing, 4, 5);
+    aliasing.pack();
+    // The clear at the start of the frame would overwrite the contents of 'first'
+    EXPECT_EQ(aliasing.getAllocation(cleared), cleared);
+    // Later textures may still reuse the allocation of a cleared one
+    EXPECT_EQ(aliasing.getAllocation(last), cleared);
+    EXPECT_EQ(aliasing.getAllocation(first), first);
+    EXPECT_EQ(aliasing.getAllocationCount(), 2U);
+}
+
+TEST(SharedTextureAliasing, OnlyAliasesMatchingKeys)
+{
+    SharedTextureAliasing aliasing;
+    uint32_t const        first  = AddTransient(aliasing, 0, 1, kKey);
+    uint32_t const        second = AddTransient(aliasing, 2, 3, kKey + 1);
+    uint32_t const        third  = AddTransient(aliasing, 4, 5, kKey + 1);
+    uint32_t const        fourth = AddTransient(aliasing, 6, 7, kKey);
+    aliasing.pack();
+    EXPECT_EQ(aliasing.getAllocation(second), second);
+    EXPECT_EQ(aliasing.getAllocation(third), second);
+    EXPECT_EQ(aliasing.getAllocation(fourth), first);
+    EXPECT_EQ(aliasing.getAllocationCount(), 2U);
+}
+
+TEST(SharedTextureAliasing, KeepsUnusedTexturesSeparate)
+{
+    SharedTextureAliasing aliasing;
+    uint32_t const        first  = AddTransient(aliasing, 0, 1);
+    uint32_t const        unused = aliasing.addTexture(kKey, kSize, true, false);
+    uint32_t const        last   = AddTransient(aliasing, 2, 3);
+    aliasing.pack();
+    EXPECT_EQ(aliasing.getAllocation(unused), unused);
+    EXPECT_EQ(aliasing.getAllocation(last), first);
+    EXPECT_EQ(aliasing.getAllocationCount(), 2U);
+
+    aliasing.reset();
+    EXPECT_EQ(aliasing.getAllocationCount(), 0U);
+    EXPECT_EQ(aliasing.getTotalSize(), 0U);
+    EXPECT_EQ(aliasing.getAliasedSize(), 0U);
+    EXPECT_EQ(aliasing.addTexture(kKey, kSize, true, false), 0U);
+}
@@ -0,0 +1,77 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "lights/lights_shared.h"
+
+#include <random>
+#include <vector>
+
+namespace Capsaicin::Tests
+{
+/**
+ * Create a random light list for testing light sampling.
+ * Infinite lights are placed at the start of the list as required by the light samplers, they are followed
+ * by a mix of area, point and spot lights with varying intensity.
+ * @param count         Total number of lights.
+ * @param infiniteCount Number of environment/directional lights at the start of the list.
+ * @param seed          Random number seed.
+ * @param extent        Half size of the region that lights are placed within.
+ * @return The new light list.
+ */
+inline std::vector<Light> CreateLights(uint32_t const count, uint32_t const infiniteCount,
+    uint32_t const seed, float const extent = 50.0F) noexcept
+{
+    std::mt19937                          random(seed);
+    std::uniform_real_distribution<float> unit(-1.0F, 1.0F);
+    std::uniform_real_distribution<float> intensity(0.1F, 10.0F);
+    std::vector<Light>                    lights;
+    lights.reserve(count);
+    for (uint32_t i = 0; i < infiniteCount && i < count; ++i)
+    {
+        lights.push_back(i == 0 ? MakeEnvironmentLight(8, 256)
+                                : MakeDirectionalLight(float3(intensity(random)),
+                                    float3(unit(random), 1.0F, unit(random)), 1e6F));
+    }
+    while (lights.size() < count)
+    {
+        float3 const position = float3(unit(random), unit(random), unit(random)) * extent;
+        float3 const radiance(intensity(random), intensity(random), intensity(random));
+        switch (lights.size() % 8)
+        {
+        case 0:
+            lights.push_back(MakePointLight(radiance, position, 100.0F));
+            break;
+        case 1:
+            lights.push_back(MakeSpotLight(radiance, position, 100.0F,
+                float3(unit(random), unit(random), unit(random) + 2.0F), 0.6F, 0.4F));
+            break;
+        default:
+            lights.push_back(MakeAreaLight(radiance, position,
+                position + float3(unit(random), unit(random), unit(random)),
+                position + float3(unit(random), unit(random), unit(random))));
+            break;
+        }
+    }
+    return lights;
+}
+} // namespace Capsaicin::Tests
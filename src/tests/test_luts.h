@@ -0,0 +1,55 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace Capsaicin::Tests
+{
+/**
+ * Create the contents of a '.cube' file where each entry stores its own red, green and blue coordinates.
+ * @param lutSize The size of each dimension of the LUT.
+ * @param lineEnd The line ending to use.
+ * @return The file contents.
+ */
+inline std::string CreateIdentityCube(uint32_t const lutSize, char const *lineEnd = "\n")
+{
+    std::ostringstream cube;
+    cube << "TITLE \"Identity\"" << lineEnd << "# Comment" << lineEnd << "LUT_3D_SIZE " << lutSize << lineEnd
+         << lineEnd;
+    for (uint32_t b = 0; b < lutSize; ++b)
+    {
+        for (uint32_t g = 0; g < lutSize; ++g)
+        {
+            for (uint32_t r = 0; r < lutSize; ++r)
+            {
+                cube << static_cast<float>(r) / static_cast<float>(lutSize - 1) << ' '
+                     << static_cast<float>(g) / static_cast<float>(lutSize - 1) << ' '
+                     << static_cast<float>(b) / static_cast<float>(lutSize - 1) << lineEnd;
+            }
+        }
+    }
+    return cube.str();
+}
+} // namespace Capsaicin::Tests
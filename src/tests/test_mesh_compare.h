@@ -0,0 +1,57 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "mesh_builder.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+namespace Capsaicin::Tests
+{
+/** Compare the raw contents of two vectors. */
+template<typename T>
+bool BytesEqual(std::vector<T> const &left, std::vector<T> const &right) noexcept
+{
+    return left.size() == right.size()
+        && (left.empty() || memcmp(left.data(), right.data(), left.size() * sizeof(T)) == 0);
+}
+
+/** Check that two processed meshes are identical. */
+inline void ExpectEqual(MeshBuildData const &left, MeshBuildData const &right, uint32_t const mesh) noexcept
+{
+    EXPECT_EQ(left.mesh.vertex_offset_idx[0], right.mesh.vertex_offset_idx[0]) << "mesh " << mesh;
+    EXPECT_EQ(left.mesh.vertex_offset_idx[1], right.mesh.vertex_offset_idx[1]) << "mesh " << mesh;
+    EXPECT_EQ(left.mesh.index_count, right.mesh.index_count) << "mesh " << mesh;
+    EXPECT_EQ(left.mesh.targets_count, right.mesh.targets_count) << "mesh " << mesh;
+    EXPECT_EQ(left.mesh.vertex_count, right.mesh.vertex_count) << "mesh " << mesh;
+    EXPECT_EQ(left.mesh.meshlet_count, right.mesh.meshlet_count) << "mesh " << mesh;
+    EXPECT_EQ(left.mesh.is_animated, right.mesh.is_animated) << "mesh " << mesh;
+    EXPECT_TRUE(BytesEqual(left.indices, right.indices)) << "mesh " << mesh;
+    EXPECT_TRUE(BytesEqual(left.vertices, right.vertices)) << "mesh " << mesh;
+    EXPECT_TRUE(BytesEqual(left.vertex_source, right.vertex_source)) << "mesh " << mesh;
+    EXPECT_TRUE(BytesEqual(left.joints, right.joints)) << "mesh " << mesh;
+    EXPECT_TRUE(BytesEqual(left.meshlets, right.meshlets)) << "mesh " << mesh;
+    EXPECT_TRUE(BytesEqual(left.meshlet_pack, right.meshlet_pack)) << "mesh " << mesh;
+    EXPECT_TRUE(BytesEqual(left.meshlet_cull, right.meshlet_cull)) << "mesh " << mesh;
+}
+} // namespace Capsaicin::Tests
@@ -0,0 +1,74 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include <gfx_scene.h>
+
+namespace Capsaicin::Tests
+{
+/**
+ * Create a synthetic grid mesh for testing mesh processing.
+ * Each quad uses its own 4 vertices so that vertex re-indexing has duplicates to remove.
+ * @param size     Number of quads along each side of the grid.
+ * @param seed     Value used to vary the vertex data between meshes.
+ * @param animated True to add skinning joints and morph targets.
+ * @return The new mesh.
+ */
+inline GfxMesh CreateGridMesh(uint32_t const size, uint32_t const seed, bool const animated) noexcept
+{
+    GfxMesh    mesh;
+    auto const offset = static_cast<float>(seed) * 0.25F;
+    for (uint32_t y = 0; y < size; ++y)
+    {
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            auto const base = static_cast<uint32_t>(mesh.vertices.size());
+            for (uint32_t corner = 0; corner < 4; ++corner)
+            {
+                auto const cx = static_cast<float>(x + (corner & 1U));
+                auto const cy = static_cast<float>(y + (corner >> 1U));
+                auto const cz = 0.1F * (cx + cy + offset - 2.0F * cx * cy / static_cast<float>(size));
+                GfxVertex  vertex;
+                vertex.position = glm::vec3(cx, cy, cz);
+                vertex.normal   = glm::vec3(0.0F, 0.0F, 1.0F);
+                vertex.uv       = glm::vec2(cx, cy) / static_cast<float>(size);
+                mesh.vertices.push_back(vertex);
+            }
+            mesh.indices.insert(mesh.indices.end(), {base, base + 1, base + 2, base + 2, base + 1, base + 3});
+        }
+    }
+    if (animated)
+    {
+        for (GfxVertex const &vertex : mesh.vertices)
+        {
+            GfxJoint joint;
+            joint.joints  = glm::uvec4(seed % 4, 0, 0, 0);
+            joint.weights = glm::vec4(1.0F, 0.0F, 0.0F, 0.0F);
+            mesh.joints.push_back(joint);
+            GfxVertex target = vertex;
+            target.position += glm::vec3(0.0F, 0.0F, 1.0F);
+            mesh.morph_targets.push_back(target);
+        }
+    }
+    return mesh;
+}
+} // namespace Capsaicin::Tests
@@ -0,0 +1,75 @@
+/**********************************************************************
+Copyright (c) 2025 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+********************************************************************/
+#pragma once
+
+#include "render_techniques/ct_ray_tracer/ct_bvh.h"
+
+#include <random>
+
+namespace Capsaicin::Tests
+{
+/**
+ * Create a random triangle soup for testing the CtRayTracer BVH.
+ * Triangles are mostly small and clustered, with a few large triangles to create overlapping bounds.
+ * @param count Number of triangles.
+ * @param seed  Random number seed.
+ * @return The new triangles.
+ */
+inline std::vector<CtBvh::Triangle> CreateTriangles(uint32_t const count, uint32_t const seed) noexcept
+{
+    std::mt19937                          random(seed);
+    std::uniform_real_distribution<float> unit(-1.0F, 1.0F);
+    std::vector<CtBvh::Triangle>          triangles(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        glm::vec3 const centre = glm::vec3(unit(random), unit(random), unit(random)) * 50.0F;
+        float const     size   = i % 64 == 0 ? 20.0F : 1.0F;
+        CtBvh::Triangle triangle {};
+        triangle.v0             = centre;
+        triangle.e1             = glm::vec3(unit(random), unit(random), unit(random)) * size;
+        triangle.e2             = glm::vec3(unit(random), unit(random), unit(random)) * size;
+        triangle.primitiveIndex = i;
+        triangles[i]            = triangle;
+    }
+    return triangles;
+}
+
+/**
+ * Create a random ray that starts outside of the triangles created by CreateTriangles.
+ * @param random Random number generator.
+ * @param [out] origin    The ray origin.
+ * @param [out] direction The normalised ray direction, aimed near the centre of the triangles.
+ */
+inline void CreateRay(std::mt19937 &random, glm::vec3 &origin, glm::vec3 &direction) noexcept
+{
+    std::uniform_real_distribution<float> unit(-1.0F, 1.0F);
+    glm::vec3                             offset;
+    do
+    {
+        offset = glm::vec3(unit(random), unit(random), unit(random));
+    }
+    while (glm::dot(offset, offset) < 1e-2F);
+    origin                 = glm::normalize(offset) * 100.0F;
+    glm::vec3 const target = glm::vec3(unit(random), unit(random), unit(random)) * 40.0F;
+    direction              = glm::normalize(target - origin);
+}
+} // namespace Capsaicin::Tests